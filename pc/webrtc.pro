@@ -112,6 +112,7 @@ HEADERS += ../webrtc/rtc_base/task_utils/repeating_task.h
 HEADERS += ../webrtc/rtc_base/task_utils/to_queued_task.h
 HEADERS += ../webrtc/common_types.h
 HEADERS += ../webrtc/common_audio/audio_converter.h
+HEADERS += ../webrtc/common_audio/audio_util_simd.h
 HEADERS += ../webrtc/common_audio/channel_buffer.h
 HEADERS += ../webrtc/common_audio/fir_filter.h
 HEADERS += ../webrtc/common_audio/fir_filter_c.h
@@ -333,6 +334,7 @@ HEADERS += ../webrtc/modules/audio_processing/aec3/aec3_fft.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/aec_state.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/alignment_mixer.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/api_call_jitter_metrics.h
+HEADERS += ../webrtc/modules/audio_processing/aec3/block.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/block_buffer.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/block_delay_buffer.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/block_framer.h
@@ -358,6 +360,7 @@ HEADERS += ../webrtc/modules/audio_processing/aec3/fft_data.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/filter_analyzer.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/frame_blocker.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/fullband_erle_estimator.h
+HEADERS += ../webrtc/modules/audio_processing/aec3/gcc_phat_delay_estimator.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/matched_filter.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/matched_filter_lag_aggregator.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/moving_average.h
@@ -384,6 +387,7 @@ HEADERS += ../webrtc/modules/audio_processing/aec3/subtractor_output_analyzer.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/suppression_filter.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/suppression_gain.h
 HEADERS += ../webrtc/modules/audio_processing/aec3/vector_math.h
+HEADERS += ../webrtc/modules/audio_processing/aec3/warm_start_state.h
 HEADERS += ../webrtc/modules/audio_processing/aecm/aecm_core.h
 HEADERS += ../webrtc/modules/audio_processing/aecm/aecm_defines.h
 HEADERS += ../webrtc/modules/audio_processing/aecm/echo_control_mobile.h
@@ -536,6 +540,8 @@ SOURCES += ../webrtc/api/audio_codecs/audio_encoder.cc
 SOURCES += ../webrtc/api/audio_codecs/audio_decoder.cc
 SOURCES += ../webrtc/common_audio/audio_converter.cc
 SOURCES += ../webrtc/common_audio/audio_util.cc
+SOURCES += ../webrtc/common_audio/audio_util_neon.cc
+SOURCES += ../webrtc/common_audio/audio_util_sse2.cc
 SOURCES += ../webrtc/common_audio/channel_buffer.cc
 SOURCES += ../webrtc/common_audio/fir_filter_c.cc
 SOURCES += ../webrtc/common_audio/fir_filter_factory.cc
@@ -634,6 +640,7 @@ SOURCES += ../webrtc/common_audio/signal_processing/complex_bit_reverse.c
 SOURCES += ../webrtc/common_audio/signal_processing/complex_fft.c
 SOURCES += ../webrtc/common_audio/signal_processing/copy_set_operations.c
 SOURCES += ../webrtc/common_audio/signal_processing/cross_correlation.c
+SOURCES += ../webrtc/common_audio/signal_processing/cross_correlation_sse2.c
 SOURCES += ../webrtc/common_audio/signal_processing/division_operations.c
 SOURCES += ../webrtc/common_audio/signal_processing/dot_product_with_scale.cc
 SOURCES += ../webrtc/common_audio/signal_processing/downsample_fast.c
@@ -740,6 +747,7 @@ SOURCES += ../webrtc/modules/audio_processing/aec3/fft_buffer.cc
 SOURCES += ../webrtc/modules/audio_processing/aec3/filter_analyzer.cc
 SOURCES += ../webrtc/modules/audio_processing/aec3/frame_blocker.cc
 SOURCES += ../webrtc/modules/audio_processing/aec3/fullband_erle_estimator.cc
+SOURCES += ../webrtc/modules/audio_processing/aec3/gcc_phat_delay_estimator.cc
 SOURCES += ../webrtc/modules/audio_processing/aec3/matched_filter.cc
 SOURCES += ../webrtc/modules/audio_processing/aec3/matched_filter_lag_aggregator.cc
 SOURCES += ../webrtc/modules/audio_processing/aec3/moving_average.cc
@@ -764,8 +772,10 @@ SOURCES += ../webrtc/modules/audio_processing/aec3/subtractor_output.cc
 SOURCES += ../webrtc/modules/audio_processing/aec3/subtractor_output_analyzer.cc
 SOURCES += ../webrtc/modules/audio_processing/aec3/suppression_filter.cc
 SOURCES += ../webrtc/modules/audio_processing/aec3/suppression_gain.cc
+SOURCES += ../webrtc/modules/audio_processing/aec3/warm_start_state.cc
 SOURCES += ../webrtc/modules/audio_processing/aecm/aecm_core.cc
 SOURCES += ../webrtc/modules/audio_processing/aecm/aecm_core_c.cc
+SOURCES += ../webrtc/modules/audio_processing/aecm/aecm_core_sse2.cc
 SOURCES += ../webrtc/modules/audio_processing/aecm/echo_control_mobile.cc
 SOURCES += ../webrtc/modules/audio_processing/agc/agc.cc
 SOURCES += ../webrtc/modules/audio_processing/agc/agc_manager_direct.cc
@@ -185,6 +185,8 @@ bool EchoCanceller3Config::Validate(EchoCanceller3Config* config) {
 
   res = res & Limit(&c->filter.config_change_duration_blocks, 0, 100000);
   res = res & Limit(&c->filter.initial_state_seconds, 0.f, 100.f);
+  res = res & Limit(&c->filter.non_uniform_partitioning.head_length_blocks, 1,
+                    250);
 
   res = res & Limit(&c->erle.min, 1.f, 100000.f);
   res = res & Limit(&c->erle.max_l, 1.f, 100000.f);
@@ -298,6 +300,9 @@ bool EchoCanceller3Config::Validate(EchoCanceller3Config* config) {
 
   res = res & Limit(&c->suppressor.floor_first_increase, 0.f, 1000000.f);
 
+  res = res & Limit(&c->duty_cycling.steady_state_blocks, 1, 100000);
+  res = res & Limit(&c->duty_cycling.delay_search_interval_blocks, 1, 250);
+
   return res;
 }
 }  // namespace webrtc
@@ -50,6 +50,9 @@ struct RTC_EXPORT EchoCanceller3Config {
     } delay_selection_thresholds = {5, 20};
     bool use_external_delay_estimator = false;
     bool log_warning_on_delay_changes = false;
+    // Estimate the delay with GCC-PHAT instead of the matched filters. Its
+    // cost hardly depends on the delay range, set by |num_filters|.
+    bool use_gcc_phat_delay_estimator = false;
     struct AlignmentMixing {
       bool downmix;
       bool adaptive_selection;
@@ -99,6 +102,22 @@ struct RTC_EXPORT EchoCanceller3Config {
     // Uses the filter configurations named main and shadow rather than those
     // named refined and coarse.
     bool use_legacy_filter_naming = true;
+    // Bypasses the filtering and adaptation of the refined and coarse filters
+    // for blocks where the render signal over the span of the filters is below
+    // about -90 dBFS, or where the capture signal is digital silence. The echo
+    // estimates are then zero.
+    bool bypass_filters_for_silence = false;
+
+    // Schedules the adaptation of the refined filter non-uniformly over its
+    // length. The first |head_length_blocks| partitions are adapted every
+    // block, while the remaining tail partitions are split into groups of
+    // doubling size that are adapted at doubling intervals. This keeps the
+    // cost of long filters close to that of the default filter length without
+    // adding any latency.
+    struct NonUniformPartitioning {
+      bool enabled = false;
+      size_t head_length_blocks = 16;
+    } non_uniform_partitioning;
   } filter;
 
   struct Erle {
@@ -230,6 +249,19 @@ struct RTC_EXPORT EchoCanceller3Config {
 
     float floor_first_increase = 0.00001f;
   } suppressor;
+
+  // Reduces the work done once the echo canceller has converged. After
+  // |steady_state_blocks| consecutive blocks with converged filters and a
+  // steady ERLE, the delay search only runs every
+  // |delay_search_interval_blocks| blocks and, if
+  // |skip_coarse_filter_adaptation| is set, the coarse filter is not adapted.
+  // Any echo path change or filter divergence restores full-rate processing.
+  struct DutyCycling {
+    bool enabled = false;
+    size_t steady_state_blocks = 500;
+    size_t delay_search_interval_blocks = 8;
+    bool skip_coarse_filter_adaptation = true;
+  } duty_cycling;
 };
 }  // namespace webrtc
 
@@ -207,6 +207,8 @@ void Aec3ConfigFromJsonString(absl::string_view json_string,
               &cfg.delay.use_external_delay_estimator);
     ReadParam(section, "log_warning_on_delay_changes",
               &cfg.delay.log_warning_on_delay_changes);
+    ReadParam(section, "use_gcc_phat_delay_estimator",
+              &cfg.delay.use_gcc_phat_delay_estimator);
 
     ReadParam(section, "render_alignment_mixing",
               &cfg.delay.render_alignment_mixing);
@@ -238,6 +240,17 @@ void Aec3ConfigFromJsonString(absl::string_view json_string,
               &cfg.filter.export_linear_aec_output);
     ReadParam(section, "use_legacy_filter_naming",
               &cfg.filter.use_legacy_filter_naming);
+    ReadParam(section, "bypass_filters_for_silence",
+              &cfg.filter.bypass_filters_for_silence);
+
+    SJson::Value subsection;
+    if (rtc::GetValueFromJsonObject(section, "non_uniform_partitioning",
+                                    &subsection)) {
+      ReadParam(subsection, "enabled",
+                &cfg.filter.non_uniform_partitioning.enabled);
+      ReadParam(subsection, "head_length_blocks",
+                &cfg.filter.non_uniform_partitioning.head_length_blocks);
+    }
   }
 
   if (rtc::GetValueFromJsonObject(aec3_root, "erle", &section)) {
@@ -390,6 +403,16 @@ void Aec3ConfigFromJsonString(absl::string_view json_string,
     ReadParam(section, "floor_first_increase",
               &cfg.suppressor.floor_first_increase);
   }
+
+  if (rtc::GetValueFromJsonObject(aec3_root, "duty_cycling", &section)) {
+    ReadParam(section, "enabled", &cfg.duty_cycling.enabled);
+    ReadParam(section, "steady_state_blocks",
+              &cfg.duty_cycling.steady_state_blocks);
+    ReadParam(section, "delay_search_interval_blocks",
+              &cfg.duty_cycling.delay_search_interval_blocks);
+    ReadParam(section, "skip_coarse_filter_adaptation",
+              &cfg.duty_cycling.skip_coarse_filter_adaptation);
+  }
 }
 
 EchoCanceller3Config Aec3ConfigFromJsonString(absl::string_view json_string) {
@@ -436,6 +459,8 @@ std::string Aec3ConfigToJsonString(const EchoCanceller3Config& config) {
       << (config.delay.use_external_delay_estimator ? "true" : "false") << ",";
   ost << "\"log_warning_on_delay_changes\": "
       << (config.delay.log_warning_on_delay_changes ? "true" : "false") << ",";
+  ost << "\"use_gcc_phat_delay_estimator\": "
+      << (config.delay.use_gcc_phat_delay_estimator ? "true" : "false") << ",";
 
   ost << "\"render_alignment_mixing\": {";
   ost << "\"downmix\": "
@@ -548,7 +573,16 @@ std::string Aec3ConfigToJsonString(const EchoCanceller3Config& config) {
   ost << "\"export_linear_aec_output\": "
       << (config.filter.export_linear_aec_output ? "true" : "false") << ",";
   ost << "\"use_legacy_filter_naming\": "
-      << (config.filter.use_legacy_filter_naming ? "true" : "false");
+      << (config.filter.use_legacy_filter_naming ? "true" : "false") << ",";
+  ost << "\"bypass_filters_for_silence\": "
+      << (config.filter.bypass_filters_for_silence ? "true" : "false") << ",";
+  ost << "\"non_uniform_partitioning\": {";
+  ost << "\"enabled\": "
+      << (config.filter.non_uniform_partitioning.enabled ? "true" : "false")
+      << ",";
+  ost << "\"head_length_blocks\": "
+      << config.filter.non_uniform_partitioning.head_length_blocks;
+  ost << "}";
 
   ost << "},";
 
@@ -715,6 +749,17 @@ std::string Aec3ConfigToJsonString(const EchoCanceller3Config& config) {
       << config.suppressor.high_bands_suppression.anti_howling_gain;
   ost << "},";
   ost << "\"floor_first_increase\": " << config.suppressor.floor_first_increase;
+  ost << "},";
+
+  ost << "\"duty_cycling\": {";
+  ost << "\"enabled\": " << (config.duty_cycling.enabled ? "true" : "false")
+      << ",";
+  ost << "\"steady_state_blocks\": " << config.duty_cycling.steady_state_blocks
+      << ",";
+  ost << "\"delay_search_interval_blocks\": "
+      << config.duty_cycling.delay_search_interval_blocks << ",";
+  ost << "\"skip_coarse_filter_adaptation\": "
+      << (config.duty_cycling.skip_coarse_filter_adaptation ? "true" : "false");
   ost << "}";
   ost << "}";
   ost << "}";
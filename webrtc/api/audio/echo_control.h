@@ -40,6 +40,10 @@ class EchoControl {
     double echo_return_loss;
     double echo_return_loss_enhancement;
     int delay_ms;
+    // Number of blocks for which the render signal, respectively the capture
+    // signal, was silent and a reduced-work processing path was taken.
+    int render_silence_blocks = 0;
+    int capture_silence_blocks = 0;
   };
 
   // Collect current metrics from the echo controller.
@@ -10,38 +10,177 @@
 
 #include "common_audio/include/audio_util.h"
 
+#include "common_audio/audio_util_simd.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kSSE2, WebRtc_G...
+#endif
+
 namespace webrtc {
 
+namespace {
+
+// Block size, in frames, of the fused conversions, and the most channels they
+// convert through the SIMD interleaving kernels.
+constexpr size_t kBlockSize = 128;
+constexpr size_t kMaxBlockChannels = 8;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// If we know the minimum architecture at compile time, avoid CPU detection.
+bool HasSse2() {
+#if defined(__SSE2__)
+  return true;
+#else
+  static const bool has_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
+  return has_sse2;
+#endif
+}
+#endif
+
+// Calls |sse2| or |neon| where available, and returns the number of elements
+// they converted.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#define WEBRTC_AUDIO_UTIL_SIMD(sse2, neon, ...) \
+  (HasSse2() ? sse2(__VA_ARGS__) : 0)
+#elif defined(WEBRTC_HAS_NEON)
+#define WEBRTC_AUDIO_UTIL_SIMD(sse2, neon, ...) neon(__VA_ARGS__)
+#else
+#define WEBRTC_AUDIO_UTIL_SIMD(sse2, neon, ...) 0
+#endif
+
+}  // namespace
+
 void FloatToS16(const float* src, size_t size, int16_t* dest) {
-  for (size_t i = 0; i < size; ++i)
+  size_t i = WEBRTC_AUDIO_UTIL_SIMD(FloatToS16_SSE2, FloatToS16_NEON, src, size,
+                                    dest);
+  for (; i < size; ++i)
     dest[i] = FloatToS16(src[i]);
 }
 
 void S16ToFloat(const int16_t* src, size_t size, float* dest) {
-  for (size_t i = 0; i < size; ++i)
+  size_t i = WEBRTC_AUDIO_UTIL_SIMD(S16ToFloat_SSE2, S16ToFloat_NEON, src, size,
+                                    dest);
+  for (; i < size; ++i)
     dest[i] = S16ToFloat(src[i]);
 }
 
 void S16ToFloatS16(const int16_t* src, size_t size, float* dest) {
-  for (size_t i = 0; i < size; ++i)
+  size_t i = WEBRTC_AUDIO_UTIL_SIMD(S16ToFloatS16_SSE2, S16ToFloatS16_NEON, src,
+                                    size, dest);
+  for (; i < size; ++i)
     dest[i] = src[i];
 }
 
 void FloatS16ToS16(const float* src, size_t size, int16_t* dest) {
-  for (size_t i = 0; i < size; ++i)
+  size_t i = WEBRTC_AUDIO_UTIL_SIMD(FloatS16ToS16_SSE2, FloatS16ToS16_NEON, src,
+                                    size, dest);
+  for (; i < size; ++i)
     dest[i] = FloatS16ToS16(src[i]);
 }
 
 void FloatToFloatS16(const float* src, size_t size, float* dest) {
-  for (size_t i = 0; i < size; ++i)
+  size_t i = WEBRTC_AUDIO_UTIL_SIMD(FloatToFloatS16_SSE2, FloatToFloatS16_NEON,
+                                    src, size, dest);
+  for (; i < size; ++i)
     dest[i] = FloatToFloatS16(src[i]);
 }
 
 void FloatS16ToFloat(const float* src, size_t size, float* dest) {
-  for (size_t i = 0; i < size; ++i)
+  size_t i = WEBRTC_AUDIO_UTIL_SIMD(FloatS16ToFloat_SSE2, FloatS16ToFloat_NEON,
+                                    src, size, dest);
+  for (; i < size; ++i)
     dest[i] = FloatS16ToFloat(src[i]);
 }
 
+template <>
+void Deinterleave<int16_t>(const int16_t* interleaved,
+                           size_t samples_per_channel,
+                           size_t num_channels,
+                           int16_t* const* deinterleaved) {
+  const size_t i =
+      WEBRTC_AUDIO_UTIL_SIMD(DeinterleaveS16_SSE2, DeinterleaveS16_NEON,
+                             interleaved, samples_per_channel, num_channels,
+                             deinterleaved);
+  // The rest, and channel counts without a SIMD kernel.
+  for (size_t c = 0; c < num_channels; ++c) {
+    for (size_t j = i; j < samples_per_channel; ++j) {
+      deinterleaved[c][j] = interleaved[j * num_channels + c];
+    }
+  }
+}
+
+template <>
+void Interleave<int16_t>(const int16_t* const* deinterleaved,
+                         size_t samples_per_channel,
+                         size_t num_channels,
+                         int16_t* interleaved) {
+  const size_t i =
+      WEBRTC_AUDIO_UTIL_SIMD(InterleaveS16_SSE2, InterleaveS16_NEON,
+                             deinterleaved, samples_per_channel, num_channels,
+                             interleaved);
+  // The rest, and channel counts without a SIMD kernel.
+  for (size_t c = 0; c < num_channels; ++c) {
+    for (size_t j = i; j < samples_per_channel; ++j) {
+      interleaved[j * num_channels + c] = deinterleaved[c][j];
+    }
+  }
+}
+
+void DeinterleaveS16ToFloatS16(const int16_t* interleaved,
+                               size_t samples_per_channel,
+                               size_t num_channels,
+                               float* const* deinterleaved) {
+  if (num_channels > kMaxBlockChannels) {
+    for (size_t c = 0; c < num_channels; ++c) {
+      for (size_t j = 0; j < samples_per_channel; ++j) {
+        deinterleaved[c][j] = interleaved[j * num_channels + c];
+      }
+    }
+    return;
+  }
+  int16_t block[kMaxBlockChannels][kBlockSize];
+  int16_t* block_channels[kMaxBlockChannels];
+  for (size_t c = 0; c < kMaxBlockChannels; ++c) {
+    block_channels[c] = block[c];
+  }
+  for (size_t start = 0; start < samples_per_channel; start += kBlockSize) {
+    const size_t length = std::min(kBlockSize, samples_per_channel - start);
+    Deinterleave(&interleaved[start * num_channels], length, num_channels,
+                 block_channels);
+    for (size_t c = 0; c < num_channels; ++c) {
+      S16ToFloatS16(block[c], length, &deinterleaved[c][start]);
+    }
+  }
+}
+
+void InterleaveFloatS16ToS16(const float* const* deinterleaved,
+                             size_t samples_per_channel,
+                             size_t num_channels,
+                             int16_t* interleaved) {
+  if (num_channels > kMaxBlockChannels) {
+    for (size_t c = 0; c < num_channels; ++c) {
+      for (size_t j = 0; j < samples_per_channel; ++j) {
+        interleaved[j * num_channels + c] = FloatS16ToS16(deinterleaved[c][j]);
+      }
+    }
+    return;
+  }
+  int16_t block[kMaxBlockChannels][kBlockSize];
+  const int16_t* block_channels[kMaxBlockChannels];
+  for (size_t c = 0; c < kMaxBlockChannels; ++c) {
+    block_channels[c] = block[c];
+  }
+  for (size_t start = 0; start < samples_per_channel; start += kBlockSize) {
+    const size_t length = std::min(kBlockSize, samples_per_channel - start);
+    for (size_t c = 0; c < num_channels; ++c) {
+      FloatS16ToS16(&deinterleaved[c][start], length, block[c]);
+    }
+    Interleave(block_channels, length, num_channels,
+               &interleaved[start * num_channels]);
+  }
+}
+
 template <>
 void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
                                        size_t num_frames,
@@ -51,4 +190,18 @@ void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
                                                  num_channels, deinterleaved);
 }
 
+void DownmixStereoToMonoS16(const int16_t* interleaved,
+                            size_t num_frames,
+                            int16_t* mono) {
+  size_t i = WEBRTC_AUDIO_UTIL_SIMD(DownmixStereoToMonoS16_SSE2,
+                                    DownmixStereoToMonoS16_NEON, interleaved,
+                                    num_frames, mono);
+  for (; i < num_frames; ++i) {
+    mono[i] = static_cast<int16_t>(
+        (int32_t{interleaved[2 * i]} + int32_t{interleaved[2 * i + 1]}) >> 1);
+  }
+}
+
+#undef WEBRTC_AUDIO_UTIL_SIMD
+
 }  // namespace webrtc
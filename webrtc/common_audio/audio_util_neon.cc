@@ -0,0 +1,208 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/audio_util_simd.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+
+namespace webrtc {
+
+namespace {
+
+// Clamps to [-32768, 32767] and rounds half away from zero, as in
+// FloatS16ToS16().
+int16x4_t RoundToS16(float32x4_t v) {
+  v = vminq_f32(v, vdupq_n_f32(32767.f));
+  v = vmaxq_f32(v, vdupq_n_f32(-32768.f));
+  const uint32x4_t sign =
+      vandq_u32(vreinterpretq_u32_f32(v), vdupq_n_u32(0x80000000));
+  const float32x4_t half = vreinterpretq_f32_u32(
+      vorrq_u32(sign, vreinterpretq_u32_f32(vdupq_n_f32(0.5f))));
+  return vqmovn_s32(vcvtq_s32_f32(vaddq_f32(v, half)));
+}
+
+float32x4_t LowToFloat(int16x8_t v) {
+  return vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+}
+
+float32x4_t HighToFloat(int16x8_t v) {
+  return vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+}
+
+}  // namespace
+
+size_t FloatToS16_NEON(const float* src, size_t size, int16_t* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const int16x4_t low = RoundToS16(vmulq_n_f32(vld1q_f32(&src[i]), 32768.f));
+    const int16x4_t high =
+        RoundToS16(vmulq_n_f32(vld1q_f32(&src[i + 4]), 32768.f));
+    vst1q_s16(&dest[i], vcombine_s16(low, high));
+  }
+  return i;
+}
+
+size_t S16ToFloat_NEON(const int16_t* src, size_t size, float* dest) {
+  constexpr float kScaling = 1.f / 32768.f;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const int16x8_t v = vld1q_s16(&src[i]);
+    vst1q_f32(&dest[i], vmulq_n_f32(LowToFloat(v), kScaling));
+    vst1q_f32(&dest[i + 4], vmulq_n_f32(HighToFloat(v), kScaling));
+  }
+  return i;
+}
+
+size_t S16ToFloatS16_NEON(const int16_t* src, size_t size, float* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const int16x8_t v = vld1q_s16(&src[i]);
+    vst1q_f32(&dest[i], LowToFloat(v));
+    vst1q_f32(&dest[i + 4], HighToFloat(v));
+  }
+  return i;
+}
+
+size_t FloatS16ToS16_NEON(const float* src, size_t size, int16_t* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const int16x4_t low = RoundToS16(vld1q_f32(&src[i]));
+    const int16x4_t high = RoundToS16(vld1q_f32(&src[i + 4]));
+    vst1q_s16(&dest[i], vcombine_s16(low, high));
+  }
+  return i;
+}
+
+size_t FloatToFloatS16_NEON(const float* src, size_t size, float* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    for (size_t k = i; k < i + 8; k += 4) {
+      const float32x4_t v = vmaxq_f32(
+          vminq_f32(vld1q_f32(&src[k]), vdupq_n_f32(1.f)), vdupq_n_f32(-1.f));
+      vst1q_f32(&dest[k], vmulq_n_f32(v, 32768.f));
+    }
+  }
+  return i;
+}
+
+size_t FloatS16ToFloat_NEON(const float* src, size_t size, float* dest) {
+  constexpr float kScaling = 1.f / 32768.f;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    for (size_t k = i; k < i + 8; k += 4) {
+      const float32x4_t v =
+          vmaxq_f32(vminq_f32(vld1q_f32(&src[k]), vdupq_n_f32(32768.f)),
+                    vdupq_n_f32(-32768.f));
+      vst1q_f32(&dest[k], vmulq_n_f32(v, kScaling));
+    }
+  }
+  return i;
+}
+
+size_t DeinterleaveS16_NEON(const int16_t* interleaved,
+                            size_t samples_per_channel,
+                            size_t num_channels,
+                            int16_t* const* deinterleaved) {
+  size_t i = 0;
+  switch (num_channels) {
+    case 2:
+      for (; i + 8 <= samples_per_channel; i += 8) {
+        const int16x8x2_t v = vld2q_s16(&interleaved[2 * i]);
+        vst1q_s16(&deinterleaved[0][i], v.val[0]);
+        vst1q_s16(&deinterleaved[1][i], v.val[1]);
+      }
+      break;
+    case 4:
+      for (; i + 8 <= samples_per_channel; i += 8) {
+        const int16x8x4_t v = vld4q_s16(&interleaved[4 * i]);
+        for (int c = 0; c < 4; ++c) {
+          vst1q_s16(&deinterleaved[c][i], v.val[c]);
+        }
+      }
+      break;
+    case 8:
+      // Each half of the block loads as channels c and c + 4 of four frames,
+      // alternating; unzipping the halves separates them.
+      for (; i + 8 <= samples_per_channel; i += 8) {
+        const int16x8x4_t first = vld4q_s16(&interleaved[8 * i]);
+        const int16x8x4_t second = vld4q_s16(&interleaved[8 * i + 32]);
+        for (int c = 0; c < 4; ++c) {
+          const int16x8x2_t v = vuzpq_s16(first.val[c], second.val[c]);
+          vst1q_s16(&deinterleaved[c][i], v.val[0]);
+          vst1q_s16(&deinterleaved[c + 4][i], v.val[1]);
+        }
+      }
+      break;
+    default:
+      break;
+  }
+  return i;
+}
+
+size_t InterleaveS16_NEON(const int16_t* const* deinterleaved,
+                          size_t samples_per_channel,
+                          size_t num_channels,
+                          int16_t* interleaved) {
+  size_t i = 0;
+  switch (num_channels) {
+    case 2:
+      for (; i + 8 <= samples_per_channel; i += 8) {
+        int16x8x2_t v;
+        v.val[0] = vld1q_s16(&deinterleaved[0][i]);
+        v.val[1] = vld1q_s16(&deinterleaved[1][i]);
+        vst2q_s16(&interleaved[2 * i], v);
+      }
+      break;
+    case 4:
+      for (; i + 8 <= samples_per_channel; i += 8) {
+        int16x8x4_t v;
+        for (int c = 0; c < 4; ++c) {
+          v.val[c] = vld1q_s16(&deinterleaved[c][i]);
+        }
+        vst4q_s16(&interleaved[4 * i], v);
+      }
+      break;
+    case 8:
+      // The inverse of the deinterleaving above.
+      for (; i + 8 <= samples_per_channel; i += 8) {
+        int16x8x4_t first;
+        int16x8x4_t second;
+        for (int c = 0; c < 4; ++c) {
+          const int16x8x2_t v = vzipq_s16(vld1q_s16(&deinterleaved[c][i]),
+                                          vld1q_s16(&deinterleaved[c + 4][i]));
+          first.val[c] = v.val[0];
+          second.val[c] = v.val[1];
+        }
+        vst4q_s16(&interleaved[8 * i], first);
+        vst4q_s16(&interleaved[8 * i + 32], second);
+      }
+      break;
+    default:
+      break;
+  }
+  return i;
+}
+
+size_t DownmixStereoToMonoS16_NEON(const int16_t* interleaved,
+                                   size_t num_frames,
+                                   int16_t* mono) {
+  size_t i = 0;
+  for (; i + 8 <= num_frames; i += 8) {
+    const int16x8x2_t v = vld2q_s16(&interleaved[2 * i]);
+    // Halving add, (left + right) >> 1 without overflow.
+    vst1q_s16(&mono[i], vhaddq_s16(v.val[0], v.val[1]));
+  }
+  return i;
+}
+
+}  // namespace webrtc
+
+#endif  // defined(WEBRTC_HAS_NEON)
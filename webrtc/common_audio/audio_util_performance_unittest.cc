@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "common_audio/include/audio_util.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+// 10 ms at 48 kHz.
+constexpr size_t kSamplesPerChannel = 480;
+
+int NumIterations() {
+  const int kNumIterations = 100000;
+  const int kQuickNumIterations = 500;
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumIterations
+                                                        : kNumIterations;
+}
+
+// Runs |convert| |num_iterations| times and reports the throughput in samples
+// per second.
+template <typename Function>
+void RunAndReport(const std::string& name,
+                  size_t samples_per_iteration,
+                  Function convert) {
+  const int num_iterations = NumIterations();
+  Clock* clock = Clock::GetRealTimeClock();
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int n = 0; n < num_iterations; ++n) {
+    convert();
+  }
+  const int64_t runtime_us = clock->TimeInMicroseconds() - start_time_us;
+  ASSERT_GT(runtime_us, 0);
+  test::PrintResult("audio_util_performance", "", name,
+                    1e6 * num_iterations * samples_per_iteration / runtime_us,
+                    "samples_per_second_per_core", true);
+}
+
+}  // namespace
+
+TEST(AudioUtilPerformanceTest, Conversions) {
+  Random random(0x12345678);
+  std::vector<int16_t> s16(kSamplesPerChannel);
+  std::vector<float> float_s16(kSamplesPerChannel);
+  for (size_t i = 0; i < kSamplesPerChannel; ++i) {
+    s16[i] = static_cast<int16_t>(random.Rand(-32768, 32767));
+    float_s16[i] = (random.Rand<float>() - 0.5f) * 70000.f;
+  }
+  std::vector<int16_t> s16_out(kSamplesPerChannel);
+  std::vector<float> float_out(kSamplesPerChannel);
+
+  RunAndReport("s16_to_float_s16", kSamplesPerChannel, [&] {
+    S16ToFloatS16(s16.data(), s16.size(), float_out.data());
+  });
+  RunAndReport("s16_to_float", kSamplesPerChannel, [&] {
+    S16ToFloat(s16.data(), s16.size(), float_out.data());
+  });
+  RunAndReport("float_s16_to_s16", kSamplesPerChannel, [&] {
+    FloatS16ToS16(float_s16.data(), float_s16.size(), s16_out.data());
+  });
+  RunAndReport("float_to_s16", kSamplesPerChannel, [&] {
+    FloatToS16(float_out.data(), float_out.size(), s16_out.data());
+  });
+  RunAndReport("float_s16_to_float", kSamplesPerChannel, [&] {
+    FloatS16ToFloat(float_s16.data(), float_s16.size(), float_out.data());
+  });
+  RunAndReport("downmix_stereo_to_mono_s16", kSamplesPerChannel / 2, [&] {
+    DownmixStereoToMonoS16(s16.data(), s16.size() / 2, s16_out.data());
+  });
+}
+
+TEST(AudioUtilPerformanceTest, Interleaving) {
+  Random random(0x12345678);
+  for (size_t num_channels : {2, 4, 6, 8}) {
+    const size_t num_samples = num_channels * kSamplesPerChannel;
+    std::vector<int16_t> interleaved(num_samples);
+    for (int16_t& sample : interleaved) {
+      sample = static_cast<int16_t>(random.Rand(-32768, 32767));
+    }
+    std::vector<int16_t> s16(num_samples);
+    std::vector<float> float_s16(num_samples);
+    std::vector<int16_t*> s16_channels;
+    std::vector<float*> float_channels;
+    for (size_t c = 0; c < num_channels; ++c) {
+      s16_channels.push_back(&s16[c * kSamplesPerChannel]);
+      float_channels.push_back(&float_s16[c * kSamplesPerChannel]);
+    }
+    const std::string suffix = "_" + std::to_string(num_channels) + "ch";
+
+    RunAndReport("deinterleave_s16" + suffix, num_samples, [&] {
+      Deinterleave(interleaved.data(), kSamplesPerChannel, num_channels,
+                   s16_channels.data());
+    });
+    RunAndReport("interleave_s16" + suffix, num_samples, [&] {
+      Interleave(s16_channels.data(), kSamplesPerChannel, num_channels,
+                 interleaved.data());
+    });
+    RunAndReport("deinterleave_s16_to_float_s16" + suffix, num_samples, [&] {
+      DeinterleaveS16ToFloatS16(interleaved.data(), kSamplesPerChannel,
+                                num_channels, float_channels.data());
+    });
+    RunAndReport("interleave_float_s16_to_s16" + suffix, num_samples, [&] {
+      InterleaveFloatS16ToS16(float_channels.data(), kSamplesPerChannel,
+                              num_channels, interleaved.data());
+    });
+  }
+}
+
+}  // namespace webrtc
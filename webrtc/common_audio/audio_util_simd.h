@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_AUDIO_UTIL_SIMD_H_
+#define COMMON_AUDIO_AUDIO_UTIL_SIMD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+
+// Architecture specific kernels behind the conversions in audio_util.h. They
+// handle a multiple of 8 samples (or frames, for the interleaving kernels) and
+// return the number processed; the caller converts the rest. The interleaving
+// kernels handle 2, 4 and 8 channels and return 0 for other channel counts.
+// All results are bit-exact with the scalar functions in audio_util.h.
+
+size_t FloatToS16_SSE2(const float* src, size_t size, int16_t* dest);
+size_t S16ToFloat_SSE2(const int16_t* src, size_t size, float* dest);
+size_t S16ToFloatS16_SSE2(const int16_t* src, size_t size, float* dest);
+size_t FloatS16ToS16_SSE2(const float* src, size_t size, int16_t* dest);
+size_t FloatToFloatS16_SSE2(const float* src, size_t size, float* dest);
+size_t FloatS16ToFloat_SSE2(const float* src, size_t size, float* dest);
+size_t DeinterleaveS16_SSE2(const int16_t* interleaved,
+                            size_t samples_per_channel,
+                            size_t num_channels,
+                            int16_t* const* deinterleaved);
+size_t InterleaveS16_SSE2(const int16_t* const* deinterleaved,
+                          size_t samples_per_channel,
+                          size_t num_channels,
+                          int16_t* interleaved);
+size_t DownmixStereoToMonoS16_SSE2(const int16_t* interleaved,
+                                   size_t num_frames,
+                                   int16_t* mono);
+
+size_t FloatToS16_NEON(const float* src, size_t size, int16_t* dest);
+size_t S16ToFloat_NEON(const int16_t* src, size_t size, float* dest);
+size_t S16ToFloatS16_NEON(const int16_t* src, size_t size, float* dest);
+size_t FloatS16ToS16_NEON(const float* src, size_t size, int16_t* dest);
+size_t FloatToFloatS16_NEON(const float* src, size_t size, float* dest);
+size_t FloatS16ToFloat_NEON(const float* src, size_t size, float* dest);
+size_t DeinterleaveS16_NEON(const int16_t* interleaved,
+                            size_t samples_per_channel,
+                            size_t num_channels,
+                            int16_t* const* deinterleaved);
+size_t InterleaveS16_NEON(const int16_t* const* deinterleaved,
+                          size_t samples_per_channel,
+                          size_t num_channels,
+                          int16_t* interleaved);
+size_t DownmixStereoToMonoS16_NEON(const int16_t* interleaved,
+                                   size_t num_frames,
+                                   int16_t* mono);
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_AUDIO_UTIL_SIMD_H_
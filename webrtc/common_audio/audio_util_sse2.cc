@@ -0,0 +1,272 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/audio_util_simd.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+
+namespace webrtc {
+
+namespace {
+
+__m128i LoadS16(const int16_t* src) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+
+void StoreS16(__m128i v, int16_t* dest) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), v);
+}
+
+// Sign extends the low and high four samples of |v| to floats.
+__m128 LowToFloat(__m128i v) {
+  return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+}
+
+__m128 HighToFloat(__m128i v) {
+  return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+}
+
+// Clamps to [-32768, 32767] and rounds half away from zero, as in
+// FloatS16ToS16(). The operand order of the min and max matches
+// std::min(v, max) and std::max(v, min), which return |v| when it is NaN.
+__m128i RoundToS32(__m128 v) {
+  v = _mm_min_ps(_mm_set1_ps(32767.f), v);
+  v = _mm_max_ps(_mm_set1_ps(-32768.f), v);
+  const __m128 sign = _mm_and_ps(v, _mm_set1_ps(-0.f));
+  return _mm_cvttps_epi32(_mm_add_ps(v, _mm_or_ps(sign, _mm_set1_ps(0.5f))));
+}
+
+// The even and the odd samples of |a| followed by those of |b|.
+__m128i Even(__m128i a, __m128i b) {
+  return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                         _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+}
+
+__m128i Odd(__m128i a, __m128i b) {
+  return _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+}
+
+// Deinterleaves 8 frames of kNumChannels channels held in |in| into one
+// vector per channel, by splitting the even and the odd channels apart until
+// one channel remains.
+template <size_t kNumChannels>
+struct Block {
+  static void Deinterleave(const __m128i* in, __m128i* out) {
+    constexpr size_t kHalf = kNumChannels / 2;
+    __m128i even[kHalf];
+    __m128i odd[kHalf];
+    for (size_t k = 0; k < kHalf; ++k) {
+      even[k] = Even(in[2 * k], in[2 * k + 1]);
+      odd[k] = Odd(in[2 * k], in[2 * k + 1]);
+    }
+    __m128i even_out[kHalf];
+    __m128i odd_out[kHalf];
+    Block<kHalf>::Deinterleave(even, even_out);
+    Block<kHalf>::Deinterleave(odd, odd_out);
+    for (size_t c = 0; c < kHalf; ++c) {
+      out[2 * c] = even_out[c];
+      out[2 * c + 1] = odd_out[c];
+    }
+  }
+
+  // The inverse of Deinterleave().
+  static void Interleave(const __m128i* in, __m128i* out) {
+    constexpr size_t kHalf = kNumChannels / 2;
+    __m128i even[kHalf];
+    __m128i odd[kHalf];
+    for (size_t c = 0; c < kHalf; ++c) {
+      even[c] = in[2 * c];
+      odd[c] = in[2 * c + 1];
+    }
+    __m128i even_out[kHalf];
+    __m128i odd_out[kHalf];
+    Block<kHalf>::Interleave(even, even_out);
+    Block<kHalf>::Interleave(odd, odd_out);
+    for (size_t k = 0; k < kHalf; ++k) {
+      out[2 * k] = _mm_unpacklo_epi16(even_out[k], odd_out[k]);
+      out[2 * k + 1] = _mm_unpackhi_epi16(even_out[k], odd_out[k]);
+    }
+  }
+};
+
+template <>
+struct Block<1> {
+  static void Deinterleave(const __m128i* in, __m128i* out) { out[0] = in[0]; }
+  static void Interleave(const __m128i* in, __m128i* out) { out[0] = in[0]; }
+};
+
+template <size_t kNumChannels>
+size_t Deinterleave(const int16_t* interleaved,
+                    size_t samples_per_channel,
+                    int16_t* const* deinterleaved) {
+  size_t i = 0;
+  for (; i + 8 <= samples_per_channel; i += 8) {
+    __m128i in[kNumChannels];
+    __m128i out[kNumChannels];
+    for (size_t k = 0; k < kNumChannels; ++k) {
+      in[k] = LoadS16(&interleaved[i * kNumChannels + 8 * k]);
+    }
+    Block<kNumChannels>::Deinterleave(in, out);
+    for (size_t c = 0; c < kNumChannels; ++c) {
+      StoreS16(out[c], &deinterleaved[c][i]);
+    }
+  }
+  return i;
+}
+
+template <size_t kNumChannels>
+size_t Interleave(const int16_t* const* deinterleaved,
+                  size_t samples_per_channel,
+                  int16_t* interleaved) {
+  size_t i = 0;
+  for (; i + 8 <= samples_per_channel; i += 8) {
+    __m128i in[kNumChannels];
+    __m128i out[kNumChannels];
+    for (size_t c = 0; c < kNumChannels; ++c) {
+      in[c] = LoadS16(&deinterleaved[c][i]);
+    }
+    Block<kNumChannels>::Interleave(in, out);
+    for (size_t k = 0; k < kNumChannels; ++k) {
+      StoreS16(out[k], &interleaved[i * kNumChannels + 8 * k]);
+    }
+  }
+  return i;
+}
+
+}  // namespace
+
+size_t FloatToS16_SSE2(const float* src, size_t size, int16_t* dest) {
+  const __m128 scaling = _mm_set1_ps(32768.f);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m128i low =
+        RoundToS32(_mm_mul_ps(_mm_loadu_ps(&src[i]), scaling));
+    const __m128i high =
+        RoundToS32(_mm_mul_ps(_mm_loadu_ps(&src[i + 4]), scaling));
+    StoreS16(_mm_packs_epi32(low, high), &dest[i]);
+  }
+  return i;
+}
+
+size_t S16ToFloat_SSE2(const int16_t* src, size_t size, float* dest) {
+  const __m128 scaling = _mm_set1_ps(1.f / 32768.f);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m128i v = LoadS16(&src[i]);
+    _mm_storeu_ps(&dest[i], _mm_mul_ps(LowToFloat(v), scaling));
+    _mm_storeu_ps(&dest[i + 4], _mm_mul_ps(HighToFloat(v), scaling));
+  }
+  return i;
+}
+
+size_t S16ToFloatS16_SSE2(const int16_t* src, size_t size, float* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m128i v = LoadS16(&src[i]);
+    _mm_storeu_ps(&dest[i], LowToFloat(v));
+    _mm_storeu_ps(&dest[i + 4], HighToFloat(v));
+  }
+  return i;
+}
+
+size_t FloatS16ToS16_SSE2(const float* src, size_t size, int16_t* dest) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const __m128i low = RoundToS32(_mm_loadu_ps(&src[i]));
+    const __m128i high = RoundToS32(_mm_loadu_ps(&src[i + 4]));
+    StoreS16(_mm_packs_epi32(low, high), &dest[i]);
+  }
+  return i;
+}
+
+size_t FloatToFloatS16_SSE2(const float* src, size_t size, float* dest) {
+  const __m128 max = _mm_set1_ps(1.f);
+  const __m128 min = _mm_set1_ps(-1.f);
+  const __m128 scaling = _mm_set1_ps(32768.f);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    for (size_t k = i; k < i + 8; k += 4) {
+      const __m128 v = _mm_max_ps(min, _mm_min_ps(max, _mm_loadu_ps(&src[k])));
+      _mm_storeu_ps(&dest[k], _mm_mul_ps(v, scaling));
+    }
+  }
+  return i;
+}
+
+size_t FloatS16ToFloat_SSE2(const float* src, size_t size, float* dest) {
+  const __m128 max = _mm_set1_ps(32768.f);
+  const __m128 min = _mm_set1_ps(-32768.f);
+  const __m128 scaling = _mm_set1_ps(1.f / 32768.f);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    for (size_t k = i; k < i + 8; k += 4) {
+      const __m128 v = _mm_max_ps(min, _mm_min_ps(max, _mm_loadu_ps(&src[k])));
+      _mm_storeu_ps(&dest[k], _mm_mul_ps(v, scaling));
+    }
+  }
+  return i;
+}
+
+size_t DeinterleaveS16_SSE2(const int16_t* interleaved,
+                            size_t samples_per_channel,
+                            size_t num_channels,
+                            int16_t* const* deinterleaved) {
+  switch (num_channels) {
+    case 2:
+      return Deinterleave<2>(interleaved, samples_per_channel, deinterleaved);
+    case 4:
+      return Deinterleave<4>(interleaved, samples_per_channel, deinterleaved);
+    case 8:
+      return Deinterleave<8>(interleaved, samples_per_channel, deinterleaved);
+    default:
+      return 0;
+  }
+}
+
+size_t InterleaveS16_SSE2(const int16_t* const* deinterleaved,
+                          size_t samples_per_channel,
+                          size_t num_channels,
+                          int16_t* interleaved) {
+  switch (num_channels) {
+    case 2:
+      return Interleave<2>(deinterleaved, samples_per_channel, interleaved);
+    case 4:
+      return Interleave<4>(deinterleaved, samples_per_channel, interleaved);
+    case 8:
+      return Interleave<8>(deinterleaved, samples_per_channel, interleaved);
+    default:
+      return 0;
+  }
+}
+
+size_t DownmixStereoToMonoS16_SSE2(const int16_t* interleaved,
+                                   size_t num_frames,
+                                   int16_t* mono) {
+  const __m128i one = _mm_set1_epi16(1);
+  size_t i = 0;
+  for (; i + 8 <= num_frames; i += 8) {
+    const __m128i a = LoadS16(&interleaved[2 * i]);
+    const __m128i b = LoadS16(&interleaved[2 * i + 8]);
+    const __m128i left = Even(a, b);
+    const __m128i right = Odd(a, b);
+    // (left + right) >> 1 without overflowing 16 bits.
+    const __m128i sum = _mm_add_epi16(
+        _mm_add_epi16(_mm_srai_epi16(left, 1), _mm_srai_epi16(right, 1)),
+        _mm_and_si128(_mm_and_si128(left, right), one));
+    StoreS16(sum, &mono[i]);
+  }
+  return i;
+}
+
+}  // namespace webrtc
+
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
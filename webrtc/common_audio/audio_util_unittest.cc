@@ -10,7 +10,10 @@
 
 #include "common_audio/include/audio_util.h"
 
+#include <vector>
+
 #include "rtc_base/arraysize.h"
+#include "rtc_base/random.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -246,5 +249,115 @@ TEST(AudioUtilTest, DownmixToMonoTest) {
   }
 }
 
+// The array conversions take vectorized paths on whole blocks of samples; all
+// lengths must give the same result as the per-sample functions.
+TEST(AudioUtilTest, ArrayConversionsMatchPerSample) {
+  Random random(42);
+  for (size_t size = 0; size < 40; ++size) {
+    std::vector<int16_t> s16(size);
+    std::vector<float> float_s16(size);
+    std::vector<float> unit(size);
+    for (size_t i = 0; i < size; ++i) {
+      s16[i] = static_cast<int16_t>(random.Rand(-32768, 32767));
+      // Out of range values, halves and exact integers.
+      float_s16[i] = i % 3 == 0 ? random.Rand(-40000, 40000) + 0.5f
+                                : (random.Rand<float>() - 0.5f) * 80000.f;
+      unit[i] = (random.Rand<float>() - 0.5f) * 2.5f;
+    }
+    std::vector<int16_t> s16_out(size);
+    std::vector<float> float_out(size);
+
+    S16ToFloat(s16.data(), size, float_out.data());
+    for (size_t i = 0; i < size; ++i)
+      EXPECT_EQ(S16ToFloat(s16[i]), float_out[i]);
+    S16ToFloatS16(s16.data(), size, float_out.data());
+    for (size_t i = 0; i < size; ++i)
+      EXPECT_EQ(static_cast<float>(s16[i]), float_out[i]);
+    FloatS16ToS16(float_s16.data(), size, s16_out.data());
+    for (size_t i = 0; i < size; ++i)
+      EXPECT_EQ(FloatS16ToS16(float_s16[i]), s16_out[i]);
+    FloatToS16(unit.data(), size, s16_out.data());
+    for (size_t i = 0; i < size; ++i)
+      EXPECT_EQ(FloatToS16(unit[i]), s16_out[i]);
+    FloatToFloatS16(unit.data(), size, float_out.data());
+    for (size_t i = 0; i < size; ++i)
+      EXPECT_EQ(FloatToFloatS16(unit[i]), float_out[i]);
+    FloatS16ToFloat(float_s16.data(), size, float_out.data());
+    for (size_t i = 0; i < size; ++i)
+      EXPECT_EQ(FloatS16ToFloat(float_s16[i]), float_out[i]);
+  }
+}
+
+TEST(AudioUtilTest, InterleavingMatchesReference) {
+  Random random(17);
+  for (size_t num_channels = 1; num_channels <= 9; ++num_channels) {
+    for (size_t samples_per_channel : {0, 1, 7, 8, 9, 33, 160, 480}) {
+      std::vector<int16_t> interleaved(num_channels * samples_per_channel);
+      for (int16_t& sample : interleaved) {
+        sample = static_cast<int16_t>(random.Rand(-32768, 32767));
+      }
+      std::vector<std::vector<int16_t>> channels(
+          num_channels, std::vector<int16_t>(samples_per_channel));
+      std::vector<std::vector<float>> float_channels(
+          num_channels, std::vector<float>(samples_per_channel));
+      std::vector<int16_t*> channel_ptrs;
+      std::vector<float*> float_channel_ptrs;
+      for (size_t c = 0; c < num_channels; ++c) {
+        channel_ptrs.push_back(channels[c].data());
+        float_channel_ptrs.push_back(float_channels[c].data());
+      }
+
+      Deinterleave(interleaved.data(), samples_per_channel, num_channels,
+                   channel_ptrs.data());
+      DeinterleaveS16ToFloatS16(interleaved.data(), samples_per_channel,
+                                num_channels, float_channel_ptrs.data());
+      for (size_t c = 0; c < num_channels; ++c) {
+        for (size_t j = 0; j < samples_per_channel; ++j) {
+          ASSERT_EQ(interleaved[j * num_channels + c], channels[c][j]);
+          ASSERT_EQ(interleaved[j * num_channels + c], float_channels[c][j]);
+        }
+      }
+
+      std::vector<int16_t> reinterleaved(interleaved.size());
+      Interleave(channel_ptrs.data(), samples_per_channel, num_channels,
+                 reinterleaved.data());
+      EXPECT_EQ(interleaved, reinterleaved);
+      std::fill(reinterleaved.begin(), reinterleaved.end(), 0);
+      InterleaveFloatS16ToS16(float_channel_ptrs.data(), samples_per_channel,
+                              num_channels, reinterleaved.data());
+      EXPECT_EQ(interleaved, reinterleaved);
+    }
+  }
+}
+
+TEST(AudioUtilTest, InterleaveFloatS16ToS16Saturates) {
+  const float kLeft[] = {40000.f, -40000.f, 1.5f, -1.5f};
+  const float kRight[] = {32767.4f, -32768.f, 0.49f, -0.5f};
+  const float* const deinterleaved[] = {kLeft, kRight};
+  int16_t interleaved[8];
+  InterleaveFloatS16ToS16(deinterleaved, 4, 2, interleaved);
+  const int16_t kExpected[] = {32767, 32767, -32768, -32768, 2, 0, -2, -1};
+  EXPECT_THAT(interleaved, ElementsAreArray(kExpected));
+}
+
+TEST(AudioUtilTest, DownmixStereoToMonoS16) {
+  Random random(3);
+  std::vector<int16_t> interleaved = {32767, 32767, -32768, -32768, 1, -2,
+                                      -1,    0,     3,      4};
+  for (int i = 0; i < 100; ++i) {
+    interleaved.push_back(static_cast<int16_t>(random.Rand(-32768, 32767)));
+  }
+  const size_t num_frames = interleaved.size() / 2;
+  std::vector<int16_t> mono(num_frames);
+  DownmixStereoToMonoS16(interleaved.data(), num_frames, mono.data());
+  EXPECT_EQ(32767, mono[0]);
+  EXPECT_EQ(-32768, mono[1]);
+  EXPECT_EQ(-1, mono[2]);
+  EXPECT_EQ(-1, mono[3]);
+  for (size_t j = 0; j < num_frames; ++j) {
+    EXPECT_EQ((interleaved[2 * j] + interleaved[2 * j + 1]) >> 1, mono[j]);
+  }
+}
+
 }  // namespace
 }  // namespace webrtc
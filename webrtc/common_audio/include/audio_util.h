@@ -143,6 +143,33 @@ void Interleave(const T* const* deinterleaved,
   }
 }
 
+// Specializations with SIMD paths for 2, 4 and 8 channels.
+template <>
+void Deinterleave<int16_t>(const int16_t* interleaved,
+                           size_t samples_per_channel,
+                           size_t num_channels,
+                           int16_t* const* deinterleaved);
+
+template <>
+void Interleave<int16_t>(const int16_t* const* deinterleaved,
+                         size_t samples_per_channel,
+                         size_t num_channels,
+                         int16_t* interleaved);
+
+// Deinterleave() followed by S16ToFloatS16() on each channel, without an
+// intermediate buffer of the whole frame.
+void DeinterleaveS16ToFloatS16(const int16_t* interleaved,
+                               size_t samples_per_channel,
+                               size_t num_channels,
+                               float* const* deinterleaved);
+
+// FloatS16ToS16() on each channel followed by Interleave(), without an
+// intermediate buffer of the whole frame.
+void InterleaveFloatS16ToS16(const float* const* deinterleaved,
+                             size_t samples_per_channel,
+                             size_t num_channels,
+                             int16_t* interleaved);
+
 // Copies audio from a single channel buffer pointed to by |mono| to each
 // channel of |interleaved|. There must be sufficient space allocated in
 // |interleaved| (|samples_per_channel| * |num_channels|).
@@ -209,6 +236,12 @@ void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
                                        int num_channels,
                                        int16_t* deinterleaved);
 
+// Downmixes interleaved stereo to mono as (left + right) >> 1, i.e. the
+// average rounded towards minus infinity.
+void DownmixStereoToMonoS16(const int16_t* interleaved,
+                            size_t num_frames,
+                            int16_t* mono);
+
 }  // namespace webrtc
 
 #endif  // COMMON_AUDIO_INCLUDE_AUDIO_UTIL_H_
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Sum of (vector1[i] * vector2[i]) >> scaling, wrapping like the C version.
+// Unlike the Neon version each product is shifted before the accumulation, so
+// the result is bit exact with WebRtcSpl_CrossCorrelationC().
+static __inline int32_t DotProductWithScaleSse2(const int16_t* vector1,
+                                                const int16_t* vector2,
+                                                size_t length,
+                                                int scaling) {
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  __m128i sum = _mm_setzero_si128();
+  int32_t lanes[4];
+  int32_t sum_res = 0;
+  size_t i = 0;
+
+  if (scaling == 0) {
+    // Without a shift the pairwise sums of _mm_madd_epi16() wrap the same way
+    // as the scalar sum.
+    for (; i + 8 <= length; i += 8) {
+      sum = _mm_add_epi32(
+          sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)&vector1[i]),
+                              _mm_loadu_si128((const __m128i*)&vector2[i])));
+    }
+  } else {
+    for (; i + 8 <= length; i += 8) {
+      const __m128i seq1 = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      const __m128i seq2 = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      const __m128i low = _mm_mullo_epi16(seq1, seq2);
+      const __m128i high = _mm_mulhi_epi16(seq1, seq2);
+      sum = _mm_add_epi32(
+          sum, _mm_sra_epi32(_mm_unpacklo_epi16(low, high), shift));
+      sum = _mm_add_epi32(
+          sum, _mm_sra_epi32(_mm_unpackhi_epi16(low, high), shift));
+    }
+  }
+
+  // Calculate the rest of the samples.
+  for (; i < length; i++) {
+    sum_res += (vector1[i] * vector2[i]) >> scaling;
+  }
+
+  _mm_storeu_si128((__m128i*)lanes, sum);
+  return (int32_t)((uint32_t)lanes[0] + (uint32_t)lanes[1] +
+                   (uint32_t)lanes[2] + (uint32_t)lanes[3] +
+                   (uint32_t)sum_res);
+}
+
+/* SSE2 version of WebRtcSpl_CrossCorrelation() for x86 platforms. */
+void WebRtcSpl_CrossCorrelationSse2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  size_t i = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    *cross_correlation++ =
+        DotProductWithScaleSse2(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include "common_audio/signal_processing/dot_product_with_scale.h"
+#include "rtc_base/system/arch.h"
 
 // Macros specific for the fixed point implementation
 #define WEBRTC_SPL_WORD16_MAX 32767
@@ -524,6 +525,15 @@ void WebRtcSpl_CrossCorrelationNeon(int32_t* cross_correlation,
                                     int right_shifts,
                                     int step_seq2);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+void WebRtcSpl_CrossCorrelationSse2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2);
+#endif
 #if defined(MIPS32_LE)
 void WebRtcSpl_CrossCorrelation_mips(int32_t* cross_correlation,
                                      const int16_t* seq1,
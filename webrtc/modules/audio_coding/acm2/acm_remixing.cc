@@ -10,6 +10,7 @@
 
 #include "modules/audio_coding/acm2/acm_remixing.h"
 
+#include "common_audio/include/audio_util.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -21,11 +22,8 @@ void DownMixFrame(const AudioFrame& input, rtc::ArrayView<int16_t> output) {
   if (input.muted()) {
     std::fill(output.begin(), output.begin() + input.samples_per_channel_, 0);
   } else {
-    const int16_t* const input_data = input.data();
-    for (size_t n = 0; n < input.samples_per_channel_; ++n) {
-      output[n] = rtc::dchecked_cast<int16_t>(
-          (int32_t{input_data[2 * n]} + int32_t{input_data[2 * n + 1]}) >> 1);
-    }
+    DownmixStereoToMonoS16(input.data(), input.samples_per_channel_,
+                           output.data());
   }
 }
 
@@ -46,27 +44,45 @@ void ReMixFrame(const AudioFrame& input,
     return;
   }
 
+  ReMixFrame(rtc::ArrayView<const int16_t>(
+                 input.data(),
+                 input.num_channels_ * input.samples_per_channel_),
+             input.num_channels_, num_output_channels, *output);
+}
+
+void ReMixFrame(rtc::ArrayView<const int16_t> input,
+                size_t num_input_channels,
+                size_t num_output_channels,
+                rtc::ArrayView<int16_t> output) {
   // Ensure that the special case of zero input channels is handled correctly
   // (zero samples per channel is already handled correctly in the code below).
-  if (input.num_channels_ == 0) {
+  if (num_input_channels == 0) {
     return;
   }
 
+  const size_t samples_per_channel = input.size() / num_input_channels;
+  RTC_DCHECK_EQ(input.size(), samples_per_channel * num_input_channels);
+  RTC_DCHECK_EQ(output.size(), samples_per_channel * num_output_channels);
   const int16_t* const input_data = input.data();
   size_t out_index = 0;
 
   // When upmixing is needed and the input is mono copy the left channel
   // into the left and right channels, and set any remaining channels to zero.
-  if (input.num_channels_ == 1 && input.num_channels_ < num_output_channels) {
-    for (size_t k = 0; k < input.samples_per_channel_; ++k) {
-      (*output)[out_index++] = input_data[k];
-      (*output)[out_index++] = input_data[k];
+  if (num_input_channels == 1 && num_input_channels < num_output_channels) {
+    if (num_output_channels == 2) {
+      const int16_t* const channels[] = {input_data, input_data};
+      Interleave(channels, samples_per_channel, 2, output.data());
+      return;
+    }
+    for (size_t k = 0; k < samples_per_channel; ++k) {
+      output[out_index++] = input_data[k];
+      output[out_index++] = input_data[k];
       for (size_t j = 2; j < num_output_channels; ++j) {
-        (*output)[out_index++] = 0;
+        output[out_index++] = 0;
       }
       RTC_DCHECK_EQ(out_index, (k + 1) * num_output_channels);
     }
-    RTC_DCHECK_EQ(out_index, input.samples_per_channel_ * num_output_channels);
+    RTC_DCHECK_EQ(out_index, samples_per_channel * num_output_channels);
     return;
   }
 
@@ -74,38 +90,35 @@ void ReMixFrame(const AudioFrame& input,
 
   // When upmixing is needed and the output is surround, copy the available
   // channels directly, and set the remaining channels to zero.
-  if (input.num_channels_ < num_output_channels) {
-    for (size_t k = 0; k < input.samples_per_channel_; ++k) {
-      for (size_t j = 0; j < input.num_channels_; ++j) {
-        (*output)[out_index++] = input_data[in_index++];
+  if (num_input_channels < num_output_channels) {
+    for (size_t k = 0; k < samples_per_channel; ++k) {
+      for (size_t j = 0; j < num_input_channels; ++j) {
+        output[out_index++] = input_data[in_index++];
       }
-      for (size_t j = input.num_channels_; j < num_output_channels; ++j) {
-        (*output)[out_index++] = 0;
+      for (size_t j = num_input_channels; j < num_output_channels; ++j) {
+        output[out_index++] = 0;
       }
-      RTC_DCHECK_EQ(in_index, (k + 1) * input.num_channels_);
+      RTC_DCHECK_EQ(in_index, (k + 1) * num_input_channels);
       RTC_DCHECK_EQ(out_index, (k + 1) * num_output_channels);
     }
-    RTC_DCHECK_EQ(in_index, input.samples_per_channel_ * input.num_channels_);
-    RTC_DCHECK_EQ(out_index, input.samples_per_channel_ * num_output_channels);
+    RTC_DCHECK_EQ(in_index, samples_per_channel * num_input_channels);
+    RTC_DCHECK_EQ(out_index, samples_per_channel * num_output_channels);
 
     return;
   }
 
   // When downmixing is needed, and the input is stereo, average the channels.
-  if (input.num_channels_ == 2) {
-    for (size_t n = 0; n < input.samples_per_channel_; ++n) {
-      (*output)[n] = rtc::dchecked_cast<int16_t>(
-          (int32_t{input_data[2 * n]} + int32_t{input_data[2 * n + 1]}) >> 1);
-    }
+  if (num_input_channels == 2) {
+    DownmixStereoToMonoS16(input_data, samples_per_channel, output.data());
     return;
   }
 
   // When downmixing is needed, and the input is multichannel, drop the surplus
   // channels.
-  const size_t num_channels_to_drop = input.num_channels_ - num_output_channels;
-  for (size_t k = 0; k < input.samples_per_channel_; ++k) {
+  const size_t num_channels_to_drop = num_input_channels - num_output_channels;
+  for (size_t k = 0; k < samples_per_channel; ++k) {
     for (size_t j = 0; j < num_output_channels; ++j) {
-      (*output)[out_index++] = input_data[in_index++];
+      output[out_index++] = input_data[in_index++];
     }
     in_index += num_channels_to_drop;
   }
@@ -13,6 +13,7 @@
 
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/audio/audio_frame.h"
 
 namespace webrtc {
@@ -29,6 +30,14 @@ void ReMixFrame(const AudioFrame& input,
                 size_t num_output_channels,
                 std::vector<int16_t>* output);
 
+// Remixes the interleaved |input|, which has |num_input_channels| channels, to
+// the interleaved |output|, which has |num_output_channels| channels and the
+// same number of samples per channel. The output must not overlap the input.
+void ReMixFrame(rtc::ArrayView<const int16_t> input,
+                size_t num_input_channels,
+                size_t num_output_channels,
+                rtc::ArrayView<int16_t> output);
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_CODING_ACM2_ACM_REMIXING_H_
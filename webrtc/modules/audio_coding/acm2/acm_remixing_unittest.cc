@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/acm2/acm_remixing.h"
+
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+// Verifies that remixing between raw interleaved buffers gives the same output
+// as remixing the corresponding frame, for all supported input channel counts.
+TEST(AcmRemixing, RemixBuffersMatchesRemixFrame) {
+  constexpr size_t kSamplesPerChannel = 480;
+  Random random_generator(42U);
+  for (size_t num_input_channels : {1, 2, 4, 6, 8}) {
+    for (size_t num_output_channels : {1, 2, 4, 6, 8}) {
+      if (num_input_channels == num_output_channels) {
+        continue;
+      }
+      SCOPED_TRACE(num_input_channels);
+      SCOPED_TRACE(num_output_channels);
+      AudioFrame frame;
+      frame.samples_per_channel_ = kSamplesPerChannel;
+      frame.num_channels_ = num_input_channels;
+      int16_t* data = frame.mutable_data();
+      for (size_t k = 0; k < kSamplesPerChannel * num_input_channels; ++k) {
+        data[k] = random_generator.Rand<int16_t>();
+      }
+
+      std::vector<int16_t> expected;
+      ReMixFrame(frame, num_output_channels, &expected);
+      std::vector<int16_t> output(kSamplesPerChannel * num_output_channels);
+      ReMixFrame(rtc::ArrayView<const int16_t>(
+                     frame.data(), kSamplesPerChannel * num_input_channels),
+                 num_input_channels, num_output_channels, output);
+      EXPECT_EQ(expected, output);
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,250 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Counts the heap allocations and payload copies per 10 ms frame on the ACM
+// send path, from Add10MsData() to the transport, for 48 kHz stereo input.
+// Each codec is run with a transport that copies the payload, as through
+// AudioPacketizationCallback::SendData(), and with one that keeps a reference
+// to the pooled payload from SendEncodedData().
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "api/audio/audio_frame.h"
+#include "modules/audio_coding/codecs/g711/audio_encoder_pcm.h"
+#include "modules/audio_coding/codecs/g722/audio_encoder_g722.h"
+#include "modules/audio_coding/codecs/opus/audio_encoder_opus.h"
+#include "modules/audio_coding/include/audio_coding_module.h"
+#include "rtc_base/checks.h"
+
+ABSL_FLAG(int, frames, 6000, "Number of 10 ms frames to measure per run.");
+ABSL_FLAG(int,
+          warmup_frames,
+          100,
+          "Number of 10 ms frames to encode before measuring, so that "
+          "buffers and pools have reached their steady state size.");
+
+namespace {
+
+std::atomic<size_t> num_allocations{0};
+
+}  // namespace
+
+// Every heap allocation of the process is counted.
+void* operator new(size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kNumChannels = 2;
+constexpr size_t kSamplesPer10Ms = kSampleRateHz / 100;
+// Packets held by the retaining transport, as by a pacer queue.
+constexpr size_t kPacketsInFlight = 4;
+
+class CountingTransport : public AudioPacketizationCallback {
+ public:
+  size_t num_packets() const { return num_packets_; }
+  size_t num_copies() const { return num_copies_; }
+  size_t copied_bytes() const { return copied_bytes_; }
+
+  void ResetCounters() {
+    num_packets_ = 0;
+    num_copies_ = 0;
+    copied_bytes_ = 0;
+  }
+
+ protected:
+  size_t num_packets_ = 0;
+  size_t num_copies_ = 0;
+  size_t copied_bytes_ = 0;
+};
+
+// Copies each payload into its own buffer, like a transport that only
+// implements SendData().
+class CopyingTransport : public CountingTransport {
+ public:
+  CopyingTransport() : packet_(1500) {}
+
+  int32_t SendData(AudioFrameType frame_type,
+                   uint8_t payload_type,
+                   uint32_t timestamp,
+                   const uint8_t* payload_data,
+                   size_t payload_len_bytes,
+                   int64_t absolute_capture_timestamp_ms) override {
+    ++num_packets_;
+    if (payload_len_bytes > 0) {
+      RTC_CHECK_LE(payload_len_bytes, packet_.size());
+      std::copy(payload_data, payload_data + payload_len_bytes,
+                packet_.begin());
+      ++num_copies_;
+      copied_bytes_ += payload_len_bytes;
+    }
+    return 0;
+  }
+
+ private:
+  std::vector<uint8_t> packet_;
+};
+
+// Keeps the last few payloads by reference, without copying them.
+class RetainingTransport : public CountingTransport {
+ public:
+  int32_t SendEncodedData(AudioFrameType frame_type,
+                          uint8_t payload_type,
+                          uint32_t timestamp,
+                          rtc::scoped_refptr<const EncodedAudioPayload> payload,
+                          int64_t absolute_capture_timestamp_ms) override {
+    ++num_packets_;
+    in_flight_[next_++ % in_flight_.size()] = std::move(payload);
+    return 0;
+  }
+
+ private:
+  std::array<rtc::scoped_refptr<const EncodedAudioPayload>, kPacketsInFlight>
+      in_flight_;
+  size_t next_ = 0;
+};
+
+struct Result {
+  double allocations_per_frame;
+  double copies_per_packet;
+  double copied_bytes_per_frame;
+  size_t num_packets;
+};
+
+Result Run(std::unique_ptr<AudioEncoder> encoder,
+           CountingTransport* transport) {
+  const int warmup_frames = absl::GetFlag(FLAGS_warmup_frames);
+  const int frames = absl::GetFlag(FLAGS_frames);
+
+  std::unique_ptr<AudioCodingModule> acm(
+      AudioCodingModule::Create(AudioCodingModule::Config()));
+  acm->SetEncoder(std::move(encoder));
+  acm->RegisterTransportCallback(transport);
+
+  AudioFrame frame;
+  frame.sample_rate_hz_ = kSampleRateHz;
+  frame.num_channels_ = kNumChannels;
+  frame.samples_per_channel_ = kSamplesPer10Ms;
+  double phase = 0.0;
+  auto add_frame = [&] {
+    int16_t* data = frame.mutable_data();
+    for (size_t i = 0; i < kSamplesPer10Ms; ++i) {
+      data[kNumChannels * i] = static_cast<int16_t>(8000 * sin(phase));
+      data[kNumChannels * i + 1] = static_cast<int16_t>(6000 * cos(phase));
+      phase += 2 * M_PI * 440.0 / kSampleRateHz;
+    }
+    RTC_CHECK_GE(acm->Add10MsData(frame), 0);
+    frame.timestamp_ += kSamplesPer10Ms;
+  };
+
+  for (int i = 0; i < warmup_frames; ++i) {
+    add_frame();
+  }
+  transport->ResetCounters();
+  const size_t allocations_before = num_allocations.load();
+  for (int i = 0; i < frames; ++i) {
+    add_frame();
+  }
+  const size_t allocations = num_allocations.load() - allocations_before;
+
+  Result result;
+  result.allocations_per_frame = static_cast<double>(allocations) / frames;
+  result.copies_per_packet =
+      transport->num_packets() > 0
+          ? static_cast<double>(transport->num_copies()) /
+                transport->num_packets()
+          : 0.0;
+  result.copied_bytes_per_frame =
+      static_cast<double>(transport->copied_bytes()) / frames;
+  result.num_packets = transport->num_packets();
+  return result;
+}
+
+struct Codec {
+  const char* name;
+  std::function<std::unique_ptr<AudioEncoder>()> create;
+};
+
+void RunAll() {
+  const Codec codecs[] = {
+      {"opus",
+       [] {
+         AudioEncoderOpusConfig config;
+         config.num_channels = kNumChannels;
+         config.bitrate_bps = 64000;
+         return std::unique_ptr<AudioEncoder>(
+             new AudioEncoderOpusImpl(config, 111));
+       }},
+      {"g722",
+       [] {
+         AudioEncoderG722Config config;
+         config.num_channels = kNumChannels;
+         return std::unique_ptr<AudioEncoder>(
+             new AudioEncoderG722Impl(config, 9));
+       }},
+      {"pcmu",
+       [] {
+         AudioEncoderPcmU::Config config;
+         config.num_channels = kNumChannels;
+         return std::unique_ptr<AudioEncoder>(new AudioEncoderPcmU(config));
+       }},
+  };
+
+  printf("%-6s %-10s %11s %13s %17s %8s\n", "codec", "transport",
+         "allocs/10ms", "copies/packet", "copied bytes/10ms", "packets");
+  for (const Codec& codec : codecs) {
+    CopyingTransport copying;
+    RetainingTransport retaining;
+    const std::pair<const char*, CountingTransport*> transports[] = {
+        {"copying", &copying}, {"retaining", &retaining}};
+    for (const auto& transport : transports) {
+      const Result result = Run(codec.create(), transport.second);
+      printf("%-6s %-10s %11.2f %13.2f %17.1f %8zu\n", codec.name,
+             transport.first, result.allocations_per_frame,
+             result.copies_per_packet, result.copied_bytes_per_frame,
+             result.num_packets);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  absl::ParseCommandLine(argc, argv);
+  webrtc::RunAll();
+  return 0;
+}
@@ -19,12 +19,14 @@
 #include "modules/audio_coding/acm2/acm_receiver.h"
 #include "modules/audio_coding/acm2/acm_remixing.h"
 #include "modules/audio_coding/acm2/acm_resampler.h"
+#include "modules/audio_coding/acm2/encoded_audio_payload_pool.h"
 #include "modules/include/module_common_types.h"
 #include "modules/include/module_common_types_public.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/aligned_malloc.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/thread_annotations.h"
 #include "system_wrappers/include/metrics.h"
@@ -33,12 +35,17 @@ namespace webrtc {
 
 namespace {
 
-// Initial size for the buffer in InputBuffer. This matches 6 channels of 10 ms
-// 48 kHz data.
-constexpr size_t kInitialInputDataBufferSize = 6 * 480;
-
 constexpr int32_t kMaxInputSampleRateHz = 192000;
 
+// Number of encoded payloads that can be held by the transport at the same
+// time before the payload pool has to allocate.
+constexpr size_t kMaxPooledPayloads = 8;
+
+// Size and alignment of the scratch buffers for the preprocessing of the
+// input.
+constexpr size_t kScratchBufferSamples = AudioFrame::kMaxDataSizeSamples;
+constexpr size_t kScratchAlignment = 64;
+
 class AudioCodingModuleImpl final : public AudioCodingModule {
  public:
   explicit AudioCodingModuleImpl(const AudioCodingModule::Config& config);
@@ -99,14 +106,11 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
 
  private:
   struct InputData {
-    InputData() : buffer(kInitialInputDataBufferSize) {}
     uint32_t input_timestamp;
+    // Points either to the input frame or to one of |scratch_buffers_|.
     const int16_t* audio;
     size_t length_per_channel;
     size_t audio_channel;
-    // If a re-mix is required (up or down), this buffer will store a re-mixed
-    // version of the input.
-    std::vector<int16_t> buffer;
   };
 
   InputData input_data_ RTC_GUARDED_BY(acm_crit_sect_);
@@ -145,15 +149,18 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
   // required, before pushing audio into encoder's buffer.
   //
   // in_frame: input audio-frame
-  // ptr_out: pointer to output audio_frame. If no preprocessing is required
-  //          |ptr_out| will be pointing to |in_frame|, otherwise pointing to
-  //          |preprocess_frame_|.
+  // input_data: the preprocessed audio, with its timestamp in the encoder's
+  //          sample rate. If no preprocessing is required, its audio points to
+  //          the data of |in_frame|, otherwise to one of |scratch_buffers_|.
   //
   // Return value:
   //   -1: if encountering an error.
   //    0: otherwise.
-  int PreprocessToAddData(const AudioFrame& in_frame,
-                          const AudioFrame** ptr_out)
+  int PreprocessToAddData(const AudioFrame& in_frame, InputData* input_data)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(acm_crit_sect_);
+
+  // Returns the scratch buffer that |audio| does not point to.
+  int16_t* OtherScratchBuffer(const int16_t* audio)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(acm_crit_sect_);
 
   // Change required states after starting to receive the codec corresponding
@@ -161,7 +168,7 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
   int UpdateUponReceivingCodec(int index);
 
   rtc::CriticalSection acm_crit_sect_;
-  rtc::Buffer encode_buffer_ RTC_GUARDED_BY(acm_crit_sect_);
+  acm2::EncodedAudioPayloadPool payload_pool_ RTC_GUARDED_BY(acm_crit_sect_);
   uint32_t expected_codec_ts_ RTC_GUARDED_BY(acm_crit_sect_);
   uint32_t expected_in_ts_ RTC_GUARDED_BY(acm_crit_sect_);
   acm2::ACMResampler resampler_ RTC_GUARDED_BY(acm_crit_sect_);
@@ -176,7 +183,10 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
 
   bool receiver_initialized_ RTC_GUARDED_BY(acm_crit_sect_);
 
-  AudioFrame preprocess_frame_ RTC_GUARDED_BY(acm_crit_sect_);
+  // The down-mix, the resampling and the remix of the input each read the
+  // output of the previous step, and write into the other of these buffers.
+  std::unique_ptr<int16_t[], AlignedFreeDeleter> scratch_buffers_[2]
+      RTC_GUARDED_BY(acm_crit_sect_);
   bool first_10ms_data_ RTC_GUARDED_BY(acm_crit_sect_);
 
   bool first_frame_ RTC_GUARDED_BY(acm_crit_sect_);
@@ -215,7 +225,8 @@ void AudioCodingModuleImpl::ChangeLogger::MaybeLog(int value) {
 
 AudioCodingModuleImpl::AudioCodingModuleImpl(
     const AudioCodingModule::Config& config)
-    : expected_codec_ts_(0xD87F3F9F),
+    : payload_pool_(kMaxPooledPayloads),
+      expected_codec_ts_(0xD87F3F9F),
       expected_in_ts_(0xD87F3F9F),
       receiver_(config),
       bitrate_logger_("WebRTC.Audio.TargetBitrateInKbps"),
@@ -230,6 +241,10 @@ AudioCodingModuleImpl::AudioCodingModuleImpl(
 #endif
       codec_histogram_bins_log_(),
       number_of_consecutive_empty_packets_(0) {
+  for (auto& buffer : scratch_buffers_) {
+    buffer.reset(AlignedMalloc<int16_t>(kScratchBufferSamples * sizeof(int16_t),
+                                        kScratchAlignment));
+  }
   if (InitializeReceiverSafe() < 0) {
     RTC_LOG(LS_ERROR) << "Cannot initialize receiver";
   }
@@ -269,17 +284,18 @@ int32_t AudioCodingModuleImpl::Encode(
   last_rtp_timestamp_ = rtp_timestamp;
   first_frame_ = false;
 
-  // Clear the buffer before reuse - encoded data will get appended.
-  encode_buffer_.Clear();
+  // The encoder appends to an empty pooled buffer, which is then handed to the
+  // transport as is.
+  rtc::scoped_refptr<EncodedAudioPayload> payload = payload_pool_.Get();
   encoded_info = encoder_stack_->Encode(
       rtp_timestamp,
       rtc::ArrayView<const int16_t>(
           input_data.audio,
           input_data.audio_channel * input_data.length_per_channel),
-      &encode_buffer_);
+      payload.get());
 
   bitrate_logger_.MaybeLog(encoder_stack_->GetTargetBitrate() / 1000);
-  if (encode_buffer_.size() == 0 && !encoded_info.send_even_if_empty) {
+  if (payload->size() == 0 && !encoded_info.send_even_if_empty) {
     // Not enough data.
     return 0;
   }
@@ -300,11 +316,11 @@ int32_t AudioCodingModuleImpl::Encode(
   }
 
   AudioFrameType frame_type;
-  if (encode_buffer_.size() == 0 && encoded_info.send_even_if_empty) {
+  if (payload->size() == 0 && encoded_info.send_even_if_empty) {
     frame_type = AudioFrameType::kEmptyFrame;
     encoded_info.payload_type = previous_pltype;
   } else {
-    RTC_DCHECK_GT(encode_buffer_.size(), 0);
+    RTC_DCHECK_GT(payload->size(), 0);
     frame_type = encoded_info.speech ? AudioFrameType::kAudioFrameSpeech
                                      : AudioFrameType::kAudioFrameCN;
   }
@@ -312,11 +328,11 @@ int32_t AudioCodingModuleImpl::Encode(
 #ifndef DISABLE_RECORDER
   {
     rtc::CritScope lock(&recorder_lock_);
-    if (encode_buffer_.size() > 0 && recorder_) {
+    if (payload->size() > 0 && recorder_) {
       recorder_->AddAudioFrame(encoder_stack_->SampleRateHz(),
                                encoder_stack_->NumChannels(),
-                               encode_buffer_.data(),
-                               encode_buffer_.size(),
+                               payload->data(),
+                               payload->size(),
                                encoded_info.encoder_type);
     }
   }
@@ -325,14 +341,13 @@ int32_t AudioCodingModuleImpl::Encode(
   {
     rtc::CritScope lock(&callback_crit_sect_);
     if (packetization_callback_) {
-      packetization_callback_->SendData(
+      packetization_callback_->SendEncodedData(
           frame_type, encoded_info.payload_type, encoded_info.encoded_timestamp,
-          encode_buffer_.data(), encode_buffer_.size(),
-          absolute_capture_timestamp_ms.value_or(-1));
+          payload, absolute_capture_timestamp_ms.value_or(-1));
     }
   }
   previous_pltype_ = encoded_info.payload_type;
-  return static_cast<int32_t>(encode_buffer_.size());
+  return static_cast<int32_t>(payload->size());
 }
 
 /////////////////////////////////////////
@@ -399,51 +414,50 @@ int AudioCodingModuleImpl::Add10MsDataInternal(const AudioFrame& audio_frame,
     return -1;
   }
 
-  const AudioFrame* ptr_frame;
   // Perform a resampling, also down-mix if it is required and can be
   // performed before resampling (a down mix prior to resampling will take
   // place if both primary and secondary encoders are mono and input is in
   // stereo).
-  if (PreprocessToAddData(audio_frame, &ptr_frame) < 0) {
+  if (PreprocessToAddData(audio_frame, input_data) < 0) {
     return -1;
   }
 
   // Check whether we need an up-mix or down-mix?
   const size_t current_num_channels = encoder_stack_->NumChannels();
-  const bool same_num_channels =
-      ptr_frame->num_channels_ == current_num_channels;
-
-  // TODO(yujo): Skip encode of muted frames.
-  input_data->input_timestamp = ptr_frame->timestamp_;
-  input_data->length_per_channel = ptr_frame->samples_per_channel_;
-  input_data->audio_channel = current_num_channels;
-
-  if (!same_num_channels) {
-    // Remixes the input frame to the output data and in the process resize the
-    // output data if needed.
-    ReMixFrame(*ptr_frame, current_num_channels, &input_data->buffer);
-
-    // For pushing data to primary, point the |ptr_audio| to correct buffer.
-    input_data->audio = input_data->buffer.data();
-    RTC_DCHECK_GE(input_data->buffer.size(),
-                  input_data->length_per_channel * input_data->audio_channel);
-  } else {
-    // When adding data to encoders this pointer is pointing to an audio buffer
-    // with correct number of channels.
-    input_data->audio = ptr_frame->data();
+  if (input_data->audio_channel != current_num_channels) {
+    const size_t length = input_data->length_per_channel * current_num_channels;
+    if (length > kScratchBufferSamples) {
+      RTC_LOG(LS_ERROR) << "Cannot Add 10 ms audio, too many channels.";
+      return -1;
+    }
+    // Remixes the audio into the scratch buffer that does not hold it.
+    int16_t* remixed = OtherScratchBuffer(input_data->audio);
+    ReMixFrame(rtc::ArrayView<const int16_t>(
+                   input_data->audio,
+                   input_data->length_per_channel * input_data->audio_channel),
+               input_data->audio_channel, current_num_channels,
+               rtc::ArrayView<int16_t>(remixed, length));
+    input_data->audio = remixed;
+    input_data->audio_channel = current_num_channels;
   }
 
+  // TODO(yujo): Skip encode of muted frames.
   return 0;
 }
 
+int16_t* AudioCodingModuleImpl::OtherScratchBuffer(const int16_t* audio) {
+  return audio == scratch_buffers_[0].get() ? scratch_buffers_[1].get()
+                                            : scratch_buffers_[0].get();
+}
+
 // Perform a resampling and down-mix if required. We down-mix only if
 // encoder is mono and input is stereo. In case of dual-streaming, both
 // encoders has to be mono for down-mix to take place.
-// |*ptr_out| will point to the pre-processed audio-frame. If no pre-processing
-// is required, |*ptr_out| points to |in_frame|.
+// |input_data->audio| will point to the pre-processed audio. If no
+// pre-processing is required, it points to the data of |in_frame|.
 // TODO(yujo): Make this more efficient for muted frames.
 int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
-                                               const AudioFrame** ptr_out) {
+                                               InputData* input_data) {
   const bool resample =
       in_frame.sample_rate_hz_ != encoder_stack_->SampleRateHz();
 
@@ -469,71 +483,41 @@ int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
     expected_in_ts_ = in_frame.timestamp_;
   }
 
-  if (!down_mix && !resample) {
-    // No pre-processing is required.
-    if (expected_in_ts_ == expected_codec_ts_) {
-      // If we've never resampled, we can use the input frame as-is
-      *ptr_out = &in_frame;
-    } else {
-      // Otherwise we'll need to alter the timestamp. Since in_frame is const,
-      // we'll have to make a copy of it.
-      preprocess_frame_.CopyFrom(in_frame);
-      preprocess_frame_.timestamp_ = expected_codec_ts_;
-      *ptr_out = &preprocess_frame_;
-    }
-
-    expected_in_ts_ += static_cast<uint32_t>(in_frame.samples_per_channel_);
-    expected_codec_ts_ += static_cast<uint32_t>(in_frame.samples_per_channel_);
-    return 0;
-  }
+  input_data->input_timestamp = expected_codec_ts_;
+  input_data->audio = in_frame.data();
+  input_data->length_per_channel = in_frame.samples_per_channel_;
+  input_data->audio_channel = in_frame.num_channels_;
 
-  *ptr_out = &preprocess_frame_;
-  preprocess_frame_.num_channels_ = in_frame.num_channels_;
-  preprocess_frame_.samples_per_channel_ = in_frame.samples_per_channel_;
-  std::array<int16_t, AudioFrame::kMaxDataSizeSamples> audio;
-  const int16_t* src_ptr_audio;
   if (down_mix) {
-    // If a resampling is required, the output of a down-mix is written into a
-    // local buffer, otherwise, it will be written to the output frame.
-    int16_t* dest_ptr_audio =
-        resample ? audio.data() : preprocess_frame_.mutable_data();
-    RTC_DCHECK_GE(audio.size(), preprocess_frame_.samples_per_channel_);
-    RTC_DCHECK_GE(audio.size(), in_frame.samples_per_channel_);
-    DownMixFrame(in_frame,
-                 rtc::ArrayView<int16_t>(
-                     dest_ptr_audio, preprocess_frame_.samples_per_channel_));
-    preprocess_frame_.num_channels_ = 1;
-
-    // Set the input of the resampler to the down-mixed signal.
-    src_ptr_audio = audio.data();
-  } else {
-    // Set the input of the resampler to the original data.
-    src_ptr_audio = in_frame.data();
+    // The input is at most 10 ms of 192 kHz stereo, and fits in the scratch
+    // buffer.
+    int16_t* down_mixed = scratch_buffers_[0].get();
+    DownMixFrame(in_frame, rtc::ArrayView<int16_t>(
+                               down_mixed, in_frame.samples_per_channel_));
+    input_data->audio = down_mixed;
+    input_data->audio_channel = 1;
   }
 
-  preprocess_frame_.timestamp_ = expected_codec_ts_;
-  preprocess_frame_.sample_rate_hz_ = in_frame.sample_rate_hz_;
   // If it is required, we have to do a resampling.
   if (resample) {
-    // The result of the resampler is written to output frame.
-    int16_t* dest_ptr_audio = preprocess_frame_.mutable_data();
-
+    // The result of the resampler is written to the scratch buffer that does
+    // not hold its input.
+    int16_t* resampled = OtherScratchBuffer(input_data->audio);
     int samples_per_channel = resampler_.Resample10Msec(
-        src_ptr_audio, in_frame.sample_rate_hz_, encoder_stack_->SampleRateHz(),
-        preprocess_frame_.num_channels_, AudioFrame::kMaxDataSizeSamples,
-        dest_ptr_audio);
+        input_data->audio, in_frame.sample_rate_hz_,
+        encoder_stack_->SampleRateHz(), input_data->audio_channel,
+        kScratchBufferSamples, resampled);
 
     if (samples_per_channel < 0) {
       RTC_LOG(LS_ERROR) << "Cannot add 10 ms audio, resampling failed";
       return -1;
     }
-    preprocess_frame_.samples_per_channel_ =
-        static_cast<size_t>(samples_per_channel);
-    preprocess_frame_.sample_rate_hz_ = encoder_stack_->SampleRateHz();
+    input_data->audio = resampled;
+    input_data->length_per_channel = static_cast<size_t>(samples_per_channel);
   }
 
   expected_codec_ts_ +=
-      static_cast<uint32_t>(preprocess_frame_.samples_per_channel_);
+      static_cast<uint32_t>(input_data->length_per_channel);
   expected_in_ts_ += static_cast<uint32_t>(in_frame.samples_per_channel_);
 
   return 0;
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/acm2/encoded_audio_payload_pool.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace acm2 {
+
+EncodedAudioPayloadPool::EncodedAudioPayloadPool(size_t max_pooled_payloads)
+    : max_pooled_payloads_(max_pooled_payloads) {
+  RTC_DCHECK_GT(max_pooled_payloads_, 0);
+  payloads_.reserve(max_pooled_payloads_);
+}
+
+EncodedAudioPayloadPool::~EncodedAudioPayloadPool() = default;
+
+rtc::scoped_refptr<EncodedAudioPayload> EncodedAudioPayloadPool::Get() {
+  // Search round robin from the buffer after the one returned last, which is
+  // the one most likely to have been released by now.
+  for (size_t i = 0; i < payloads_.size(); ++i) {
+    const size_t index = (next_payload_ + i) % payloads_.size();
+    if (payloads_[index]->HasOneRef()) {
+      next_payload_ = (index + 1) % payloads_.size();
+      payloads_[index]->Clear();
+      return payloads_[index];
+    }
+  }
+
+  ++num_allocations_;
+  rtc::scoped_refptr<EncodedAudioPayload> payload(
+      new EncodedAudioPayload());
+  if (payloads_.size() < max_pooled_payloads_) {
+    payloads_.push_back(payload);
+    next_payload_ = 0;
+  }
+  return payload;
+}
+
+}  // namespace acm2
+}  // namespace webrtc
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_ACM2_ENCODED_AUDIO_PAYLOAD_POOL_H_
+#define MODULES_AUDIO_CODING_ACM2_ENCODED_AUDIO_PAYLOAD_POOL_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "modules/audio_coding/include/audio_coding_module.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+namespace acm2 {
+
+// Hands out reference counted buffers for encoded payloads. A buffer goes back
+// to the pool when the last reference outside the pool is released, and is
+// then reused with its capacity intact, so that encoding into it and handing
+// it to the transport does not allocate once the pool is warm.
+class EncodedAudioPayloadPool {
+ public:
+  // At most |max_pooled_payloads| buffers are kept. If all of them are still
+  // referenced, e.g. queued in the transport, Get() allocates a buffer that is
+  // not pooled.
+  explicit EncodedAudioPayloadPool(size_t max_pooled_payloads);
+  ~EncodedAudioPayloadPool();
+
+  // Returns an empty buffer that is referenced nowhere else.
+  rtc::scoped_refptr<EncodedAudioPayload> Get();
+
+  // Number of buffers allocated by Get() so far, pooled or not.
+  size_t num_allocations() const { return num_allocations_; }
+
+ private:
+  const size_t max_pooled_payloads_;
+  std::vector<rtc::scoped_refptr<EncodedAudioPayload>> payloads_;
+  size_t next_payload_ = 0;
+  size_t num_allocations_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(EncodedAudioPayloadPool);
+};
+
+}  // namespace acm2
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_ACM2_ENCODED_AUDIO_PAYLOAD_POOL_H_
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/acm2/encoded_audio_payload_pool.h"
+
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace acm2 {
+
+TEST(EncodedAudioPayloadPoolTest, ReusesReleasedPayload) {
+  EncodedAudioPayloadPool pool(2);
+  const uint8_t kPayload[] = {1, 2, 3, 4};
+  const EncodedAudioPayload* first = nullptr;
+  size_t capacity = 0;
+  {
+    rtc::scoped_refptr<EncodedAudioPayload> payload = pool.Get();
+    payload->AppendData(kPayload);
+    first = payload.get();
+    capacity = payload->capacity();
+  }
+  rtc::scoped_refptr<EncodedAudioPayload> payload = pool.Get();
+  EXPECT_EQ(first, payload.get());
+  EXPECT_EQ(0u, payload->size());
+  EXPECT_EQ(capacity, payload->capacity());
+  EXPECT_EQ(1u, pool.num_allocations());
+}
+
+TEST(EncodedAudioPayloadPoolTest, DoesNotReuseReferencedPayload) {
+  EncodedAudioPayloadPool pool(2);
+  rtc::scoped_refptr<const EncodedAudioPayload> held = pool.Get();
+  rtc::scoped_refptr<EncodedAudioPayload> payload = pool.Get();
+  EXPECT_NE(held.get(), payload.get());
+  EXPECT_EQ(2u, pool.num_allocations());
+}
+
+TEST(EncodedAudioPayloadPoolTest, AllocatesBeyondPoolSize) {
+  EncodedAudioPayloadPool pool(2);
+  std::vector<rtc::scoped_refptr<EncodedAudioPayload>> held;
+  for (int i = 0; i < 3; ++i) {
+    held.push_back(pool.Get());
+  }
+  EXPECT_EQ(3u, pool.num_allocations());
+
+  // Only the two pooled payloads are reused once released.
+  held.clear();
+  for (int i = 0; i < 2; ++i) {
+    held.push_back(pool.Get());
+  }
+  EXPECT_EQ(3u, pool.num_allocations());
+  held.push_back(pool.Get());
+  EXPECT_EQ(4u, pool.num_allocations());
+}
+
+}  // namespace acm2
+}  // namespace webrtc
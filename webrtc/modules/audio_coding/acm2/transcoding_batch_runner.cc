@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/acm2/transcoding_batch_runner.h"
+
+#include <algorithm>
+#include <string>
+
+#include "modules/audio_coding/acm2/transcoding_session.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+
+namespace webrtc {
+
+namespace {
+
+// Number of sessions claimed at a time. Large enough to keep the claims off
+// the profile, small enough to balance the load at the end of a tick.
+constexpr size_t kSessionsPerClaim = 16;
+
+}  // namespace
+
+// A thread that calls ProcessSessions() once for every tick.
+class TranscodingBatchRunner::Worker {
+ public:
+  Worker(TranscodingBatchRunner* runner, int index)
+      : runner_(runner),
+        thread_(&Worker::Run,
+                this,
+                "TranscodingWorker" + std::to_string(index)) {
+    thread_.Start();
+  }
+
+  ~Worker() {
+    stopping_ = true;
+    start_.Set();
+    thread_.Stop();
+  }
+
+  void StartTick() { start_.Set(); }
+  void WaitForTick() { done_.Wait(rtc::Event::kForever); }
+
+ private:
+  static void Run(void* obj) { static_cast<Worker*>(obj)->Process(); }
+
+  void Process() {
+    while (true) {
+      start_.Wait(rtc::Event::kForever);
+      if (stopping_) {
+        return;
+      }
+      runner_->ProcessSessions();
+      done_.Set();
+    }
+  }
+
+  TranscodingBatchRunner* const runner_;
+  rtc::Event start_;
+  rtc::Event done_;
+  std::atomic<bool> stopping_{false};
+  rtc::PlatformThread thread_;
+};
+
+TranscodingBatchRunner::TranscodingBatchRunner(int num_threads) {
+  RTC_DCHECK_GE(num_threads, 1);
+  for (int i = 1; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>(this, i));
+  }
+}
+
+TranscodingBatchRunner::~TranscodingBatchRunner() = default;
+
+void TranscodingBatchRunner::AddSession(TranscodingSession* session) {
+  RTC_DCHECK(session);
+  RTC_DCHECK(std::none_of(
+      entries_.begin(), entries_.end(),
+      [session](const Entry& entry) { return entry.session == session; }));
+  entries_.push_back(Entry{session, SessionStats()});
+}
+
+void TranscodingBatchRunner::RemoveSession(TranscodingSession* session) {
+  auto it = std::find_if(
+      entries_.begin(), entries_.end(),
+      [session](const Entry& entry) { return entry.session == session; });
+  RTC_DCHECK(it != entries_.end());
+  if (it != entries_.end()) {
+    // The order of the sessions does not matter.
+    *it = entries_.back();
+    entries_.pop_back();
+  }
+}
+
+void TranscodingBatchRunner::RunTick() {
+  next_index_.store(0, std::memory_order_relaxed);
+  for (auto& worker : workers_) {
+    worker->StartTick();
+  }
+  ProcessSessions();
+  for (auto& worker : workers_) {
+    worker->WaitForTick();
+  }
+}
+
+TranscodingBatchRunner::SessionStats TranscodingBatchRunner::GetSessionStats(
+    const TranscodingSession* session) const {
+  auto it = std::find_if(
+      entries_.begin(), entries_.end(),
+      [session](const Entry& entry) { return entry.session == session; });
+  RTC_DCHECK(it != entries_.end());
+  return it != entries_.end() ? it->stats : SessionStats();
+}
+
+void TranscodingBatchRunner::ProcessSessions() {
+  const size_t num_entries = entries_.size();
+  while (true) {
+    const size_t begin =
+        next_index_.fetch_add(kSessionsPerClaim, std::memory_order_relaxed);
+    if (begin >= num_entries) {
+      return;
+    }
+    const size_t end = std::min(begin + kSessionsPerClaim, num_entries);
+    for (size_t i = begin; i < end; ++i) {
+      // Only this thread touches the entry during the tick.
+      Entry& entry = entries_[i];
+      const int64_t start_ns = rtc::GetThreadCpuTimeNanos();
+      const int result = entry.session->Process10Ms();
+      entry.stats.cpu_time_ns += rtc::GetThreadCpuTimeNanos() - start_ns;
+      ++entry.stats.ticks;
+      if (result < 0) {
+        ++entry.stats.errors;
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_ACM2_TRANSCODING_BATCH_RUNNER_H_
+#define MODULES_AUDIO_CODING_ACM2_TRANSCODING_BATCH_RUNNER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+
+class TranscodingSession;
+
+// Runs TranscodingSession::Process10Ms() on a batch of sessions once per
+// tick, spread over a pool of threads, and keeps track of the thread CPU time
+// spent on each session.
+//
+// Sessions are claimed by the threads in small chunks, so that a few
+// expensive sessions do not hold back the whole tick. A session is processed
+// by at most one thread per tick, but not necessarily by the same thread in
+// consecutive ticks.
+//
+// All methods must be called from the same thread.
+class TranscodingBatchRunner {
+ public:
+  struct SessionStats {
+    // Thread CPU time spent in Process10Ms().
+    int64_t cpu_time_ns = 0;
+    // Number of calls to Process10Ms(), and how many of them failed.
+    int ticks = 0;
+    int errors = 0;
+  };
+
+  // |num_threads| includes the thread calling RunTick(), so a runner with one
+  // thread processes all sessions on the calling thread.
+  explicit TranscodingBatchRunner(int num_threads);
+  ~TranscodingBatchRunner();
+
+  // The session must stay alive until it is removed or the runner destroyed.
+  void AddSession(TranscodingSession* session);
+  void RemoveSession(TranscodingSession* session);
+  size_t num_sessions() const { return entries_.size(); }
+
+  // Processes 10 ms of every session, and returns when all are done.
+  void RunTick();
+
+  // Returns the statistics of |session| since it was added.
+  SessionStats GetSessionStats(const TranscodingSession* session) const;
+
+ private:
+  class Worker;
+
+  struct Entry {
+    TranscodingSession* session;
+    SessionStats stats;
+  };
+
+  // Claims and processes chunks of sessions until there are none left in this
+  // tick.
+  void ProcessSessions();
+
+  std::vector<Entry> entries_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Index of the next session to claim in the current tick.
+  std::atomic<size_t> next_index_{0};
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(TranscodingBatchRunner);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_ACM2_TRANSCODING_BATCH_RUNNER_H_
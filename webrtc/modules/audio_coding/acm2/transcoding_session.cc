@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/acm2/transcoding_session.h"
+
+#include <utility>
+
+#include "api/rtp_headers.h"
+#include "modules/audio_coding/acm2/acm_remixing.h"
+#include "modules/audio_coding/neteq/default_neteq_factory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr size_t kMaxPooledPayloads = 4;
+
+std::unique_ptr<NetEq> CreateNetEq(const TranscodingSession::Config& config) {
+  Clock* const clock =
+      config.clock ? config.clock : Clock::GetRealTimeClock();
+  if (config.neteq_factory) {
+    return config.neteq_factory->CreateNetEq(config.neteq_config,
+                                             config.decoder_factory, clock);
+  }
+  return DefaultNetEqFactory().CreateNetEq(config.neteq_config,
+                                           config.decoder_factory, clock);
+}
+
+}  // namespace
+
+TranscodingSession::Config::Config() = default;
+TranscodingSession::Config::Config(const Config&) = default;
+TranscodingSession::Config::~Config() = default;
+
+TranscodingSession::TranscodingSession(const Config& config,
+                                       std::unique_ptr<AudioEncoder> encoder,
+                                       AudioPacketizationCallback* transport)
+    : neteq_(CreateNetEq(config)),
+      encoder_(std::move(encoder)),
+      transport_(transport),
+      payload_pool_(kMaxPooledPayloads),
+      rtp_timestamp_(config.initial_rtp_timestamp) {
+  RTC_DCHECK(encoder_);
+  RTC_DCHECK(transport_);
+  neteq_->SetCodecs(config.receive_codecs);
+}
+
+TranscodingSession::~TranscodingSession() = default;
+
+int TranscodingSession::InsertPacket(const RTPHeader& rtp_header,
+                                     rtc::ArrayView<const uint8_t> payload) {
+  rtc::CritScope lock(&crit_sect_);
+  if (payload.empty()) {
+    neteq_->InsertEmptyPacket(rtp_header);
+    return 0;
+  }
+  if (neteq_->InsertPacket(rtp_header, payload) != NetEq::kOK) {
+    RTC_LOG(LERROR) << "TranscodingSession::InsertPacket failed for payload "
+                       "type "
+                    << static_cast<int>(rtp_header.payloadType);
+    return -1;
+  }
+  return 0;
+}
+
+int TranscodingSession::Process10Ms() {
+  rtc::CritScope lock(&crit_sect_);
+  bool muted = false;
+  if (neteq_->GetAudio(&decoded_frame_, &muted) != NetEq::kOK) {
+    RTC_LOG(LERROR) << "TranscodingSession::Process10Ms: NetEq failed";
+    return -1;
+  }
+  const rtc::ArrayView<const int16_t> audio = ConvertDecodedFrame();
+  if (audio.empty()) {
+    return -1;
+  }
+  return Encode(audio);
+}
+
+void TranscodingSession::SetEncoder(std::unique_ptr<AudioEncoder> encoder) {
+  RTC_DCHECK(encoder);
+  rtc::CritScope lock(&crit_sect_);
+  encoder_ = std::move(encoder);
+}
+
+void TranscodingSession::OnReceivedUplinkPacketLossFraction(
+    float packet_loss_fraction) {
+  rtc::CritScope lock(&crit_sect_);
+  encoder_->OnReceivedUplinkPacketLossFraction(packet_loss_fraction);
+}
+
+rtc::ArrayView<const int16_t> TranscodingSession::ConvertDecodedFrame() {
+  const size_t encoder_channels = encoder_->NumChannels();
+  const int encoder_rate_hz = encoder_->SampleRateHz();
+  const AudioFrame* frame = &decoded_frame_;
+  const int16_t* audio = decoded_frame_.data();
+  size_t num_channels = decoded_frame_.num_channels_;
+  size_t samples_per_channel = decoded_frame_.samples_per_channel_;
+
+  // Down-mix before resampling, so that fewer channels are resampled.
+  if (num_channels > encoder_channels) {
+    ReMixFrame(decoded_frame_, encoder_channels, &remix_buffer_);
+    audio = remix_buffer_.data();
+    num_channels = encoder_channels;
+  }
+
+  if (decoded_frame_.sample_rate_hz_ != encoder_rate_hz) {
+    const int samples = resampler_.Resample10Msec(
+        audio, decoded_frame_.sample_rate_hz_, encoder_rate_hz, num_channels,
+        AudioFrame::kMaxDataSizeSamples, resampled_frame_.mutable_data());
+    if (samples < 0) {
+      RTC_LOG(LERROR) << "TranscodingSession: resampling from "
+                      << decoded_frame_.sample_rate_hz_ << " to "
+                      << encoder_rate_hz << " Hz failed";
+      return rtc::ArrayView<const int16_t>();
+    }
+    resampled_frame_.samples_per_channel_ = static_cast<size_t>(samples);
+    resampled_frame_.num_channels_ = num_channels;
+    resampled_frame_.sample_rate_hz_ = encoder_rate_hz;
+    frame = &resampled_frame_;
+    audio = resampled_frame_.data();
+    samples_per_channel = resampled_frame_.samples_per_channel_;
+  }
+
+  // Up-mix after resampling, so that fewer channels are resampled.
+  if (num_channels < encoder_channels) {
+    ReMixFrame(*frame, encoder_channels, &remix_buffer_);
+    audio = remix_buffer_.data();
+    num_channels = encoder_channels;
+  }
+
+  RTC_DCHECK_EQ(samples_per_channel,
+                static_cast<size_t>(encoder_rate_hz / 100));
+  return rtc::ArrayView<const int16_t>(audio,
+                                       num_channels * samples_per_channel);
+}
+
+int TranscodingSession::Encode(rtc::ArrayView<const int16_t> audio) {
+  rtc::scoped_refptr<EncodedAudioPayload> payload = payload_pool_.Get();
+  AudioEncoder::EncodedInfo encoded_info =
+      encoder_->Encode(rtp_timestamp_, audio, payload.get());
+  rtp_timestamp_ += static_cast<uint32_t>(encoder_->RtpTimestampRateHz() / 100);
+
+  if (payload->size() == 0 && !encoded_info.send_even_if_empty) {
+    // Not enough data.
+    return 0;
+  }
+
+  AudioFrameType frame_type;
+  if (payload->size() == 0) {
+    frame_type = AudioFrameType::kEmptyFrame;
+    encoded_info.payload_type = previous_payload_type_;
+  } else {
+    frame_type = encoded_info.speech ? AudioFrameType::kAudioFrameSpeech
+                                     : AudioFrameType::kAudioFrameCN;
+  }
+  transport_->SendEncodedData(frame_type, encoded_info.payload_type,
+                              encoded_info.encoded_timestamp, payload, -1);
+  previous_payload_type_ = encoded_info.payload_type;
+  return static_cast<int>(payload->size());
+}
+
+}  // namespace webrtc
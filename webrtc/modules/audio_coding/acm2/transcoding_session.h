@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_ACM2_TRANSCODING_SESSION_H_
+#define MODULES_AUDIO_CODING_ACM2_TRANSCODING_SESSION_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio/audio_frame.h"
+#include "api/audio_codecs/audio_decoder_factory.h"
+#include "api/audio_codecs/audio_encoder.h"
+#include "api/audio_codecs/audio_format.h"
+#include "api/neteq/neteq.h"
+#include "api/neteq/neteq_factory.h"
+#include "api/scoped_refptr.h"
+#include "modules/audio_coding/acm2/acm_resampler.h"
+#include "modules/audio_coding/acm2/encoded_audio_payload_pool.h"
+#include "modules/audio_coding/include/audio_coding_module.h"
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class Clock;
+struct RTPHeader;
+
+// One leg of a transcoding server: the packets of an incoming stream are
+// decoded by NetEq, converted to the sample rate and channel count of the
+// encoder of the outgoing stream, and encoded again.
+//
+// Compared to connecting AudioCodingModule::PlayoutData10Ms() of one ACM to
+// Add10MsData() of another, the decoded audio is not copied between frames,
+// it is resampled at most once, directly from NetEq's output rate to the
+// encoder's rate, and each 10 ms takes one lock instead of one per ACM. The
+// encoded payloads are delivered like from an ACM, through
+// AudioPacketizationCallback::SendEncodedData().
+class TranscodingSession {
+ public:
+  struct Config {
+    Config();
+    Config(const Config&);
+    ~Config();
+
+    NetEq::Config neteq_config;
+    rtc::scoped_refptr<AudioDecoderFactory> decoder_factory;
+    // If null, the default NetEq factory is used.
+    NetEqFactory* neteq_factory = nullptr;
+    // If null, the real time clock is used.
+    Clock* clock = nullptr;
+    // Payload types of the incoming stream.
+    std::map<int, SdpAudioFormat> receive_codecs;
+    // RTP timestamp of the first payload of the outgoing stream.
+    uint32_t initial_rtp_timestamp = 0;
+  };
+
+  // |transport| is called with the lock of the session held, so it must not
+  // call back into the session. It must outlive the session.
+  TranscodingSession(const Config& config,
+                     std::unique_ptr<AudioEncoder> encoder,
+                     AudioPacketizationCallback* transport);
+  ~TranscodingSession();
+
+  // Inserts a packet of the incoming stream. Returns 0 on success and -1 on
+  // failure.
+  int InsertPacket(const RTPHeader& rtp_header,
+                   rtc::ArrayView<const uint8_t> payload);
+
+  // Decodes 10 ms of the incoming stream and encodes it. Returns the size of
+  // the payload sent to the transport, 0 if the encoder has not produced a
+  // payload, or -1 on failure.
+  int Process10Ms();
+
+  // Replaces the encoder of the outgoing stream. The RTP timestamps continue
+  // from the previous encoder, in the rate of the new one.
+  void SetEncoder(std::unique_ptr<AudioEncoder> encoder);
+
+  // Forwards the outgoing leg's packet loss rate, in [0, 1], to the encoder.
+  void OnReceivedUplinkPacketLossFraction(float packet_loss_fraction);
+
+ private:
+  // Converts |decoded_frame_| to the encoder's sample rate and number of
+  // channels. Returns the converted audio, or an empty view on failure.
+  rtc::ArrayView<const int16_t> ConvertDecodedFrame()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
+  int Encode(rtc::ArrayView<const int16_t> audio)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
+  rtc::CriticalSection crit_sect_;
+  const std::unique_ptr<NetEq> neteq_ RTC_GUARDED_BY(crit_sect_);
+  std::unique_ptr<AudioEncoder> encoder_ RTC_GUARDED_BY(crit_sect_);
+  AudioPacketizationCallback* const transport_;
+
+  // NetEq's output, and the same audio after resampling.
+  AudioFrame decoded_frame_ RTC_GUARDED_BY(crit_sect_);
+  AudioFrame resampled_frame_ RTC_GUARDED_BY(crit_sect_);
+  // Remixed audio, when the channel counts differ.
+  std::vector<int16_t> remix_buffer_ RTC_GUARDED_BY(crit_sect_);
+  acm2::ACMResampler resampler_ RTC_GUARDED_BY(crit_sect_);
+  acm2::EncodedAudioPayloadPool payload_pool_ RTC_GUARDED_BY(crit_sect_);
+
+  uint32_t rtp_timestamp_ RTC_GUARDED_BY(crit_sect_);
+  uint8_t previous_payload_type_ RTC_GUARDED_BY(crit_sect_) = 255;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(TranscodingSession);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_ACM2_TRANSCODING_SESSION_H_
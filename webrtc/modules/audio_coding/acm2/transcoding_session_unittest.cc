@@ -0,0 +1,217 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/acm2/transcoding_session.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/rtp_headers.h"
+#include "modules/audio_coding/acm2/transcoding_batch_runner.h"
+#include "modules/audio_coding/codecs/g711/audio_encoder_pcm.h"
+#include "modules/audio_coding/codecs/pcm16b/audio_encoder_pcm16b.h"
+#include "rtc_base/buffer.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kPcmuPayloadType = 0;
+constexpr int kPcm16bPayloadType = 107;
+constexpr uint32_t kInitialRtpTimestamp = 0x12345678;
+
+struct SentPacket {
+  AudioFrameType frame_type;
+  uint8_t payload_type;
+  uint32_t timestamp;
+  size_t size;
+};
+
+class RecordingTransport : public AudioPacketizationCallback {
+ public:
+  int32_t SendEncodedData(
+      AudioFrameType frame_type,
+      uint8_t payload_type,
+      uint32_t timestamp,
+      rtc::scoped_refptr<const EncodedAudioPayload> payload,
+      int64_t absolute_capture_timestamp_ms) override {
+    packets_.push_back(
+        SentPacket{frame_type, payload_type, timestamp, payload->size()});
+    return 0;
+  }
+
+  const std::vector<SentPacket>& packets() const { return packets_; }
+
+ private:
+  std::vector<SentPacket> packets_;
+};
+
+// Produces a 20 ms PCMU packet of a square wave every other 10 ms.
+class PcmuSource {
+ public:
+  PcmuSource() : encoder_(AudioEncoderPcmU::Config()) {
+    for (size_t i = 0; i < audio_.size(); ++i) {
+      audio_[i] = (i / 20) % 2 ? 3000 : -3000;
+    }
+  }
+
+  void MaybeInsertPacket(TranscodingSession* session) {
+    rtc::Buffer payload;
+    const AudioEncoder::EncodedInfo info =
+        encoder_.Encode(timestamp_, audio_, &payload);
+    timestamp_ += audio_.size();
+    if (payload.size() == 0) {
+      return;
+    }
+    RTPHeader header;
+    header.payloadType = kPcmuPayloadType;
+    header.sequenceNumber = sequence_number_++;
+    header.timestamp = info.encoded_timestamp;
+    header.ssrc = 0x1234;
+    EXPECT_EQ(0, session->InsertPacket(header, payload));
+  }
+
+ private:
+  AudioEncoderPcmU encoder_;
+  std::array<int16_t, 80> audio_;
+  uint32_t timestamp_ = 0;
+  uint16_t sequence_number_ = 0;
+};
+
+TranscodingSession::Config CreateConfig(Clock* clock) {
+  TranscodingSession::Config config;
+  config.decoder_factory = CreateBuiltinAudioDecoderFactory();
+  config.clock = clock;
+  config.receive_codecs = {{kPcmuPayloadType, {"pcmu", 8000, 1}}};
+  config.initial_rtp_timestamp = kInitialRtpTimestamp;
+  return config;
+}
+
+std::unique_ptr<AudioEncoder> CreatePcm16bEncoder(int sample_rate_hz,
+                                                  size_t num_channels) {
+  AudioEncoderPcm16B::Config config;
+  config.sample_rate_hz = sample_rate_hz;
+  config.num_channels = num_channels;
+  config.payload_type = kPcm16bPayloadType;
+  return std::make_unique<AudioEncoderPcm16B>(config);
+}
+
+}  // namespace
+
+class TranscodingSessionTest : public ::testing::Test {
+ protected:
+  TranscodingSessionTest() : clock_(0) {}
+
+  // Runs |num_ticks| times 10 ms of the incoming stream through |session|.
+  void Run(TranscodingSession* session, int num_ticks) {
+    for (int i = 0; i < num_ticks; ++i) {
+      source_.MaybeInsertPacket(session);
+      EXPECT_GE(session->Process10Ms(), 0);
+      clock_.AdvanceTimeMilliseconds(10);
+    }
+  }
+
+  SimulatedClock clock_;
+  PcmuSource source_;
+  RecordingTransport transport_;
+};
+
+// PCMU at 8 kHz mono in, resampled and up-mixed to PCM16B at 16 kHz stereo.
+TEST_F(TranscodingSessionTest, ResamplesAndUpmixes) {
+  TranscodingSession session(CreateConfig(&clock_),
+                             CreatePcm16bEncoder(16000, 2), &transport_);
+  Run(&session, 100);
+
+  // One 20 ms packet for every other 10 ms.
+  const std::vector<SentPacket>& packets = transport_.packets();
+  ASSERT_EQ(50u, packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(AudioFrameType::kAudioFrameSpeech, packets[i].frame_type);
+    EXPECT_EQ(kPcm16bPayloadType, packets[i].payload_type);
+    EXPECT_EQ(kInitialRtpTimestamp + 320 * i, packets[i].timestamp);
+    EXPECT_EQ(320u * 2 * 2, packets[i].size);
+  }
+}
+
+TEST_F(TranscodingSessionTest, KeepsRtpTimestampsAcrossEncoderChange) {
+  TranscodingSession session(CreateConfig(&clock_),
+                             CreatePcm16bEncoder(16000, 1), &transport_);
+  Run(&session, 20);
+  ASSERT_EQ(10u, transport_.packets().size());
+
+  // Down to 8 kHz, where the RTP timestamps advance half as fast.
+  session.SetEncoder(CreatePcm16bEncoder(8000, 1));
+  Run(&session, 20);
+  const std::vector<SentPacket>& packets = transport_.packets();
+  ASSERT_EQ(20u, packets.size());
+  for (size_t i = 10; i < packets.size(); ++i) {
+    EXPECT_EQ(kInitialRtpTimestamp + 320 * 10 + 160 * (i - 10),
+              packets[i].timestamp);
+    EXPECT_EQ(160u * 2, packets[i].size);
+  }
+}
+
+TEST_F(TranscodingSessionTest, RejectsUnknownPayloadType) {
+  TranscodingSession session(CreateConfig(&clock_),
+                             CreatePcm16bEncoder(8000, 1), &transport_);
+  RTPHeader header;
+  header.payloadType = 96;
+  const uint8_t kPayload[160] = {0};
+  EXPECT_EQ(-1, session.InsertPacket(header, kPayload));
+}
+
+TEST(TranscodingBatchRunnerTest, ProcessesAllSessionsEveryTick) {
+  constexpr int kNumSessions = 40;
+  constexpr int kNumTicks = 30;
+  SimulatedClock clock(0);
+  std::vector<std::unique_ptr<RecordingTransport>> transports;
+  std::vector<std::unique_ptr<TranscodingSession>> sessions;
+  std::vector<PcmuSource> sources(kNumSessions);
+  TranscodingBatchRunner runner(3);
+  for (int i = 0; i < kNumSessions; ++i) {
+    transports.push_back(std::make_unique<RecordingTransport>());
+    sessions.push_back(std::make_unique<TranscodingSession>(
+        CreateConfig(&clock), CreatePcm16bEncoder(16000, 1),
+        transports.back().get()));
+    runner.AddSession(sessions.back().get());
+  }
+  EXPECT_EQ(static_cast<size_t>(kNumSessions), runner.num_sessions());
+
+  for (int tick = 0; tick < kNumTicks; ++tick) {
+    for (int i = 0; i < kNumSessions; ++i) {
+      sources[i].MaybeInsertPacket(sessions[i].get());
+    }
+    runner.RunTick();
+    clock.AdvanceTimeMilliseconds(10);
+  }
+
+  for (int i = 0; i < kNumSessions; ++i) {
+    const TranscodingBatchRunner::SessionStats stats =
+        runner.GetSessionStats(sessions[i].get());
+    EXPECT_EQ(kNumTicks, stats.ticks);
+    EXPECT_EQ(0, stats.errors);
+    EXPECT_GE(stats.cpu_time_ns, 0);
+    EXPECT_EQ(static_cast<size_t>(kNumTicks / 2),
+              transports[i]->packets().size());
+  }
+
+  // A removed session is no longer processed.
+  runner.RemoveSession(sessions[0].get());
+  runner.RunTick();
+  EXPECT_EQ(static_cast<size_t>(kNumTicks / 2),
+            transports[0]->packets().size());
+  EXPECT_EQ(kNumTicks + 1, runner.GetSessionStats(sessions[1].get()).ticks);
+}
+
+}  // namespace webrtc
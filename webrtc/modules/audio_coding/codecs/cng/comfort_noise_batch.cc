@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/cng/comfort_noise_batch.h"
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr size_t kMaxSamples = ComfortNoiseDecoder::kMaxGenerateSamples;
+constexpr size_t kFilterLength = WEBRTC_CNG_MAX_LPC_ORDER + 1;
+constexpr size_t kLanes = 4;
+
+using FilterFunction = void (*)(const int16_t* const a[4],
+                                const int16_t* const x[4],
+                                size_t length,
+                                int16_t* const state[4],
+                                int16_t* const state_low[4],
+                                int16_t* const y[4]);
+
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+FilterFunction Filter4Function() {
+  return CngFilterAR4_SSE2;
+}
+#else
+FilterFunction Filter4Function() {
+  static const FilterFunction function =
+      WebRtc_GetCPUInfo(kSSE2) ? CngFilterAR4_SSE2 : nullptr;
+  return function;
+}
+#endif
+#else
+FilterFunction Filter4Function() {
+  return nullptr;
+}
+#endif
+
+// A stream whose excitation has been generated, waiting to be filtered.
+struct PendingStream {
+  const ComfortNoiseBatch::Stream* stream;
+  int16_t lp_poly[kFilterLength];
+  int16_t excitation[kMaxSamples];
+};
+
+}  // namespace
+
+bool ComfortNoiseBatch::Generate(rtc::ArrayView<const Stream> streams) {
+  const FilterFunction filter4 = Filter4Function();
+  PendingStream pending[kLanes];
+  size_t num_pending = 0;
+  bool success = true;
+
+  // Filters the pending streams, all four together if possible.
+  auto flush = [&] {
+    if (num_pending == kLanes && filter4) {
+      const int16_t* a[kLanes];
+      const int16_t* x[kLanes];
+      int16_t* state[kLanes];
+      int16_t* state_low[kLanes];
+      int16_t* y[kLanes];
+      for (size_t n = 0; n < kLanes; ++n) {
+        ComfortNoiseDecoder* decoder = pending[n].stream->decoder;
+        a[n] = pending[n].lp_poly;
+        x[n] = pending[n].excitation;
+        state[n] = decoder->dec_filtstate_;
+        state_low[n] = decoder->dec_filtstateLow_;
+        y[n] = pending[n].stream->output.data();
+      }
+      filter4(a, x, pending[0].stream->output.size(), state, state_low, y);
+    } else {
+      int16_t low[kMaxSamples];
+      for (size_t n = 0; n < num_pending; ++n) {
+        ComfortNoiseDecoder* decoder = pending[n].stream->decoder;
+        const rtc::ArrayView<int16_t> output = pending[n].stream->output;
+        WebRtcSpl_FilterAR(pending[n].lp_poly, kFilterLength,
+                           pending[n].excitation, output.size(),
+                           decoder->dec_filtstate_, WEBRTC_CNG_MAX_LPC_ORDER,
+                           decoder->dec_filtstateLow_,
+                           WEBRTC_CNG_MAX_LPC_ORDER, output.data(), low,
+                           output.size());
+      }
+    }
+    num_pending = 0;
+  };
+
+  for (const Stream& stream : streams) {
+    RTC_DCHECK(stream.decoder);
+    const size_t num_samples = stream.output.size();
+    if (num_samples > kMaxSamples) {
+      success = false;
+      continue;
+    }
+    if (num_pending > 0 &&
+        pending[0].stream->output.size() != num_samples) {
+      flush();
+    }
+    PendingStream& next = pending[num_pending++];
+    next.stream = &stream;
+    stream.decoder->UpdateFilter(stream.new_period, next.lp_poly);
+    stream.decoder->GenerateExcitation(
+        rtc::ArrayView<int16_t>(next.excitation, num_samples));
+    if (num_pending == kLanes) {
+      flush();
+    }
+  }
+  flush();
+  return success;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_CNG_COMFORT_NOISE_BATCH_H_
+#define MODULES_AUDIO_CODING_CODECS_CNG_COMFORT_NOISE_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/array_view.h"
+#include "modules/audio_coding/codecs/cng/webrtc_cng.h"
+
+namespace webrtc {
+
+// Generates comfort noise for many ComfortNoiseDecoders at once, e.g. for all
+// the muted participants of a conference. The per stream filter updates are
+// done as in ComfortNoiseDecoder::Generate(), but the all-pole synthesis
+// filter, where the time goes, runs on four streams at a time in the lanes of
+// SSE2 vectors. The output is bit-exact with calling Generate() on each
+// decoder in turn.
+class ComfortNoiseBatch {
+ public:
+  struct Stream {
+    ComfortNoiseDecoder* decoder;
+    // Its size determines the number of samples generated.
+    rtc::ArrayView<int16_t> output;
+    bool new_period;
+  };
+
+  // Generates comfort noise for all |streams|. Streams of the same length are
+  // filtered together, so the batch is most efficient when the streams have
+  // the same sample rate. Returns false if any of the outputs is too large
+  // for ComfortNoiseDecoder::Generate(); those streams are left untouched.
+  static bool Generate(rtc::ArrayView<const Stream> streams);
+};
+
+// Architecture specific synthesis filters, WebRtcSpl_FilterAR() with
+// WEBRTC_CNG_MAX_LPC_ORDER + 1 coefficients on four streams in parallel.
+// Stream n is filtered with the coefficients |a[n]| from |x[n]| into |y[n]|,
+// with the state in |state[n]| and |state_low[n]|.
+void CngFilterAR4_SSE2(const int16_t* const a[4],
+                       const int16_t* const x[4],
+                       size_t length,
+                       int16_t* const state[4],
+                       int16_t* const state_low[4],
+                       int16_t* const y[4]);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_CODECS_CNG_COMFORT_NOISE_BATCH_H_
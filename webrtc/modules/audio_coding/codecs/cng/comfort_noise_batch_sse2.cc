@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Contains CngFilterAR4_SSE2(), WebRtcSpl_FilterAR() for the comfort noise
+// synthesis filter on four streams at a time. Bit exact with
+// WebRtcSpl_FilterAR().
+//
+// Each 32-bit lane holds one stream. The filter history is kept as pairs of
+// consecutive samples in the 16-bit halves of a lane, in the same order as
+// the coefficient pairs, so that _mm_madd_epi16() does two taps at a time.
+// The C version accumulates in 64 bits, but only the low 32 bits of the sum
+// reach the outputs, so 32-bit lanes give the same result.
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/cng/comfort_noise_batch.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kOrder = WEBRTC_CNG_MAX_LPC_ORDER;
+constexpr int kPairs = kOrder / 2;
+static_assert(kOrder % 2 == 0, "The taps are processed in pairs");
+
+// Packs |v[n][i0]| and |v[n][i1]| into the low and high halves of lane n.
+__m128i LoadPairs(const int16_t* const v[4], int i0, int i1) {
+  auto pair = [&](int n) {
+    return static_cast<int32_t>(static_cast<uint16_t>(v[n][i0]) |
+                                (static_cast<uint32_t>(v[n][i1]) << 16));
+  };
+  return _mm_set_epi32(pair(3), pair(2), pair(1), pair(0));
+}
+
+// Moves |sample| into the history |pairs|, pushing out the oldest sample.
+void Push(__m128i sample, __m128i pairs[kPairs]) {
+  for (int k = kPairs - 1; k > 0; --k) {
+    pairs[k] = _mm_or_si128(_mm_srli_epi32(pairs[k - 1], 16),
+                            _mm_slli_epi32(pairs[k], 16));
+  }
+  pairs[0] = _mm_or_si128(_mm_and_si128(sample, _mm_set1_epi32(0xffff)),
+                          _mm_slli_epi32(pairs[0], 16));
+}
+
+// Writes the history |pairs| of lane |n| back in WebRtcSpl_FilterAR() state
+// order, where the last element is the most recent sample.
+void StorePairs(const __m128i pairs[kPairs], int n, int16_t* state) {
+  for (int k = 0; k < kPairs; ++k) {
+    int32_t lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), pairs[k]);
+    state[kOrder - 1 - 2 * k] = static_cast<int16_t>(lanes[n]);
+    state[kOrder - 2 - 2 * k] = static_cast<int16_t>(lanes[n] >> 16);
+  }
+}
+
+}  // namespace
+
+void CngFilterAR4_SSE2(const int16_t* const a[4],
+                       const int16_t* const x[4],
+                       size_t length,
+                       int16_t* const state[4],
+                       int16_t* const state_low[4],
+                       int16_t* const y[4]) {
+  // Pair k holds the coefficients a[2k + 1] and a[2k + 2], and the samples
+  // that many steps back.
+  __m128i coefficients[kPairs];
+  __m128i history[kPairs];
+  __m128i history_low[kPairs];
+  for (int k = 0; k < kPairs; ++k) {
+    coefficients[k] = LoadPairs(a, 2 * k + 1, 2 * k + 2);
+    history[k] = LoadPairs(state, kOrder - 1 - 2 * k, kOrder - 2 - 2 * k);
+    history_low[k] =
+        LoadPairs(state_low, kOrder - 1 - 2 * k, kOrder - 2 - 2 * k);
+  }
+
+  const __m128i rounding = _mm_set1_epi32(2048);
+  for (size_t i = 0; i < length; ++i) {
+    __m128i o = _mm_slli_epi32(
+        _mm_set_epi32(x[3][i], x[2][i], x[1][i], x[0][i]), 12);
+    __m128i o_low = _mm_setzero_si128();
+    for (int k = 0; k < kPairs; ++k) {
+      o = _mm_sub_epi32(o, _mm_madd_epi16(coefficients[k], history[k]));
+      o_low =
+          _mm_sub_epi32(o_low, _mm_madd_epi16(coefficients[k], history_low[k]));
+    }
+    o = _mm_add_epi32(o, _mm_srai_epi32(o_low, 12));
+
+    // The outputs, sign extended from 16 bits.
+    const __m128i out = _mm_srai_epi32(
+        _mm_slli_epi32(_mm_srai_epi32(_mm_add_epi32(o, rounding), 12), 16), 16);
+    const __m128i out_low = _mm_sub_epi32(o, _mm_slli_epi32(out, 12));
+
+    Push(out, history);
+    Push(out_low, history_low);
+
+    y[0][i] = static_cast<int16_t>(_mm_extract_epi16(out, 0));
+    y[1][i] = static_cast<int16_t>(_mm_extract_epi16(out, 2));
+    y[2][i] = static_cast<int16_t>(_mm_extract_epi16(out, 4));
+    y[3][i] = static_cast<int16_t>(_mm_extract_epi16(out, 6));
+  }
+
+  for (int n = 0; n < 4; ++n) {
+    StorePairs(history, n, state[n]);
+    StorePairs(history_low, n, state_low[n]);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/cng/comfort_noise_batch.h"
+
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/arraysize.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kNumStreams = 11;
+
+// Returns a SID frame describing noise of amplitude |amplitude|, with
+// |quality| reflection coefficients.
+rtc::Buffer MakeSid(Random* random, int quality, int amplitude) {
+  ComfortNoiseEncoder encoder(16000, 100, quality);
+  std::vector<int16_t> speech(160);
+  rtc::Buffer sid;
+  for (int16_t& sample : speech) {
+    sample = static_cast<int16_t>(random->Rand(-amplitude, amplitude));
+  }
+  encoder.Encode(speech, /*force_sid=*/true, &sid);
+  return sid;
+}
+
+// Two identical sets of decoders, one generated stream by stream and one in
+// a batch.
+class ComfortNoiseBatchTest : public ::testing::Test {
+ protected:
+  ComfortNoiseBatchTest() : random_(4711) {
+    for (int n = 0; n < kNumStreams; ++n) {
+      reference_.push_back(std::make_unique<ComfortNoiseDecoder>());
+      batched_.push_back(std::make_unique<ComfortNoiseDecoder>());
+    }
+  }
+
+  void UpdateSids() {
+    for (int n = 0; n < kNumStreams; ++n) {
+      const rtc::Buffer sid = MakeSid(&random_, 1 + n % WEBRTC_CNG_MAX_LPC_ORDER,
+                                      random_.Rand(1, 20000));
+      reference_[n]->UpdateSid(sid);
+      batched_[n]->UpdateSid(sid);
+    }
+  }
+
+  // Generates one frame of |lengths[n]| samples for stream n both ways, and
+  // checks that they match.
+  void GenerateAndCompare(const std::vector<size_t>& lengths,
+                          bool new_period) {
+    std::vector<std::vector<int16_t>> expected(kNumStreams);
+    std::vector<std::vector<int16_t>> actual(kNumStreams);
+    std::vector<ComfortNoiseBatch::Stream> streams;
+    for (int n = 0; n < kNumStreams; ++n) {
+      expected[n].resize(lengths[n]);
+      actual[n].resize(lengths[n]);
+      ASSERT_TRUE(reference_[n]->Generate(expected[n], new_period));
+      streams.push_back({batched_[n].get(), actual[n], new_period});
+    }
+    ASSERT_TRUE(ComfortNoiseBatch::Generate(streams));
+    for (int n = 0; n < kNumStreams; ++n) {
+      EXPECT_EQ(expected[n], actual[n]) << "stream " << n;
+    }
+  }
+
+  Random random_;
+  std::vector<std::unique_ptr<ComfortNoiseDecoder>> reference_;
+  std::vector<std::unique_ptr<ComfortNoiseDecoder>> batched_;
+};
+
+}  // namespace
+
+TEST_F(ComfortNoiseBatchTest, SameLengthMatchesGenerate) {
+  const std::vector<size_t> lengths(kNumStreams, 160);
+  for (int frame = 0; frame < 50; ++frame) {
+    if (frame % 10 == 0) {
+      UpdateSids();
+    }
+    GenerateAndCompare(lengths, frame == 0);
+  }
+}
+
+TEST_F(ComfortNoiseBatchTest, MixedLengthsMatchGenerate) {
+  const size_t kLengths[] = {80, 160, 320, 480, 640, 5};
+  std::vector<size_t> lengths;
+  for (int n = 0; n < kNumStreams; ++n) {
+    lengths.push_back(kLengths[(n / 2) % arraysize(kLengths)]);
+  }
+  for (int frame = 0; frame < 50; ++frame) {
+    if (frame % 7 == 0) {
+      UpdateSids();
+    }
+    GenerateAndCompare(lengths, frame % 20 == 0);
+  }
+}
+
+TEST(ComfortNoiseBatchTest, RejectsTooLongOutput) {
+  ComfortNoiseDecoder decoder;
+  std::vector<int16_t> output(ComfortNoiseDecoder::kMaxGenerateSamples + 1,
+                              17);
+  const ComfortNoiseBatch::Stream stream = {&decoder, output, false};
+  EXPECT_FALSE(ComfortNoiseBatch::Generate({&stream, 1}));
+  EXPECT_EQ(std::vector<int16_t>(output.size(), 17), output);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// The filter on full scale random coefficients, input and state, which
+// overflows the 32-bit lanes; only the low bits of the sums matter. The low
+// state stays within the range the filter itself produces.
+TEST(ComfortNoiseBatchTest, FilterAR4Sse2MatchesFilterAR) {
+  if (!WebRtc_GetCPUInfo(kSSE2)) {
+    return;
+  }
+  constexpr size_t kFilterLength = WEBRTC_CNG_MAX_LPC_ORDER + 1;
+  constexpr size_t kLength = 23;
+  Random random(42);
+  auto full_scale = [&] {
+    return static_cast<int16_t>(random.Rand(-32768, 32767));
+  };
+  for (int trial = 0; trial < 100; ++trial) {
+    int16_t a[4][kFilterLength];
+    int16_t x[4][kLength];
+    int16_t state[4][kFilterLength];
+    int16_t state_low[4][kFilterLength];
+    int16_t y[4][kLength];
+    for (int n = 0; n < 4; ++n) {
+      for (size_t k = 0; k < kFilterLength; ++k) {
+        a[n][k] = full_scale();
+        state[n][k] = full_scale();
+        state_low[n][k] = static_cast<int16_t>(random.Rand(-2048, 2047));
+      }
+      for (size_t i = 0; i < kLength; ++i) {
+        x[n][i] = full_scale();
+      }
+    }
+    int16_t expected_state[4][kFilterLength];
+    int16_t expected_state_low[4][kFilterLength];
+    int16_t expected_y[4][kLength];
+    int16_t expected_y_low[kLength];
+    memcpy(expected_state, state, sizeof(state));
+    memcpy(expected_state_low, state_low, sizeof(state_low));
+    for (int n = 0; n < 4; ++n) {
+      WebRtcSpl_FilterAR(a[n], kFilterLength, x[n], kLength, expected_state[n],
+                         WEBRTC_CNG_MAX_LPC_ORDER, expected_state_low[n],
+                         WEBRTC_CNG_MAX_LPC_ORDER, expected_y[n],
+                         expected_y_low, kLength);
+    }
+
+    const int16_t* const a_ptrs[4] = {a[0], a[1], a[2], a[3]};
+    const int16_t* const x_ptrs[4] = {x[0], x[1], x[2], x[3]};
+    int16_t* const state_ptrs[4] = {state[0], state[1], state[2], state[3]};
+    int16_t* const state_low_ptrs[4] = {state_low[0], state_low[1],
+                                        state_low[2], state_low[3]};
+    int16_t* const y_ptrs[4] = {y[0], y[1], y[2], y[3]};
+    CngFilterAR4_SSE2(a_ptrs, x_ptrs, kLength, state_ptrs, state_low_ptrs,
+                      y_ptrs);
+
+    for (int n = 0; n < 4; ++n) {
+      for (size_t i = 0; i < kLength; ++i) {
+        ASSERT_EQ(expected_y[n][i], y[n][i]) << "stream " << n << " at " << i;
+      }
+      for (size_t k = 0; k < WEBRTC_CNG_MAX_LPC_ORDER; ++k) {
+        ASSERT_EQ(expected_state[n][k], state[n][k]);
+        ASSERT_EQ(expected_state_low[n][k], state_low[n][k]);
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace webrtc
@@ -20,7 +20,7 @@ namespace webrtc {
 
 namespace {
 
-const size_t kCngMaxOutsizeOrder = 640;
+const size_t kCngMaxOutsizeOrder = ComfortNoiseDecoder::kMaxGenerateSamples;
 
 // TODO(ossu): Rename the left-over WebRtcCng according to style guide.
 void WebRtcCng_K2a16(int16_t* k, int useOrder, int16_t* a);
@@ -113,6 +113,30 @@ bool ComfortNoiseDecoder::Generate(rtc::ArrayView<int16_t> out_data,
   int16_t excitation[kCngMaxOutsizeOrder];
   int16_t low[kCngMaxOutsizeOrder];
   int16_t lpPoly[WEBRTC_CNG_MAX_LPC_ORDER + 1];
+  const size_t num_samples = out_data.size();
+
+  if (num_samples > kCngMaxOutsizeOrder) {
+    return false;
+  }
+
+  UpdateFilter(new_period, lpPoly);
+  GenerateExcitation(rtc::ArrayView<int16_t>(excitation, num_samples));
+
+  /* |lpPoly| - Coefficients in Q12.
+   * |excitation| - Speech samples.
+   * |nst->dec_filtstate| - State preservation.
+   * |out_data| - Filtered speech samples. */
+  WebRtcSpl_FilterAR(lpPoly, WEBRTC_CNG_MAX_LPC_ORDER + 1, excitation,
+                     num_samples, dec_filtstate_, WEBRTC_CNG_MAX_LPC_ORDER,
+                     dec_filtstateLow_, WEBRTC_CNG_MAX_LPC_ORDER,
+                     out_data.data(), low, num_samples);
+
+  return true;
+}
+
+void ComfortNoiseDecoder::UpdateFilter(
+    bool new_period,
+    int16_t lpPoly[WEBRTC_CNG_MAX_LPC_ORDER + 1]) {
   int16_t ReflBetaStd = 26214;      /* 0.8 in q15. */
   int16_t ReflBetaCompStd = 6553;   /* 0.2 in q15. */
   int16_t ReflBetaNewP = 19661;     /* 0.6 in q15. */
@@ -121,11 +145,6 @@ bool ComfortNoiseDecoder::Generate(rtc::ArrayView<int16_t> out_data,
   int32_t targetEnergy;
   int16_t En;
   int16_t temp16;
-  const size_t num_samples = out_data.size();
-
-  if (num_samples > kCngMaxOutsizeOrder) {
-    return false;
-  }
 
   if (new_period) {
     dec_used_scale_factor_ = dec_target_scale_factor_;
@@ -182,27 +201,19 @@ bool ComfortNoiseDecoder::Generate(rtc::ArrayView<int16_t> out_data,
   En = (int16_t)WebRtcSpl_Sqrt(En) << 6;
   En = (En * 3) >> 1; /* 1.5 estimates sqrt(2). */
   dec_used_scale_factor_ = (int16_t)((En * targetEnergy) >> 12);
+}
 
+void ComfortNoiseDecoder::GenerateExcitation(
+    rtc::ArrayView<int16_t> excitation) {
   /* Generate excitation. */
   /* Excitation energy per sample is 2.^24 - Q13 N(0,1). */
-  for (size_t i = 0; i < num_samples; i++) {
+  for (size_t i = 0; i < excitation.size(); i++) {
     excitation[i] = WebRtcSpl_RandN(&dec_seed_) >> 1;
   }
 
   /* Scale to correct energy. */
-  WebRtcSpl_ScaleVector(excitation, excitation, dec_used_scale_factor_,
-                        num_samples, 13);
-
-  /* |lpPoly| - Coefficients in Q12.
-   * |excitation| - Speech samples.
-   * |nst->dec_filtstate| - State preservation.
-   * |out_data| - Filtered speech samples. */
-  WebRtcSpl_FilterAR(lpPoly, WEBRTC_CNG_MAX_LPC_ORDER + 1, excitation,
-                     num_samples, dec_filtstate_, WEBRTC_CNG_MAX_LPC_ORDER,
-                     dec_filtstateLow_, WEBRTC_CNG_MAX_LPC_ORDER,
-                     out_data.data(), low, num_samples);
-
-  return true;
+  WebRtcSpl_ScaleVector(excitation.data(), excitation.data(),
+                        dec_used_scale_factor_, excitation.size(), 13);
 }
 
 ComfortNoiseEncoder::ComfortNoiseEncoder(int fs, int interval, int quality)
@@ -24,6 +24,9 @@ namespace webrtc {
 
 class ComfortNoiseDecoder {
  public:
+  // The largest number of samples Generate() produces in one call.
+  static constexpr size_t kMaxGenerateSamples = 640;
+
   ComfortNoiseDecoder();
   ~ComfortNoiseDecoder() = default;
 
@@ -46,6 +49,16 @@ class ComfortNoiseDecoder {
   bool Generate(rtc::ArrayView<int16_t> out_data, bool new_period);
 
  private:
+  friend class ComfortNoiseBatch;
+
+  // Moves the filter and the scale factor towards the targets from the
+  // latest SID, and writes the synthesis filter, in Q12, to |lp_poly|.
+  void UpdateFilter(bool new_period,
+                    int16_t lp_poly[WEBRTC_CNG_MAX_LPC_ORDER + 1]);
+
+  // Writes scaled random excitation to |excitation|.
+  void GenerateExcitation(rtc::ArrayView<int16_t> excitation);
+
   uint32_t dec_seed_;
   int32_t dec_target_energy_;
   int32_t dec_used_energy_;
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/g711/g711_batch.h"
+
+#include <type_traits>
+
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kSSE2, WebRtc_G...
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kUlawBias = 0x84;
+constexpr int kAlawAmiMask = 0x55;
+
+// Returns the index of the highest set bit of |bits|, which must be non-zero.
+int TopBit(unsigned int bits) {
+  int i = 0;
+  while (bits >>= 1) {
+    ++i;
+  }
+  return i;
+}
+
+struct G711Tables {
+  G711Tables() {
+    for (int i = 0; i < 65536; ++i) {
+      const int16_t linear = static_cast<int16_t>(i);
+      linear_to_alaw[i] = G711LinearToAlaw(linear);
+      linear_to_ulaw[i] = G711LinearToUlaw(linear);
+    }
+    for (int i = 0; i < 256; ++i) {
+      const uint8_t code = static_cast<uint8_t>(i);
+      alaw_to_linear[i] = G711AlawToLinear(code);
+      ulaw_to_linear[i] = G711UlawToLinear(code);
+    }
+    for (int i = 0; i < 256; ++i) {
+      alaw_to_ulaw[i] =
+          linear_to_ulaw[static_cast<uint16_t>(alaw_to_linear[i])];
+      ulaw_to_alaw[i] =
+          linear_to_alaw[static_cast<uint16_t>(ulaw_to_linear[i])];
+    }
+  }
+
+  // Indexed by the sample reinterpreted as uint16_t.
+  uint8_t linear_to_alaw[65536];
+  uint8_t linear_to_ulaw[65536];
+  int16_t alaw_to_linear[256];
+  int16_t ulaw_to_linear[256];
+  uint8_t alaw_to_ulaw[256];
+  uint8_t ulaw_to_alaw[256];
+};
+
+const G711Tables& Tables() {
+  static const G711Tables* const tables = new G711Tables();
+  return *tables;
+}
+
+// Table lookup of |len| entries, unrolled by four so that the loads of
+// neighboring samples are independent.
+template <typename In, typename Out>
+void Lookup(const Out* table, const In* in, size_t len, Out* out) {
+  using Index = typename std::make_unsigned<In>::type;
+  size_t n = 0;
+  for (; n + 4 <= len; n += 4) {
+    const Out a = table[static_cast<Index>(in[n])];
+    const Out b = table[static_cast<Index>(in[n + 1])];
+    const Out c = table[static_cast<Index>(in[n + 2])];
+    const Out d = table[static_cast<Index>(in[n + 3])];
+    out[n] = a;
+    out[n + 1] = b;
+    out[n + 2] = c;
+    out[n + 3] = d;
+  }
+  for (; n < len; ++n) {
+    out[n] = table[static_cast<Index>(in[n])];
+  }
+}
+
+using DecodeFunction = size_t (*)(const uint8_t*, size_t, int16_t*);
+
+#if !(defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)) && \
+    !defined(WEBRTC_HAS_NEON)
+// Leaves all samples to the table lookup.
+size_t DecodeNone(const uint8_t* /* encoded */,
+                  size_t /* len */,
+                  int16_t* /* linear */) {
+  return 0;
+}
+#endif
+
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+DecodeFunction DecodeAFunction() {
+  return G711DecodeA_SSE2;
+}
+DecodeFunction DecodeUFunction() {
+  return G711DecodeU_SSE2;
+}
+#else
+DecodeFunction DecodeAFunction() {
+  static const DecodeFunction function =
+      WebRtc_GetCPUInfo(kSSE2) ? G711DecodeA_SSE2 : DecodeNone;
+  return function;
+}
+DecodeFunction DecodeUFunction() {
+  static const DecodeFunction function =
+      WebRtc_GetCPUInfo(kSSE2) ? G711DecodeU_SSE2 : DecodeNone;
+  return function;
+}
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+DecodeFunction DecodeAFunction() {
+  return G711DecodeA_NEON;
+}
+DecodeFunction DecodeUFunction() {
+  return G711DecodeU_NEON;
+}
+#else
+DecodeFunction DecodeAFunction() {
+  return DecodeNone;
+}
+DecodeFunction DecodeUFunction() {
+  return DecodeNone;
+}
+#endif
+
+}  // namespace
+
+uint8_t G711LinearToAlaw(int16_t sample) {
+  int linear = sample;
+  int mask;
+  if (linear >= 0) {
+    // Sign (bit 7) bit = 1.
+    mask = kAlawAmiMask | 0x80;
+  } else {
+    // Sign (bit 7) bit = 0. Offset by one to be bit-exact with the G.711
+    // reference implementation.
+    mask = kAlawAmiMask;
+    linear = -linear - 1;
+  }
+  // Convert the scaled magnitude to a segment number. A 16-bit input never
+  // exceeds segment 7.
+  const int seg = TopBit(linear | 0xFF) - 7;
+  return static_cast<uint8_t>(
+      ((seg << 4) | ((linear >> (seg ? seg + 3 : 4)) & 0x0F)) ^ mask);
+}
+
+uint8_t G711LinearToUlaw(int16_t sample) {
+  int linear = sample;
+  int mask;
+  if (linear < 0) {
+    // Offset by one to be bit-exact with the G.711 reference implementation.
+    linear = kUlawBias - linear - 1;
+    mask = 0x7F;
+  } else {
+    linear = kUlawBias + linear;
+    mask = 0xFF;
+  }
+  const int seg = TopBit(linear | 0xFF) - 7;
+  if (seg >= 8) {
+    // Out of range; return the maximum value.
+    return static_cast<uint8_t>(0x7F ^ mask);
+  }
+  return static_cast<uint8_t>(
+      ((seg << 4) | ((linear >> (seg + 3)) & 0x0F)) ^ mask);
+}
+
+int16_t G711AlawToLinear(uint8_t alaw) {
+  alaw ^= kAlawAmiMask;
+  int i = (alaw & 0x0F) << 4;
+  const int seg = (alaw & 0x70) >> 4;
+  if (seg) {
+    i = (i + 0x108) << (seg - 1);
+  } else {
+    i += 8;
+  }
+  return static_cast<int16_t>((alaw & 0x80) ? i : -i);
+}
+
+int16_t G711UlawToLinear(uint8_t ulaw) {
+  // Complement to obtain the normal u-law value.
+  ulaw = ~ulaw;
+  // Extract and bias the quantization bits, then shift up by the segment
+  // number and subtract out the bias.
+  const int t = (((ulaw & 0x0F) << 3) + kUlawBias) << ((ulaw & 0x70) >> 4);
+  return static_cast<int16_t>((ulaw & 0x80) ? (kUlawBias - t)
+                                            : (t - kUlawBias));
+}
+
+}  // namespace webrtc
+
+void WebRtcG711Batch_EncodeA(const int16_t* linear, size_t len, uint8_t* alaw) {
+  webrtc::Lookup(webrtc::Tables().linear_to_alaw, linear, len, alaw);
+}
+
+void WebRtcG711Batch_EncodeU(const int16_t* linear, size_t len, uint8_t* ulaw) {
+  webrtc::Lookup(webrtc::Tables().linear_to_ulaw, linear, len, ulaw);
+}
+
+void WebRtcG711Batch_DecodeA(const uint8_t* alaw, size_t len, int16_t* linear) {
+  const size_t n = webrtc::DecodeAFunction()(alaw, len, linear);
+  webrtc::Lookup(webrtc::Tables().alaw_to_linear, alaw + n, len - n,
+                 linear + n);
+}
+
+void WebRtcG711Batch_DecodeU(const uint8_t* ulaw, size_t len, int16_t* linear) {
+  const size_t n = webrtc::DecodeUFunction()(ulaw, len, linear);
+  webrtc::Lookup(webrtc::Tables().ulaw_to_linear, ulaw + n, len - n,
+                 linear + n);
+}
+
+void WebRtcG711Batch_AlawToUlaw(const uint8_t* alaw,
+                                size_t len,
+                                uint8_t* ulaw) {
+  webrtc::Lookup(webrtc::Tables().alaw_to_ulaw, alaw, len, ulaw);
+}
+
+void WebRtcG711Batch_UlawToAlaw(const uint8_t* ulaw,
+                                size_t len,
+                                uint8_t* alaw) {
+  webrtc::Lookup(webrtc::Tables().ulaw_to_alaw, ulaw, len, alaw);
+}
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_G711_G711_BATCH_H_
+#define MODULES_AUDIO_CODING_CODECS_G711_G711_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Table-driven G.711 conversion of whole buffers. Encoding uses one 64K-entry
+// table per law, indexed by the 16-bit sample. Decoding uses 256-entry tables,
+// or an arithmetic SSE2/NEON kernel where available. A-law <-> u-law
+// transcoding uses 256-entry tables and gives the same result as decoding
+// followed by encoding, without going through linear PCM. All functions
+// produce output bit-exact with the sample-by-sample reference conversions.
+// The tables are built on first use and are thread safe.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void WebRtcG711Batch_EncodeA(const int16_t* linear, size_t len, uint8_t* alaw);
+void WebRtcG711Batch_EncodeU(const int16_t* linear, size_t len, uint8_t* ulaw);
+void WebRtcG711Batch_DecodeA(const uint8_t* alaw, size_t len, int16_t* linear);
+void WebRtcG711Batch_DecodeU(const uint8_t* ulaw, size_t len, int16_t* linear);
+void WebRtcG711Batch_AlawToUlaw(const uint8_t* alaw, size_t len, uint8_t* ulaw);
+void WebRtcG711Batch_UlawToAlaw(const uint8_t* ulaw, size_t len, uint8_t* alaw);
+
+#ifdef __cplusplus
+}  // extern "C"
+
+namespace webrtc {
+
+// Sample-by-sample reference conversions, used to build the tables.
+uint8_t G711LinearToAlaw(int16_t linear);
+uint8_t G711LinearToUlaw(int16_t linear);
+int16_t G711AlawToLinear(uint8_t alaw);
+int16_t G711UlawToLinear(uint8_t ulaw);
+
+// Architecture specific decoders. They handle a multiple of 8 samples and
+// return the number of samples processed; the caller decodes the rest.
+size_t G711DecodeA_SSE2(const uint8_t* alaw, size_t len, int16_t* linear);
+size_t G711DecodeU_SSE2(const uint8_t* ulaw, size_t len, int16_t* linear);
+size_t G711DecodeA_NEON(const uint8_t* alaw, size_t len, int16_t* linear);
+size_t G711DecodeU_NEON(const uint8_t* ulaw, size_t len, int16_t* linear);
+
+}  // namespace webrtc
+#endif  // __cplusplus
+
+#endif  // MODULES_AUDIO_CODING_CODECS_G711_G711_BATCH_H_
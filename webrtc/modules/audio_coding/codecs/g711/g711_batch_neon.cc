@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <arm_neon.h>
+
+#include "modules/audio_coding/codecs/g711/g711_batch.h"
+
+namespace webrtc {
+
+size_t G711DecodeA_NEON(const uint8_t* alaw, size_t len, int16_t* linear) {
+  const uint16x8_t ami_mask = vdupq_n_u16(0x55);
+  const uint16x8_t mantissa_mask = vdupq_n_u16(0x0F);
+  const uint16x8_t segment_mask = vdupq_n_u16(0x70);
+  const uint16x8_t sign_mask = vdupq_n_u16(0x80);
+  size_t n = 0;
+  for (; n + 8 <= len; n += 8) {
+    const uint16x8_t code = veorq_u16(vmovl_u8(vld1_u8(&alaw[n])), ami_mask);
+    const uint16x8_t mantissa = vshlq_n_u16(vandq_u16(code, mantissa_mask), 4);
+    const int16x8_t segment =
+        vreinterpretq_s16_u16(vshrq_n_u16(vandq_u16(code, segment_mask), 4));
+    // Segment 0: mantissa + 8. Segments 1 to 7:
+    // (mantissa + 0x108) << (segment - 1).
+    const uint16x8_t linear_seg0 = vaddq_u16(mantissa, vdupq_n_u16(8));
+    const uint16x8_t linear_segn =
+        vshlq_u16(vaddq_u16(mantissa, vdupq_n_u16(0x108)),
+                  vsubq_s16(segment, vdupq_n_s16(1)));
+    const uint16x8_t magnitude =
+        vbslq_u16(vceqq_s16(segment, vdupq_n_s16(0)), linear_seg0,
+                  linear_segn);
+    const int16x8_t positive = vreinterpretq_s16_u16(magnitude);
+    vst1q_s16(&linear[n], vbslq_s16(vtstq_u16(code, sign_mask), positive,
+                                    vnegq_s16(positive)));
+  }
+  return n;
+}
+
+size_t G711DecodeU_NEON(const uint8_t* ulaw, size_t len, int16_t* linear) {
+  const uint16x8_t all_ones = vdupq_n_u16(0xFF);
+  const uint16x8_t mantissa_mask = vdupq_n_u16(0x0F);
+  const uint16x8_t segment_mask = vdupq_n_u16(0x70);
+  const uint16x8_t sign_mask = vdupq_n_u16(0x80);
+  const int16x8_t bias = vdupq_n_s16(0x84);
+  size_t n = 0;
+  for (; n + 8 <= len; n += 8) {
+    // Complement to obtain the normal u-law value.
+    const uint16x8_t code = veorq_u16(vmovl_u8(vld1_u8(&ulaw[n])), all_ones);
+    const uint16x8_t mantissa = vshlq_n_u16(vandq_u16(code, mantissa_mask), 3);
+    const int16x8_t segment =
+        vreinterpretq_s16_u16(vshrq_n_u16(vandq_u16(code, segment_mask), 4));
+    // t = ((mantissa << 3) + bias) << segment, at most 0x7E00.
+    const int16x8_t t = vreinterpretq_s16_u16(
+        vshlq_u16(vaddq_u16(mantissa, vreinterpretq_u16_s16(bias)), segment));
+    vst1q_s16(&linear[n], vbslq_s16(vtstq_u16(code, sign_mask),
+                                    vsubq_s16(bias, t), vsubq_s16(t, bias)));
+  }
+  return n;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/g711/g711_batch.h"
+
+namespace webrtc {
+
+namespace {
+
+// Returns 2^|exponent| for 16-bit lanes with |exponent| in [-1, 7]. SSE2 has
+// no per-lane variable shift, so the power of two is built as a float from
+// the exponent and multiplied in instead. An exponent of -1 gives zero.
+__m128i PowerOfTwo(__m128i exponent) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i bias = _mm_set1_epi32(127);
+  // Sign extend to 32 bits.
+  const __m128i sign = _mm_cmpgt_epi16(zero, exponent);
+  const __m128i lo = _mm_unpacklo_epi16(exponent, sign);
+  const __m128i hi = _mm_unpackhi_epi16(exponent, sign);
+  const __m128i pow_lo = _mm_cvttps_epi32(
+      _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(lo, bias), 23)));
+  const __m128i pow_hi = _mm_cvttps_epi32(
+      _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(hi, bias), 23)));
+  return _mm_packs_epi32(pow_lo, pow_hi);
+}
+
+// Loads 8 codes and zero extends them to 16 bits.
+__m128i LoadCodes(const uint8_t* codes) {
+  return _mm_unpacklo_epi8(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(codes)),
+      _mm_setzero_si128());
+}
+
+// Selects |if_set| in the lanes where |mask| is all ones, and |if_clear| in
+// the lanes where it is zero.
+__m128i Select(__m128i if_set, __m128i mask, __m128i if_clear) {
+  return _mm_or_si128(_mm_and_si128(mask, if_set),
+                      _mm_andnot_si128(mask, if_clear));
+}
+
+}  // namespace
+
+size_t G711DecodeA_SSE2(const uint8_t* alaw, size_t len, int16_t* linear) {
+  const __m128i ami_mask = _mm_set1_epi16(0x55);
+  const __m128i mantissa_mask = _mm_set1_epi16(0x0F);
+  const __m128i segment_mask = _mm_set1_epi16(0x70);
+  const __m128i sign_mask = _mm_set1_epi16(0x80);
+  const __m128i one = _mm_set1_epi16(1);
+  size_t n = 0;
+  for (; n + 8 <= len; n += 8) {
+    const __m128i code = _mm_xor_si128(LoadCodes(&alaw[n]), ami_mask);
+    const __m128i mantissa =
+        _mm_slli_epi16(_mm_and_si128(code, mantissa_mask), 4);
+    const __m128i segment =
+        _mm_srli_epi16(_mm_and_si128(code, segment_mask), 4);
+    // Segment 0: mantissa + 8. Segments 1 to 7:
+    // (mantissa + 0x108) << (segment - 1).
+    const __m128i linear_seg0 = _mm_add_epi16(mantissa, _mm_set1_epi16(8));
+    const __m128i linear_segn =
+        _mm_mullo_epi16(_mm_add_epi16(mantissa, _mm_set1_epi16(0x108)),
+                        PowerOfTwo(_mm_sub_epi16(segment, one)));
+    const __m128i is_seg0 = _mm_cmpeq_epi16(segment, _mm_setzero_si128());
+    const __m128i magnitude = Select(linear_seg0, is_seg0, linear_segn);
+    const __m128i positive =
+        _mm_cmpeq_epi16(_mm_and_si128(code, sign_mask), sign_mask);
+    const __m128i result = Select(
+        magnitude, positive, _mm_sub_epi16(_mm_setzero_si128(), magnitude));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&linear[n]), result);
+  }
+  return n;
+}
+
+size_t G711DecodeU_SSE2(const uint8_t* ulaw, size_t len, int16_t* linear) {
+  const __m128i all_ones = _mm_set1_epi16(0xFF);
+  const __m128i mantissa_mask = _mm_set1_epi16(0x0F);
+  const __m128i segment_mask = _mm_set1_epi16(0x70);
+  const __m128i sign_mask = _mm_set1_epi16(0x80);
+  const __m128i bias = _mm_set1_epi16(0x84);
+  size_t n = 0;
+  for (; n + 8 <= len; n += 8) {
+    // Complement to obtain the normal u-law value.
+    const __m128i code = _mm_xor_si128(LoadCodes(&ulaw[n]), all_ones);
+    const __m128i mantissa =
+        _mm_slli_epi16(_mm_and_si128(code, mantissa_mask), 3);
+    const __m128i segment =
+        _mm_srli_epi16(_mm_and_si128(code, segment_mask), 4);
+    // t = ((mantissa << 3) + bias) << segment, at most 0x7E00.
+    const __m128i t =
+        _mm_mullo_epi16(_mm_add_epi16(mantissa, bias), PowerOfTwo(segment));
+    const __m128i negative =
+        _mm_cmpeq_epi16(_mm_and_si128(code, sign_mask), sign_mask);
+    const __m128i result =
+        Select(_mm_sub_epi16(bias, t), negative, _mm_sub_epi16(t, bias));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&linear[n]), result);
+  }
+  return n;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,193 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/g711/g711_batch.h"
+
+#include <vector>
+
+#include "modules/audio_coding/codecs/g711/audio_decoder_pcm.h"
+#include "modules/audio_coding/codecs/g711/audio_encoder_pcm.h"
+#include "modules/audio_coding/codecs/g711/g711_interface.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+std::vector<int16_t> AllSamples() {
+  std::vector<int16_t> samples(65536);
+  for (int i = 0; i < 65536; ++i) {
+    samples[i] = static_cast<int16_t>(i - 32768);
+  }
+  return samples;
+}
+
+std::vector<uint8_t> AllCodes() {
+  std::vector<uint8_t> codes(256);
+  for (int i = 0; i < 256; ++i) {
+    codes[i] = static_cast<uint8_t>(i);
+  }
+  return codes;
+}
+
+}  // namespace
+
+TEST(G711BatchTest, KnownValues) {
+  EXPECT_EQ(0xD5, G711LinearToAlaw(0));
+  EXPECT_EQ(0xFF, G711LinearToUlaw(0));
+  EXPECT_EQ(0x2A, G711LinearToAlaw(-32768));
+  EXPECT_EQ(0xAA, G711LinearToAlaw(32767));
+  EXPECT_EQ(0x00, G711LinearToUlaw(-32768));
+  EXPECT_EQ(0x80, G711LinearToUlaw(32767));
+  EXPECT_EQ(8, G711AlawToLinear(0xD5));
+  EXPECT_EQ(0, G711UlawToLinear(0xFF));
+  EXPECT_EQ(-32124, G711UlawToLinear(0x00));
+  EXPECT_EQ(32256, G711AlawToLinear(0xAA));
+}
+
+TEST(G711BatchTest, EncodeMatchesReference) {
+  const std::vector<int16_t> samples = AllSamples();
+  std::vector<uint8_t> alaw(samples.size());
+  std::vector<uint8_t> ulaw(samples.size());
+  WebRtcG711Batch_EncodeA(samples.data(), samples.size(), alaw.data());
+  WebRtcG711Batch_EncodeU(samples.data(), samples.size(), ulaw.data());
+  for (size_t i = 0; i < samples.size(); ++i) {
+    ASSERT_EQ(G711LinearToAlaw(samples[i]), alaw[i]) << samples[i];
+    ASSERT_EQ(G711LinearToUlaw(samples[i]), ulaw[i]) << samples[i];
+  }
+}
+
+TEST(G711BatchTest, DecodeMatchesReference) {
+  const std::vector<uint8_t> codes = AllCodes();
+  std::vector<int16_t> alaw(codes.size());
+  std::vector<int16_t> ulaw(codes.size());
+  WebRtcG711Batch_DecodeA(codes.data(), codes.size(), alaw.data());
+  WebRtcG711Batch_DecodeU(codes.data(), codes.size(), ulaw.data());
+  for (size_t i = 0; i < codes.size(); ++i) {
+    EXPECT_EQ(G711AlawToLinear(codes[i]), alaw[i]) << i;
+    EXPECT_EQ(G711UlawToLinear(codes[i]), ulaw[i]) << i;
+  }
+}
+
+// Lengths that are not a multiple of the SIMD width exercise the scalar tail,
+// and an unaligned start exercises unaligned loads and stores.
+TEST(G711BatchTest, DecodeOddLengthsAndOffsets) {
+  Random random(42);
+  std::vector<uint8_t> codes(67);
+  for (uint8_t& code : codes) {
+    code = static_cast<uint8_t>(random.Rand(255));
+  }
+  for (size_t offset = 0; offset < 3; ++offset) {
+    for (size_t len = 0; len + offset <= codes.size(); ++len) {
+      std::vector<int16_t> decoded(len + 1, 0x1234);
+      WebRtcG711Batch_DecodeU(&codes[offset], len, decoded.data());
+      for (size_t i = 0; i < len; ++i) {
+        ASSERT_EQ(G711UlawToLinear(codes[offset + i]), decoded[i]);
+      }
+      WebRtcG711Batch_DecodeA(&codes[offset], len, decoded.data());
+      for (size_t i = 0; i < len; ++i) {
+        ASSERT_EQ(G711AlawToLinear(codes[offset + i]), decoded[i]);
+      }
+      // Nothing is written past the end.
+      EXPECT_EQ(0x1234, decoded[len]);
+    }
+  }
+}
+
+TEST(G711BatchTest, TranscodeMatchesDecodeThenEncode) {
+  const std::vector<uint8_t> codes = AllCodes();
+  std::vector<uint8_t> to_ulaw(codes.size());
+  std::vector<uint8_t> to_alaw(codes.size());
+  EXPECT_EQ(codes.size(), WebRtcG711_TranscodeAtoU(codes.data(), codes.size(),
+                                                   to_ulaw.data()));
+  EXPECT_EQ(codes.size(), WebRtcG711_TranscodeUtoA(codes.data(), codes.size(),
+                                                   to_alaw.data()));
+  for (size_t i = 0; i < codes.size(); ++i) {
+    EXPECT_EQ(G711LinearToUlaw(G711AlawToLinear(codes[i])), to_ulaw[i]) << i;
+    EXPECT_EQ(G711LinearToAlaw(G711UlawToLinear(codes[i])), to_alaw[i]) << i;
+  }
+
+  // In place.
+  std::vector<uint8_t> in_place = codes;
+  WebRtcG711_TranscodeAtoU(in_place.data(), in_place.size(), in_place.data());
+  EXPECT_EQ(to_ulaw, in_place);
+}
+
+TEST(G711BatchTest, InterfaceRoundTrip) {
+  const std::vector<int16_t> samples = AllSamples();
+  std::vector<uint8_t> encoded(samples.size());
+  std::vector<int16_t> decoded(samples.size());
+  int16_t speech_type = 0;
+  ASSERT_EQ(samples.size(), WebRtcG711_EncodeU(samples.data(), samples.size(),
+                                               encoded.data()));
+  ASSERT_EQ(samples.size(), WebRtcG711_DecodeU(encoded.data(), encoded.size(),
+                                               decoded.data(), &speech_type));
+  EXPECT_EQ(1, speech_type);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    // Decoded samples are on the quantization grid and survive another
+    // round trip unchanged.
+    ASSERT_EQ(decoded[i], G711UlawToLinear(G711LinearToUlaw(decoded[i])));
+  }
+}
+
+// Interleaved stereo through the PCMu/PCMa encoder and decoder keeps the
+// channels apart.
+TEST(G711BatchTest, StereoEncoderDecoder) {
+  constexpr size_t kChannels = 2;
+  constexpr size_t kSamplesPer10Ms = 80;
+  AudioEncoderPcmU::Config config_u;
+  config_u.num_channels = kChannels;
+  AudioEncoderPcmU encoder_u(config_u);
+  AudioEncoderPcmA::Config config_a;
+  config_a.num_channels = kChannels;
+  AudioEncoderPcmA encoder_a(config_a);
+  AudioDecoderPcmU decoder_u(kChannels);
+  AudioDecoderPcmA decoder_a(kChannels);
+
+  // Left channel is a positive ramp and right channel a negative ramp.
+  std::vector<int16_t> audio(kSamplesPer10Ms * kChannels);
+  for (size_t i = 0; i < kSamplesPer10Ms; ++i) {
+    audio[kChannels * i] = static_cast<int16_t>(i * 100);
+    audio[kChannels * i + 1] = static_cast<int16_t>(-1000 - i * 100);
+  }
+
+  rtc::Buffer encoded_u;
+  rtc::Buffer encoded_a;
+  for (uint32_t timestamp = 0; encoded_u.empty(); timestamp += 80) {
+    encoder_u.Encode(timestamp, audio, &encoded_u);
+    encoder_a.Encode(timestamp, audio, &encoded_a);
+  }
+  // 20 ms frames.
+  ASSERT_EQ(2 * audio.size(), encoded_u.size());
+  ASSERT_EQ(2 * audio.size(), encoded_a.size());
+
+  std::vector<int16_t> decoded(encoded_u.size());
+  AudioDecoder::SpeechType speech_type;
+  for (AudioDecoder* decoder :
+       {static_cast<AudioDecoder*>(&decoder_u),
+        static_cast<AudioDecoder*>(&decoder_a)}) {
+    const rtc::Buffer& encoded =
+        decoder == &decoder_u ? encoded_u : encoded_a;
+    ASSERT_EQ(static_cast<int>(decoded.size()),
+              decoder->Decode(encoded.data(), encoded.size(), 8000,
+                              decoded.size() * sizeof(int16_t), decoded.data(),
+                              &speech_type));
+    for (size_t i = 0; i < decoded.size(); ++i) {
+      const int16_t expected = audio[i % audio.size()];
+      // G.711 quantization error is at most half a step of the top segment.
+      EXPECT_NEAR(expected, decoded[i], 1024) << i;
+      EXPECT_EQ(expected >= 0, decoded[i] >= 0) << i;
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -10,24 +10,20 @@
 
 #include <string.h>
 
-#include "modules/third_party/g711/g711.h"
+#include "modules/audio_coding/codecs/g711/g711_batch.h"
 #include "modules/audio_coding/codecs/g711/g711_interface.h"
 
 size_t WebRtcG711_EncodeA(const int16_t* speechIn,
                           size_t len,
                           uint8_t* encoded) {
-  size_t n;
-  for (n = 0; n < len; n++)
-    encoded[n] = linear_to_alaw(speechIn[n]);
+  WebRtcG711Batch_EncodeA(speechIn, len, encoded);
   return len;
 }
 
 size_t WebRtcG711_EncodeU(const int16_t* speechIn,
                           size_t len,
                           uint8_t* encoded) {
-  size_t n;
-  for (n = 0; n < len; n++)
-    encoded[n] = linear_to_ulaw(speechIn[n]);
+  WebRtcG711Batch_EncodeU(speechIn, len, encoded);
   return len;
 }
 
@@ -35,9 +31,7 @@ size_t WebRtcG711_DecodeA(const uint8_t* encoded,
                           size_t len,
                           int16_t* decoded,
                           int16_t* speechType) {
-  size_t n;
-  for (n = 0; n < len; n++)
-    decoded[n] = alaw_to_linear(encoded[n]);
+  WebRtcG711Batch_DecodeA(encoded, len, decoded);
   *speechType = 1;
   return len;
 }
@@ -46,13 +40,25 @@ size_t WebRtcG711_DecodeU(const uint8_t* encoded,
                           size_t len,
                           int16_t* decoded,
                           int16_t* speechType) {
-  size_t n;
-  for (n = 0; n < len; n++)
-    decoded[n] = ulaw_to_linear(encoded[n]);
+  WebRtcG711Batch_DecodeU(encoded, len, decoded);
   *speechType = 1;
   return len;
 }
 
+size_t WebRtcG711_TranscodeAtoU(const uint8_t* alaw,
+                                size_t len,
+                                uint8_t* ulaw) {
+  WebRtcG711Batch_AlawToUlaw(alaw, len, ulaw);
+  return len;
+}
+
+size_t WebRtcG711_TranscodeUtoA(const uint8_t* ulaw,
+                                size_t len,
+                                uint8_t* alaw) {
+  WebRtcG711Batch_UlawToAlaw(ulaw, len, alaw);
+  return len;
+}
+
 int16_t WebRtcG711_Version(char* version, int16_t lenBytes) {
   strncpy(version, "2.0.0", lenBytes);
   return 0;
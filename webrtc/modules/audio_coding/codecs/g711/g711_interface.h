@@ -111,6 +111,52 @@ size_t WebRtcG711_DecodeU(const uint8_t* encoded,
                           int16_t* decoded,
                           int16_t* speechType);
 
+/****************************************************************************
+ * WebRtcG711_TranscodeAtoU(...)
+ *
+ * This function converts a G711 A-law frame to U-law without decoding to
+ * linear PCM. The result is identical to decoding with WebRtcG711_DecodeA()
+ * and encoding with WebRtcG711_EncodeU(). |alaw| and |ulaw| may point to the
+ * same buffer.
+ *
+ * Input:
+ *      - alaw               : A-law encoded data
+ *      - len                : Bytes in alaw
+ *
+ * Output:
+ *      - ulaw               : U-law encoded data
+ *
+ * Return value              : Length (in bytes) of the U-law data.
+ *                             Always equal to len input parameter.
+ */
+
+size_t WebRtcG711_TranscodeAtoU(const uint8_t* alaw,
+                                size_t len,
+                                uint8_t* ulaw);
+
+/****************************************************************************
+ * WebRtcG711_TranscodeUtoA(...)
+ *
+ * This function converts a G711 U-law frame to A-law without decoding to
+ * linear PCM. The result is identical to decoding with WebRtcG711_DecodeU()
+ * and encoding with WebRtcG711_EncodeA(). |ulaw| and |alaw| may point to the
+ * same buffer.
+ *
+ * Input:
+ *      - ulaw               : U-law encoded data
+ *      - len                : Bytes in ulaw
+ *
+ * Output:
+ *      - alaw               : A-law encoded data
+ *
+ * Return value              : Length (in bytes) of the A-law data.
+ *                             Always equal to len input parameter.
+ */
+
+size_t WebRtcG711_TranscodeUtoA(const uint8_t* ulaw,
+                                size_t len,
+                                uint8_t* alaw);
+
 /**********************************************************************
  * WebRtcG711_Version(...)
  *
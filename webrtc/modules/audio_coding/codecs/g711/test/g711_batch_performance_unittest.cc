@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "modules/audio_coding/codecs/g711/g711_batch.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+// One 20 ms frame at 48 kHz, which also covers a batch of 8 kHz legs.
+constexpr size_t kFrameSize = 960;
+
+// Runs |function| over a frame |num_frames| times on the calling thread and
+// reports the throughput in samples per second.
+template <typename In, typename Out>
+void RunAndReport(const std::string& name,
+                  void (*function)(const In*, size_t, Out*),
+                  const std::vector<In>& input,
+                  int num_frames) {
+  std::vector<Out> output(input.size());
+  Clock* clock = Clock::GetRealTimeClock();
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  int64_t checksum = 0;
+  for (int n = 0; n < num_frames; ++n) {
+    function(input.data(), input.size(), output.data());
+    checksum += output[n % output.size()];
+  }
+  const int64_t runtime_us = clock->TimeInMicroseconds() - start_time_us;
+  // Keep the compiler from removing the conversions.
+  EXPECT_NE(checksum, -1);
+  ASSERT_GT(runtime_us, 0);
+  test::PrintResult("g711_batch_performance", "", name,
+                    1e6 * num_frames * input.size() / runtime_us,
+                    "samples_per_second_per_core", true);
+}
+
+}  // namespace
+
+TEST(G711BatchPerformanceTest, Throughput) {
+  const int kNumFrames = 200000;
+  const int kQuickNumFrames = 1000;
+  const int num_frames = field_trial::IsEnabled("WebRTC-QuickPerfTest")
+                             ? kQuickNumFrames
+                             : kNumFrames;
+  Random random(0x12345678);
+  std::vector<int16_t> linear(kFrameSize);
+  std::vector<uint8_t> codes(kFrameSize);
+  for (size_t i = 0; i < kFrameSize; ++i) {
+    linear[i] = static_cast<int16_t>(random.Rand(-32768, 32767));
+    codes[i] = static_cast<uint8_t>(random.Rand(255));
+  }
+
+  RunAndReport("encode_alaw", WebRtcG711Batch_EncodeA, linear, num_frames);
+  RunAndReport("encode_ulaw", WebRtcG711Batch_EncodeU, linear, num_frames);
+  RunAndReport("decode_alaw", WebRtcG711Batch_DecodeA, codes, num_frames);
+  RunAndReport("decode_ulaw", WebRtcG711Batch_DecodeU, codes, num_frames);
+  RunAndReport("alaw_to_ulaw", WebRtcG711Batch_AlawToUlaw, codes, num_frames);
+  RunAndReport("ulaw_to_alaw", WebRtcG711Batch_UlawToAlaw, codes, num_frames);
+}
+
+}  // namespace webrtc
@@ -12,6 +12,8 @@
 #define MODULES_AUDIO_CODING_CODECS_G722_AUDIO_DECODER_G722_H_
 
 #include "api/audio_codecs/audio_decoder.h"
+#include "modules/audio_coding/codecs/g722/g722_core.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/constructor_magic.h"
 
 typedef struct WebRtcG722DecInst G722DecInst;
@@ -64,17 +66,19 @@ class AudioDecoderG722StereoImpl final : public AudioDecoder {
                      SpeechType* speech_type) override;
 
  private:
-  // Splits the stereo-interleaved payload in |encoded| into separate payloads
-  // for left and right channels. The separated payloads are written to
-  // |encoded_deinterleaved|, which must hold at least |encoded_len| samples.
-  // The left channel starts at offset 0, while the right channel starts at
-  // offset encoded_len / 2 into |encoded_deinterleaved|.
+  // Regroups the stereo-interleaved payload in |encoded|, which interleaves
+  // the channels by 4-bit halves, into whole G.722 bytes alternating between
+  // left and right channel. The result is written to |encoded_interleaved|,
+  // which must hold at least |encoded_len| bytes.
   void SplitStereoPacket(const uint8_t* encoded,
                          size_t encoded_len,
-                         uint8_t* encoded_deinterleaved);
+                         uint8_t* encoded_interleaved);
 
-  G722DecInst* dec_state_left_;
-  G722DecInst* dec_state_right_;
+  // Decodes both channels in lockstep.
+  G722DecoderCore<2> decoder_;
+  // Holds the regrouped payload. It is kept between calls, so that it is only
+  // reallocated when a larger payload arrives.
+  rtc::Buffer encoded_interleaved_;
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioDecoderG722StereoImpl);
 };
 
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/g722/audio_decoder_g722.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kSampleRateHz = 16000;
+
+// Packs the single-stream G.722 payloads |left| and |right| into a stereo
+// payload, interleaving the channels by 4-bit halves as the stereo encoder
+// does: |l1 r1| |l2 r2| ..., where "lx" is the 4 bits of left sample x.
+std::vector<uint8_t> PackStereo(const std::vector<uint8_t>& left,
+                                const std::vector<uint8_t>& right) {
+  std::vector<uint8_t> stereo(2 * left.size());
+  for (size_t i = 0; i < left.size(); ++i) {
+    stereo[2 * i] = (left[i] & 0xF0) | (right[i] >> 4);
+    stereo[2 * i + 1] = (left[i] << 4) | (right[i] & 0x0F);
+  }
+  return stereo;
+}
+
+}  // namespace
+
+// Verifies that the stereo decoder gives the same output as one
+// single-stream decoder per channel, for a sequence of payloads of varying
+// sizes decoded with the same decoder.
+TEST(AudioDecoderG722Test, StereoMatchesSingleStreamDecoders) {
+  Random random_generator(42U);
+  AudioDecoderG722StereoImpl stereo_decoder;
+  AudioDecoderG722Impl left_decoder;
+  AudioDecoderG722Impl right_decoder;
+  for (int n = 0; n < 200; ++n) {
+    // 5 to 60 ms per channel, so that the payload both grows and shrinks
+    // between calls.
+    const size_t bytes_per_channel = 40 * random_generator.Rand(1, 12);
+    std::vector<uint8_t> left(bytes_per_channel);
+    std::vector<uint8_t> right(bytes_per_channel);
+    for (size_t i = 0; i < bytes_per_channel; ++i) {
+      left[i] = random_generator.Rand<uint8_t>();
+      right[i] = random_generator.Rand<uint8_t>();
+    }
+    const std::vector<uint8_t> stereo = PackStereo(left, right);
+
+    const size_t samples_per_channel = 2 * bytes_per_channel;
+    std::vector<int16_t> decoded(2 * samples_per_channel);
+    std::vector<int16_t> decoded_left(samples_per_channel);
+    std::vector<int16_t> decoded_right(samples_per_channel);
+    AudioDecoder::SpeechType speech_type;
+    ASSERT_EQ(static_cast<int>(2 * samples_per_channel),
+              stereo_decoder.Decode(stereo.data(), stereo.size(),
+                                    kSampleRateHz,
+                                    decoded.size() * sizeof(int16_t),
+                                    decoded.data(), &speech_type));
+    ASSERT_EQ(static_cast<int>(samples_per_channel),
+              left_decoder.Decode(left.data(), left.size(), kSampleRateHz,
+                                  decoded_left.size() * sizeof(int16_t),
+                                  decoded_left.data(), &speech_type));
+    ASSERT_EQ(static_cast<int>(samples_per_channel),
+              right_decoder.Decode(right.data(), right.size(), kSampleRateHz,
+                                   decoded_right.size() * sizeof(int16_t),
+                                   decoded_right.data(), &speech_type));
+    for (size_t k = 0; k < samples_per_channel; ++k) {
+      ASSERT_EQ(decoded_left[k], decoded[2 * k]) << "packet " << n;
+      ASSERT_EQ(decoded_right[k], decoded[2 * k + 1]) << "packet " << n;
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -12,7 +12,6 @@
 
 #include <cstdint>
 
-#include "modules/audio_coding/codecs/g722/g722_interface.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
 
@@ -32,15 +31,10 @@ AudioEncoderG722Impl::AudioEncoderG722Impl(const AudioEncoderG722Config& config,
           static_cast<size_t>(config.frame_size_ms / 10)),
       num_10ms_frames_buffered_(0),
       first_timestamp_in_buffer_(0),
-      encoders_(new EncoderState[num_channels_]),
+      encoder_(num_channels_),
+      encoded_buffer_(SamplesPerChannel() / 2 * num_channels_),
       interleave_buffer_(2 * num_channels_) {
   RTC_CHECK(config.IsOk());
-  const size_t samples_per_channel =
-      kSampleRateHz / 100 * num_10ms_frames_per_packet_;
-  for (size_t i = 0; i < num_channels_; ++i) {
-    encoders_[i].speech_buffer.reset(new int16_t[samples_per_channel]);
-    encoders_[i].encoded_buffer.SetSize(samples_per_channel / 2);
-  }
   Reset();
 }
 
@@ -75,8 +69,7 @@ int AudioEncoderG722Impl::GetTargetBitrate() const {
 
 void AudioEncoderG722Impl::Reset() {
   num_10ms_frames_buffered_ = 0;
-  for (size_t i = 0; i < num_channels_; ++i)
-    RTC_CHECK_EQ(0, WebRtcG722_EncoderInit(encoders_[i].encoder));
+  encoder_.Reset();
 }
 
 absl::optional<std::pair<TimeDelta, TimeDelta>>
@@ -92,27 +85,24 @@ AudioEncoder::EncodedInfo AudioEncoderG722Impl::EncodeImpl(
   if (num_10ms_frames_buffered_ == 0)
     first_timestamp_in_buffer_ = rtp_timestamp;
 
-  // Deinterleave samples and save them in each channel's buffer.
-  const size_t start = kSampleRateHz / 100 * num_10ms_frames_buffered_;
-  for (size_t i = 0; i < kSampleRateHz / 100; ++i)
-    for (size_t j = 0; j < num_channels_; ++j)
-      encoders_[j].speech_buffer[start + i] = audio[i * num_channels_ + j];
+  // Encode all channels of the 10 ms frame right away; the encoder state
+  // carries over between frames, so there is no need to buffer audio.
+  constexpr size_t kSamplesPer10Ms = kSampleRateHz / 100;
+  RTC_DCHECK_EQ(audio.size(), kSamplesPer10Ms * num_channels_);
+  const size_t bytes_encoded = encoder_.Encode(
+      audio.data(), kSamplesPer10Ms,
+      &encoded_buffer_[kSamplesPer10Ms / 2 * num_channels_ *
+                       num_10ms_frames_buffered_]);
+  RTC_CHECK_EQ(bytes_encoded, kSamplesPer10Ms / 2);
 
   // If we don't yet have enough samples for a packet, we're done for now.
   if (++num_10ms_frames_buffered_ < num_10ms_frames_per_packet_) {
     return EncodedInfo();
   }
 
-  // Encode each channel separately.
   RTC_CHECK_EQ(num_10ms_frames_buffered_, num_10ms_frames_per_packet_);
   num_10ms_frames_buffered_ = 0;
   const size_t samples_per_channel = SamplesPerChannel();
-  for (size_t i = 0; i < num_channels_; ++i) {
-    const size_t bytes_encoded = WebRtcG722_Encode(
-        encoders_[i].encoder, encoders_[i].speech_buffer.get(),
-        samples_per_channel, encoders_[i].encoded_buffer.data());
-    RTC_CHECK_EQ(bytes_encoded, samples_per_channel / 2);
-  }
 
   const size_t bytes_to_encode = samples_per_channel / 2 * num_channels_;
   EncodedInfo info;
@@ -123,7 +113,7 @@ AudioEncoder::EncodedInfo AudioEncoderG722Impl::EncodeImpl(
         // significant half first.
         for (size_t i = 0; i < samples_per_channel / 2; ++i) {
           for (size_t j = 0; j < num_channels_; ++j) {
-            uint8_t two_samples = encoders_[j].encoded_buffer.data()[i];
+            uint8_t two_samples = encoded_buffer_[i * num_channels_ + j];
             interleave_buffer_.data()[j] = two_samples >> 4;
             interleave_buffer_.data()[num_channels_ + j] = two_samples & 0xf;
           }
@@ -141,14 +131,6 @@ AudioEncoder::EncodedInfo AudioEncoderG722Impl::EncodeImpl(
   return info;
 }
 
-AudioEncoderG722Impl::EncoderState::EncoderState() {
-  RTC_CHECK_EQ(0, WebRtcG722_CreateEncoder(&encoder));
-}
-
-AudioEncoderG722Impl::EncoderState::~EncoderState() {
-  RTC_CHECK_EQ(0, WebRtcG722_FreeEncoder(encoder));
-}
-
 size_t AudioEncoderG722Impl::SamplesPerChannel() const {
   return kSampleRateHz / 100 * num_10ms_frames_per_packet_;
 }
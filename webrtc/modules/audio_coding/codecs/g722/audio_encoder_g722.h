@@ -11,14 +11,13 @@
 #ifndef MODULES_AUDIO_CODING_CODECS_G722_AUDIO_ENCODER_G722_H_
 #define MODULES_AUDIO_CODING_CODECS_G722_AUDIO_ENCODER_G722_H_
 
-#include <memory>
 #include <utility>
 
 #include "absl/types/optional.h"
 #include "api/audio_codecs/audio_encoder.h"
 #include "api/audio_codecs/g722/audio_encoder_g722_config.h"
 #include "api/units/time_delta.h"
-#include "modules/audio_coding/codecs/g722/g722_interface.h"
+#include "modules/audio_coding/codecs/g722/g722_core.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/constructor_magic.h"
 
@@ -45,15 +44,6 @@ class AudioEncoderG722Impl final : public AudioEncoder {
                          rtc::Buffer* encoded) override;
 
  private:
-  // The encoder state for one channel.
-  struct EncoderState {
-    G722EncInst* encoder;
-    std::unique_ptr<int16_t[]> speech_buffer;  // Queued up for encoding.
-    rtc::Buffer encoded_buffer;                // Already encoded.
-    EncoderState();
-    ~EncoderState();
-  };
-
   size_t SamplesPerChannel() const;
 
   const size_t num_channels_;
@@ -61,7 +51,11 @@ class AudioEncoderG722Impl final : public AudioEncoder {
   const size_t num_10ms_frames_per_packet_;
   size_t num_10ms_frames_buffered_;
   uint32_t first_timestamp_in_buffer_;
-  const std::unique_ptr<EncoderState[]> encoders_;
+  // Encodes all channels in lockstep, straight from the interleaved input.
+  G722MultiChannelEncoder encoder_;
+  // Encoded bytes of the packet so far, one byte per channel and sample pair,
+  // interleaved by channel.
+  rtc::Buffer encoded_buffer_;
   rtc::Buffer interleave_buffer_;
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioEncoderG722Impl);
 };
@@ -0,0 +1,514 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/g722/g722_core.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+// The block names in the comments below (e.g. "Block 4, UPPOL2") refer to the
+// G.722 specification, which this implementation follows at 64 kbit/s.
+
+namespace webrtc {
+
+namespace {
+
+using g722_internal::BandState;
+using g722_internal::kQmfHistory;
+
+// Number of byte periods (sample pairs) per lane processed in one block, i.e.
+// 10 ms.
+constexpr size_t kBlockPairs = 80;
+
+constexpr size_t kQmfTaps = 24;
+
+// Even coefficients of the QMF. The odd ones are the same in reverse order.
+constexpr int32_t kQmfCoeffs[kQmfTaps / 2] = {3,    -11, 12,  32,   -210, 951,
+                                              3876, -805, 362, -156, 53,   -11};
+
+// Low-band quantizer decision levels, Q12 relative to the scale factor. The
+// last level is repeated to pad the table for the binary search.
+constexpr int32_t kQ6[32] = {0,    35,   72,   110,  150,  190,  233,  276,
+                             323,  370,  422,  473,  530,  587,  650,  714,
+                             786,  858,  940,  1023, 1121, 1219, 1339, 1458,
+                             1612, 1765, 1980, 2195, 2557, 2919, 2919, 2919};
+
+// Low-band 6-bit inverse quantizer output levels.
+constexpr int32_t kQm6[64] = {
+    -136,   -136,   -136,   -136,   -24808, -21904, -19008, -16704,
+    -14984, -13512, -12280, -11192, -10232, -9360,  -8576,  -7856,
+    -7192,  -6576,  -6000,  -5456,  -4944,  -4464,  -4008,  -3576,
+    -3168,  -2776,  -2400,  -2032,  -1688,  -1360,  -1040,  -728,
+    24808,  21904,  19008,  16704,  14984,  13512,  12280,  11192,
+    10232,  9360,   8576,   7856,   7192,   6576,   6000,   5456,
+    4944,   4464,   4008,   3576,   3168,   2776,   2400,   2032,
+    1688,   1360,   1040,   728,    432,    136,    -432,   -136};
+
+// Low-band 4-bit inverse quantizer output levels, used for prediction.
+constexpr int32_t kQm4[16] = {0,     -20456, -12896, -8968, -6288, -4240,
+                              -2584, -1200,  20456,  12896, 8968,  6288,
+                              4240,  2584,   1200,   0};
+
+// Low-band scale factor multipliers, indexed through kRl42.
+constexpr int32_t kWl[8] = {-60, -30, 58, 172, 334, 538, 1198, 3042};
+constexpr int32_t kRl42[16] = {0, 7, 6, 5, 4, 3, 2, 1, 7, 6, 5, 4, 3, 2, 1, 0};
+
+// High-band inverse quantizer output levels and scale factor multipliers.
+constexpr int32_t kQm2[4] = {-7408, -1616, 7408, 1616};
+constexpr int32_t kWh[3] = {0, -214, 798};
+constexpr int32_t kRh2[4] = {2, 1, 2, 1};
+
+// Inverse logarithmic scale factor table.
+constexpr int32_t kIlb[32] = {
+    2048, 2093, 2139, 2186, 2233, 2282, 2332, 2383, 2435, 2489, 2543,
+    2599, 2656, 2714, 2774, 2834, 2896, 2960, 3025, 3091, 3158, 3228,
+    3298, 3371, 3444, 3520, 3597, 3676, 3756, 3838, 3922, 4008};
+
+// Low and high band limits of the logarithmic scale factor, and the shift
+// that turns it into a linear scale factor.
+constexpr int32_t kMaxNbLow = 18432;
+constexpr int32_t kMaxNbHigh = 22528;
+constexpr int32_t kScaleShiftLow = 8;
+constexpr int32_t kScaleShiftHigh = 10;
+
+inline int32_t Clamp(int32_t value, int32_t min, int32_t max) {
+  return std::min(std::max(value, min), max);
+}
+
+inline int32_t Saturate(int32_t value) {
+  return Clamp(value, -32768, 32767);
+}
+
+template <size_t N>
+void ResetBand(int32_t det, BandState<N>* band) {
+  memset(band, 0, sizeof(*band));
+  for (size_t k = 0; k < N; ++k) {
+    band->det[k] = det;
+  }
+}
+
+// Blocks 3L/3H, LOGSCL/LOGSCH and SCALEL/SCALEH: adapts the scale factor of
+// each lane with the multiplier in |w|.
+template <size_t N>
+void UpdateScaleFactor(const int32_t* w,
+                       int32_t max_nb,
+                       int32_t scale_shift,
+                       BandState<N>* band) {
+  for (size_t k = 0; k < N; ++k) {
+    const int32_t nb = Clamp(((band->nb[k] * 127) >> 7) + w[k], 0, max_nb);
+    band->nb[k] = nb;
+    // The specification shifts left by one when the shift below is -1; doing
+    // that unconditionally first gives the same result for all shifts.
+    const int32_t ilb = kIlb[(nb >> 6) & 31] << 1;
+    band->det[k] = (ilb >> (scale_shift + 1 - (nb >> 11))) << 2;
+  }
+}
+
+// Block 4: updates the adaptive predictor of each lane with the quantized
+// difference signal |d|, and computes the next predicted signal.
+template <size_t N>
+void UpdatePredictor(const int32_t* d, BandState<N>* band) {
+  int32_t d_sign[N];
+  for (size_t k = 0; k < N; ++k) {
+    // RECONS and PARREC.
+    const int32_t r0 = Saturate(band->s[k] + d[k]);
+    const int32_t p0 = Saturate(band->sz[k] + d[k]);
+    const int32_t sg0 = p0 >> 15;
+    const int32_t sg1 = band->p[1][k] >> 15;
+    const int32_t sg2 = band->p[2][k] >> 15;
+    const int32_t a1 = band->a[1][k];
+    const int32_t a2 = band->a[2][k];
+
+    // UPPOL2.
+    int32_t wd1 = Saturate(a1 * 4);
+    int32_t wd2 = std::min(sg0 == sg1 ? -wd1 : wd1, 32767);
+    int32_t wd3 = (wd2 >> 7) + (sg0 == sg2 ? 128 : -128) + ((a2 * 32512) >> 15);
+    const int32_t ap2 = Clamp(wd3, -12288, 12288);
+
+    // UPPOL1.
+    wd1 = sg0 == sg1 ? 192 : -192;
+    wd2 = (a1 * 32640) >> 15;
+    wd3 = Saturate(15360 - ap2);
+    const int32_t ap1 = Clamp(Saturate(wd1 + wd2), -wd3, wd3);
+
+    // DELAYA for the pole section.
+    band->r[2][k] = band->r[1][k];
+    band->r[1][k] = r0;
+    band->p[2][k] = band->p[1][k];
+    band->p[1][k] = p0;
+    band->a[1][k] = ap1;
+    band->a[2][k] = ap2;
+
+    // FILTEP.
+    wd1 = (ap1 * Saturate(2 * band->r[1][k])) >> 15;
+    wd2 = (ap2 * Saturate(2 * band->r[2][k])) >> 15;
+    band->sp[k] = Saturate(wd1 + wd2);
+    d_sign[k] = d[k] >> 15;
+  }
+
+  // UPZERO.
+  for (size_t i = 1; i < 7; ++i) {
+    for (size_t k = 0; k < N; ++k) {
+      const int32_t step = d[k] == 0 ? 0 : 128;
+      const int32_t wd2 = (band->d[i][k] >> 15) == d_sign[k] ? step : -step;
+      band->b[i][k] = Saturate(wd2 + ((band->b[i][k] * 32640) >> 15));
+    }
+  }
+
+  // DELAYA for the zero section.
+  for (size_t i = 6; i > 1; --i) {
+    for (size_t k = 0; k < N; ++k) {
+      band->d[i][k] = band->d[i - 1][k];
+    }
+  }
+  for (size_t k = 0; k < N; ++k) {
+    band->d[1][k] = d[k];
+  }
+
+  // FILTEZ and PREDIC.
+  int32_t sz[N] = {0};
+  for (size_t i = 1; i < 7; ++i) {
+    for (size_t k = 0; k < N; ++k) {
+      sz[k] += (band->b[i][k] * Saturate(2 * band->d[i][k])) >> 15;
+    }
+  }
+  for (size_t k = 0; k < N; ++k) {
+    band->sz[k] = Saturate(sz[k]);
+    band->s[k] = Saturate(band->sp[k] + band->sz[k]);
+  }
+}
+
+}  // namespace
+
+template <size_t kLanes>
+G722EncoderCore<kLanes>::G722EncoderCore() {
+  static_assert(kLanes == 1 || kLanes == 2 || kLanes == 4 || kLanes == 8,
+                "Unsupported number of lanes");
+  Reset();
+}
+
+template <size_t kLanes>
+void G722EncoderCore<kLanes>::Reset() {
+  memset(qmf_history_, 0, sizeof(qmf_history_));
+  ResetBand(32, &low_band_);
+  ResetBand(8, &high_band_);
+}
+
+template <size_t kLanes>
+size_t G722EncoderCore<kLanes>::Encode(const int16_t* input,
+                                       size_t input_stride,
+                                       size_t samples_per_lane,
+                                       uint8_t* output,
+                                       size_t output_stride) {
+  RTC_DCHECK_EQ(samples_per_lane % 2, 0);
+  RTC_DCHECK_GE(input_stride, kLanes);
+  RTC_DCHECK_GE(output_stride, kLanes);
+  const size_t bytes_per_lane = samples_per_lane / 2;
+
+  // QMF input: the history followed by the samples of the current block.
+  int32_t x[kQmfHistory + 2 * kBlockPairs][kLanes];
+  int32_t x_low[kBlockPairs][kLanes];
+  int32_t x_high[kBlockPairs][kLanes];
+  for (size_t start = 0; start < bytes_per_lane; start += kBlockPairs) {
+    const size_t num_pairs = std::min(kBlockPairs, bytes_per_lane - start);
+    memcpy(x, qmf_history_, sizeof(qmf_history_));
+    for (size_t n = 0; n < 2 * num_pairs; ++n) {
+      const int16_t* in = &input[(2 * start + n) * input_stride];
+      for (size_t k = 0; k < kLanes; ++k) {
+        x[kQmfHistory + n][k] = in[k];
+      }
+    }
+    memcpy(qmf_history_, x[2 * num_pairs], sizeof(qmf_history_));
+
+    // Transmit QMF, keeping every other output. The shift by 14 removes the
+    // DC gain of 4096 of the filters, the gain of 2 from summing two filters,
+    // and scales the input to the 15 bits expected by the ADPCM coders.
+    for (size_t j = 0; j < num_pairs; ++j) {
+      int32_t sum_odd[kLanes] = {0};
+      int32_t sum_even[kLanes] = {0};
+      for (size_t i = 0; i < kQmfTaps / 2; ++i) {
+        for (size_t k = 0; k < kLanes; ++k) {
+          sum_odd[k] += x[2 * j + 2 * i][k] * kQmfCoeffs[i];
+          sum_even[k] += x[2 * j + 2 * i + 1][k] * kQmfCoeffs[11 - i];
+        }
+      }
+      for (size_t k = 0; k < kLanes; ++k) {
+        x_low[j][k] = static_cast<int16_t>((sum_even[k] + sum_odd[k]) >> 14);
+        x_high[j][k] = static_cast<int16_t>((sum_even[k] - sum_odd[k]) >> 14);
+      }
+    }
+
+    for (size_t j = 0; j < num_pairs; ++j) {
+      int32_t e[kLanes];
+      int32_t magnitude[kLanes];
+      int32_t interval[kLanes];
+      int32_t code[kLanes];
+      int32_t d[kLanes];
+      int32_t w[kLanes];
+
+      // Block 1L, SUBTRA and QUANTL. The quantizer interval is one more than
+      // the number of decision levels at or below the magnitude, counted by a
+      // branch-free binary search and limited to the 30 intervals.
+      for (size_t k = 0; k < kLanes; ++k) {
+        e[k] = Saturate(x_low[j][k] - low_band_.s[k]);
+        magnitude[k] = e[k] >= 0 ? e[k] : -(e[k] + 1);
+        interval[k] = 0;
+      }
+      for (int32_t step = 16; step > 0; step >>= 1) {
+        for (size_t k = 0; k < kLanes; ++k) {
+          const int32_t level =
+              (kQ6[interval[k] + step] * low_band_.det[k]) >> 12;
+          interval[k] += magnitude[k] >= level ? step : 0;
+        }
+      }
+      for (size_t k = 0; k < kLanes; ++k) {
+        interval[k] = std::min(interval[k], 29) + 1;
+      }
+      for (size_t k = 0; k < kLanes; ++k) {
+        // Code words for positive and negative differences (tables ILP and
+        // ILN of the specification).
+        const int32_t i = interval[k];
+        code[k] = e[k] >= 0 ? 62 - i : (i < 3 ? 64 - i : 34 - i);
+
+        // Block 2L, INVQAL.
+        const int32_t ril = code[k] >> 2;
+        d[k] = (low_band_.det[k] * kQm4[ril]) >> 15;
+        w[k] = kWl[kRl42[ril]];
+      }
+      UpdateScaleFactor(w, kMaxNbLow, kScaleShiftLow, &low_band_);
+      UpdatePredictor(d, &low_band_);
+
+      for (size_t k = 0; k < kLanes; ++k) {
+        // Block 1H, SUBTRA and QUANTH.
+        e[k] = Saturate(x_high[j][k] - high_band_.s[k]);
+        magnitude[k] = e[k] >= 0 ? e[k] : -(e[k] + 1);
+        const bool outer = magnitude[k] >= ((564 * high_band_.det[k]) >> 12);
+        const int32_t ihigh = (e[k] >= 0 ? 2 : 0) + (outer ? 0 : 1);
+        code[k] |= ihigh << 6;
+
+        // Block 2H, INVQAH.
+        d[k] = (high_band_.det[k] * kQm2[ihigh]) >> 15;
+        w[k] = kWh[kRh2[ihigh]];
+      }
+      UpdateScaleFactor(w, kMaxNbHigh, kScaleShiftHigh, &high_band_);
+      UpdatePredictor(d, &high_band_);
+
+      uint8_t* out = &output[(start + j) * output_stride];
+      for (size_t k = 0; k < kLanes; ++k) {
+        out[k] = static_cast<uint8_t>(code[k]);
+      }
+    }
+  }
+  return bytes_per_lane;
+}
+
+template <size_t kLanes>
+G722DecoderCore<kLanes>::G722DecoderCore() {
+  static_assert(kLanes == 1 || kLanes == 2 || kLanes == 4 || kLanes == 8,
+                "Unsupported number of lanes");
+  Reset();
+}
+
+template <size_t kLanes>
+void G722DecoderCore<kLanes>::Reset() {
+  memset(qmf_history_, 0, sizeof(qmf_history_));
+  ResetBand(32, &low_band_);
+  ResetBand(8, &high_band_);
+}
+
+template <size_t kLanes>
+size_t G722DecoderCore<kLanes>::Decode(const uint8_t* input,
+                                       size_t input_stride,
+                                       size_t bytes_per_lane,
+                                       int16_t* output,
+                                       size_t output_stride) {
+  RTC_DCHECK_GE(input_stride, kLanes);
+  RTC_DCHECK_GE(output_stride, kLanes);
+
+  // QMF input: the history followed by the reconstructed sub-band sum and
+  // difference signals of the current block.
+  int32_t x[kQmfHistory + 2 * kBlockPairs][kLanes];
+  for (size_t start = 0; start < bytes_per_lane; start += kBlockPairs) {
+    const size_t num_pairs = std::min(kBlockPairs, bytes_per_lane - start);
+    memcpy(x, qmf_history_, sizeof(qmf_history_));
+
+    for (size_t j = 0; j < num_pairs; ++j) {
+      const uint8_t* in = &input[(start + j) * input_stride];
+      int32_t r_low[kLanes];
+      int32_t ihigh[kLanes];
+      int32_t d[kLanes];
+      int32_t w[kLanes];
+
+      for (size_t k = 0; k < kLanes; ++k) {
+        const int32_t ilow = in[k] & 0x3F;
+        ihigh[k] = in[k] >> 6;
+
+        // Block 5L, INVQBL, RECONS and LIMIT.
+        const int32_t d_low = (low_band_.det[k] * kQm6[ilow]) >> 15;
+        r_low[k] = Clamp(low_band_.s[k] + d_low, -16384, 16383);
+
+        // Block 2L, INVQAL.
+        const int32_t ril = ilow >> 2;
+        d[k] = (low_band_.det[k] * kQm4[ril]) >> 15;
+        w[k] = kWl[kRl42[ril]];
+      }
+      UpdateScaleFactor(w, kMaxNbLow, kScaleShiftLow, &low_band_);
+      UpdatePredictor(d, &low_band_);
+
+      for (size_t k = 0; k < kLanes; ++k) {
+        // Block 2H, INVQAH, and block 5H, RECONS and LIMIT.
+        d[k] = (high_band_.det[k] * kQm2[ihigh[k]]) >> 15;
+        const int32_t r_high = Clamp(high_band_.s[k] + d[k], -16384, 16383);
+        w[k] = kWh[kRh2[ihigh[k]]];
+        x[kQmfHistory + 2 * j][k] = r_low[k] + r_high;
+        x[kQmfHistory + 2 * j + 1][k] = r_low[k] - r_high;
+      }
+      UpdateScaleFactor(w, kMaxNbHigh, kScaleShiftHigh, &high_band_);
+      UpdatePredictor(d, &high_band_);
+    }
+
+    // Receive QMF. The shift by 11 removes the DC gain of 4096 of the filters
+    // and scales the 15-bit sub-band signals back to 16 bits.
+    for (size_t j = 0; j < num_pairs; ++j) {
+      int32_t sum_odd[kLanes] = {0};
+      int32_t sum_even[kLanes] = {0};
+      for (size_t i = 0; i < kQmfTaps / 2; ++i) {
+        for (size_t k = 0; k < kLanes; ++k) {
+          sum_odd[k] += x[2 * j + 2 * i][k] * kQmfCoeffs[i];
+          sum_even[k] += x[2 * j + 2 * i + 1][k] * kQmfCoeffs[11 - i];
+        }
+      }
+      int16_t* out = &output[2 * (start + j) * output_stride];
+      for (size_t k = 0; k < kLanes; ++k) {
+        out[k] = static_cast<int16_t>(Saturate(sum_even[k] >> 11));
+        out[output_stride + k] =
+            static_cast<int16_t>(Saturate(sum_odd[k] >> 11));
+      }
+    }
+    memcpy(qmf_history_, x[2 * num_pairs], sizeof(qmf_history_));
+  }
+  return 2 * bytes_per_lane;
+}
+
+template class G722EncoderCore<1>;
+template class G722EncoderCore<2>;
+template class G722EncoderCore<4>;
+template class G722EncoderCore<8>;
+template class G722DecoderCore<1>;
+template class G722DecoderCore<2>;
+template class G722DecoderCore<4>;
+template class G722DecoderCore<8>;
+
+G722MultiChannelEncoder::G722MultiChannelEncoder(size_t num_channels)
+    : num_channels_(num_channels), groups_of_8_(num_channels / 8) {
+  RTC_DCHECK_GE(num_channels, 1);
+  if (num_channels & 4)
+    group_of_4_.reset(new G722EncoderCore<4>());
+  if (num_channels & 2)
+    group_of_2_.reset(new G722EncoderCore<2>());
+  if (num_channels & 1)
+    group_of_1_.reset(new G722EncoderCore<1>());
+}
+
+G722MultiChannelEncoder::~G722MultiChannelEncoder() = default;
+
+void G722MultiChannelEncoder::Reset() {
+  for (auto& group : groups_of_8_)
+    group.Reset();
+  if (group_of_4_)
+    group_of_4_->Reset();
+  if (group_of_2_)
+    group_of_2_->Reset();
+  if (group_of_1_)
+    group_of_1_->Reset();
+}
+
+size_t G722MultiChannelEncoder::Encode(const int16_t* input,
+                                       size_t samples_per_channel,
+                                       uint8_t* output) {
+  const size_t stride = num_channels_;
+  size_t channel = 0;
+  for (auto& group : groups_of_8_) {
+    group.Encode(input + channel, stride, samples_per_channel, output + channel,
+                 stride);
+    channel += 8;
+  }
+  if (group_of_4_) {
+    group_of_4_->Encode(input + channel, stride, samples_per_channel,
+                        output + channel, stride);
+    channel += 4;
+  }
+  if (group_of_2_) {
+    group_of_2_->Encode(input + channel, stride, samples_per_channel,
+                        output + channel, stride);
+    channel += 2;
+  }
+  if (group_of_1_) {
+    group_of_1_->Encode(input + channel, stride, samples_per_channel,
+                        output + channel, stride);
+  }
+  return samples_per_channel / 2;
+}
+
+G722MultiChannelDecoder::G722MultiChannelDecoder(size_t num_channels)
+    : num_channels_(num_channels), groups_of_8_(num_channels / 8) {
+  RTC_DCHECK_GE(num_channels, 1);
+  if (num_channels & 4)
+    group_of_4_.reset(new G722DecoderCore<4>());
+  if (num_channels & 2)
+    group_of_2_.reset(new G722DecoderCore<2>());
+  if (num_channels & 1)
+    group_of_1_.reset(new G722DecoderCore<1>());
+}
+
+G722MultiChannelDecoder::~G722MultiChannelDecoder() = default;
+
+void G722MultiChannelDecoder::Reset() {
+  for (auto& group : groups_of_8_)
+    group.Reset();
+  if (group_of_4_)
+    group_of_4_->Reset();
+  if (group_of_2_)
+    group_of_2_->Reset();
+  if (group_of_1_)
+    group_of_1_->Reset();
+}
+
+size_t G722MultiChannelDecoder::Decode(const uint8_t* input,
+                                       size_t bytes_per_channel,
+                                       int16_t* output) {
+  const size_t stride = num_channels_;
+  size_t channel = 0;
+  for (auto& group : groups_of_8_) {
+    group.Decode(input + channel, stride, bytes_per_channel, output + channel,
+                 stride);
+    channel += 8;
+  }
+  if (group_of_4_) {
+    group_of_4_->Decode(input + channel, stride, bytes_per_channel,
+                        output + channel, stride);
+    channel += 4;
+  }
+  if (group_of_2_) {
+    group_of_2_->Decode(input + channel, stride, bytes_per_channel,
+                        output + channel, stride);
+    channel += 2;
+  }
+  if (group_of_1_) {
+    group_of_1_->Decode(input + channel, stride, bytes_per_channel,
+                        output + channel, stride);
+  }
+  return 2 * bytes_per_channel;
+}
+
+}  // namespace webrtc
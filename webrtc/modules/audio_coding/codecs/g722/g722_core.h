@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_G722_G722_CORE_H_
+#define MODULES_AUDIO_CODING_CODECS_G722_G722_CORE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+namespace webrtc {
+
+namespace g722_internal {
+
+// Number of past input samples (encoder) or reconstructed samples (decoder)
+// kept by the 24-tap QMF.
+constexpr size_t kQmfHistory = 22;
+
+// ADPCM state of one sub-band for |N| lanes. Each field stores the values of
+// all lanes next to each other, so that the lanes can be updated together.
+// History index 0 is unused so that the indices match the G.722
+// specification.
+template <size_t N>
+struct BandState {
+  int32_t s[N];     // Predicted signal.
+  int32_t sp[N];    // Pole section of the predicted signal.
+  int32_t sz[N];    // Zero section of the predicted signal.
+  int32_t r[3][N];  // Reconstructed signal.
+  int32_t p[3][N];  // Partially reconstructed signal.
+  int32_t a[3][N];  // Pole predictor coefficients.
+  int32_t d[7][N];  // Quantized difference signal.
+  int32_t b[7][N];  // Zero predictor coefficients.
+  int32_t nb[N];    // Logarithmic quantizer scale factor.
+  int32_t det[N];   // Quantizer scale factor.
+};
+
+}  // namespace g722_internal
+
+// G.722 encoder at 64 kbit/s for |kLanes| independent streams, e.g. the
+// channels of one signal or unrelated calls. All lanes advance in lockstep,
+// with branch-free arithmetic over the lane arrays that the compiler can
+// vectorize. Each lane is bit-exact with a single-stream G.722 encoder.
+// |kLanes| must be 1, 2, 4 or 8.
+template <size_t kLanes>
+class G722EncoderCore {
+ public:
+  G722EncoderCore();
+
+  void Reset();
+
+  // Encodes |samples_per_lane| 16 kHz samples of each lane into one byte per
+  // two samples. Sample i of lane k is read from input[i * input_stride + k]
+  // and byte j of lane k is written to output[j * output_stride + k].
+  // |samples_per_lane| must be even. Returns the number of bytes per lane.
+  size_t Encode(const int16_t* input,
+                size_t input_stride,
+                size_t samples_per_lane,
+                uint8_t* output,
+                size_t output_stride);
+
+ private:
+  int32_t qmf_history_[g722_internal::kQmfHistory][kLanes];
+  g722_internal::BandState<kLanes> low_band_;
+  g722_internal::BandState<kLanes> high_band_;
+};
+
+// The decoding counterpart of G722EncoderCore.
+template <size_t kLanes>
+class G722DecoderCore {
+ public:
+  G722DecoderCore();
+
+  void Reset();
+
+  // Decodes |bytes_per_lane| bytes of each lane into two 16 kHz samples per
+  // byte. Byte j of lane k is read from input[j * input_stride + k] and
+  // sample i of lane k is written to output[i * output_stride + k]. Returns
+  // the number of samples per lane.
+  size_t Decode(const uint8_t* input,
+                size_t input_stride,
+                size_t bytes_per_lane,
+                int16_t* output,
+                size_t output_stride);
+
+ private:
+  int32_t qmf_history_[g722_internal::kQmfHistory][kLanes];
+  g722_internal::BandState<kLanes> low_band_;
+  g722_internal::BandState<kLanes> high_band_;
+};
+
+// Encodes interleaved audio with any number of channels by splitting the
+// channels into lockstep groups of 8, 4, 2 and 1.
+class G722MultiChannelEncoder {
+ public:
+  explicit G722MultiChannelEncoder(size_t num_channels);
+  ~G722MultiChannelEncoder();
+
+  void Reset();
+
+  // Encodes |samples_per_channel| interleaved samples per channel. The
+  // encoded bytes are interleaved the same way, i.e. byte j of channel c is
+  // written to output[j * num_channels + c]. Returns the number of bytes per
+  // channel.
+  size_t Encode(const int16_t* input,
+                size_t samples_per_channel,
+                uint8_t* output);
+
+ private:
+  const size_t num_channels_;
+  std::vector<G722EncoderCore<8>> groups_of_8_;
+  std::unique_ptr<G722EncoderCore<4>> group_of_4_;
+  std::unique_ptr<G722EncoderCore<2>> group_of_2_;
+  std::unique_ptr<G722EncoderCore<1>> group_of_1_;
+};
+
+// The decoding counterpart of G722MultiChannelEncoder.
+class G722MultiChannelDecoder {
+ public:
+  explicit G722MultiChannelDecoder(size_t num_channels);
+  ~G722MultiChannelDecoder();
+
+  void Reset();
+
+  // Decodes |bytes_per_channel| interleaved bytes per channel into
+  // interleaved samples. Returns the number of samples per channel.
+  size_t Decode(const uint8_t* input,
+                size_t bytes_per_channel,
+                int16_t* output);
+
+ private:
+  const size_t num_channels_;
+  std::vector<G722DecoderCore<8>> groups_of_8_;
+  std::unique_ptr<G722DecoderCore<4>> group_of_4_;
+  std::unique_ptr<G722DecoderCore<2>> group_of_2_;
+  std::unique_ptr<G722DecoderCore<1>> group_of_1_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_CODECS_G722_G722_CORE_H_
@@ -0,0 +1,408 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/g722/g722_core.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+// Straightforward single-stream G.722 codec at 64 kbit/s, written sample by
+// sample as in the specification, used as reference for the lockstep core.
+class ReferenceG722 {
+ public:
+  ReferenceG722() {
+    band_[0].det = 32;
+    band_[1].det = 8;
+  }
+
+  uint8_t EncodePair(int16_t sample0, int16_t sample1) {
+    static constexpr int kQ6[32] = {
+        0,    35,   72,   110,  150,  190,  233,  276,  323,  370,  422,
+        473,  530,  587,  650,  714,  786,  858,  940,  1023, 1121, 1219,
+        1339, 1458, 1612, 1765, 1980, 2195, 2557, 2919, 0,    0};
+    static constexpr int kIln[32] = {0,  63, 62, 31, 30, 29, 28, 27,
+                                     26, 25, 24, 23, 22, 21, 20, 19,
+                                     18, 17, 16, 15, 14, 13, 12, 11,
+                                     10, 9,  8,  7,  6,  5,  4,  0};
+    static constexpr int kIlp[32] = {0,  61, 60, 59, 58, 57, 56, 55,
+                                     54, 53, 52, 51, 50, 49, 48, 47,
+                                     46, 45, 44, 43, 42, 41, 40, 39,
+                                     38, 37, 36, 35, 34, 33, 32, 0};
+    static constexpr int kIhn[3] = {0, 1, 0};
+    static constexpr int kIhp[3] = {0, 3, 2};
+
+    for (int i = 0; i < 22; ++i)
+      x_[i] = x_[i + 2];
+    x_[22] = sample0;
+    x_[23] = sample1;
+    int sum_even = 0;
+    int sum_odd = 0;
+    for (int i = 0; i < 12; ++i) {
+      sum_odd += x_[2 * i] * kQmf[i];
+      sum_even += x_[2 * i + 1] * kQmf[11 - i];
+    }
+    const int16_t x_low = static_cast<int16_t>((sum_even + sum_odd) >> 14);
+    const int16_t x_high = static_cast<int16_t>((sum_even - sum_odd) >> 14);
+
+    const int el = Saturate(x_low - band_[0].s);
+    int wd = el >= 0 ? el : -(el + 1);
+    int i;
+    for (i = 1; i < 30; ++i) {
+      if (wd < ((kQ6[i] * band_[0].det) >> 12))
+        break;
+    }
+    const int ilow = el < 0 ? kIln[i] : kIlp[i];
+    const int ril = ilow >> 2;
+    const int dlow = (band_[0].det * kQm4[ril]) >> 15;
+    UpdateScaleFactor(&band_[0], kWl[kRl42[ril]], 18432, 8);
+    UpdatePredictor(&band_[0], dlow);
+
+    const int eh = Saturate(x_high - band_[1].s);
+    wd = eh >= 0 ? eh : -(eh + 1);
+    const int mih = wd >= ((564 * band_[1].det) >> 12) ? 2 : 1;
+    const int ihigh = eh < 0 ? kIhn[mih] : kIhp[mih];
+    const int dhigh = (band_[1].det * kQm2[ihigh]) >> 15;
+    UpdateScaleFactor(&band_[1], kWh[kRh2[ihigh]], 22528, 10);
+    UpdatePredictor(&band_[1], dhigh);
+    return static_cast<uint8_t>((ihigh << 6) | ilow);
+  }
+
+  void DecodeByte(uint8_t code, int16_t* output) {
+    static constexpr int kQm6[64] = {
+        -136,   -136,   -136,   -136,   -24808, -21904, -19008, -16704,
+        -14984, -13512, -12280, -11192, -10232, -9360,  -8576,  -7856,
+        -7192,  -6576,  -6000,  -5456,  -4944,  -4464,  -4008,  -3576,
+        -3168,  -2776,  -2400,  -2032,  -1688,  -1360,  -1040,  -728,
+        24808,  21904,  19008,  16704,  14984,  13512,  12280,  11192,
+        10232,  9360,   8576,   7856,   7192,   6576,   6000,   5456,
+        4944,   4464,   4008,   3576,   3168,   2776,   2400,   2032,
+        1688,   1360,   1040,   728,    432,    136,    -432,   -136};
+    const int ilow = code & 0x3F;
+    const int ihigh = (code >> 6) & 0x03;
+    const int rlow = std::min(
+        std::max(band_[0].s + ((band_[0].det * kQm6[ilow]) >> 15), -16384),
+        16383);
+    const int ril = ilow >> 2;
+    const int dlow = (band_[0].det * kQm4[ril]) >> 15;
+    UpdateScaleFactor(&band_[0], kWl[kRl42[ril]], 18432, 8);
+    UpdatePredictor(&band_[0], dlow);
+
+    const int dhigh = (band_[1].det * kQm2[ihigh]) >> 15;
+    const int rhigh =
+        std::min(std::max(dhigh + band_[1].s, -16384), 16383);
+    UpdateScaleFactor(&band_[1], kWh[kRh2[ihigh]], 22528, 10);
+    UpdatePredictor(&band_[1], dhigh);
+
+    for (int i = 0; i < 22; ++i)
+      x_[i] = x_[i + 2];
+    x_[22] = rlow + rhigh;
+    x_[23] = rlow - rhigh;
+    int xout1 = 0;
+    int xout2 = 0;
+    for (int i = 0; i < 12; ++i) {
+      xout2 += x_[2 * i] * kQmf[i];
+      xout1 += x_[2 * i + 1] * kQmf[11 - i];
+    }
+    output[0] = static_cast<int16_t>(Saturate(xout1 >> 11));
+    output[1] = static_cast<int16_t>(Saturate(xout2 >> 11));
+  }
+
+ private:
+  struct Band {
+    int s = 0;
+    int sp = 0;
+    int sz = 0;
+    int r[3] = {0};
+    int a[3] = {0};
+    int ap[3] = {0};
+    int p[3] = {0};
+    int d[7] = {0};
+    int b[7] = {0};
+    int bp[7] = {0};
+    int sg[7] = {0};
+    int nb = 0;
+    int det = 0;
+  };
+
+  static constexpr int kQmf[12] = {3,    -11,  12,  32,   -210, 951,
+                                   3876, -805, 362, -156, 53,   -11};
+  static constexpr int kQm4[16] = {0,     -20456, -12896, -8968,
+                                   -6288, -4240,  -2584,  -1200,
+                                   20456, 12896,  8968,   6288,
+                                   4240,  2584,   1200,   0};
+  static constexpr int kQm2[4] = {-7408, -1616, 7408, 1616};
+  static constexpr int kWl[8] = {-60, -30, 58, 172, 334, 538, 1198, 3042};
+  static constexpr int kRl42[16] = {0, 7, 6, 5, 4, 3, 2, 1,
+                                    7, 6, 5, 4, 3, 2, 1, 0};
+  static constexpr int kWh[3] = {0, -214, 798};
+  static constexpr int kRh2[4] = {2, 1, 2, 1};
+  static constexpr int kIlb[32] = {
+      2048, 2093, 2139, 2186, 2233, 2282, 2332, 2383, 2435, 2489, 2543,
+      2599, 2656, 2714, 2774, 2834, 2896, 2960, 3025, 3091, 3158, 3228,
+      3298, 3371, 3444, 3520, 3597, 3676, 3756, 3838, 3922, 4008};
+
+  static int Saturate(int amp) {
+    return std::min(std::max(amp, -32768), 32767);
+  }
+
+  static void UpdateScaleFactor(Band* band, int w, int max_nb, int shift) {
+    band->nb = ((band->nb * 127) >> 7) + w;
+    band->nb = std::min(std::max(band->nb, 0), max_nb);
+    const int wd1 = (band->nb >> 6) & 31;
+    const int wd2 = shift - (band->nb >> 11);
+    const int wd3 = wd2 < 0 ? (kIlb[wd1] << -wd2) : (kIlb[wd1] >> wd2);
+    band->det = wd3 << 2;
+  }
+
+  static void UpdatePredictor(Band* band, int d) {
+    band->d[0] = d;
+    band->r[0] = Saturate(band->s + d);
+    band->p[0] = Saturate(band->sz + d);
+
+    for (int i = 0; i < 3; ++i)
+      band->sg[i] = band->p[i] >> 15;
+    int wd1 = Saturate(band->a[1] * 4);
+    int wd2 = band->sg[0] == band->sg[1] ? -wd1 : wd1;
+    if (wd2 > 32767)
+      wd2 = 32767;
+    int wd3 = (wd2 >> 7) + (band->sg[0] == band->sg[2] ? 128 : -128);
+    wd3 += (band->a[2] * 32512) >> 15;
+    band->ap[2] = std::min(std::max(wd3, -12288), 12288);
+
+    wd1 = band->sg[0] == band->sg[1] ? 192 : -192;
+    wd2 = (band->a[1] * 32640) >> 15;
+    band->ap[1] = Saturate(wd1 + wd2);
+    wd3 = Saturate(15360 - band->ap[2]);
+    if (band->ap[1] > wd3)
+      band->ap[1] = wd3;
+    else if (band->ap[1] < -wd3)
+      band->ap[1] = -wd3;
+
+    wd1 = d == 0 ? 0 : 128;
+    band->sg[0] = d >> 15;
+    for (int i = 1; i < 7; ++i) {
+      band->sg[i] = band->d[i] >> 15;
+      wd2 = band->sg[i] == band->sg[0] ? wd1 : -wd1;
+      wd3 = (band->b[i] * 32640) >> 15;
+      band->bp[i] = Saturate(wd2 + wd3);
+    }
+
+    for (int i = 6; i > 0; --i) {
+      band->d[i] = band->d[i - 1];
+      band->b[i] = band->bp[i];
+    }
+    for (int i = 2; i > 0; --i) {
+      band->r[i] = band->r[i - 1];
+      band->p[i] = band->p[i - 1];
+      band->a[i] = band->ap[i];
+    }
+
+    wd1 = (band->a[1] * Saturate(band->r[1] + band->r[1])) >> 15;
+    wd2 = (band->a[2] * Saturate(band->r[2] + band->r[2])) >> 15;
+    band->sp = Saturate(wd1 + wd2);
+
+    band->sz = 0;
+    for (int i = 6; i > 0; --i)
+      band->sz += (band->b[i] * Saturate(band->d[i] + band->d[i])) >> 15;
+    band->sz = Saturate(band->sz);
+
+    band->s = Saturate(band->sp + band->sz);
+  }
+
+  int x_[24] = {0};
+  Band band_[2];
+};
+
+constexpr int ReferenceG722::kQmf[12];
+constexpr int ReferenceG722::kQm4[16];
+constexpr int ReferenceG722::kQm2[4];
+constexpr int ReferenceG722::kWl[8];
+constexpr int ReferenceG722::kRl42[16];
+constexpr int ReferenceG722::kWh[3];
+constexpr int ReferenceG722::kRh2[4];
+constexpr int ReferenceG722::kIlb[32];
+
+// Creates an interleaved test signal with a different character per channel:
+// tones, noise and full-scale square waves that drive the predictors into
+// saturation.
+std::vector<int16_t> CreateSignal(size_t num_channels,
+                                  size_t samples_per_channel) {
+  Random random(4711);
+  std::vector<int16_t> signal(num_channels * samples_per_channel);
+  for (size_t c = 0; c < num_channels; ++c) {
+    for (size_t i = 0; i < samples_per_channel; ++i) {
+      int16_t sample;
+      switch (c % 4) {
+        case 0:
+          sample = static_cast<int16_t>(
+              12000 * sin(2 * M_PI * (300 + 500 * c) * i / 16000));
+          break;
+        case 1:
+          sample = static_cast<int16_t>(random.Rand(-32768, 32767));
+          break;
+        case 2:
+          sample = (i / (10 + c)) % 2 ? 32767 : -32768;
+          break;
+        default:
+          sample = static_cast<int16_t>(random.Rand(-300, 300));
+          break;
+      }
+      signal[i * num_channels + c] = sample;
+    }
+  }
+  return signal;
+}
+
+std::vector<uint8_t> ReferenceEncode(const std::vector<int16_t>& signal,
+                                     size_t num_channels) {
+  std::vector<ReferenceG722> encoders(num_channels);
+  std::vector<uint8_t> encoded(signal.size() / 2);
+  for (size_t j = 0; j < encoded.size() / num_channels; ++j) {
+    for (size_t c = 0; c < num_channels; ++c) {
+      encoded[j * num_channels + c] =
+          encoders[c].EncodePair(signal[2 * j * num_channels + c],
+                                 signal[(2 * j + 1) * num_channels + c]);
+    }
+  }
+  return encoded;
+}
+
+std::vector<int16_t> ReferenceDecode(const std::vector<uint8_t>& encoded,
+                                     size_t num_channels) {
+  std::vector<ReferenceG722> decoders(num_channels);
+  std::vector<int16_t> decoded(2 * encoded.size());
+  for (size_t j = 0; j < encoded.size() / num_channels; ++j) {
+    for (size_t c = 0; c < num_channels; ++c) {
+      int16_t pair[2];
+      decoders[c].DecodeByte(encoded[j * num_channels + c], pair);
+      decoded[2 * j * num_channels + c] = pair[0];
+      decoded[(2 * j + 1) * num_channels + c] = pair[1];
+    }
+  }
+  return decoded;
+}
+
+template <size_t kLanes>
+void TestLanesMatchReference() {
+  // Not a multiple of the internal block size.
+  constexpr size_t kSamplesPerLane = 2 * 1000 + 38;
+  const std::vector<int16_t> signal = CreateSignal(kLanes, kSamplesPerLane);
+  const std::vector<uint8_t> expected_encoded =
+      ReferenceEncode(signal, kLanes);
+
+  G722EncoderCore<kLanes> encoder;
+  std::vector<uint8_t> encoded(kLanes * kSamplesPerLane / 2);
+  EXPECT_EQ(kSamplesPerLane / 2,
+            encoder.Encode(signal.data(), kLanes, kSamplesPerLane,
+                           encoded.data(), kLanes));
+  EXPECT_EQ(expected_encoded, encoded);
+
+  // Decode both valid streams and arbitrary bytes, including the code words
+  // that the encoder never produces.
+  std::vector<uint8_t> garbage(encoded.size());
+  Random random(17);
+  for (uint8_t& byte : garbage)
+    byte = static_cast<uint8_t>(random.Rand(255));
+  for (const std::vector<uint8_t>& stream : {encoded, garbage}) {
+    G722DecoderCore<kLanes> decoder;
+    std::vector<int16_t> decoded(2 * stream.size());
+    EXPECT_EQ(kSamplesPerLane,
+              decoder.Decode(stream.data(), kLanes, stream.size() / kLanes,
+                             decoded.data(), kLanes));
+    EXPECT_EQ(ReferenceDecode(stream, kLanes), decoded);
+  }
+}
+
+}  // namespace
+
+TEST(G722CoreTest, OneLaneMatchesReference) {
+  TestLanesMatchReference<1>();
+}
+
+TEST(G722CoreTest, TwoLanesMatchReference) {
+  TestLanesMatchReference<2>();
+}
+
+TEST(G722CoreTest, FourLanesMatchReference) {
+  TestLanesMatchReference<4>();
+}
+
+TEST(G722CoreTest, EightLanesMatchReference) {
+  TestLanesMatchReference<8>();
+}
+
+TEST(G722CoreTest, MultiChannelMatchesReference) {
+  constexpr size_t kSamplesPerChannel = 960;
+  for (size_t num_channels : {1, 3, 6, 13}) {
+    const std::vector<int16_t> signal =
+        CreateSignal(num_channels, kSamplesPerChannel);
+    G722MultiChannelEncoder encoder(num_channels);
+    G722MultiChannelDecoder decoder(num_channels);
+    // Encode and decode in 10 ms chunks.
+    std::vector<uint8_t> encoded(signal.size() / 2);
+    std::vector<int16_t> decoded(signal.size());
+    for (size_t i = 0; i < kSamplesPerChannel; i += 160) {
+      EXPECT_EQ(80u, encoder.Encode(&signal[i * num_channels], 160,
+                                    &encoded[i / 2 * num_channels]));
+      EXPECT_EQ(160u, decoder.Decode(&encoded[i / 2 * num_channels], 80,
+                                     &decoded[i * num_channels]));
+    }
+    EXPECT_EQ(ReferenceEncode(signal, num_channels), encoded) << num_channels;
+    EXPECT_EQ(ReferenceDecode(encoded, num_channels), decoded)
+        << num_channels;
+  }
+}
+
+TEST(G722CoreTest, Reset) {
+  const std::vector<int16_t> signal = CreateSignal(2, 320);
+  G722EncoderCore<2> encoder;
+  std::vector<uint8_t> first(signal.size() / 2);
+  std::vector<uint8_t> second(signal.size() / 2);
+  encoder.Encode(signal.data(), 2, 320, first.data(), 2);
+  encoder.Reset();
+  encoder.Encode(signal.data(), 2, 320, second.data(), 2);
+  EXPECT_EQ(first, second);
+}
+
+// A tone survives the round trip with the 22 sample codec delay.
+TEST(G722CoreTest, RoundTripQuality) {
+  constexpr size_t kSamples = 1600;
+  constexpr size_t kDelay = 22;
+  std::vector<int16_t> signal(kSamples);
+  for (size_t i = 0; i < kSamples; ++i)
+    signal[i] = static_cast<int16_t>(10000 * sin(2 * M_PI * 1000 * i / 16000));
+  G722EncoderCore<1> encoder;
+  G722DecoderCore<1> decoder;
+  std::vector<uint8_t> encoded(kSamples / 2);
+  std::vector<int16_t> decoded(kSamples);
+  encoder.Encode(signal.data(), 1, kSamples, encoded.data(), 1);
+  decoder.Decode(encoded.data(), 1, encoded.size(), decoded.data(), 1);
+
+  double signal_energy = 0.0;
+  double error_energy = 0.0;
+  // Skip the initial adaptation.
+  for (size_t i = 400; i < kSamples; ++i) {
+    const double error = decoded[i] - signal[i - kDelay];
+    signal_energy += signal[i - kDelay] * signal[i - kDelay];
+    error_energy += error * error;
+  }
+  EXPECT_GT(10 * log10(signal_energy / error_energy), 30.0);
+}
+
+}  // namespace webrtc
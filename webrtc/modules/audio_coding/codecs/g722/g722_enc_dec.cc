@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/g722/g722_enc_dec.h"
+
+#include "modules/audio_coding/codecs/g722/g722_core.h"
+
+struct WebRtcG722EncoderState {
+  webrtc::G722EncoderCore<1> core;
+};
+
+struct WebRtcG722DecoderState {
+  webrtc::G722DecoderCore<1> core;
+};
+
+namespace {
+
+bool IsSupported(int rate, int options) {
+  return rate == 64000 && !(options & G722_SAMPLE_RATE_8000);
+}
+
+}  // namespace
+
+G722EncoderState* WebRtc_g722_encode_init(G722EncoderState* s,
+                                          int rate,
+                                          int options) {
+  if (!IsSupported(rate, options))
+    return nullptr;
+  if (s) {
+    s->core.Reset();
+    return s;
+  }
+  return new G722EncoderState();
+}
+
+int WebRtc_g722_encode_release(G722EncoderState* s) {
+  delete s;
+  return 0;
+}
+
+size_t WebRtc_g722_encode(G722EncoderState* s,
+                          uint8_t g722_data[],
+                          const int16_t amp[],
+                          size_t len) {
+  return s->core.Encode(amp, 1, len, g722_data, 1);
+}
+
+G722DecoderState* WebRtc_g722_decode_init(G722DecoderState* s,
+                                          int rate,
+                                          int options) {
+  if (!IsSupported(rate, options))
+    return nullptr;
+  if (s) {
+    s->core.Reset();
+    return s;
+  }
+  return new G722DecoderState();
+}
+
+int WebRtc_g722_decode_release(G722DecoderState* s) {
+  delete s;
+  return 0;
+}
+
+size_t WebRtc_g722_decode(G722DecoderState* s,
+                          int16_t amp[],
+                          const uint8_t g722_data[],
+                          size_t len) {
+  return s->core.Decode(g722_data, 1, len, amp, 1);
+}
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_G722_G722_ENC_DEC_H_
+#define MODULES_AUDIO_CODING_CODECS_G722_G722_ENC_DEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Single-stream G.722 encoder and decoder states, implemented on top of the
+ * lockstep core in g722_core.h. Only 64 kbit/s with 16 kHz audio and one
+ * code word per byte is supported.
+ */
+
+enum {
+  G722_SAMPLE_RATE_8000 = 0x0001,
+  G722_PACKED = 0x0002
+};
+
+typedef struct WebRtcG722EncoderState G722EncoderState;
+typedef struct WebRtcG722DecoderState G722DecoderState;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Resets |s|, or allocates a new state if |s| is NULL. |options| may contain
+ * G722_PACKED, which has no effect at 64 kbit/s. Returns NULL if |rate| is
+ * not 64000 or |options| asks for 8 kHz audio.
+ */
+G722EncoderState* WebRtc_g722_encode_init(G722EncoderState* s,
+                                          int rate,
+                                          int options);
+int WebRtc_g722_encode_release(G722EncoderState* s);
+
+/*
+ * Encodes |len| samples, which must be even, into |len| / 2 bytes. Returns
+ * the number of bytes.
+ */
+size_t WebRtc_g722_encode(G722EncoderState* s,
+                          uint8_t g722_data[],
+                          const int16_t amp[],
+                          size_t len);
+
+G722DecoderState* WebRtc_g722_decode_init(G722DecoderState* s,
+                                          int rate,
+                                          int options);
+int WebRtc_g722_decode_release(G722DecoderState* s);
+
+/*
+ * Decodes |len| bytes into 2 * |len| samples. Returns the number of samples.
+ */
+size_t WebRtc_g722_decode(G722DecoderState* s,
+                          int16_t amp[],
+                          const uint8_t g722_data[],
+                          size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MODULES_AUDIO_CODING_CODECS_G722_G722_ENC_DEC_H_ */
@@ -8,15 +8,14 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-#include <stdlib.h>
 #include <string.h>
 
+#include "modules/audio_coding/codecs/g722/g722_enc_dec.h"
 #include "modules/audio_coding/codecs/g722/g722_interface.h"
-#include "modules/third_party/g722/g722_enc_dec.h"
 
 int16_t WebRtcG722_CreateEncoder(G722EncInst **G722enc_inst)
 {
-    *G722enc_inst=(G722EncInst*)malloc(sizeof(G722EncoderState));
+    *G722enc_inst=(G722EncInst*)WebRtc_g722_encode_init(NULL, 64000, 2);
     if (*G722enc_inst!=NULL) {
       return(0);
     } else {
@@ -56,7 +55,7 @@ size_t WebRtcG722_Encode(G722EncInst *G722enc_inst,
 
 int16_t WebRtcG722_CreateDecoder(G722DecInst **G722dec_inst)
 {
-    *G722dec_inst=(G722DecInst*)malloc(sizeof(G722DecoderState));
+    *G722dec_inst=(G722DecInst*)WebRtc_g722_decode_init(NULL, 64000, 2);
     if (*G722dec_inst!=NULL) {
       return(0);
     } else {
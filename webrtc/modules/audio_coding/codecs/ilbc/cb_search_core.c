@@ -16,10 +16,12 @@
 
 ******************************************************************/
 
+#include "modules/audio_coding/codecs/ilbc/cb_search_core.h"
+
 #include "modules/audio_coding/codecs/ilbc/defines.h"
 #include "modules/audio_coding/codecs/ilbc/constants.h"
 
-void WebRtcIlbcfix_CbSearchCore(
+void WebRtcIlbcfix_CbSearchCoreC(
     int32_t *cDot,    /* (i) Cross Correlation */
     size_t range,    /* (i) Search range */
     int16_t stage,    /* (i) Stage of this search */
@@ -111,3 +113,30 @@ void WebRtcIlbcfix_CbSearchCore(
 
   return;
 }
+
+void WebRtcIlbcfix_CbSearchCore(
+    int32_t *cDot,    /* (i) Cross Correlation */
+    size_t range,    /* (i) Search range */
+    int16_t stage,    /* (i) Stage of this search */
+    int16_t *inverseEnergy,  /* (i) Inversed energy */
+    int16_t *inverseEnergyShift, /* (i) Shifts of inversed energy
+                                           with the offset 2*16-29 */
+    int32_t *Crit,    /* (o) The criteria */
+    size_t *bestIndex,   /* (o) Index that corresponds to
+                                                   maximum criteria (in this
+                                                   vector) */
+    int32_t *bestCrit,   /* (o) Value of critera for the
+                                                   chosen index */
+    int16_t *bestCritSh)   /* (o) The domain of the chosen
+                                                   criteria */
+{
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+  WebRtcIlbcfix_CbSearchCoreSse2(cDot, range, stage, inverseEnergy,
+                                 inverseEnergyShift, Crit, bestIndex,
+                                 bestCrit, bestCritSh);
+#else
+  WebRtcIlbcfix_CbSearchCoreC(cDot, range, stage, inverseEnergy,
+                              inverseEnergyShift, Crit, bestIndex, bestCrit,
+                              bestCritSh);
+#endif
+}
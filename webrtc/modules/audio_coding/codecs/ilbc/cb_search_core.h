@@ -20,7 +20,10 @@
 #define MODULES_AUDIO_CODING_CODECS_ILBC_MAIN_SOURCE_CB_SEARCH_CORE_H_
 
 #include "modules/audio_coding/codecs/ilbc/defines.h"
+#include "rtc_base/system/arch.h"
 
+/* Calls the SSE2 version on x86 platforms with SSE2 and the C version
+   otherwise. The two are bit exact. */
 void WebRtcIlbcfix_CbSearchCore(
     int32_t* cDot,               /* (i) Cross Correlation */
     size_t range,                /* (i) Search range */
@@ -37,4 +40,26 @@ void WebRtcIlbcfix_CbSearchCore(
     int16_t* bestCritSh); /* (o) The domain of the chosen
                                    criteria */
 
+/* Implementations of WebRtcIlbcfix_CbSearchCore() */
+void WebRtcIlbcfix_CbSearchCoreC(int32_t* cDot,
+                                 size_t range,
+                                 int16_t stage,
+                                 int16_t* inverseEnergy,
+                                 int16_t* inverseEnergyShift,
+                                 int32_t* Crit,
+                                 size_t* bestIndex,
+                                 int32_t* bestCrit,
+                                 int16_t* bestCritSh);
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+void WebRtcIlbcfix_CbSearchCoreSse2(int32_t* cDot,
+                                    size_t range,
+                                    int16_t stage,
+                                    int16_t* inverseEnergy,
+                                    int16_t* inverseEnergyShift,
+                                    int32_t* Crit,
+                                    size_t* bestIndex,
+                                    int32_t* bestCrit,
+                                    int16_t* bestCritSh);
+#endif
+
 #endif
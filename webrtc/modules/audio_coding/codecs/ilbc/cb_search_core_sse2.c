@@ -0,0 +1,186 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/******************************************************************
+
+ iLBC Speech Coder ANSI-C Source Code
+
+ WebRtcIlbcfix_CbSearchCoreSse2.c
+
+ SSE2 version of WebRtcIlbcfix_CbSearchCore(). Eight criteria are
+ computed per iteration; the result is bit exact with
+ WebRtcIlbcfix_CbSearchCoreC().
+
+******************************************************************/
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/ilbc/cb_search_core.h"
+#include "rtc_base/checks.h"
+
+/* Arithmetic right shift of each lane of |x| by the corresponding lane of
+   |shifts|, which must be in [0, 31] */
+static __inline __m128i ShiftRightVariable(__m128i x, __m128i shifts) {
+  int k;
+  for (k = 1; k <= 16; k <<= 1) {
+    const __m128i bit = _mm_set1_epi32(k);
+    const __m128i mask = _mm_cmpeq_epi32(_mm_and_si128(shifts, bit), bit);
+    const __m128i shifted = _mm_sra_epi32(x, _mm_cvtsi32_si128(k));
+    x = _mm_or_si128(_mm_and_si128(mask, shifted), _mm_andnot_si128(mask, x));
+  }
+  return x;
+}
+
+/* Lane wise maximum of two vectors of int32_t */
+static __inline __m128i MaxW32(__m128i a, __m128i b) {
+  const __m128i mask = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+void WebRtcIlbcfix_CbSearchCoreSse2(
+    int32_t *cDot,    /* (i) Cross Correlation */
+    size_t range,    /* (i) Search range */
+    int16_t stage,    /* (i) Stage of this search */
+    int16_t *inverseEnergy,  /* (i) Inversed energy */
+    int16_t *inverseEnergyShift, /* (i) Shifts of inversed energy
+                                           with the offset 2*16-29 */
+    int32_t *Crit,    /* (o) The criteria */
+    size_t *bestIndex,   /* (o) Index that corresponds to
+                                                   maximum criteria (in this
+                                                   vector) */
+    int32_t *bestCrit,   /* (o) Value of critera for the
+                                                   chosen index */
+    int16_t *bestCritSh)   /* (o) The domain of the chosen
+                                                   criteria */
+{
+  int32_t maxW32, tmp32, critMax;
+  int16_t max, sh, tmp16, cDotSqW16;
+  int16_t lanes16[8];
+  int32_t lanes32[4];
+  size_t i;
+  __m128i shift, maxShift, maxCrit;
+
+  RTC_DCHECK_GT(range, 0);
+
+  /* Don't allow negative values for stage 0 */
+  if (stage==0) {
+    const __m128i zero = _mm_setzero_si128();
+    for (i = 0; i + 4 <= range; i += 4) {
+      const __m128i c = _mm_loadu_si128((const __m128i*)&cDot[i]);
+      _mm_storeu_si128((__m128i*)&cDot[i],
+                       _mm_and_si128(c, _mm_cmpgt_epi32(c, zero)));
+    }
+    for (; i < range; i++) {
+      cDot[i] = WEBRTC_SPL_MAX(0, cDot[i]);
+    }
+  }
+
+  /* Normalize cDot to int16_t, calculate the square of cDot and store the upper int16_t */
+  maxW32 = WebRtcSpl_MaxAbsValueW32(cDot, range);
+
+  sh = (int16_t)WebRtcSpl_NormW32(maxW32);
+  shift = _mm_cvtsi32_si128(sh);
+
+  /* The shift of the lanes with a non-zero criteria, WEBRTC_SPL_WORD16_MIN
+     elsewhere */
+  maxShift = _mm_set1_epi16(WEBRTC_SPL_WORD16_MIN);
+  for (i = 0; i + 8 <= range; i += 8) {
+    /* After the normalization each value fits in an int16_t, so the packing
+       does not saturate */
+    const __m128i c0 = _mm_srai_epi32(
+        _mm_sll_epi32(_mm_loadu_si128((const __m128i*)&cDot[i]), shift), 16);
+    const __m128i c1 = _mm_srai_epi32(
+        _mm_sll_epi32(_mm_loadu_si128((const __m128i*)&cDot[i + 4]), shift),
+        16);
+    const __m128i c = _mm_packs_epi32(c0, c1);
+    const __m128i cSq = _mm_mulhi_epi16(c, c);
+    const __m128i invEnergy =
+        _mm_loadu_si128((const __m128i*)&inverseEnergy[i]);
+    const __m128i low = _mm_mullo_epi16(cSq, invEnergy);
+    const __m128i high = _mm_mulhi_epi16(cSq, invEnergy);
+    const __m128i zeroCrit =
+        _mm_or_si128(_mm_cmpeq_epi16(cSq, _mm_setzero_si128()),
+                     _mm_cmpeq_epi16(invEnergy, _mm_setzero_si128()));
+    const __m128i shifts =
+        _mm_loadu_si128((const __m128i*)&inverseEnergyShift[i]);
+
+    /* Calculate the criteria (cDot*cDot/energy) */
+    _mm_storeu_si128((__m128i*)&Crit[i], _mm_unpacklo_epi16(low, high));
+    _mm_storeu_si128((__m128i*)&Crit[i + 4], _mm_unpackhi_epi16(low, high));
+
+    /* Extract the maximum shift value under the constraint
+       that the criteria is not zero */
+    maxShift = _mm_max_epi16(
+        maxShift,
+        _mm_or_si128(_mm_and_si128(zeroCrit, _mm_set1_epi16(
+                                                 WEBRTC_SPL_WORD16_MIN)),
+                     _mm_andnot_si128(zeroCrit, shifts)));
+  }
+  _mm_storeu_si128((__m128i*)lanes16, maxShift);
+  max = lanes16[0];
+  for (tmp16 = 1; tmp16 < 8; tmp16++) {
+    max = WEBRTC_SPL_MAX(lanes16[tmp16], max);
+  }
+  for (; i < range; i++) {
+    tmp32 = cDot[i] << sh;
+    tmp16 = (int16_t)(tmp32 >> 16);
+    cDotSqW16 = (int16_t)(((int32_t)(tmp16)*(tmp16))>>16);
+    Crit[i] = cDotSqW16 * inverseEnergy[i];
+    if (Crit[i] != 0) {
+      max = WEBRTC_SPL_MAX(inverseEnergyShift[i], max);
+    }
+  }
+
+  /* If no max shifts still at initialization value, set shift to zero */
+  if (max==WEBRTC_SPL_WORD16_MIN) {
+    max = 0;
+  }
+
+  /* Modify the criterias, so that all of them use the same Q domain. A
+     criteria with a shift above |max| is zero, so the shift is clamped to
+     [0, 16] */
+  maxShift = _mm_set1_epi16(max);
+  maxCrit = _mm_set1_epi32(WEBRTC_SPL_WORD32_MIN);
+  for (i = 0; i + 8 <= range; i += 8) {
+    const __m128i shifts = _mm_min_epi16(
+        _mm_max_epi16(
+            _mm_subs_epi16(maxShift, _mm_loadu_si128(
+                (const __m128i*)&inverseEnergyShift[i])),
+            _mm_setzero_si128()),
+        _mm_set1_epi16(16));
+    const __m128i crit0 = ShiftRightVariable(
+        _mm_loadu_si128((const __m128i*)&Crit[i]),
+        _mm_unpacklo_epi16(shifts, _mm_setzero_si128()));
+    const __m128i crit1 = ShiftRightVariable(
+        _mm_loadu_si128((const __m128i*)&Crit[i + 4]),
+        _mm_unpackhi_epi16(shifts, _mm_setzero_si128()));
+    _mm_storeu_si128((__m128i*)&Crit[i], crit0);
+    _mm_storeu_si128((__m128i*)&Crit[i + 4], crit1);
+    maxCrit = MaxW32(maxCrit, MaxW32(crit0, crit1));
+  }
+  _mm_storeu_si128((__m128i*)lanes32, maxCrit);
+  critMax = WEBRTC_SPL_MAX(WEBRTC_SPL_MAX(lanes32[0], lanes32[1]),
+                           WEBRTC_SPL_MAX(lanes32[2], lanes32[3]));
+  for (; i < range; i++) {
+    tmp16 = WEBRTC_SPL_MIN(16, max-inverseEnergyShift[i]);
+    Crit[i] = WEBRTC_SPL_SHIFT_W32(Crit[i], -tmp16);
+    critMax = WEBRTC_SPL_MAX(Crit[i], critMax);
+  }
+
+  /* Find the index of the best value, the first one as in
+     WebRtcSpl_MaxIndexW32() */
+  for (i = 0; Crit[i] != critMax; i++) {
+  }
+  *bestIndex = i;
+  *bestCrit = critMax;
+
+  /* Calculate total shifts of this criteria */
+  *bestCritSh = 32 - 2*sh + max;
+}
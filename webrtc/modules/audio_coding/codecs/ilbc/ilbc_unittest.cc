@@ -11,8 +11,14 @@
 #include "modules/audio_coding/codecs/ilbc/audio_decoder_ilbc.h"
 #include "modules/audio_coding/codecs/ilbc/audio_encoder_ilbc.h"
 #include "modules/audio_coding/codecs/legacy_encoded_audio_frame.h"
+#include "rtc_base/random.h"
 #include "test/gtest.h"
 
+extern "C" {
+#include "modules/audio_coding/codecs/ilbc/cb_search_core.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+}
+
 namespace webrtc {
 
 TEST(IlbcTest, BadPacket) {
@@ -137,4 +143,87 @@ TEST(IlbcTest, SplitUnevenPayload) {
   EXPECT_TRUE(results.empty());
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+// The codebook search of the encoder uses the SSE2 kernels when available; the
+// encoded bit stream is only unchanged if they are bit exact with C.
+TEST(IlbcTest, CrossCorrelationSse2BitExact) {
+  Random random(4711);
+  int16_t target[STATE_SHORT_LEN_30MS];
+  int16_t cb_memory[CB_MEML];
+  int32_t expected[CB_MEML];
+  int32_t actual[CB_MEML];
+  for (int16_t& sample : cb_memory) {
+    sample = random.Rand<int16_t>();
+  }
+  cb_memory[0] = WEBRTC_SPL_WORD16_MIN;
+  cb_memory[1] = WEBRTC_SPL_WORD16_MIN;
+  for (size_t length : {size_t{SUBL}, size_t{STATE_SHORT_LEN_30MS}, size_t{23}}) {
+    for (int scale = 0; scale <= 8; ++scale) {
+      for (int16_t& sample : target) {
+        sample = random.Rand<int16_t>();
+      }
+      // The largest product, which overflows a pair sum of _mm_madd_epi16().
+      target[0] = WEBRTC_SPL_WORD16_MIN;
+      target[1] = WEBRTC_SPL_WORD16_MIN;
+      const size_t range = CB_MEML - length;
+      WebRtcSpl_CrossCorrelationC(expected, target, &cb_memory[range - 1],
+                                  length, range, scale, -1);
+      WebRtcSpl_CrossCorrelationSse2(actual, target, &cb_memory[range - 1],
+                                     length, range, scale, -1);
+      for (size_t i = 0; i < range; ++i) {
+        ASSERT_EQ(expected[i], actual[i]) << "length " << length << " scale "
+                                          << scale << " lag " << i;
+      }
+    }
+  }
+}
+
+TEST(IlbcTest, CbSearchCoreSse2BitExact) {
+  Random random(42);
+  for (int trial = 0; trial < 200; ++trial) {
+    const size_t range = 1 + random.Rand(127);
+    const int16_t stage = static_cast<int16_t>(random.Rand(CB_NSTAGES - 1));
+    int32_t c_dot[128];
+    int16_t inverse_energy[128];
+    int16_t inverse_energy_shift[128];
+    for (size_t i = 0; i < range; ++i) {
+      // Leave out some magnitude bits, so that the normalization shift and
+      // the zero criteria vary between trials.
+      c_dot[i] = static_cast<int32_t>(random.Rand<uint32_t>()) >>
+                 random.Rand(31);
+      inverse_energy[i] = random.Rand(7) == 0
+                              ? 0
+                              : static_cast<int16_t>(random.Rand(0, 32767));
+      inverse_energy_shift[i] = static_cast<int16_t>(random.Rand(-8, 40));
+    }
+    int32_t c_dot_sse2[128];
+    std::copy(c_dot, c_dot + range, c_dot_sse2);
+
+    int32_t crit[128];
+    size_t best_index;
+    int32_t best_crit;
+    int16_t best_crit_sh;
+    WebRtcIlbcfix_CbSearchCoreC(c_dot, range, stage, inverse_energy,
+                                inverse_energy_shift, crit, &best_index,
+                                &best_crit, &best_crit_sh);
+    int32_t crit_sse2[128];
+    size_t best_index_sse2;
+    int32_t best_crit_sse2;
+    int16_t best_crit_sh_sse2;
+    WebRtcIlbcfix_CbSearchCoreSse2(c_dot_sse2, range, stage, inverse_energy,
+                                   inverse_energy_shift, crit_sse2,
+                                   &best_index_sse2, &best_crit_sse2,
+                                   &best_crit_sh_sse2);
+
+    for (size_t i = 0; i < range; ++i) {
+      ASSERT_EQ(c_dot[i], c_dot_sse2[i]);
+      ASSERT_EQ(crit[i], crit_sse2[i]) << "trial " << trial << " index " << i;
+    }
+    EXPECT_EQ(best_index, best_index_sse2);
+    EXPECT_EQ(best_crit, best_crit_sse2);
+    EXPECT_EQ(best_crit_sh, best_crit_sh_sse2);
+  }
+}
+#endif
+
 }  // namespace webrtc
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <time.h>
+
+#include "modules/audio_coding/codecs/ilbc/defines.h"
+#include "modules/audio_coding/codecs/ilbc/ilbc.h"
+#include "modules/audio_coding/codecs/tools/audio_codec_speed_test.h"
+
+using std::string;
+
+namespace webrtc {
+
+static const int kIlbcBlockDurationMs = 30;
+static const int kIlbcSamplingKhz = 8;
+
+class IlbcSpeedTest : public AudioCodecSpeedTest {
+ protected:
+  IlbcSpeedTest();
+  void SetUp() override;
+  void TearDown() override;
+  float EncodeABlock(int16_t* in_data,
+                     uint8_t* bit_stream,
+                     size_t max_bytes,
+                     size_t* encoded_bytes) override;
+  float DecodeABlock(const uint8_t* bit_stream,
+                     size_t encoded_bytes,
+                     int16_t* out_data) override;
+  // Prints the encoder throughput of EncodeDecode(|audio_duration_sec|) in
+  // frames per second of CPU time. The encoder runs on a single thread, so
+  // this is the throughput per core.
+  void PrintEncoderThroughput(size_t audio_duration_sec) const;
+  IlbcEncoderInstance* encoder_;
+  IlbcDecoderInstance* decoder_;
+};
+
+IlbcSpeedTest::IlbcSpeedTest()
+    : AudioCodecSpeedTest(kIlbcBlockDurationMs,
+                          kIlbcSamplingKhz,
+                          kIlbcSamplingKhz),
+      encoder_(NULL),
+      decoder_(NULL) {}
+
+void IlbcSpeedTest::SetUp() {
+  AudioCodecSpeedTest::SetUp();
+
+  // Check whether the allocated buffer for the bit stream is large enough.
+  EXPECT_GE(max_bytes_, static_cast<size_t>(NO_OF_BYTES_30MS));
+
+  EXPECT_EQ(0, WebRtcIlbcfix_EncoderCreate(&encoder_));
+  EXPECT_EQ(0, WebRtcIlbcfix_DecoderCreate(&decoder_));
+  EXPECT_EQ(0, WebRtcIlbcfix_EncoderInit(encoder_, block_duration_ms_));
+  EXPECT_EQ(0, WebRtcIlbcfix_DecoderInit(decoder_, block_duration_ms_));
+}
+
+void IlbcSpeedTest::TearDown() {
+  AudioCodecSpeedTest::TearDown();
+  EXPECT_EQ(0, WebRtcIlbcfix_EncoderFree(encoder_));
+  EXPECT_EQ(0, WebRtcIlbcfix_DecoderFree(decoder_));
+}
+
+float IlbcSpeedTest::EncodeABlock(int16_t* in_data,
+                                  uint8_t* bit_stream,
+                                  size_t max_bytes,
+                                  size_t* encoded_bytes) {
+  clock_t clocks = clock();
+  int value = WebRtcIlbcfix_Encode(encoder_, in_data, input_length_sample_,
+                                   bit_stream);
+  clocks = clock() - clocks;
+  EXPECT_EQ(NO_OF_BYTES_30MS, value);
+  *encoded_bytes = static_cast<size_t>(value);
+  assert(*encoded_bytes <= max_bytes);
+  return 1000.0 * clocks / CLOCKS_PER_SEC;
+}
+
+float IlbcSpeedTest::DecodeABlock(const uint8_t* bit_stream,
+                                  size_t encoded_bytes,
+                                  int16_t* out_data) {
+  int16_t audio_type;
+  clock_t clocks = clock();
+  int value = WebRtcIlbcfix_Decode(decoder_, bit_stream, encoded_bytes,
+                                   out_data, &audio_type);
+  clocks = clock() - clocks;
+  EXPECT_EQ(output_length_sample_, static_cast<size_t>(value));
+  return 1000.0 * clocks / CLOCKS_PER_SEC;
+}
+
+void IlbcSpeedTest::PrintEncoderThroughput(size_t audio_duration_sec) const {
+  const double frames = 1000.0 * audio_duration_sec / block_duration_ms_;
+  printf("Encoding: %.0f frames per second per core.\n",
+         frames * 1000.0 / encoding_time_ms_);
+}
+
+TEST_P(IlbcSpeedTest, IlbcEncodeDecodeTest) {
+  size_t kDurationSec = 400;  // Test audio length in second.
+  EncodeDecode(kDurationSec);
+  PrintEncoderThroughput(kDurationSec);
+}
+
+// The 16 kHz speech file is read as 8 kHz audio, which keeps the signal
+// speech like for the encoder's searches.
+const coding_param param_set[] = {
+    std::make_tuple(1,
+                    13333,
+                    string("audio_coding/speech_mono_16kHz"),
+                    string("pcm"),
+                    true)};
+
+INSTANTIATE_TEST_SUITE_P(AllTest,
+                         IlbcSpeedTest,
+                         ::testing::ValuesIn(param_set));
+
+}  // namespace webrtc
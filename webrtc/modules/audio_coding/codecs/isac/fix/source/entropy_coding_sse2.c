@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/* This file contains WebRtcIsacfix_MatrixProduct1Sse2() and
+ * WebRtcIsacfix_MatrixProduct2Sse2() for x86 platforms with SSE2. API's are
+ * in entropy_coding.c. Results are bit exact with the c code for
+ * generic platforms.
+ */
+
+#include <emmintrin.h>
+#include <stddef.h>
+
+#include "modules/audio_coding/codecs/isac/fix/source/entropy_coding.h"
+#include "modules/audio_coding/codecs/isac/fix/source/fixed_point_sse2.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// One output of WebRtcIsacfix_MatrixProduct1C().
+static int32_t InnerProduct(const int16_t matrix0[],
+                            const int32_t matrix1[],
+                            int matrix0_index,
+                            int matrix1_index,
+                            const int matrix0_index_step,
+                            const int matrix1_index_step,
+                            const int inner_loop_count,
+                            const int shift) {
+  int32_t sum32 = 0;
+  int n;
+  for (n = 0; n < inner_loop_count; n++) {
+    sum32 += WEBRTC_SPL_MUL_16_32_RSFT16(
+        matrix0[matrix0_index], matrix1[matrix1_index] * (1 << shift));
+    matrix0_index += matrix0_index_step;
+    matrix1_index += matrix1_index_step;
+  }
+  return sum32;
+}
+
+void WebRtcIsacfix_MatrixProduct1Sse2(const int16_t matrix0[],
+                                      const int32_t matrix1[],
+                                      int32_t matrix_product[],
+                                      const int matrix1_index_factor1,
+                                      const int matrix0_index_factor1,
+                                      const int matrix1_index_init_case,
+                                      const int matrix1_index_step,
+                                      const int matrix0_index_step,
+                                      const int inner_loop_count,
+                                      const int mid_loop_count,
+                                      const int shift) {
+  int j = 0, k = 0, n = 0;
+  int matrix1_index = 0, matrix0_index = 0, matrix_prod_index = 0;
+  const __m128i shift_v = _mm_cvtsi32_si128(shift);
+
+  if (matrix1_index_init_case != 0 && matrix1_index_factor1 == 1) {
+    // Four consecutive outputs use four consecutive elements of matrix1 and
+    // the same element of matrix0.
+    for (j = 0; j < SUBFRAMES; j++) {
+      matrix_prod_index = mid_loop_count * j;
+      for (k = 0; k + 4 <= mid_loop_count; k += 4) {
+        __m128i sum = _mm_setzero_si128();
+        matrix1_index = k;
+        matrix0_index = matrix0_index_factor1 * j;
+        for (n = 0; n < inner_loop_count; n++) {
+          const __m128i matrix0_v = Sse2SetCoefficient(matrix0[matrix0_index]);
+          const __m128i matrix1_v = _mm_sll_epi32(
+              _mm_loadu_si128((const __m128i*)&matrix1[matrix1_index]),
+              shift_v);
+          sum = _mm_add_epi32(sum, Sse2Mul16x32Rsft16(matrix0_v, matrix1_v));
+          matrix1_index += matrix1_index_step;
+          matrix0_index += matrix0_index_step;
+        }
+        _mm_storeu_si128((__m128i*)&matrix_product[matrix_prod_index], sum);
+        matrix_prod_index += 4;
+      }
+      for (; k < mid_loop_count; k++) {
+        matrix_product[matrix_prod_index++] = InnerProduct(
+            matrix0, matrix1, matrix0_index_factor1 * j, k,
+            matrix0_index_step, matrix1_index_step, inner_loop_count, shift);
+      }
+    }
+  } else if (matrix1_index_init_case == 0 && matrix0_index_factor1 == 1) {
+    // Four consecutive outputs use four consecutive elements of matrix0 and
+    // the same element of matrix1.
+    for (j = 0; j < SUBFRAMES; j++) {
+      matrix_prod_index = mid_loop_count * j;
+      for (k = 0; k + 4 <= mid_loop_count; k += 4) {
+        __m128i sum = _mm_setzero_si128();
+        matrix1_index = matrix1_index_factor1 * j;
+        matrix0_index = k;
+        for (n = 0; n < inner_loop_count; n++) {
+          const __m128i matrix0_v =
+              Sse2LoadCoefficients(&matrix0[matrix0_index]);
+          const __m128i matrix1_v =
+              _mm_set1_epi32(matrix1[matrix1_index] * (1 << shift));
+          sum = _mm_add_epi32(sum, Sse2Mul16x32Rsft16(matrix0_v, matrix1_v));
+          matrix1_index += matrix1_index_step;
+          matrix0_index += matrix0_index_step;
+        }
+        _mm_storeu_si128((__m128i*)&matrix_product[matrix_prod_index], sum);
+        matrix_prod_index += 4;
+      }
+      for (; k < mid_loop_count; k++) {
+        matrix_product[matrix_prod_index++] = InnerProduct(
+            matrix0, matrix1, k, matrix1_index_factor1 * j,
+            matrix0_index_step, matrix1_index_step, inner_loop_count, shift);
+      }
+    }
+  } else if (matrix1_index_init_case == 0 &&
+             matrix1_index_step == 1 &&
+             matrix0_index_step == 1) {
+    // Both matrices are read consecutively in the inner loop.
+    for (j = 0; j < SUBFRAMES; j++) {
+      matrix_prod_index = mid_loop_count * j;
+      for (k = 0; k < mid_loop_count; k++) {
+        int32_t lanes[4];
+        __m128i sum = _mm_setzero_si128();
+        matrix1_index = matrix1_index_factor1 * j;
+        matrix0_index = matrix0_index_factor1 * k;
+        for (n = 0; n + 4 <= inner_loop_count; n += 4) {
+          const __m128i matrix0_v =
+              Sse2LoadCoefficients(&matrix0[matrix0_index + n]);
+          const __m128i matrix1_v = _mm_sll_epi32(
+              _mm_loadu_si128((const __m128i*)&matrix1[matrix1_index + n]),
+              shift_v);
+          sum = _mm_add_epi32(sum, Sse2Mul16x32Rsft16(matrix0_v, matrix1_v));
+        }
+        _mm_storeu_si128((__m128i*)lanes, sum);
+        matrix_product[matrix_prod_index++] =
+            lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+            InnerProduct(matrix0, matrix1, matrix0_index + n,
+                         matrix1_index + n, 1, 1, inner_loop_count - n, shift);
+      }
+    }
+  } else {
+    WebRtcIsacfix_MatrixProduct1C(
+        matrix0, matrix1, matrix_product, matrix1_index_factor1,
+        matrix0_index_factor1, matrix1_index_init_case, matrix1_index_step,
+        matrix0_index_step, inner_loop_count, mid_loop_count, shift);
+  }
+}
+
+void WebRtcIsacfix_MatrixProduct2Sse2(const int16_t matrix0[],
+                                      const int32_t matrix1[],
+                                      int32_t matrix_product[],
+                                      const int matrix0_index_factor,
+                                      const int matrix0_index_step) {
+  int j = 0, n = 0;
+  int matrix1_index = 0, matrix0_index = 0, matrix_prod_index = 0;
+  // Two rows j and j + 1 of the two-column product at a time.
+  for (j = 0; j < SUBFRAMES; j += 2) {
+    __m128i sum = _mm_setzero_si128();
+    matrix1_index = 0;
+    matrix0_index = matrix0_index_factor * j;
+    for (n = SUBFRAMES; n > 0; n--) {
+      const __m128i matrix0_v = _mm_unpacklo_epi64(
+          Sse2SetCoefficient(matrix0[matrix0_index]),
+          Sse2SetCoefficient(matrix0[matrix0_index + matrix0_index_factor]));
+      const __m128i matrix1_v = _mm_loadl_epi64(
+          (const __m128i*)&matrix1[matrix1_index]);
+      sum = _mm_add_epi32(
+          sum, Sse2Mul16x32Rsft16(matrix0_v,
+                                  _mm_unpacklo_epi64(matrix1_v, matrix1_v)));
+      matrix1_index += 2;
+      matrix0_index += matrix0_index_step;
+    }
+    _mm_storeu_si128((__m128i*)&matrix_product[matrix_prod_index],
+                     _mm_srai_epi32(sum, 3));
+    matrix_prod_index += 4;
+  }
+}
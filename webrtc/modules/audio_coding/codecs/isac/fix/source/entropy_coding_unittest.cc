@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/isac/fix/source/entropy_coding.h"
+
+#include "modules/audio_coding/codecs/isac/fix/source/lpc_tables.h"
+#include "modules/audio_coding/codecs/isac/fix/source/settings.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+// The arguments of the WebRtcIsacfix_MatrixProduct1() calls in
+// entropy_coding.c.
+struct MatrixProduct1Args {
+  const int16_t* matrix0;
+  int matrix1_index_factor1;
+  int matrix0_index_factor1;
+  int matrix1_index_init_case;
+  int matrix1_index_step;
+  int matrix0_index_step;
+  int inner_loop_count;
+  int mid_loop_count;
+  int shift;
+};
+
+const MatrixProduct1Args kMatrixProduct1Calls[] = {
+    {WebRtcIsacfix_kT1GainQ15[0], 2, 2, 0, 1, 1, 2, 2, 5},
+    {WebRtcIsacfix_kT2ShapeQ15[0], 1, 1, 1, LPC_SHAPE_ORDER, SUBFRAMES,
+     SUBFRAMES, LPC_SHAPE_ORDER, 0},
+    {WebRtcIsacfix_kT1ShapeQ15[0], LPC_SHAPE_ORDER, 1, 0, 1, LPC_SHAPE_ORDER,
+     LPC_SHAPE_ORDER, LPC_SHAPE_ORDER, 1},
+    {WebRtcIsacfix_kT2ShapeQ15[0], 1, SUBFRAMES, 1, LPC_SHAPE_ORDER, 1,
+     SUBFRAMES, LPC_SHAPE_ORDER, 1},
+    {WebRtcIsacfix_kT1ShapeQ15[0], LPC_SHAPE_ORDER, LPC_SHAPE_ORDER, 0, 1, 1,
+     LPC_SHAPE_ORDER, LPC_SHAPE_ORDER, 1},
+    {WebRtcIsacfix_kT2ShapeQ15[0], 1, 1, 1, LPC_SHAPE_ORDER, SUBFRAMES,
+     SUBFRAMES, LPC_SHAPE_ORDER, 1},
+};
+
+}  // namespace
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// The SSE2 matrix products are bit exact with the C versions for all the
+// argument combinations used by the codec.
+TEST(EntropyCodingTest, MatrixProductSse2BitExact) {
+  if (WebRtc_GetCPUInfo(kSSE2) == 0) {
+    return;
+  }
+  constexpr int kSize = SUBFRAMES * LPC_SHAPE_ORDER;
+  Random random(17);
+  int32_t matrix1[kSize];
+  int32_t product_c[kSize];
+  int32_t product_sse2[kSize];
+  for (int trial = 0; trial < 20; trial++) {
+    for (int32_t& value : matrix1) {
+      value = random.Rand(-(1 << 20), 1 << 20);
+    }
+    for (const MatrixProduct1Args& args : kMatrixProduct1Calls) {
+      WebRtcIsacfix_MatrixProduct1C(
+          args.matrix0, matrix1, product_c, args.matrix1_index_factor1,
+          args.matrix0_index_factor1, args.matrix1_index_init_case,
+          args.matrix1_index_step, args.matrix0_index_step,
+          args.inner_loop_count, args.mid_loop_count, args.shift);
+      WebRtcIsacfix_MatrixProduct1Sse2(
+          args.matrix0, matrix1, product_sse2, args.matrix1_index_factor1,
+          args.matrix0_index_factor1, args.matrix1_index_init_case,
+          args.matrix1_index_step, args.matrix0_index_step,
+          args.inner_loop_count, args.mid_loop_count, args.shift);
+      const int outputs = SUBFRAMES * args.mid_loop_count;
+      for (int i = 0; i < outputs; i++) {
+        ASSERT_EQ(product_c[i], product_sse2[i]) << i;
+      }
+    }
+
+    // The (matrix0_index_factor, matrix0_index_step) pairs used with
+    // WebRtcIsacfix_MatrixProduct2().
+    for (int matrix0_index_factor : {1, SUBFRAMES}) {
+      const int matrix0_index_step = SUBFRAMES / matrix0_index_factor;
+      WebRtcIsacfix_MatrixProduct2C(WebRtcIsacfix_kT2GainQ15[0], matrix1,
+                                    product_c, matrix0_index_factor,
+                                    matrix0_index_step);
+      WebRtcIsacfix_MatrixProduct2Sse2(WebRtcIsacfix_kT2GainQ15[0], matrix1,
+                                       product_sse2, matrix0_index_factor,
+                                       matrix0_index_step);
+      for (int i = 0; i < 2 * SUBFRAMES; i++) {
+        ASSERT_EQ(product_c[i], product_sse2[i]) << i;
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace webrtc
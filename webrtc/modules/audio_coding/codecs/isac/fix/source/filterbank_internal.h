@@ -13,6 +13,8 @@
 
 #include <stdint.h>
 
+#include "rtc_base/system/arch.h"
+
 #if defined(__cplusplus) || defined(c_plusplus)
 extern "C" {
 #endif
@@ -69,6 +71,16 @@ void WebRtcIsacfix_AllpassFilter2FixDec16Neon(int16_t* data_ch1,
                                               int32_t* filter_state_ch2);
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcIsacfix_AllpassFilter2FixDec16Sse2(int16_t* data_ch1,
+                                              int16_t* data_ch2,
+                                              const int16_t* factor_ch1,
+                                              const int16_t* factor_ch2,
+                                              const int length,
+                                              int32_t* filter_state_ch1,
+                                              int32_t* filter_state_ch2);
+#endif
+
 #if defined(MIPS_DSP_R1_LE)
 void WebRtcIsacfix_AllpassFilter2FixDec16MIPS(int16_t* data_ch1,
                                               int16_t* data_ch2,
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Contains WebRtcIsacfix_AllpassFilter2FixDec16Sse2() for the iSAC codec,
+// optimized for SSE2. Bit exact with WebRtcIsacfix_AllpassFilter2FixDec16C()
+// in filterbanks.c.
+//
+// As in the Neon version, the four filter sections (two per channel) run in
+// the four lanes of one vector, with the second section of each channel one
+// sample behind the first.
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/isac/fix/source/filterbank_internal.h"
+#include "modules/audio_coding/codecs/isac/fix/source/fixed_point_sse2.h"
+#include "rtc_base/checks.h"
+
+// WebRtcSpl_AddSatW32() on each lane.
+static __inline __m128i AddSat32(__m128i a, __m128i b) {
+  const __m128i sum = _mm_add_epi32(a, b);
+  // Overflow if the sign of the sum differs from the signs of both terms.
+  const __m128i overflow = _mm_srai_epi32(
+      _mm_and_si128(_mm_xor_si128(sum, a), _mm_xor_si128(sum, b)), 31);
+  const __m128i saturated =
+      _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7fffffff));
+  return _mm_or_si128(_mm_and_si128(overflow, saturated),
+                      _mm_andnot_si128(overflow, sum));
+}
+
+// Runs one sample through the sections in the lanes of |mask|. The low half
+// of each lane in |data| is the section input; returns the outputs in the
+// low halves.
+static __inline __m128i FilterStep(__m128i data,
+                                   __m128i factor,
+                                   __m128i mask,
+                                   __m128i* state) {
+  // a = factor * in_out * 2, in Q16.
+  const __m128i a = _mm_slli_epi32(Sse2Mul16x16(factor, data), 1);
+  const __m128i b = AddSat32(a, *state);
+  const __m128i out = _mm_srai_epi32(b, 16);
+  // state = -factor * out * 2 + in_out * 2^16, in Q16.
+  const __m128i new_state = AddSat32(
+      _mm_sub_epi32(_mm_setzero_si128(),
+                    _mm_slli_epi32(Sse2Mul16x16(factor, out), 1)),
+      _mm_slli_epi32(data, 16));
+  *state = _mm_or_si128(_mm_and_si128(mask, new_state),
+                        _mm_andnot_si128(mask, *state));
+  return out;
+}
+
+void WebRtcIsacfix_AllpassFilter2FixDec16Sse2(
+    int16_t* data_ch1,  // Input and output in channel 1, in Q0
+    int16_t* data_ch2,  // Input and output in channel 2, in Q0
+    const int16_t* factor_ch1,  // Scaling factor for channel 1, in Q15
+    const int16_t* factor_ch2,  // Scaling factor for channel 2, in Q15
+    const int length,  // Length of the data buffers
+    int32_t* filter_state_ch1,  // Filter state for channel 1, in Q16
+    int32_t* filter_state_ch2) {  // Filter state for channel 2, in Q16
+  RTC_DCHECK_EQ(0, length % 2);
+  int n = 0;
+  // Lanes: channel 1 section 0, channel 1 section 1, channel 2 section 0 and
+  // channel 2 section 1.
+  const __m128i factor = _mm_set_epi32(
+      (uint16_t)factor_ch2[1], (uint16_t)factor_ch2[0],
+      (uint16_t)factor_ch1[1], (uint16_t)factor_ch1[0]);
+  const __m128i all_sections = _mm_set1_epi32(-1);
+  const __m128i first_sections = _mm_set_epi32(0, -1, 0, -1);
+  const __m128i second_sections = _mm_set_epi32(-1, 0, -1, 0);
+  __m128i state = _mm_set_epi32(filter_state_ch2[1], filter_state_ch2[0],
+                                filter_state_ch1[1], filter_state_ch1[0]);
+  __m128i data;
+  __m128i out;
+
+  // Sample 0 through the first sections only.
+  data = _mm_set_epi32(0, data_ch2[0], 0, data_ch1[0]);
+  out = FilterStep(data, factor, first_sections, &state);
+
+  // Sample n + 1 through the first sections and sample n through the second.
+  for (n = 0; n < length - 1; n++) {
+    data = _mm_slli_epi64(out, 32);
+    data = _mm_insert_epi16(data, data_ch1[n + 1], 0);
+    data = _mm_insert_epi16(data, data_ch2[n + 1], 4);
+    out = FilterStep(data, factor, all_sections, &state);
+    data_ch1[n] = (int16_t)_mm_extract_epi16(out, 2);
+    data_ch2[n] = (int16_t)_mm_extract_epi16(out, 6);
+  }
+
+  // The last sample through the second sections only.
+  data = _mm_slli_epi64(out, 32);
+  out = FilterStep(data, factor, second_sections, &state);
+  data_ch1[n] = (int16_t)_mm_extract_epi16(out, 2);
+  data_ch2[n] = (int16_t)_mm_extract_epi16(out, 6);
+
+  filter_state_ch1[0] = _mm_cvtsi128_si32(state);
+  filter_state_ch1[1] = _mm_cvtsi128_si32(_mm_srli_si128(state, 4));
+  filter_state_ch2[0] = _mm_cvtsi128_si32(_mm_srli_si128(state, 8));
+  filter_state_ch2[1] = _mm_cvtsi128_si32(_mm_srli_si128(state, 12));
+}
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "rtc_base/checks.h"
+#include "modules/audio_coding/codecs/isac/fix/source/codec.h"
+
+// Adds the pairwise products of the eight int16_t in |x| and |y| to the two
+// 64-bit sums in |sum|.
+static __inline __m128i MulAddLong(__m128i sum, __m128i x, __m128i y) {
+  const __m128i kMin = _mm_set1_epi32((int32_t)0x80000000);
+  const __m128i products = _mm_madd_epi16(x, y);
+  // A pair sum only reaches 0x80000000 when it overflows, as
+  // (-32768 * -32768) * 2 = 2^31; sign extend it as positive.
+  const __m128i sign = _mm_andnot_si128(
+      _mm_cmpeq_epi32(products, kMin),
+      _mm_srai_epi32(products, 31));
+  sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(products, sign));
+  return _mm_add_epi64(sum, _mm_unpackhi_epi32(products, sign));
+}
+
+static __inline int64_t HorizontalSum(__m128i sum) {
+  int64_t lanes[2];
+  _mm_storeu_si128((__m128i*)lanes, sum);
+  return lanes[0] + lanes[1];
+}
+
+// Autocorrelation function in fixed point. Bit exact with
+// WebRtcIsacfix_AutocorrC().
+// NOTE! Different from SPLIB-version in how it scales the signal.
+int WebRtcIsacfix_AutocorrSse2(int32_t* __restrict r,
+                               const int16_t* __restrict x,
+                               int16_t n,
+                               int16_t order,
+                               int16_t* __restrict scale) {
+  int i = 0;
+  int j = 0;
+  int16_t scaling = 0;
+  uint32_t temp = 0;
+  int64_t prod = 0;
+  __m128i sum;
+
+  RTC_DCHECK_EQ(0, n % 4);
+  RTC_DCHECK_GE(n, 8);
+
+  // Calculate r[0].
+  sum = _mm_setzero_si128();
+  for (j = 0; j + 8 <= n; j += 8) {
+    const __m128i x_v = _mm_loadu_si128((const __m128i*)&x[j]);
+    sum = MulAddLong(sum, x_v, x_v);
+  }
+  prod = HorizontalSum(sum);
+  for (; j < n; j++) {
+    prod += x[j] * x[j];
+  }
+
+  // Calculate scaling (the value of shifting).
+  temp = (uint32_t)(prod >> 31);
+  scaling = temp ? 32 - WebRtcSpl_NormU32(temp) : 0;
+  r[0] = (int32_t)(prod >> scaling);
+
+  // Perform the actual correlation calculation.
+  for (i = 1; i < order + 1; i++) {
+    const int length = n - i;
+    sum = _mm_setzero_si128();
+    for (j = 0; j + 8 <= length; j += 8) {
+      sum = MulAddLong(sum, _mm_loadu_si128((const __m128i*)&x[j]),
+                       _mm_loadu_si128((const __m128i*)&x[i + j]));
+    }
+    prod = HorizontalSum(sum);
+    for (; j < length; j++) {
+      prod += x[j] * x[i + j];
+    }
+    r[i] = (int32_t)(prod >> scaling);
+  }
+
+  *scale = scaling;
+
+  return order + 1;
+}
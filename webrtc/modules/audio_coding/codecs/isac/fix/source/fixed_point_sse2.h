@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// SSE2 versions of the 16 x 32 bit fixed point multiplication macros in
+// signal_processing_library.h, bit exact with the macros for every input.
+// Each 32-bit lane of a coefficient vector holds one int16_t coefficient in
+// its low half and zero in its high half (see Sse2LoadCoefficients()), so
+// that _mm_madd_epi16() yields one exact 16 x 16 bit product per lane.
+
+#ifndef MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_FIXED_POINT_SSE2_H_
+#define MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_FIXED_POINT_SSE2_H_
+
+#include <emmintrin.h>
+#include <stdint.h>
+
+// Widens four int16_t coefficients to the coefficient vector layout.
+static __inline __m128i Sse2LoadCoefficients(const int16_t* coefficients) {
+  return _mm_unpacklo_epi16(
+      _mm_loadl_epi64((const __m128i*)coefficients), _mm_setzero_si128());
+}
+
+// Broadcasts one int16_t coefficient to the coefficient vector layout.
+static __inline __m128i Sse2SetCoefficient(int16_t coefficient) {
+  return _mm_set1_epi32((uint16_t)coefficient);
+}
+
+// WEBRTC_SPL_MUL_16_16(a, b), with |b| in the low half of each lane.
+static __inline __m128i Sse2Mul16x16(__m128i a, __m128i b) {
+  return _mm_madd_epi16(b, a);
+}
+
+// WEBRTC_SPL_MUL_16_U16(a, (uint16_t)b).
+static __inline __m128i Sse2Mul16xU16(__m128i a, __m128i b) {
+  // The madd treats the low half of |b| as signed; add a * 2^16 back where
+  // its sign bit is set.
+  const __m128i b_negative = _mm_srai_epi32(_mm_slli_epi32(b, 16), 31);
+  return _mm_add_epi32(_mm_madd_epi16(b, a),
+                       _mm_and_si128(_mm_slli_epi32(a, 16), b_negative));
+}
+
+// WEBRTC_SPL_MUL_16_32_RSFT11/14/15(a, b) for |shift| = 11, 14 or 15.
+static __inline __m128i Sse2Mul16x32Rsft(__m128i a, __m128i b, int shift) {
+  const __m128i high = Sse2Mul16x16(a, _mm_srai_epi32(b, 16));
+  const __m128i low = _mm_sra_epi32(
+      _mm_add_epi32(_mm_srai_epi32(Sse2Mul16xU16(a, b), 1),
+                    _mm_set1_epi32(1 << (shift - 2))),
+      _mm_cvtsi32_si128(shift - 1));
+  return _mm_add_epi32(_mm_sll_epi32(high, _mm_cvtsi32_si128(16 - shift)),
+                       low);
+}
+
+// WEBRTC_SPL_MUL_16_32_RSFT16(a, b).
+static __inline __m128i Sse2Mul16x32Rsft16(__m128i a, __m128i b) {
+  const __m128i high = Sse2Mul16x16(a, _mm_srai_epi32(b, 16));
+  const __m128i low_half =
+      _mm_srli_epi32(_mm_and_si128(b, _mm_set1_epi32(0xffff)), 1);
+  const __m128i low = _mm_srai_epi32(
+      _mm_add_epi32(Sse2Mul16x16(a, low_half), _mm_set1_epi32(0x4000)), 15);
+  return _mm_add_epi32(high, low);
+}
+
+// Truncates the 32-bit lanes of |a| and |b| to int16_t, like a C cast.
+static __inline __m128i Sse2TruncateToInt16(__m128i a, __m128i b) {
+  a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+  b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+  return _mm_packs_epi32(a, b);
+}
+
+// Sign extends the low and high four int16_t of |a| to 32 bits.
+static __inline __m128i Sse2WidenLow(__m128i a) {
+  return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+}
+
+static __inline __m128i Sse2WidenHigh(__m128i a) {
+  return _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16);
+}
+
+#endif  // MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_FIXED_POINT_SSE2_H_
@@ -170,6 +170,25 @@ static void WebRtcIsacfix_InitNeon(void) {
 }
 #endif
 
+/****************************************************************************
+ * WebRtcIsacfix_InitSse2(...)
+ *
+ * This function initializes function pointers for x86 platforms with SSE2.
+ */
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+static void WebRtcIsacfix_InitSse2(void) {
+  WebRtcIsacfix_AutocorrFix = WebRtcIsacfix_AutocorrSse2;
+  WebRtcIsacfix_FilterMaLoopFix = WebRtcIsacfix_FilterMaLoopSse2;
+  WebRtcIsacfix_Spec2Time = WebRtcIsacfix_Spec2TimeSse2;
+  WebRtcIsacfix_Time2Spec = WebRtcIsacfix_Time2SpecSse2;
+  WebRtcIsacfix_AllpassFilter2FixDec16 =
+      WebRtcIsacfix_AllpassFilter2FixDec16Sse2;
+  WebRtcIsacfix_MatrixProduct1 = WebRtcIsacfix_MatrixProduct1Sse2;
+  WebRtcIsacfix_MatrixProduct2 = WebRtcIsacfix_MatrixProduct2Sse2;
+}
+#endif
+
 /****************************************************************************
  * WebRtcIsacfix_InitMIPS(...)
  *
@@ -213,6 +232,16 @@ static void InitFunctionPointers(void) {
   WebRtcIsacfix_InitNeon();
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  WebRtcIsacfix_InitSse2();
+#else
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    WebRtcIsacfix_InitSse2();
+  }
+#endif
+#endif
+
 #if defined(MIPS32_LE)
   WebRtcIsacfix_InitMIPS();
 #endif
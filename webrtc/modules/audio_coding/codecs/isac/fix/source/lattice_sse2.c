@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/isac/fix/source/codec.h"
+#include "modules/audio_coding/codecs/isac/fix/source/fixed_point_sse2.h"
+#include "modules/audio_coding/codecs/isac/fix/source/settings.h"
+
+// Contains a function for the core loop in the normalized lattice MA
+// filter routine for iSAC codec, optimized for SSE2. It does:
+//  for 0 <= n < HALF_SUBFRAMELEN - 1:
+//    *ptr2 = input2 * ((*ptr2) + input0 * (*ptr0));
+//    *ptr1 = input1 * (*ptr0) + input0 * (*ptr2);
+// Unlike the Neon version, the output is bit exact with
+// WebRtcIsacfix_FilterMaLoopC().
+void WebRtcIsacfix_FilterMaLoopSse2(int16_t input0,  // Filter coefficient
+                                    int16_t input1,  // Filter coefficient
+                                    int32_t input2,  // Inverse coefficient
+                                    int32_t* ptr0,   // Sample buffer
+                                    int32_t* ptr1,   // Sample buffer
+                                    int32_t* ptr2)   // Sample buffer
+{
+  int n = 0;
+
+  // Separate the 32-bit variable input2 into two 16-bit integers (high 16 and
+  // low 16 bits), as done by LATTICE_MUL_32_32_RSFT16 in lattice.c.
+  int16_t t16a = (int16_t)(input2 >> 16);
+  int16_t t16b = (int16_t)input2;
+  if (t16b < 0) t16a++;
+
+  const __m128i input0_v = Sse2SetCoefficient(input0);
+  const __m128i input1_v = Sse2SetCoefficient(input1);
+  const __m128i t16a_v = Sse2SetCoefficient(t16a);
+  const __m128i t16b_v = Sse2SetCoefficient(t16b);
+
+  for (; n + 4 <= HALF_SUBFRAMELEN - 1; n += 4) {
+    const __m128i ptr0_v = _mm_loadu_si128((const __m128i*)&ptr0[n]);
+    __m128i ptr2_v = _mm_loadu_si128((const __m128i*)&ptr2[n]);
+
+    // Calculate *ptr2 = input2 * (*ptr2 + input0 * (*ptr0)).
+    const __m128i tmp = _mm_add_epi32(
+        ptr2_v, Sse2Mul16x32Rsft(input0_v, ptr0_v, 15));
+    // t16a * tmp, keeping the low 32 bits like WEBRTC_SPL_MUL().
+    const __m128i product = _mm_add_epi32(
+        _mm_slli_epi32(Sse2Mul16x16(t16a_v, _mm_srai_epi32(tmp, 16)), 16),
+        Sse2Mul16xU16(t16a_v, tmp));
+    ptr2_v = _mm_add_epi32(product, Sse2Mul16x32Rsft16(t16b_v, tmp));
+    _mm_storeu_si128((__m128i*)&ptr2[n], ptr2_v);
+
+    // Calculate *ptr1 = input1 * (*ptr0) + input0 * (*ptr2).
+    _mm_storeu_si128(
+        (__m128i*)&ptr1[n],
+        _mm_add_epi32(Sse2Mul16x32Rsft(input1_v, ptr0_v, 15),
+                      Sse2Mul16x32Rsft(input0_v, ptr2_v, 15)));
+  }
+
+  // The remaining samples.
+  for (; n < HALF_SUBFRAMELEN - 1; n++) {
+    int32_t tmp32a;
+    int32_t tmp32b;
+
+    // Calculate *ptr2 = input2 * (*ptr2 + input0 * (*ptr0)).
+    tmp32a = WEBRTC_SPL_MUL_16_32_RSFT15(input0, ptr0[n]);
+    tmp32b = ptr2[n] + tmp32a;
+    ptr2[n] = (int32_t)(WEBRTC_SPL_MUL(t16a, tmp32b) +
+                        (WEBRTC_SPL_MUL_16_32_RSFT16(t16b, tmp32b)));
+
+    // Calculate *ptr1 = input1 * (*ptr0) + input0 * (*ptr2).
+    tmp32a = WEBRTC_SPL_MUL_16_32_RSFT15(input1, ptr0[n]);
+    tmp32b = WEBRTC_SPL_MUL_16_32_RSFT15(input0, ptr2[n]);
+    ptr1[n] = tmp32a + tmp32b;
+  }
+}
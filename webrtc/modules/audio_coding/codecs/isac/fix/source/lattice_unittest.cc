@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/isac/fix/source/codec.h"
+#include "modules/audio_coding/codecs/isac/fix/source/settings.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// The SSE2 MA filter loop is bit exact with the C version.
+TEST(LatticeTest, FilterMaLoopSse2BitExact) {
+  if (WebRtc_GetCPUInfo(kSSE2) == 0) {
+    return;
+  }
+  Random random(7);
+  for (int trial = 0; trial < 200; trial++) {
+    const int16_t input0 = static_cast<int16_t>(random.Rand(-32767, 32767));
+    const int16_t input1 = static_cast<int16_t>(random.Rand(0, 32767));
+    // 1/input1 in Q16, including values with the sign bit of the low half set.
+    const int32_t input2 = random.Rand(65536, 1 << 22);
+    int32_t ptr0[HALF_SUBFRAMELEN];
+    int32_t ptr1_c[HALF_SUBFRAMELEN] = {0};
+    int32_t ptr1_sse2[HALF_SUBFRAMELEN] = {0};
+    int32_t ptr2_c[HALF_SUBFRAMELEN];
+    int32_t ptr2_sse2[HALF_SUBFRAMELEN];
+    for (int n = 0; n < HALF_SUBFRAMELEN; n++) {
+      ptr0[n] = random.Rand(-(1 << 16), 1 << 16);
+      ptr2_c[n] = ptr2_sse2[n] = random.Rand(-(1 << 16), 1 << 16);
+    }
+
+    WebRtcIsacfix_FilterMaLoopC(input0, input1, input2, ptr0, ptr1_c, ptr2_c);
+    WebRtcIsacfix_FilterMaLoopSse2(input0, input1, input2, ptr0, ptr1_sse2,
+                                   ptr2_sse2);
+    for (int n = 0; n < HALF_SUBFRAMELEN; n++) {
+      ASSERT_EQ(ptr1_c[n], ptr1_sse2[n]) << trial << " " << n;
+      ASSERT_EQ(ptr2_c[n], ptr2_sse2[n]) << trial << " " << n;
+    }
+  }
+}
+#endif
+
+}  // namespace webrtc
@@ -0,0 +1,306 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// SSE2 versions of WebRtcIsacfix_Time2SpecC() and WebRtcIsacfix_Spec2TimeC()
+// in transform.c, bit exact with the C versions. The FFT itself is shared;
+// the modulation, scaling and symmetry passes around it are vectorized.
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/isac/fix/source/codec.h"
+#include "modules/audio_coding/codecs/isac/fix/source/fft.h"
+#include "modules/audio_coding/codecs/isac/fix/source/fixed_point_sse2.h"
+#include "modules/audio_coding/codecs/isac/fix/source/settings.h"
+
+// Tables are defined in transform_tables.c file.
+// Cosine table 1 in Q14.
+extern const int16_t WebRtcIsacfix_kCosTab1[FRAMESAMPLES/2];
+// Sine table 1 in Q14.
+extern const int16_t WebRtcIsacfix_kSinTab1[FRAMESAMPLES/2];
+// Sine table 2 in Q14.
+extern const int16_t WebRtcIsacfix_kSinTab2[FRAMESAMPLES/4];
+
+// Updates |max| with the absolute values of |a|, saturated to
+// WEBRTC_SPL_WORD32_MAX like WebRtcSpl_MaxAbsValueW32().
+static __inline __m128i MaxAbs(__m128i max, __m128i a) {
+  const __m128i sign = _mm_srai_epi32(a, 31);
+  __m128i abs = _mm_sub_epi32(_mm_xor_si128(a, sign), sign);
+  abs = _mm_xor_si128(abs, _mm_srai_epi32(abs, 31));
+  const __m128i greater = _mm_cmpgt_epi32(abs, max);
+  return _mm_or_si128(_mm_and_si128(greater, abs),
+                      _mm_andnot_si128(greater, max));
+}
+
+static __inline int32_t HorizontalMax(__m128i max) {
+  int32_t lanes[4];
+  int32_t result = 0;
+  int i;
+  _mm_storeu_si128((__m128i*)lanes, max);
+  for (i = 0; i < 4; i++) {
+    result = lanes[i] > result ? lanes[i] : result;
+  }
+  return result;
+}
+
+// Reverses the order of the four 32-bit lanes.
+static __inline __m128i Reverse32(__m128i a) {
+  return _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+// Loads kSinTab2[FRAMESAMPLES/4 - 1 - k - i] for i = 0..3, negated, as a
+// coefficient vector.
+static __inline __m128i LoadNegatedReversedSinTab2(int k) {
+  __m128i sin = _mm_loadl_epi64(
+      (const __m128i*)&WebRtcIsacfix_kSinTab2[FRAMESAMPLES/4 - 4 - k]);
+  sin = _mm_shufflelo_epi16(sin, _MM_SHUFFLE(0, 1, 2, 3));
+  sin = _mm_sub_epi16(_mm_setzero_si128(), sin);
+  return _mm_unpacklo_epi16(sin, _mm_setzero_si128());
+}
+
+// Writes (int16_t)(in << sh) for sh >= 0, or the rounded (in >> -sh)
+// otherwise.
+static void PreShiftW32toW16(const int32_t* in, int16_t* out, int16_t sh) {
+  int k;
+  if (sh >= 0) {
+    const __m128i shift = _mm_cvtsi32_si128(sh);
+    for (k = 0; k < FRAMESAMPLES/2; k += 8) {
+      const __m128i a = _mm_sll_epi32(
+          _mm_loadu_si128((const __m128i*)&in[k]), shift);
+      const __m128i b = _mm_sll_epi32(
+          _mm_loadu_si128((const __m128i*)&in[k + 4]), shift);
+      _mm_storeu_si128((__m128i*)&out[k], Sse2TruncateToInt16(a, b));
+    }
+  } else {
+    const __m128i shift = _mm_cvtsi32_si128(-sh);
+    const __m128i round = _mm_set1_epi32(1 << (-sh - 1));
+    for (k = 0; k < FRAMESAMPLES/2; k += 8) {
+      const __m128i a = _mm_sra_epi32(
+          _mm_add_epi32(_mm_loadu_si128((const __m128i*)&in[k]), round),
+          shift);
+      const __m128i b = _mm_sra_epi32(
+          _mm_add_epi32(_mm_loadu_si128((const __m128i*)&in[k + 4]), round),
+          shift);
+      _mm_storeu_si128((__m128i*)&out[k], Sse2TruncateToInt16(a, b));
+    }
+  }
+}
+
+// Writes in >> sh for sh >= 0, or in << -sh otherwise, to Q16.
+static void PostShiftW16toW32(const int16_t* in, int32_t* out, int16_t sh) {
+  int k;
+  const __m128i right_shift = _mm_cvtsi32_si128(sh >= 0 ? sh : 0);
+  const __m128i left_shift = _mm_cvtsi32_si128(sh >= 0 ? 0 : -sh);
+  for (k = 0; k < FRAMESAMPLES/2; k += 8) {
+    const __m128i a = _mm_loadu_si128((const __m128i*)&in[k]);
+    _mm_storeu_si128(
+        (__m128i*)&out[k],
+        _mm_sll_epi32(_mm_sra_epi32(Sse2WidenLow(a), right_shift),
+                      left_shift));
+    _mm_storeu_si128(
+        (__m128i*)&out[k + 4],
+        _mm_sll_epi32(_mm_sra_epi32(Sse2WidenHigh(a), right_shift),
+                      left_shift));
+  }
+}
+
+void WebRtcIsacfix_Time2SpecSse2(int16_t* inre1Q9,
+                                 int16_t* inre2Q9,
+                                 int16_t* outreQ7,
+                                 int16_t* outimQ7) {
+  int k;
+  int32_t tmpreQ16[FRAMESAMPLES/2], tmpimQ16[FRAMESAMPLES/2];
+  int16_t sh;
+  // 0.5/sqrt(240) in Q19 is round(.5/sqrt(240)*(2^19)) = 16921.
+  const __m128i factQ19 = Sse2SetCoefficient(16921);
+  const __m128i four = _mm_set1_epi32(4);
+  __m128i max = _mm_setzero_si128();
+
+  // Multiply with complex exponentials and combine into one complex vector,
+  // and find the maximum.
+  for (k = 0; k < FRAMESAMPLES/2; k += 8) {
+    const __m128i cos = _mm_loadu_si128(
+        (const __m128i*)&WebRtcIsacfix_kCosTab1[k]);
+    const __m128i sin = _mm_loadu_si128(
+        (const __m128i*)&WebRtcIsacfix_kSinTab1[k]);
+    const __m128i neg_sin = _mm_sub_epi16(_mm_setzero_si128(), sin);
+    const __m128i in1 = _mm_loadu_si128((const __m128i*)&inre1Q9[k]);
+    const __m128i in2 = _mm_loadu_si128((const __m128i*)&inre2Q9[k]);
+    int half;
+    for (half = 0; half < 2; half++) {
+      __m128i cos_sin, cos_neg_sin, in12, in21;
+      __m128i xrQ16, xiQ16, re, im;
+      if (half == 0) {
+        cos_sin = _mm_unpacklo_epi16(cos, sin);
+        cos_neg_sin = _mm_unpacklo_epi16(cos, neg_sin);
+        in12 = _mm_unpacklo_epi16(in1, in2);
+        in21 = _mm_unpacklo_epi16(in2, in1);
+      } else {
+        cos_sin = _mm_unpackhi_epi16(cos, sin);
+        cos_neg_sin = _mm_unpackhi_epi16(cos, neg_sin);
+        in12 = _mm_unpackhi_epi16(in1, in2);
+        in21 = _mm_unpackhi_epi16(in2, in1);
+      }
+      // xrQ16 = (cos * in1 + sin * in2) >> 7.
+      xrQ16 = _mm_srai_epi32(_mm_madd_epi16(cos_sin, in12), 7);
+      // xiQ16 = (cos * in2 - sin * in1) >> 7.
+      xiQ16 = _mm_srai_epi32(_mm_madd_epi16(cos_neg_sin, in21), 7);
+      // Q-domains below: (Q16*Q19>>16)>>3 = Q16
+      re = _mm_srai_epi32(
+          _mm_add_epi32(Sse2Mul16x32Rsft16(factQ19, xrQ16), four), 3);
+      im = _mm_srai_epi32(
+          _mm_add_epi32(Sse2Mul16x32Rsft16(factQ19, xiQ16), four), 3);
+      _mm_storeu_si128((__m128i*)&tmpreQ16[k + 4 * half], re);
+      _mm_storeu_si128((__m128i*)&tmpimQ16[k + 4 * half], im);
+      max = MaxAbs(MaxAbs(max, re), im);
+    }
+  }
+
+  // If sh becomes >= 0, then we should shift sh steps to the left, and the
+  // domain will become Q(16 + sh). If sh becomes < 0, then we should shift
+  // -sh steps to the right, and the domain will become Q(16 + sh).
+  sh = WebRtcSpl_NormW32(HorizontalMax(max)) - 24;
+  PreShiftW32toW16(tmpreQ16, inre1Q9, sh);
+  PreShiftW32toW16(tmpimQ16, inre2Q9, sh);
+
+  // Get DFT.
+  WebRtcIsacfix_FftRadix16Fastest(inre1Q9, inre2Q9, -1);
+
+  // Back to Q16.
+  PostShiftW16toW32(inre1Q9, tmpreQ16, sh);
+  PostShiftW16toW32(inre2Q9, tmpimQ16, sh);
+
+  // Use symmetry to separate into two complex vectors and center frames in
+  // time around zero.
+  for (k = 0; k < FRAMESAMPLES/4; k += 4) {
+    const int k_rev = FRAMESAMPLES/2 - 4 - k;
+    const __m128i re = _mm_loadu_si128((const __m128i*)&tmpreQ16[k]);
+    const __m128i im = _mm_loadu_si128((const __m128i*)&tmpimQ16[k]);
+    const __m128i re_rev =
+        Reverse32(_mm_loadu_si128((const __m128i*)&tmpreQ16[k_rev]));
+    const __m128i im_rev =
+        Reverse32(_mm_loadu_si128((const __m128i*)&tmpimQ16[k_rev]));
+    const __m128i xrQ16 = _mm_add_epi32(re, re_rev);
+    const __m128i yiQ16 = _mm_sub_epi32(re_rev, re);
+    const __m128i xiQ16 = _mm_sub_epi32(im, im_rev);
+    const __m128i yrQ16 = _mm_add_epi32(im, im_rev);
+    const __m128i tmp1rQ14 = LoadNegatedReversedSinTab2(k);
+    const __m128i tmp1iQ14 =
+        Sse2LoadCoefficients(&WebRtcIsacfix_kSinTab2[k]);
+    __m128i v1Q16, v2Q16, out;
+
+    v1Q16 = _mm_sub_epi32(Sse2Mul16x32Rsft(tmp1rQ14, xrQ16, 14),
+                          Sse2Mul16x32Rsft(tmp1iQ14, xiQ16, 14));
+    v2Q16 = _mm_add_epi32(Sse2Mul16x32Rsft(tmp1iQ14, xrQ16, 14),
+                          Sse2Mul16x32Rsft(tmp1rQ14, xiQ16, 14));
+    out = Sse2TruncateToInt16(_mm_srai_epi32(v1Q16, 9),
+                              _mm_srai_epi32(v2Q16, 9));
+    _mm_storel_epi64((__m128i*)&outreQ7[k], out);
+    _mm_storel_epi64((__m128i*)&outimQ7[k], _mm_srli_si128(out, 8));
+
+    v1Q16 = _mm_sub_epi32(
+        _mm_sub_epi32(_mm_setzero_si128(),
+                      Sse2Mul16x32Rsft(tmp1iQ14, yrQ16, 14)),
+        Sse2Mul16x32Rsft(tmp1rQ14, yiQ16, 14));
+    v2Q16 = _mm_sub_epi32(Sse2Mul16x32Rsft(tmp1iQ14, yiQ16, 14),
+                          Sse2Mul16x32Rsft(tmp1rQ14, yrQ16, 14));
+    out = Sse2TruncateToInt16(Reverse32(_mm_srai_epi32(v1Q16, 9)),
+                              Reverse32(_mm_srai_epi32(v2Q16, 9)));
+    _mm_storel_epi64((__m128i*)&outreQ7[k_rev], out);
+    _mm_storel_epi64((__m128i*)&outimQ7[k_rev], _mm_srli_si128(out, 8));
+  }
+}
+
+void WebRtcIsacfix_Spec2TimeSse2(int16_t* inreQ7,
+                                 int16_t* inimQ7,
+                                 int32_t* outre1Q16,
+                                 int32_t* outre2Q16) {
+  int k;
+  int16_t sh;
+  const __m128i factQ16 = Sse2SetCoefficient(273);
+  // sqrt(240) in Q11 is round(15.49193338482967*2048) = 31727.
+  const __m128i factQ11 = Sse2SetCoefficient(31727);
+  __m128i max = _mm_setzero_si128();
+
+  for (k = 0; k < FRAMESAMPLES/4; k += 4) {
+    const int k_rev = FRAMESAMPLES/2 - 4 - k;
+    // Move zero in time to beginning of frames.
+    const __m128i tmp1rQ14 = LoadNegatedReversedSinTab2(k);
+    const __m128i tmp1iQ14 =
+        Sse2LoadCoefficients(&WebRtcIsacfix_kSinTab2[k]);
+    // Q7 -> Q16.
+    const __m128i in_re = _mm_slli_epi32(
+        Sse2WidenLow(_mm_loadl_epi64((const __m128i*)&inreQ7[k])), 9);
+    const __m128i in_im = _mm_slli_epi32(
+        Sse2WidenLow(_mm_loadl_epi64((const __m128i*)&inimQ7[k])), 9);
+    const __m128i in_re2 = Reverse32(_mm_slli_epi32(
+        Sse2WidenLow(_mm_loadl_epi64((const __m128i*)&inreQ7[k_rev])), 9));
+    const __m128i in_im2 = Reverse32(_mm_slli_epi32(
+        Sse2WidenLow(_mm_loadl_epi64((const __m128i*)&inimQ7[k_rev])), 9));
+
+    const __m128i xrQ16 =
+        _mm_add_epi32(Sse2Mul16x32Rsft(tmp1rQ14, in_re, 14),
+                      Sse2Mul16x32Rsft(tmp1iQ14, in_im, 14));
+    const __m128i xiQ16 =
+        _mm_sub_epi32(Sse2Mul16x32Rsft(tmp1rQ14, in_im, 14),
+                      Sse2Mul16x32Rsft(tmp1iQ14, in_re, 14));
+    const __m128i yrQ16 = _mm_sub_epi32(
+        _mm_sub_epi32(_mm_setzero_si128(),
+                      Sse2Mul16x32Rsft(tmp1rQ14, in_im2, 14)),
+        Sse2Mul16x32Rsft(tmp1iQ14, in_re2, 14));
+    const __m128i yiQ16 =
+        _mm_sub_epi32(Sse2Mul16x32Rsft(tmp1iQ14, in_im2, 14),
+                      Sse2Mul16x32Rsft(tmp1rQ14, in_re2, 14));
+
+    // Combine into one vector, z = x + j * y.
+    const __m128i out1 = _mm_sub_epi32(xrQ16, yiQ16);
+    const __m128i out1_rev = _mm_add_epi32(xrQ16, yiQ16);
+    const __m128i out2 = _mm_add_epi32(xiQ16, yrQ16);
+    const __m128i out2_rev = _mm_sub_epi32(yrQ16, xiQ16);
+    _mm_storeu_si128((__m128i*)&outre1Q16[k], out1);
+    _mm_storeu_si128((__m128i*)&outre1Q16[k_rev], Reverse32(out1_rev));
+    _mm_storeu_si128((__m128i*)&outre2Q16[k], out2);
+    _mm_storeu_si128((__m128i*)&outre2Q16[k_rev], Reverse32(out2_rev));
+    max = MaxAbs(MaxAbs(max, out1), out1_rev);
+    max = MaxAbs(MaxAbs(max, out2), out2_rev);
+  }
+
+  // Get IDFT.
+  sh = WebRtcSpl_NormW32(HorizontalMax(max)) - 24;
+  PreShiftW32toW16(outre1Q16, inreQ7, sh);
+  PreShiftW32toW16(outre2Q16, inimQ7, sh);
+
+  WebRtcIsacfix_FftRadix16Fastest(inreQ7, inimQ7, 1);
+
+  PostShiftW16toW32(inreQ7, outre1Q16, sh);
+  PostShiftW16toW32(inimQ7, outre2Q16, sh);
+
+  // Divide through by the normalizing constant, i.e. scale all values with
+  // 1/240 (273 in Q16), then demodulate and separate.
+  for (k = 0; k < FRAMESAMPLES/2; k += 4) {
+    const __m128i tmp1rQ14 =
+        Sse2LoadCoefficients(&WebRtcIsacfix_kCosTab1[k]);
+    const __m128i tmp1iQ14 =
+        Sse2LoadCoefficients(&WebRtcIsacfix_kSinTab1[k]);
+    const __m128i out1 = Sse2Mul16x32Rsft16(
+        factQ16, _mm_loadu_si128((const __m128i*)&outre1Q16[k]));
+    const __m128i out2 = Sse2Mul16x32Rsft16(
+        factQ16, _mm_loadu_si128((const __m128i*)&outre2Q16[k]));
+    const __m128i xrQ16 =
+        _mm_sub_epi32(Sse2Mul16x32Rsft(tmp1rQ14, out1, 14),
+                      Sse2Mul16x32Rsft(tmp1iQ14, out2, 14));
+    const __m128i xiQ16 =
+        _mm_add_epi32(Sse2Mul16x32Rsft(tmp1rQ14, out2, 14),
+                      Sse2Mul16x32Rsft(tmp1iQ14, out1, 14));
+    _mm_storeu_si128((__m128i*)&outre1Q16[k],
+                     Sse2Mul16x32Rsft(factQ11, xrQ16, 11));
+    _mm_storeu_si128((__m128i*)&outre2Q16[k],
+                     Sse2Mul16x32Rsft(factQ11, xiQ16, 11));
+  }
+}
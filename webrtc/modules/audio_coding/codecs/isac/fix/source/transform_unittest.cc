@@ -9,6 +9,7 @@
  */
 
 #include "modules/audio_coding/codecs/isac/fix/source/codec.h"
+#include "rtc_base/random.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
 
@@ -189,6 +190,11 @@ TEST_F(TransformTest, Time2SpecTest) {
 #if defined(WEBRTC_HAS_NEON)
   Time2SpecTester(WebRtcIsacfix_Time2SpecNeon);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    Time2SpecTester(WebRtcIsacfix_Time2SpecSse2);
+  }
+#endif
 }
 
 TEST_F(TransformTest, Spec2TimeTest) {
@@ -196,4 +202,50 @@ TEST_F(TransformTest, Spec2TimeTest) {
 #if defined(WEBRTC_HAS_NEON)
   Spec2TimeTester(WebRtcIsacfix_Spec2TimeNeon);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    Spec2TimeTester(WebRtcIsacfix_Spec2TimeSse2);
+  }
+#endif
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Unlike the ARM versions, the SSE2 versions are bit exact with C, also for
+// inputs that need left as well as right shifts around the FFT.
+TEST_F(TransformTest, Sse2BitExact) {
+  if (WebRtc_GetCPUInfo(kSSE2) == 0) {
+    return;
+  }
+  webrtc::Random random(4711);
+  for (int trial = 0; trial < 100; trial++) {
+    const int amplitude = 1 << (trial % 15 + 1);
+    int16_t in_1_c[kSamples], in_2_c[kSamples];
+    int16_t in_1_sse2[kSamples], in_2_sse2[kSamples];
+    for (int i = 0; i < kSamples; i++) {
+      in_1_c[i] = in_1_sse2[i] =
+          static_cast<int16_t>(random.Rand(-amplitude, amplitude - 1));
+      in_2_c[i] = in_2_sse2[i] =
+          static_cast<int16_t>(random.Rand(-amplitude, amplitude - 1));
+    }
+    int16_t spec_re_c[kSamples], spec_im_c[kSamples];
+    int16_t spec_re_sse2[kSamples], spec_im_sse2[kSamples];
+    WebRtcIsacfix_Time2SpecC(in_1_c, in_2_c, spec_re_c, spec_im_c);
+    WebRtcIsacfix_Time2SpecSse2(in_1_sse2, in_2_sse2, spec_re_sse2,
+                                spec_im_sse2);
+    for (int i = 0; i < kSamples; i++) {
+      ASSERT_EQ(spec_re_c[i], spec_re_sse2[i]) << trial << " " << i;
+      ASSERT_EQ(spec_im_c[i], spec_im_sse2[i]) << trial << " " << i;
+    }
+
+    int32_t time_1_c[kSamples], time_2_c[kSamples];
+    int32_t time_1_sse2[kSamples], time_2_sse2[kSamples];
+    WebRtcIsacfix_Spec2TimeC(spec_re_c, spec_im_c, time_1_c, time_2_c);
+    WebRtcIsacfix_Spec2TimeSse2(spec_re_sse2, spec_im_sse2, time_1_sse2,
+                                time_2_sse2);
+    for (int i = 0; i < kSamples; i++) {
+      ASSERT_EQ(time_1_c[i], time_1_sse2[i]) << trial << " " << i;
+      ASSERT_EQ(time_2_c[i], time_2_sse2[i]) << trial << " " << i;
+    }
+  }
 }
+#endif
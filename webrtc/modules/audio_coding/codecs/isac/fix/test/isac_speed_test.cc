@@ -9,6 +9,10 @@
  */
 
 #include "modules/audio_coding/codecs/isac/fix/include/isacfix.h"
+#include "modules/audio_coding/codecs/isac/fix/source/codec.h"
+#include "modules/audio_coding/codecs/isac/fix/source/entropy_coding.h"
+#include "modules/audio_coding/codecs/isac/fix/source/filterbank_internal.h"
+#include "modules/audio_coding/codecs/isac/fix/source/lpc_masking_model.h"
 #include "modules/audio_coding/codecs/isac/fix/source/settings.h"
 #include "modules/audio_coding/codecs/tools/audio_codec_speed_test.h"
 
@@ -32,6 +36,9 @@ class IsacSpeedTest : public AudioCodecSpeedTest {
   float DecodeABlock(const uint8_t* bit_stream,
                      size_t encoded_bytes,
                      int16_t* out_data) override;
+  // Replaces the platform specific kernels picked at init, e.g. SSE2 or
+  // Neon, with the generic C versions, as a baseline for the optimized ones.
+  void UseCKernels();
   ISACFIX_MainStruct* ISACFIX_main_inst_;
 };
 
@@ -62,6 +69,19 @@ void IsacSpeedTest::TearDown() {
   EXPECT_EQ(0, WebRtcIsacfix_Free(ISACFIX_main_inst_));
 }
 
+void IsacSpeedTest::UseCKernels() {
+  WebRtcIsacfix_AutocorrFix = WebRtcIsacfix_AutocorrC;
+  WebRtcIsacfix_FilterMaLoopFix = WebRtcIsacfix_FilterMaLoopC;
+  WebRtcIsacfix_CalculateResidualEnergy =
+      WebRtcIsacfix_CalculateResidualEnergyC;
+  WebRtcIsacfix_AllpassFilter2FixDec16 = WebRtcIsacfix_AllpassFilter2FixDec16C;
+  WebRtcIsacfix_HighpassFilterFixDec32 = WebRtcIsacfix_HighpassFilterFixDec32C;
+  WebRtcIsacfix_Time2Spec = WebRtcIsacfix_Time2SpecC;
+  WebRtcIsacfix_Spec2Time = WebRtcIsacfix_Spec2TimeC;
+  WebRtcIsacfix_MatrixProduct1 = WebRtcIsacfix_MatrixProduct1C;
+  WebRtcIsacfix_MatrixProduct2 = WebRtcIsacfix_MatrixProduct2C;
+}
+
 float IsacSpeedTest::EncodeABlock(int16_t* in_data,
                                   uint8_t* bit_stream,
                                   size_t max_bytes,
@@ -105,6 +125,14 @@ TEST_P(IsacSpeedTest, IsacEncodeDecodeTest) {
   EncodeDecode(kDurationSec);
 }
 
+// The same as above with the generic C kernels, for comparing the real time
+// percentages against the platform specific kernels.
+TEST_P(IsacSpeedTest, IsacEncodeDecodeTestCKernels) {
+  size_t kDurationSec = 400;  // Test audio length in second.
+  UseCKernels();
+  EncodeDecode(kDurationSec);
+}
+
 const coding_param param_set[] = {
     std::make_tuple(1,
                     32000,
@@ -10,11 +10,49 @@
 
 #include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
 
+#include "rtc_base/system/arch.h"
+
+// PCM16B is big-endian, so on little-endian hosts encoding and decoding are
+// both a byte swap of each sample, done 8 samples at a time where the
+// instructions are known to be available at compile time.
+#if defined(WEBRTC_ARCH_LITTLE_ENDIAN) && defined(WEBRTC_ARCH_X86_FAMILY) && \
+    defined(__SSE2__)
+#include <emmintrin.h>
+
+static size_t SwapBytes(const void* in, size_t num_samples, void* out) {
+  const __m128i* in_v = (const __m128i*)in;
+  __m128i* out_v = (__m128i*)out;
+  size_t i;
+  for (i = 0; i + 8 <= num_samples; i += 8) {
+    const __m128i v = _mm_loadu_si128(in_v++);
+    _mm_storeu_si128(out_v++,
+                     _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+  }
+  return i;
+}
+#elif defined(WEBRTC_ARCH_LITTLE_ENDIAN) && defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+
+static size_t SwapBytes(const void* in, size_t num_samples, void* out) {
+  const uint8_t* in_bytes = (const uint8_t*)in;
+  uint8_t* out_bytes = (uint8_t*)out;
+  size_t i;
+  for (i = 0; i + 8 <= num_samples; i += 8) {
+    vst1q_u8(&out_bytes[2 * i], vrev16q_u8(vld1q_u8(&in_bytes[2 * i])));
+  }
+  return i;
+}
+#else
+static size_t SwapBytes(const void* in, size_t num_samples, void* out) {
+  return 0;
+}
+#endif
+
 size_t WebRtcPcm16b_Encode(const int16_t* speech,
                            size_t len,
                            uint8_t* encoded) {
   size_t i;
-  for (i = 0; i < len; ++i) {
+  for (i = SwapBytes(speech, len, encoded); i < len; ++i) {
     uint16_t s = speech[i];
     encoded[2 * i] = s >> 8;
     encoded[2 * i + 1] = s;
@@ -26,7 +64,7 @@ size_t WebRtcPcm16b_Decode(const uint8_t* encoded,
                            size_t len,
                            int16_t* speech) {
   size_t i;
-  for (i = 0; i < len / 2; ++i)
+  for (i = SwapBytes(encoded, len / 2, speech); i < len / 2; ++i)
     speech[i] = encoded[2 * i] << 8 | encoded[2 * i + 1];
   return len / 2;
 }
@@ -0,0 +1,43 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+// Encoding swaps whole blocks of samples at a time; check the byte order for
+// lengths around the block size.
+TEST(Pcm16bTest, BigEndianForAllLengths) {
+  Random random(7);
+  for (size_t len = 0; len < 40; ++len) {
+    std::vector<int16_t> speech(len);
+    for (int16_t& sample : speech) {
+      sample = static_cast<int16_t>(random.Rand(-32768, 32767));
+    }
+    std::vector<uint8_t> encoded(2 * len);
+    ASSERT_EQ(2 * len, WebRtcPcm16b_Encode(speech.data(), len, encoded.data()));
+    for (size_t i = 0; i < len; ++i) {
+      EXPECT_EQ(static_cast<uint16_t>(speech[i]) >> 8, encoded[2 * i]);
+      EXPECT_EQ(static_cast<uint16_t>(speech[i]) & 0xFF, encoded[2 * i + 1]);
+    }
+
+    std::vector<int16_t> decoded(len);
+    ASSERT_EQ(len,
+              WebRtcPcm16b_Decode(encoded.data(), 2 * len, decoded.data()));
+    EXPECT_EQ(speech, decoded);
+  }
+}
+
+}  // namespace webrtc
@@ -12,6 +12,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -19,14 +20,31 @@
 
 namespace webrtc {
 
+namespace {
+
+// RFC 2198 headers: 4 bytes for each redundant encoding, with a 14 bit
+// timestamp offset and a 10 bit block length, and 1 byte for the primary one.
+constexpr size_t kRedHeaderLength = 4;
+constexpr size_t kRedLastHeaderLength = 1;
+constexpr uint32_t kMaxRedTimestampOffset = (1 << 14) - 1;
+constexpr size_t kMaxRedBlockLength = (1 << 10) - 1;
+
+}  // namespace
+
+constexpr size_t AudioEncoderCopyRed::kMaxRedundancy;
+
 AudioEncoderCopyRed::Config::Config() = default;
 AudioEncoderCopyRed::Config::Config(Config&&) = default;
 AudioEncoderCopyRed::Config::~Config() = default;
 
 AudioEncoderCopyRed::AudioEncoderCopyRed(Config&& config)
     : speech_encoder_(std::move(config.speech_encoder)),
-      red_payload_type_(config.payload_type) {
+      red_payload_type_(config.payload_type),
+      redundancy_(config.redundancy),
+      write_red_headers_(config.write_red_headers) {
   RTC_CHECK(speech_encoder_) << "Speech encoder not provided.";
+  RTC_CHECK_GE(redundancy_, 1);
+  RTC_CHECK_LE(redundancy_, kMaxRedundancy);
 }
 
 AudioEncoderCopyRed::~AudioEncoderCopyRed() = default;
@@ -59,43 +77,110 @@ AudioEncoder::EncodedInfo AudioEncoderCopyRed::EncodeImpl(
     uint32_t rtp_timestamp,
     rtc::ArrayView<const int16_t> audio,
     rtc::Buffer* encoded) {
-  const size_t primary_offset = encoded->size();
-  EncodedInfo info = speech_encoder_->Encode(rtp_timestamp, audio, encoded);
+  // Encode into the slot of the encoding that has become too old to be sent
+  // again.
+  const size_t num_slots = redundancy_ + 1;
+  const size_t slot = (latest_ + 1) % num_slots;
+  Block& block = blocks_[slot];
+  block.payload.Clear();
+  EncodedInfo info =
+      speech_encoder_->Encode(rtp_timestamp, audio, &block.payload);
 
   RTC_CHECK(info.redundant.empty()) << "Cannot use nested redundant encoders.";
-  RTC_DCHECK_EQ(encoded->size() - primary_offset, info.encoded_bytes);
+  RTC_DCHECK_EQ(block.payload.size(), info.encoded_bytes);
 
   if (info.encoded_bytes > 0) {
     // |info| will be implicitly cast to an EncodedInfoLeaf struct, effectively
     // discarding the (empty) vector of redundant information. This is
     // intentional.
-    info.redundant.push_back(info);
-    RTC_DCHECK_EQ(info.redundant.size(), 1);
-    if (secondary_info_.encoded_bytes > 0) {
-      encoded->AppendData(secondary_encoded_);
-      info.redundant.push_back(secondary_info_);
-      RTC_DCHECK_EQ(info.redundant.size(), 2);
+    block.info = info;
+    block.red_header =
+        (1u << 31) | (static_cast<uint32_t>(info.payload_type & 0x7f) << 24) |
+        static_cast<uint32_t>(info.encoded_bytes & kMaxRedBlockLength);
+    latest_ = slot;
+    num_blocks_ = std::min(num_blocks_ + 1, num_slots);
+
+    // The latest encoding and the previous ones that fit in the packet.
+    size_t num_redundant = num_blocks_ - 1;
+    if (write_red_headers_) {
+      // The blocks only get older, so the first one that does not fit ends
+      // the redundancy.
+      for (size_t age = 1; age <= num_redundant; ++age) {
+        const Block& redundant = BlockAt(age);
+        if (info.encoded_timestamp - redundant.info.encoded_timestamp >
+                kMaxRedTimestampOffset ||
+            redundant.info.encoded_bytes > kMaxRedBlockLength) {
+          num_redundant = age - 1;
+          break;
+        }
+      }
+    }
+    info.redundant.reserve(num_redundant + 1);
+    for (size_t age = 0; age <= num_redundant; ++age) {
+      info.redundant.push_back(BlockAt(age).info);
     }
-    // Save primary to secondary.
-    secondary_encoded_.SetData(encoded->data() + primary_offset,
-                               info.encoded_bytes);
-    secondary_info_ = info;
     RTC_DCHECK_EQ(info.speech, info.redundant[0].speech);
+    info.encoded_bytes = WritePacket(num_redundant, encoded);
   }
   // Update main EncodedInfo.
   info.payload_type = red_payload_type_;
-  info.encoded_bytes = 0;
-  for (std::vector<EncodedInfoLeaf>::const_iterator it = info.redundant.begin();
-       it != info.redundant.end(); ++it) {
-    info.encoded_bytes += it->encoded_bytes;
-  }
   return info;
 }
 
+const AudioEncoderCopyRed::Block& AudioEncoderCopyRed::BlockAt(
+    size_t age) const {
+  RTC_DCHECK_LT(age, num_blocks_);
+  const size_t num_slots = redundancy_ + 1;
+  return blocks_[(latest_ + num_slots - age) % num_slots];
+}
+
+size_t AudioEncoderCopyRed::WritePacket(size_t num_redundant,
+                                        rtc::Buffer* encoded) const {
+  size_t size = 0;
+  for (size_t age = 0; age <= num_redundant; ++age) {
+    size += BlockAt(age).payload.size();
+  }
+  if (write_red_headers_) {
+    size += num_redundant * kRedHeaderLength + kRedLastHeaderLength;
+  }
+
+  return encoded->AppendData(size, [&](rtc::ArrayView<uint8_t> output) {
+    uint8_t* out = output.data();
+    const Block& latest = BlockAt(0);
+    if (!write_red_headers_) {
+      for (size_t age = 0; age <= num_redundant; ++age) {
+        const rtc::Buffer& payload = BlockAt(age).payload;
+        memcpy(out, payload.data(), payload.size());
+        out += payload.size();
+      }
+      return size;
+    }
+
+    for (size_t age = num_redundant; age > 0; --age) {
+      const Block& redundant = BlockAt(age);
+      const uint32_t header =
+          redundant.red_header |
+          ((latest.info.encoded_timestamp - redundant.info.encoded_timestamp)
+           << 10);
+      out[0] = static_cast<uint8_t>(header >> 24);
+      out[1] = static_cast<uint8_t>(header >> 16);
+      out[2] = static_cast<uint8_t>(header >> 8);
+      out[3] = static_cast<uint8_t>(header);
+      out += kRedHeaderLength;
+    }
+    *out++ = static_cast<uint8_t>(latest.info.payload_type & 0x7f);
+    for (size_t age = num_redundant + 1; age > 0; --age) {
+      const rtc::Buffer& payload = BlockAt(age - 1).payload;
+      memcpy(out, payload.data(), payload.size());
+      out += payload.size();
+    }
+    return size;
+  });
+}
+
 void AudioEncoderCopyRed::Reset() {
   speech_encoder_->Reset();
-  secondary_encoded_.Clear();
-  secondary_info_.encoded_bytes = 0;
+  num_blocks_ = 0;
 }
 
 bool AudioEncoderCopyRed::SetFec(bool enable) {
@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <array>
 #include <memory>
 #include <utility>
 
@@ -28,16 +29,32 @@ namespace webrtc {
 
 // This class implements redundant audio coding. The class object will have an
 // underlying AudioEncoder object that performs the actual encodings. The
-// current class will gather the two latest encodings from the underlying codec
-// into one packet.
+// current class will gather the latest encoding and up to |kMaxRedundancy|
+// previous ones from the underlying codec into one packet.
+//
+// The underlying encoder writes straight into a ring of encoded frames, and
+// each packet is assembled from the ring in a single pass, so every payload
+// is copied exactly once per packet it is sent in.
 class AudioEncoderCopyRed final : public AudioEncoder {
  public:
+  static constexpr size_t kMaxRedundancy = 4;
+
   struct Config {
     Config();
     Config(Config&&);
     ~Config();
     int payload_type;
     std::unique_ptr<AudioEncoder> speech_encoder;
+    // Number of previous encodings sent along with the latest one, in
+    // [1, kMaxRedundancy].
+    size_t redundancy = 1;
+    // If true, the output is a complete RFC 2198 payload: the RED headers
+    // followed by the redundant encodings, oldest first, and the latest
+    // encoding last. Redundant encodings that cannot be described by a RED
+    // header (too old or too large) are left out. If false, the output is the
+    // latest encoding followed by the redundant ones, newest first, without
+    // headers, and the RED headers are left to the packetizer.
+    bool write_red_headers = false;
   };
 
   explicit AudioEncoderCopyRed(Config&& config);
@@ -71,10 +88,33 @@ class AudioEncoderCopyRed final : public AudioEncoder {
                          rtc::Buffer* encoded) override;
 
  private:
+  // An encoding from the underlying encoder.
+  struct Block {
+    rtc::Buffer payload;
+    EncodedInfoLeaf info;
+    // RED header of the block as a redundant encoding, without the timestamp
+    // offset, which depends on the packet it is sent in.
+    uint32_t red_header = 0;
+  };
+
+  // Returns the block that was encoded |age| encodings before the latest one.
+  const Block& BlockAt(size_t age) const;
+
+  // Writes the blocks, from the latest to |num_redundant| encodings before it,
+  // to |encoded| in the layout selected by |write_red_headers_|. Returns the
+  // number of bytes written.
+  size_t WritePacket(size_t num_redundant, rtc::Buffer* encoded) const;
+
   std::unique_ptr<AudioEncoder> speech_encoder_;
-  int red_payload_type_;
-  rtc::Buffer secondary_encoded_;
-  EncodedInfoLeaf secondary_info_;
+  const int red_payload_type_;
+  const size_t redundancy_;
+  const bool write_red_headers_;
+  // The latest encodings; |redundancy_| + 1 of the slots are used.
+  std::array<Block, kMaxRedundancy + 1> blocks_;
+  // Index in |blocks_| of the latest encoding.
+  size_t latest_ = 0;
+  // Number of valid encodings in |blocks_|, including the latest one.
+  size_t num_blocks_ = 0;
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioEncoderCopyRed);
 };
 
@@ -10,6 +10,7 @@
 
 #include "modules/audio_coding/codecs/red/audio_encoder_copy_red.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -43,11 +44,21 @@ class AudioEncoderCopyRedTest : public ::testing::Test {
         sample_rate_hz_(16000),
         num_audio_samples_10ms(sample_rate_hz_ / 100),
         red_payload_type_(200) {
+    CreateRed(mock_encoder_, 1, false);
+    memset(audio_, 0, sizeof(audio_));
+  }
+
+  // Replaces |red_| with an encoder that wraps |mock_encoder|.
+  void CreateRed(MockAudioEncoder* mock_encoder,
+                 size_t redundancy,
+                 bool write_red_headers) {
+    mock_encoder_ = mock_encoder;
     AudioEncoderCopyRed::Config config;
     config.payload_type = red_payload_type_;
     config.speech_encoder = std::unique_ptr<AudioEncoder>(mock_encoder_);
+    config.redundancy = redundancy;
+    config.write_red_headers = write_red_headers;
     red_.reset(new AudioEncoderCopyRed(std::move(config)));
-    memset(audio_, 0, sizeof(audio_));
     EXPECT_CALL(*mock_encoder_, NumChannels()).WillRepeatedly(Return(1U));
     EXPECT_CALL(*mock_encoder_, SampleRateHz())
         .WillRepeatedly(Return(sample_rate_hz_));
@@ -286,6 +297,105 @@ TEST_F(AudioEncoderCopyRedTest, CheckPayloadType) {
   EXPECT_EQ(red_payload_type_, encoded_info_.payload_type);
 }
 
+// Checks that up to |redundancy| previous payloads follow the primary one,
+// newest first.
+TEST_F(AudioEncoderCopyRedTest, CheckPayloadsWithRedundancy) {
+  constexpr size_t kRedundancy = 3;
+  CreateRed(new MockAudioEncoder, kRedundancy, false);
+  static const size_t kPayloadLenBytes = 5;
+  uint8_t payload[kPayloadLenBytes];
+  for (uint8_t i = 0; i < kPayloadLenBytes; ++i) {
+    payload[i] = i;
+  }
+  EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+      .WillRepeatedly(Invoke(MockAudioEncoder::CopyEncoding(payload)));
+
+  for (size_t j = 0; j < 8; ++j) {
+    Encode();
+    const size_t num_blocks = std::min(j, kRedundancy) + 1;
+    ASSERT_EQ(num_blocks, encoded_info_.redundant.size());
+    ASSERT_EQ(num_blocks * kPayloadLenBytes, encoded_.size());
+    EXPECT_EQ(encoded_.size(), encoded_info_.encoded_bytes);
+    for (size_t block = 0; block < num_blocks; ++block) {
+      for (size_t i = 0; i < kPayloadLenBytes; ++i) {
+        EXPECT_EQ((j - block) * 10 + i,
+                  encoded_.data()[block * kPayloadLenBytes + i]);
+      }
+    }
+    // Increment all values of the payload by 10.
+    for (size_t i = 0; i < kPayloadLenBytes; ++i)
+      payload[i] += 10;
+  }
+}
+
+// Checks the RFC 2198 headers written ahead of the payloads.
+TEST_F(AudioEncoderCopyRedTest, CheckRedHeaders) {
+  CreateRed(new MockAudioEncoder, 2, true);
+  const int kPrimaryPayloadType = 111;
+  const uint32_t kTimestampStep = 960;
+  AudioEncoder::EncodedInfo info;
+  info.payload_type = kPrimaryPayloadType;
+  for (size_t i = 0; i < 3; ++i) {
+    info.encoded_bytes = 10 * (i + 1);
+    info.encoded_timestamp = 4711 + i * kTimestampStep;
+    EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+        .WillOnce(Invoke(MockAudioEncoder::FakeEncoding(info)));
+    Encode();
+  }
+
+  ASSERT_EQ(3u, encoded_info_.redundant.size());
+  EXPECT_EQ(red_payload_type_, encoded_info_.payload_type);
+  const size_t kHeaderBytes = 4 + 4 + 1;
+  ASSERT_EQ(kHeaderBytes + 10 + 20 + 30, encoded_.size());
+  EXPECT_EQ(encoded_.size(), encoded_info_.encoded_bytes);
+  // Oldest block: offset 2 * 960, length 10.
+  const uint8_t kExpectedHeaders[kHeaderBytes] = {
+      0x80 | kPrimaryPayloadType, (1920 >> 6) & 0xff,
+      ((1920 & 0x3f) << 2) | (10 >> 8), 10 & 0xff,
+      0x80 | kPrimaryPayloadType, (960 >> 6) & 0xff,
+      ((960 & 0x3f) << 2) | (20 >> 8), 20 & 0xff,
+      kPrimaryPayloadType};
+  for (size_t i = 0; i < kHeaderBytes; ++i) {
+    EXPECT_EQ(kExpectedHeaders[i], encoded_.data()[i]) << "Byte " << i;
+  }
+}
+
+// Checks that payloads too old for the 14 bit timestamp offset of the RED
+// header are left out.
+TEST_F(AudioEncoderCopyRedTest, DropsRedundancyBeyondRedHeaderRange) {
+  CreateRed(new MockAudioEncoder, 2, true);
+  AudioEncoder::EncodedInfo info;
+  info.payload_type = 111;
+  info.encoded_bytes = 10;
+  for (size_t i = 0; i < 3; ++i) {
+    info.encoded_timestamp = 4711 + i * 10000;
+    EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+        .WillOnce(Invoke(MockAudioEncoder::FakeEncoding(info)));
+    Encode();
+  }
+  ASSERT_EQ(2u, encoded_info_.redundant.size());
+  EXPECT_EQ(4711u + 20000, encoded_info_.redundant[0].encoded_timestamp);
+  EXPECT_EQ(4711u + 10000, encoded_info_.redundant[1].encoded_timestamp);
+  EXPECT_EQ(4u + 1 + 2 * 10, encoded_.size());
+}
+
+// Checks that a reset forgets the previous payloads.
+TEST_F(AudioEncoderCopyRedTest, ResetClearsRedundancy) {
+  CreateRed(new MockAudioEncoder, 2, false);
+  AudioEncoder::EncodedInfo info;
+  info.encoded_bytes = 10;
+  EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+      .WillRepeatedly(Invoke(MockAudioEncoder::FakeEncoding(info)));
+  Encode();
+  Encode();
+  ASSERT_EQ(2u, encoded_info_.redundant.size());
+  EXPECT_CALL(*mock_encoder_, Reset());
+  red_->Reset();
+  Encode();
+  EXPECT_EQ(1u, encoded_info_.redundant.size());
+  EXPECT_EQ(10u, encoded_.size());
+}
+
 #if GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 // This test fixture tests various error conditions that makes the
@@ -312,6 +422,13 @@ TEST_F(AudioEncoderCopyRedDeathTest, NullSpeechEncoder) {
   delete red;
 }
 
+TEST_F(AudioEncoderCopyRedDeathTest, InvalidRedundancy) {
+  RTC_EXPECT_DEATH(CreateRed(new MockAudioEncoder, 0, false), "");
+  RTC_EXPECT_DEATH(CreateRed(new MockAudioEncoder,
+                             AudioEncoderCopyRed::kMaxRedundancy + 1, false),
+                   "");
+}
+
 #endif  // GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 }  // namespace webrtc
@@ -0,0 +1,294 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/tools/audio_codec_benchmark.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "api/array_view.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/json.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+// Length of the synthetic signal, which is looped.
+constexpr int kSignalLengthMs = 2000;
+// Longest packet any of the decoders produces.
+constexpr int kMaxPacketMs = 120;
+
+// Generates |kSignalLengthMs| of interleaved audio: a second of a harmonic
+// tone with noise, to keep the speech paths of the encoders busy, followed by
+// a second of faint noise, for the VAD, DTX and comfort noise paths.
+std::vector<int16_t> CreateSignal(int sample_rate_hz, size_t num_channels) {
+  const size_t samples_per_channel = sample_rate_hz * kSignalLengthMs / 1000;
+  std::vector<int16_t> signal(samples_per_channel * num_channels);
+  Random random(0x1234);
+  for (size_t n = 0; n < samples_per_channel; ++n) {
+    const bool tone = n < samples_per_channel / 2;
+    for (size_t c = 0; c < num_channels; ++c) {
+      const double t = static_cast<double>(n) / sample_rate_hz;
+      const double f0 = 220.0 * (c + 1);
+      double sample = random.Gaussian(0.0, tone ? 300.0 : 30.0);
+      if (tone) {
+        sample += 6000 * sin(2 * M_PI * f0 * t) +
+                  2000 * sin(2 * M_PI * 3 * f0 * t) +
+                  1000 * sin(2 * M_PI * 7 * f0 * t);
+      }
+      signal[n * num_channels + c] = static_cast<int16_t>(
+          std::max(-32768.0, std::min(32767.0, sample)));
+    }
+  }
+  return signal;
+}
+
+// Encodes and decodes on a thread of its own.
+class Instance {
+ public:
+  Instance(const AudioCodecBenchmark::Case& benchmark_case,
+           rtc::ArrayView<const int16_t> signal,
+           int duration_ms,
+           int index)
+      : case_(benchmark_case),
+        signal_(signal),
+        duration_ms_(duration_ms),
+        index_(index),
+        thread_(&Instance::Run,
+                this,
+                "CodecBenchmark" + std::to_string(index)) {}
+
+  void Start() { thread_.Start(); }
+  void Stop() { thread_.Stop(); }
+
+  // Adds the statistics of this instance to |result|; call after Stop().
+  void AddTo(AudioCodecBenchmark::Result* result) const {
+    result->audio_ms += duration_ms_;
+    result->encode_cpu_time_ns += encode_cpu_time_ns_;
+    result->decode_cpu_time_ns += decode_cpu_time_ns_;
+    result->encoded_bytes += encoded_bytes_;
+    result->packets += packets_;
+    result->decode_errors += decode_errors_;
+  }
+
+ private:
+  static void Run(void* obj) { static_cast<Instance*>(obj)->Process(); }
+
+  void Process() {
+    // Created on this thread, so that its memory is allocated here too.
+    std::unique_ptr<AudioEncoder> encoder = case_.create_encoder();
+    std::unique_ptr<AudioDecoder> decoder =
+        case_.create_decoder ? case_.create_decoder() : nullptr;
+    const size_t block_size =
+        rtc::CheckedDivExact(encoder->SampleRateHz(), 100) *
+        encoder->NumChannels();
+    RTC_CHECK_EQ(0, signal_.size() % block_size);
+    const size_t num_blocks = signal_.size() / block_size;
+    std::vector<int16_t> decoded;
+    if (decoder) {
+      decoded.resize(decoder->SampleRateHz() / 1000 * kMaxPacketMs *
+                     decoder->Channels());
+    }
+    rtc::Buffer encoded;
+    uint32_t rtp_timestamp = 0;
+    // Start each instance at a different place in the signal, so that the
+    // threads do not switch between tone and noise in lockstep.
+    size_t block = (index_ * 37) % num_blocks;
+
+    for (int time_ms = 0; time_ms < duration_ms_; time_ms += 10) {
+      const rtc::ArrayView<const int16_t> audio =
+          signal_.subview(block * block_size, block_size);
+      block = (block + 1) % num_blocks;
+
+      encoded.Clear();
+      int64_t start_ns = rtc::GetThreadCpuTimeNanos();
+      encoder->Encode(rtp_timestamp, audio, &encoded);
+      encode_cpu_time_ns_ += rtc::GetThreadCpuTimeNanos() - start_ns;
+      rtp_timestamp += encoder->RtpTimestampRateHz() / 100;
+      if (encoded.empty()) {
+        continue;
+      }
+      ++packets_;
+      encoded_bytes_ += encoded.size();
+      if (!decoder) {
+        continue;
+      }
+
+      AudioDecoder::SpeechType speech_type;
+      start_ns = rtc::GetThreadCpuTimeNanos();
+      const int decoded_samples = decoder->Decode(
+          encoded.data(), encoded.size(), decoder->SampleRateHz(),
+          decoded.size() * sizeof(int16_t), decoded.data(), &speech_type);
+      decode_cpu_time_ns_ += rtc::GetThreadCpuTimeNanos() - start_ns;
+      if (decoded_samples < 0) {
+        ++decode_errors_;
+      }
+    }
+  }
+
+  const AudioCodecBenchmark::Case& case_;
+  const rtc::ArrayView<const int16_t> signal_;
+  const int duration_ms_;
+  const int index_;
+  int64_t encode_cpu_time_ns_ = 0;
+  int64_t decode_cpu_time_ns_ = 0;
+  int64_t encoded_bytes_ = 0;
+  int64_t packets_ = 0;
+  int64_t decode_errors_ = 0;
+  rtc::PlatformThread thread_;
+};
+
+bool SameCase(const AudioCodecBenchmark::Result& a,
+              const AudioCodecBenchmark::Result& b) {
+  return a.codec == b.codec && a.sample_rate_hz == b.sample_rate_hz &&
+         a.num_channels == b.num_channels &&
+         a.frame_size_ms == b.frame_size_ms && a.complexity == b.complexity &&
+         a.redundancy == b.redundancy;
+}
+
+// Audio processed per wall clock time, summed over the threads.
+double RealtimeFactor(const AudioCodecBenchmark::Result& result) {
+  return result.wall_time_ms > 0
+             ? static_cast<double>(result.audio_ms) / result.wall_time_ms
+             : 0.0;
+}
+
+}  // namespace
+
+AudioCodecBenchmark::Case::Case() = default;
+AudioCodecBenchmark::Case::Case(const Case&) = default;
+AudioCodecBenchmark::Case::~Case() = default;
+
+AudioCodecBenchmark::Config::Config() = default;
+AudioCodecBenchmark::Config::Config(const Config&) = default;
+AudioCodecBenchmark::Config::~Config() = default;
+
+AudioCodecBenchmark::AudioCodecBenchmark(const Config& config)
+    : config_(config) {
+  RTC_DCHECK_GT(config_.duration_ms, 0);
+  RTC_DCHECK_EQ(0, config_.duration_ms % 10);
+}
+
+AudioCodecBenchmark::~AudioCodecBenchmark() = default;
+
+std::vector<AudioCodecBenchmark::Result> AudioCodecBenchmark::Run() const {
+  std::vector<Result> results;
+  for (const Case& benchmark_case : config_.cases) {
+    for (int num_threads : config_.thread_counts) {
+      results.push_back(RunCase(benchmark_case, num_threads));
+    }
+  }
+  return results;
+}
+
+AudioCodecBenchmark::Result AudioCodecBenchmark::RunCase(
+    const Case& benchmark_case,
+    int num_threads) const {
+  RTC_DCHECK_GT(num_threads, 0);
+  const std::vector<int16_t> signal =
+      CreateSignal(benchmark_case.sample_rate_hz, benchmark_case.num_channels);
+
+  std::vector<std::unique_ptr<Instance>> instances;
+  for (int i = 0; i < num_threads; ++i) {
+    instances.push_back(std::make_unique<Instance>(
+        benchmark_case, signal, config_.duration_ms, i));
+  }
+  const int64_t start_ms = rtc::TimeMillis();
+  for (auto& instance : instances) {
+    instance->Start();
+  }
+  for (auto& instance : instances) {
+    instance->Stop();
+  }
+
+  Result result;
+  result.wall_time_ms = rtc::TimeMillis() - start_ms;
+  result.codec = benchmark_case.codec;
+  result.sample_rate_hz = benchmark_case.sample_rate_hz;
+  result.num_channels = benchmark_case.num_channels;
+  result.frame_size_ms = benchmark_case.frame_size_ms;
+  result.complexity = benchmark_case.complexity;
+  result.redundancy = benchmark_case.redundancy;
+  result.num_threads = num_threads;
+  for (const auto& instance : instances) {
+    instance->AddTo(&result);
+  }
+  return result;
+}
+
+std::string AudioCodecBenchmark::ToJson(const std::vector<Result>& results) {
+  SJson::Value root(SJson::arrayValue);
+  for (const Result& result : results) {
+    SJson::Value entry;
+    entry["codec"] = result.codec;
+    entry["sample_rate_hz"] = result.sample_rate_hz;
+    entry["num_channels"] = static_cast<int>(result.num_channels);
+    entry["frame_size_ms"] = result.frame_size_ms;
+    if (result.complexity >= 0) {
+      entry["complexity"] = result.complexity;
+    }
+    if (result.redundancy >= 0) {
+      entry["redundancy"] = result.redundancy;
+    }
+    entry["num_threads"] = result.num_threads;
+    entry["audio_ms"] = static_cast<SJson::Int64>(result.audio_ms);
+    entry["wall_time_ms"] = static_cast<SJson::Int64>(result.wall_time_ms);
+    entry["encode_cpu_time_ns"] =
+        static_cast<SJson::Int64>(result.encode_cpu_time_ns);
+    entry["decode_cpu_time_ns"] =
+        static_cast<SJson::Int64>(result.decode_cpu_time_ns);
+    entry["packets"] = static_cast<SJson::Int64>(result.packets);
+    entry["decode_errors"] = static_cast<SJson::Int64>(result.decode_errors);
+
+    const double blocks = result.audio_ms / 10.0;
+    entry["encode_ns_per_10ms"] =
+        blocks > 0 ? result.encode_cpu_time_ns / blocks : 0.0;
+    entry["decode_ns_per_10ms"] =
+        blocks > 0 ? result.decode_cpu_time_ns / blocks : 0.0;
+    entry["bitrate_bps"] =
+        result.audio_ms > 0 ? 8000.0 * result.encoded_bytes / result.audio_ms
+                            : 0.0;
+    // Encoder and decoder pairs one core can run in real time.
+    const int64_t cpu_time_ns =
+        result.encode_cpu_time_ns + result.decode_cpu_time_ns;
+    entry["streams_per_core"] =
+        cpu_time_ns > 0 ? 1e6 * result.audio_ms / cpu_time_ns : 0.0;
+    entry["realtime_factor"] = RealtimeFactor(result);
+
+    // Throughput relative to |num_threads| times the single threaded run.
+    auto single = std::find_if(
+        results.begin(), results.end(), [&result](const Result& other) {
+          return other.num_threads == 1 && SameCase(result, other);
+        });
+    if (single != results.end() && RealtimeFactor(*single) > 0) {
+      entry["scaling_efficiency"] =
+          RealtimeFactor(result) /
+          (result.num_threads * RealtimeFactor(*single));
+    }
+    root.append(entry);
+  }
+
+  SJson::StreamWriterBuilder builder;
+  builder["indentation"] = "  ";
+  return SJson::writeString(builder, root);
+}
+
+}  // namespace test
+}  // namespace webrtc
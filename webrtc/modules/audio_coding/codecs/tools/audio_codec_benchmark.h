@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_TOOLS_AUDIO_CODEC_BENCHMARK_H_
+#define MODULES_AUDIO_CODING_CODECS_TOOLS_AUDIO_CODEC_BENCHMARK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/audio_codecs/audio_decoder.h"
+#include "api/audio_codecs/audio_encoder.h"
+
+namespace webrtc {
+namespace test {
+
+// Measures the CPU cost of audio encoders and decoders, and how their
+// throughput scales with the number of threads. For every case, each thread
+// runs its own encoder and decoder instance over a synthetic signal, encoding
+// 10 ms at a time and decoding every packet as soon as it is produced, and the
+// thread CPU time of the encode and decode calls is accumulated separately.
+//
+// Unlike AudioCodecSpeedTest, which times one instance of one codec on one
+// thread, this runs a whole sweep of codecs and configurations in one process
+// and reports the results as JSON, so that runs can be compared mechanically.
+class AudioCodecBenchmark {
+ public:
+  struct Case {
+    Case();
+    Case(const Case&);
+    ~Case();
+
+    // Name of the codec, e.g. "opus" or "cng(pcmu)".
+    std::string codec;
+    int sample_rate_hz = 0;
+    size_t num_channels = 1;
+    int frame_size_ms = 0;
+    // Codec specific; -1 where they do not apply.
+    int complexity = -1;
+    int redundancy = -1;
+    std::function<std::unique_ptr<AudioEncoder>()> create_encoder;
+    // Null for payloads that are only meaningful to NetEq, like RED.
+    std::function<std::unique_ptr<AudioDecoder>()> create_decoder;
+  };
+
+  struct Config {
+    Config();
+    Config(const Config&);
+    ~Config();
+
+    std::vector<Case> cases;
+    // Every case is run once with each of these thread counts.
+    std::vector<int> thread_counts = {1};
+    // Audio encoded by each thread.
+    int duration_ms = 10000;
+  };
+
+  struct Result {
+    std::string codec;
+    int sample_rate_hz = 0;
+    size_t num_channels = 0;
+    int frame_size_ms = 0;
+    int complexity = -1;
+    int redundancy = -1;
+    int num_threads = 0;
+    // Sum over all threads.
+    int64_t audio_ms = 0;
+    int64_t encode_cpu_time_ns = 0;
+    int64_t decode_cpu_time_ns = 0;
+    int64_t wall_time_ms = 0;
+    int64_t encoded_bytes = 0;
+    int64_t packets = 0;
+    int64_t decode_errors = 0;
+  };
+
+  explicit AudioCodecBenchmark(const Config& config);
+  ~AudioCodecBenchmark();
+
+  // Runs all cases with all thread counts.
+  std::vector<Result> Run() const;
+
+  // Runs one case on |num_threads| threads.
+  Result RunCase(const Case& benchmark_case, int num_threads) const;
+
+  // Returns the results as a JSON array, with the derived per-stream costs
+  // and the scaling relative to the single threaded run of the same case.
+  static std::string ToJson(const std::vector<Result>& results);
+
+ private:
+  const Config config_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_CODECS_TOOLS_AUDIO_CODEC_BENCHMARK_H_
@@ -0,0 +1,336 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_split.h"
+#include "modules/audio_coding/codecs/cng/audio_encoder_cng.h"
+#include "modules/audio_coding/codecs/g711/audio_decoder_pcm.h"
+#include "modules/audio_coding/codecs/g711/audio_encoder_pcm.h"
+#include "modules/audio_coding/codecs/g722/audio_decoder_g722.h"
+#include "modules/audio_coding/codecs/g722/audio_encoder_g722.h"
+#include "modules/audio_coding/codecs/ilbc/audio_decoder_ilbc.h"
+#include "modules/audio_coding/codecs/ilbc/audio_encoder_ilbc.h"
+#include "modules/audio_coding/codecs/isac/fix/include/audio_decoder_isacfix.h"
+#include "modules/audio_coding/codecs/isac/fix/include/audio_encoder_isacfix.h"
+#include "modules/audio_coding/codecs/isac/main/include/audio_decoder_isac.h"
+#include "modules/audio_coding/codecs/isac/main/include/audio_encoder_isac.h"
+#include "modules/audio_coding/codecs/opus/audio_decoder_opus.h"
+#include "modules/audio_coding/codecs/opus/audio_encoder_opus.h"
+#include "modules/audio_coding/codecs/pcm16b/audio_decoder_pcm16b.h"
+#include "modules/audio_coding/codecs/pcm16b/audio_encoder_pcm16b.h"
+#include "modules/audio_coding/codecs/red/audio_encoder_copy_red.h"
+#include "modules/audio_coding/codecs/tools/audio_codec_benchmark.h"
+#include "rtc_base/checks.h"
+
+ABSL_FLAG(std::string,
+          codecs,
+          "",
+          "Comma separated list of the codecs to run, e.g. \"opus,g722\". "
+          "Runs all codecs if empty.");
+ABSL_FLAG(int,
+          max_threads,
+          4,
+          "Each case is run with 1, 2, 4, ... threads, up to this many.");
+ABSL_FLAG(int, duration_ms, 10000, "Audio encoded by each thread.");
+ABSL_FLAG(std::string,
+          output,
+          "",
+          "File to write the JSON result to. Defaults to stdout.");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+using Case = AudioCodecBenchmark::Case;
+
+Case MakeCase(std::string codec,
+              int sample_rate_hz,
+              size_t num_channels,
+              int frame_size_ms,
+              std::function<std::unique_ptr<AudioEncoder>()> create_encoder,
+              std::function<std::unique_ptr<AudioDecoder>()> create_decoder) {
+  Case benchmark_case;
+  benchmark_case.codec = std::move(codec);
+  benchmark_case.sample_rate_hz = sample_rate_hz;
+  benchmark_case.num_channels = num_channels;
+  benchmark_case.frame_size_ms = frame_size_ms;
+  benchmark_case.create_encoder = std::move(create_encoder);
+  benchmark_case.create_decoder = std::move(create_decoder);
+  return benchmark_case;
+}
+
+std::unique_ptr<AudioEncoder> CreatePcmuEncoder(size_t num_channels,
+                                                int frame_size_ms) {
+  AudioEncoderPcmU::Config config;
+  config.num_channels = num_channels;
+  config.frame_size_ms = frame_size_ms;
+  return std::make_unique<AudioEncoderPcmU>(config);
+}
+
+std::unique_ptr<AudioEncoder> CreateG722Encoder(size_t num_channels,
+                                                int frame_size_ms) {
+  AudioEncoderG722Config config;
+  config.num_channels = num_channels;
+  config.frame_size_ms = frame_size_ms;
+  return std::make_unique<AudioEncoderG722Impl>(config, 9);
+}
+
+std::unique_ptr<AudioEncoder> CreateOpusEncoder(size_t num_channels,
+                                                int frame_size_ms,
+                                                int complexity) {
+  AudioEncoderOpusConfig config;
+  config.num_channels = num_channels;
+  config.frame_size_ms = frame_size_ms;
+  config.complexity = complexity;
+  config.low_rate_complexity = complexity;
+  config.application = num_channels == 1
+                           ? AudioEncoderOpusConfig::ApplicationMode::kVoip
+                           : AudioEncoderOpusConfig::ApplicationMode::kAudio;
+  return AudioEncoderOpusImpl::MakeAudioEncoder(config, 111);
+}
+
+template <typename Encoder, typename Decoder>
+void AddIsacCases(const std::string& codec, std::vector<Case>* cases) {
+  const std::pair<int, int> kRatesAndFrameSizes[] = {
+      {16000, 30}, {16000, 60}, {32000, 30}};
+  for (const auto& rate_and_frame_size : kRatesAndFrameSizes) {
+    typename Encoder::Config encoder_config;
+    encoder_config.sample_rate_hz = rate_and_frame_size.first;
+    encoder_config.frame_size_ms = rate_and_frame_size.second;
+    encoder_config.bit_rate =
+        encoder_config.sample_rate_hz == 16000 ? 32000 : 56000;
+    if (!encoder_config.IsOk()) {
+      // Super-wideband is only available in the float implementation.
+      continue;
+    }
+    typename Decoder::Config decoder_config;
+    decoder_config.sample_rate_hz = encoder_config.sample_rate_hz;
+    cases->push_back(MakeCase(
+        codec, encoder_config.sample_rate_hz, 1, encoder_config.frame_size_ms,
+        [encoder_config] {
+          return std::make_unique<Encoder>(encoder_config);
+        },
+        [decoder_config] {
+          return std::make_unique<Decoder>(decoder_config);
+        }));
+  }
+}
+
+// Every in-tree codec, with the configurations that matter for capacity:
+// frame sizes, channel counts and, for Opus, complexity.
+std::vector<Case> CreateCases() {
+  std::vector<Case> cases;
+
+  for (size_t num_channels : {1, 2}) {
+    for (int frame_size_ms : {10, 20, 60}) {
+      cases.push_back(MakeCase(
+          "pcmu", 8000, num_channels, frame_size_ms,
+          [=] { return CreatePcmuEncoder(num_channels, frame_size_ms); },
+          [=] { return std::make_unique<AudioDecoderPcmU>(num_channels); }));
+      cases.push_back(MakeCase(
+          "pcma", 8000, num_channels, frame_size_ms,
+          [=] {
+            AudioEncoderPcmA::Config config;
+            config.num_channels = num_channels;
+            config.frame_size_ms = frame_size_ms;
+            return std::make_unique<AudioEncoderPcmA>(config);
+          },
+          [=] { return std::make_unique<AudioDecoderPcmA>(num_channels); }));
+    }
+  }
+
+  for (size_t num_channels : {1, 2}) {
+    for (int frame_size_ms : {10, 20, 60}) {
+      cases.push_back(MakeCase(
+          "g722", 16000, num_channels, frame_size_ms,
+          [=] { return CreateG722Encoder(num_channels, frame_size_ms); },
+          [=]() -> std::unique_ptr<AudioDecoder> {
+            if (num_channels == 1) {
+              return std::make_unique<AudioDecoderG722Impl>();
+            }
+            return std::make_unique<AudioDecoderG722StereoImpl>();
+          }));
+    }
+  }
+
+  for (int frame_size_ms : {20, 30, 60}) {
+    cases.push_back(MakeCase(
+        "ilbc", 8000, 1, frame_size_ms,
+        [=] {
+          AudioEncoderIlbcConfig config;
+          config.frame_size_ms = frame_size_ms;
+          return std::make_unique<AudioEncoderIlbcImpl>(config, 102);
+        },
+        [] { return std::make_unique<AudioDecoderIlbcImpl>(); }));
+  }
+
+  AddIsacCases<AudioEncoderIsacFloatImpl, AudioDecoderIsacFloatImpl>(
+      "isac", &cases);
+  AddIsacCases<AudioEncoderIsacFixImpl, AudioDecoderIsacFixImpl>("isac_fix",
+                                                                 &cases);
+
+  for (int sample_rate_hz : {8000, 16000, 32000, 48000}) {
+    for (size_t num_channels : {1, 2}) {
+      cases.push_back(MakeCase(
+          "l16", sample_rate_hz, num_channels, 20,
+          [=] {
+            AudioEncoderPcm16B::Config config;
+            config.sample_rate_hz = sample_rate_hz;
+            config.num_channels = num_channels;
+            return std::make_unique<AudioEncoderPcm16B>(config);
+          },
+          [=] {
+            return std::make_unique<AudioDecoderPcm16B>(sample_rate_hz,
+                                                        num_channels);
+          }));
+    }
+  }
+
+  // Comfort noise and RED wrap a speech encoder. Their payloads are split and
+  // decoded by NetEq, so only the encoder side is measured here.
+  cases.push_back(MakeCase(
+      "cng(pcmu)", 8000, 1, 20,
+      [] {
+        AudioEncoderCngConfig config;
+        config.speech_encoder = CreatePcmuEncoder(1, 20);
+        return CreateComfortNoiseEncoder(std::move(config));
+      },
+      nullptr));
+  cases.push_back(MakeCase(
+      "cng(g722)", 16000, 1, 20,
+      [] {
+        AudioEncoderCngConfig config;
+        config.speech_encoder = CreateG722Encoder(1, 20);
+        return CreateComfortNoiseEncoder(std::move(config));
+      },
+      nullptr));
+  // RED at every depth, with the RFC 2198 headers written by the encoder, so
+  // that the cost covers the packetization too. Over PCMU the cost of the RED
+  // layer itself dominates; over Opus it is in proportion to a real codec.
+  for (size_t redundancy = 1; redundancy <= AudioEncoderCopyRed::kMaxRedundancy;
+       ++redundancy) {
+    const struct {
+      const char* name;
+      int sample_rate_hz;
+      bool opus;
+    } kSpeechCodecs[] = {{"red(pcmu)", 8000, false},
+                         {"red(opus)", 48000, true}};
+    for (const auto& speech_codec : kSpeechCodecs) {
+      const bool opus = speech_codec.opus;
+      Case red_case = MakeCase(
+          speech_codec.name, speech_codec.sample_rate_hz, 1, 20,
+          [=] {
+            AudioEncoderCopyRed::Config config;
+            config.payload_type = 63;
+            config.speech_encoder =
+                opus ? CreateOpusEncoder(1, 20, 9) : CreatePcmuEncoder(1, 20);
+            config.redundancy = redundancy;
+            config.write_red_headers = true;
+            return std::make_unique<AudioEncoderCopyRed>(std::move(config));
+          },
+          nullptr);
+      red_case.redundancy = static_cast<int>(redundancy);
+      cases.push_back(std::move(red_case));
+    }
+  }
+
+  for (size_t num_channels : {1, 2}) {
+    for (int frame_size_ms : {10, 20, 60}) {
+      for (int complexity : {0, 5, 9, 10}) {
+        Case opus_case = MakeCase(
+            "opus", 48000, num_channels, frame_size_ms,
+            [=] {
+              return CreateOpusEncoder(num_channels, frame_size_ms,
+                                       complexity);
+            },
+            [=] {
+              return std::make_unique<AudioDecoderOpusImpl>(num_channels);
+            });
+        opus_case.complexity = complexity;
+        cases.push_back(std::move(opus_case));
+      }
+    }
+  }
+  return cases;
+}
+
+// Keeps the cases whose codec, or the codec wrapped by it, is in |codecs|.
+std::vector<Case> FilterCases(std::vector<Case> cases,
+                              const std::string& codecs) {
+  if (codecs.empty()) {
+    return cases;
+  }
+  const std::vector<std::string> names = absl::StrSplit(codecs, ',');
+  std::vector<Case> filtered;
+  for (Case& benchmark_case : cases) {
+    const std::string name =
+        benchmark_case.codec.substr(0, benchmark_case.codec.find('('));
+    if (std::find(names.begin(), names.end(), name) != names.end()) {
+      filtered.push_back(std::move(benchmark_case));
+    }
+  }
+  return filtered;
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  absl::ParseCommandLine(argc, argv);
+  const std::string usage =
+      "Measures the encode and decode CPU time of all in-tree audio codecs, "
+      "on 1 to N threads with one instance per thread, and reports the "
+      "results as JSON.\n"
+      "Example usage:\n"
+      "./audio_codec_benchmark --codecs=opus,g722 --max_threads=8\n";
+  const int max_threads = absl::GetFlag(FLAGS_max_threads);
+  const int duration_ms = absl::GetFlag(FLAGS_duration_ms);
+  if (max_threads <= 0 || duration_ms <= 0 || duration_ms % 10 != 0) {
+    std::cout << usage;
+    return 1;
+  }
+
+  webrtc::test::AudioCodecBenchmark::Config config;
+  config.cases = webrtc::test::FilterCases(webrtc::test::CreateCases(),
+                                           absl::GetFlag(FLAGS_codecs));
+  if (config.cases.empty()) {
+    std::cout << usage;
+    return 1;
+  }
+  config.thread_counts.clear();
+  for (int num_threads = 1; num_threads < max_threads; num_threads *= 2) {
+    config.thread_counts.push_back(num_threads);
+  }
+  config.thread_counts.push_back(max_threads);
+  config.duration_ms = duration_ms;
+
+  const std::string json = webrtc::test::AudioCodecBenchmark::ToJson(
+      webrtc::test::AudioCodecBenchmark(config).Run());
+  const std::string output_file = absl::GetFlag(FLAGS_output);
+  if (output_file.empty()) {
+    std::cout << json << std::endl;
+  } else {
+    std::ofstream output(output_file);
+    RTC_CHECK(output.is_open()) << "Cannot open " << output_file;
+    output << json << std::endl;
+  }
+  return 0;
+}
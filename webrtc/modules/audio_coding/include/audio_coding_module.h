@@ -22,10 +22,13 @@
 #include "api/function_view.h"
 #include "api/neteq/neteq.h"
 #include "api/neteq/neteq_factory.h"
+#include "api/scoped_refptr.h"
 #include "modules/audio_coding/include/audio_coding_module_typedefs.h"
 #ifndef DISABLE_RECORDER
 #include "modules/recording/recorder.h"
 #endif
+#include "rtc_base/buffer.h"
+#include "rtc_base/ref_counted_object.h"
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
@@ -36,11 +39,29 @@ class AudioEncoder;
 class AudioFrame;
 struct RTPHeader;
 
+// An encoded payload, reference counted so that it can be passed on without
+// copying it.
+using EncodedAudioPayload = rtc::RefCountedObject<rtc::Buffer>;
+
 // Callback class used for sending data ready to be packetized
 class AudioPacketizationCallback {
  public:
   virtual ~AudioPacketizationCallback() {}
 
+  // Called by the ACM for every encoded payload. The transport may keep a
+  // reference to |payload| instead of copying it, but must not modify it: the
+  // ACM reuses the buffer for a later payload once all references to it are
+  // released. The default implementation calls SendData().
+  virtual int32_t SendEncodedData(
+      AudioFrameType frame_type,
+      uint8_t payload_type,
+      uint32_t timestamp,
+      rtc::scoped_refptr<const EncodedAudioPayload> payload,
+      int64_t absolute_capture_timestamp_ms) {
+    return SendData(frame_type, payload_type, timestamp, payload->data(),
+                    payload->size(), absolute_capture_timestamp_ms);
+  }
+
   virtual int32_t SendData(AudioFrameType frame_type,
                            uint8_t payload_type,
                            uint32_t timestamp,
@@ -75,19 +75,13 @@ void AudioMultiVector::PushBackInterleaved(
     channels_[0]->PushBack(append_this.data(), append_this.size());
     return;
   }
-  size_t length_per_channel = append_this.size() / num_channels_;
-  int16_t* temp_array = new int16_t[length_per_channel];  // Temporary storage.
+  const size_t length_per_channel = append_this.size() / num_channels_;
   for (size_t channel = 0; channel < num_channels_; ++channel) {
-    // Copy elements to |temp_array|.
-    // Set |source_ptr| to first element of this channel.
-    const int16_t* source_ptr = &append_this[channel];
-    for (size_t i = 0; i < length_per_channel; ++i) {
-      temp_array[i] = *source_ptr;
-      source_ptr += num_channels_;  // Jump to next element of this channel.
-    }
-    channels_[channel]->PushBack(temp_array, length_per_channel);
+    // De-interleave directly into the channel, starting at the first element
+    // of this channel and jumping |num_channels_| elements at a time.
+    channels_[channel]->PushBackInterleaved(&append_this[channel],
+                                            length_per_channel, num_channels_);
   }
-  delete[] temp_array;
 }
 
 void AudioMultiVector::PushBack(const AudioMultiVector& append_this) {
@@ -133,7 +127,6 @@ size_t AudioMultiVector::ReadInterleavedFromIndex(size_t start_index,
                                                   size_t length,
                                                   int16_t* destination) const {
   RTC_DCHECK(destination);
-  size_t index = 0;  // Number of elements written to |destination| so far.
   RTC_DCHECK_LE(start_index, Size());
   start_index = std::min(start_index, Size());
   if (length + start_index > Size()) {
@@ -144,13 +137,11 @@ size_t AudioMultiVector::ReadInterleavedFromIndex(size_t start_index,
     (*this)[0].CopyTo(length, start_index, destination);
     return length;
   }
-  for (size_t i = 0; i < length; ++i) {
-    for (size_t channel = 0; channel < num_channels_; ++channel) {
-      destination[index] = (*this)[channel][i + start_index];
-      ++index;
-    }
+  for (size_t channel = 0; channel < num_channels_; ++channel) {
+    (*this)[channel].CopyToInterleaved(length, start_index, num_channels_,
+                                       &destination[channel]);
   }
-  return index;
+  return length * num_channels_;
 }
 
 size_t AudioMultiVector::ReadInterleavedFromEnd(size_t length,
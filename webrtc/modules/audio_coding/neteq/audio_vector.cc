@@ -61,6 +61,31 @@ void AudioVector::CopyTo(size_t length,
   }
 }
 
+void AudioVector::CopyToInterleaved(size_t length,
+                                    size_t position,
+                                    size_t stride,
+                                    int16_t* copy_to) const {
+  RTC_DCHECK_GT(stride, 0);
+  if (length == 0)
+    return;
+  length = std::min(length, Size() - position);
+  // The wrap-around splits the requested range into at most two linear
+  // chunks, so the inner loops never need to wrap the read index.
+  const size_t copy_index = (begin_index_ + position) % capacity_;
+  const size_t first_chunk_length = std::min(length, capacity_ - copy_index);
+  const int16_t* source = &array_[copy_index];
+  for (size_t i = 0; i < first_chunk_length; ++i) {
+    *copy_to = source[i];
+    copy_to += stride;
+  }
+  const size_t remaining_length = length - first_chunk_length;
+  source = array_.get();
+  for (size_t i = 0; i < remaining_length; ++i) {
+    *copy_to = source[i];
+    copy_to += stride;
+  }
+}
+
 void AudioVector::PushFront(const AudioVector& prepend_this) {
   const size_t length = prepend_this.Size();
   if (length == 0)
@@ -138,6 +163,28 @@ void AudioVector::PushBack(const int16_t* append_this, size_t length) {
   end_index_ = (end_index_ + length) % capacity_;
 }
 
+void AudioVector::PushBackInterleaved(const int16_t* append_this,
+                                      size_t length,
+                                      size_t stride) {
+  RTC_DCHECK_GT(stride, 0);
+  if (length == 0)
+    return;
+  Reserve(Size() + length);
+  const size_t first_chunk_length = std::min(length, capacity_ - end_index_);
+  int16_t* destination = &array_[end_index_];
+  for (size_t i = 0; i < first_chunk_length; ++i) {
+    destination[i] = *append_this;
+    append_this += stride;
+  }
+  const size_t remaining_length = length - first_chunk_length;
+  destination = array_.get();
+  for (size_t i = 0; i < remaining_length; ++i) {
+    destination[i] = *append_this;
+    append_this += stride;
+  }
+  end_index_ = (end_index_ + length) % capacity_;
+}
+
 void AudioVector::PopFront(size_t length) {
   if (length == 0)
     return;
@@ -42,6 +42,14 @@ class AudioVector {
   // Copies |length| values from |position| in this vector to |copy_to|.
   virtual void CopyTo(size_t length, size_t position, int16_t* copy_to) const;
 
+  // Like CopyTo() above, but writes the values to every |stride|-th element of
+  // |copy_to|, starting with the first. Used to interleave several channels
+  // into one output array without going through operator[] for each sample.
+  void CopyToInterleaved(size_t length,
+                         size_t position,
+                         size_t stride,
+                         int16_t* copy_to) const;
+
   // Prepends the contents of AudioVector |prepend_this| to this object. The
   // length of this object is increased with the length of |prepend_this|.
   virtual void PushFront(const AudioVector& prepend_this);
@@ -62,6 +70,13 @@ class AudioVector {
   // Same as PushFront but will append to the end of this object.
   virtual void PushBack(const int16_t* append_this, size_t length);
 
+  // Appends |length| values taken from every |stride|-th element of
+  // |append_this|, starting with the first. Used to de-interleave a
+  // multi-channel array straight into the channel buffers.
+  void PushBackInterleaved(const int16_t* append_this,
+                           size_t length,
+                           size_t stride);
+
   // Removes |length| elements from the beginning of this object.
   virtual void PopFront(size_t length);
 
@@ -98,6 +98,42 @@ TEST_F(AudioVectorTest, PushBackVector) {
   }
 }
 
+// Test the PushBackInterleaved and CopyToInterleaved methods, with the
+// stored data wrapping around the end of the internal array.
+TEST_F(AudioVectorTest, PushBackAndCopyInterleaved) {
+  static const size_t kStride = 3;
+  static const size_t kLength = 10;
+  int16_t interleaved[kStride * kLength];
+  for (size_t i = 0; i < kStride * kLength; ++i) {
+    interleaved[i] = static_cast<int16_t>(i);
+  }
+  // Leave room for all the values, so that appending them does not reallocate
+  // the internal array, which would move the data back to its start. Then
+  // move the start of the data towards the end of the array, so that the
+  // appended values wrap around, with two values before the wrap.
+  AudioVector vec(2 * kLength);
+  vec.PopFront(2 * kLength - 2);
+  ASSERT_EQ(2u, vec.Size());
+  vec[0] = -1;
+  vec[1] = -2;
+  vec.PushBackInterleaved(&interleaved[1], kLength, kStride);
+  ASSERT_EQ(kLength + 2, vec.Size());
+  for (size_t i = 0; i < kLength; ++i) {
+    EXPECT_EQ(interleaved[kStride * i + 1], vec[i + 2]);
+  }
+
+  // Read the data back from before and after the wrap.
+  for (size_t position : {0, 2}) {
+    int16_t output[kStride * (kLength + 2)] = {0};
+    vec.CopyToInterleaved(kLength + 2, position, kStride, &output[2]);
+    for (size_t i = 0; i < kLength + 2 - position; ++i) {
+      EXPECT_EQ(0, output[kStride * i]);
+      EXPECT_EQ(0, output[kStride * i + 1]);
+      EXPECT_EQ(vec[i + position], output[kStride * i + 2]);
+    }
+  }
+}
+
 // Test the PushFront method.
 TEST_F(AudioVectorTest, PushFront) {
   AudioVector vec;
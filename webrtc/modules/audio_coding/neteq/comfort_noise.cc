@@ -13,9 +13,9 @@
 #include <assert.h>
 
 #include <cstdint>
-#include <memory>
 
 #include "api/array_view.h"
+#include "modules/audio_coding/codecs/cng/comfort_noise_batch.h"
 #include "modules/audio_coding/codecs/cng/webrtc_cng.h"
 #include "modules/audio_coding/neteq/audio_multi_vector.h"
 #include "modules/audio_coding/neteq/audio_vector.h"
@@ -68,16 +68,24 @@ int ComfortNoise::Generate(size_t requested_length, AudioMultiVector* output) {
     return kUnknownPayloadType;
   }
 
-  std::unique_ptr<int16_t[]> temp(new int16_t[number_of_samples]);
-  if (!cng_decoder->Generate(
-          rtc::ArrayView<int16_t>(temp.get(), number_of_samples), new_period)) {
+  // A NetEq instance generates one stream at a time; code that owns many
+  // decoders passes them to ComfortNoiseBatch together instead.
+  int16_t temp[ComfortNoiseDecoder::kMaxGenerateSamples];
+  bool generated = false;
+  if (number_of_samples <= ComfortNoiseDecoder::kMaxGenerateSamples) {
+    const ComfortNoiseBatch::Stream stream = {
+        cng_decoder, rtc::ArrayView<int16_t>(temp, number_of_samples),
+        new_period};
+    generated = ComfortNoiseBatch::Generate({&stream, 1});
+  }
+  if (!generated) {
     // Error returned.
     output->Zeros(requested_length);
     RTC_LOG(LS_ERROR)
         << "ComfortNoiseDecoder::Genererate failed to generate comfort noise";
     return kInternalError;
   }
-  (*output)[0].OverwriteAt(temp.get(), number_of_samples, 0);
+  (*output)[0].OverwriteAt(temp, number_of_samples, 0);
 
   if (first_call_) {
     // Set tapering window parameters. Values are in Q15.
@@ -0,0 +1,185 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/decode_ahead_buffer.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "modules/include/module_common_types_public.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+
+SharedEncodedAudioFrame::Frame::Frame(
+    std::unique_ptr<AudioDecoder::EncodedAudioFrame> frame)
+    : frame_(std::move(frame)) {
+  RTC_DCHECK(frame_);
+}
+
+SharedEncodedAudioFrame::Frame::~Frame() = default;
+
+SharedEncodedAudioFrame::SharedEncodedAudioFrame(
+    std::unique_ptr<AudioDecoder::EncodedAudioFrame> frame)
+    : frame_(new rtc::RefCountedObject<Frame>(std::move(frame))) {}
+
+SharedEncodedAudioFrame::SharedEncodedAudioFrame(
+    rtc::scoped_refptr<Frame> frame)
+    : frame_(std::move(frame)) {}
+
+SharedEncodedAudioFrame::~SharedEncodedAudioFrame() = default;
+
+std::unique_ptr<SharedEncodedAudioFrame> SharedEncodedAudioFrame::Share()
+    const {
+  return std::unique_ptr<SharedEncodedAudioFrame>(
+      new SharedEncodedAudioFrame(frame_));
+}
+
+size_t SharedEncodedAudioFrame::Duration() const {
+  return frame_->get()->Duration();
+}
+
+bool SharedEncodedAudioFrame::IsDtxPacket() const {
+  return frame_->get()->IsDtxPacket();
+}
+
+AudioEncoder::CodecType SharedEncodedAudioFrame::CodecType() {
+  return frame_->get()->CodecType();
+}
+
+int SharedEncodedAudioFrame::PayloadSize() {
+  return frame_->get()->PayloadSize();
+}
+
+const uint8_t* SharedEncodedAudioFrame::PayloadData() {
+  return frame_->get()->PayloadData();
+}
+
+absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult>
+SharedEncodedAudioFrame::Decode(rtc::ArrayView<int16_t> decoded) const {
+  return frame_->get()->Decode(decoded);
+}
+
+DecodeAheadBuffer::DecodeAheadBuffer(size_t max_frames,
+                                     size_t max_samples_per_frame)
+    : frames_(max_frames) {
+  RTC_DCHECK_GT(max_frames, 0);
+  for (Frame& frame : frames_) {
+    frame.audio.SetSize(max_samples_per_frame);
+  }
+}
+
+DecodeAheadBuffer::~DecodeAheadBuffer() = default;
+
+void DecodeAheadBuffer::Flush() {
+  first_ = 0;
+  num_frames_ = 0;
+  next_timestamp_ = absl::nullopt;
+}
+
+bool DecodeAheadBuffer::Empty() const {
+  return num_frames_ == 0;
+}
+
+bool DecodeAheadBuffer::Full() const {
+  return num_frames_ == frames_.size();
+}
+
+size_t DecodeAheadBuffer::NumFrames() const {
+  return num_frames_;
+}
+
+absl::optional<uint32_t> DecodeAheadBuffer::NextTimestamp() const {
+  return next_timestamp_;
+}
+
+bool DecodeAheadBuffer::DecodeAndInsert(const Packet& packet,
+                                        size_t num_channels) {
+  RTC_DCHECK(packet.frame);
+  RTC_DCHECK_GT(num_channels, 0);
+  if (Full()) {
+    return false;
+  }
+  Frame& frame = frames_[(first_ + num_frames_) % frames_.size()];
+  frame.timestamp = packet.timestamp;
+  frame.sequence_number = packet.sequence_number;
+  frame.payload_type = packet.payload_type;
+  frame.priority = packet.priority;
+  frame.result = packet.frame->Decode(frame.audio);
+  ++num_frames_;
+  const size_t num_samples =
+      frame.result ? frame.result->num_decoded_samples : 0;
+  SetNextTimestamp(packet.timestamp, num_samples / num_channels);
+  return true;
+}
+
+void DecodeAheadBuffer::OnFrameDecoded(uint32_t timestamp,
+                                       size_t samples_per_channel) {
+  RTC_DCHECK(Empty());
+  SetNextTimestamp(timestamp, samples_per_channel);
+}
+
+bool DecodeAheadBuffer::ReplacesDecodedFrame(const Packet& packet) const {
+  for (size_t i = 0; i < num_frames_; ++i) {
+    const Frame& frame = frames_[(first_ + i) % frames_.size()];
+    if (frame.timestamp == packet.timestamp) {
+      // The packet buffer keeps the packet which sorts first, see
+      // Packet::operator<().
+      if (frame.sequence_number == packet.sequence_number) {
+        return packet.priority < frame.priority;
+      }
+      return IsNewerSequenceNumber(frame.sequence_number,
+                                   packet.sequence_number);
+    }
+  }
+  return false;
+}
+
+bool DecodeAheadBuffer::Extract(
+    const Packet& packet,
+    rtc::ArrayView<int16_t> decoded,
+    absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult>* result) {
+  RTC_DCHECK(result);
+  if (Empty()) {
+    return false;
+  }
+  const Frame& frame = Front();
+  const size_t num_samples =
+      frame.result ? frame.result->num_decoded_samples : 0;
+  if (frame.timestamp != packet.timestamp ||
+      frame.sequence_number != packet.sequence_number ||
+      frame.payload_type != packet.payload_type ||
+      frame.priority != packet.priority || num_samples > decoded.size()) {
+    return false;
+  }
+  memcpy(decoded.data(), frame.audio.data(), num_samples * sizeof(int16_t));
+  *result = frame.result;
+  PopFront();
+  return true;
+}
+
+void DecodeAheadBuffer::SetNextTimestamp(uint32_t timestamp,
+                                         size_t samples_per_channel) {
+  if (samples_per_channel == 0) {
+    next_timestamp_ = absl::nullopt;
+    return;
+  }
+  next_timestamp_ = timestamp + static_cast<uint32_t>(samples_per_channel);
+}
+
+void DecodeAheadBuffer::PopFront() {
+  RTC_DCHECK(!Empty());
+  first_ = (first_ + 1) % frames_.size();
+  --num_frames_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_DECODE_AHEAD_BUFFER_H_
+#define MODULES_AUDIO_CODING_NETEQ_DECODE_AHEAD_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/audio_codecs/audio_decoder.h"
+#include "api/scoped_refptr.h"
+#include "modules/audio_coding/neteq/packet.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/ref_count.h"
+
+namespace webrtc {
+
+// An encoded frame which can be shared, so that it can be decoded ahead of
+// playout without holding the NetEq lock, even if its packet is discarded from
+// the packet buffer in the meantime. All calls are forwarded to the wrapped
+// frame.
+class SharedEncodedAudioFrame : public AudioDecoder::EncodedAudioFrame {
+ public:
+  explicit SharedEncodedAudioFrame(
+      std::unique_ptr<AudioDecoder::EncodedAudioFrame> frame);
+
+  ~SharedEncodedAudioFrame() override;
+
+  // Returns a new frame, wrapping the same frame as this one.
+  std::unique_ptr<SharedEncodedAudioFrame> Share() const;
+
+  size_t Duration() const override;
+
+  bool IsDtxPacket() const override;
+
+  AudioEncoder::CodecType CodecType() override;
+
+  int PayloadSize() override;
+
+  const uint8_t* PayloadData() override;
+
+  absl::optional<DecodeResult> Decode(
+      rtc::ArrayView<int16_t> decoded) const override;
+
+ private:
+  class Frame : public rtc::RefCountInterface {
+   public:
+    explicit Frame(std::unique_ptr<AudioDecoder::EncodedAudioFrame> frame);
+    ~Frame() override;
+
+    AudioDecoder::EncodedAudioFrame* get() const { return frame_.get(); }
+
+   private:
+    const std::unique_ptr<AudioDecoder::EncodedAudioFrame> frame_;
+  };
+
+  explicit SharedEncodedAudioFrame(rtc::scoped_refptr<Frame> frame);
+
+  const rtc::scoped_refptr<Frame> frame_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(SharedEncodedAudioFrame);
+};
+
+// This class holds audio which has been decoded ahead of playout, one entry per
+// encoded frame, in timestamp order. The frames are decoded when the packets
+// are inserted into NetEq, so that the decoding can be skipped when the
+// packets are later extracted from the packet buffer for playout. The buffer
+// only ever holds a continuous run of frames, following the last frame that
+// was decoded for playout, since the decoder state depends on the order in
+// which frames are decoded.
+class DecodeAheadBuffer {
+ public:
+  // Creates a buffer holding at most |max_frames| frames, each of at most
+  // |max_samples_per_frame| samples (all channels).
+  DecodeAheadBuffer(size_t max_frames, size_t max_samples_per_frame);
+
+  virtual ~DecodeAheadBuffer();
+
+  // Removes all frames from the buffer, and forgets where the decoder is in
+  // the stream. Decoding ahead cannot continue until a frame has been decoded
+  // for playout again, see OnFrameDecoded().
+  virtual void Flush();
+
+  virtual bool Empty() const;
+
+  virtual bool Full() const;
+
+  virtual size_t NumFrames() const;
+
+  // Returns the timestamp of the frame following the last frame decoded,
+  // ahead of playout or for playout. This is the only frame which may be
+  // decoded ahead next. Returns an empty optional if not known, e.g., after a
+  // flush, or if the last frame did not decode into any audio.
+  virtual absl::optional<uint32_t> NextTimestamp() const;
+
+  // Decodes the frame of |packet| and appends the result to the buffer. The
+  // decoder is expected to produce audio with |num_channels| channels. Returns
+  // false if the buffer is full.
+  virtual bool DecodeAndInsert(const Packet& packet, size_t num_channels);
+
+  // Must be called when a frame has been decoded for playout without being
+  // taken from the buffer, which must be empty. |samples_per_channel| is the
+  // number of samples per channel produced by the decoder.
+  virtual void OnFrameDecoded(uint32_t timestamp, size_t samples_per_channel);
+
+  // Returns true if |packet| would replace a frame which has already been
+  // decoded when inserted into the packet buffer, e.g., a primary payload
+  // replacing redundant or FEC data, or a payload with the same timestamp from
+  // an earlier packet. The buffer must then be flushed.
+  virtual bool ReplacesDecodedFrame(const Packet& packet) const;
+
+  // Looks up the decoded audio for |packet|, which is a hit only if it is the
+  // first frame in the buffer. On a hit, the samples are copied to |decoded|,
+  // the decoder result is written to |result|, the frame is removed from the
+  // buffer, and true is returned. On a miss, false is returned; if the buffer
+  // is not empty, the decoder has then decoded frames which will not be played
+  // out, e.g., because their packets were discarded, and the caller must flush
+  // the buffer and reset the decoder before decoding |packet| itself.
+  virtual bool Extract(
+      const Packet& packet,
+      rtc::ArrayView<int16_t> decoded,
+      absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult>* result);
+
+ private:
+  struct Frame {
+    uint32_t timestamp = 0;
+    uint16_t sequence_number = 0;
+    uint8_t payload_type = 0;
+    Packet::Priority priority;
+    absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult> result;
+    rtc::BufferT<int16_t> audio;
+  };
+
+  const Frame& Front() const { return frames_[first_]; }
+  void PopFront();
+  // Sets |next_timestamp_| to follow a frame decoded into
+  // |samples_per_channel| samples per channel, starting at |timestamp|.
+  void SetNextTimestamp(uint32_t timestamp, size_t samples_per_channel);
+
+  // Circular buffer of frames, with preallocated audio storage.
+  std::vector<Frame> frames_;
+  size_t first_ = 0;
+  size_t num_frames_ = 0;
+  absl::optional<uint32_t> next_timestamp_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(DecodeAheadBuffer);
+};
+
+}  // namespace webrtc
+#endif  // MODULES_AUDIO_CODING_NETEQ_DECODE_AHEAD_BUFFER_H_
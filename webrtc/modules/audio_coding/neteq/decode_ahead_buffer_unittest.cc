@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Unit tests for DecodeAheadBuffer class.
+
+#include "modules/audio_coding/neteq/decode_ahead_buffer.h"
+
+#include <memory>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+const size_t kFrameLength = 160;
+const size_t kChannels = 2;
+const uint8_t kPayloadType = 17;
+
+// Decodes into |kFrameLength| stereo samples, all set to the value given at
+// construction.
+class FakeEncodedAudioFrame : public AudioDecoder::EncodedAudioFrame {
+ public:
+  explicit FakeEncodedAudioFrame(int16_t value) : value_(value) {}
+
+  size_t Duration() const override { return kFrameLength; }
+
+  AudioEncoder::CodecType CodecType() override {
+    return AudioEncoder::CodecType::kOther;
+  }
+
+  int PayloadSize() override { return 0; }
+
+  const uint8_t* PayloadData() override { return nullptr; }
+
+  absl::optional<DecodeResult> Decode(
+      rtc::ArrayView<int16_t> decoded) const override {
+    ++num_decode_calls_;
+    if (value_ < 0) {
+      return absl::nullopt;
+    }
+    const size_t num_samples = kFrameLength * kChannels;
+    RTC_CHECK_GE(decoded.size(), num_samples);
+    for (size_t i = 0; i < num_samples; ++i) {
+      decoded[i] = value_;
+    }
+    return DecodeResult{num_samples, AudioDecoder::kSpeech};
+  }
+
+  mutable int num_decode_calls_ = 0;
+
+ private:
+  const int16_t value_;
+};
+
+Packet CreatePacket(uint32_t timestamp, int16_t value) {
+  Packet packet;
+  packet.timestamp = timestamp;
+  packet.sequence_number = static_cast<uint16_t>(value);
+  packet.payload_type = kPayloadType;
+  packet.frame.reset(new FakeEncodedAudioFrame(value));
+  return packet;
+}
+
+}  // namespace
+
+TEST(DecodeAheadBuffer, CreateAndDestroy) {
+  DecodeAheadBuffer buffer(3, kFrameLength * kChannels);
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_FALSE(buffer.Full());
+  EXPECT_EQ(0u, buffer.NumFrames());
+  EXPECT_FALSE(buffer.NextTimestamp());
+}
+
+TEST(DecodeAheadBuffer, InsertAndExtract) {
+  DecodeAheadBuffer buffer(3, kFrameLength * kChannels);
+  Packet packets[] = {CreatePacket(1000, 1),
+                      CreatePacket(1000 + kFrameLength, 2),
+                      CreatePacket(1000 + 2 * kFrameLength, 3)};
+  for (const Packet& packet : packets) {
+    EXPECT_TRUE(buffer.DecodeAndInsert(packet, kChannels));
+  }
+  EXPECT_TRUE(buffer.Full());
+  EXPECT_EQ(1000 + 3 * kFrameLength, buffer.NextTimestamp());
+  EXPECT_FALSE(buffer.DecodeAndInsert(CreatePacket(1000 + 3 * kFrameLength, 4),
+                                      kChannels));
+
+  int16_t decoded[kFrameLength * kChannels] = {0};
+  for (int i = 0; i < 3; ++i) {
+    absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult> result;
+    ASSERT_TRUE(buffer.Extract(packets[i], decoded, &result));
+    ASSERT_TRUE(result);
+    EXPECT_EQ(kFrameLength * kChannels, result->num_decoded_samples);
+    EXPECT_EQ(i + 1, decoded[0]);
+    EXPECT_EQ(i + 1, decoded[kFrameLength * kChannels - 1]);
+    // The frame was only decoded once.
+    EXPECT_EQ(1, static_cast<const FakeEncodedAudioFrame*>(
+                     packets[i].frame.get())
+                     ->num_decode_calls_);
+  }
+  EXPECT_TRUE(buffer.Empty());
+}
+
+// Frames older than the extracted packet make it a miss, since the decoder has
+// decoded frames which are not played out.
+TEST(DecodeAheadBuffer, ExtractAfterOlderFramesMisses) {
+  DecodeAheadBuffer buffer(3, kFrameLength * kChannels);
+  Packet first = CreatePacket(1000, 1);
+  Packet second = CreatePacket(1000 + kFrameLength, 2);
+  buffer.DecodeAndInsert(first, kChannels);
+  buffer.DecodeAndInsert(second, kChannels);
+
+  int16_t decoded[kFrameLength * kChannels] = {0};
+  absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult> result;
+  EXPECT_FALSE(buffer.Extract(second, decoded, &result));
+  EXPECT_EQ(2u, buffer.NumFrames());
+}
+
+// A packet which was not decoded ahead is a miss, which leaves the buffer to be
+// flushed by the caller.
+TEST(DecodeAheadBuffer, Miss) {
+  DecodeAheadBuffer buffer(3, kFrameLength * kChannels);
+  buffer.DecodeAndInsert(CreatePacket(1000 + kFrameLength, 2), kChannels);
+  buffer.DecodeAndInsert(CreatePacket(1000 + 2 * kFrameLength, 3), kChannels);
+
+  int16_t decoded[kFrameLength * kChannels] = {0};
+  absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult> result;
+  EXPECT_FALSE(buffer.Extract(CreatePacket(1000, 1), decoded, &result));
+  EXPECT_EQ(2u, buffer.NumFrames());
+
+  // Same timestamp, but another payload type.
+  Packet other_payload_type = CreatePacket(1000 + kFrameLength, 2);
+  other_payload_type.payload_type = kPayloadType + 1;
+  EXPECT_FALSE(buffer.Extract(other_payload_type, decoded, &result));
+  EXPECT_EQ(2u, buffer.NumFrames());
+
+  buffer.Flush();
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_FALSE(buffer.NextTimestamp());
+}
+
+// The next frame to decode ahead follows the last frame decoded, whether ahead
+// of playout or for playout.
+TEST(DecodeAheadBuffer, NextTimestamp) {
+  DecodeAheadBuffer buffer(3, kFrameLength * kChannels);
+  buffer.OnFrameDecoded(1000, kFrameLength);
+  EXPECT_EQ(1000 + kFrameLength, buffer.NextTimestamp());
+
+  Packet packet = CreatePacket(1000 + kFrameLength, 2);
+  buffer.DecodeAndInsert(packet, kChannels);
+  EXPECT_EQ(1000 + 2 * kFrameLength, buffer.NextTimestamp());
+
+  // Extracting the last frame does not change the position of the decoder.
+  int16_t decoded[kFrameLength * kChannels] = {0};
+  absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult> result;
+  EXPECT_TRUE(buffer.Extract(packet, decoded, &result));
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_EQ(1000 + 2 * kFrameLength, buffer.NextTimestamp());
+
+  // Nothing decoded.
+  buffer.OnFrameDecoded(1000 + 2 * kFrameLength, 0);
+  EXPECT_FALSE(buffer.NextTimestamp());
+}
+
+// A primary payload replacing a decoded FEC payload invalidates the buffer, as
+// does a payload from an earlier packet with the same timestamp, while a
+// redundant payload for an already decoded primary, or a payload from a later
+// packet, does not.
+TEST(DecodeAheadBuffer, ReplacesDecodedFrame) {
+  DecodeAheadBuffer buffer(3, kFrameLength * kChannels);
+  Packet fec = CreatePacket(1000, 1);
+  fec.priority = Packet::Priority(1, 0);
+  buffer.DecodeAndInsert(fec, kChannels);
+  buffer.DecodeAndInsert(CreatePacket(1000 + kFrameLength, 2), kChannels);
+
+  Packet redundant = CreatePacket(1000 + kFrameLength, 2);
+  redundant.priority = Packet::Priority(0, 1);
+  EXPECT_FALSE(buffer.ReplacesDecodedFrame(redundant));
+  EXPECT_FALSE(
+      buffer.ReplacesDecodedFrame(CreatePacket(1000 + 3 * kFrameLength, 4)));
+  EXPECT_TRUE(buffer.ReplacesDecodedFrame(CreatePacket(1000, 1)));
+
+  Packet later = CreatePacket(1000 + kFrameLength, 3);
+  EXPECT_FALSE(buffer.ReplacesDecodedFrame(later));
+  Packet earlier = CreatePacket(1000 + kFrameLength, 1);
+  EXPECT_TRUE(buffer.ReplacesDecodedFrame(earlier));
+}
+
+// Shared frames are decoded by the wrapped frame, which lives as long as any of
+// them.
+TEST(DecodeAheadBuffer, SharedFrame) {
+  FakeEncodedAudioFrame* frame = new FakeEncodedAudioFrame(5);
+  std::unique_ptr<SharedEncodedAudioFrame> shared(new SharedEncodedAudioFrame(
+      std::unique_ptr<AudioDecoder::EncodedAudioFrame>(frame)));
+  std::unique_ptr<SharedEncodedAudioFrame> copy = shared->Share();
+  shared.reset();
+  EXPECT_EQ(kFrameLength, copy->Duration());
+  int16_t decoded[kFrameLength * kChannels] = {0};
+  auto result = copy->Decode(decoded);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(kFrameLength * kChannels, result->num_decoded_samples);
+  EXPECT_EQ(5, decoded[0]);
+  EXPECT_EQ(1, frame->num_decode_calls_);
+}
+
+// Decoder errors are stored and handed out like any other result, but the
+// buffer cannot continue past them.
+TEST(DecodeAheadBuffer, DecodeError) {
+  DecodeAheadBuffer buffer(3, kFrameLength * kChannels);
+  Packet packet = CreatePacket(1000, -1);
+  EXPECT_TRUE(buffer.DecodeAndInsert(packet, kChannels));
+  EXPECT_FALSE(buffer.NextTimestamp());
+
+  int16_t decoded[kFrameLength * kChannels] = {0};
+  absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult> result;
+  EXPECT_TRUE(buffer.Extract(packet, decoded, &result));
+  EXPECT_FALSE(result);
+}
+
+}  // namespace webrtc
@@ -42,6 +42,7 @@ class MockPacketBuffer : public PacketBuffer {
   MOCK_CONST_METHOD2(NextHigherTimestamp,
                      int(uint32_t timestamp, uint32_t* next_timestamp));
   MOCK_CONST_METHOD0(PeekNextPacket, const Packet*());
+  MOCK_CONST_METHOD1(PeekPacket, const Packet*(uint32_t timestamp));
   MOCK_METHOD0(GetNextPacket, absl::optional<Packet>());
   MOCK_METHOD1(DiscardNextPacket, int(StatisticsCalculator* stats));
   MOCK_METHOD3(DiscardOldPackets,
@@ -11,6 +11,7 @@
 #include "modules/audio_coding/neteq/nack_tracker.h"
 
 #include <assert.h>
+#include <string.h>
 
 #include <cstdint>
 #include <utility>
@@ -35,7 +36,12 @@ NackTracker::NackTracker(int nack_threshold_packets)
       any_rtp_decoded_(false),
       sample_rate_khz_(kDefaultSampleRateKhz),
       samples_per_packet_(sample_rate_khz_ * kDefaultPacketSizeMs),
-      max_nack_list_size_(kNackListSizeLimit) {}
+      max_nack_list_size_(kNackListSizeLimit) {
+  memset(in_list_, 0, sizeof(in_list_));
+  memset(is_missing_, 0, sizeof(is_missing_));
+  memset(time_to_play_ms_, 0, sizeof(time_to_play_ms_));
+  memset(estimated_timestamp_, 0, sizeof(estimated_timestamp_));
+}
 
 NackTracker::~NackTracker() = default;
 
@@ -69,12 +75,23 @@ void NackTracker::UpdateLastReceivedPacket(uint16_t sequence_number,
     return;
 
   // Received RTP should not be in the list.
-  nack_list_.erase(sequence_number);
+  Erase(sequence_number);
 
   // If this is an old sequence number, no more action is required, return.
   if (IsNewerSequenceNumber(sequence_num_last_received_rtp_, sequence_number))
     return;
 
+  // The window is about to move forward. The slots of the sequence numbers
+  // entering it hold packets which are now too old to be in the list.
+  const uint16_t num_new_slots =
+      sequence_number - sequence_num_last_received_rtp_;
+  if (num_new_slots >= kNackWindowSize) {
+    memset(in_list_, 0, sizeof(in_list_));
+  } else {
+    for (uint16_t n = 1; n <= num_new_slots; ++n)
+      ClearSlot(Slot(sequence_num_last_received_rtp_ + n));
+  }
+
   UpdateSamplesPerPacket(sequence_number, timestamp);
 
   UpdateList(sequence_number);
@@ -106,12 +123,14 @@ void NackTracker::UpdateList(uint16_t sequence_number_current_received_rtp) {
 
 void NackTracker::ChangeFromLateToMissing(
     uint16_t sequence_number_current_received_rtp) {
-  NackList::const_iterator lower_bound =
-      nack_list_.lower_bound(static_cast<uint16_t>(
-          sequence_number_current_received_rtp - nack_threshold_packets_));
-
-  for (NackList::iterator it = nack_list_.begin(); it != lower_bound; ++it)
-    it->second.is_missing = true;
+  const uint16_t lower_bound = static_cast<uint16_t>(
+      sequence_number_current_received_rtp - nack_threshold_packets_);
+  ForEachSlot(in_list_, [this, lower_bound](size_t slot) {
+    if (!IsNewerSequenceNumber(lower_bound, SequenceNumberOfSlot(slot)))
+      return false;
+    is_missing_[slot / 64] |= uint64_t{1} << (slot % 64);
+    return true;
+  });
 }
 
 uint32_t NackTracker::EstimateTimestamp(uint16_t sequence_num) {
@@ -129,22 +148,34 @@ void NackTracker::AddToList(uint16_t sequence_number_current_received_rtp) {
   uint16_t upper_bound_missing =
       sequence_number_current_received_rtp - nack_threshold_packets_;
 
-  for (uint16_t n = sequence_num_last_received_rtp_ + 1;
+  // Packets which would be removed by LimitNackListSize() right away are not
+  // added in the first place.
+  uint16_t first = sequence_num_last_received_rtp_ + 1;
+  const uint16_t oldest_kept = sequence_number_current_received_rtp -
+                               static_cast<uint16_t>(max_nack_list_size_);
+  if (IsNewerSequenceNumber(oldest_kept, first))
+    first = oldest_kept;
+
+  for (uint16_t n = first;
        IsNewerSequenceNumber(sequence_number_current_received_rtp, n); ++n) {
     bool is_missing = IsNewerSequenceNumber(upper_bound_missing, n);
     uint32_t timestamp = EstimateTimestamp(n);
-    NackElement nack_element(TimeToPlay(timestamp), timestamp, is_missing);
-    nack_list_.insert(nack_list_.end(), std::make_pair(n, nack_element));
+    SetElement(n, TimeToPlay(timestamp), timestamp, is_missing);
   }
 }
 
 void NackTracker::UpdateEstimatedPlayoutTimeBy10ms() {
-  while (!nack_list_.empty() &&
-         nack_list_.begin()->second.time_to_play_ms <= 10)
-    nack_list_.erase(nack_list_.begin());
-
-  for (NackList::iterator it = nack_list_.begin(); it != nack_list_.end(); ++it)
-    it->second.time_to_play_ms -= 10;
+  ForEachSlot(in_list_, [this](size_t slot) {
+    if (time_to_play_ms_[slot] > 10)
+      return false;
+    ClearSlot(slot);
+    return true;
+  });
+
+  // Slots which are not in the list are updated as well; their values are
+  // overwritten before use, and the loop is left free of branches.
+  for (size_t i = 0; i < kNackWindowSize; ++i)
+    time_to_play_ms_[i] -= 10;
 }
 
 void NackTracker::UpdateLastDecodedPacket(uint16_t sequence_number,
@@ -156,13 +187,16 @@ void NackTracker::UpdateLastDecodedPacket(uint16_t sequence_number,
     // Packets in the list with sequence numbers less than the
     // sequence number of the decoded RTP should be removed from the lists.
     // They will be discarded by the jitter buffer if they arrive.
-    nack_list_.erase(nack_list_.begin(),
-                     nack_list_.upper_bound(sequence_num_last_decoded_rtp_));
-
-    // Update estimated time-to-play.
-    for (NackList::iterator it = nack_list_.begin(); it != nack_list_.end();
-         ++it)
-      it->second.time_to_play_ms = TimeToPlay(it->second.estimated_timestamp);
+    // Update estimated time-to-play for the others.
+    ForEachSlot(in_list_, [this](size_t slot) {
+      if (IsNewerSequenceNumber(SequenceNumberOfSlot(slot),
+                                sequence_num_last_decoded_rtp_)) {
+        time_to_play_ms_[slot] = TimeToPlay(estimated_timestamp_[slot]);
+      } else {
+        ClearSlot(slot);
+      }
+      return true;
+    });
   } else {
     assert(sequence_number == sequence_num_last_decoded_rtp_);
 
@@ -178,11 +212,22 @@ void NackTracker::UpdateLastDecodedPacket(uint16_t sequence_number,
 }
 
 NackTracker::NackList NackTracker::GetNackList() const {
-  return nack_list_;
+  NackList nack_list;
+  ForEachSlot(in_list_, [this, &nack_list](size_t slot) {
+    nack_list.insert(
+        nack_list.end(),
+        std::make_pair(SequenceNumberOfSlot(slot),
+                       NackElement(time_to_play_ms_[slot],
+                                   estimated_timestamp_[slot],
+                                   (is_missing_[slot / 64] >> (slot % 64)) & 1)));
+    return true;
+  });
+  return nack_list;
 }
 
 void NackTracker::Reset() {
-  nack_list_.clear();
+  memset(in_list_, 0, sizeof(in_list_));
+  memset(is_missing_, 0, sizeof(is_missing_));
 
   sequence_num_last_received_rtp_ = 0;
   timestamp_last_received_rtp_ = 0;
@@ -207,7 +252,12 @@ void NackTracker::SetMaxNackListSize(size_t max_nack_list_size) {
 void NackTracker::LimitNackListSize() {
   uint16_t limit = sequence_num_last_received_rtp_ -
                    static_cast<uint16_t>(max_nack_list_size_) - 1;
-  nack_list_.erase(nack_list_.begin(), nack_list_.upper_bound(limit));
+  ForEachSlot(in_list_, [this, limit](size_t slot) {
+    if (IsNewerSequenceNumber(SequenceNumberOfSlot(slot), limit))
+      return false;
+    ClearSlot(slot);
+    return true;
+  });
 }
 
 int64_t NackTracker::TimeToPlay(uint32_t timestamp) const {
@@ -215,17 +265,78 @@ int64_t NackTracker::TimeToPlay(uint32_t timestamp) const {
   return timestamp_increase / sample_rate_khz_;
 }
 
+void NackTracker::SetElement(uint16_t sequence_number,
+                             int64_t time_to_play_ms,
+                             uint32_t timestamp,
+                             bool is_missing) {
+  const size_t slot = Slot(sequence_number);
+  const uint64_t bit = uint64_t{1} << (slot % 64);
+  in_list_[slot / 64] |= bit;
+  if (is_missing) {
+    is_missing_[slot / 64] |= bit;
+  } else {
+    is_missing_[slot / 64] &= ~bit;
+  }
+  time_to_play_ms_[slot] = time_to_play_ms;
+  estimated_timestamp_[slot] = timestamp;
+}
+
+void NackTracker::ClearSlot(size_t slot) {
+  in_list_[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+}
+
+void NackTracker::Erase(uint16_t sequence_number) {
+  const uint16_t age = sequence_num_last_received_rtp_ - sequence_number;
+  if (age > 0 && age < kNackWindowSize)
+    ClearSlot(Slot(sequence_number));
+}
+
+template <typename Visitor>
+void NackTracker::ForEachSlot(const uint64_t* bitmap, Visitor visitor) const {
+  // The oldest sequence number which may be in the list sits in the slot
+  // after the one of |sequence_num_last_received_rtp_|. Walk the words from
+  // there, wrapping around, and visit that first word a second time for the
+  // bits below the start slot.
+  const size_t start_slot = Slot(sequence_num_last_received_rtp_ + 1);
+  const size_t start_word = start_slot / 64;
+  const uint64_t start_mask = ~uint64_t{0} << (start_slot % 64);
+  for (size_t k = 0; k <= kNumBitmapWords; ++k) {
+    const size_t word_index = (start_word + k) % kNumBitmapWords;
+    uint64_t word = bitmap[word_index];
+    if (k == 0) {
+      word &= start_mask;
+    } else if (k == kNumBitmapWords) {
+      word &= ~start_mask;
+    }
+    for (size_t slot = word_index * 64; word != 0; word >>= 1, ++slot) {
+      if ((word & 1) && !visitor(slot))
+        return;
+    }
+  }
+}
+
 // We don't erase elements with time-to-play shorter than round-trip-time.
 std::vector<uint16_t> NackTracker::GetNackList(
     int64_t round_trip_time_ms) const {
   RTC_DCHECK_GE(round_trip_time_ms, 0);
-  std::vector<uint16_t> sequence_numbers;
-  for (NackList::const_iterator it = nack_list_.begin(); it != nack_list_.end();
-       ++it) {
-    if (it->second.is_missing &&
-        it->second.time_to_play_ms > round_trip_time_ms)
-      sequence_numbers.push_back(it->first);
+  // Filter on the round-trip time for the whole window at once, one word of
+  // slots at a time, and only then walk the bits of the selected packets.
+  uint64_t selected[kNumBitmapWords];
+  for (size_t w = 0; w < kNumBitmapWords; ++w) {
+    const int64_t* time_to_play_ms = &time_to_play_ms_[w * 64];
+    uint64_t late_enough = 0;
+    for (size_t i = 0; i < 64; ++i) {
+      late_enough |= static_cast<uint64_t>(time_to_play_ms[i] >
+                                           round_trip_time_ms)
+                     << i;
+    }
+    selected[w] = in_list_[w] & is_missing_[w] & late_enough;
   }
+  std::vector<uint16_t> sequence_numbers;
+  ForEachSlot(selected, [this, &sequence_numbers](size_t slot) {
+    sequence_numbers.push_back(SequenceNumberOfSlot(slot));
+    return true;
+  });
   return sequence_numbers;
 }
 
@@ -44,6 +44,14 @@
 // its buffer and re-transmission is meaning less for old packet. Therefore, in
 // that case, after reset the sampling rate has to be updated.
 //
+// Storage
+// =======
+// The list is kept in a fixed window of |kNackWindowSize| slots indexed by the
+// low bits of the sequence number. Membership and the missing/late state are
+// kept in bitmaps, and the time-to-play estimates in arrays parallel to them,
+// so that receiving, decoding and listing packets never allocate and mostly
+// skip empty parts of the window a 64-bit word at a time.
+//
 // Thread Safety
 // =============
 // Please note that this class in not thread safe. The class must be protected
@@ -132,6 +140,17 @@ class NackTracker {
 
   typedef std::map<uint16_t, NackElement, NackListCompare> NackList;
 
+  // Number of sequence numbers covered by the window. It has to be a power of
+  // two larger than |kNackListSizeLimit|, so that every element of the list
+  // has a slot of its own.
+  static const size_t kNackWindowSize = 512;
+  static const size_t kNackWindowMask = kNackWindowSize - 1;
+  static const size_t kNumBitmapWords = kNackWindowSize / 64;
+  static_assert(kNackWindowSize > kNackListSizeLimit,
+                "The window must hold a full NACK list");
+  static_assert((kNackWindowSize & kNackWindowMask) == 0,
+                "The window size must be a power of two");
+
   // Constructor.
   explicit NackTracker(int nack_threshold_packets);
 
@@ -139,6 +158,42 @@ class NackTracker {
   // computed correctly.
   NackList GetNackList() const;
 
+  static size_t Slot(uint16_t sequence_number) {
+    return sequence_number & kNackWindowMask;
+  }
+
+  // Returns the sequence number held by |slot|. All elements of the list are
+  // older than |sequence_num_last_received_rtp_| and at most
+  // |kNackWindowSize| - 1 packets older than it.
+  uint16_t SequenceNumberOfSlot(size_t slot) const {
+    return static_cast<uint16_t>(
+        sequence_num_last_received_rtp_ -
+        ((sequence_num_last_received_rtp_ - slot) & kNackWindowMask));
+  }
+
+  bool InList(size_t slot) const {
+    return (in_list_[slot / 64] >> (slot % 64)) & 1;
+  }
+
+  // Adds the packet with |sequence_number| to the list, or updates it if it is
+  // already there.
+  void SetElement(uint16_t sequence_number,
+                  int64_t time_to_play_ms,
+                  uint32_t timestamp,
+                  bool is_missing);
+
+  // Removes the element in |slot|, if any, from the list.
+  void ClearSlot(size_t slot);
+
+  // Removes |sequence_number| from the list, if it is inside the window.
+  void Erase(uint16_t sequence_number);
+
+  // Calls |visitor(slot)| for every bit set in |bitmap|, in the order of the
+  // sequence numbers of the slots, oldest first. The iteration stops early if
+  // |visitor| returns false. |bitmap| may be modified by |visitor|.
+  template <typename Visitor>
+  void ForEachSlot(const uint64_t* bitmap, Visitor visitor) const;
+
   // Given the |sequence_number_current_received_rtp| of currently received RTP,
   // recognize packets which are not arrive and add to the list.
   void AddToList(uint16_t sequence_number_current_received_rtp);
@@ -196,10 +251,16 @@ class NackTracker {
   // packet, not only for consecutive packets.
   int samples_per_packet_;
 
-  // A list of missing packets to be retransmitted. Components of the list
-  // contain the sequence number of missing packets and the estimated time that
-  // each pack is going to be played out.
-  NackList nack_list_;
+  // A list of missing packets to be retransmitted, stored as a window of
+  // |kNackWindowSize| slots. Bit n of |in_list_| is set if slot n holds an
+  // element of the list, and bit n of |is_missing_| tells if that element is
+  // considered missing rather than late. The estimated time left until each
+  // packet is going to be played out, and its estimated timestamp, are kept in
+  // the parallel arrays. Slots which are not in the list hold stale values.
+  uint64_t in_list_[kNumBitmapWords];
+  uint64_t is_missing_[kNumBitmapWords];
+  int64_t time_to_play_ms_[kNackWindowSize];
+  uint32_t estimated_timestamp_[kNackWindowSize];
 
   // NACK list will not keep track of missing packets prior to
   // |sequence_num_last_received_rtp_| - |max_nack_list_size_|.
@@ -11,6 +11,7 @@
 #include "modules/audio_coding/neteq/neteq_impl.h"
 
 #include <assert.h>
+#include <stdio.h>
 
 #include <algorithm>
 #include <cstdint>
@@ -28,6 +29,7 @@
 #include "modules/audio_coding/neteq/background_noise.h"
 #include "modules/audio_coding/neteq/comfort_noise.h"
 #include "modules/audio_coding/neteq/decision_logic.h"
+#include "modules/audio_coding/neteq/decode_ahead_buffer.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/dtmf_buffer.h"
 #include "modules/audio_coding/neteq/dtmf_tone_generator.h"
@@ -44,6 +46,7 @@
 #include "modules/audio_coding/neteq/sync_buffer.h"
 #include "modules/audio_coding/neteq/time_stretch.h"
 #include "modules/audio_coding/neteq/timestamp_scaler.h"
+#include "modules/include/module_common_types_public.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -51,6 +54,7 @@
 #include "rtc_base/strings/audio_format_to_string.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace {
@@ -73,6 +77,27 @@ std::unique_ptr<NetEqController> CreateNetEqController(
   return controller_factory.CreateNetEqController(config);
 }
 
+// Returns the number of frames to decode ahead of playout, as configured by the
+// field trial "WebRTC-Audio-NetEqDecodeAhead/Enabled-<frames>/". Returns zero
+// if decode-ahead is disabled.
+size_t GetDecodeAheadFrames() {
+  constexpr char kDecodeAheadFieldTrial[] = "WebRTC-Audio-NetEqDecodeAhead";
+  constexpr int kMaxDecodeAheadFrames = 16;
+  if (!field_trial::IsEnabled(kDecodeAheadFieldTrial)) {
+    return 0;
+  }
+  const std::string field_trial_string =
+      field_trial::FindFullName(kDecodeAheadFieldTrial);
+  int frames = 0;
+  if (sscanf(field_trial_string.c_str(), "Enabled-%d", &frames) != 1 ||
+      frames < 1 || frames > kMaxDecodeAheadFrames) {
+    RTC_LOG(LS_WARNING) << "Invalid NetEq decode-ahead field trial: "
+                        << field_trial_string;
+    return 0;
+  }
+  return static_cast<size_t>(frames);
+}
+
 }  // namespace
 
 NetEqImpl::Dependencies::Dependencies(
@@ -144,7 +169,8 @@ NetEqImpl::NetEqImpl(const NetEq::Config& config,
                                 10,  // Report once every 10 s.
                                 tick_timer_.get()),
       no_time_stretching_(config.for_test_no_time_stretching),
-      enable_rtx_handling_(config.enable_rtx_handling) {
+      enable_rtx_handling_(config.enable_rtx_handling),
+      decode_ahead_frames_(GetDecodeAheadFrames()) {
   RTC_LOG(LS_INFO) << "NetEq config: " << config.ToString();
   int fs = config.sample_rate_hz;
   if (fs != 8000 && fs != 16000 && fs != 32000 && fs != 48000) {
@@ -175,9 +201,24 @@ int NetEqImpl::InsertPacket(const RTPHeader& rtp_header,
                             rtc::ArrayView<const uint8_t> payload) {
   rtc::MsanCheckInitialized(payload);
   TRACE_EVENT0("webrtc", "NetEqImpl::InsertPacket");
-  rtc::CritScope lock(&crit_sect_);
-  if (InsertPacketInternal(rtp_header, payload) != 0) {
-    return kFail;
+  PacketList decode_ahead_packets;
+  size_t num_channels = 0;
+  uint32_t decode_ahead_generation = 0;
+  {
+    rtc::CritScope lock(&crit_sect_);
+    rtc::CritScope decode_ahead_lock(&decode_ahead_lock_);
+    if (InsertPacketInternal(rtp_header, payload) != 0) {
+      return kFail;
+    }
+    if (decode_ahead_buffer_) {
+      GetDecodeAheadPackets(&decode_ahead_packets, &num_channels);
+      decode_ahead_generation = decode_ahead_generation_;
+    }
+  }
+  // Decode after releasing |crit_sect_|, so that GetAudio() is not blocked for
+  // longer than the decoding of a single frame.
+  if (!decode_ahead_packets.empty()) {
+    DecodeAhead(decode_ahead_packets, num_channels, decode_ahead_generation);
   }
   return kOK;
 }
@@ -243,6 +284,7 @@ int NetEqImpl::GetAudio(AudioFrame* audio_frame,
                         absl::optional<Operation> action_override) {
   TRACE_EVENT0("webrtc", "NetEqImpl::GetAudio");
   rtc::CritScope lock(&crit_sect_);
+  rtc::CritScope decode_ahead_lock(&decode_ahead_lock_);
   if (GetAudioInternal(audio_frame, muted, action_override) != 0) {
     return kFail;
   }
@@ -264,11 +306,15 @@ int NetEqImpl::GetAudio(AudioFrame* audio_frame,
 
 void NetEqImpl::SetCodecs(const std::map<int, SdpAudioFormat>& codecs) {
   rtc::CritScope lock(&crit_sect_);
+  rtc::CritScope decode_ahead_lock(&decode_ahead_lock_);
   const std::vector<int> changed_payload_types =
       decoder_database_->SetCodecs(codecs);
   for (const int pt : changed_payload_types) {
     packet_buffer_->DiscardPacketsWithPayloadType(pt, stats_.get());
   }
+  if (!changed_payload_types.empty()) {
+    FlushDecodeAheadBuffer();
+  }
 }
 
 bool NetEqImpl::RegisterPayloadType(int rtp_payload_type,
@@ -283,10 +329,12 @@ bool NetEqImpl::RegisterPayloadType(int rtp_payload_type,
 
 int NetEqImpl::RemovePayloadType(uint8_t rtp_payload_type) {
   rtc::CritScope lock(&crit_sect_);
+  rtc::CritScope decode_ahead_lock(&decode_ahead_lock_);
   int ret = decoder_database_->Remove(rtp_payload_type);
   if (ret == DecoderDatabase::kOK || ret == DecoderDatabase::kDecoderNotFound) {
     packet_buffer_->DiscardPacketsWithPayloadType(rtp_payload_type,
                                                   stats_.get());
+    FlushDecodeAheadBuffer();
     return kOK;
   }
   return kFail;
@@ -294,6 +342,8 @@ int NetEqImpl::RemovePayloadType(uint8_t rtp_payload_type) {
 
 void NetEqImpl::RemoveAllPayloadTypes() {
   rtc::CritScope lock(&crit_sect_);
+  rtc::CritScope decode_ahead_lock(&decode_ahead_lock_);
+  FlushDecodeAheadBuffer();
   decoder_database_->RemoveAll();
 }
 
@@ -363,6 +413,13 @@ NetEqLifetimeStatistics NetEqImpl::GetLifetimeStatistics() const {
   return stats_->GetLifetimeStatistics();
 }
 
+StatisticsCalculator::WaitingTimeStatistics
+NetEqImpl::GetWaitingTimeStatistics() const {
+  // |stats_| itself is never reassigned, and the waiting time statistics are
+  // published through a lock-free snapshot.
+  return stats_->GetWaitingTimeStatistics();
+}
+
 NetEqOperationsAndState NetEqImpl::GetOperationsAndState() const {
   rtc::CritScope lock(&crit_sect_);
   auto result = stats_->GetOperationsAndState();
@@ -427,8 +484,10 @@ absl::optional<NetEq::DecoderFormat> NetEqImpl::GetDecoderFormat(
 
 void NetEqImpl::FlushBuffers() {
   rtc::CritScope lock(&crit_sect_);
+  rtc::CritScope decode_ahead_lock(&decode_ahead_lock_);
   RTC_LOG(LS_VERBOSE) << "FlushBuffers";
   packet_buffer_->Flush();
+  FlushDecodeAheadBuffer();
   assert(sync_buffer_.get());
   assert(expand_.get());
   sync_buffer_->Flush();
@@ -548,6 +607,7 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
     // Flush the packet buffer and DTMF buffer.
     packet_buffer_->Flush();
     dtmf_buffer_->Flush();
+    FlushDecodeAheadBuffer();
 
     // Update audio buffer timestamp.
     sync_buffer_->IncreaseEndTimestamp(main_timestamp - timestamp_);
@@ -682,6 +742,22 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
                                      number_of_primary_packets);
   }
 
+  if (decode_ahead_buffer_) {
+    for (Packet& packet : parsed_packet_list) {
+      // Frames which have been decoded ahead from packets that are about to be
+      // replaced in the packet buffer, e.g. by a late primary payload replacing
+      // FEC, must not be played out.
+      if (decode_ahead_buffer_->ReplacesDecodedFrame(packet)) {
+        FlushDecodeAheadBuffer();
+      }
+      // Make the frame shareable, see GetDecodeAheadPackets().
+      if (packet.frame) {
+        packet.frame.reset(
+            new SharedEncodedAudioFrame(std::move(packet.frame)));
+      }
+    }
+  }
+
   // Insert packets in buffer.
   const int ret = packet_buffer_->InsertPacketList(
       &parsed_packet_list, *decoder_database_, &current_rtp_payload_type_,
@@ -690,6 +766,7 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
     // Reset DSP timestamp etc. if packet buffer flushed.
     new_codec_ = true;
     update_sample_rate_and_channels = true;
+    FlushDecodeAheadBuffer();
   } else if (ret != PacketBuffer::kOK) {
     return kOtherError;
   }
@@ -1330,6 +1407,8 @@ int NetEqImpl::Decode(PacketList* packet_list,
       bool decoder_changed;
       decoder_database_->SetActiveDecoder(payload_type, &decoder_changed);
       if (decoder_changed) {
+        // Audio decoded ahead, if any, came from the previous decoder.
+        FlushDecodeAheadBuffer();
         // We have a new decoder. Re-init some values.
         const DecoderDatabase::DecoderInfo* decoder_info =
             decoder_database_->GetDecoderInfo(payload_type);
@@ -1364,18 +1443,25 @@ int NetEqImpl::Decode(PacketList* packet_list,
     if (cng_decoder)
       cng_decoder->Reset();
 
+    // Audio decoded ahead was decoded with the state from before the reset.
+    FlushDecodeAheadBuffer();
+
     reset_decoder_ = false;
   }
 
   *decoded_length = 0;
   // Update codec-internal PLC state.
   if ((*operation == Operation::kMerge) && decoder && decoder->HasDecodePlc()) {
+    // The concealment must follow the last frame played out.
+    FlushDecodeAheadBuffer();
     decoder->DecodePlc(1, &decoded_buffer_[*decoded_length]);
   }
 
   int return_value;
   if (*operation == Operation::kCodecInternalCng) {
     RTC_DCHECK(packet_list->empty());
+    // The comfort noise must follow the last frame played out.
+    FlushDecodeAheadBuffer();
     return_value = DecodeCng(decoder, decoded_length, speech_type);
   } else {
     return_value = DecodeLoop(packet_list, *operation, decoder, decoded_length,
@@ -1478,9 +1564,21 @@ int NetEqImpl::DecodeLoop(PacketList* packet_list,
     }
 #endif
 
-    auto opt_result = packet_list->front().frame->Decode(
-        rtc::ArrayView<int16_t>(&decoded_buffer_[*decoded_length],
-                                decoded_buffer_length_ - *decoded_length));
+    const rtc::ArrayView<int16_t> decoded(
+        &decoded_buffer_[*decoded_length],
+        decoded_buffer_length_ - *decoded_length);
+    absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult> opt_result;
+    if (!decode_ahead_buffer_) {
+      opt_result = packet_list->front().frame->Decode(decoded);
+    } else if (!decode_ahead_buffer_->Extract(packet_list->front(), decoded,
+                                              &opt_result)) {
+      FlushDecodeAheadBuffer();
+      opt_result = packet_list->front().frame->Decode(decoded);
+      decode_ahead_buffer_->OnFrameDecoded(
+          packet_list->front().timestamp,
+          opt_result ? opt_result->num_decoded_samples / decoder->Channels()
+                     : 0);
+    }
     last_decoded_timestamps_.push_back(packet_list->front().timestamp);
     last_decoded_packet_infos_.push_back(
         std::move(packet_list->front().packet_info));
@@ -1519,6 +1617,101 @@ int NetEqImpl::DecodeLoop(PacketList* packet_list,
   return 0;
 }
 
+void NetEqImpl::GetDecodeAheadPackets(PacketList* packets,
+                                      size_t* num_channels) {
+  RTC_DCHECK(decode_ahead_buffer_);
+  RTC_DCHECK(packets->empty());
+  // Wait until GetAudio() has picked up a codec change or a decoder reset;
+  // until then it is not known which decoder state the next frame follows.
+  if (new_codec_ || reset_decoder_) {
+    return;
+  }
+  // After an expansion or codec-internal comfort noise, the next call to
+  // GetAudio() is likely to use the decoder for concealment or comfort noise,
+  // or for the merge, before decoding the next frame.
+  if (last_mode_ == Mode::kExpand || last_mode_ == Mode::kCodecPlc ||
+      last_mode_ == Mode::kCodecInternalCng) {
+    return;
+  }
+  AudioDecoder* decoder = decoder_database_->GetActiveDecoder();
+  if (!decoder || decoder->Channels() != sync_buffer_->Channels()) {
+    return;
+  }
+  *num_channels = decoder->Channels();
+  // The first frame to decode ahead is the one following the last frame
+  // decoded, ahead of playout or for playout.
+  absl::optional<uint32_t> next_timestamp =
+      decode_ahead_buffer_->NextTimestamp();
+  size_t num_frames = decode_ahead_buffer_->NumFrames();
+  while (next_timestamp && num_frames < decode_ahead_frames_) {
+    const Packet* packet = packet_buffer_->PeekPacket(*next_timestamp);
+    if (!packet || !packet->frame ||
+        decoder_database_->IsComfortNoise(packet->payload_type) ||
+        decoder_database_->GetDecoder(packet->payload_type) != decoder) {
+      return;
+    }
+    Packet copy;
+    copy.timestamp = packet->timestamp;
+    copy.sequence_number = packet->sequence_number;
+    copy.payload_type = packet->payload_type;
+    copy.priority = packet->priority;
+    // All frames are made shareable by InsertPacketInternal() when decoding
+    // ahead.
+    copy.frame =
+        static_cast<const SharedEncodedAudioFrame*>(packet->frame.get())
+            ->Share();
+    const size_t duration = copy.frame->Duration();
+    packets->push_back(std::move(copy));
+    ++num_frames;
+    if (duration == 0) {
+      // The timestamp of the next frame is not known until this one has been
+      // decoded.
+      return;
+    }
+    next_timestamp = *next_timestamp + static_cast<uint32_t>(duration);
+  }
+}
+
+void NetEqImpl::DecodeAhead(const PacketList& packets,
+                            size_t num_channels,
+                            uint32_t generation) {
+  for (const Packet& packet : packets) {
+    // Only take the lock for one frame at a time, so that GetAudio() does not
+    // have to wait for more than that.
+    rtc::CritScope lock(&decode_ahead_lock_);
+    if (!decode_ahead_buffer_ || generation != decode_ahead_generation_ ||
+        decode_ahead_buffer_->Full()) {
+      return;
+    }
+    const absl::optional<uint32_t> next_timestamp =
+        decode_ahead_buffer_->NextTimestamp();
+    if (!next_timestamp ||
+        IsNewerTimestamp(packet.timestamp, *next_timestamp)) {
+      return;
+    }
+    if (packet.timestamp != *next_timestamp) {
+      // Decoded for playout in the meantime.
+      continue;
+    }
+    decode_ahead_buffer_->DecodeAndInsert(packet, num_channels);
+  }
+}
+
+void NetEqImpl::FlushDecodeAheadBuffer() {
+  if (!decode_ahead_buffer_) {
+    return;
+  }
+  if (!decode_ahead_buffer_->Empty()) {
+    // The decoder state cannot be rolled back to the playout position.
+    AudioDecoder* decoder = decoder_database_->GetActiveDecoder();
+    if (decoder) {
+      decoder->Reset();
+    }
+  }
+  decode_ahead_buffer_->Flush();
+  ++decode_ahead_generation_;
+}
+
 void NetEqImpl::DoNormal(const int16_t* decoded_buffer,
                          size_t decoded_length,
                          AudioDecoder::SpeechType speech_type,
@@ -1584,6 +1777,8 @@ bool NetEqImpl::DoCodecPlc() {
       output_size_samples_ -
       (sync_buffer_->FutureLength() - expand_->overlap_length());
   concealment_audio_.Clear();
+  // The concealment must follow the last frame played out.
+  FlushDecodeAheadBuffer();
   decoder->GeneratePlc(requested_samples_per_channel, &concealment_audio_);
   if (concealment_audio_.empty()) {
     // Nothing produced. Resort to regular expand.
@@ -2119,6 +2314,13 @@ void NetEqImpl::SetSampleRateAndChannels(int fs_hz, size_t channels) {
     decoded_buffer_length_ = kMaxFrameSize * channels;
     decoded_buffer_.reset(new int16_t[decoded_buffer_length_]);
   }
+
+  // Delete decode-ahead buffer and create a new one.
+  if (decode_ahead_frames_ > 0) {
+    FlushDecodeAheadBuffer();
+    decode_ahead_buffer_.reset(
+        new DecodeAheadBuffer(decode_ahead_frames_, decoded_buffer_length_));
+  }
   RTC_CHECK(controller_) << "Unexpectedly found no NetEqController";
   controller_->SetSampleRate(fs_hz_, output_size_samples_);
 }
@@ -43,6 +43,7 @@ class Accelerate;
 class BackgroundNoise;
 class Clock;
 class ComfortNoise;
+class DecodeAheadBuffer;
 class DecoderDatabase;
 class DtmfBuffer;
 class DtmfToneGenerator;
@@ -169,6 +170,12 @@ class NetEqImpl : public webrtc::NetEq {
 
   NetEqOperationsAndState GetOperationsAndState() const override;
 
+  // Returns the lifetime packet waiting time statistics, including streaming
+  // percentile estimates. Does not take |crit_sect_|, so it can be polled at
+  // any rate without contending with GetAudio() and InsertPacket().
+  StatisticsCalculator::WaitingTimeStatistics GetWaitingTimeStatistics() const
+      RTC_NO_THREAD_SAFETY_ANALYSIS;
+
   // Enables post-decode VAD. When enabled, GetAudio() will return
   // kOutputVADPassive when the signal contains no speech.
   void EnableVad() override;
@@ -217,14 +224,14 @@ class NetEqImpl : public webrtc::NetEq {
   // TODO(hlundin): Merge this with InsertPacket above?
   int InsertPacketInternal(const RTPHeader& rtp_header,
                            rtc::ArrayView<const uint8_t> payload)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_, decode_ahead_lock_);
 
   // Delivers 10 ms of audio data. The data is written to |audio_frame|.
   // Returns 0 on success, otherwise an error code.
   int GetAudioInternal(AudioFrame* audio_frame,
                        bool* muted,
                        absl::optional<Operation> action_override)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_, decode_ahead_lock_);
 
   // Provides a decision to the GetAudioInternal method. The decision what to
   // do is written to |operation|. Packets to decode are written to
@@ -248,13 +255,34 @@ class NetEqImpl : public webrtc::NetEq {
              Operation* operation,
              int* decoded_length,
              AudioDecoder::SpeechType* speech_type)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_, decode_ahead_lock_);
+
+  // Copies the packets in |packet_buffer_| which continue the stream where the
+  // previously decoded audio ends, and belong to the active decoder, to
+  // |packets|. Their frames are shared with the packet buffer. The number of
+  // channels of the decoder is written to |num_channels|. Called after new
+  // packets have been inserted.
+  void GetDecodeAheadPackets(PacketList* packets, size_t* num_channels)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_, decode_ahead_lock_);
+
+  // Decodes |packets| from GetDecodeAheadPackets() into
+  // |decode_ahead_buffer_|, so that the decoding does not have to be done in
+  // GetAudio(). Runs without |crit_sect_|, and stops if the buffer has been
+  // flushed after |generation|, since the decoder may have been deleted then.
+  void DecodeAhead(const PacketList& packets,
+                   size_t num_channels,
+                   uint32_t generation) RTC_LOCKS_EXCLUDED(decode_ahead_lock_);
+
+  // Flushes |decode_ahead_buffer_|. If it held any frames, the active decoder
+  // has decoded past the playout position, and is reset.
+  void FlushDecodeAheadBuffer()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_, decode_ahead_lock_);
 
   // Sub-method to Decode(). Performs codec internal CNG.
   int DecodeCng(AudioDecoder* decoder,
                 int* decoded_length,
                 AudioDecoder::SpeechType* speech_type)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_, decode_ahead_lock_);
 
   // Sub-method to Decode(). Performs the actual decoding.
   int DecodeLoop(PacketList* packet_list,
@@ -262,7 +290,7 @@ class NetEqImpl : public webrtc::NetEq {
                  AudioDecoder* decoder,
                  int* decoded_length,
                  AudioDecoder::SpeechType* speech_type)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_, decode_ahead_lock_);
 
   // Sub-method which calls the Normal class to perform the normal operation.
   void DoNormal(const int16_t* decoded_buffer,
@@ -276,7 +304,8 @@ class NetEqImpl : public webrtc::NetEq {
                AudioDecoder::SpeechType speech_type,
                bool play_dtmf) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
-  bool DoCodecPlc() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+  bool DoCodecPlc()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_, decode_ahead_lock_);
 
   // Sub-method which calls the Expand class to perform the expand operation.
   int DoExpand(bool play_dtmf) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
@@ -330,7 +359,7 @@ class NetEqImpl : public webrtc::NetEq {
   // Resets various variables and objects to new values based on the sample rate
   // |fs_hz| and |channels| number audio channels.
   void SetSampleRateAndChannels(int fs_hz, size_t channels)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_, decode_ahead_lock_);
 
   // Returns the output type for the audio produced by the latest call to
   // GetAudio().
@@ -415,6 +444,17 @@ class NetEqImpl : public webrtc::NetEq {
   bool no_time_stretching_ RTC_GUARDED_BY(crit_sect_);  // Only used for test.
   rtc::BufferT<int16_t> concealment_audio_ RTC_GUARDED_BY(crit_sect_);
   const bool enable_rtx_handling_ RTC_GUARDED_BY(crit_sect_);
+  // Number of frames to decode ahead of playout. Zero disables decode-ahead.
+  const size_t decode_ahead_frames_;
+  // Serializes the use of the decoders between GetAudio() and decoding ahead,
+  // which InsertPacket() does after releasing |crit_sect_|. It must be held,
+  // after |crit_sect_| if both are taken, for anything that changes the state
+  // of a decoder or deletes one.
+  rtc::CriticalSection decode_ahead_lock_;
+  std::unique_ptr<DecodeAheadBuffer> decode_ahead_buffer_
+      RTC_GUARDED_BY(decode_ahead_lock_);
+  // Incremented each time |decode_ahead_buffer_| is flushed.
+  uint32_t decode_ahead_generation_ RTC_GUARDED_BY(decode_ahead_lock_) = 0;
 
  private:
   RTC_DISALLOW_COPY_AND_ASSIGN(NetEqImpl);
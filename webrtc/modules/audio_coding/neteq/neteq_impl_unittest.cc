@@ -10,6 +10,7 @@
 
 #include "modules/audio_coding/neteq/neteq_impl.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -36,6 +37,7 @@
 #include "rtc_base/numerics/safe_conversions.h"
 #include "system_wrappers/include/clock.h"
 #include "test/audio_decoder_proxy_factory.h"
+#include "test/field_trial.h"
 #include "test/function_audio_decoder_factory.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -50,6 +52,7 @@ using ::testing::InSequence;
 using ::testing::Invoke;
 using ::testing::IsEmpty;
 using ::testing::IsNull;
+using ::testing::Mock;
 using ::testing::Pointee;
 using ::testing::Return;
 using ::testing::ReturnNull;
@@ -1553,6 +1556,95 @@ TEST_F(NetEqImplTest, EnableRtxHandling) {
   EXPECT_EQ(NetEq::kOK, neteq_->InsertPacket(rtp_header, payload));
 }
 
+// Verifies that packets are decoded when inserted, as long as they continue
+// the stream that has been decoded for playout, and that the decoded audio is
+// then played out without decoding again.
+TEST_F(NetEqImplTest, DecodeAhead) {
+  test::ScopedFieldTrials field_trial(
+      "WebRTC-Audio-NetEqDecodeAhead/Enabled-4/");
+  UseNoMocks();
+  MockAudioDecoder mock_decoder;
+  CreateInstance(
+      new rtc::RefCountedObject<test::AudioDecoderProxyFactory>(&mock_decoder));
+
+  const uint8_t kPayloadType = 17;  // Just an arbitrary number.
+  const int kSampleRateHz = 8000;
+  const size_t kPayloadLengthSamples =
+      static_cast<size_t>(10 * kSampleRateHz / 1000);  // 10 ms.
+  const size_t kPayloadLengthBytes = 2 * kPayloadLengthSamples;
+  uint8_t payload[kPayloadLengthBytes] = {0};
+  RTPHeader rtp_header;
+  rtp_header.payloadType = kPayloadType;
+  rtp_header.sequenceNumber = 0x1234;
+  rtp_header.timestamp = 0x12345678;
+  rtp_header.ssrc = 0x87654321;
+
+  ON_CALL(mock_decoder, SampleRateHz()).WillByDefault(Return(kSampleRateHz));
+  ON_CALL(mock_decoder, Channels()).WillByDefault(Return(1));
+  ON_CALL(mock_decoder, PacketDuration(_, _))
+      .WillByDefault(Return(rtc::checked_cast<int>(kPayloadLengthSamples)));
+  // Each packet decodes into samples with the value of its first payload byte.
+  ON_CALL(mock_decoder, DecodeInternal(_, kPayloadLengthBytes, kSampleRateHz,
+                                       _, _))
+      .WillByDefault(Invoke([&](const uint8_t* encoded, size_t encoded_len,
+                                int sample_rate_hz, int16_t* decoded,
+                                AudioDecoder::SpeechType* speech_type) {
+        std::fill(decoded, decoded + kPayloadLengthSamples, encoded[0]);
+        *speech_type = AudioDecoder::kSpeech;
+        return rtc::checked_cast<int>(kPayloadLengthSamples);
+      }));
+  EXPECT_CALL(mock_decoder, SampleRateHz()).Times(AtLeast(0));
+  EXPECT_CALL(mock_decoder, Channels()).Times(AtLeast(0));
+  EXPECT_CALL(mock_decoder, PacketDuration(_, _)).Times(AtLeast(0));
+  EXPECT_TRUE(neteq_->RegisterPayloadType(kPayloadType,
+                                          SdpAudioFormat("L16", 8000, 1)));
+
+  auto insert_packet = [&](uint8_t value) {
+    payload[0] = value;
+    EXPECT_EQ(NetEq::kOK, neteq_->InsertPacket(rtp_header, payload));
+    rtp_header.sequenceNumber++;
+    rtp_header.timestamp += kPayloadLengthSamples;
+  };
+
+  // Nothing is decoded ahead of the first packet, since it is not known which
+  // decoder will be used.
+  AudioFrame output;
+  bool muted;
+  EXPECT_CALL(mock_decoder, DecodeInternal(_, _, _, _, _));
+  insert_packet(1);
+  EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+  EXPECT_EQ(1, output.data()[kPayloadLengthSamples - 1]);
+
+  // The next packets continue the stream, and are decoded on insertion.
+  EXPECT_CALL(mock_decoder, DecodeInternal(_, _, _, _, _)).Times(2);
+  insert_packet(2);
+  insert_packet(3);
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(&mock_decoder));
+
+  // Playing them out does not decode them again.
+  EXPECT_CALL(mock_decoder, DecodeInternal(_, _, _, _, _)).Times(0);
+  for (int16_t value : {2, 3}) {
+    EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+    ASSERT_EQ(kPayloadLengthSamples, output.samples_per_channel_);
+    EXPECT_EQ(AudioFrame::kNormalSpeech, output.speech_type_);
+    // The start of the frame may be mixed with the previous one.
+    EXPECT_EQ(value, output.data()[kPayloadLengthSamples - 1]);
+  }
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(&mock_decoder));
+
+  // Dropping audio decoded ahead resets the decoder, since its state is ahead
+  // of playout.
+  {
+    InSequence s;
+    EXPECT_CALL(mock_decoder, DecodeInternal(_, _, _, _, _));
+    EXPECT_CALL(mock_decoder, Reset());
+  }
+  insert_packet(4);
+  neteq_->FlushBuffers();
+
+  EXPECT_CALL(mock_decoder, Die());
+}
+
 class Decoder120ms : public AudioDecoder {
  public:
   Decoder120ms(int sample_rate_hz, SpeechType speech_type)
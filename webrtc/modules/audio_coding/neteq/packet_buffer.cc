@@ -209,6 +209,19 @@ const Packet* PacketBuffer::PeekNextPacket() const {
   return buffer_.empty() ? nullptr : &buffer_.front();
 }
 
+const Packet* PacketBuffer::PeekPacket(uint32_t timestamp) const {
+  for (const Packet& packet : buffer_) {
+    if (packet.timestamp == timestamp) {
+      return &packet;
+    }
+    if (IsNewerTimestamp(packet.timestamp, timestamp)) {
+      // The buffer is sorted on timestamp; no need to look further.
+      break;
+    }
+  }
+  return nullptr;
+}
+
 absl::optional<Packet> PacketBuffer::GetNextPacket() {
   if (Empty()) {
     // Buffer is empty.
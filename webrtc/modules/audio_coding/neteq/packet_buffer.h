@@ -87,6 +87,10 @@ class PacketBuffer {
   // NULL if the buffer is empty.
   virtual const Packet* PeekNextPacket() const;
 
+  // Returns a (constant) pointer to the packet in the buffer with timestamp
+  // |timestamp|. Returns NULL if there is no such packet.
+  virtual const Packet* PeekPacket(uint32_t timestamp) const;
+
   // Extracts the first packet in the buffer and returns it.
   // Returns an empty optional if the buffer is empty.
   virtual absl::optional<Packet> GetNextPacket();
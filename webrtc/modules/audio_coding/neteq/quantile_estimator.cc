@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/quantile_estimator.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+QuantileEstimator::QuantileEstimator(double quantile) : quantile_(quantile) {
+  RTC_DCHECK_GT(quantile, 0.0);
+  RTC_DCHECK_LT(quantile, 1.0);
+  Reset();
+}
+
+void QuantileEstimator::Reset() {
+  count_ = 0;
+  for (int i = 0; i < kNumMarkers; ++i) {
+    heights_[i] = 0.0;
+    positions_[i] = i;
+  }
+  desired_positions_[0] = 0.0;
+  desired_positions_[1] = 2.0 * quantile_;
+  desired_positions_[2] = 4.0 * quantile_;
+  desired_positions_[3] = 2.0 + 2.0 * quantile_;
+  desired_positions_[4] = 4.0;
+  desired_increments_[0] = 0.0;
+  desired_increments_[1] = quantile_ / 2.0;
+  desired_increments_[2] = quantile_;
+  desired_increments_[3] = (1.0 + quantile_) / 2.0;
+  desired_increments_[4] = 1.0;
+}
+
+void QuantileEstimator::Add(double value) {
+  if (count_ < kNumMarkers) {
+    // Insertion sort into the first |count_| heights.
+    int i = static_cast<int>(count_);
+    while (i > 0 && heights_[i - 1] > value) {
+      heights_[i] = heights_[i - 1];
+      --i;
+    }
+    heights_[i] = value;
+    ++count_;
+    return;
+  }
+  ++count_;
+
+  // Find the cell k such that heights_[k] <= value < heights_[k + 1], and
+  // extend the extreme markers if needed.
+  int k;
+  if (value < heights_[0]) {
+    heights_[0] = value;
+    k = 0;
+  } else if (value >= heights_[kNumMarkers - 1]) {
+    heights_[kNumMarkers - 1] = value;
+    k = kNumMarkers - 2;
+  } else {
+    k = 0;
+    while (value >= heights_[k + 1]) {
+      ++k;
+    }
+  }
+  for (int i = k + 1; i < kNumMarkers; ++i) {
+    ++positions_[i];
+  }
+  for (int i = 0; i < kNumMarkers; ++i) {
+    desired_positions_[i] += desired_increments_[i];
+  }
+
+  // Adjust the heights of the middle markers if they are off from their
+  // desired positions.
+  for (int i = 1; i < kNumMarkers - 1; ++i) {
+    const double d = desired_positions_[i] - positions_[i];
+    if (d >= 1.0 && positions_[i + 1] - positions_[i] > 1) {
+      AdjustMarker(i, 1);
+    } else if (d <= -1.0 && positions_[i - 1] - positions_[i] < -1) {
+      AdjustMarker(i, -1);
+    }
+  }
+}
+
+void QuantileEstimator::AdjustMarker(int i, int direction) {
+  const double d = direction;
+  const double n_prev = static_cast<double>(positions_[i - 1]);
+  const double n = static_cast<double>(positions_[i]);
+  const double n_next = static_cast<double>(positions_[i + 1]);
+  const double q_prev = heights_[i - 1];
+  const double q = heights_[i];
+  const double q_next = heights_[i + 1];
+
+  // Piecewise-parabolic prediction of the new height.
+  const double parabolic =
+      q + d / (n_next - n_prev) *
+              ((n - n_prev + d) * (q_next - q) / (n_next - n) +
+               (n_next - n - d) * (q - q_prev) / (n - n_prev));
+  if (q_prev < parabolic && parabolic < q_next) {
+    heights_[i] = parabolic;
+  } else {
+    // Fall back to linear prediction to keep the heights monotonic.
+    const int j = i + direction;
+    heights_[i] = q + d * (heights_[j] - q) /
+                          (static_cast<double>(positions_[j]) - n);
+  }
+  positions_[i] += direction;
+}
+
+absl::optional<double> QuantileEstimator::Estimate() const {
+  if (count_ == 0) {
+    return absl::nullopt;
+  }
+  if (count_ <= kNumMarkers) {
+    // Nearest-rank quantile of the samples seen so far.
+    const int rank = std::min(static_cast<int>(quantile_ * count_),
+                              static_cast<int>(count_) - 1);
+    return heights_[rank];
+  }
+  return heights_[2];
+}
+
+}  // namespace webrtc
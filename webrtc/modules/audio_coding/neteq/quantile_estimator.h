@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_QUANTILE_ESTIMATOR_H_
+#define MODULES_AUDIO_CODING_NETEQ_QUANTILE_ESTIMATOR_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+
+namespace webrtc {
+
+// Streaming estimate of a single quantile using the P-square algorithm (Jain
+// and Chlamtac, 1985). Uses constant memory and constant time per sample, and
+// the estimate is available in constant time. The estimate is exact for the
+// first five samples.
+class QuantileEstimator {
+ public:
+  // |quantile| must be in (0, 1).
+  explicit QuantileEstimator(double quantile);
+
+  void Reset();
+
+  void Add(double value);
+
+  // Returns the current estimate, or nullopt if no samples have been added.
+  absl::optional<double> Estimate() const;
+
+  int64_t count() const { return count_; }
+
+ private:
+  static constexpr int kNumMarkers = 5;
+
+  // Moves marker |i| by |direction| (+1 or -1) and updates its height.
+  void AdjustMarker(int i, int direction);
+
+  const double quantile_;
+  int64_t count_ = 0;
+  // Marker heights. Until there are five samples, these hold the samples in
+  // sorted order.
+  double heights_[kNumMarkers];
+  // Actual marker positions.
+  int64_t positions_[kNumMarkers];
+  // Desired marker positions, and how they move for each new sample.
+  double desired_positions_[kNumMarkers];
+  double desired_increments_[kNumMarkers];
+};
+
+}  // namespace webrtc
+#endif  // MODULES_AUDIO_CODING_NETEQ_QUANTILE_ESTIMATOR_H_
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/quantile_estimator.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+double ExactQuantile(std::vector<double> values, double quantile) {
+  std::sort(values.begin(), values.end());
+  return values[static_cast<size_t>(quantile * (values.size() - 1))];
+}
+
+}  // namespace
+
+TEST(QuantileEstimator, Empty) {
+  QuantileEstimator estimator(0.5);
+  EXPECT_FALSE(estimator.Estimate());
+  EXPECT_EQ(0, estimator.count());
+}
+
+TEST(QuantileEstimator, ExactForFewSamples) {
+  QuantileEstimator median(0.5);
+  median.Add(30);
+  EXPECT_EQ(30, *median.Estimate());
+  median.Add(10);
+  median.Add(20);
+  EXPECT_EQ(20, *median.Estimate());
+
+  QuantileEstimator p99(0.99);
+  for (double value : {5, 1, 4, 2, 3}) {
+    p99.Add(value);
+  }
+  EXPECT_EQ(5, *p99.Estimate());
+}
+
+TEST(QuantileEstimator, Reset) {
+  QuantileEstimator estimator(0.5);
+  for (int i = 0; i < 100; ++i) {
+    estimator.Add(i);
+  }
+  estimator.Reset();
+  EXPECT_FALSE(estimator.Estimate());
+  estimator.Add(7);
+  EXPECT_EQ(7, *estimator.Estimate());
+}
+
+TEST(QuantileEstimator, Constant) {
+  QuantileEstimator estimator(0.95);
+  for (int i = 0; i < 1000; ++i) {
+    estimator.Add(42);
+  }
+  EXPECT_EQ(42, *estimator.Estimate());
+}
+
+TEST(QuantileEstimator, UniformDistribution) {
+  Random random(4711);
+  for (double quantile : {0.5, 0.95, 0.99}) {
+    QuantileEstimator estimator(quantile);
+    std::vector<double> values;
+    for (int i = 0; i < 10000; ++i) {
+      const double value = random.Rand(0, 1000);
+      values.push_back(value);
+      estimator.Add(value);
+    }
+    EXPECT_NEAR(ExactQuantile(values, quantile), *estimator.Estimate(), 10.0)
+        << "quantile " << quantile;
+  }
+}
+
+TEST(QuantileEstimator, SkewedDistribution) {
+  // Waiting-time like distribution: mostly small values with a long tail.
+  Random random(17);
+  for (double quantile : {0.5, 0.95, 0.99}) {
+    QuantileEstimator estimator(quantile);
+    std::vector<double> values;
+    for (int i = 0; i < 10000; ++i) {
+      const double value = 20 + random.Exponential(1.0 / 40);
+      values.push_back(value);
+      estimator.Add(value);
+    }
+    const double exact = ExactQuantile(values, quantile);
+    EXPECT_NEAR(exact, *estimator.Estimate(), 0.05 * exact)
+        << "quantile " << quantile;
+  }
+}
+
+}  // namespace webrtc
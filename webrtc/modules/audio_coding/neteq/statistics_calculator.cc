@@ -107,6 +107,40 @@ int StatisticsCalculator::PeriodicUmaAverage::Metric() const {
   return counter_ == 0 ? 0 : static_cast<int>(sum_ / counter_);
 }
 
+void StatisticsCalculator::WaitingTimeSnapshot::Publish(
+    const WaitingTimeStatistics& stats) {
+  // An odd sequence number marks a write in progress.
+  const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+  sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  num_packets_.store(stats.num_packets, std::memory_order_relaxed);
+  mean_ms_.store(stats.mean_ms, std::memory_order_relaxed);
+  max_ms_.store(stats.max_ms, std::memory_order_relaxed);
+  p50_ms_.store(stats.p50_ms, std::memory_order_relaxed);
+  p95_ms_.store(stats.p95_ms, std::memory_order_relaxed);
+  p99_ms_.store(stats.p99_ms, std::memory_order_relaxed);
+  sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+StatisticsCalculator::WaitingTimeStatistics
+StatisticsCalculator::WaitingTimeSnapshot::Read() const {
+  WaitingTimeStatistics stats;
+  uint32_t sequence_before;
+  uint32_t sequence_after;
+  do {
+    sequence_before = sequence_.load(std::memory_order_acquire);
+    stats.num_packets = num_packets_.load(std::memory_order_relaxed);
+    stats.mean_ms = mean_ms_.load(std::memory_order_relaxed);
+    stats.max_ms = max_ms_.load(std::memory_order_relaxed);
+    stats.p50_ms = p50_ms_.load(std::memory_order_relaxed);
+    stats.p95_ms = p95_ms_.load(std::memory_order_relaxed);
+    stats.p99_ms = p99_ms_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    sequence_after = sequence_.load(std::memory_order_relaxed);
+  } while ((sequence_before & 1) != 0 || sequence_before != sequence_after);
+  return stats;
+}
+
 void StatisticsCalculator::PeriodicUmaAverage::Reset() {
   sum_ = 0.0;
   counter_ = 0;
@@ -123,6 +157,9 @@ StatisticsCalculator::StatisticsCalculator()
       timestamps_since_last_report_(0),
       secondary_decoded_samples_(0),
       discarded_secondary_packets_(0),
+      waiting_time_p50_(0.50),
+      waiting_time_p95_(0.95),
+      waiting_time_p99_(0.99),
       delayed_packet_outage_counter_(
           "WebRTC.Audio.DelayedPacketOutageEventsPerMinute",
           60000,  // 60 seconds report interval.
@@ -144,7 +181,8 @@ void StatisticsCalculator::Reset() {
   expanded_noise_samples_ = 0;
   secondary_decoded_samples_ = 0;
   discarded_secondary_packets_ = 0;
-  waiting_times_.clear();
+  num_waiting_times_ = 0;
+  next_waiting_time_index_ = 0;
 }
 
 void StatisticsCalculator::ResetMcu() {
@@ -312,13 +350,25 @@ void StatisticsCalculator::LogDelayedPacketOutageEvent(int num_samples,
 
 void StatisticsCalculator::StoreWaitingTime(int waiting_time_ms) {
   excess_buffer_delay_.RegisterSample(waiting_time_ms);
-  RTC_DCHECK_LE(waiting_times_.size(), kLenWaitingTimes);
-  if (waiting_times_.size() == kLenWaitingTimes) {
-    // Erase first value.
-    waiting_times_.pop_front();
-  }
-  waiting_times_.push_back(waiting_time_ms);
+  RTC_DCHECK_LE(num_waiting_times_, kLenWaitingTimes);
+  waiting_times_[next_waiting_time_index_] = waiting_time_ms;
+  next_waiting_time_index_ = (next_waiting_time_index_ + 1) % kLenWaitingTimes;
+  num_waiting_times_ = std::min(num_waiting_times_ + 1, kLenWaitingTimes);
   operations_and_state_.last_waiting_time_ms = waiting_time_ms;
+
+  waiting_time_p50_.Add(waiting_time_ms);
+  waiting_time_p95_.Add(waiting_time_ms);
+  waiting_time_p99_.Add(waiting_time_ms);
+  waiting_time_sum_ms_ += waiting_time_ms;
+  ++waiting_time_stats_.num_packets;
+  waiting_time_stats_.mean_ms = static_cast<int>(
+      waiting_time_sum_ms_ / waiting_time_stats_.num_packets);
+  waiting_time_stats_.max_ms =
+      std::max(waiting_time_stats_.max_ms, waiting_time_ms);
+  waiting_time_stats_.p50_ms = static_cast<int>(*waiting_time_p50_.Estimate());
+  waiting_time_stats_.p95_ms = static_cast<int>(*waiting_time_p95_.Estimate());
+  waiting_time_stats_.p99_ms = static_cast<int>(*waiting_time_p99_.Estimate());
+  waiting_time_snapshot_.Publish(waiting_time_stats_);
 }
 
 void StatisticsCalculator::GetNetworkStatistics(int fs_hz,
@@ -358,28 +408,35 @@ void StatisticsCalculator::GetNetworkStatistics(int fs_hz,
                         static_cast<uint32_t>(discarded_secondary_samples +
                                               secondary_decoded_samples_));
 
-  if (waiting_times_.size() == 0) {
+  if (num_waiting_times_ == 0) {
     stats->mean_waiting_time_ms = -1;
     stats->median_waiting_time_ms = -1;
     stats->min_waiting_time_ms = -1;
     stats->max_waiting_time_ms = -1;
   } else {
-    std::sort(waiting_times_.begin(), waiting_times_.end());
+    // The ring buffer is cleared below, so it can be partially reordered in
+    // place. While full, all entries are valid and the order does not matter.
+    const auto begin = waiting_times_.begin();
+    const auto end = begin + num_waiting_times_;
     // Find mid-point elements. If the size is odd, the two values
     // |middle_left| and |middle_right| will both be the one middle element; if
     // the size is even, they will be the the two neighboring elements at the
     // middle of the list.
-    const int middle_left = waiting_times_[(waiting_times_.size() - 1) / 2];
-    const int middle_right = waiting_times_[waiting_times_.size() / 2];
+    const auto middle_right = begin + num_waiting_times_ / 2;
+    std::nth_element(begin, middle_right, end);
+    const int middle_left =
+        num_waiting_times_ % 2 == 1 ? *middle_right
+                                    : *std::max_element(begin, middle_right);
     // Calculate the average of the two. (Works also for odd sizes.)
-    stats->median_waiting_time_ms = (middle_left + middle_right) / 2;
-    stats->min_waiting_time_ms = waiting_times_.front();
-    stats->max_waiting_time_ms = waiting_times_.back();
+    stats->median_waiting_time_ms = (middle_left + *middle_right) / 2;
+    const auto min_max = std::minmax_element(begin, end);
+    stats->min_waiting_time_ms = *min_max.first;
+    stats->max_waiting_time_ms = *min_max.second;
     double sum = 0;
-    for (auto time : waiting_times_) {
-      sum += time;
+    for (auto it = begin; it != end; ++it) {
+      sum += *it;
     }
-    stats->mean_waiting_time_ms = static_cast<int>(sum / waiting_times_.size());
+    stats->mean_waiting_time_ms = static_cast<int>(sum / num_waiting_times_);
   }
 
   // Reset counters.
@@ -391,6 +448,11 @@ NetEqLifetimeStatistics StatisticsCalculator::GetLifetimeStatistics() const {
   return lifetime_stats_;
 }
 
+StatisticsCalculator::WaitingTimeStatistics
+StatisticsCalculator::GetWaitingTimeStatistics() const {
+  return waiting_time_snapshot_.Read();
+}
+
 NetEqOperationsAndState StatisticsCalculator::GetOperationsAndState() const {
   return operations_and_state_;
 }
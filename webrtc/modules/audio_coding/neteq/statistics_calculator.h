@@ -11,10 +11,12 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_STATISTICS_CALCULATOR_H_
 #define MODULES_AUDIO_CODING_NETEQ_STATISTICS_CALCULATOR_H_
 
-#include <deque>
+#include <array>
+#include <atomic>
 #include <string>
 
 #include "api/neteq/neteq.h"
+#include "modules/audio_coding/neteq/quantile_estimator.h"
 #include "rtc_base/constructor_magic.h"
 
 namespace webrtc {
@@ -24,6 +26,18 @@ class DelayManager;
 // This class handles various network statistics in NetEq.
 class StatisticsCalculator {
  public:
+  // Packet waiting times over the lifetime of the object. All values are -1
+  // until the first packet has been decoded.
+  struct WaitingTimeStatistics {
+    int64_t num_packets = 0;
+    int mean_ms = -1;
+    int max_ms = -1;
+    // Streaming estimates of the 50th, 95th and 99th percentiles.
+    int p50_ms = -1;
+    int p95_ms = -1;
+    int p99_ms = -1;
+  };
+
   StatisticsCalculator();
 
   virtual ~StatisticsCalculator();
@@ -124,6 +138,11 @@ class StatisticsCalculator {
 
   NetEqOperationsAndState GetOperationsAndState() const;
 
+  // Returns the waiting time statistics. Unlike the other methods, this may be
+  // called from any thread, concurrently with the other methods; it never
+  // blocks and takes constant time.
+  WaitingTimeStatistics GetWaitingTimeStatistics() const;
+
  private:
   static const int kMaxReportPeriod = 60;  // Seconds before auto-reset.
   static const size_t kLenWaitingTimes = 100;
@@ -180,6 +199,24 @@ class StatisticsCalculator {
     int counter_ = 0;
   };
 
+  // Sequence-locked copy of WaitingTimeStatistics. There is a single writer
+  // (the thread calling StoreWaitingTime()); readers retry if they overlap
+  // with a write.
+  class WaitingTimeSnapshot {
+   public:
+    void Publish(const WaitingTimeStatistics& stats);
+    WaitingTimeStatistics Read() const;
+
+   private:
+    std::atomic<uint32_t> sequence_{0};
+    std::atomic<int64_t> num_packets_{0};
+    std::atomic<int> mean_ms_{-1};
+    std::atomic<int> max_ms_{-1};
+    std::atomic<int> p50_ms_{-1};
+    std::atomic<int> p95_ms_{-1};
+    std::atomic<int> p99_ms_{-1};
+  };
+
   // Corrects the concealed samples counter in lifetime_stats_. The value of
   // num_samples_ is added directly to the stat if the correction is positive.
   // If the correction is negative, it is cached and will be subtracted against
@@ -203,9 +240,20 @@ class StatisticsCalculator {
   size_t discarded_packets_;
   size_t lost_timestamps_;
   uint32_t timestamps_since_last_report_;
-  std::deque<int> waiting_times_;
   uint32_t secondary_decoded_samples_;
   size_t discarded_secondary_packets_;
+  // Ring buffer with the last |num_waiting_times_| waiting times, for the
+  // network statistics. The oldest entry is overwritten when it is full.
+  std::array<int, kLenWaitingTimes> waiting_times_;
+  size_t num_waiting_times_ = 0;
+  size_t next_waiting_time_index_ = 0;
+  // Lifetime waiting time statistics.
+  int64_t waiting_time_sum_ms_ = 0;
+  WaitingTimeStatistics waiting_time_stats_;
+  QuantileEstimator waiting_time_p50_;
+  QuantileEstimator waiting_time_p95_;
+  QuantileEstimator waiting_time_p99_;
+  WaitingTimeSnapshot waiting_time_snapshot_;
   PeriodicUmaCount delayed_packet_outage_counter_;
   PeriodicUmaAverage excess_buffer_delay_;
   PeriodicUmaCount buffer_full_counter_;
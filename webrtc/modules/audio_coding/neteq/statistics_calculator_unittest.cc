@@ -184,4 +184,58 @@ TEST(StatisticsCalculator, InterruptionCounterDoNotLogBeforeDecoding) {
   EXPECT_EQ(1, lts.interruption_count);
 }
 
+TEST(StatisticsCalculator, WaitingTimes) {
+  StatisticsCalculator stats;
+  NetEqNetworkStatistics network_stats;
+  stats.GetNetworkStatistics(48000, 0, 480, &network_stats);
+  EXPECT_EQ(-1, network_stats.median_waiting_time_ms);
+
+  for (int waiting_time_ms : {40, 10, 30, 20}) {
+    stats.StoreWaitingTime(waiting_time_ms);
+  }
+  stats.GetNetworkStatistics(48000, 0, 480, &network_stats);
+  EXPECT_EQ(25, network_stats.mean_waiting_time_ms);
+  EXPECT_EQ(25, network_stats.median_waiting_time_ms);
+  EXPECT_EQ(10, network_stats.min_waiting_time_ms);
+  EXPECT_EQ(40, network_stats.max_waiting_time_ms);
+
+  // Only the last 100 waiting times are used for the network statistics.
+  for (int i = 0; i < 150; ++i) {
+    stats.StoreWaitingTime(i);
+  }
+  stats.GetNetworkStatistics(48000, 0, 480, &network_stats);
+  EXPECT_EQ(99, network_stats.median_waiting_time_ms);
+  EXPECT_EQ(50, network_stats.min_waiting_time_ms);
+  EXPECT_EQ(149, network_stats.max_waiting_time_ms);
+
+  // The network statistics are reset after each call.
+  stats.StoreWaitingTime(7);
+  stats.GetNetworkStatistics(48000, 0, 480, &network_stats);
+  EXPECT_EQ(7, network_stats.median_waiting_time_ms);
+  EXPECT_EQ(7, network_stats.mean_waiting_time_ms);
+}
+
+TEST(StatisticsCalculator, LifetimeWaitingTimeStatistics) {
+  StatisticsCalculator stats;
+  auto waiting_times = stats.GetWaitingTimeStatistics();
+  EXPECT_EQ(0, waiting_times.num_packets);
+  EXPECT_EQ(-1, waiting_times.p50_ms);
+
+  // 1, 2, ..., 1000 ms in a scrambled order.
+  for (int i = 0; i < 1000; ++i) {
+    stats.StoreWaitingTime(1 + (i * 617) % 1000);
+  }
+  // Polling the network statistics does not reset the lifetime statistics.
+  NetEqNetworkStatistics network_stats;
+  stats.GetNetworkStatistics(48000, 0, 480, &network_stats);
+
+  waiting_times = stats.GetWaitingTimeStatistics();
+  EXPECT_EQ(1000, waiting_times.num_packets);
+  EXPECT_EQ(500, waiting_times.mean_ms);
+  EXPECT_EQ(1000, waiting_times.max_ms);
+  EXPECT_NEAR(500, waiting_times.p50_ms, 20);
+  EXPECT_NEAR(950, waiting_times.p95_ms, 20);
+  EXPECT_NEAR(990, waiting_times.p99_ms, 20);
+}
+
 }  // namespace webrtc
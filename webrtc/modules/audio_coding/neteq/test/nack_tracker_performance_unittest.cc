@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/audio_coding/neteq/nack_tracker.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+const int kNackThreshold = 3;
+const int kSampleRateHz = 48000;
+const uint32_t kTimestampIncrement = 960;  // 20 ms at 48 kHz.
+const int64_t kRoundTripTimeMs = 100;
+// Decoding trails the received packets by a fixed jitter buffer delay.
+const int kJitterBufferPackets = 12;
+
+// Returns the number of packets expected in the NACK list after packet |n|
+// of the trace has been sent and two 10 ms pulls have decoded packet
+// |n| - |kJitterBufferPackets|, given which packets were |received| and the
+// first and last packets received so far. A lost packet m is missing once a
+// packet more than |kNackThreshold| packets later has been received. It is
+// in the list until it is decoded, and it is returned if it plays out after
+// |kRoundTripTimeMs|, i.e., if 20 * (m - decoded) - 10 ms is larger.
+size_t ExpectedNackListSize(const std::vector<bool>& received,
+                            int first_received,
+                            int last_received,
+                            int n) {
+  const int decoded = n - kJitterBufferPackets;
+  size_t size = 0;
+  for (int m = std::max(first_received, decoded) + 1;
+       m + kNackThreshold < last_received; ++m) {
+    if (!received[m] && 20 * (m - decoded) - 10 > kRoundTripTimeMs)
+      ++size;
+  }
+  return size;
+}
+
+// Feeds a 20 ms packet stream with random losses of |loss_percent| through a
+// NackTracker, pulling 10 ms of audio and querying the NACK list as NetEq and
+// the RTCP sender would. Returns the runtime in microseconds.
+int64_t RunLossTrace(int num_packets, int loss_percent) {
+  std::unique_ptr<NackTracker> nack(NackTracker::Create(kNackThreshold));
+  nack->UpdateSampleRate(kSampleRateHz);
+  Random random(0x12345678);
+  std::vector<bool> received(num_packets);
+  for (int n = 0; n < num_packets; ++n)
+    received[n] = static_cast<int>(random.Rand(99)) >= loss_percent;
+  std::vector<size_t> list_sizes(num_packets);
+  Clock* clock = Clock::GetRealTimeClock();
+
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  uint16_t sequence_number = 0;
+  uint32_t timestamp = 0;
+  for (int n = 0; n < num_packets; ++n) {
+    if (received[n])
+      nack->UpdateLastReceivedPacket(sequence_number, timestamp);
+    if (n >= kJitterBufferPackets) {
+      const uint16_t decoded = sequence_number - kJitterBufferPackets;
+      const uint32_t decoded_timestamp =
+          timestamp - kJitterBufferPackets * kTimestampIncrement;
+      // Two 10 ms pulls per 20 ms packet.
+      nack->UpdateLastDecodedPacket(decoded, decoded_timestamp);
+      nack->UpdateLastDecodedPacket(decoded, decoded_timestamp);
+    }
+    list_sizes[n] = nack->GetNackList(kRoundTripTimeMs).size();
+    ++sequence_number;
+    timestamp += kTimestampIncrement;
+  }
+  const int64_t end_time_us = clock->TimeInMicroseconds();
+
+  // Before the first pull, the playout times are estimated relative to the
+  // first received packet instead, so the check starts after it.
+  int first_received = -1;
+  int last_received = -1;
+  size_t total_list_size = 0;
+  for (int n = 0; n < num_packets; ++n) {
+    if (received[n]) {
+      if (first_received < 0)
+        first_received = n;
+      last_received = n;
+    }
+    if (n < kJitterBufferPackets)
+      continue;
+    EXPECT_EQ(ExpectedNackListSize(received, first_received, last_received, n),
+              list_sizes[n])
+        << "after packet " << n;
+    total_list_size += list_sizes[n];
+  }
+  // The trace is long enough for every loss rate to produce NACKs.
+  EXPECT_EQ(loss_percent > 0, total_list_size > 0);
+  return end_time_us - start_time_us;
+}
+
+}  // namespace
+
+// Runs loss traces from 0% to 50% random packet loss on 20 ms packets.
+TEST(NackTrackerPerformanceTest, LossTrace) {
+  const int kNumPackets = 1000000;
+  const int kQuickNumPackets = 10000;
+  const int num_packets = field_trial::IsEnabled("WebRTC-QuickPerfTest")
+                              ? kQuickNumPackets
+                              : kNumPackets;
+  for (int loss_percent : {0, 5, 10, 20, 30, 50}) {
+    const int64_t runtime_us = RunLossTrace(num_packets, loss_percent);
+    ASSERT_GT(runtime_us, 0);
+    test::PrintResult("nack_tracker_performance", "",
+                      std::to_string(loss_percent) + "_pl",
+                      static_cast<double>(runtime_us) / num_packets,
+                      "us_per_packet", true);
+  }
+}
+
+}  // namespace webrtc
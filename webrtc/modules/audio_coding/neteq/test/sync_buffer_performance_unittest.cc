@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "api/array_view.h"
+#include "modules/audio_coding/neteq/audio_multi_vector.h"
+#include "modules/audio_coding/neteq/sync_buffer.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kSampleRateKhz = 48;
+constexpr size_t kPacketLength = 20 * kSampleRateKhz;
+constexpr size_t kOutputLength = 10 * kSampleRateKhz;
+// Same as the sync buffer of NetEqImpl.
+constexpr size_t kSyncBufferLength = 90 * kSampleRateKhz;
+
+int NumPackets() {
+  const int kNumPackets = 200000;
+  const int kQuickNumPackets = 2000;
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumPackets
+                                                        : kNumPackets;
+}
+
+// Measures the multi-channel playout path of NetEq for normal operation, as
+// for a multi-channel Opus stream: each 20 ms of decoded, interleaved audio is
+// de-interleaved into the algorithm buffer and appended to the sync buffer,
+// from which two 10 ms output frames are read out interleaved. Reports the
+// time per 20 ms packet.
+void RunAndReport(size_t num_channels) {
+  Random random_generator(42U);
+  std::vector<int16_t> decoded(kPacketLength * num_channels);
+  for (auto& sample : decoded) {
+    sample = random_generator.Rand<int16_t>();
+  }
+  AudioMultiVector algorithm_buffer(num_channels);
+  SyncBuffer sync_buffer(num_channels, kSyncBufferLength);
+  AudioFrame output;
+
+  const int num_packets = NumPackets();
+  Clock* clock = Clock::GetRealTimeClock();
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int n = 0; n < num_packets; ++n) {
+    algorithm_buffer.Clear();
+    algorithm_buffer.PushBackInterleaved(
+        rtc::ArrayView<const int16_t>(decoded.data(), decoded.size()));
+    sync_buffer.PushBack(algorithm_buffer);
+    for (size_t i = 0; i < kPacketLength / kOutputLength; ++i) {
+      sync_buffer.GetNextAudioInterleaved(kOutputLength, &output);
+      ASSERT_EQ(kOutputLength, output.samples_per_channel_);
+    }
+  }
+  const int64_t runtime_us = clock->TimeInMicroseconds() - start_time_us;
+  ASSERT_GT(runtime_us, 0);
+  test::PrintResult("sync_buffer_playout", "",
+                    std::to_string(num_channels) + "_channels",
+                    static_cast<double>(runtime_us) / num_packets,
+                    "us_per_packet", true);
+}
+
+}  // namespace
+
+// Stereo and 5.1 playout.
+TEST(SyncBufferPerformanceTest, MultiChannelPlayout) {
+  for (size_t num_channels : {2, 6}) {
+    RunAndReport(num_channels);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/impaired_neteq_input.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+// With a mean burst length of L packets, the loss state is left with
+// probability 1 / L. The entry probability is then chosen such that the
+// stationary probability of the loss state equals the requested loss rate.
+double LeaveLossProbability(const ImpairedNetEqInput::Config& config) {
+  return config.mean_burst_length > 1.0 ? 1.0 / config.mean_burst_length
+                                        : 1.0;
+}
+
+double EnterLossProbability(const ImpairedNetEqInput::Config& config) {
+  if (config.loss_rate <= 0.0) {
+    return 0.0;
+  }
+  return std::min(1.0, config.loss_rate * LeaveLossProbability(config) /
+                           (1.0 - config.loss_rate));
+}
+
+}  // namespace
+
+ImpairedNetEqInput::ImpairedNetEqInput(std::unique_ptr<NetEqInput> input,
+                                       const Config& config)
+    : input_(std::move(input)),
+      config_(config),
+      p_enter_loss_(EnterLossProbability(config)),
+      p_leave_loss_(LeaveLossProbability(config)),
+      random_(config.seed) {
+  RTC_CHECK(input_);
+  RTC_CHECK_GE(config_.loss_rate, 0.0);
+  RTC_CHECK_LT(config_.loss_rate, 1.0);
+  RTC_CHECK_GE(config_.max_jitter_ms, 0);
+  FillQueue();
+}
+
+ImpairedNetEqInput::~ImpairedNetEqInput() = default;
+
+absl::optional<int64_t> ImpairedNetEqInput::NextPacketTime() const {
+  if (queue_.empty()) {
+    return absl::nullopt;
+  }
+  return queue_.begin()->first;
+}
+
+absl::optional<int64_t> ImpairedNetEqInput::NextOutputEventTime() const {
+  return input_->NextOutputEventTime();
+}
+
+std::unique_ptr<NetEqInput::PacketData> ImpairedNetEqInput::PopPacket() {
+  if (queue_.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<PacketData> packet = std::move(queue_.begin()->second);
+  queue_.erase(queue_.begin());
+  FillQueue();
+  return packet;
+}
+
+void ImpairedNetEqInput::AdvanceOutputEvent() {
+  input_->AdvanceOutputEvent();
+}
+
+bool ImpairedNetEqInput::ended() const {
+  return queue_.empty() && input_->ended();
+}
+
+absl::optional<RTPHeader> ImpairedNetEqInput::NextHeader() const {
+  if (queue_.empty()) {
+    return absl::nullopt;
+  }
+  return queue_.begin()->second->header;
+}
+
+void ImpairedNetEqInput::FillQueue() {
+  // Jitter only ever adds delay, so no packet still in |input_| can arrive
+  // before that packet's send time.
+  while (input_->NextPacketTime() &&
+         (queue_.empty() || queue_.begin()->first > *input_->NextPacketTime())) {
+    std::unique_ptr<PacketData> packet = input_->PopPacket();
+    RTC_CHECK(packet);
+    if (DropNextPacket()) {
+      ++packets_lost_;
+      continue;
+    }
+    int64_t arrival_time_ms = packet->time_ms;
+    if (config_.max_jitter_ms > 0) {
+      arrival_time_ms += random_.Rand(0, config_.max_jitter_ms);
+    }
+    if (!config_.allow_reordering) {
+      arrival_time_ms = std::max(arrival_time_ms, last_arrival_time_ms_);
+    }
+    last_arrival_time_ms_ = arrival_time_ms;
+    packet->time_ms = arrival_time_ms;
+    // Packets with equal arrival time keep their source order, since the
+    // multimap inserts equal keys at the upper bound.
+    queue_.emplace(arrival_time_ms, std::move(packet));
+  }
+}
+
+bool ImpairedNetEqInput::DropNextPacket() {
+  if (p_enter_loss_ == 0.0) {
+    return false;
+  }
+  const double r = random_.Rand<double>();
+  if (p_leave_loss_ == 1.0) {
+    // Independent losses.
+    return r < config_.loss_rate;
+  }
+  in_loss_state_ = in_loss_state_ ? r >= p_leave_loss_ : r < p_enter_loss_;
+  return in_loss_state_;
+}
+
+}  // namespace test
+}  // namespace webrtc
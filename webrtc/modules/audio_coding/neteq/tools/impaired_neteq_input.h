@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_IMPAIRED_NETEQ_INPUT_H_
+#define MODULES_AUDIO_CODING_NETEQ_TOOLS_IMPAIRED_NETEQ_INPUT_H_
+
+#include <map>
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "modules/audio_coding/neteq/tools/neteq_input.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace test {
+
+// Wrapper class that applies a synthetic network impairment to the packets
+// of another NetEqInput object. Packets are dropped according to a
+// Gilbert-Elliott loss model and delayed by a random amount of jitter. Output
+// events are passed through unchanged.
+class ImpairedNetEqInput : public NetEqInput {
+ public:
+  struct Config {
+    // Long-term fraction of packets that are lost, in [0, 1).
+    double loss_rate = 0.0;
+    // Mean number of consecutive packets lost in a burst. A value of 1 (or
+    // less) gives independent (Bernoulli) losses.
+    double mean_burst_length = 1.0;
+    // Each packet is delayed by a uniformly distributed amount in
+    // [0, |max_jitter_ms|].
+    int max_jitter_ms = 0;
+    // If false, a packet is never delivered before the packet preceding it in
+    // the source; the jitter then only stretches the inter-arrival times.
+    bool allow_reordering = false;
+    // Seed for the random generator. Must be non-zero.
+    uint64_t seed = 1;
+  };
+
+  ImpairedNetEqInput(std::unique_ptr<NetEqInput> input, const Config& config);
+  ~ImpairedNetEqInput() override;
+
+  absl::optional<int64_t> NextPacketTime() const override;
+  absl::optional<int64_t> NextOutputEventTime() const override;
+  std::unique_ptr<PacketData> PopPacket() override;
+  void AdvanceOutputEvent() override;
+  bool ended() const override;
+  absl::optional<RTPHeader> NextHeader() const override;
+
+  // Number of packets dropped by the loss model so far.
+  int packets_lost() const { return packets_lost_; }
+
+ private:
+  // Pulls packets from |input_| until the earliest queued packet is known to
+  // arrive before any packet that has not yet been pulled.
+  void FillQueue();
+  bool DropNextPacket();
+
+  const std::unique_ptr<NetEqInput> input_;
+  const Config config_;
+  // Probabilities of entering and leaving the loss state, per packet.
+  const double p_enter_loss_;
+  const double p_leave_loss_;
+  Random random_;
+  bool in_loss_state_ = false;
+  int packets_lost_ = 0;
+  int64_t last_arrival_time_ms_ = 0;
+  // Packets that have been pulled from |input_|, keyed by arrival time.
+  std::multimap<int64_t, std::unique_ptr<PacketData>> queue_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+#endif  // MODULES_AUDIO_CODING_NETEQ_TOOLS_IMPAIRED_NETEQ_INPUT_H_
@@ -0,0 +1,183 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Unit tests for ImpairedNetEqInput class.
+
+#include "modules/audio_coding/neteq/tools/impaired_neteq_input.h"
+
+#include <utility>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+constexpr int kPacketPeriodMs = 20;
+constexpr int kOutputPeriodMs = 10;
+
+// Produces |num_packets| packets, one every 20 ms, and output events every
+// 10 ms for as long as there are packets.
+class FakeInput : public NetEqInput {
+ public:
+  explicit FakeInput(int num_packets) : num_packets_(num_packets) {}
+
+  absl::optional<int64_t> NextPacketTime() const override {
+    if (next_packet_ >= num_packets_) {
+      return absl::nullopt;
+    }
+    return next_packet_ * kPacketPeriodMs;
+  }
+
+  absl::optional<int64_t> NextOutputEventTime() const override {
+    if (ended()) {
+      return absl::nullopt;
+    }
+    return next_output_ms_;
+  }
+
+  std::unique_ptr<PacketData> PopPacket() override {
+    if (next_packet_ >= num_packets_) {
+      return nullptr;
+    }
+    auto packet = std::make_unique<PacketData>();
+    packet->header = *NextHeader();
+    packet->time_ms = *NextPacketTime();
+    packet->payload.SetSize(10);
+    ++next_packet_;
+    return packet;
+  }
+
+  void AdvanceOutputEvent() override { next_output_ms_ += kOutputPeriodMs; }
+
+  bool ended() const override {
+    return next_output_ms_ > num_packets_ * kPacketPeriodMs;
+  }
+
+  absl::optional<RTPHeader> NextHeader() const override {
+    if (next_packet_ >= num_packets_) {
+      return absl::nullopt;
+    }
+    RTPHeader header;
+    header.sequenceNumber = static_cast<uint16_t>(next_packet_);
+    header.timestamp = next_packet_ * 160;
+    return header;
+  }
+
+ private:
+  const int num_packets_;
+  int next_packet_ = 0;
+  int64_t next_output_ms_ = 0;
+};
+
+// Pops all packets and returns them in delivery order.
+std::vector<std::unique_ptr<NetEqInput::PacketData>> PopAll(
+    NetEqInput* input) {
+  std::vector<std::unique_ptr<NetEqInput::PacketData>> packets;
+  while (input->NextPacketTime()) {
+    const int64_t expected_time_ms = *input->NextPacketTime();
+    const uint16_t expected_seq_no = input->NextHeader()->sequenceNumber;
+    packets.push_back(input->PopPacket());
+    EXPECT_EQ(expected_time_ms, packets.back()->time_ms);
+    EXPECT_EQ(expected_seq_no, packets.back()->header.sequenceNumber);
+  }
+  return packets;
+}
+
+}  // namespace
+
+TEST(ImpairedNetEqInput, NoImpairment) {
+  ImpairedNetEqInput input(std::make_unique<FakeInput>(100),
+                           ImpairedNetEqInput::Config());
+  auto packets = PopAll(&input);
+  ASSERT_EQ(100u, packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(i, packets[i]->header.sequenceNumber);
+    EXPECT_EQ(static_cast<int64_t>(i * kPacketPeriodMs), packets[i]->time_ms);
+  }
+  EXPECT_EQ(0, input.packets_lost());
+  EXPECT_EQ(0, *input.NextOutputEventTime());
+  input.AdvanceOutputEvent();
+  EXPECT_EQ(kOutputPeriodMs, *input.NextOutputEventTime());
+}
+
+TEST(ImpairedNetEqInput, IndependentLoss) {
+  constexpr int kNumPackets = 20000;
+  ImpairedNetEqInput::Config config;
+  config.loss_rate = 0.1;
+  ImpairedNetEqInput input(std::make_unique<FakeInput>(kNumPackets), config);
+  auto packets = PopAll(&input);
+  EXPECT_EQ(kNumPackets, static_cast<int>(packets.size()) +
+                             input.packets_lost());
+  EXPECT_NEAR(0.1, static_cast<double>(input.packets_lost()) / kNumPackets,
+              0.01);
+}
+
+TEST(ImpairedNetEqInput, BurstLoss) {
+  constexpr int kNumPackets = 50000;
+  ImpairedNetEqInput::Config config;
+  config.loss_rate = 0.1;
+  config.mean_burst_length = 4.0;
+  ImpairedNetEqInput input(std::make_unique<FakeInput>(kNumPackets), config);
+  auto packets = PopAll(&input);
+  EXPECT_NEAR(0.1, static_cast<double>(input.packets_lost()) / kNumPackets,
+              0.02);
+  // Count the loss bursts from the gaps in the sequence numbers.
+  int bursts = 0;
+  int expected_seq_no = 0;
+  for (const auto& packet : packets) {
+    if (packet->header.sequenceNumber != (expected_seq_no & 0xFFFF)) {
+      ++bursts;
+    }
+    expected_seq_no += static_cast<uint16_t>(packet->header.sequenceNumber -
+                                             expected_seq_no) +
+                       1;
+  }
+  ASSERT_GT(bursts, 0);
+  EXPECT_NEAR(4.0, static_cast<double>(input.packets_lost()) / bursts, 0.5);
+}
+
+TEST(ImpairedNetEqInput, JitterWithoutReordering) {
+  ImpairedNetEqInput::Config config;
+  config.max_jitter_ms = 60;
+  ImpairedNetEqInput input(std::make_unique<FakeInput>(1000), config);
+  auto packets = PopAll(&input);
+  ASSERT_EQ(1000u, packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(i, packets[i]->header.sequenceNumber);
+    EXPECT_GE(packets[i]->time_ms, static_cast<int64_t>(i * kPacketPeriodMs));
+    if (i > 0) {
+      EXPECT_GE(packets[i]->time_ms, packets[i - 1]->time_ms);
+    }
+  }
+}
+
+TEST(ImpairedNetEqInput, JitterWithReordering) {
+  ImpairedNetEqInput::Config config;
+  config.max_jitter_ms = 60;
+  config.allow_reordering = true;
+  ImpairedNetEqInput input(std::make_unique<FakeInput>(1000), config);
+  auto packets = PopAll(&input);
+  ASSERT_EQ(1000u, packets.size());
+  int reordered = 0;
+  for (size_t i = 1; i < packets.size(); ++i) {
+    // Delivery is always in arrival order.
+    EXPECT_GE(packets[i]->time_ms, packets[i - 1]->time_ms);
+    if (packets[i]->header.sequenceNumber <
+        packets[i - 1]->header.sequenceNumber) {
+      ++reordered;
+    }
+  }
+  EXPECT_GT(reordered, 0);
+}
+
+}  // namespace test
+}  // namespace webrtc
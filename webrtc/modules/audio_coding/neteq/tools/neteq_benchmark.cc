@@ -0,0 +1,516 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/neteq_benchmark.h"
+
+#include <stdio.h>
+#if defined(WEBRTC_LINUX)
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "modules/audio_coding/neteq/default_neteq_factory.h"
+#include "modules/audio_coding/neteq/neteq_impl.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/strings/json.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+using Category = NetEqBenchmark::Category;
+
+constexpr int kOutputBlockMs = 10;
+
+// Returns the resident set size of the process, or zero if it cannot be read.
+int64_t ResidentSetSizeBytes() {
+#if defined(WEBRTC_LINUX)
+  FILE* file = fopen("/proc/self/statm", "r");
+  if (!file) {
+    return 0;
+  }
+  long total_pages = 0;
+  long resident_pages = 0;
+  const int read = fscanf(file, "%ld %ld", &total_pages, &resident_pages);
+  fclose(file);
+  if (read != 2) {
+    return 0;
+  }
+  return static_cast<int64_t>(resident_pages) * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+Category CategoryFromOperation(NetEq::Operation operation) {
+  switch (operation) {
+    case NetEq::Operation::kNormal:
+      return Category::kNormal;
+    case NetEq::Operation::kMerge:
+      return Category::kMerge;
+    case NetEq::Operation::kExpand:
+      return Category::kExpand;
+    case NetEq::Operation::kAccelerate:
+    case NetEq::Operation::kFastAccelerate:
+      return Category::kAccelerate;
+    case NetEq::Operation::kPreemptiveExpand:
+      return Category::kPreemptiveExpand;
+    case NetEq::Operation::kRfc3389Cng:
+    case NetEq::Operation::kRfc3389CngNoPacket:
+    case NetEq::Operation::kCodecInternalCng:
+      return Category::kComfortNoise;
+    default:
+      return Category::kOther;
+  }
+}
+
+// Forwards to another frame, and adds the CPU time spent in Decode() to
+// |*decode_time_ns|.
+class TimingEncodedAudioFrame : public AudioDecoder::EncodedAudioFrame {
+ public:
+  TimingEncodedAudioFrame(std::unique_ptr<EncodedAudioFrame> frame,
+                          int64_t* decode_time_ns,
+                          int64_t* decode_calls)
+      : frame_(std::move(frame)),
+        decode_time_ns_(decode_time_ns),
+        decode_calls_(decode_calls) {}
+
+  size_t Duration() const override { return frame_->Duration(); }
+  bool IsDtxPacket() const override { return frame_->IsDtxPacket(); }
+  AudioEncoder::CodecType CodecType() override { return frame_->CodecType(); }
+  int PayloadSize() override { return frame_->PayloadSize(); }
+  const uint8_t* PayloadData() override { return frame_->PayloadData(); }
+
+  absl::optional<DecodeResult> Decode(
+      rtc::ArrayView<int16_t> decoded) const override {
+    const int64_t start_ns = rtc::GetThreadCpuTimeNanos();
+    auto result = frame_->Decode(decoded);
+    *decode_time_ns_ += rtc::GetThreadCpuTimeNanos() - start_ns;
+    ++*decode_calls_;
+    return result;
+  }
+
+ private:
+  const std::unique_ptr<EncodedAudioFrame> frame_;
+  int64_t* const decode_time_ns_;
+  int64_t* const decode_calls_;
+};
+
+// Wraps an AudioDecoder such that all frames it parses are timed. Codec
+// internal PLC is not timed here; it is part of the expand operation.
+class TimingAudioDecoder : public AudioDecoder {
+ public:
+  TimingAudioDecoder(std::unique_ptr<AudioDecoder> decoder,
+                     int64_t* decode_time_ns,
+                     int64_t* decode_calls)
+      : decoder_(std::move(decoder)),
+        decode_time_ns_(decode_time_ns),
+        decode_calls_(decode_calls) {}
+
+  std::vector<ParseResult> ParsePayload(rtc::Buffer&& payload,
+                                        uint32_t timestamp) override {
+    std::vector<ParseResult> results =
+        decoder_->ParsePayload(std::move(payload), timestamp);
+    for (ParseResult& result : results) {
+      result.frame = std::make_unique<TimingEncodedAudioFrame>(
+          std::move(result.frame), decode_time_ns_, decode_calls_);
+    }
+    return results;
+  }
+
+  bool HasDecodePlc() const override { return decoder_->HasDecodePlc(); }
+  size_t DecodePlc(size_t num_frames, int16_t* decoded) override {
+    return decoder_->DecodePlc(num_frames, decoded);
+  }
+  void GeneratePlc(size_t requested_samples_per_channel,
+                   rtc::BufferT<int16_t>* concealment_audio) override {
+    decoder_->GeneratePlc(requested_samples_per_channel, concealment_audio);
+  }
+  void Reset() override { decoder_->Reset(); }
+  int ErrorCode() override { return decoder_->ErrorCode(); }
+  int PacketDuration(const uint8_t* encoded,
+                     size_t encoded_len) const override {
+    return decoder_->PacketDuration(encoded, encoded_len);
+  }
+  int PacketDurationRedundant(const uint8_t* encoded,
+                              size_t encoded_len) const override {
+    return decoder_->PacketDurationRedundant(encoded, encoded_len);
+  }
+  bool PacketHasFec(const uint8_t* encoded,
+                    size_t encoded_len) const override {
+    return decoder_->PacketHasFec(encoded, encoded_len);
+  }
+  int SampleRateHz() const override { return decoder_->SampleRateHz(); }
+  size_t Channels() const override { return decoder_->Channels(); }
+  AudioEncoder::CodecType CodecType() override {
+    return decoder_->CodecType();
+  }
+
+ protected:
+  int DecodeInternal(const uint8_t* encoded,
+                     size_t encoded_len,
+                     int sample_rate_hz,
+                     int16_t* decoded,
+                     SpeechType* speech_type) override {
+    // NetEq only decodes through ParsePayload(); this is for completeness.
+    const int duration = decoder_->PacketDuration(encoded, encoded_len);
+    const size_t max_decoded_bytes =
+        duration > 0 ? duration * Channels() * sizeof(int16_t)
+                     : std::numeric_limits<size_t>::max();
+    return decoder_->Decode(encoded, encoded_len, sample_rate_hz,
+                            max_decoded_bytes, decoded, speech_type);
+  }
+
+ private:
+  const std::unique_ptr<AudioDecoder> decoder_;
+  int64_t* const decode_time_ns_;
+  int64_t* const decode_calls_;
+};
+
+class TimingAudioDecoderFactory : public AudioDecoderFactory {
+ public:
+  TimingAudioDecoderFactory(rtc::scoped_refptr<AudioDecoderFactory> factory,
+                            int64_t* decode_time_ns,
+                            int64_t* decode_calls)
+      : factory_(std::move(factory)),
+        decode_time_ns_(decode_time_ns),
+        decode_calls_(decode_calls) {}
+
+  std::vector<AudioCodecSpec> GetSupportedDecoders() override {
+    return factory_->GetSupportedDecoders();
+  }
+  bool IsSupportedDecoder(const SdpAudioFormat& format) override {
+    return factory_->IsSupportedDecoder(format);
+  }
+  std::unique_ptr<AudioDecoder> MakeAudioDecoder(
+      const SdpAudioFormat& format,
+      absl::optional<AudioCodecPairId> codec_pair_id) override {
+    std::unique_ptr<AudioDecoder> decoder =
+        factory_->MakeAudioDecoder(format, codec_pair_id);
+    if (!decoder) {
+      return nullptr;
+    }
+    return std::make_unique<TimingAudioDecoder>(std::move(decoder),
+                                                decode_time_ns_, decode_calls_);
+  }
+
+ private:
+  const rtc::scoped_refptr<AudioDecoderFactory> factory_;
+  int64_t* const decode_time_ns_;
+  int64_t* const decode_calls_;
+};
+
+// One simulated receive stream. All methods are called on the thread of the
+// shard owning the instance.
+class Instance {
+ public:
+  Instance(const NetEqBenchmark::Config& config, int index)
+      : clock_(0),
+        decoder_factory_(new rtc::RefCountedObject<TimingAudioDecoderFactory>(
+            config.decoder_factory,
+            &decode_time_ns_,
+            &decode_calls_)),
+        input_(config.input_factory(index)) {
+    RTC_CHECK(input_);
+    // DefaultNetEqFactory always creates a NetEqImpl, which is needed for
+    // last_operation_for_test().
+    neteq_ = DefaultNetEqFactory().CreateNetEq(config.neteq_config,
+                                               decoder_factory_, &clock_);
+    for (const auto& codec : config.codecs) {
+      RTC_CHECK(neteq_->RegisterPayloadType(codec.first, codec.second));
+    }
+    if (input_->NextEventTime()) {
+      time_now_ms_ = *input_->NextEventTime();
+      clock_.AdvanceTimeMilliseconds(time_now_ms_);
+    }
+  }
+
+  // Processes input events up to and including the next output event. Returns
+  // false once the input has ended.
+  bool Step(NetEqBenchmark::Result* result) {
+    while (!input_->ended()) {
+      const absl::optional<int64_t> next_event_ms = input_->NextEventTime();
+      if (!next_event_ms) {
+        return false;
+      }
+      clock_.AdvanceTimeMilliseconds(*next_event_ms - time_now_ms_);
+      time_now_ms_ = *next_event_ms;
+      if (input_->NextPacketTime() &&
+          time_now_ms_ >= *input_->NextPacketTime()) {
+        InsertPacket(result);
+      }
+      if (input_->NextOutputEventTime() &&
+          time_now_ms_ >= *input_->NextOutputEventTime()) {
+        GetAudio(result);
+        input_->AdvanceOutputEvent();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Moves the decode time gathered so far into |result|.
+  void CollectDecodeTime(NetEqBenchmark::Result* result) {
+    NetEqBenchmark::CpuStats& stats =
+        result->cpu[static_cast<size_t>(Category::kDecode)];
+    stats.cpu_time_ns += decode_time_ns_;
+    stats.count += decode_calls_;
+    decode_time_ns_ = 0;
+    decode_calls_ = 0;
+  }
+
+ private:
+  void InsertPacket(NetEqBenchmark::Result* result) {
+    std::unique_ptr<NetEqInput::PacketData> packet = input_->PopPacket();
+    RTC_CHECK(packet);
+    const size_t payload_length =
+        packet->payload.size() - packet->header.paddingLength;
+    // With decode-ahead enabled, decoding may happen here; that part is
+    // accounted as decode time.
+    const int64_t decode_before_ns = decode_time_ns_;
+    const int64_t start_ns = rtc::GetThreadCpuTimeNanos();
+    if (payload_length != 0) {
+      if (neteq_->InsertPacket(
+              packet->header,
+              rtc::ArrayView<const uint8_t>(packet->payload)) !=
+          NetEq::kOK) {
+        ++result->insert_errors;
+      }
+    } else {
+      neteq_->InsertEmptyPacket(packet->header);
+    }
+    const int64_t elapsed_ns = rtc::GetThreadCpuTimeNanos() - start_ns;
+    AddCpuTime(Category::kInsertPacket,
+               elapsed_ns - (decode_time_ns_ - decode_before_ns), result);
+    ++result->packets_inserted;
+  }
+
+  void GetAudio(NetEqBenchmark::Result* result) {
+    const int64_t decode_before_ns = decode_time_ns_;
+    const int64_t start_ns = rtc::GetThreadCpuTimeNanos();
+    bool muted = false;
+    const int error = neteq_->GetAudio(&frame_, &muted);
+    const int64_t elapsed_ns = rtc::GetThreadCpuTimeNanos() - start_ns;
+    if (error != NetEq::kOK) {
+      ++result->get_audio_errors;
+    }
+    const Category category = CategoryFromOperation(
+        static_cast<NetEqImpl*>(neteq_.get())->last_operation_for_test());
+    AddCpuTime(category, elapsed_ns - (decode_time_ns_ - decode_before_ns),
+               result);
+    result->simulated_time_ms += kOutputBlockMs;
+    result->max_buffer_size_ms =
+        std::max(result->max_buffer_size_ms,
+                 static_cast<int>(
+                     neteq_->GetOperationsAndState().current_buffer_size_ms));
+  }
+
+  static void AddCpuTime(Category category,
+                         int64_t cpu_time_ns,
+                         NetEqBenchmark::Result* result) {
+    NetEqBenchmark::CpuStats& stats =
+        result->cpu[static_cast<size_t>(category)];
+    stats.cpu_time_ns += cpu_time_ns;
+    ++stats.count;
+  }
+
+  SimulatedClock clock_;
+  int64_t decode_time_ns_ = 0;
+  int64_t decode_calls_ = 0;
+  const rtc::scoped_refptr<AudioDecoderFactory> decoder_factory_;
+  const std::unique_ptr<NetEqInput> input_;
+  std::unique_ptr<NetEq> neteq_;
+  AudioFrame frame_;
+  int64_t time_now_ms_ = 0;
+};
+
+// A set of instances run by one thread. The instances are stepped round-robin,
+// one output block at a time, so that all of them are live simultaneously as
+// on a real receive server.
+class Shard {
+ public:
+  explicit Shard(int index)
+      : thread_(&Shard::Run, this, "NetEqBenchmark" + std::to_string(index)) {}
+
+  void AddInstance(std::unique_ptr<Instance> instance) {
+    instances_.push_back(std::move(instance));
+  }
+
+  void Start() { thread_.Start(); }
+  void Stop() { thread_.Stop(); }
+
+  void DestroyInstances() { instances_.clear(); }
+
+  const NetEqBenchmark::Result& result() const { return result_; }
+
+ private:
+  static void Run(void* obj) { static_cast<Shard*>(obj)->Process(); }
+
+  void Process() {
+    std::vector<Instance*> active;
+    for (const auto& instance : instances_) {
+      active.push_back(instance.get());
+    }
+    while (!active.empty()) {
+      auto it = active.begin();
+      while (it != active.end()) {
+        if ((*it)->Step(&result_)) {
+          ++it;
+        } else {
+          (*it)->CollectDecodeTime(&result_);
+          it = active.erase(it);
+        }
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<Instance>> instances_;
+  NetEqBenchmark::Result result_;
+  rtc::PlatformThread thread_;
+};
+
+}  // namespace
+
+NetEqBenchmark::Config::Config() = default;
+NetEqBenchmark::Config::Config(const Config&) = default;
+NetEqBenchmark::Config::~Config() = default;
+
+NetEqBenchmark::NetEqBenchmark(const Config& config) : config_(config) {
+  RTC_CHECK(config_.decoder_factory);
+  RTC_CHECK(config_.input_factory);
+  RTC_CHECK_GT(config_.num_instances, 0);
+  RTC_CHECK_GT(config_.num_threads, 0);
+}
+
+NetEqBenchmark::~NetEqBenchmark() = default;
+
+NetEqBenchmark::Result NetEqBenchmark::Run() {
+  const int num_threads = std::min(config_.num_threads, config_.num_instances);
+  const int64_t rss_start_bytes = ResidentSetSizeBytes();
+
+  std::vector<std::unique_ptr<Shard>> shards;
+  for (int i = 0; i < num_threads; ++i) {
+    shards.push_back(std::make_unique<Shard>(i));
+  }
+  for (int i = 0; i < config_.num_instances; ++i) {
+    shards[i % num_threads]->AddInstance(
+        std::make_unique<Instance>(config_, i));
+  }
+
+  const int64_t start_ms = rtc::TimeMillis();
+  for (auto& shard : shards) {
+    shard->Start();
+  }
+  for (auto& shard : shards) {
+    shard->Stop();
+  }
+
+  Result result;
+  result.wall_time_ms = rtc::TimeMillis() - start_ms;
+  // Measured before the instances are destroyed, so that it includes the
+  // buffers they have grown during the run.
+  const int64_t rss_end_bytes = ResidentSetSizeBytes();
+  if (rss_start_bytes > 0 && rss_end_bytes > rss_start_bytes) {
+    result.memory_bytes_per_instance =
+        (rss_end_bytes - rss_start_bytes) / config_.num_instances;
+  }
+  result.num_instances = config_.num_instances;
+  result.num_threads = num_threads;
+  for (auto& shard : shards) {
+    const Result& shard_result = shard->result();
+    result.simulated_time_ms += shard_result.simulated_time_ms;
+    for (size_t i = 0; i < kNumCategories; ++i) {
+      result.cpu[i].cpu_time_ns += shard_result.cpu[i].cpu_time_ns;
+      result.cpu[i].count += shard_result.cpu[i].count;
+    }
+    result.max_buffer_size_ms =
+        std::max(result.max_buffer_size_ms, shard_result.max_buffer_size_ms);
+    result.packets_inserted += shard_result.packets_inserted;
+    result.insert_errors += shard_result.insert_errors;
+    result.get_audio_errors += shard_result.get_audio_errors;
+    shard->DestroyInstances();
+  }
+  return result;
+}
+
+const char* NetEqBenchmark::CategoryName(Category category) {
+  switch (category) {
+    case Category::kInsertPacket:
+      return "insert_packet";
+    case Category::kDecode:
+      return "decode";
+    case Category::kNormal:
+      return "normal";
+    case Category::kExpand:
+      return "expand";
+    case Category::kMerge:
+      return "merge";
+    case Category::kAccelerate:
+      return "accelerate";
+    case Category::kPreemptiveExpand:
+      return "preemptive_expand";
+    case Category::kComfortNoise:
+      return "comfort_noise";
+    case Category::kOther:
+    case Category::kNumCategories:
+      break;
+  }
+  return "other";
+}
+
+std::string NetEqBenchmark::Result::ToJson() const {
+  SJson::Value root;
+  root["num_instances"] = num_instances;
+  root["num_threads"] = num_threads;
+  root["simulated_time_ms"] = static_cast<SJson::Int64>(simulated_time_ms);
+  root["wall_time_ms"] = static_cast<SJson::Int64>(wall_time_ms);
+  root["memory_bytes_per_instance"] =
+      static_cast<SJson::Int64>(memory_bytes_per_instance);
+  root["max_buffer_size_ms"] = max_buffer_size_ms;
+  root["packets_inserted"] = packets_inserted;
+  root["insert_errors"] = insert_errors;
+  root["get_audio_errors"] = get_audio_errors;
+
+  int64_t total_cpu_time_ns = 0;
+  SJson::Value cpu_json;
+  for (size_t i = 0; i < kNumCategories; ++i) {
+    SJson::Value category;
+    category["cpu_time_ns"] = static_cast<SJson::Int64>(cpu[i].cpu_time_ns);
+    category["count"] = static_cast<SJson::Int64>(cpu[i].count);
+    cpu_json[CategoryName(static_cast<Category>(i))] = category;
+    total_cpu_time_ns += cpu[i].cpu_time_ns;
+  }
+  root["cpu"] = cpu_json;
+  root["total_cpu_time_ns"] = static_cast<SJson::Int64>(total_cpu_time_ns);
+  // CPU time needed per second of audio and stream; the inverse is the number
+  // of streams one core can sustain.
+  root["cpu_ns_per_stream_second"] =
+      simulated_time_ms > 0 ? 1000.0 * total_cpu_time_ns / simulated_time_ms
+                            : 0.0;
+
+  SJson::StreamWriterBuilder builder;
+  builder["indentation"] = "  ";
+  return SJson::writeString(builder, root);
+}
+
+}  // namespace test
+}  // namespace webrtc
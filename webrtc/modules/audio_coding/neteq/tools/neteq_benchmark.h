@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BENCHMARK_H_
+#define MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BENCHMARK_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "api/audio_codecs/audio_decoder_factory.h"
+#include "api/audio_codecs/audio_format.h"
+#include "api/neteq/neteq.h"
+#include "api/scoped_refptr.h"
+#include "modules/audio_coding/neteq/tools/neteq_input.h"
+
+namespace webrtc {
+namespace test {
+
+// Runs many NetEq instances side by side on a pool of threads and measures
+// where the CPU time goes. Each instance is fed by its own NetEqInput (an RTP
+// dump, an encoded synthetic signal, optionally wrapped in an
+// ImpairedNetEqInput) and runs in simulated time, as fast as possible. The CPU
+// time spent in GetAudio() is attributed to the operation NetEq performed,
+// with the time spent inside the audio decoder accounted separately.
+class NetEqBenchmark {
+ public:
+  using DecoderMap = std::map<int, SdpAudioFormat>;
+  // Creates the input for instance number |instance|.
+  using InputFactory =
+      std::function<std::unique_ptr<NetEqInput>(int instance)>;
+
+  struct Config {
+    Config();
+    Config(const Config&);
+    ~Config();
+
+    NetEq::Config neteq_config;
+    rtc::scoped_refptr<AudioDecoderFactory> decoder_factory;
+    DecoderMap codecs;
+    InputFactory input_factory;
+    int num_instances = 1;
+    int num_threads = 1;
+  };
+
+  enum class Category {
+    kInsertPacket,
+    kDecode,
+    kNormal,
+    kExpand,
+    kMerge,
+    kAccelerate,
+    kPreemptiveExpand,
+    kComfortNoise,
+    kOther,
+    kNumCategories
+  };
+  static constexpr size_t kNumCategories =
+      static_cast<size_t>(Category::kNumCategories);
+
+  struct CpuStats {
+    int64_t cpu_time_ns = 0;
+    // Number of calls (kInsertPacket, kDecode) or 10 ms output blocks (all
+    // other categories).
+    int64_t count = 0;
+  };
+
+  struct Result {
+    int num_instances = 0;
+    int num_threads = 0;
+    // Sum of the audio produced by all instances.
+    int64_t simulated_time_ms = 0;
+    int64_t wall_time_ms = 0;
+    std::array<CpuStats, kNumCategories> cpu;
+    // Growth of the resident set size while the instances were created and
+    // run, divided by the number of instances. Zero where not available.
+    int64_t memory_bytes_per_instance = 0;
+    // Largest buffer level reported by any instance.
+    int max_buffer_size_ms = 0;
+    int packets_inserted = 0;
+    int insert_errors = 0;
+    int get_audio_errors = 0;
+
+    // Returns the result as a JSON object.
+    std::string ToJson() const;
+  };
+
+  explicit NetEqBenchmark(const Config& config);
+  ~NetEqBenchmark();
+
+  // Runs all instances until their inputs have ended.
+  Result Run();
+
+  static const char* CategoryName(Category category);
+
+ private:
+  const Config config_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+#endif  // MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BENCHMARK_H_
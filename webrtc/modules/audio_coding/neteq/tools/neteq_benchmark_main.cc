@@ -0,0 +1,182 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <math.h>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "modules/audio_coding/codecs/pcm16b/audio_encoder_pcm16b.h"
+#include "modules/audio_coding/neteq/tools/encode_neteq_input.h"
+#include "modules/audio_coding/neteq/tools/impaired_neteq_input.h"
+#include "modules/audio_coding/neteq/tools/neteq_benchmark.h"
+#include "modules/audio_coding/neteq/tools/neteq_packet_source_input.h"
+#include "modules/audio_coding/neteq/tools/neteq_test.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/field_trial.h"
+
+ABSL_FLAG(int, instances, 100, "Number of NetEq instances to run.");
+ABSL_FLAG(int, threads, 1, "Number of threads to spread the instances over.");
+ABSL_FLAG(int,
+          duration_ms,
+          60000,
+          "Simulated duration per instance. Input files are cut at this "
+          "length; the synthetic signal is generated for this long.");
+ABSL_FLAG(double, loss_rate, 0.0, "Fraction of packets to drop, in [0, 1).");
+ABSL_FLAG(double,
+          burst_length,
+          1.0,
+          "Mean loss burst length in packets; 1 gives independent losses.");
+ABSL_FLAG(int, jitter_ms, 0, "Maximum extra delay added to each packet.");
+ABSL_FLAG(bool,
+          reordering,
+          false,
+          "Allow the added jitter to reorder packets.");
+ABSL_FLAG(int,
+          max_packets_in_buffer,
+          200,
+          "Maximum number of packets in each NetEq packet buffer.");
+ABSL_FLAG(int,
+          sample_rate_hz,
+          48000,
+          "Sample rate of the synthetic PCM16 stream used when no input "
+          "files are given.");
+ABSL_FLAG(std::string,
+          output,
+          "",
+          "File to write the JSON result to. Defaults to stdout.");
+ABSL_FLAG(std::string,
+          force_fieldtrials,
+          "",
+          "Field trials control experimental feature code which can be forced. "
+          "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enable/"
+          " will assign the group Enable to field trial WebRTC-FooFeature.");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kSyntheticPayloadType = 96;
+
+// Generates a sine tone, with a different frequency for each instance so that
+// the streams do not run in lockstep.
+class SineGenerator : public EncodeNetEqInput::Generator {
+ public:
+  SineGenerator(int sample_rate_hz, double frequency_hz)
+      : phase_increment_(2 * M_PI * frequency_hz / sample_rate_hz) {}
+
+  rtc::ArrayView<const int16_t> Generate(size_t num_samples) override {
+    buffer_.resize(num_samples);
+    for (int16_t& sample : buffer_) {
+      sample = static_cast<int16_t>(8000 * sin(phase_));
+      phase_ += phase_increment_;
+    }
+    phase_ = fmod(phase_, 2 * M_PI);
+    return buffer_;
+  }
+
+ private:
+  const double phase_increment_;
+  double phase_ = 0.0;
+  std::vector<int16_t> buffer_;
+};
+
+std::unique_ptr<NetEqInput> CreateInput(
+    const std::vector<std::string>& input_files,
+    int instance) {
+  const int duration_ms = absl::GetFlag(FLAGS_duration_ms);
+  std::unique_ptr<NetEqInput> input;
+  if (input_files.empty()) {
+    AudioEncoderPcm16B::Config config;
+    config.sample_rate_hz = absl::GetFlag(FLAGS_sample_rate_hz);
+    config.payload_type = kSyntheticPayloadType;
+    input = std::make_unique<EncodeNetEqInput>(
+        std::make_unique<SineGenerator>(config.sample_rate_hz,
+                                        300.0 + 10 * (instance % 50)),
+        std::make_unique<AudioEncoderPcm16B>(config), duration_ms);
+  } else {
+    input = std::make_unique<TimeLimitedNetEqInput>(
+        std::make_unique<NetEqRtpDumpInput>(
+            input_files[instance % input_files.size()],
+            RtpHeaderExtensionMap(), absl::nullopt),
+        duration_ms);
+  }
+  ImpairedNetEqInput::Config config;
+  config.loss_rate = absl::GetFlag(FLAGS_loss_rate);
+  config.mean_burst_length = absl::GetFlag(FLAGS_burst_length);
+  config.max_jitter_ms = absl::GetFlag(FLAGS_jitter_ms);
+  config.allow_reordering = absl::GetFlag(FLAGS_reordering);
+  config.seed = instance + 1;
+  return std::make_unique<ImpairedNetEqInput>(std::move(input), config);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  const std::string usage =
+      "Runs many NetEq instances in parallel and reports the CPU time per "
+      "operation and the memory per instance as JSON.\n"
+      "Example usage:\n"
+      "./neteq_benchmark --instances=1000 --threads=8 --loss_rate=0.05 "
+      "[input1.rtp input2.rtp ...]\n"
+      "Without input files, a synthetic PCM16 stream is used.\n";
+  if (absl::GetFlag(FLAGS_instances) <= 0 ||
+      absl::GetFlag(FLAGS_threads) <= 0) {
+    std::cout << usage;
+    return 1;
+  }
+  // The field trial code keeps a pointer to the string, so it must stay alive
+  // for the rest of the program.
+  const std::string force_fieldtrials = absl::GetFlag(FLAGS_force_fieldtrials);
+  webrtc::field_trial::InitFieldTrialsFromString(force_fieldtrials.c_str());
+
+  const std::vector<std::string> input_files(args.begin() + 1, args.end());
+
+  webrtc::test::NetEqBenchmark::Config config;
+  config.neteq_config.max_packets_in_buffer =
+      absl::GetFlag(FLAGS_max_packets_in_buffer);
+  config.decoder_factory = webrtc::CreateBuiltinAudioDecoderFactory();
+  if (input_files.empty()) {
+    config.codecs = {
+        {webrtc::test::kSyntheticPayloadType,
+         webrtc::SdpAudioFormat("l16", absl::GetFlag(FLAGS_sample_rate_hz),
+                                1)}};
+  } else {
+    config.codecs = webrtc::test::NetEqTest::StandardDecoderMap();
+  }
+  config.input_factory = [&input_files](int instance) {
+    return webrtc::test::CreateInput(input_files, instance);
+  };
+  config.num_instances = absl::GetFlag(FLAGS_instances);
+  config.num_threads = absl::GetFlag(FLAGS_threads);
+
+  const webrtc::test::NetEqBenchmark::Result result =
+      webrtc::test::NetEqBenchmark(config).Run();
+
+  const std::string output_file = absl::GetFlag(FLAGS_output);
+  if (output_file.empty()) {
+    std::cout << result.ToJson() << std::endl;
+  } else {
+    std::ofstream output(output_file);
+    RTC_CHECK(output.is_open()) << "Cannot open " << output_file;
+    output << result.ToJson() << std::endl;
+  }
+  return 0;
+}
@@ -36,13 +36,28 @@ void ComputeFrequencyResponse(
     size_t num_partitions,
     const std::vector<std::vector<FftData>>& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
-  for (auto& H2_ch : *H2) {
-    H2_ch.fill(0.f);
+  for (size_t p = num_partitions; p < H2->size(); ++p) {
+    (*H2)[p].fill(0.f);
+  }
+  ComputeFrequencyResponse(0, num_partitions, H, H2);
+}
+
+// Computes and stores the frequency response of the filter partitions
+// [from_partition, to_partition).
+void ComputeFrequencyResponse(
+    size_t from_partition,
+    size_t to_partition,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
+  RTC_DCHECK_LE(from_partition, to_partition);
+  RTC_DCHECK_LE(to_partition, H2->size());
+  for (size_t p = from_partition; p < to_partition; ++p) {
+    (*H2)[p].fill(0.f);
   }
 
   const size_t num_render_channels = H[0].size();
   RTC_DCHECK_EQ(H.size(), H2->capacity());
-  for (size_t p = 0; p < num_partitions; ++p) {
+  for (size_t p = from_partition; p < to_partition; ++p) {
     RTC_DCHECK_EQ(kFftLengthBy2Plus1, (*H2)[p].size());
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
       for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
@@ -60,13 +75,28 @@ void ComputeFrequencyResponse_Neon(
     size_t num_partitions,
     const std::vector<std::vector<FftData>>& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
-  for (auto& H2_ch : *H2) {
-    H2_ch.fill(0.f);
+  for (size_t p = num_partitions; p < H2->size(); ++p) {
+    (*H2)[p].fill(0.f);
+  }
+  ComputeFrequencyResponse_Neon(0, num_partitions, H, H2);
+}
+
+// Computes and stores the frequency response of the filter partitions
+// [from_partition, to_partition).
+void ComputeFrequencyResponse_Neon(
+    size_t from_partition,
+    size_t to_partition,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
+  RTC_DCHECK_LE(from_partition, to_partition);
+  RTC_DCHECK_LE(to_partition, H2->size());
+  for (size_t p = from_partition; p < to_partition; ++p) {
+    (*H2)[p].fill(0.f);
   }
 
   const size_t num_render_channels = H[0].size();
   RTC_DCHECK_EQ(H.size(), H2->capacity());
-  for (size_t p = 0; p < num_partitions; ++p) {
+  for (size_t p = from_partition; p < to_partition; ++p) {
     RTC_DCHECK_EQ(kFftLengthBy2Plus1, (*H2)[p].size());
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
       for (size_t j = 0; j < kFftLengthBy2; j += 4) {
@@ -92,14 +122,29 @@ void ComputeFrequencyResponse_Sse2(
     size_t num_partitions,
     const std::vector<std::vector<FftData>>& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
-  for (auto& H2_ch : *H2) {
-    H2_ch.fill(0.f);
+  for (size_t p = num_partitions; p < H2->size(); ++p) {
+    (*H2)[p].fill(0.f);
+  }
+  ComputeFrequencyResponse_Sse2(0, num_partitions, H, H2);
+}
+
+// Computes and stores the frequency response of the filter partitions
+// [from_partition, to_partition).
+void ComputeFrequencyResponse_Sse2(
+    size_t from_partition,
+    size_t to_partition,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
+  RTC_DCHECK_LE(from_partition, to_partition);
+  RTC_DCHECK_LE(to_partition, H2->size());
+  for (size_t p = from_partition; p < to_partition; ++p) {
+    (*H2)[p].fill(0.f);
   }
 
   const size_t num_render_channels = H[0].size();
   RTC_DCHECK_EQ(H.size(), H2->capacity());
   // constexpr __mmmask8 kMaxMask = static_cast<__mmmask8>(256u);
-  for (size_t p = 0; p < num_partitions; ++p) {
+  for (size_t p = from_partition; p < to_partition; ++p) {
     RTC_DCHECK_EQ(kFftLengthBy2Plus1, (*H2)[p].size());
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
       for (size_t j = 0; j < kFftLengthBy2; j += 4) {
@@ -125,11 +170,25 @@ void AdaptPartitions(const RenderBuffer& render_buffer,
                      const FftData& G,
                      size_t num_partitions,
                      std::vector<std::vector<FftData>>* H) {
+  AdaptPartitions(render_buffer, G, 0, num_partitions, H);
+}
+
+// Adapts the filter partitions [from_partition, to_partition).
+void AdaptPartitions(const RenderBuffer& render_buffer,
+                     const FftData& G,
+                     size_t from_partition,
+                     size_t to_partition,
+                     std::vector<std::vector<FftData>>* H) {
   rtc::ArrayView<const std::vector<FftData>> render_buffer_data =
       render_buffer.GetFftBuffer();
-  size_t index = render_buffer.Position();
+  RTC_DCHECK_LE(from_partition, to_partition);
+  RTC_DCHECK_LE(to_partition, render_buffer_data.size());
+  size_t index = render_buffer.Position() + from_partition;
+  if (index >= render_buffer_data.size()) {
+    index -= render_buffer_data.size();
+  }
   const size_t num_render_channels = render_buffer_data[index].size();
-  for (size_t p = 0; p < num_partitions; ++p) {
+  for (size_t p = from_partition; p < to_partition; ++p) {
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
       const FftData& X_p_ch = render_buffer_data[index][ch];
       FftData& H_p_ch = (*H)[p][ch];
@@ -148,17 +207,32 @@ void AdaptPartitions_Neon(const RenderBuffer& render_buffer,
                           const FftData& G,
                           size_t num_partitions,
                           std::vector<std::vector<FftData>>* H) {
+  AdaptPartitions_Neon(render_buffer, G, 0, num_partitions, H);
+}
+
+// Adapts the filter partitions [from_partition, to_partition). (Neon variant)
+void AdaptPartitions_Neon(const RenderBuffer& render_buffer,
+                          const FftData& G,
+                          size_t from_partition,
+                          size_t to_partition,
+                          std::vector<std::vector<FftData>>* H) {
   rtc::ArrayView<const std::vector<FftData>> render_buffer_data =
       render_buffer.GetFftBuffer();
+  RTC_DCHECK_LE(from_partition, to_partition);
+  RTC_DCHECK_LE(to_partition, render_buffer_data.size());
   const size_t num_render_channels = render_buffer_data[0].size();
+  size_t X_start = render_buffer.Position() + from_partition;
+  if (X_start >= render_buffer_data.size()) {
+    X_start -= render_buffer_data.size();
+  }
   const size_t lim1 = std::min(
-      render_buffer_data.size() - render_buffer.Position(), num_partitions);
-  const size_t lim2 = num_partitions;
+      from_partition + render_buffer_data.size() - X_start, to_partition);
+  const size_t lim2 = to_partition;
   constexpr size_t kNumFourBinBands = kFftLengthBy2 / 4;
 
-  size_t X_partition = render_buffer.Position();
+  size_t X_partition = X_start;
   size_t limit = lim1;
-  size_t p = 0;
+  size_t p = from_partition;
   do {
     for (; p < limit; ++p, ++X_partition) {
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
@@ -187,9 +261,9 @@ void AdaptPartitions_Neon(const RenderBuffer& render_buffer,
     limit = lim2;
   } while (p < lim2);
 
-  X_partition = render_buffer.Position();
+  X_partition = X_start;
   limit = lim1;
-  p = 0;
+  p = from_partition;
   do {
     for (; p < limit; ++p, ++X_partition) {
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
@@ -214,17 +288,32 @@ void AdaptPartitions_Sse2(const RenderBuffer& render_buffer,
                           const FftData& G,
                           size_t num_partitions,
                           std::vector<std::vector<FftData>>* H) {
+  AdaptPartitions_Sse2(render_buffer, G, 0, num_partitions, H);
+}
+
+// Adapts the filter partitions [from_partition, to_partition). (SSE2 variant)
+void AdaptPartitions_Sse2(const RenderBuffer& render_buffer,
+                          const FftData& G,
+                          size_t from_partition,
+                          size_t to_partition,
+                          std::vector<std::vector<FftData>>* H) {
   rtc::ArrayView<const std::vector<FftData>> render_buffer_data =
       render_buffer.GetFftBuffer();
+  RTC_DCHECK_LE(from_partition, to_partition);
+  RTC_DCHECK_LE(to_partition, render_buffer_data.size());
   const size_t num_render_channels = render_buffer_data[0].size();
+  size_t X_start = render_buffer.Position() + from_partition;
+  if (X_start >= render_buffer_data.size()) {
+    X_start -= render_buffer_data.size();
+  }
   const size_t lim1 = std::min(
-      render_buffer_data.size() - render_buffer.Position(), num_partitions);
-  const size_t lim2 = num_partitions;
+      from_partition + render_buffer_data.size() - X_start, to_partition);
+  const size_t lim2 = to_partition;
   constexpr size_t kNumFourBinBands = kFftLengthBy2 / 4;
 
-  size_t X_partition = render_buffer.Position();
+  size_t X_partition = X_start;
   size_t limit = lim1;
-  size_t p = 0;
+  size_t p = from_partition;
   do {
     for (; p < limit; ++p, ++X_partition) {
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
@@ -255,9 +344,9 @@ void AdaptPartitions_Sse2(const RenderBuffer& render_buffer,
     limit = lim2;
   } while (p < lim2);
 
-  X_partition = render_buffer.Position();
+  X_partition = X_start;
   limit = lim1;
-  p = 0;
+  p = from_partition;
   do {
     for (; p < limit; ++p, ++X_partition) {
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
@@ -501,6 +590,14 @@ AdaptiveFirFilter::~AdaptiveFirFilter() = default;
 void AdaptiveFirFilter::HandleEchoPathChange() {
   // TODO(peah): Check the value and purpose of the code below.
   ZeroFilter(current_size_partitions_, max_size_partitions_, &H_);
+  frequency_response_stale_ = true;
+}
+
+void AdaptiveFirFilter::SetNonUniformAdaptation(size_t head_size_partitions) {
+  head_size_partitions_ = head_size_partitions;
+  adaptation_counter_ = 0;
+  modified_partitions_.clear();
+  frequency_response_stale_ = true;
 }
 
 void AdaptiveFirFilter::SetSizePartitions(size_t size, bool immediate_effect) {
@@ -517,6 +614,7 @@ void AdaptiveFirFilter::SetSizePartitions(size_t size, bool immediate_effect) {
     partition_to_constrain_ =
         std::min(partition_to_constrain_, current_size_partitions_ - 1);
     size_change_counter_ = 0;
+    frequency_response_stale_ = true;
   } else {
     size_change_counter_ = size_change_duration_blocks_;
   }
@@ -545,6 +643,9 @@ void AdaptiveFirFilter::UpdateSize() {
         target_size_partitions_;
   }
   ZeroFilter(old_size_partitions_, current_size_partitions_, &H_);
+  if (old_size_partitions_ != current_size_partitions_) {
+    frequency_response_stale_ = true;
+  }
   RTC_DCHECK_LE(0, size_change_counter_);
 }
 
@@ -590,6 +691,41 @@ void AdaptiveFirFilter::ComputeFrequencyResponse(
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) const {
   RTC_DCHECK_GE(max_size_partitions_, H2->capacity());
 
+  // With the non-uniform adaptation schedule, only the partitions modified
+  // since the last call need to be recomputed, provided that the same
+  // frequency response is updated each time.
+  if (head_size_partitions_ > 0 && !frequency_response_stale_ &&
+      last_H2_ == H2 && H2->size() == current_size_partitions_) {
+    for (const auto& range : modified_partitions_) {
+      const size_t to_partition =
+          std::min(range.second, current_size_partitions_);
+      if (range.first >= to_partition) {
+        continue;
+      }
+      switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+        case Aec3Optimization::kSse2:
+          aec3::ComputeFrequencyResponse_Sse2(range.first, to_partition, H_,
+                                              H2);
+          break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+        case Aec3Optimization::kNeon:
+          aec3::ComputeFrequencyResponse_Neon(range.first, to_partition, H_,
+                                              H2);
+          break;
+#endif
+        default:
+          aec3::ComputeFrequencyResponse(range.first, to_partition, H_, H2);
+      }
+    }
+    modified_partitions_.clear();
+    return;
+  }
+  modified_partitions_.clear();
+  frequency_response_stale_ = false;
+  last_H2_ = H2;
+
   H2->resize(current_size_partitions_);
 
   switch (optimization_) {
@@ -613,28 +749,100 @@ void AdaptiveFirFilter::AdaptAndUpdateSize(const RenderBuffer& render_buffer,
   // Update the filter size if needed.
   UpdateSize();
 
-  // Adapt the filter.
+  if (head_size_partitions_ == 0) {
+    AdaptPartitions(render_buffer, G, 0, current_size_partitions_);
+    return;
+  }
+
+  // Modifications that have not been followed by a computation of the
+  // frequency response are no longer tracked.
+  if (!modified_partitions_.empty()) {
+    modified_partitions_.clear();
+    frequency_response_stale_ = true;
+  }
+
+  // Adapt the head of the filter every block.
+  const size_t head_end =
+      std::min(head_size_partitions_, current_size_partitions_);
+  AdaptPartitions(render_buffer, G, 0, head_end);
+  MarkModified(0, head_end);
+
+  // Adapt one chunk of each of the tail groups, where the n:th group has
+  // 2^(n-1) times the size of the head and is adapted over 2^n blocks.
+  size_t group_start = head_end;
+  size_t group_size = head_size_partitions_;
+  size_t interval = 2;
+  while (group_start < current_size_partitions_) {
+    const size_t group_end =
+        std::min(group_start + group_size, current_size_partitions_);
+    const size_t chunk_size =
+        (group_end - group_start + interval - 1) / interval;
+    const size_t from_partition =
+        group_start + (adaptation_counter_ % interval) * chunk_size;
+    if (from_partition < group_end) {
+      const size_t to_partition =
+          std::min(from_partition + chunk_size, group_end);
+      AdaptPartitions(render_buffer, G, from_partition, to_partition);
+      MarkModified(from_partition, to_partition);
+    }
+    group_start = group_end;
+    group_size *= 2;
+    interval *= 2;
+  }
+  ++adaptation_counter_;
+}
+
+void AdaptiveFirFilter::AdaptPartitions(const RenderBuffer& render_buffer,
+                                        const FftData& G,
+                                        size_t from_partition,
+                                        size_t to_partition) {
   switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
     case Aec3Optimization::kSse2:
-      aec3::AdaptPartitions_Sse2(render_buffer, G, current_size_partitions_,
-                                 &H_);
+      aec3::AdaptPartitions_Sse2(render_buffer, G, from_partition,
+                                 to_partition, &H_);
       break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
-      aec3::AdaptPartitions_Neon(render_buffer, G, current_size_partitions_,
-                                 &H_);
+      aec3::AdaptPartitions_Neon(render_buffer, G, from_partition,
+                                 to_partition, &H_);
       break;
 #endif
     default:
-      aec3::AdaptPartitions(render_buffer, G, current_size_partitions_, &H_);
+      aec3::AdaptPartitions(render_buffer, G, from_partition, to_partition,
+                            &H_);
+  }
+}
+
+void AdaptiveFirFilter::MarkModified(size_t from_partition,
+                                     size_t to_partition) {
+  if (head_size_partitions_ == 0 || frequency_response_stale_ ||
+      from_partition >= to_partition) {
+    return;
   }
+  // Extend the last range when the partitions are contiguous with it.
+  if (!modified_partitions_.empty() &&
+      modified_partitions_.back().second == from_partition) {
+    modified_partitions_.back().second = to_partition;
+    return;
+  }
+  modified_partitions_.push_back({from_partition, to_partition});
 }
 
 // Constrains the partition of the frequency domain filter to be limited in
 // time via setting the relevant time-domain coefficients to zero and updates
 // the corresponding values in an externally stored impulse response estimate.
+void AdaptiveFirFilter::ConstrainAndComputeImpulseResponse(
+    std::vector<float>* impulse_response) {
+  // The partitions are constrained cyclically, so one pass over the current
+  // filter size covers all of them.
+  for (size_t p = 0; p < current_size_partitions_; ++p) {
+    ConstrainAndUpdateImpulseResponse(impulse_response);
+  }
+  frequency_response_stale_ = true;
+}
+
 void AdaptiveFirFilter::ConstrainAndUpdateImpulseResponse(
     std::vector<float>* impulse_response) {
   RTC_DCHECK_EQ(GetTimeDomainLength(max_size_partitions_),
@@ -670,6 +878,7 @@ void AdaptiveFirFilter::ConstrainAndUpdateImpulseResponse(
 
     fft_.Fft(&h, &H_[partition_to_constrain_][ch]);
   }
+  MarkModified(partition_to_constrain_, partition_to_constrain_ + 1);
 
   partition_to_constrain_ =
       partition_to_constrain_ < (current_size_partitions_ - 1)
@@ -691,6 +900,7 @@ void AdaptiveFirFilter::Constrain() {
 
     fft_.Fft(&h, &H_[partition_to_constrain_][ch]);
   }
+  MarkModified(partition_to_constrain_, partition_to_constrain_ + 1);
 
   partition_to_constrain_ =
       partition_to_constrain_ < (current_size_partitions_ - 1)
@@ -699,6 +909,7 @@ void AdaptiveFirFilter::Constrain() {
 }
 
 void AdaptiveFirFilter::ScaleFilter(float factor) {
+  frequency_response_stale_ = true;
   for (auto& H_p : H_) {
     for (auto& H_p_ch : H_p) {
       for (auto& re : H_p_ch.re) {
@@ -714,6 +925,7 @@ void AdaptiveFirFilter::ScaleFilter(float factor) {
 // Set the filter coefficients.
 void AdaptiveFirFilter::SetFilter(size_t num_partitions,
                                   const std::vector<std::vector<FftData>>& H) {
+  frequency_response_stale_ = true;
   const size_t min_num_partitions =
       std::min(current_size_partitions_, num_partitions);
   for (size_t p = 0; p < min_num_partitions; ++p) {
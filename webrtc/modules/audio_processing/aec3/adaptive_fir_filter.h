@@ -14,6 +14,7 @@
 #include <stddef.h>
 
 #include <array>
+#include <utility>
 #include <vector>
 
 #include "api/array_view.h"
@@ -44,6 +45,28 @@ void ComputeFrequencyResponse_Sse2(
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
 #endif
 
+// Computes and stores the frequency response of the filter partitions
+// [from_partition, to_partition), leaving the other partitions untouched.
+void ComputeFrequencyResponse(
+    size_t from_partition,
+    size_t to_partition,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
+#if defined(WEBRTC_HAS_NEON)
+void ComputeFrequencyResponse_Neon(
+    size_t from_partition,
+    size_t to_partition,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void ComputeFrequencyResponse_Sse2(
+    size_t from_partition,
+    size_t to_partition,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
+#endif
+
 // Adapts the filter partitions.
 void AdaptPartitions(const RenderBuffer& render_buffer,
                      const FftData& G,
@@ -62,6 +85,27 @@ void AdaptPartitions_Sse2(const RenderBuffer& render_buffer,
                           std::vector<std::vector<FftData>>* H);
 #endif
 
+// Adapts the filter partitions [from_partition, to_partition).
+void AdaptPartitions(const RenderBuffer& render_buffer,
+                     const FftData& G,
+                     size_t from_partition,
+                     size_t to_partition,
+                     std::vector<std::vector<FftData>>* H);
+#if defined(WEBRTC_HAS_NEON)
+void AdaptPartitions_Neon(const RenderBuffer& render_buffer,
+                          const FftData& G,
+                          size_t from_partition,
+                          size_t to_partition,
+                          std::vector<std::vector<FftData>>* H);
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void AdaptPartitions_Sse2(const RenderBuffer& render_buffer,
+                          const FftData& G,
+                          size_t from_partition,
+                          size_t to_partition,
+                          std::vector<std::vector<FftData>>* H);
+#endif
+
 // Produces the filter output.
 void ApplyFilter(const RenderBuffer& render_buffer,
                  size_t num_partitions,
@@ -119,6 +163,14 @@ class AdaptiveFirFilter {
   // Sets the filter size.
   void SetSizePartitions(size_t size, bool immediate_effect);
 
+  // Schedules the adaptation non-uniformly over the filter partitions. The
+  // first |head_size_partitions| partitions are adapted every block, while the
+  // remaining partitions are split into groups of doubling size, where the
+  // n:th group is adapted in chunks over 2^n blocks. The frequency response is
+  // then only recomputed for the partitions that have been modified. A value
+  // of 0 adapts all the partitions every block.
+  void SetNonUniformAdaptation(size_t head_size_partitions);
+
   // Computes the frequency responses for the filter partitions.
   void ComputeFrequencyResponse(
       std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) const;
@@ -143,10 +195,24 @@ class AdaptiveFirFilter {
   // Gets the filter coefficients.
   const std::vector<std::vector<FftData>>& GetFilter() const { return H_; }
 
+  // Constrains all the filter partitions at once and updates the supplied
+  // impulse response accordingly.
+  void ConstrainAndComputeImpulseResponse(std::vector<float>* impulse_response);
+
  private:
   // Adapts the filter and updates the filter size.
   void AdaptAndUpdateSize(const RenderBuffer& render_buffer, const FftData& G);
 
+  // Adapts the filter partitions [from_partition, to_partition).
+  void AdaptPartitions(const RenderBuffer& render_buffer,
+                       const FftData& G,
+                       size_t from_partition,
+                       size_t to_partition);
+
+  // Marks the filter partitions [from_partition, to_partition) as modified
+  // since the last computation of the frequency response.
+  void MarkModified(size_t from_partition, size_t to_partition);
+
   // Constrain the filter partitions in a cyclic manner.
   void Constrain();
   // Constrains the filter in a cyclic manner and updates the corresponding
@@ -169,6 +235,14 @@ class AdaptiveFirFilter {
   int size_change_counter_ = 0;
   std::vector<std::vector<FftData>> H_;
   size_t partition_to_constrain_ = 0;
+  size_t head_size_partitions_ = 0;
+  size_t adaptation_counter_ = 0;
+  // State for the incremental computation of the frequency response when the
+  // adaptation is scheduled non-uniformly.
+  mutable std::vector<std::pair<size_t, size_t>> modified_partitions_;
+  mutable bool frequency_response_stale_ = true;
+  mutable const std::vector<std::array<float, kFftLengthBy2Plus1>>* last_H2_ =
+      nullptr;
 };
 
 }  // namespace webrtc
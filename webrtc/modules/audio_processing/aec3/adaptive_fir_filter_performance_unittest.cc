@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/adaptive_fir_filter.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/render_delay_buffer.h"
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 16000;
+constexpr size_t kNumRenderChannels = 1;
+// Number of distinct render blocks cycled through during the measurement.
+constexpr size_t kNumRenderBlocks = 200;
+
+int NumIterations() {
+  const int kNumIterations = 20000;
+  const int kQuickNumIterations = 200;
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumIterations
+                                                        : kNumIterations;
+}
+
+// Measures the per-block cost of filtering, adapting and computing the
+// frequency response of the filter, as done for the refined filter in the
+// subtractor, and reports the throughput in blocks per second.
+void RunAndReport(size_t length_blocks, size_t head_size_partitions) {
+  ApmDataDumper data_dumper(0);
+  EchoCanceller3Config config;
+  config.filter.refined.length_blocks = length_blocks;
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, kNumRenderChannels));
+  AdaptiveFirFilter filter(length_blocks, length_blocks,
+                           config.filter.config_change_duration_blocks,
+                           kNumRenderChannels, DetectOptimization(),
+                           &data_dumper);
+  filter.SetNonUniformAdaptation(head_size_partitions);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> H2(length_blocks);
+  std::vector<float> h(GetTimeDomainLength(length_blocks), 0.f);
+
+  Random random_generator(42U);
+  Block x(NumBandsForRate(kSampleRateHz), kNumRenderChannels);
+  for (size_t k = 0; k < kNumRenderBlocks; ++k) {
+    RandomizeSampleVector(&random_generator, x.View(/*band=*/0, /*channel=*/0));
+    render_delay_buffer->Insert(x);
+    if (k == 0) {
+      render_delay_buffer->Reset();
+    }
+    render_delay_buffer->PrepareCaptureProcessing();
+  }
+  const RenderBuffer& render_buffer = *render_delay_buffer->GetRenderBuffer();
+
+  FftData G;
+  std::for_each(G.re.begin(), G.re.end(), [&](float& a) {
+    a = 1e-9f * (random_generator.Rand<float>() - 0.5f);
+  });
+  std::for_each(G.im.begin(), G.im.end(), [&](float& a) {
+    a = 1e-9f * (random_generator.Rand<float>() - 0.5f);
+  });
+  FftData S;
+
+  const int num_iterations = NumIterations();
+  Clock* clock = Clock::GetRealTimeClock();
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int n = 0; n < num_iterations; ++n) {
+    filter.Filter(render_buffer, &S);
+    filter.Adapt(render_buffer, G, &h);
+    filter.ComputeFrequencyResponse(&H2);
+  }
+  const int64_t runtime_us = clock->TimeInMicroseconds() - start_time_us;
+  ASSERT_GT(runtime_us, 0);
+  test::PrintResult(
+      "aec3_adaptive_fir_filter",
+      head_size_partitions > 0 ? "_non_uniform" : "_uniform",
+      "length_blocks_" + std::to_string(length_blocks),
+      1e6 * num_iterations / runtime_us, "blocks_per_second_per_core", true);
+}
+
+}  // namespace
+
+TEST(AdaptiveFirFilterPerformanceTest, FilterLength) {
+  const size_t head_size_partitions =
+      EchoCanceller3Config().filter.non_uniform_partitioning.head_length_blocks;
+  for (size_t length_blocks : {13, 20, 40, 70, 100}) {
+    RunAndReport(length_blocks, 0);
+    RunAndReport(length_blocks, head_size_partitions);
+  }
+}
+
+}  // namespace webrtc
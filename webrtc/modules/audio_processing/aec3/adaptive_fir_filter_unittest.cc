@@ -73,10 +73,7 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
         RenderDelayBuffer::Create(EchoCanceller3Config(), kSampleRateHz,
                                   num_render_channels));
     Random random_generator(42U);
-    std::vector<std::vector<std::vector<float>>> x(
-        kNumBands,
-        std::vector<std::vector<float>>(num_render_channels,
-                                        std::vector<float>(kBlockSize, 0.f)));
+    Block x(kNumBands, num_render_channels);
     FftData S_C;
     FftData S_Neon;
     FftData G;
@@ -93,9 +90,9 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
     }
 
     for (size_t k = 0; k < 30; ++k) {
-      for (size_t band = 0; band < x.size(); ++band) {
-        for (size_t ch = 0; ch < x[band].size(); ++ch) {
-          RandomizeSampleVector(&random_generator, x[band][ch]);
+      for (size_t band = 0; band < x.NumBands(); ++band) {
+        for (size_t ch = 0; ch < x.NumChannels(); ++ch) {
+          RandomizeSampleVector(&random_generator, x.View(band, ch));
         }
       }
       render_delay_buffer->Insert(x);
@@ -186,10 +183,7 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
           RenderDelayBuffer::Create(EchoCanceller3Config(), kSampleRateHz,
                                     num_render_channels));
       Random random_generator(42U);
-      std::vector<std::vector<std::vector<float>>> x(
-          kNumBands,
-          std::vector<std::vector<float>>(num_render_channels,
-                                          std::vector<float>(kBlockSize, 0.f)));
+      Block x(kNumBands, num_render_channels);
       FftData S_C;
       FftData S_Sse2;
       FftData G;
@@ -206,9 +200,9 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
       }
 
       for (size_t k = 0; k < 500; ++k) {
-        for (size_t band = 0; band < x.size(); ++band) {
-          for (size_t ch = 0; ch < x[band].size(); ++ch) {
-            RandomizeSampleVector(&random_generator, x[band][ch]);
+        for (size_t band = 0; band < x.NumBands(); ++band) {
+          for (size_t ch = 0; ch < x.NumChannels(); ++ch) {
+            RandomizeSampleVector(&random_generator, x.View(band, ch));
           }
         }
         render_delay_buffer->Insert(x);
@@ -283,6 +277,160 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
 
 #endif
 
+// Verifies that adapting the filter partitions in ranges gives the same result
+// as adapting all partitions at once, also when the ranges wrap around the end
+// of the render buffer.
+TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
+       PartitionRangeAdaptation) {
+  const size_t num_render_channels = GetParam();
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+  const Aec3Optimization optimization = DetectOptimization();
+
+  for (size_t num_partitions : {2, 5, 12, 30, 50}) {
+    EchoCanceller3Config config;
+    config.filter.refined.length_blocks = num_partitions;
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(config, kSampleRateHz, num_render_channels));
+    Random random_generator(42U);
+    Block x(kNumBands, num_render_channels);
+    FftData G;
+    std::vector<std::vector<FftData>> H_full(
+        num_partitions, std::vector<FftData>(num_render_channels));
+    std::vector<std::vector<FftData>> H_ranges(
+        num_partitions, std::vector<FftData>(num_render_channels));
+    std::vector<std::vector<FftData>> H_ranges_optimized(
+        num_partitions, std::vector<FftData>(num_render_channels));
+    for (size_t p = 0; p < num_partitions; ++p) {
+      for (size_t ch = 0; ch < num_render_channels; ++ch) {
+        H_full[p][ch].Clear();
+        H_ranges[p][ch].Clear();
+        H_ranges_optimized[p][ch].Clear();
+      }
+    }
+
+    for (size_t k = 0; k < 100; ++k) {
+      for (size_t band = 0; band < x.NumBands(); ++band) {
+        for (size_t ch = 0; ch < x.NumChannels(); ++ch) {
+          RandomizeSampleVector(&random_generator, x.View(band, ch));
+        }
+      }
+      render_delay_buffer->Insert(x);
+      if (k == 0) {
+        render_delay_buffer->Reset();
+      }
+      render_delay_buffer->PrepareCaptureProcessing();
+      auto* const render_buffer = render_delay_buffer->GetRenderBuffer();
+
+      std::for_each(G.re.begin(), G.re.end(),
+                    [&](float& a) { a = random_generator.Rand<float>(); });
+      std::for_each(G.im.begin(), G.im.end(),
+                    [&](float& a) { a = random_generator.Rand<float>(); });
+
+      AdaptPartitions(*render_buffer, G, num_partitions, &H_full);
+      const size_t split = (k * 7) % num_partitions;
+      AdaptPartitions(*render_buffer, G, split, num_partitions, &H_ranges);
+      AdaptPartitions(*render_buffer, G, 0, split, &H_ranges);
+      switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+        case Aec3Optimization::kSse2:
+          AdaptPartitions_Sse2(*render_buffer, G, split, num_partitions,
+                               &H_ranges_optimized);
+          AdaptPartitions_Sse2(*render_buffer, G, 0, split,
+                               &H_ranges_optimized);
+          break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+        case Aec3Optimization::kNeon:
+          AdaptPartitions_Neon(*render_buffer, G, split, num_partitions,
+                               &H_ranges_optimized);
+          AdaptPartitions_Neon(*render_buffer, G, 0, split,
+                               &H_ranges_optimized);
+          break;
+#endif
+        default:
+          AdaptPartitions(*render_buffer, G, split, num_partitions,
+                          &H_ranges_optimized);
+          AdaptPartitions(*render_buffer, G, 0, split, &H_ranges_optimized);
+      }
+
+      for (size_t p = 0; p < num_partitions; ++p) {
+        for (size_t ch = 0; ch < num_render_channels; ++ch) {
+          for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
+            EXPECT_EQ(H_full[p][ch].re[j], H_ranges[p][ch].re[j]);
+            EXPECT_EQ(H_full[p][ch].im[j], H_ranges[p][ch].im[j]);
+            EXPECT_FLOAT_EQ(H_full[p][ch].re[j],
+                            H_ranges_optimized[p][ch].re[j]);
+            EXPECT_FLOAT_EQ(H_full[p][ch].im[j],
+                            H_ranges_optimized[p][ch].im[j]);
+          }
+        }
+      }
+    }
+  }
+}
+
+// Verifies that the incrementally updated frequency response of a filter with
+// the non-uniform adaptation schedule matches a full recomputation.
+TEST(AdaptiveFirFilterTest, NonUniformAdaptationFrequencyResponse) {
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+  constexpr size_t kNumRenderChannels = 1;
+  constexpr size_t kFilterSize = 40;
+  ApmDataDumper data_dumper(42);
+  EchoCanceller3Config config;
+  config.filter.refined.length_blocks = kFilterSize;
+  AdaptiveFirFilter filter(kFilterSize, kFilterSize / 2, 50,
+                           kNumRenderChannels, DetectOptimization(),
+                           &data_dumper);
+  filter.SetNonUniformAdaptation(4);
+  filter.SetSizePartitions(kFilterSize, false);
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, kNumRenderChannels));
+  Random random_generator(42U);
+  Block x(kNumBands, kNumRenderChannels);
+  std::vector<float> h(GetTimeDomainLength(kFilterSize), 0.f);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> H2(kFilterSize);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> H2_reference(kFilterSize);
+  FftData G;
+
+  for (size_t k = 0; k < 300; ++k) {
+    for (size_t band = 0; band < x.NumBands(); ++band) {
+      RandomizeSampleVector(&random_generator, x.View(band, 0));
+    }
+    render_delay_buffer->Insert(x);
+    if (k == 0) {
+      render_delay_buffer->Reset();
+    }
+    render_delay_buffer->PrepareCaptureProcessing();
+    auto* const render_buffer = render_delay_buffer->GetRenderBuffer();
+
+    std::for_each(G.re.begin(), G.re.end(), [&](float& a) {
+      a = 1e-6f * (random_generator.Rand<float>() - 0.5f);
+    });
+    std::for_each(G.im.begin(), G.im.end(), [&](float& a) {
+      a = 1e-6f * (random_generator.Rand<float>() - 0.5f);
+    });
+
+    if (k % 97 == 0) {
+      filter.ScaleFilter(0.5f);
+    }
+    filter.Adapt(*render_buffer, G, &h);
+    filter.ComputeFrequencyResponse(&H2);
+
+    H2_reference.resize(filter.SizePartitions());
+    ComputeFrequencyResponse(filter.SizePartitions(), filter.GetFilter(),
+                             &H2_reference);
+    ASSERT_EQ(H2_reference.size(), H2.size());
+    for (size_t p = 0; p < H2.size(); ++p) {
+      for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
+        EXPECT_FLOAT_EQ(H2_reference[p][j], H2[p][j]);
+      }
+    }
+  }
+  EXPECT_EQ(kFilterSize, filter.SizePartitions());
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 // Verifies that the check for non-null data dumper works.
 TEST(AdaptiveFirFilterTest, NullDataDumper) {
@@ -332,18 +480,22 @@ TEST(AdaptiveFirFilterTest, FilterSize) {
 
 class AdaptiveFirFilterMultiChannel
     : public ::testing::Test,
-      public ::testing::WithParamInterface<std::tuple<size_t, size_t>> {};
+      public ::testing::WithParamInterface<
+          std::tuple<size_t, size_t, size_t>> {};
 
 INSTANTIATE_TEST_SUITE_P(MultiChannel,
                          AdaptiveFirFilterMultiChannel,
                          ::testing::Combine(::testing::Values(1, 4),
-                                            ::testing::Values(1, 8)));
+                                            ::testing::Values(1, 8),
+                                            ::testing::Values(0, 16)));
 
 // Verifies that the filter is being able to properly filter a signal and to
-// adapt its coefficients.
+// adapt its coefficients, both with the uniform and the non-uniform adaptation
+// schedule.
 TEST_P(AdaptiveFirFilterMultiChannel, FilterAndAdapt) {
   const size_t num_render_channels = std::get<0>(GetParam());
   const size_t num_capture_channels = std::get<1>(GetParam());
+  const size_t head_size_partitions = std::get<2>(GetParam());
 
   constexpr int kSampleRateHz = 48000;
   constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
@@ -359,10 +511,23 @@ TEST_P(AdaptiveFirFilterMultiChannel, FilterAndAdapt) {
     config.filter.coarse_initial = {12, 0.7f, 20075344.f};
   }
 
+  // Use a long filter for the non-uniform adaptation schedule, in order to
+  // also verify the adaptation of echoes in the tail of the filter. As the tail
+  // is adapted less often, the convergence is given more time.
+  std::vector<size_t> delays_samples = {0, 64, 150, 200, 301};
+  size_t num_blocks_to_process_per_render_channel =
+      kNumBlocksToProcessPerRenderChannel;
+  if (head_size_partitions > 0) {
+    config.filter.refined.length_blocks = 40;
+    delays_samples.push_back(1600);
+    num_blocks_to_process_per_render_channel *= 2;
+  }
+
   AdaptiveFirFilter filter(
       config.filter.refined.length_blocks, config.filter.refined.length_blocks,
       config.filter.config_change_duration_blocks, num_render_channels,
       DetectOptimization(), &data_dumper);
+  filter.SetNonUniformAdaptation(head_size_partitions);
   std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>> H2(
       num_capture_channels, std::vector<std::array<float, kFftLengthBy2Plus1>>(
                                 filter.max_filter_size_partitions(),
@@ -378,12 +543,10 @@ TEST_P(AdaptiveFirFilterMultiChannel, FilterAndAdapt) {
   CoarseFilterUpdateGain gain(config.filter.coarse,
                               config.filter.config_change_duration_blocks);
   Random random_generator(42U);
-  std::vector<std::vector<std::vector<float>>> x(
-      kNumBands, std::vector<std::vector<float>>(
-                     num_render_channels, std::vector<float>(kBlockSize, 0.f)));
+  Block x(kNumBands, num_render_channels);
   std::vector<float> n(kBlockSize, 0.f);
   std::vector<float> y(kBlockSize, 0.f);
-  AecState aec_state(EchoCanceller3Config{}, num_capture_channels);
+  AecState aec_state(config, num_capture_channels);
   RenderSignalAnalyzer render_signal_analyzer(config);
   absl::optional<DelayEstimate> delay_estimate;
   std::vector<float> e(kBlockSize, 0.f);
@@ -413,7 +576,7 @@ TEST_P(AdaptiveFirFilterMultiChannel, FilterAndAdapt) {
 
   constexpr float kScale = 1.0f / kFftLengthBy2;
 
-  for (size_t delay_samples : {0, 64, 150, 200, 301}) {
+  for (size_t delay_samples : delays_samples) {
     std::vector<DelayBuffer<float>> delay_buffer(
         num_render_channels, DelayBuffer<float>(delay_samples));
     std::vector<std::unique_ptr<CascadedBiQuadFilter>> x_hp_filter(
@@ -426,13 +589,13 @@ TEST_P(AdaptiveFirFilterMultiChannel, FilterAndAdapt) {
 
     SCOPED_TRACE(ProduceDebugText(num_render_channels, delay_samples));
     const size_t num_blocks_to_process =
-        kNumBlocksToProcessPerRenderChannel * num_render_channels;
+        num_blocks_to_process_per_render_channel * num_render_channels;
     for (size_t j = 0; j < num_blocks_to_process; ++j) {
       std::fill(y.begin(), y.end(), 0.f);
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        RandomizeSampleVector(&random_generator, x[0][ch]);
+        RandomizeSampleVector(&random_generator, x.View(/*band=*/0, ch));
         std::array<float, kBlockSize> y_channel;
-        delay_buffer[ch].Delay(x[0][ch], y_channel);
+        delay_buffer[ch].Delay(x.View(/*band=*/0, ch), y_channel);
         for (size_t k = 0; k < y.size(); ++k) {
           y[k] += y_channel[k] / num_render_channels;
         }
@@ -445,7 +608,7 @@ TEST_P(AdaptiveFirFilterMultiChannel, FilterAndAdapt) {
       }
 
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        x_hp_filter[ch]->Process(x[0][ch]);
+        x_hp_filter[ch]->Process(x.View(/*band=*/0, ch));
       }
       y_hp_filter.Process(y);
 
@@ -144,12 +144,14 @@ AecState::AecState(const EchoCanceller3Config& config,
       delay_state_(config_, num_capture_channels_),
       transparent_state_(config_),
       filter_quality_state_(config_, num_capture_channels_),
-      erl_estimator_(2 * kNumBlocksPerSecond),
+      steady_state_(config_),
+      erl_estimator_(2 * kNumBlocksPerSecond, DetectOptimization()),
       erle_estimator_(2 * kNumBlocksPerSecond, config_, num_capture_channels_),
       filter_analyzer_(config_, num_capture_channels_),
       echo_audibility_(
           config_.echo_audibility.use_stationarity_properties_at_init),
       reverb_model_estimator_(config_, num_capture_channels_),
+      avg_render_reverb_(DetectOptimization()),
       subtractor_output_analyzer_(num_capture_channels_) {}
 
 AecState::~AecState() = default;
@@ -183,6 +185,9 @@ void AecState::HandleEchoPathChange(
   if (subtractor_analyzer_reset_at_echo_path_change_) {
     subtractor_output_analyzer_.HandleEchoPathChange();
   }
+  if (echo_path_variability.AudioPathChanged()) {
+    steady_state_.Reset();
+  }
 }
 
 void AecState::Update(
@@ -218,15 +223,16 @@ void AecState::Update(
                         strong_not_saturated_render_blocks_);
   }
 
-  const std::vector<std::vector<float>>& aligned_render_block =
-      render_buffer.Block(-delay_state_.MinDirectPathFilterDelay())[0];
+  const Block& aligned_render_block =
+      render_buffer.GetBlock(-delay_state_.MinDirectPathFilterDelay());
 
   // Update render counters.
   bool active_render = false;
-  for (size_t ch = 0; ch < aligned_render_block.size(); ++ch) {
-    const float render_energy = std::inner_product(
-        aligned_render_block[ch].begin(), aligned_render_block[ch].end(),
-        aligned_render_block[ch].begin(), 0.f);
+  for (size_t ch = 0; ch < aligned_render_block.NumChannels(); ++ch) {
+    const float render_energy =
+        std::inner_product(aligned_render_block.begin(/*band=*/0, ch),
+                           aligned_render_block.end(/*band=*/0, ch),
+                           aligned_render_block.begin(/*band=*/0, ch), 0.f);
     if (render_energy > (config_.render_levels.active_render_limit *
                          config_.render_levels.active_render_limit) *
                             kFftLengthBy2) {
@@ -287,6 +293,10 @@ void AecState::Update(
                                SaturatedCapture(), external_delay,
                                any_filter_converged);
 
+  // Detect whether the processing can be duty cycled.
+  steady_state_.Update(subtractor_output, all_filters_diverged, active_render,
+                       SaturatedCapture(), FullBandErleLog2());
+
   // Update the reverb estimate.
   const bool stationary_block =
       config_.echo_audibility.use_stationarity_properties &&
@@ -316,6 +326,7 @@ void AecState::Update(
   data_dumper_->DumpRaw("aec3_echo_saturation", SaturatedEcho());
   data_dumper_->DumpRaw("aec3_any_filter_converged", any_filter_converged);
   data_dumper_->DumpRaw("aec3_all_filters_diverged", all_filters_diverged);
+  data_dumper_->DumpRaw("aec3_steady_state", SteadyState());
 
   data_dumper_->DumpRaw("aec3_external_delay_avaliable",
                         external_delay ? 1 : 0);
@@ -323,6 +334,39 @@ void AecState::Update(
                         GetReverbFrequencyResponse());
 }
 
+void AecState::GetWarmStartState(WarmStartState* state) const {
+  RTC_DCHECK(state);
+  std::copy(erl_estimator_.Erl().begin(), erl_estimator_.Erl().end(),
+            state->erl.begin());
+  state->erl_time_domain = erl_estimator_.ErlTimeDomain();
+  const auto erle = erle_estimator_.SubbandErle();
+  const auto erle_onsets = erle_estimator_.ErleOnsets();
+  const auto fullband_erle_log2 = erle_estimator_.FullbandErleLog2PerChannel();
+  state->erle.assign(erle.begin(), erle.end());
+  state->erle_onsets.assign(erle_onsets.begin(), erle_onsets.end());
+  state->fullband_erle_log2.assign(fullband_erle_log2.begin(),
+                                   fullband_erle_log2.end());
+  state->reverb_decay = reverb_model_estimator_.ReverbDecay();
+  state->reverb_average_decay = reverb_model_estimator_.ReverbAverageDecay();
+  const auto reverb_frequency_response =
+      reverb_model_estimator_.GetReverbFrequencyResponse();
+  std::copy(reverb_frequency_response.begin(), reverb_frequency_response.end(),
+            state->reverb_frequency_response.begin());
+}
+
+void AecState::SetWarmStartState(const WarmStartState& state) {
+  RTC_DCHECK_EQ(num_capture_channels_, state.erle.size());
+  RTC_DCHECK_EQ(num_capture_channels_, state.erle_onsets.size());
+  RTC_DCHECK_EQ(num_capture_channels_, state.fullband_erle_log2.size());
+  initial_state_.Exit();
+  erl_estimator_.Restore(state.erl, state.erl_time_domain);
+  erle_estimator_.Restore(state.erle, state.erle_onsets,
+                          state.fullband_erle_log2);
+  reverb_model_estimator_.Restore(state.reverb_decay,
+                                  state.reverb_average_decay,
+                                  state.reverb_frequency_response);
+}
+
 AecState::InitialState::InitialState(const EchoCanceller3Config& config)
     : conservative_initial_phase_(config.filter.conservative_initial_phase),
       initial_state_seconds_(config.filter.initial_state_seconds) {
@@ -351,6 +395,15 @@ void AecState::InitialState::InitialState::Update(bool active_render,
   transition_triggered_ = !initial_state_ && prev_initial_state;
 }
 
+void AecState::InitialState::Exit() {
+  initial_state_ = false;
+  transition_triggered_ = false;
+  strong_not_saturated_render_blocks_ =
+      conservative_initial_phase_
+          ? 5 * kNumBlocksPerSecond
+          : static_cast<size_t>(initial_state_seconds_ * kNumBlocksPerSecond);
+}
+
 AecState::FilterDelay::FilterDelay(const EchoCanceller3Config& config,
                                    size_t num_capture_channels)
     : delay_headroom_samples_(config.delay.delay_headroom_samples),
@@ -387,6 +440,69 @@ void AecState::FilterDelay::Update(
                                         filter_delays_blocks_.end());
 }
 
+AecState::SteadyStateDetector::SteadyStateDetector(
+    const EchoCanceller3Config& config)
+    : enabled_(config.duty_cycling.enabled),
+      steady_state_blocks_(config.duty_cycling.steady_state_blocks) {}
+
+void AecState::SteadyStateDetector::Reset() {
+  steady_blocks_ = 0;
+  steady_state_ = false;
+}
+
+void AecState::SteadyStateDetector::Update(
+    rtc::ArrayView<const SubtractorOutput> subtractor_output,
+    bool all_filters_diverged,
+    bool active_render,
+    bool saturated_capture,
+    float fullband_erle_log2) {
+  if (!enabled_) {
+    return;
+  }
+
+  if (all_filters_diverged) {
+    Reset();
+    return;
+  }
+
+  // Only blocks with enough render and capture activity say anything about
+  // the convergence; keep the current decision during the others.
+  if (!active_render || saturated_capture) {
+    return;
+  }
+
+  constexpr float kConvergenceThreshold = 50 * 50 * kBlockSize;
+  bool all_refined_filters_converged = true;
+  bool echo_present = false;
+  for (const auto& output : subtractor_output) {
+    if (output.y2 > kConvergenceThreshold) {
+      echo_present = true;
+      all_refined_filters_converged =
+          all_refined_filters_converged && output.e2_refined < 0.5f * output.y2;
+    }
+  }
+  if (!echo_present) {
+    return;
+  }
+
+  // The ERLE is considered steady when it stays within about 3 dB of its
+  // smoothed value.
+  constexpr float kErleSmoothing = 0.02f;
+  constexpr float kMaxErleDeviationLog2 = 0.5f;
+  smoothed_erle_log2_ +=
+      kErleSmoothing * (fullband_erle_log2 - smoothed_erle_log2_);
+  const bool steady_erle = fabsf(fullband_erle_log2 - smoothed_erle_log2_) <
+                           kMaxErleDeviationLog2;
+
+  if (!all_refined_filters_converged || !steady_erle) {
+    Reset();
+    return;
+  }
+
+  ++steady_blocks_;
+  steady_state_ = steady_blocks_ >= steady_state_blocks_;
+}
+
 AecState::TransparentMode::TransparentMode(const EchoCanceller3Config& config)
     : bounded_erl_(config.ep_strength.bounded_erl),
       linear_and_stable_echo_path_(
@@ -530,7 +646,7 @@ void AecState::FilteringQualityAnalyzer::Update(
 }
 
 void AecState::SaturationDetector::Update(
-    rtc::ArrayView<const std::vector<float>> x,
+    const Block& x,
     bool saturated_capture,
     bool usable_linear_estimate,
     rtc::ArrayView<const SubtractorOutput> subtractor_output,
@@ -550,8 +666,8 @@ void AecState::SaturationDetector::Update(
     }
   } else {
     float max_sample = 0.f;
-    for (auto& channel : x) {
-      for (float sample : channel) {
+    for (size_t ch = 0; ch < x.NumChannels(); ++ch) {
+      for (float sample : x.View(/*band=*/0, ch)) {
         max_sample = std::max(max_sample, fabsf(sample));
       }
     }
@@ -21,6 +21,7 @@
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/echo_audibility.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
@@ -31,6 +32,7 @@
 #include "modules/audio_processing/aec3/reverb_model_estimator.h"
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "modules/audio_processing/aec3/subtractor_output_analyzer.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 
 namespace webrtc {
 
@@ -141,6 +143,18 @@ class AecState {
       rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
       rtc::ArrayView<const SubtractorOutput> subtractor_output);
 
+  // Returns whether the echo canceller has been converged for long enough for
+  // the delay search and the coarse filter adaptation to be duty cycled.
+  bool SteadyState() const { return steady_state_.Active(); }
+
+  // Stores the ERL, ERLE and reverb model estimates in |state|.
+  void GetWarmStartState(WarmStartState* state) const;
+
+  // Restores the ERL, ERLE and reverb model estimates from |state| and leaves
+  // the initial state. The dimensions of |state| must match the echo
+  // canceller.
+  void SetWarmStartState(const WarmStartState& state);
+
   // Returns filter length in blocks.
   int FilterLengthBlocks() const {
     // All filters have the same length, so arbitrarily return channel 0 length.
@@ -168,6 +182,9 @@ class AecState {
     // Updates the state based on new data.
     void Update(bool active_render, bool saturated_capture);
 
+    // Leaves the initial state without triggering the transition.
+    void Exit();
+
     // Returns whether the initial state is active or not.
     bool InitialStateActive() const { return initial_state_; }
 
@@ -300,7 +317,7 @@ class AecState {
     bool SaturatedEcho() const { return saturated_echo_; }
 
     // Updates the detection decision based on new data.
-    void Update(rtc::ArrayView<const std::vector<float>> x,
+    void Update(const Block& x,
                 bool saturated_capture,
                 bool usable_linear_estimate,
                 rtc::ArrayView<const SubtractorOutput> subtractor_output,
@@ -310,6 +327,33 @@ class AecState {
     bool saturated_echo_ = false;
   } saturation_detector_;
 
+  // Class for detecting a steady state where all the refined filters are
+  // converged and the fullband ERLE is stable.
+  class SteadyStateDetector {
+   public:
+    explicit SteadyStateDetector(const EchoCanceller3Config& config);
+
+    // Returns whether the steady state is active.
+    bool Active() const { return steady_state_; }
+
+    // Resets the detector to the non-steady state.
+    void Reset();
+
+    // Updates the detection decision based on new data.
+    void Update(rtc::ArrayView<const SubtractorOutput> subtractor_output,
+                bool all_filters_diverged,
+                bool active_render,
+                bool saturated_capture,
+                float fullband_erle_log2);
+
+   private:
+    const bool enabled_;
+    const size_t steady_state_blocks_;
+    size_t steady_blocks_ = 0;
+    float smoothed_erle_log2_ = 0.f;
+    bool steady_state_ = false;
+  } steady_state_;
+
   ErlEstimator erl_estimator_;
   ErleEstimator erle_estimator_;
   size_t strong_not_saturated_render_blocks_ = 0;
@@ -35,9 +35,7 @@ void RunNormalUsageTest(size_t num_render_channels,
   std::vector<std::array<float, kFftLengthBy2Plus1>> E2_refined(
       num_capture_channels);
   std::vector<std::array<float, kFftLengthBy2Plus1>> Y2(num_capture_channels);
-  std::vector<std::vector<std::vector<float>>> x(
-      kNumBands, std::vector<std::vector<float>>(
-                     num_render_channels, std::vector<float>(kBlockSize, 0.f)));
+  Block x(kNumBands, num_render_channels);
   EchoPathVariability echo_path_variability(
       false, EchoPathVariability::DelayAdjustment::kNone, false);
   std::vector<std::array<float, kBlockSize>> y(num_capture_channels);
@@ -72,7 +70,7 @@ void RunNormalUsageTest(size_t num_render_channels,
   // Verify that linear AEC usability is true when the filter is converged
   for (size_t band = 0; band < kNumBands; ++band) {
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
-      std::fill(x[band][ch].begin(), x[band][ch].end(), 101.f);
+      std::fill(x.begin(band, ch), x.end(band, ch), 101.f);
     }
   }
   for (int k = 0; k < 3000; ++k) {
@@ -100,7 +98,7 @@ void RunNormalUsageTest(size_t num_render_channels,
 
   // Verify that the active render detection works as intended.
   for (size_t ch = 0; ch < num_render_channels; ++ch) {
-    std::fill(x[0][ch].begin(), x[0][ch].end(), 101.f);
+    std::fill(x.begin(/*band=*/0, ch), x.end(/*band=*/0, ch), 101.f);
   }
   render_delay_buffer->Insert(x);
   for (size_t ch = 0; ch < num_capture_channels; ++ch) {
@@ -125,14 +123,14 @@ void RunNormalUsageTest(size_t num_render_channels,
   EXPECT_TRUE(state.ActiveRender());
 
   // Verify that the ERL is properly estimated
-  for (auto& band : x) {
-    for (auto& channel : band) {
-      channel = std::vector<float>(kBlockSize, 0.f);
+  for (size_t band = 0; band < kNumBands; ++band) {
+    for (size_t ch = 0; ch < num_render_channels; ++ch) {
+      std::fill(x.begin(band, ch), x.end(band, ch), 0.f);
     }
   }
 
   for (size_t ch = 0; ch < num_render_channels; ++ch) {
-    x[0][ch][0] = 5000.f;
+    x.View(/*band=*/0, ch)[0] = 5000.f;
   }
   for (size_t k = 0;
        k < render_delay_buffer->GetRenderBuffer()->GetFftBuffer().size(); ++k) {
@@ -296,4 +294,115 @@ TEST(AecState, ConvergedFilterDelay) {
   }
 }
 
+// Verifies that the steady state is detected for converged filters and that it
+// is left at echo path changes and filter divergence.
+TEST(AecState, SteadyStateDetection) {
+  constexpr size_t kNumCaptureChannels = 1;
+  constexpr size_t kNumBands = NumBandsForRate(48000);
+  EchoCanceller3Config config;
+  config.duty_cycling.enabled = true;
+  config.duty_cycling.steady_state_blocks = 100;
+  AecState state(config, kNumCaptureChannels);
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, 48000, 1));
+  absl::optional<DelayEstimate> delay_estimate =
+      DelayEstimate(DelayEstimate::Quality::kRefined, 10);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> E2_refined(
+      kNumCaptureChannels);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> Y2(kNumCaptureChannels);
+  Block x(kNumBands, 1, 101.f);
+  std::vector<SubtractorOutput> subtractor_output(kNumCaptureChannels);
+  subtractor_output[0].Reset();
+  std::array<float, kBlockSize> y;
+  y.fill(1000.f);
+  E2_refined[0].fill(0.f);
+  Y2[0].fill(0.f);
+
+  std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>
+  frequency_response(
+      kNumCaptureChannels, std::vector<std::array<float, kFftLengthBy2Plus1>>(
+                               config.filter.refined.length_blocks));
+  for (auto& v_ch : frequency_response) {
+    for (auto& v : v_ch) {
+      v.fill(0.01f);
+    }
+  }
+  std::vector<std::vector<float>> impulse_response(
+      kNumCaptureChannels,
+      std::vector<float>(
+          GetTimeDomainLength(config.filter.refined.length_blocks), 0.f));
+
+  auto process_blocks = [&](int num_blocks, float e) {
+    subtractor_output[0].e_refined.fill(e);
+    subtractor_output[0].e_coarse.fill(e);
+    for (int k = 0; k < num_blocks; ++k) {
+      render_delay_buffer->Insert(x);
+      subtractor_output[0].ComputeMetrics(y);
+      state.Update(delay_estimate, frequency_response, impulse_response,
+                   *render_delay_buffer->GetRenderBuffer(), E2_refined, Y2,
+                   subtractor_output);
+    }
+  };
+
+  // Converged filters.
+  process_blocks(50, 100.f);
+  EXPECT_FALSE(state.SteadyState());
+  process_blocks(1000, 100.f);
+  EXPECT_TRUE(state.SteadyState());
+
+  // A block without any change does not affect the steady state.
+  state.HandleEchoPathChange(EchoPathVariability(
+      false, EchoPathVariability::DelayAdjustment::kNone, false));
+  EXPECT_TRUE(state.SteadyState());
+
+  // An echo path change resets the steady state.
+  state.HandleEchoPathChange(EchoPathVariability(
+      true, EchoPathVariability::DelayAdjustment::kNone, false));
+  EXPECT_FALSE(state.SteadyState());
+  process_blocks(1000, 100.f);
+  EXPECT_TRUE(state.SteadyState());
+
+  // Diverged filters reset the steady state.
+  process_blocks(1, 2000.f);
+  EXPECT_FALSE(state.SteadyState());
+}
+
+// Verifies that the steady state is never reported when duty cycling is not
+// enabled.
+TEST(AecState, NoSteadyStateWithoutDutyCycling) {
+  EchoCanceller3Config config;
+  config.duty_cycling.steady_state_blocks = 1;
+  AecState state(config, 1);
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, 16000, 1));
+  std::vector<std::array<float, kFftLengthBy2Plus1>> E2_refined(1);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> Y2(1);
+  E2_refined[0].fill(0.f);
+  Y2[0].fill(0.f);
+  Block x(1, 1, 101.f);
+  std::vector<SubtractorOutput> subtractor_output(1);
+  subtractor_output[0].Reset();
+  subtractor_output[0].e_refined.fill(100.f);
+  std::array<float, kBlockSize> y;
+  y.fill(1000.f);
+  std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>
+  frequency_response(1, std::vector<std::array<float, kFftLengthBy2Plus1>>(
+                            config.filter.refined.length_blocks));
+  for (auto& v : frequency_response[0]) {
+    v.fill(0.01f);
+  }
+  std::vector<std::vector<float>> impulse_response(
+      1, std::vector<float>(
+             GetTimeDomainLength(config.filter.refined.length_blocks), 0.f));
+
+  for (int k = 0; k < 1000; ++k) {
+    render_delay_buffer->Insert(x);
+    subtractor_output[0].ComputeMetrics(y);
+    state.Update(absl::nullopt, frequency_response, impulse_response,
+                 *render_delay_buffer->GetRenderBuffer(), E2_refined, Y2,
+                 subtractor_output);
+    EXPECT_FALSE(state.SteadyState());
+  }
+}
+
 }  // namespace webrtc
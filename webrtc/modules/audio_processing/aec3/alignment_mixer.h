@@ -16,6 +16,7 @@
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/block.h"
 
 namespace webrtc {
 
@@ -33,8 +34,8 @@ class AlignmentMixer {
                  float excitation_limit,
                  bool prefer_first_two_channels);
 
-  void ProduceOutput(rtc::ArrayView<const std::vector<float>> x,
-                     rtc::ArrayView<float, kBlockSize> y);
+  // Produces the mixed output from the lowest band of |x|.
+  void ProduceOutput(const Block& x, rtc::ArrayView<float, kBlockSize> y);
 
   enum class MixingVariant { kDownmix, kAdaptive, kFixed };
 
@@ -49,9 +50,8 @@ class AlignmentMixer {
   int selected_channel_ = 0;
   size_t block_counter_ = 0;
 
-  void Downmix(const rtc::ArrayView<const std::vector<float>> x,
-               rtc::ArrayView<float, kBlockSize> y) const;
-  int SelectChannel(rtc::ArrayView<const std::vector<float>> x);
+  void Downmix(const Block& x, rtc::ArrayView<float, kBlockSize> y) const;
+  int SelectChannel(const Block& x);
 };
 }  // namespace webrtc
 
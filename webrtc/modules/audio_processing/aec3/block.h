@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_BLOCK_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_BLOCK_H_
+
+#include <stddef.h>
+
+#include <utility>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Multiband, multichannel audio where each channel of each band holds
+// |kLength| samples. All samples are stored in a single contiguous
+// allocation, band by band and channel by channel, so that copying, swapping
+// and iterating over the content touches no per-band or per-channel heap
+// objects.
+template <size_t kLength>
+class MultiBandAudio {
+ public:
+  MultiBandAudio(size_t num_bands,
+                 size_t num_channels,
+                 float default_value = 0.f)
+      : num_bands_(num_bands),
+        num_channels_(num_channels),
+        data_(num_bands * num_channels * kLength, default_value) {}
+
+  size_t NumBands() const { return num_bands_; }
+  size_t NumChannels() const { return num_channels_; }
+
+  // Iterators over the samples of one channel of one band.
+  float* begin(size_t band, size_t channel) {
+    return &data_[Index(band, channel)];
+  }
+  const float* begin(size_t band, size_t channel) const {
+    return &data_[Index(band, channel)];
+  }
+  float* end(size_t band, size_t channel) {
+    return begin(band, channel) + kLength;
+  }
+  const float* end(size_t band, size_t channel) const {
+    return begin(band, channel) + kLength;
+  }
+
+  // Views of the samples of one channel of one band.
+  rtc::ArrayView<float, kLength> View(size_t band, size_t channel) {
+    return rtc::ArrayView<float, kLength>(begin(band, channel), kLength);
+  }
+  rtc::ArrayView<const float, kLength> View(size_t band,
+                                            size_t channel) const {
+    return rtc::ArrayView<const float, kLength>(begin(band, channel),
+                                                kLength);
+  }
+
+  // Exchanges the content with |other| without copying any samples.
+  void Swap(MultiBandAudio* other) {
+    std::swap(num_bands_, other->num_bands_);
+    std::swap(num_channels_, other->num_channels_);
+    data_.swap(other->data_);
+  }
+
+ private:
+  size_t Index(size_t band, size_t channel) const {
+    RTC_DCHECK_LT(band, num_bands_);
+    RTC_DCHECK_LT(channel, num_channels_);
+    return (band * num_channels_ + channel) * kLength;
+  }
+
+  size_t num_bands_;
+  size_t num_channels_;
+  std::vector<float> data_;
+};
+
+// Contains one or more channels of 4 milliseconds of audio, split into one or
+// more frequency bands each sampled at 16 kHz.
+using Block = MultiBandAudio<kBlockSize>;
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_BLOCK_H_
@@ -49,14 +49,12 @@ class BlockProcessorImpl final : public BlockProcessor {
 
   ~BlockProcessorImpl() override;
 
-  void ProcessCapture(
-      bool echo_path_gain_change,
-      bool capture_signal_saturation,
-      std::vector<std::vector<std::vector<float>>>* linear_output,
-      std::vector<std::vector<std::vector<float>>>* capture_block) override;
+  void ProcessCapture(bool echo_path_gain_change,
+                      bool capture_signal_saturation,
+                      Block* linear_output,
+                      Block* capture_block) override;
 
-  void BufferRender(
-      const std::vector<std::vector<std::vector<float>>>& block) override;
+  void BufferRender(const Block& block) override;
 
   void UpdateEchoLeakageStatus(bool leakage_detected) override;
 
@@ -64,6 +62,10 @@ class BlockProcessorImpl final : public BlockProcessor {
 
   void SetAudioBufferDelay(int delay_ms) override;
 
+  void GetWarmStartState(WarmStartState* state) const override;
+
+  bool SetWarmStartState(const WarmStartState& state) override;
+
  private:
   static int instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
@@ -78,6 +80,7 @@ class BlockProcessorImpl final : public BlockProcessor {
   RenderDelayBuffer::BufferingEvent render_event_;
   size_t capture_call_counter_ = 0;
   absl::optional<DelayEstimate> estimated_delay_;
+  absl::optional<size_t> warm_start_delay_blocks_;
 };
 
 int BlockProcessorImpl::instance_count_ = 0;
@@ -103,21 +106,20 @@ BlockProcessorImpl::BlockProcessorImpl(
 
 BlockProcessorImpl::~BlockProcessorImpl() = default;
 
-void BlockProcessorImpl::ProcessCapture(
-    bool echo_path_gain_change,
-    bool capture_signal_saturation,
-    std::vector<std::vector<std::vector<float>>>* linear_output,
-    std::vector<std::vector<std::vector<float>>>* capture_block) {
+void BlockProcessorImpl::ProcessCapture(bool echo_path_gain_change,
+                                        bool capture_signal_saturation,
+                                        Block* linear_output,
+                                        Block* capture_block) {
   RTC_DCHECK(capture_block);
-  RTC_DCHECK_EQ(NumBandsForRate(sample_rate_hz_), capture_block->size());
-  RTC_DCHECK_EQ(kBlockSize, (*capture_block)[0][0].size());
+  RTC_DCHECK_EQ(NumBandsForRate(sample_rate_hz_), capture_block->NumBands());
 
   capture_call_counter_++;
 
   data_dumper_->DumpRaw("aec3_processblock_call_order",
                         static_cast<int>(BlockProcessorApiCall::kCapture));
   data_dumper_->DumpWav("aec3_processblock_capture_input", kBlockSize,
-                        &(*capture_block)[0][0][0], 16000, 1);
+                        capture_block->begin(/*band=*/0, /*channel=*/0), 16000,
+                        1);
 
   if (render_properly_started_) {
     if (!capture_properly_started_) {
@@ -158,21 +160,30 @@ void BlockProcessorImpl::ProcessCapture(
   }
 
   data_dumper_->DumpWav("aec3_processblock_capture_input2", kBlockSize,
-                        &(*capture_block)[0][0][0], 16000, 1);
+                        capture_block->begin(/*band=*/0, /*channel=*/0), 16000,
+                        1);
 
   bool has_delay_estimator = !config_.delay.use_external_delay_estimator;
   if (has_delay_estimator) {
     RTC_DCHECK(delay_controller_);
     // Compute and apply the render delay required to achieve proper signal
-    // alignment.
+    // alignment. The delay search is duty cycled while the echo remover is in
+    // its steady state.
+    delay_controller_->SetSteadyState(echo_remover_->SteadyState());
     estimated_delay_ = delay_controller_->GetDelay(
         render_buffer_->GetDownsampledRenderBuffer(), render_buffer_->Delay(),
-        (*capture_block)[0]);
+        *capture_block);
 
     if (estimated_delay_) {
       bool delay_change =
           render_buffer_->AlignFromDelay(estimated_delay_->delay);
-      if (delay_change) {
+      // Aligning to a restored delay is not an echo path change, as the
+      // restored filters already match that delay.
+      const bool warm_start_alignment =
+          warm_start_delay_blocks_ &&
+          *warm_start_delay_blocks_ == estimated_delay_->delay;
+      warm_start_delay_blocks_ = absl::nullopt;
+      if (delay_change && !warm_start_alignment) {
         rtc::LoggingSeverity log_level =
             config_.delay.log_warning_on_delay_changes ? rtc::LS_WARNING
                                                        : rtc::LS_INFO;
@@ -200,16 +211,14 @@ void BlockProcessorImpl::ProcessCapture(
   metrics_.UpdateCapture(false);
 }
 
-void BlockProcessorImpl::BufferRender(
-    const std::vector<std::vector<std::vector<float>>>& block) {
-  RTC_DCHECK_EQ(NumBandsForRate(sample_rate_hz_), block.size());
-  RTC_DCHECK_EQ(kBlockSize, block[0][0].size());
+void BlockProcessorImpl::BufferRender(const Block& block) {
+  RTC_DCHECK_EQ(NumBandsForRate(sample_rate_hz_), block.NumBands());
   data_dumper_->DumpRaw("aec3_processblock_call_order",
                         static_cast<int>(BlockProcessorApiCall::kRender));
   data_dumper_->DumpWav("aec3_processblock_render_input", kBlockSize,
-                        &block[0][0][0], 16000, 1);
+                        block.begin(/*band=*/0, /*channel=*/0), 16000, 1);
   data_dumper_->DumpWav("aec3_processblock_render_input2", kBlockSize,
-                        &block[0][0][0], 16000, 1);
+                        block.begin(/*band=*/0, /*channel=*/0), 16000, 1);
 
   render_event_ = render_buffer_->Insert(block);
 
@@ -236,6 +245,26 @@ void BlockProcessorImpl::SetAudioBufferDelay(int delay_ms) {
   render_buffer_->SetAudioBufferDelay(delay_ms);
 }
 
+void BlockProcessorImpl::GetWarmStartState(WarmStartState* state) const {
+  RTC_DCHECK(state);
+  echo_remover_->GetWarmStartState(state);
+  state->delay_blocks = absl::nullopt;
+  if (delay_controller_ && estimated_delay_) {
+    state->delay_blocks = estimated_delay_->delay;
+  }
+}
+
+bool BlockProcessorImpl::SetWarmStartState(const WarmStartState& state) {
+  if (!echo_remover_->SetWarmStartState(state)) {
+    return false;
+  }
+  if (delay_controller_ && state.delay_blocks) {
+    delay_controller_->SetWarmStartDelay(*state.delay_blocks);
+    warm_start_delay_blocks_ = state.delay_blocks;
+  }
+  return true;
+}
+
 }  // namespace
 
 BlockProcessor* BlockProcessor::Create(const EchoCanceller3Config& config,
@@ -18,9 +18,11 @@
 
 #include "api/audio/echo_canceller3_config.h"
 #include "api/audio/echo_control.h"
+#include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/echo_remover.h"
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 #include "modules/audio_processing/aec3/render_delay_controller.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 
 namespace webrtc {
 
@@ -56,19 +58,25 @@ class BlockProcessor {
   virtual void SetAudioBufferDelay(int delay_ms) = 0;
 
   // Processes a block of capture data.
-  virtual void ProcessCapture(
-      bool echo_path_gain_change,
-      bool capture_signal_saturation,
-      std::vector<std::vector<std::vector<float>>>* linear_output,
-      std::vector<std::vector<std::vector<float>>>* capture_block) = 0;
+  virtual void ProcessCapture(bool echo_path_gain_change,
+                              bool capture_signal_saturation,
+                              Block* linear_output,
+                              Block* capture_block) = 0;
 
   // Buffers a block of render data supplied by a FrameBlocker object.
-  virtual void BufferRender(
-      const std::vector<std::vector<std::vector<float>>>& render_block) = 0;
+  virtual void BufferRender(const Block& render_block) = 0;
 
   // Reports whether echo leakage has been detected in the echo canceller
   // output.
   virtual void UpdateEchoLeakageStatus(bool leakage_detected) = 0;
+
+  // Stores the adaptive state of the echo canceller in |state|.
+  virtual void GetWarmStartState(WarmStartState* state) const = 0;
+
+  // Restores the adaptive state of the echo canceller from |state|. Returns
+  // false, leaving the block processor untouched, if the dimensions of |state|
+  // do not match the block processor.
+  virtual bool SetWarmStartState(const WarmStartState& state) = 0;
 };
 
 }  // namespace webrtc
@@ -221,16 +221,16 @@ void FillSubFrameView(
 }
 
 void FillSubFrameView(
-    std::vector<std::vector<std::vector<float>>>* frame,
+    Aec3RenderQueueItem* frame,
     size_t sub_frame_index,
     std::vector<std::vector<rtc::ArrayView<float>>>* sub_frame_view) {
   RTC_DCHECK_GE(1, sub_frame_index);
-  RTC_DCHECK_EQ(frame->size(), sub_frame_view->size());
-  RTC_DCHECK_EQ((*frame)[0].size(), (*sub_frame_view)[0].size());
-  for (size_t band = 0; band < frame->size(); ++band) {
-    for (size_t channel = 0; channel < (*frame)[band].size(); ++channel) {
+  RTC_DCHECK_EQ(frame->NumBands(), sub_frame_view->size());
+  RTC_DCHECK_EQ(frame->NumChannels(), (*sub_frame_view)[0].size());
+  for (size_t band = 0; band < frame->NumBands(); ++band) {
+    for (size_t channel = 0; channel < frame->NumChannels(); ++channel) {
       (*sub_frame_view)[band][channel] = rtc::ArrayView<float>(
-          &(*frame)[band][channel][sub_frame_index * kSubFrameLength],
+          frame->begin(band, channel) + sub_frame_index * kSubFrameLength,
           kSubFrameLength);
     }
   }
@@ -246,10 +246,10 @@ void ProcessCaptureFrameContent(
     BlockFramer* linear_output_framer,
     BlockFramer* output_framer,
     BlockProcessor* block_processor,
-    std::vector<std::vector<std::vector<float>>>* linear_output_block,
+    Block* linear_output_block,
     std::vector<std::vector<rtc::ArrayView<float>>>*
         linear_output_sub_frame_view,
-    std::vector<std::vector<std::vector<float>>>* capture_block,
+    Block* capture_block,
     std::vector<std::vector<rtc::ArrayView<float>>>* capture_sub_frame_view) {
   FillSubFrameView(capture, sub_frame_index, capture_sub_frame_view);
 
@@ -282,8 +282,8 @@ void ProcessRemainingCaptureFrameContent(
     BlockFramer* linear_output_framer,
     BlockFramer* output_framer,
     BlockProcessor* block_processor,
-    std::vector<std::vector<std::vector<float>>>* linear_output_block,
-    std::vector<std::vector<std::vector<float>>>* block) {
+    Block* linear_output_block,
+    Block* block) {
   if (!capture_blocker->IsBlockAvailable()) {
     return;
   }
@@ -300,21 +300,20 @@ void ProcessRemainingCaptureFrameContent(
 }
 
 void BufferRenderFrameContent(
-    std::vector<std::vector<std::vector<float>>>* render_frame,
+    Aec3RenderQueueItem* render_frame,
     size_t sub_frame_index,
     FrameBlocker* render_blocker,
     BlockProcessor* block_processor,
-    std::vector<std::vector<std::vector<float>>>* block,
+    Block* block,
     std::vector<std::vector<rtc::ArrayView<float>>>* sub_frame_view) {
   FillSubFrameView(render_frame, sub_frame_index, sub_frame_view);
   render_blocker->InsertSubFrameAndExtractBlock(*sub_frame_view, block);
   block_processor->BufferRender(*block);
 }
 
-void BufferRemainingRenderFrameContent(
-    FrameBlocker* render_blocker,
-    BlockProcessor* block_processor,
-    std::vector<std::vector<std::vector<float>>>* block) {
+void BufferRemainingRenderFrameContent(FrameBlocker* render_blocker,
+                                       BlockProcessor* block_processor,
+                                       Block* block) {
   if (!render_blocker->IsBlockAvailable()) {
     return;
   }
@@ -325,17 +324,16 @@ void BufferRemainingRenderFrameContent(
 void CopyBufferIntoFrame(const AudioBuffer& buffer,
                          size_t num_bands,
                          size_t num_channels,
-                         std::vector<std::vector<std::vector<float>>>* frame) {
-  RTC_DCHECK_EQ(num_bands, frame->size());
-  RTC_DCHECK_EQ(num_channels, (*frame)[0].size());
-  RTC_DCHECK_EQ(AudioBuffer::kSplitBandSize, (*frame)[0][0].size());
+                         Aec3RenderQueueItem* frame) {
+  RTC_DCHECK_EQ(num_bands, frame->NumBands());
+  RTC_DCHECK_EQ(num_channels, frame->NumChannels());
   for (size_t band = 0; band < num_bands; ++band) {
     for (size_t channel = 0; channel < num_channels; ++channel) {
       rtc::ArrayView<const float> buffer_view(
           &buffer.split_bands_const(channel)[band][0],
           AudioBuffer::kSplitBandSize);
       std::copy(buffer_view.begin(), buffer_view.end(),
-                (*frame)[band][channel].begin());
+                frame->begin(band, channel));
     }
   }
 }
@@ -345,8 +343,8 @@ void CopyBufferIntoFrame(const AudioBuffer& buffer,
 class EchoCanceller3::RenderWriter {
  public:
   RenderWriter(ApmDataDumper* data_dumper,
-               SwapQueue<std::vector<std::vector<std::vector<float>>>,
-                         Aec3RenderQueueItemVerifier>* render_transfer_queue,
+               SwapQueue<Aec3RenderQueueItem, Aec3RenderQueueItemVerifier>*
+                   render_transfer_queue,
                size_t num_bands,
                size_t num_channels);
   ~RenderWriter();
@@ -357,27 +355,23 @@ class EchoCanceller3::RenderWriter {
   const size_t num_bands_;
   const size_t num_channels_;
   HighPassFilter high_pass_filter_;
-  std::vector<std::vector<std::vector<float>>> render_queue_input_frame_;
-  SwapQueue<std::vector<std::vector<std::vector<float>>>,
-            Aec3RenderQueueItemVerifier>* render_transfer_queue_;
+  Aec3RenderQueueItem render_queue_input_frame_;
+  SwapQueue<Aec3RenderQueueItem, Aec3RenderQueueItemVerifier>*
+      render_transfer_queue_;
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RenderWriter);
 };
 
 EchoCanceller3::RenderWriter::RenderWriter(
     ApmDataDumper* data_dumper,
-    SwapQueue<std::vector<std::vector<std::vector<float>>>,
-              Aec3RenderQueueItemVerifier>* render_transfer_queue,
+    SwapQueue<Aec3RenderQueueItem, Aec3RenderQueueItemVerifier>*
+        render_transfer_queue,
     size_t num_bands,
     size_t num_channels)
     : data_dumper_(data_dumper),
       num_bands_(num_bands),
       num_channels_(num_channels),
       high_pass_filter_(16000, num_channels),
-      render_queue_input_frame_(
-          num_bands_,
-          std::vector<std::vector<float>>(
-              num_channels_,
-              std::vector<float>(AudioBuffer::kSplitBandSize, 0.f))),
+      render_queue_input_frame_(num_bands_, num_channels_),
       render_transfer_queue_(render_transfer_queue) {
   RTC_DCHECK(data_dumper);
 }
@@ -398,7 +392,10 @@ void EchoCanceller3::RenderWriter::Insert(const AudioBuffer& input) {
 
   CopyBufferIntoFrame(input, num_bands_, num_channels_,
                       &render_queue_input_frame_);
-  high_pass_filter_.Process(&render_queue_input_frame_[0]);
+  for (size_t channel = 0; channel < num_channels_; ++channel) {
+    high_pass_filter_.Process(
+        channel, render_queue_input_frame_.View(/*band=*/0, channel));
+  }
 
   static_cast<void>(render_transfer_queue_->Insert(&render_queue_input_frame_));
 }
@@ -435,28 +432,12 @@ EchoCanceller3::EchoCanceller3(const EchoCanceller3Config& config,
       render_blocker_(num_bands_, num_render_channels_),
       render_transfer_queue_(
           kRenderTransferQueueSizeFrames,
-          std::vector<std::vector<std::vector<float>>>(
-              num_bands_,
-              std::vector<std::vector<float>>(
-                  num_render_channels_,
-                  std::vector<float>(AudioBuffer::kSplitBandSize, 0.f))),
-          Aec3RenderQueueItemVerifier(num_bands_,
-                                      num_render_channels_,
-                                      AudioBuffer::kSplitBandSize)),
+          Aec3RenderQueueItem(num_bands_, num_render_channels_),
+          Aec3RenderQueueItemVerifier(num_bands_, num_render_channels_)),
       block_processor_(std::move(block_processor)),
-      render_queue_output_frame_(
-          num_bands_,
-          std::vector<std::vector<float>>(
-              num_render_channels_,
-              std::vector<float>(AudioBuffer::kSplitBandSize, 0.f))),
-      render_block_(
-          num_bands_,
-          std::vector<std::vector<float>>(num_render_channels_,
-                                          std::vector<float>(kBlockSize, 0.f))),
-      capture_block_(
-          num_bands_,
-          std::vector<std::vector<float>>(num_capture_channels_,
-                                          std::vector<float>(kBlockSize, 0.f))),
+      render_queue_output_frame_(num_bands_, num_render_channels_),
+      render_block_(num_bands_, num_render_channels_),
+      capture_block_(num_bands_, num_capture_channels_),
       render_sub_frame_view_(
           num_bands_,
           std::vector<rtc::ArrayView<float>>(num_render_channels_)),
@@ -481,9 +462,7 @@ EchoCanceller3::EchoCanceller3(const EchoCanceller3Config& config,
   if (config_.filter.export_linear_aec_output) {
     linear_output_framer_.reset(new BlockFramer(1, num_capture_channels_));
     linear_output_block_ =
-        std::make_unique<std::vector<std::vector<std::vector<float>>>>(
-            1, std::vector<std::vector<float>>(
-                   num_capture_channels_, std::vector<float>(kBlockSize, 0.f)));
+        std::make_unique<Block>(/*num_bands=*/1, num_capture_channels_);
     linear_output_sub_frame_view_ =
         std::vector<std::vector<rtc::ArrayView<float>>>(
             1, std::vector<rtc::ArrayView<float>>(num_capture_channels_));
@@ -590,6 +569,26 @@ void EchoCanceller3::SetAudioBufferDelay(int delay_ms) {
   block_processor_->SetAudioBufferDelay(delay_ms);
 }
 
+void EchoCanceller3::GetWarmStartState(std::vector<uint8_t>* state) const {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  RTC_DCHECK(state);
+  WarmStartState warm_start_state;
+  block_processor_->GetWarmStartState(&warm_start_state);
+  SerializeWarmStartState(warm_start_state, state);
+}
+
+bool EchoCanceller3::SetWarmStartState(rtc::ArrayView<const uint8_t> state) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  WarmStartState warm_start_state;
+  if (!ParseWarmStartState(state, &warm_start_state) ||
+      !block_processor_->SetWarmStartState(warm_start_state)) {
+    RTC_LOG(LS_WARNING) << "Ignoring invalid AEC3 warm start state of "
+                        << state.size() << " bytes.";
+    return false;
+  }
+  return true;
+}
+
 bool EchoCanceller3::ActiveProcessing() const {
   return true;
 }
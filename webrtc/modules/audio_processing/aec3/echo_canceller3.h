@@ -12,6 +12,7 @@
 #define MODULES_AUDIO_PROCESSING_AEC3_ECHO_CANCELLER3_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <memory>
 #include <vector>
@@ -20,6 +21,7 @@
 #include "api/audio/echo_canceller3_config.h"
 #include "api/audio/echo_control.h"
 #include "modules/audio_processing/aec3/api_call_jitter_metrics.h"
+#include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/block_delay_buffer.h"
 #include "modules/audio_processing/aec3/block_framer.h"
 #include "modules/audio_processing/aec3/block_processor.h"
@@ -33,38 +35,24 @@
 
 namespace webrtc {
 
+// Multiband, multichannel 10 ms frame of render audio, as transferred through
+// the render queue.
+using Aec3RenderQueueItem = MultiBandAudio<AudioBuffer::kSplitBandSize>;
+
 // Functor for verifying the invariance of the frames being put into the render
 // queue.
 class Aec3RenderQueueItemVerifier {
  public:
-  Aec3RenderQueueItemVerifier(size_t num_bands,
-                              size_t num_channels,
-                              size_t frame_length)
-      : num_bands_(num_bands),
-        num_channels_(num_channels),
-        frame_length_(frame_length) {}
-
-  bool operator()(const std::vector<std::vector<std::vector<float>>>& v) const {
-    if (v.size() != num_bands_) {
-      return false;
-    }
-    for (const auto& band : v) {
-      if (band.size() != num_channels_) {
-        return false;
-      }
-      for (const auto& channel : band) {
-        if (channel.size() != frame_length_) {
-          return false;
-        }
-      }
-    }
-    return true;
+  Aec3RenderQueueItemVerifier(size_t num_bands, size_t num_channels)
+      : num_bands_(num_bands), num_channels_(num_channels) {}
+
+  bool operator()(const Aec3RenderQueueItem& v) const {
+    return v.NumBands() == num_bands_ && v.NumChannels() == num_channels_;
   }
 
  private:
   const size_t num_bands_;
   const size_t num_channels_;
-  const size_t frame_length_;
 };
 
 // Main class for the echo canceller3.
@@ -124,6 +112,17 @@ class EchoCanceller3 : public EchoControl {
     block_processor_->UpdateEchoLeakageStatus(leakage_detected);
   }
 
+  // Serializes the adaptive state of the echo canceller, i.e., the linear
+  // filters, the delay and the ERL, ERLE and reverb model estimates, into a
+  // versioned binary blob. The blob can be used to warm start a new echo
+  // canceller with the same configuration and numbers of channels.
+  void GetWarmStartState(std::vector<uint8_t>* state) const;
+
+  // Restores an adaptive state produced by GetWarmStartState(). Returns false,
+  // leaving the echo canceller to converge from its initial state, if the
+  // state is malformed or does not match the echo canceller.
+  bool SetWarmStartState(rtc::ArrayView<const uint8_t> state);
+
   // Produces a default configuration that is suitable for a certain combination
   // of render and capture channels.
   static EchoCanceller3Config CreateDefaultConfig(size_t num_render_channels,
@@ -161,21 +160,18 @@ class EchoCanceller3 : public EchoControl {
   BlockFramer output_framer_ RTC_GUARDED_BY(capture_race_checker_);
   FrameBlocker capture_blocker_ RTC_GUARDED_BY(capture_race_checker_);
   FrameBlocker render_blocker_ RTC_GUARDED_BY(capture_race_checker_);
-  SwapQueue<std::vector<std::vector<std::vector<float>>>,
-            Aec3RenderQueueItemVerifier>
+  SwapQueue<Aec3RenderQueueItem, Aec3RenderQueueItemVerifier>
       render_transfer_queue_;
   std::unique_ptr<BlockProcessor> block_processor_
       RTC_GUARDED_BY(capture_race_checker_);
-  std::vector<std::vector<std::vector<float>>> render_queue_output_frame_
+  Aec3RenderQueueItem render_queue_output_frame_
       RTC_GUARDED_BY(capture_race_checker_);
   bool saturated_microphone_signal_ RTC_GUARDED_BY(capture_race_checker_) =
       false;
-  std::vector<std::vector<std::vector<float>>> render_block_
-      RTC_GUARDED_BY(capture_race_checker_);
-  std::unique_ptr<std::vector<std::vector<std::vector<float>>>>
-      linear_output_block_ RTC_GUARDED_BY(capture_race_checker_);
-  std::vector<std::vector<std::vector<float>>> capture_block_
+  Block render_block_ RTC_GUARDED_BY(capture_race_checker_);
+  std::unique_ptr<Block> linear_output_block_
       RTC_GUARDED_BY(capture_race_checker_);
+  Block capture_block_ RTC_GUARDED_BY(capture_race_checker_);
   std::vector<std::vector<rtc::ArrayView<float>>> render_sub_frame_view_
       RTC_GUARDED_BY(capture_race_checker_);
   std::vector<std::vector<rtc::ArrayView<float>>> linear_output_sub_frame_view_
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/echo_canceller3.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kNumFramesPerSecond = 100;
+// Number of distinct frames cycled through during the measurement.
+constexpr size_t kNumDistinctFrames = 50;
+// Echo path delay, in split-band samples.
+constexpr size_t kDelaySamples = 480;
+
+int NumIterations() {
+  const int kNumIterations = 1000;
+  const int kQuickNumIterations = 50;
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumIterations
+                                                        : kNumIterations;
+}
+
+// Split-band signals for a sequence of frames, indexed as
+// [frame][band][channel][sample].
+using SplitBandFrames =
+    std::vector<std::vector<std::vector<std::vector<float>>>>;
+
+SplitBandFrames CreateFrames(size_t num_bands, size_t num_channels) {
+  return SplitBandFrames(
+      kNumDistinctFrames,
+      std::vector<std::vector<std::vector<float>>>(
+          num_bands, std::vector<std::vector<float>>(
+                         num_channels, std::vector<float>(
+                                           AudioBuffer::kSplitBandSize, 0.f))));
+}
+
+void CopyToSplitBands(const std::vector<std::vector<std::vector<float>>>& frame,
+                      AudioBuffer* buffer) {
+  for (size_t band = 0; band < frame.size(); ++band) {
+    for (size_t channel = 0; channel < frame[band].size(); ++channel) {
+      std::copy(frame[band][channel].begin(), frame[band][channel].end(),
+                buffer->split_bands(channel)[band]);
+    }
+  }
+}
+
+// Measures the cost of running the echo canceller on 48 kHz multichannel
+// audio, with the capture signal being a delayed and attenuated render signal
+// plus noise, and reports the throughput relative to real time.
+void RunAndReport(size_t num_render_channels, size_t num_capture_channels) {
+  const size_t num_bands = 3;
+  const size_t frame_length = kSampleRateHz / kNumFramesPerSecond;
+  AudioBuffer render_buffer(kSampleRateHz, num_render_channels, kSampleRateHz,
+                            num_render_channels, kSampleRateHz,
+                            num_render_channels);
+  AudioBuffer capture_buffer(kSampleRateHz, num_capture_channels,
+                             kSampleRateHz, num_capture_channels,
+                             kSampleRateHz, num_capture_channels);
+  render_buffer.SplitIntoFrequencyBands();
+  capture_buffer.SplitIntoFrequencyBands();
+  ASSERT_EQ(num_bands, render_buffer.num_bands());
+  ASSERT_EQ(frame_length, render_buffer.num_frames());
+
+  Random random_generator(42U);
+  SplitBandFrames render_frames = CreateFrames(num_bands, num_render_channels);
+  SplitBandFrames capture_frames =
+      CreateFrames(num_bands, num_capture_channels);
+  std::vector<DelayBuffer<float>> delay_buffers(
+      num_capture_channels, DelayBuffer<float>(kDelaySamples));
+  std::vector<float> echo(AudioBuffer::kSplitBandSize);
+  for (size_t k = 0; k < kNumDistinctFrames; ++k) {
+    for (size_t band = 0; band < num_bands; ++band) {
+      for (auto& channel : render_frames[k][band]) {
+        RandomizeSampleVector(&random_generator, channel);
+      }
+    }
+    for (size_t channel = 0; channel < num_capture_channels; ++channel) {
+      delay_buffers[channel].Delay(
+          render_frames[k][0][channel % num_render_channels], echo);
+      for (size_t band = 0; band < num_bands; ++band) {
+        auto& y = capture_frames[k][band][channel];
+        RandomizeSampleVector(&random_generator, y, 100.f);
+        if (band == 0) {
+          for (size_t j = 0; j < y.size(); ++j) {
+            y[j] += 0.5f * echo[j];
+          }
+        }
+      }
+    }
+  }
+
+  EchoCanceller3 echo_canceller(EchoCanceller3Config(), kSampleRateHz,
+                                num_render_channels, num_capture_channels);
+
+  const int num_iterations = NumIterations();
+  Clock* clock = Clock::GetRealTimeClock();
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int n = 0; n < num_iterations; ++n) {
+    const size_t k = n % kNumDistinctFrames;
+    CopyToSplitBands(render_frames[k], &render_buffer);
+    CopyToSplitBands(capture_frames[k], &capture_buffer);
+    echo_canceller.AnalyzeRender(&render_buffer);
+    echo_canceller.AnalyzeCapture(&capture_buffer);
+    echo_canceller.ProcessCapture(&capture_buffer, /*level_change=*/false);
+  }
+  const int64_t runtime_us = clock->TimeInMicroseconds() - start_time_us;
+  ASSERT_GT(runtime_us, 0);
+  test::PrintResult(
+      "aec3_echo_canceller3", "_48kHz",
+      std::to_string(num_render_channels) + "_render_" +
+          std::to_string(num_capture_channels) + "_capture_channels",
+      1e6 * num_iterations / kNumFramesPerSecond / runtime_us,
+      "x_realtime_per_core", true);
+}
+
+}  // namespace
+
+TEST(EchoCanceller3PerformanceTest, MultichannelFullBand) {
+  RunAndReport(1, 1);
+  RunAndReport(2, 2);
+  RunAndReport(2, 4);
+  RunAndReport(8, 8);
+}
+
+}  // namespace webrtc
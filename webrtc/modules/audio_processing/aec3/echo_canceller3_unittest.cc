@@ -109,14 +109,12 @@ class CaptureTransportVerificationProcessor : public BlockProcessor {
   explicit CaptureTransportVerificationProcessor(size_t num_bands) {}
   ~CaptureTransportVerificationProcessor() override = default;
 
-  void ProcessCapture(
-      bool level_change,
-      bool saturated_microphone_signal,
-      std::vector<std::vector<std::vector<float>>>* linear_output,
-      std::vector<std::vector<std::vector<float>>>* capture_block) override {}
+  void ProcessCapture(bool level_change,
+                      bool saturated_microphone_signal,
+                      Block* linear_output,
+                      Block* capture_block) override {}
 
-  void BufferRender(
-      const std::vector<std::vector<std::vector<float>>>& block) override {}
+  void BufferRender(const Block& block) override {}
 
   void UpdateEchoLeakageStatus(bool leakage_detected) override {}
 
@@ -124,6 +122,12 @@ class CaptureTransportVerificationProcessor : public BlockProcessor {
 
   void SetAudioBufferDelay(int delay_ms) override {}
 
+  void GetWarmStartState(WarmStartState* state) const override {}
+
+  bool SetWarmStartState(const WarmStartState& state) override {
+    return false;
+  }
+
  private:
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(CaptureTransportVerificationProcessor);
 };
@@ -135,19 +139,16 @@ class RenderTransportVerificationProcessor : public BlockProcessor {
   explicit RenderTransportVerificationProcessor(size_t num_bands) {}
   ~RenderTransportVerificationProcessor() override = default;
 
-  void ProcessCapture(
-      bool level_change,
-      bool saturated_microphone_signal,
-      std::vector<std::vector<std::vector<float>>>* linear_output,
-      std::vector<std::vector<std::vector<float>>>* capture_block) override {
-    std::vector<std::vector<std::vector<float>>> render_block =
-        received_render_blocks_.front();
+  void ProcessCapture(bool level_change,
+                      bool saturated_microphone_signal,
+                      Block* linear_output,
+                      Block* capture_block) override {
+    Block render_block = received_render_blocks_.front();
     received_render_blocks_.pop_front();
-    capture_block->swap(render_block);
+    capture_block->Swap(&render_block);
   }
 
-  void BufferRender(
-      const std::vector<std::vector<std::vector<float>>>& block) override {
+  void BufferRender(const Block& block) override {
     received_render_blocks_.push_back(block);
   }
 
@@ -157,9 +158,14 @@ class RenderTransportVerificationProcessor : public BlockProcessor {
 
   void SetAudioBufferDelay(int delay_ms) override {}
 
+  void GetWarmStartState(WarmStartState* state) const override {}
+
+  bool SetWarmStartState(const WarmStartState& state) override {
+    return false;
+  }
+
  private:
-  std::deque<std::vector<std::vector<std::vector<float>>>>
-      received_render_blocks_;
+  std::deque<Block> received_render_blocks_;
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RenderTransportVerificationProcessor);
 };
 
@@ -48,6 +48,19 @@ EchoPathDelayEstimator::EchoPathDelayEstimator(
                                      config.delay.delay_selection_thresholds) {
   RTC_DCHECK(data_dumper);
   RTC_DCHECK(down_sampling_factor_ > 0);
+  if (config.delay.use_gcc_phat_delay_estimator) {
+    // Cover the same lags as the matched filters.
+    const size_t max_lag =
+        ((config.delay.num_filters - 1) *
+             kMatchedFilterAlignmentShiftSizeSubBlocks +
+         kMatchedFilterWindowSizeSubBlocks) *
+        sub_block_size_;
+    gcc_phat_delay_estimator_ = std::make_unique<GccPhatDelayEstimator>(
+        data_dumper_, sub_block_size_, max_lag,
+        config.delay.down_sampling_factor == 8
+            ? config.render_levels.poor_excitation_render_limit_ds8
+            : config.render_levels.poor_excitation_render_limit);
+  }
 }
 
 EchoPathDelayEstimator::~EchoPathDelayEstimator() = default;
@@ -58,8 +71,7 @@ void EchoPathDelayEstimator::Reset(bool reset_delay_confidence) {
 
 absl::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
     const DownsampledRenderBuffer& render_buffer,
-    const std::vector<std::vector<float>>& capture) {
-  RTC_DCHECK_EQ(kBlockSize, capture[0].size());
+    const Block& capture) {
 
   std::array<float, kBlockSize> downsampled_capture_data;
   rtc::ArrayView<float> downsampled_capture(downsampled_capture_data.data(),
@@ -71,11 +83,30 @@ absl::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
   data_dumper_->DumpWav("aec3_capture_decimator_output",
                         downsampled_capture.size(), downsampled_capture.data(),
                         16000 / down_sampling_factor_, 1);
-  matched_filter_.Update(render_buffer, downsampled_capture);
+
+  // The GCC-PHAT estimator keeps its own capture history and analysis cadence,
+  // so it is fed on every block also when the delay search is duty cycled.
+  if (gcc_phat_delay_estimator_) {
+    gcc_phat_delay_estimator_->Update(render_buffer, downsampled_capture);
+  }
+
+  delay_search_skipped_ =
+      ++blocks_since_delay_search_ < delay_search_interval_blocks_;
+  if (delay_search_skipped_) {
+    return absl::nullopt;
+  }
+  blocks_since_delay_search_ = 0;
+
+  rtc::ArrayView<const MatchedFilter::LagEstimate> lag_estimates;
+  if (gcc_phat_delay_estimator_) {
+    lag_estimates = gcc_phat_delay_estimator_->GetLagEstimates();
+  } else {
+    matched_filter_.Update(render_buffer, downsampled_capture);
+    lag_estimates = matched_filter_.GetLagEstimates();
+  }
 
   absl::optional<DelayEstimate> aggregated_matched_filter_lag =
-      matched_filter_lag_aggregator_.Aggregate(
-          matched_filter_.GetLagEstimates());
+      matched_filter_lag_aggregator_.Aggregate(lag_estimates);
 
   // Run clockdrift detection.
   if (aggregated_matched_filter_lag &&
@@ -113,12 +144,20 @@ absl::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
   return aggregated_matched_filter_lag;
 }
 
+void EchoPathDelayEstimator::SetDelaySearchInterval(size_t interval_blocks) {
+  RTC_DCHECK_LT(0, interval_blocks);
+  delay_search_interval_blocks_ = interval_blocks;
+}
+
 void EchoPathDelayEstimator::Reset(bool reset_lag_aggregator,
                                    bool reset_delay_confidence) {
   if (reset_lag_aggregator) {
     matched_filter_lag_aggregator_.Reset(reset_delay_confidence);
   }
   matched_filter_.Reset();
+  if (gcc_phat_delay_estimator_) {
+    gcc_phat_delay_estimator_->Reset();
+  }
   old_aggregated_lag_ = absl::nullopt;
   consistent_estimate_counter_ = 0;
 }
@@ -13,12 +13,16 @@
 
 #include <stddef.h>
 
+#include <memory>
+
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/alignment_mixer.h"
+#include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/clockdrift_detector.h"
 #include "modules/audio_processing/aec3/decimator.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
+#include "modules/audio_processing/aec3/gcc_phat_delay_estimator.h"
 #include "modules/audio_processing/aec3/matched_filter.h"
 #include "modules/audio_processing/aec3/matched_filter_lag_aggregator.h"
 #include "rtc_base/constructor_magic.h"
@@ -44,7 +48,15 @@ class EchoPathDelayEstimator {
   // Produce a delay estimate if such is avaliable.
   absl::optional<DelayEstimate> EstimateDelay(
       const DownsampledRenderBuffer& render_buffer,
-      const std::vector<std::vector<float>>& capture);
+      const Block& capture);
+
+  // Sets the delay search to only run on every |interval_blocks| block. The
+  // capture signal is still decimated on every block.
+  void SetDelaySearchInterval(size_t interval_blocks);
+
+  // Returns whether the delay search was skipped in the last call to
+  // EstimateDelay().
+  bool DelaySearchSkipped() const { return delay_search_skipped_; }
 
   // Log delay estimator properties.
   void LogDelayEstimationProperties(int sample_rate_hz, size_t shift) const {
@@ -64,10 +76,15 @@ class EchoPathDelayEstimator {
   AlignmentMixer capture_mixer_;
   Decimator capture_decimator_;
   MatchedFilter matched_filter_;
+  // Replaces |matched_filter_| when set.
+  std::unique_ptr<GccPhatDelayEstimator> gcc_phat_delay_estimator_;
   MatchedFilterLagAggregator matched_filter_lag_aggregator_;
   absl::optional<DelayEstimate> old_aggregated_lag_;
   size_t consistent_estimate_counter_ = 0;
   ClockdriftDetector clockdrift_detector_;
+  size_t delay_search_interval_blocks_ = 1;
+  size_t blocks_since_delay_search_ = 0;
+  bool delay_search_skipped_ = false;
 
   // Internal reset method with more granularity.
   void Reset(bool reset_lag_aggregator, bool reset_delay_confidence);
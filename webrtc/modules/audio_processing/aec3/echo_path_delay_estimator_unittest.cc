@@ -54,11 +54,8 @@ TEST_P(EchoPathDelayEstimatorMultiChannel, BasicApiCalls) {
   std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
       RenderDelayBuffer::Create(config, kSampleRateHz, num_render_channels));
   EchoPathDelayEstimator estimator(&data_dumper, config, num_capture_channels);
-  std::vector<std::vector<std::vector<float>>> render(
-      kNumBands, std::vector<std::vector<float>>(
-                     num_render_channels, std::vector<float>(kBlockSize)));
-  std::vector<std::vector<float>> capture(num_capture_channels,
-                                          std::vector<float>(kBlockSize));
+  Block render(kNumBands, num_render_channels);
+  Block capture(/*num_bands=*/1, num_capture_channels);
   for (size_t k = 0; k < 100; ++k) {
     render_delay_buffer->Insert(render);
     estimator.EstimateDelay(render_delay_buffer->GetDownsampledRenderBuffer(),
@@ -75,11 +72,8 @@ TEST(EchoPathDelayEstimator, DelayEstimation) {
   constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
 
   Random random_generator(42U);
-  std::vector<std::vector<std::vector<float>>> render(
-      kNumBands, std::vector<std::vector<float>>(
-                     kNumRenderChannels, std::vector<float>(kBlockSize)));
-  std::vector<std::vector<float>> capture(kNumCaptureChannels,
-                                          std::vector<float>(kBlockSize));
+  Block render(kNumBands, kNumRenderChannels);
+  Block capture(/*num_bands=*/1, kNumCaptureChannels);
   ApmDataDumper data_dumper(0);
   constexpr size_t kDownSamplingFactors[] = {2, 4, 8};
   for (auto down_sampling_factor : kDownSamplingFactors) {
@@ -96,8 +90,141 @@ TEST(EchoPathDelayEstimator, DelayEstimation) {
 
       absl::optional<DelayEstimate> estimated_delay_samples;
       for (size_t k = 0; k < (500 + (delay_samples) / kBlockSize); ++k) {
-        RandomizeSampleVector(&random_generator, render[0][0]);
-        signal_delay_buffer.Delay(render[0][0], capture[0]);
+        RandomizeSampleVector(&random_generator,
+                              render.View(/*band=*/0, /*channel=*/0));
+        signal_delay_buffer.Delay(render.View(/*band=*/0, /*channel=*/0),
+                                  capture.View(/*band=*/0, /*channel=*/0));
+        render_delay_buffer->Insert(render);
+
+        if (k == 0) {
+          render_delay_buffer->Reset();
+        }
+
+        render_delay_buffer->PrepareCaptureProcessing();
+
+        auto estimate = estimator.EstimateDelay(
+            render_delay_buffer->GetDownsampledRenderBuffer(), capture);
+
+        if (estimate) {
+          estimated_delay_samples = estimate;
+        }
+      }
+
+      if (estimated_delay_samples) {
+        // Allow estimated delay to be off by one sample in the down-sampled
+        // domain.
+        size_t delay_ds = delay_samples / down_sampling_factor;
+        size_t estimated_delay_ds =
+            estimated_delay_samples->delay / down_sampling_factor;
+        EXPECT_NEAR(delay_ds, estimated_delay_ds, 1);
+      } else {
+        ADD_FAILURE();
+      }
+    }
+  }
+}
+
+// Verifies that the delay estimator produces correct delay when the delay
+// search is only run on a subset of the blocks.
+TEST(EchoPathDelayEstimator, DelayEstimationWithReducedSearchRate) {
+  constexpr size_t kNumRenderChannels = 1;
+  constexpr size_t kNumCaptureChannels = 1;
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+  constexpr size_t kSearchIntervalBlocks = 4;
+
+  Random random_generator(42U);
+  Block render(kNumBands, kNumRenderChannels);
+  Block capture(/*num_bands=*/1, kNumCaptureChannels);
+  ApmDataDumper data_dumper(0);
+  EchoCanceller3Config config;
+  config.delay.num_filters = 10;
+  for (size_t delay_samples : {30, 200, 800}) {
+    SCOPED_TRACE(ProduceDebugText(delay_samples,
+                                  config.delay.down_sampling_factor));
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(config, kSampleRateHz, kNumRenderChannels));
+    DelayBuffer<float> signal_delay_buffer(delay_samples);
+    EchoPathDelayEstimator estimator(&data_dumper, config,
+                                     kNumCaptureChannels);
+    estimator.SetDelaySearchInterval(kSearchIntervalBlocks);
+
+    absl::optional<DelayEstimate> estimated_delay_samples;
+    size_t num_skipped_searches = 0;
+    constexpr size_t kNumBlocks = 2000;
+    for (size_t k = 0; k < kNumBlocks; ++k) {
+      RandomizeSampleVector(&random_generator,
+                            render.View(/*band=*/0, /*channel=*/0));
+      signal_delay_buffer.Delay(render.View(/*band=*/0, /*channel=*/0),
+                                capture.View(/*band=*/0, /*channel=*/0));
+      render_delay_buffer->Insert(render);
+
+      if (k == 0) {
+        render_delay_buffer->Reset();
+      }
+
+      render_delay_buffer->PrepareCaptureProcessing();
+
+      auto estimate = estimator.EstimateDelay(
+          render_delay_buffer->GetDownsampledRenderBuffer(), capture);
+
+      if (estimator.DelaySearchSkipped()) {
+        EXPECT_FALSE(estimate);
+        ++num_skipped_searches;
+      }
+      if (estimate) {
+        estimated_delay_samples = estimate;
+      }
+    }
+
+    EXPECT_EQ(kNumBlocks - kNumBlocks / kSearchIntervalBlocks,
+              num_skipped_searches);
+    if (estimated_delay_samples) {
+      // Allow estimated delay to be off by one sample in the down-sampled
+      // domain.
+      size_t delay_ds = delay_samples / config.delay.down_sampling_factor;
+      size_t estimated_delay_ds =
+          estimated_delay_samples->delay / config.delay.down_sampling_factor;
+      EXPECT_NEAR(delay_ds, estimated_delay_ds, 1);
+    } else {
+      ADD_FAILURE();
+    }
+  }
+}
+
+// Verifies that the GCC-PHAT delay estimator finds the delay, also beyond the
+// range of the matched filters.
+TEST(EchoPathDelayEstimator, DelayEstimationWithGccPhat) {
+  constexpr size_t kNumRenderChannels = 1;
+  constexpr size_t kNumCaptureChannels = 1;
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+
+  Random random_generator(42U);
+  Block render(kNumBands, kNumRenderChannels);
+  Block capture(/*num_bands=*/1, kNumCaptureChannels);
+  ApmDataDumper data_dumper(0);
+  constexpr size_t kDownSamplingFactors[] = {2, 4, 8};
+  for (auto down_sampling_factor : kDownSamplingFactors) {
+    EchoCanceller3Config config;
+    config.delay.down_sampling_factor = down_sampling_factor;
+    // Covers delays up to 1.38 s.
+    config.delay.num_filters = 14;
+    config.delay.use_gcc_phat_delay_estimator = true;
+    for (size_t delay_samples : {30, 64, 150, 200, 800, 4000, 18000}) {
+      SCOPED_TRACE(ProduceDebugText(delay_samples, down_sampling_factor));
+      std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+          RenderDelayBuffer::Create(config, kSampleRateHz, kNumRenderChannels));
+      DelayBuffer<float> signal_delay_buffer(delay_samples);
+      EchoPathDelayEstimator estimator(&data_dumper, config,
+                                       kNumCaptureChannels);
+
+      absl::optional<DelayEstimate> estimated_delay_samples;
+      for (size_t k = 0; k < (500 + (delay_samples) / kBlockSize); ++k) {
+        RandomizeSampleVector(&random_generator,
+                              render.View(/*band=*/0, /*channel=*/0));
+        signal_delay_buffer.Delay(render.View(/*band=*/0, /*channel=*/0),
+                                  capture.View(/*band=*/0, /*channel=*/0));
         render_delay_buffer->Insert(render);
 
         if (k == 0) {
@@ -137,22 +264,22 @@ TEST(EchoPathDelayEstimator, NoDelayEstimatesForLowLevelRenderSignals) {
   constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
   Random random_generator(42U);
   EchoCanceller3Config config;
-  std::vector<std::vector<std::vector<float>>> render(
-      kNumBands, std::vector<std::vector<float>>(
-                     kNumRenderChannels, std::vector<float>(kBlockSize)));
-  std::vector<std::vector<float>> capture(kNumCaptureChannels,
-                                          std::vector<float>(kBlockSize));
+  Block render(kNumBands, kNumRenderChannels);
+  Block capture(/*num_bands=*/1, kNumCaptureChannels);
   ApmDataDumper data_dumper(0);
   EchoPathDelayEstimator estimator(&data_dumper, config, kNumCaptureChannels);
   std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
       RenderDelayBuffer::Create(EchoCanceller3Config(), kSampleRateHz,
                                 kNumRenderChannels));
   for (size_t k = 0; k < 100; ++k) {
-    RandomizeSampleVector(&random_generator, render[0][0]);
-    for (auto& render_k : render[0][0]) {
+    RandomizeSampleVector(&random_generator,
+                          render.View(/*band=*/0, /*channel=*/0));
+    for (auto& render_k : render.View(/*band=*/0, /*channel=*/0)) {
       render_k *= 100.f / 32767.f;
     }
-    std::copy(render[0][0].begin(), render[0][0].end(), capture[0].begin());
+    std::copy(render.begin(/*band=*/0, /*channel=*/0),
+              render.end(/*band=*/0, /*channel=*/0),
+              capture.begin(/*band=*/0, /*channel=*/0));
     render_delay_buffer->Insert(render);
     render_delay_buffer->PrepareCaptureProcessing();
     EXPECT_FALSE(estimator.EstimateDelay(
@@ -171,23 +298,7 @@ TEST(EchoPathDelayEstimator, DISABLED_WrongRenderBlockSize) {
   EchoPathDelayEstimator estimator(&data_dumper, config, 1);
   std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
       RenderDelayBuffer::Create(config, 48000, 1));
-  std::vector<std::vector<float>> capture(1, std::vector<float>(kBlockSize));
-  EXPECT_DEATH(estimator.EstimateDelay(
-                   render_delay_buffer->GetDownsampledRenderBuffer(), capture),
-               "");
-}
-
-// Verifies the check for the capture blocksize.
-// TODO(peah): Re-enable the test once the issue with memory leaks during DEATH
-// tests on test bots has been fixed.
-TEST(EchoPathDelayEstimator, WrongCaptureBlockSize) {
-  ApmDataDumper data_dumper(0);
-  EchoCanceller3Config config;
-  EchoPathDelayEstimator estimator(&data_dumper, config, 1);
-  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
-      RenderDelayBuffer::Create(config, 48000, 1));
-  std::vector<std::vector<float>> capture(1,
-                                          std::vector<float>(kBlockSize - 1));
+  Block capture(/*num_bands=*/1, 1);
   EXPECT_DEATH(estimator.EstimateDelay(
                    render_delay_buffer->GetDownsampledRenderBuffer(), capture),
                "");
@@ -123,8 +123,8 @@ class EchoRemoverImpl final : public EchoRemover {
       bool capture_signal_saturation,
       const absl::optional<DelayEstimate>& external_delay,
       RenderBuffer* render_buffer,
-      std::vector<std::vector<std::vector<float>>>* linear_output,
-      std::vector<std::vector<std::vector<float>>>* capture) override;
+      Block* linear_output,
+      Block* capture) override;
 
   // Updates the status on whether echo leakage is detected in the output of the
   // echo remover.
@@ -132,6 +132,12 @@ class EchoRemoverImpl final : public EchoRemover {
     echo_leakage_detected_ = leakage_detected;
   }
 
+  bool SteadyState() const override { return aec_state_.SteadyState(); }
+
+  void GetWarmStartState(WarmStartState* state) const override;
+
+  bool SetWarmStartState(const WarmStartState& state) override;
+
  private:
   // Selects which of the coarse and refined linear filter outputs that is most
   // appropriate to pass to the suppressor and forms the linear filter output by
@@ -205,7 +211,7 @@ EchoRemoverImpl::EchoRemoverImpl(const EchoCanceller3Config& config,
                           sample_rate_hz_,
                           num_capture_channels_),
       render_signal_analyzer_(config_),
-      residual_echo_estimator_(config_, num_render_channels),
+      residual_echo_estimator_(config_, optimization_, num_render_channels),
       aec_state_(config_, num_capture_channels_),
       e_old_(num_capture_channels_, {0.f}),
       y_old_(num_capture_channels_, {0.f}),
@@ -229,6 +235,37 @@ void EchoRemoverImpl::GetMetrics(EchoControl::Metrics* metrics) const {
   metrics->echo_return_loss = -10.0 * std::log10(aec_state_.ErlTimeDomain());
   metrics->echo_return_loss_enhancement =
       Log2TodB(aec_state_.FullBandErleLog2());
+  metrics->render_silence_blocks = subtractor_.RenderSilenceBlocks();
+  metrics->capture_silence_blocks = subtractor_.CaptureSilenceBlocks();
+}
+
+void EchoRemoverImpl::GetWarmStartState(WarmStartState* state) const {
+  subtractor_.GetWarmStartState(state);
+  aec_state_.GetWarmStartState(state);
+}
+
+bool EchoRemoverImpl::SetWarmStartState(const WarmStartState& state) {
+  if (state.filters.size() != num_capture_channels_ ||
+      state.erle.size() != num_capture_channels_ ||
+      state.erle_onsets.size() != num_capture_channels_ ||
+      state.fullband_erle_log2.size() != num_capture_channels_) {
+    return false;
+  }
+  for (const auto& H : state.filters) {
+    if (H.size() != subtractor_.FilterSizePartitions()) {
+      return false;
+    }
+    for (const auto& H_p : H) {
+      if (H_p.size() != num_render_channels_) {
+        return false;
+      }
+    }
+  }
+
+  subtractor_.SetWarmStartState(state);
+  aec_state_.SetWarmStartState(state);
+  suppression_gain_.SetInitialState(false);
+  return true;
 }
 
 void EchoRemoverImpl::ProcessCapture(
@@ -236,20 +273,17 @@ void EchoRemoverImpl::ProcessCapture(
     bool capture_signal_saturation,
     const absl::optional<DelayEstimate>& external_delay,
     RenderBuffer* render_buffer,
-    std::vector<std::vector<std::vector<float>>>* linear_output,
-    std::vector<std::vector<std::vector<float>>>* capture) {
+    Block* linear_output,
+    Block* capture) {
   ++block_counter_;
-  const std::vector<std::vector<std::vector<float>>>& x =
-      render_buffer->Block(0);
-  std::vector<std::vector<std::vector<float>>>* y = capture;
+  const Block& x = render_buffer->GetBlock(0);
+  Block* y = capture;
   RTC_DCHECK(render_buffer);
   RTC_DCHECK(y);
-  RTC_DCHECK_EQ(x.size(), NumBandsForRate(sample_rate_hz_));
-  RTC_DCHECK_EQ(y->size(), NumBandsForRate(sample_rate_hz_));
-  RTC_DCHECK_EQ(x[0].size(), num_render_channels_);
-  RTC_DCHECK_EQ((*y)[0].size(), num_capture_channels_);
-  RTC_DCHECK_EQ(x[0][0].size(), kBlockSize);
-  RTC_DCHECK_EQ((*y)[0][0].size(), kBlockSize);
+  RTC_DCHECK_EQ(x.NumBands(), NumBandsForRate(sample_rate_hz_));
+  RTC_DCHECK_EQ(y->NumBands(), NumBandsForRate(sample_rate_hz_));
+  RTC_DCHECK_EQ(x.NumChannels(), num_render_channels_);
+  RTC_DCHECK_EQ(y->NumChannels(), num_capture_channels_);
 
   // Stack allocated data to use when the number of channels is low.
   std::array<std::array<float, kFftLengthBy2>, kMaxNumChannelsOnStack> e_stack;
@@ -309,11 +343,13 @@ void EchoRemoverImpl::ProcessCapture(
   }
 
   data_dumper_->DumpWav("aec3_echo_remover_capture_input", kBlockSize,
-                        &(*y)[0][0][0], 16000, 1);
+                        y->begin(/*band=*/0, /*channel=*/0), 16000, 1);
   data_dumper_->DumpWav("aec3_echo_remover_render_input", kBlockSize,
-                        &x[0][0][0], 16000, 1);
-  data_dumper_->DumpRaw("aec3_echo_remover_capture_input", (*y)[0][0]);
-  data_dumper_->DumpRaw("aec3_echo_remover_render_input", x[0][0]);
+                        x.begin(/*band=*/0, /*channel=*/0), 16000, 1);
+  data_dumper_->DumpRaw("aec3_echo_remover_capture_input",
+                        y->View(/*band=*/0, /*channel=*/0));
+  data_dumper_->DumpRaw("aec3_echo_remover_render_input",
+                        x.View(/*band=*/0, /*channel=*/0));
 
   aec_state_.UpdateCaptureSaturation(capture_signal_saturation);
 
@@ -356,13 +392,13 @@ void EchoRemoverImpl::ProcessCapture(
   }
 
   // Perform linear echo cancellation.
-  subtractor_.Process(*render_buffer, (*y)[0], render_signal_analyzer_,
+  subtractor_.Process(*render_buffer, *y, render_signal_analyzer_,
                       aec_state_, subtractor_output);
 
   // Compute spectra.
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     FormLinearFilterOutput(subtractor_output[ch], e[ch]);
-    WindowedPaddedFft(fft_, (*y)[0][ch], y_old_[ch], &Y[ch]);
+    WindowedPaddedFft(fft_, y->View(/*band=*/0, ch), y_old_[ch], &Y[ch]);
     WindowedPaddedFft(fft_, e[ch], e_old_[ch], &E[ch]);
     LinearEchoPower(E[ch], Y[ch], &S2_linear[ch]);
     Y[ch].Spectrum(optimization_, Y2[ch]);
@@ -371,11 +407,11 @@ void EchoRemoverImpl::ProcessCapture(
 
   // Optionally return the linear filter output.
   if (linear_output) {
-    RTC_DCHECK_GE(1, linear_output->size());
-    RTC_DCHECK_EQ(num_capture_channels_, linear_output[0].size());
+    RTC_DCHECK_GE(1, linear_output->NumBands());
+    RTC_DCHECK_EQ(num_capture_channels_, linear_output->NumChannels());
     for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
-      RTC_DCHECK_EQ(kBlockSize, (*linear_output)[0][ch].size());
-      std::copy(e[ch].begin(), e[ch].end(), (*linear_output)[0][ch].begin());
+      std::copy(e[ch].begin(), e[ch].end(),
+                linear_output->begin(/*band=*/0, ch));
     }
   }
 
@@ -387,8 +423,8 @@ void EchoRemoverImpl::ProcessCapture(
   // Choose the linear output.
   const auto& Y_fft = aec_state_.UseLinearFilterOutput() ? E : Y;
 
-  data_dumper_->DumpWav("aec3_output_linear", kBlockSize, &(*y)[0][0][0], 16000,
-                        1);
+  data_dumper_->DumpWav("aec3_output_linear", kBlockSize,
+                        y->begin(/*band=*/0, /*channel=*/0), 16000, 1);
   data_dumper_->DumpWav("aec3_output_linear2", kBlockSize, &e[0][0], 16000, 1);
 
   // Estimate the residual echo power.
@@ -430,13 +466,12 @@ void EchoRemoverImpl::ProcessCapture(
   // Debug outputs for the purpose of development and analysis.
   data_dumper_->DumpWav("aec3_echo_estimate", kBlockSize,
                         &subtractor_output[0].s_refined[0], 16000, 1);
-  data_dumper_->DumpRaw("aec3_output", (*y)[0][0]);
+  data_dumper_->DumpRaw("aec3_output", y->View(/*band=*/0, /*channel=*/0));
   data_dumper_->DumpRaw("aec3_narrow_render",
                         render_signal_analyzer_.NarrowPeakBand() ? 1 : 0);
   data_dumper_->DumpRaw("aec3_N2", cng_.NoiseSpectrum()[0]);
   data_dumper_->DumpRaw("aec3_suppressor_gain", G);
-  data_dumper_->DumpWav("aec3_output",
-                        rtc::ArrayView<const float>(&(*y)[0][0][0], kBlockSize),
+  data_dumper_->DumpWav("aec3_output", y->View(/*band=*/0, /*channel=*/0),
                         16000, 1);
   data_dumper_->DumpRaw("aec3_using_subtractor_output[0]",
                         aec_state_.UseLinearFilterOutput() ? 1 : 0);
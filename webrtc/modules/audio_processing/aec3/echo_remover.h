@@ -16,9 +16,11 @@
 #include "absl/types/optional.h"
 #include "api/audio/echo_canceller3_config.h"
 #include "api/audio/echo_control.h"
+#include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 
 namespace webrtc {
 
@@ -42,12 +44,25 @@ class EchoRemover {
       bool capture_signal_saturation,
       const absl::optional<DelayEstimate>& external_delay,
       RenderBuffer* render_buffer,
-      std::vector<std::vector<std::vector<float>>>* linear_output,
-      std::vector<std::vector<std::vector<float>>>* capture) = 0;
+      Block* linear_output,
+      Block* capture) = 0;
 
   // Updates the status on whether echo leakage is detected in the output of the
   // echo remover.
   virtual void UpdateEchoLeakageStatus(bool leakage_detected) = 0;
+
+  // Returns whether the echo remover has converged to a steady state where the
+  // echo path is stable.
+  virtual bool SteadyState() const = 0;
+
+  // Stores the linear filters and the ERL, ERLE and reverb model estimates in
+  // |state|.
+  virtual void GetWarmStartState(WarmStartState* state) const = 0;
+
+  // Restores the linear filters and the ERL, ERLE and reverb model estimates
+  // from |state|. Returns false, leaving the echo remover untouched, if the
+  // dimensions of |state| do not match the echo remover.
+  virtual bool SetWarmStartState(const WarmStartState& state) = 0;
 };
 
 }  // namespace webrtc
@@ -57,6 +57,7 @@ void EchoRemoverMetrics::ResetMetrics() {
   erle_.fill(DbMetric(0.f, 0.f, 1000.f));
   erle_time_domain_ = DbMetric(0.f, 0.f, 1000.f);
   active_render_count_ = 0;
+  steady_state_count_ = 0;
   saturated_capture_ = false;
 }
 
@@ -71,6 +72,7 @@ void EchoRemoverMetrics::Update(
     aec3::UpdateDbMetric(aec_state.Erle()[0], &erle_);
     erle_time_domain_.UpdateInstant(aec_state.FullBandErleLog2());
     active_render_count_ += (aec_state.ActiveRender() ? 1 : 0);
+    steady_state_count_ += (aec_state.SteadyState() ? 1 : 0);
     saturated_capture_ = saturated_capture_ || aec_state.SaturatedCapture();
   } else {
     // Report the metrics over several frames in order to lower the impact of
@@ -162,6 +164,9 @@ void EchoRemoverMetrics::Update(
                                     31);
         RTC_HISTOGRAM_BOOLEAN("WebRTC.Audio.EchoCanceller.CaptureSaturation",
                               static_cast<int>(saturated_capture_ ? 1 : 0));
+        RTC_HISTOGRAM_PERCENTAGE(
+            "WebRTC.Audio.EchoCanceller.SteadyStateBlocks",
+            100 * steady_state_count_ / kMetricsCollectionBlocks);
         break;
       case kMetricsCollectionBlocks + 6:
         RTC_HISTOGRAM_COUNTS_LINEAR(
@@ -53,6 +53,7 @@ class EchoRemoverMetrics {
   std::array<DbMetric, 2> erle_;
   DbMetric erle_time_domain_;
   int active_render_count_ = 0;
+  int steady_state_count_ = 0;
   bool saturated_capture_ = false;
   bool metrics_reported_ = false;
 
@@ -13,7 +13,9 @@
 #include <algorithm>
 #include <numeric>
 
+#include "modules/audio_processing/aec3/vector_math.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_minmax.h"
 
 namespace webrtc {
 
@@ -24,8 +26,10 @@ constexpr float kMaxErl = 1000.f;
 
 }  // namespace
 
-ErlEstimator::ErlEstimator(size_t startup_phase_length_blocks_)
-    : startup_phase_length_blocks__(startup_phase_length_blocks_) {
+ErlEstimator::ErlEstimator(size_t startup_phase_length_blocks_,
+                           Aec3Optimization optimization)
+    : startup_phase_length_blocks__(startup_phase_length_blocks_),
+      optimization_(optimization) {
   erl_.fill(kMaxErl);
   hold_counters_.fill(0);
   erl_time_domain_ = kMaxErl;
@@ -38,6 +42,16 @@ void ErlEstimator::Reset() {
   blocks_since_reset_ = 0;
 }
 
+void ErlEstimator::Restore(rtc::ArrayView<const float, kFftLengthBy2Plus1> erl,
+                           float erl_time_domain) {
+  std::transform(erl.begin(), erl.end(), erl_.begin(),
+                 [](float a) { return rtc::SafeClamp(a, kMinErl, kMaxErl); });
+  hold_counters_.fill(1000);
+  erl_time_domain_ = rtc::SafeClamp(erl_time_domain, kMinErl, kMaxErl);
+  hold_counter_time_domain_ = 1000;
+  blocks_since_reset_ = startup_phase_length_blocks__;
+}
+
 void ErlEstimator::Update(
     const std::vector<bool>& converged_filters,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> render_spectra,
@@ -60,6 +74,7 @@ void ErlEstimator::Update(
   }
 
   // Use the maximum spectrum across capture and the maximum across render.
+  aec3::VectorMath vector_math(optimization_);
   std::array<float, kFftLengthBy2Plus1> max_capture_spectrum_data;
   std::array<float, kFftLengthBy2Plus1> max_capture_spectrum =
       capture_spectra[/*channel=*/0];
@@ -75,10 +90,7 @@ void ErlEstimator::Update(
       if (!converged_filters[ch]) {
         continue;
       }
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        max_capture_spectrum_data[k] =
-            std::max(max_capture_spectrum_data[k], capture_spectra[ch][k]);
-      }
+      vector_math.Max(capture_spectra[ch], max_capture_spectrum_data);
     }
     max_capture_spectrum = max_capture_spectrum_data;
   }
@@ -91,10 +103,7 @@ void ErlEstimator::Update(
     std::copy(render_spectra[0].begin(), render_spectra[0].end(),
               max_render_spectrum_data.begin());
     for (size_t ch = 1; ch < num_render_channels; ++ch) {
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        max_render_spectrum_data[k] =
-            std::max(max_render_spectrum_data[k], render_spectra[ch][k]);
-      }
+      vector_math.Max(render_spectra[ch], max_render_spectrum_data);
     }
     max_render_spectrum = max_render_spectrum_data;
   }
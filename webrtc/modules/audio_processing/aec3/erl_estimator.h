@@ -25,12 +25,17 @@ namespace webrtc {
 // Estimates the echo return loss based on the signal spectra.
 class ErlEstimator {
  public:
-  explicit ErlEstimator(size_t startup_phase_length_blocks_);
+  ErlEstimator(size_t startup_phase_length_blocks_,
+               Aec3Optimization optimization);
   ~ErlEstimator();
 
   // Resets the ERL estimation.
   void Reset();
 
+  // Restores a previously converged ERL estimate, skipping the startup phase.
+  void Restore(rtc::ArrayView<const float, kFftLengthBy2Plus1> erl,
+               float erl_time_domain);
+
   // Updates the ERL estimate.
   void Update(const std::vector<bool>& converged_filters,
               rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>>
@@ -44,6 +49,7 @@ class ErlEstimator {
 
  private:
   const size_t startup_phase_length_blocks__;
+  const Aec3Optimization optimization_;
   std::array<float, kFftLengthBy2Plus1> erl_;
   std::array<int, kFftLengthBy2Minus1> hold_counters_;
   float erl_time_domain_;
@@ -10,6 +10,7 @@
 
 #include "modules/audio_processing/aec3/erl_estimator.h"
 
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
 #include "test/gtest.h"
 
@@ -60,7 +61,7 @@ TEST_P(ErlEstimatorMultiChannel, Estimates) {
   const size_t converged_idx = num_capture_channels - 1;
   converged_filters[converged_idx] = true;
 
-  ErlEstimator estimator(0);
+  ErlEstimator estimator(0, DetectOptimization());
 
   // Verifies that the ERL estimate is properly reduced to lower values.
   for (auto& X2_ch : X2) {
@@ -101,4 +102,38 @@ TEST_P(ErlEstimatorMultiChannel, Estimates) {
   }
   VerifyErl(estimator.Erl(), estimator.ErlTimeDomain(), 1000.f);
 }
+
+// Verifies that the optimized maximum spectra across channels give the same
+// ERL estimates as the generic code.
+TEST_P(ErlEstimatorMultiChannel, OptimizationsAreBitExact) {
+  const size_t num_render_channels = std::get<0>(GetParam());
+  const size_t num_capture_channels = std::get<1>(GetParam());
+  SCOPED_TRACE(ProduceDebugText(num_render_channels, num_capture_channels));
+  Random random_generator(42U);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> X2(num_render_channels);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> Y2(num_capture_channels);
+  std::vector<bool> converged_filters(num_capture_channels, true);
+  ErlEstimator estimator(0, Aec3Optimization::kNone);
+  ErlEstimator estimator_optimized(0, DetectOptimization());
+  for (int n = 0; n < 1000; ++n) {
+    for (auto& X2_ch : X2) {
+      std::for_each(X2_ch.begin(), X2_ch.end(), [&](float& a) {
+        a = 1000000000.f * random_generator.Rand<float>();
+      });
+    }
+    for (auto& Y2_ch : Y2) {
+      std::for_each(Y2_ch.begin(), Y2_ch.end(), [&](float& a) {
+        a = 1000000000.f * random_generator.Rand<float>();
+      });
+    }
+    converged_filters[n % num_capture_channels] = n % 3 != 0;
+    estimator.Update(converged_filters, X2, Y2);
+    estimator_optimized.Update(converged_filters, X2, Y2);
+    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+      ASSERT_EQ(estimator.Erl()[k], estimator_optimized.Erl()[k]);
+    }
+    ASSERT_EQ(estimator.ErlTimeDomain(), estimator_optimized.ErlTimeDomain());
+  }
+}
+
 }  // namespace webrtc
@@ -42,6 +42,15 @@ void ErleEstimator::Reset(bool delay_change) {
   }
 }
 
+void ErleEstimator::Restore(
+    rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle,
+    rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle_onsets,
+    rtc::ArrayView<const float> fullband_erle_log2) {
+  subband_erle_estimator_.Restore(erle, erle_onsets);
+  fullband_erle_estimator_.Restore(fullband_erle_log2);
+  blocks_since_reset_ = startup_phase_length_blocks_;
+}
+
 void ErleEstimator::Update(
     const RenderBuffer& render_buffer,
     rtc::ArrayView<const std::vector<std::array<float, kFftLengthBy2Plus1>>>
@@ -41,6 +41,25 @@ class ErleEstimator {
   // Resets the fullband ERLE estimator and the subbands ERLE estimators.
   void Reset(bool delay_change);
 
+  // Restores previously converged subband and fullband ERLE estimates,
+  // skipping the startup phase.
+  void Restore(
+      rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle,
+      rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle_onsets,
+      rtc::ArrayView<const float> fullband_erle_log2);
+
+  // Returns the subband ERLE estimates that are estimated without taking the
+  // signal dependency into account.
+  rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> SubbandErle()
+      const {
+    return subband_erle_estimator_.Erle();
+  }
+
+  // Returns the fullband ERLE estimates for each capture channel.
+  rtc::ArrayView<const float> FullbandErleLog2PerChannel() const {
+    return fullband_erle_estimator_.FullbandErleLog2PerChannel();
+  }
+
   // Updates the ERLE estimates.
   void Update(
       const RenderBuffer& render_buffer,
@@ -50,7 +50,7 @@ void VerifyErle(
   EXPECT_NEAR(reference_lf, erle_time_domain, 0.5);
 }
 
-void FormFarendTimeFrame(std::vector<std::vector<std::vector<float>>>* x) {
+void FormFarendTimeFrame(Block* x) {
   const std::array<float, kBlockSize> frame = {
       7459.88, 17209.6, 17383,   20768.9, 16816.7, 18386.3, 4492.83, 9675.85,
       6665.52, 14808.6, 9342.3,  7483.28, 19261.7, 4145.98, 1622.18, 13475.2,
@@ -60,10 +60,9 @@ void FormFarendTimeFrame(std::vector<std::vector<std::vector<float>>>* x) {
       11405,   15031.4, 14541.6, 19765.5, 18346.3, 19350.2, 3157.47, 18095.8,
       1743.68, 21328.2, 19727.5, 7295.16, 10332.4, 11055.5, 20107.4, 14708.4,
       12416.2, 16434,   2454.69, 9840.8,  6867.23, 1615.75, 6059.9,  8394.19};
-  for (size_t band = 0; band < x->size(); ++band) {
-    for (size_t channel = 0; channel < (*x)[band].size(); ++channel) {
-      RTC_DCHECK_GE((*x)[band][channel].size(), frame.size());
-      std::copy(frame.begin(), frame.end(), (*x)[band][channel].begin());
+  for (size_t band = 0; band < x->NumBands(); ++band) {
+    for (size_t channel = 0; channel < x->NumChannels(); ++channel) {
+      std::copy(frame.begin(), frame.end(), x->begin(band, channel));
     }
   }
 }
@@ -94,13 +93,13 @@ void FormFarendFrame(const RenderBuffer& render_buffer,
 }
 
 void FormNearendFrame(
-    std::vector<std::vector<std::vector<float>>>* x,
+    Block* x,
     std::array<float, kFftLengthBy2Plus1>* X2,
     rtc::ArrayView<std::array<float, kFftLengthBy2Plus1>> E2,
     rtc::ArrayView<std::array<float, kFftLengthBy2Plus1>> Y2) {
-  for (size_t band = 0; band < x->size(); ++band) {
-    for (size_t ch = 0; ch < (*x)[band].size(); ++ch) {
-      std::fill((*x)[band][ch].begin(), (*x)[band][ch].end(), 0.f);
+  for (size_t band = 0; band < x->NumBands(); ++band) {
+    for (size_t ch = 0; ch < x->NumChannels(); ++ch) {
+      std::fill(x->begin(band, ch), x->end(band, ch), 0.f);
     }
   }
 
@@ -152,9 +151,7 @@ TEST_P(ErleEstimatorMultiChannel, VerifyErleIncreaseAndHold) {
   EchoCanceller3Config config;
   config.erle.onset_detection = true;
 
-  std::vector<std::vector<std::vector<float>>> x(
-      kNumBands, std::vector<std::vector<float>>(
-                     num_render_channels, std::vector<float>(kBlockSize, 0.f)));
+  Block x(kNumBands, num_render_channels);
   std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>
   filter_frequency_response(
       config.filter.refined.length_blocks,
@@ -206,9 +203,7 @@ TEST_P(ErleEstimatorMultiChannel, VerifyErleTrackingOnOnsets) {
   std::vector<bool> converged_filters(num_capture_channels, true);
   EchoCanceller3Config config;
   config.erle.onset_detection = true;
-  std::vector<std::vector<std::vector<float>>> x(
-      kNumBands, std::vector<std::vector<float>>(
-                     num_render_channels, std::vector<float>(kBlockSize, 0.f)));
+  Block x(kNumBands, num_render_channels);
   std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>
   filter_frequency_response(
       config.filter.refined.length_blocks,
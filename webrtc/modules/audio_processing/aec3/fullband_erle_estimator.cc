@@ -56,6 +56,17 @@ void FullBandErleEstimator::Reset() {
             hold_counters_time_domain_.end(), 0);
 }
 
+void FullBandErleEstimator::Restore(rtc::ArrayView<const float> erle_log2) {
+  RTC_DCHECK_EQ(erle_time_domain_log2_.size(), erle_log2.size());
+  for (size_t ch = 0; ch < erle_log2.size(); ++ch) {
+    erle_time_domain_log2_[ch] =
+        rtc::SafeClamp(erle_log2[ch], min_erle_log2_, max_erle_lf_log2);
+    hold_counters_time_domain_[ch] = kBlocksToHoldErle;
+    instantaneous_erle_[ch].Reset();
+  }
+  UpdateQualityEstimates();
+}
+
 void FullBandErleEstimator::Update(
     rtc::ArrayView<const float> X2,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
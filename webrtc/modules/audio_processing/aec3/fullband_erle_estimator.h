@@ -32,6 +32,9 @@ class FullBandErleEstimator {
   // Resets the ERLE estimator.
   void Reset();
 
+  // Restores previously converged fullband ERLE estimates, in log2 units.
+  void Restore(rtc::ArrayView<const float> erle_log2);
+
   // Updates the ERLE estimator.
   void Update(rtc::ArrayView<const float> X2,
               rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
@@ -47,6 +50,12 @@ class FullBandErleEstimator {
     return min_erle;
   }
 
+  // Returns the fullband ERLE estimates for each capture channel, in log2
+  // units.
+  rtc::ArrayView<const float> FullbandErleLog2PerChannel() const {
+    return erle_time_domain_log2_;
+  }
+
   // Returns an estimation of the current linear filter quality. It returns a
   // float number between 0 and 1 mapping 1 to the highest possible quality.
   rtc::ArrayView<const absl::optional<float>> GetInstLinearQualityEstimates()
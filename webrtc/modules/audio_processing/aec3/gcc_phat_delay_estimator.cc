@@ -0,0 +1,298 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/gcc_phat_delay_estimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "common_audio/third_party/fft4g/fft4g.h"
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Analysis window and interval, in sub-blocks.
+constexpr size_t kWindowSubBlocks = 16;
+constexpr size_t kAnalysisIntervalSubBlocks = 4;
+// Once the coarse search has found the delay, it is only repeated every this
+// many analyses.
+constexpr size_t kCoarseSearchIntervalWhenLocked = 8;
+// The fine search covers the lags within this many samples of the coarse
+// estimate.
+constexpr size_t kFineMargin = 8;
+// Forgetting factor of the recursively averaged cross-spectra.
+constexpr float kSmoothing = 0.95f;
+// The coarse correlation peak must exceed the RMS of the correlation over all
+// lags by this factor to be reliable.
+constexpr float kPeakToRmsThreshold = 10.f;
+
+size_t FftSize(size_t length) {
+  size_t fft_size = 2;
+  while (fft_size < length) {
+    fft_size *= 2;
+  }
+  return fft_size;
+}
+
+}  // namespace
+
+// Computes the PHAT weighted cross-correlation of a capture window with a
+// render segment for a range of lags. With |envelope| set, the peak is searched
+// in the envelope of the correlation, which tolerates the phase offsets that
+// fractional delays cause in the band-pass sampled signal at down-sampling
+// factor 8. The fine search uses it; the coarse search saves the extra inverse
+// transform.
+class GccPhatDelayEstimator::Correlator {
+ public:
+  struct Peak {
+    size_t lag = 0;
+    float value = 0.f;
+    float peak_to_rms = 0.f;
+  };
+
+  Correlator(size_t window_size, size_t num_lags, bool envelope)
+      : window_size_(window_size),
+        num_lags_(num_lags),
+        envelope_(envelope),
+        fft_size_(FftSize(window_size + num_lags - 1)),
+        bit_reversal_state_(fft_size_ / 2),
+        tables_(fft_size_ / 2),
+        capture_fft_(fft_size_),
+        render_fft_(fft_size_),
+        cross_spectrum_(fft_size_),
+        correlation_(fft_size_),
+        quadrature_(envelope_ ? fft_size_ : 0) {
+    // Setting |bit_reversal_state_[0]| to 0 triggers the initialization of
+    // the tables.
+    bit_reversal_state_[0] = 0;
+    WebRtc_rdft(fft_size_, 1, correlation_.data(), bit_reversal_state_.data(),
+                tables_.data());
+    Reset();
+  }
+
+  void Reset() {
+    std::fill(cross_spectrum_.begin(), cross_spectrum_.end(), 0.f);
+  }
+
+  // Correlates the |window_size_| samples in |capture| with |render|, which
+  // holds |window_size_| + |num_lags_| - 1 samples, such that at lag d,
+  // render[num_lags_ - 1 - d + n] aligns with capture[n].
+  Peak Correlate(rtc::ArrayView<const float> capture,
+                 rtc::ArrayView<const float> render) {
+    RTC_DCHECK_EQ(window_size_, capture.size());
+    RTC_DCHECK_EQ(window_size_ + num_lags_ - 1, render.size());
+    Transform(capture, capture_fft_);
+    Transform(render, render_fft_);
+
+    // Average conj(capture) * render. The PHAT weighting then keeps the phase
+    // only. In the packed format, elements 0 and 1 hold the real DC and
+    // Nyquist bins; the DC bin is left out.
+    const float* c = capture_fft_.data();
+    const float* r = render_fft_.data();
+    float* s = cross_spectrum_.data();
+    float* w = correlation_.data();
+    std::fill(correlation_.begin(), correlation_.end(), 0.f);
+    s[1] = kSmoothing * s[1] + (1.f - kSmoothing) * c[1] * r[1];
+    w[1] = s[1] > 0.f ? 1.f : (s[1] < 0.f ? -1.f : 0.f);
+    for (size_t k = 2; k < fft_size_; k += 2) {
+      const float re = c[k] * r[k] + c[k + 1] * r[k + 1];
+      const float im = c[k] * r[k + 1] - c[k + 1] * r[k];
+      s[k] = kSmoothing * s[k] + (1.f - kSmoothing) * re;
+      s[k + 1] = kSmoothing * s[k + 1] + (1.f - kSmoothing) * im;
+      const float magnitude = std::sqrt(s[k] * s[k] + s[k + 1] * s[k + 1]);
+      if (magnitude > 0.f) {
+        w[k] = s[k] / magnitude;
+        w[k + 1] = s[k + 1] / magnitude;
+      }
+    }
+    if (envelope_) {
+      // The weighted spectrum rotated by 90 degrees gives the quadrature
+      // component of the correlation.
+      quadrature_[0] = 0.f;
+      quadrature_[1] = 0.f;
+      for (size_t k = 2; k < fft_size_; k += 2) {
+        quadrature_[k] = w[k + 1];
+        quadrature_[k + 1] = -w[k];
+      }
+      WebRtc_rdft(fft_size_, -1, quadrature_.data(),
+                  bit_reversal_state_.data(), tables_.data());
+    }
+    WebRtc_rdft(fft_size_, -1, correlation_.data(), bit_reversal_state_.data(),
+                tables_.data());
+
+    // The correlation at lag d is in element |num_lags_| - 1 - d.
+    Peak peak;
+    float energy = 0.f;
+    for (size_t d = 0; d < num_lags_; ++d) {
+      const size_t index = num_lags_ - 1 - d;
+      const float value =
+          envelope_ ? std::sqrt(correlation_[index] * correlation_[index] +
+                                quadrature_[index] * quadrature_[index])
+                    : correlation_[index];
+      energy += value * value;
+      if (value > peak.value) {
+        peak.value = value;
+        peak.lag = d;
+      }
+    }
+    const float rms = std::sqrt(energy / num_lags_);
+    peak.peak_to_rms = rms > 0.f ? peak.value / rms : 0.f;
+    // An impulse at the peak sums to fft_size_ / 2 in the inverse transform.
+    peak.value *= 2.f / fft_size_;
+    return peak;
+  }
+
+ private:
+  void Transform(rtc::ArrayView<const float> x, std::vector<float>& fft) {
+    std::copy(x.begin(), x.end(), fft.begin());
+    std::fill(fft.begin() + x.size(), fft.end(), 0.f);
+    WebRtc_rdft(fft_size_, 1, fft.data(), bit_reversal_state_.data(),
+                tables_.data());
+  }
+
+  const size_t window_size_;
+  const size_t num_lags_;
+  const bool envelope_;
+  const size_t fft_size_;
+  std::vector<size_t> bit_reversal_state_;
+  std::vector<float> tables_;
+  std::vector<float> capture_fft_;
+  std::vector<float> render_fft_;
+  std::vector<float> cross_spectrum_;
+  std::vector<float> correlation_;
+  std::vector<float> quadrature_;
+};
+
+GccPhatDelayEstimator::GccPhatDelayEstimator(ApmDataDumper* data_dumper,
+                                             size_t sub_block_size,
+                                             size_t max_lag,
+                                             float excitation_limit)
+    : data_dumper_(data_dumper),
+      sub_block_size_(sub_block_size),
+      max_lag_(max_lag),
+      window_size_(kWindowSubBlocks * sub_block_size),
+      render_power_threshold_(excitation_limit * excitation_limit),
+      render_history_(window_size_ + max_lag_),
+      capture_history_(window_size_, 0.f),
+      coarse_correlator_(
+          std::make_unique<Correlator>(window_size_, max_lag_ + 1, false)),
+      fine_correlator_(std::make_unique<Correlator>(window_size_,
+                                                    2 * kFineMargin + 1,
+                                                    true)) {
+  RTC_DCHECK(data_dumper);
+  RTC_DCHECK_GE(max_lag_, 2 * kFineMargin);
+}
+
+GccPhatDelayEstimator::~GccPhatDelayEstimator() = default;
+
+void GccPhatDelayEstimator::Reset() {
+  coarse_correlator_->Reset();
+  fine_correlator_->Reset();
+  coarse_lag_ = absl::nullopt;
+  fine_min_lag_ = 0;
+  sub_blocks_since_analysis_ = 0;
+  analyses_since_coarse_search_ = 0;
+  lag_estimate_[0] = MatchedFilter::LagEstimate();
+}
+
+void GccPhatDelayEstimator::Update(
+    const DownsampledRenderBuffer& render_buffer,
+    rtc::ArrayView<const float> capture) {
+  RTC_DCHECK_EQ(sub_block_size_, capture.size());
+
+  std::copy(capture_history_.begin() + sub_block_size_, capture_history_.end(),
+            capture_history_.begin());
+  std::copy(capture.begin(), capture.end(),
+            capture_history_.end() - sub_block_size_);
+
+  lag_estimate_[0].updated = false;
+  if (++sub_blocks_since_analysis_ == kAnalysisIntervalSubBlocks) {
+    sub_blocks_since_analysis_ = 0;
+    Analyze(render_buffer);
+  }
+}
+
+void GccPhatDelayEstimator::Analyze(
+    const DownsampledRenderBuffer& render_buffer) {
+  // The render buffer holds the sample aligned with the newest capture sample
+  // at the read index, and older samples at increasing indices.
+  RTC_DCHECK_LE(render_history_.size(), render_buffer.buffer.size());
+  const size_t size = render_buffer.buffer.size();
+  size_t index = render_buffer.read;
+  for (auto it = render_history_.rbegin(); it != render_history_.rend(); ++it) {
+    *it = render_buffer.buffer[index];
+    index = index < size - 1 ? index + 1 : 0;
+  }
+
+  const float render_energy =
+      std::inner_product(render_history_.begin(), render_history_.end(),
+                         render_history_.begin(), 0.f);
+  if (render_energy < render_history_.size() * render_power_threshold_) {
+    return;
+  }
+
+  // Search all lags until the delay is found, and then only now and then to
+  // detect delay changes.
+  if (!coarse_lag_ ||
+      ++analyses_since_coarse_search_ == kCoarseSearchIntervalWhenLocked) {
+    analyses_since_coarse_search_ = 0;
+    const Correlator::Peak coarse =
+        coarse_correlator_->Correlate(capture_history_, render_history_);
+    data_dumper_->DumpRaw("aec3_gcc_phat_coarse_lag", coarse.lag);
+    data_dumper_->DumpRaw("aec3_gcc_phat_coarse_peak_to_rms",
+                          coarse.peak_to_rms);
+    if (coarse.peak_to_rms < kPeakToRmsThreshold) {
+      coarse_lag_ = absl::nullopt;
+      lag_estimate_[0] =
+          MatchedFilter::LagEstimate(coarse.value, false, coarse.lag, true);
+      return;
+    }
+    coarse_lag_ = coarse.lag;
+
+    // The fine correlation is averaged over the same lags as long as the
+    // coarse estimate stays well inside them.
+    if (*coarse_lag_ < fine_min_lag_ + kFineMargin / 2 ||
+        *coarse_lag_ > fine_min_lag_ + 3 * kFineMargin / 2) {
+      fine_min_lag_ = std::min(
+          *coarse_lag_ > kFineMargin ? *coarse_lag_ - kFineMargin : 0,
+          max_lag_ - 2 * kFineMargin);
+      fine_correlator_->Reset();
+    }
+  }
+
+  // Track the delay around the coarse estimate.
+  const size_t fine_render_size = window_size_ + 2 * kFineMargin;
+  const Correlator::Peak fine = fine_correlator_->Correlate(
+      capture_history_,
+      rtc::ArrayView<const float>(
+          &render_history_[render_history_.size() - fine_render_size -
+                           fine_min_lag_],
+          fine_render_size));
+  data_dumper_->DumpRaw("aec3_gcc_phat_fine_lag", fine_min_lag_ + fine.lag);
+
+  // A peak at an inner edge of the fine search is likely outside it; fall
+  // back to the coarse estimate and repeat the coarse search.
+  if ((fine.lag == 0 && fine_min_lag_ > 0) ||
+      (fine.lag == 2 * kFineMargin &&
+       fine_min_lag_ + 2 * kFineMargin < max_lag_)) {
+    lag_estimate_[0] =
+        MatchedFilter::LagEstimate(fine.value, true, *coarse_lag_, true);
+    analyses_since_coarse_search_ = kCoarseSearchIntervalWhenLocked - 1;
+    return;
+  }
+  lag_estimate_[0] = MatchedFilter::LagEstimate(
+      fine.value, true, fine_min_lag_ + fine.lag, true);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_GCC_PHAT_DELAY_ESTIMATOR_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_GCC_PHAT_DELAY_ESTIMATOR_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/matched_filter.h"
+
+namespace webrtc {
+
+class ApmDataDumper;
+struct DownsampledRenderBuffer;
+
+// Estimates the echo path delay from the generalized cross-correlation with
+// phase transform weighting (GCC-PHAT) of the downsampled render and capture
+// signals. It is an alternative to MatchedFilter, producing lag estimates for
+// the same aggregation. A coarse search over the whole delay range runs until
+// it finds a reliable peak, and then only every few analyses to detect delay
+// changes. In between, a fine search over a few lags around the coarse
+// estimate tracks the delay. The cross-spectra are computed with FFTs over a
+// sliding window and recursively averaged, so the cost of the coarse search
+// grows as n log n with the delay range rather than linearly per sample.
+class GccPhatDelayEstimator {
+ public:
+  // |max_lag| is the largest lag, in downsampled samples, that is searched.
+  // Windows with a render power below |excitation_limit|^2 are not analyzed.
+  GccPhatDelayEstimator(ApmDataDumper* data_dumper,
+                        size_t sub_block_size,
+                        size_t max_lag,
+                        float excitation_limit);
+  ~GccPhatDelayEstimator();
+
+  GccPhatDelayEstimator(const GccPhatDelayEstimator&) = delete;
+  GccPhatDelayEstimator& operator=(const GccPhatDelayEstimator&) = delete;
+
+  // Resets the correlation estimates. The signal history is kept.
+  void Reset();
+
+  // Adds a sub-block of capture and the matching render from
+  // |render_buffer|, and updates the correlation every few sub-blocks.
+  void Update(const DownsampledRenderBuffer& render_buffer,
+              rtc::ArrayView<const float> capture);
+
+  // Returns the lag estimate; it is marked as updated only for the sub-blocks
+  // where the correlation was updated.
+  rtc::ArrayView<const MatchedFilter::LagEstimate> GetLagEstimates() const {
+    return lag_estimate_;
+  }
+
+  size_t max_lag() const { return max_lag_; }
+
+ private:
+  class Correlator;
+
+  void Analyze(const DownsampledRenderBuffer& render_buffer);
+
+  ApmDataDumper* const data_dumper_;
+  const size_t sub_block_size_;
+  const size_t max_lag_;
+  const size_t window_size_;
+  const float render_power_threshold_;
+  // Oldest sample first, newest last. The render is copied from the render
+  // buffer for each analysis.
+  std::vector<float> render_history_;
+  std::vector<float> capture_history_;
+  std::unique_ptr<Correlator> coarse_correlator_;
+  std::unique_ptr<Correlator> fine_correlator_;
+  // The lag found by the last coarse search, if reliable.
+  absl::optional<size_t> coarse_lag_;
+  size_t fine_min_lag_ = 0;
+  size_t sub_blocks_since_analysis_ = 0;
+  size_t analyses_since_coarse_search_ = 0;
+  std::array<MatchedFilter::LagEstimate, 1> lag_estimate_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_GCC_PHAT_DELAY_ESTIMATOR_H_
@@ -0,0 +1,219 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/gcc_phat_delay_estimator.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/decimator.h"
+#include "modules/audio_processing/aec3/render_delay_buffer.h"
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/string_builder.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumChannels = 1;
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+
+std::string ProduceDebugText(size_t delay, size_t down_sampling_factor) {
+  rtc::StringBuilder ss;
+  ss << "Delay: " << delay;
+  ss << ", Down sampling factor: " << down_sampling_factor;
+  return ss.Release();
+}
+
+// The largest lag covered by the matched filters for |num_filters|.
+size_t MaxLag(size_t num_filters, size_t sub_block_size) {
+  return ((num_filters - 1) * kMatchedFilterAlignmentShiftSizeSubBlocks +
+          kMatchedFilterWindowSizeSubBlocks) *
+         sub_block_size;
+}
+
+// Runs |num_blocks| of noise through an echo path of |delay_samples|
+// downsampled samples and returns the last updated lag estimate.
+MatchedFilter::LagEstimate EstimateLag(size_t down_sampling_factor,
+                                       size_t num_filters,
+                                       size_t delay_samples,
+                                       size_t num_blocks,
+                                       float capture_noise_level) {
+  Random random_generator(42U);
+  const size_t sub_block_size = kBlockSize / down_sampling_factor;
+  EchoCanceller3Config config;
+  config.delay.down_sampling_factor = down_sampling_factor;
+  config.delay.num_filters = num_filters;
+  ApmDataDumper data_dumper(0);
+  GccPhatDelayEstimator estimator(&data_dumper, sub_block_size,
+                                  MaxLag(num_filters, sub_block_size), 150.f);
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, kNumChannels));
+  Decimator capture_decimator(down_sampling_factor);
+  DelayBuffer<float> signal_delay_buffer(down_sampling_factor *
+                                         delay_samples);
+
+  Block render(kNumBands, kNumChannels);
+  std::vector<float> capture(kBlockSize, 0.f);
+  std::vector<float> noise(kBlockSize, 0.f);
+  MatchedFilter::LagEstimate last_estimate;
+  for (size_t k = 0; k < num_blocks; ++k) {
+    for (size_t band = 0; band < kNumBands; ++band) {
+      RandomizeSampleVector(&random_generator, render.View(band, 0));
+    }
+    signal_delay_buffer.Delay(render.View(/*band=*/0, /*channel=*/0), capture);
+    RandomizeSampleVector(&random_generator, noise);
+    for (size_t j = 0; j < kBlockSize; ++j) {
+      capture[j] += capture_noise_level * noise[j];
+    }
+    render_delay_buffer->Insert(render);
+    if (k == 0) {
+      render_delay_buffer->Reset();
+    }
+    render_delay_buffer->PrepareCaptureProcessing();
+
+    std::array<float, kBlockSize> downsampled_capture_data;
+    rtc::ArrayView<float> downsampled_capture(downsampled_capture_data.data(),
+                                              sub_block_size);
+    capture_decimator.Decimate(capture, downsampled_capture);
+    estimator.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                     downsampled_capture);
+    if (estimator.GetLagEstimates()[0].updated) {
+      last_estimate = estimator.GetLagEstimates()[0];
+    }
+  }
+  return last_estimate;
+}
+
+}  // namespace
+
+// Verifies that the estimator finds the delay of artificially delayed signals.
+TEST(GccPhatDelayEstimator, LagEstimation) {
+  for (size_t down_sampling_factor : {4, 8}) {
+    const size_t sub_block_size = kBlockSize / down_sampling_factor;
+    for (size_t delay_samples : {5, 64, 150, 200, 800, 1000}) {
+      SCOPED_TRACE(ProduceDebugText(delay_samples, down_sampling_factor));
+      const MatchedFilter::LagEstimate estimate =
+          EstimateLag(down_sampling_factor, 10,
+                      delay_samples, 300 + delay_samples / sub_block_size, 0.f);
+      EXPECT_TRUE(estimate.updated);
+      EXPECT_TRUE(estimate.reliable);
+      EXPECT_EQ(delay_samples, estimate.lag);
+    }
+  }
+}
+
+// Verifies that the delay is found in strong capture noise.
+TEST(GccPhatDelayEstimator, LagEstimationInNoise) {
+  constexpr size_t kDelaySamples = 300;
+  const MatchedFilter::LagEstimate estimate =
+      EstimateLag(4, 10, kDelaySamples, 300, 1.f);
+  EXPECT_TRUE(estimate.reliable);
+  EXPECT_EQ(kDelaySamples, estimate.lag);
+}
+
+// Verifies that delays of about a second are found when the number of filters
+// is configured to cover them.
+TEST(GccPhatDelayEstimator, LongDelay) {
+  constexpr size_t kDownSamplingFactor = 4;
+  constexpr size_t kSubBlockSize = kBlockSize / kDownSamplingFactor;
+  constexpr size_t kNumFilters = 12;
+  // One second at the downsampled rate of 4 kHz.
+  constexpr size_t kDelaySamples = 4000;
+  ASSERT_LT(kDelaySamples, MaxLag(kNumFilters, kSubBlockSize));
+  const MatchedFilter::LagEstimate estimate =
+      EstimateLag(kDownSamplingFactor, kNumFilters, kDelaySamples,
+                  300 + kDelaySamples / kSubBlockSize, 0.f);
+  EXPECT_TRUE(estimate.reliable);
+  EXPECT_EQ(kDelaySamples, estimate.lag);
+}
+
+// Verifies that the estimates are not reliable for uncorrelated render and
+// capture signals.
+TEST(GccPhatDelayEstimator, LagNotReliableForUncorrelatedRenderAndCapture) {
+  Random random_generator(42U);
+  for (size_t down_sampling_factor : {4, 8}) {
+    SCOPED_TRACE(ProduceDebugText(0, down_sampling_factor));
+    const size_t sub_block_size = kBlockSize / down_sampling_factor;
+    EchoCanceller3Config config;
+    config.delay.down_sampling_factor = down_sampling_factor;
+    config.delay.num_filters = 10;
+    ApmDataDumper data_dumper(0);
+    GccPhatDelayEstimator estimator(&data_dumper, sub_block_size,
+                                    MaxLag(10, sub_block_size), 150.f);
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(config, kSampleRateHz, kNumChannels));
+    Block render(kNumBands, kNumChannels);
+    std::vector<float> capture(sub_block_size);
+
+    // Check the estimates once the render buffer has been filled.
+    size_t num_updates = 0;
+    for (size_t k = 0; k < 1000; ++k) {
+      RandomizeSampleVector(&random_generator,
+                            render.View(/*band=*/0, /*channel=*/0));
+      RandomizeSampleVector(&random_generator, capture);
+      render_delay_buffer->Insert(render);
+      render_delay_buffer->PrepareCaptureProcessing();
+      estimator.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                       capture);
+      const MatchedFilter::LagEstimate& estimate =
+          estimator.GetLagEstimates()[0];
+      if (k > 300 && estimate.updated) {
+        ++num_updates;
+        EXPECT_FALSE(estimate.reliable);
+      }
+    }
+    EXPECT_LT(0u, num_updates);
+  }
+}
+
+// Verifies that no estimates are produced for render signals of low level.
+TEST(GccPhatDelayEstimator, LagNotUpdatedForLowLevelRender) {
+  constexpr size_t kDownSamplingFactor = 4;
+  constexpr size_t kSubBlockSize = kBlockSize / kDownSamplingFactor;
+  Random random_generator(42U);
+  EchoCanceller3Config config;
+  config.delay.down_sampling_factor = kDownSamplingFactor;
+  config.delay.num_filters = 10;
+  ApmDataDumper data_dumper(0);
+  GccPhatDelayEstimator estimator(&data_dumper, kSubBlockSize,
+                                  MaxLag(10, kSubBlockSize), 150.f);
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, kNumChannels));
+  Block render(kNumBands, kNumChannels);
+  std::vector<float> capture(kSubBlockSize);
+
+  for (size_t k = 0; k < 100; ++k) {
+    RandomizeSampleVector(&random_generator,
+                          render.View(/*band=*/0, /*channel=*/0));
+    for (float& x : render.View(/*band=*/0, /*channel=*/0)) {
+      x *= 149.f / 32767.f;
+    }
+    std::copy(render.begin(/*band=*/0, /*channel=*/0),
+              render.begin(/*band=*/0, /*channel=*/0) + kSubBlockSize,
+              capture.begin());
+    render_delay_buffer->Insert(render);
+    render_delay_buffer->PrepareCaptureProcessing();
+    estimator.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                     capture);
+    EXPECT_FALSE(estimator.GetLagEstimates()[0].updated);
+    EXPECT_FALSE(estimator.GetLagEstimates()[0].reliable);
+  }
+}
+
+}  // namespace webrtc
@@ -11,8 +11,7 @@
 //#ifndef MODULES_AUDIO_PROCESSING_AEC3_MOCK_MOCK_BLOCK_PROCESSOR_H_
 //#define MODULES_AUDIO_PROCESSING_AEC3_MOCK_MOCK_BLOCK_PROCESSOR_H_
 
-//#include <vector>
-
+//#include "modules/audio_processing/aec3/block.h"
 //#include "modules/audio_processing/aec3/block_processor.h"
 //#include "test/gmock.h"
 
@@ -24,17 +23,17 @@
 //  MockBlockProcessor();
 //  virtual ~MockBlockProcessor();
 
-//  MOCK_METHOD4(
-//      ProcessCapture,
-//      void(bool level_change,
-//           bool saturated_microphone_signal,
-//           std::vector<std::vector<std::vector<float>>>* linear_output,
-//           std::vector<std::vector<std::vector<float>>>* capture_block));
-//  MOCK_METHOD1(BufferRender,
-//               void(const std::vector<std::vector<std::vector<float>>>& block));
+//  MOCK_METHOD4(ProcessCapture,
+//               void(bool level_change,
+//                    bool saturated_microphone_signal,
+//                    Block* linear_output,
+//                    Block* capture_block));
+//  MOCK_METHOD1(BufferRender, void(const Block& block));
 //  MOCK_METHOD1(UpdateEchoLeakageStatus, void(bool leakage_detected));
 //  MOCK_CONST_METHOD1(GetMetrics, void(EchoControl::Metrics* metrics));
 //  MOCK_METHOD1(SetAudioBufferDelay, void(int delay_ms));
+//  MOCK_CONST_METHOD1(GetWarmStartState, void(WarmStartState* state));
+//  MOCK_METHOD1(SetWarmStartState, bool(const WarmStartState& state));
 //};
 
 //}  // namespace test
@@ -11,9 +11,8 @@
 //#ifndef MODULES_AUDIO_PROCESSING_AEC3_MOCK_MOCK_ECHO_REMOVER_H_
 //#define MODULES_AUDIO_PROCESSING_AEC3_MOCK_MOCK_ECHO_REMOVER_H_
 
-//#include <vector>
-
 //#include "absl/types/optional.h"
+//#include "modules/audio_processing/aec3/block.h"
 //#include "modules/audio_processing/aec3/echo_path_variability.h"
 //#include "modules/audio_processing/aec3/echo_remover.h"
 //#include "modules/audio_processing/aec3/render_buffer.h"
@@ -32,11 +31,14 @@
 //                    bool capture_signal_saturation,
 //                    const absl::optional<DelayEstimate>& delay_estimate,
 //                    RenderBuffer* render_buffer,
-//                    std::vector<std::vector<std::vector<float>>>* linear_output,
-//                    std::vector<std::vector<std::vector<float>>>* capture));
+//                    Block* linear_output,
+//                    Block* capture));
 //  MOCK_CONST_METHOD0(Delay, absl::optional<int>());
 //  MOCK_METHOD1(UpdateEchoLeakageStatus, void(bool leakage_detected));
 //  MOCK_CONST_METHOD1(GetMetrics, void(EchoControl::Metrics* metrics));
+//  MOCK_CONST_METHOD0(SteadyState, bool());
+//  MOCK_CONST_METHOD1(GetWarmStartState, void(WarmStartState* state));
+//  MOCK_METHOD1(SetWarmStartState, bool(const WarmStartState& state));
 //};
 
 //}  // namespace test
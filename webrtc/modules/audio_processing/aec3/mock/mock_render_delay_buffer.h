@@ -11,9 +11,8 @@
 //#ifndef MODULES_AUDIO_PROCESSING_AEC3_MOCK_MOCK_RENDER_DELAY_BUFFER_H_
 //#define MODULES_AUDIO_PROCESSING_AEC3_MOCK_MOCK_RENDER_DELAY_BUFFER_H_
 
-//#include <vector>
-
 //#include "modules/audio_processing/aec3/aec3_common.h"
+//#include "modules/audio_processing/aec3/block.h"
 //#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
 //#include "modules/audio_processing/aec3/render_buffer.h"
 //#include "modules/audio_processing/aec3/render_delay_buffer.h"
@@ -29,8 +28,7 @@
 
 //  MOCK_METHOD0(Reset, void());
 //  MOCK_METHOD1(Insert,
-//               RenderDelayBuffer::BufferingEvent(
-//                   const std::vector<std::vector<std::vector<float>>>& block));
+//               RenderDelayBuffer::BufferingEvent(const Block& block));
 //  MOCK_METHOD0(PrepareCaptureProcessing, RenderDelayBuffer::BufferingEvent());
 //  MOCK_METHOD1(AlignFromDelay, bool(size_t delay));
 //  MOCK_METHOD0(AlignFromExternalDelay, void());
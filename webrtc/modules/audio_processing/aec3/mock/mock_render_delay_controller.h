@@ -13,6 +13,7 @@
 
 //#include "absl/types/optional.h"
 //#include "api/array_view.h"
+//#include "modules/audio_processing/aec3/block.h"
 //#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
 //#include "modules/audio_processing/aec3/render_delay_controller.h"
 //#include "test/gmock.h"
@@ -31,8 +32,10 @@
 //               absl::optional<DelayEstimate>(
 //                   const DownsampledRenderBuffer& render_buffer,
 //                   size_t render_delay_buffer_delay,
-//                   const std::vector<std::vector<float>>& capture));
+//                   const Block& capture));
 //  MOCK_CONST_METHOD0(HasClockdrift, bool());
+//  MOCK_METHOD1(SetSteadyState, void(bool steady_state));
+//  MOCK_METHOD1(SetWarmStartDelay, void(size_t delay_blocks));
 //};
 
 //}  // namespace test
@@ -36,8 +36,7 @@ class RenderBuffer {
   ~RenderBuffer();
 
   // Get a block.
-  const std::vector<std::vector<std::vector<float>>>& Block(
-      int buffer_offset_blocks) const {
+  const Block& GetBlock(int buffer_offset_blocks) const {
     int position =
         block_buffer_->OffsetIndex(block_buffer_->read, buffer_offset_blocks);
     return block_buffer_->buffer[position];
@@ -42,15 +42,19 @@ class RenderDelayControllerImpl final : public RenderDelayController {
   absl::optional<DelayEstimate> GetDelay(
       const DownsampledRenderBuffer& render_buffer,
       size_t render_delay_buffer_delay,
-      const std::vector<std::vector<float>>& capture) override;
+      const Block& capture) override;
   bool HasClockdrift() const override;
+  void SetSteadyState(bool steady_state) override;
+  void SetWarmStartDelay(size_t delay_blocks) override;
 
  private:
   static int instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
   const int hysteresis_limit_blocks_;
   const int delay_headroom_samples_;
+  const size_t steady_state_delay_search_interval_blocks_;
   absl::optional<DelayEstimate> delay_;
+  absl::optional<DelayEstimate> warm_start_delay_;
   EchoPathDelayEstimator delay_estimator_;
   RenderDelayControllerMetrics metrics_;
   absl::optional<DelayEstimate> delay_samples_;
@@ -97,6 +101,10 @@ RenderDelayControllerImpl::RenderDelayControllerImpl(
       hysteresis_limit_blocks_(
           static_cast<int>(config.delay.hysteresis_limit_blocks)),
       delay_headroom_samples_(config.delay.delay_headroom_samples),
+      steady_state_delay_search_interval_blocks_(
+          config.duty_cycling.enabled
+              ? config.duty_cycling.delay_search_interval_blocks
+              : 1),
       delay_estimator_(data_dumper_.get(), config, num_capture_channels),
       last_delay_estimate_quality_(DelayEstimate::Quality::kCoarse) {
   RTC_DCHECK(ValidFullBandRate(sample_rate_hz));
@@ -120,8 +128,7 @@ void RenderDelayControllerImpl::LogRenderCall() {}
 absl::optional<DelayEstimate> RenderDelayControllerImpl::GetDelay(
     const DownsampledRenderBuffer& render_buffer,
     size_t render_delay_buffer_delay,
-    const std::vector<std::vector<float>>& capture) {
-  RTC_DCHECK_EQ(kBlockSize, capture[0].size());
+    const Block& capture) {
   ++capture_call_counter_;
 
   auto delay_samples = delay_estimator_.EstimateDelay(render_buffer, capture);
@@ -161,8 +168,14 @@ absl::optional<DelayEstimate> RenderDelayControllerImpl::GetDelay(
                                 use_hysteresis ? hysteresis_limit_blocks_ : 0,
                                 delay_headroom_samples_, *delay_samples_);
     last_delay_estimate_quality_ = delay_samples_->quality;
+    warm_start_delay_ = absl::nullopt;
+  } else if (warm_start_delay_) {
+    delay_ = warm_start_delay_;
   }
 
+  if (delay_estimator_.DelaySearchSkipped()) {
+    metrics_.LogSkippedDelaySearch();
+  }
   metrics_.Update(delay_samples_ ? absl::optional<size_t>(delay_samples_->delay)
                                  : absl::nullopt,
                   delay_ ? delay_->delay : 0, 0, delay_estimator_.Clockdrift());
@@ -179,6 +192,16 @@ bool RenderDelayControllerImpl::HasClockdrift() const {
   return delay_estimator_.Clockdrift() != ClockdriftDetector::Level::kNone;
 }
 
+void RenderDelayControllerImpl::SetSteadyState(bool steady_state) {
+  delay_estimator_.SetDelaySearchInterval(
+      steady_state ? steady_state_delay_search_interval_blocks_ : 1);
+}
+
+void RenderDelayControllerImpl::SetWarmStartDelay(size_t delay_blocks) {
+  warm_start_delay_ =
+      DelayEstimate(DelayEstimate::Quality::kCoarse, delay_blocks);
+}
+
 }  // namespace
 
 RenderDelayController* RenderDelayController::Create(
@@ -14,6 +14,7 @@
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
@@ -40,10 +41,18 @@ class RenderDelayController {
   virtual absl::optional<DelayEstimate> GetDelay(
       const DownsampledRenderBuffer& render_buffer,
       size_t render_delay_buffer_delay,
-      const std::vector<std::vector<float>>& capture) = 0;
+      const Block& capture) = 0;
 
   // Returns true if clockdrift has been detected.
   virtual bool HasClockdrift() const = 0;
+
+  // Sets whether the echo canceller is in a steady state where the delay
+  // search can be run at a reduced rate.
+  virtual void SetSteadyState(bool steady_state) = 0;
+
+  // Sets a previously estimated delay, in blocks, to use until the first delay
+  // estimate is available.
+  virtual void SetWarmStartDelay(size_t delay_blocks) = 0;
 };
 }  // namespace webrtc
 
@@ -120,6 +120,10 @@ void RenderDelayControllerMetrics::Update(
         "WebRTC.Audio.EchoCanceller.Clockdrift", static_cast<int>(clockdrift),
         static_cast<int>(ClockdriftDetector::Level::kNumCategories));
 
+    RTC_HISTOGRAM_PERCENTAGE(
+        "WebRTC.Audio.EchoCanceller.SkippedDelaySearches",
+        100 * skipped_delay_search_counter_ / kMetricsReportingIntervalBlocks);
+
     metrics_reported_ = true;
     call_counter_ = 0;
     ResetMetrics();
@@ -140,6 +144,7 @@ void RenderDelayControllerMetrics::Update(
 void RenderDelayControllerMetrics::ResetMetrics() {
   delay_change_counter_ = 0;
   reliable_delay_estimate_counter_ = 0;
+  skipped_delay_search_counter_ = 0;
 }
 
 }  // namespace webrtc
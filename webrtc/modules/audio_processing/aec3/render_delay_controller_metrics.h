@@ -30,6 +30,10 @@ class RenderDelayControllerMetrics {
               absl::optional<int> skew_shift_blocks,
               ClockdriftDetector::Level clockdrift);
 
+  // Logs that the delay search was skipped for the current block due to duty
+  // cycling. Must be called before Update() for that block.
+  void LogSkippedDelaySearch() { ++skipped_delay_search_counter_; }
+
   // Returns true if the metrics have just been reported, otherwise false.
   bool MetricsReported() { return metrics_reported_; }
 
@@ -40,6 +44,7 @@ class RenderDelayControllerMetrics {
   size_t delay_blocks_ = 0;
   int reliable_delay_estimate_counter_ = 0;
   int delay_change_counter_ = 0;
+  int skipped_delay_search_counter_ = 0;
   int call_counter_ = 0;
   int skew_report_timer_ = 0;
   int initial_call_counter_ = 0;
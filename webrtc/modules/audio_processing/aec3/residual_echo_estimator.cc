@@ -17,6 +17,7 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/reverb_model.h"
+#include "modules/audio_processing/aec3/vector_math.h"
 #include "rtc_base/checks.h"
 #include "system_wrappers/include/field_trial.h"
 
@@ -103,48 +104,49 @@ void GetRenderIndexesToAnalyze(
 // Estimates the residual echo power based on the echo return loss enhancement
 // (ERLE) and the linear power estimate.
 void LinearEstimate(
+    Aec3Optimization optimization,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> S2_linear,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle,
     rtc::ArrayView<std::array<float, kFftLengthBy2Plus1>> R2) {
   RTC_DCHECK_EQ(S2_linear.size(), erle.size());
   RTC_DCHECK_EQ(S2_linear.size(), R2.size());
 
+  aec3::VectorMath vector_math(optimization);
   const size_t num_capture_channels = R2.size();
   for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-      RTC_DCHECK_LT(0.f, erle[ch][k]);
-      R2[ch][k] = S2_linear[ch][k] / erle[ch][k];
-    }
+    RTC_DCHECK(std::all_of(erle[ch].begin(), erle[ch].end(),
+                           [](float a) { return a > 0.f; }));
+    vector_math.Divide(S2_linear[ch], erle[ch], R2[ch]);
   }
 }
 
 // Estimates the residual echo power based on an uncertainty estimate of the
 // echo return loss enhancement (ERLE) and the linear power estimate.
 void LinearEstimate(
+    Aec3Optimization optimization,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> S2_linear,
     float erle_uncertainty,
     rtc::ArrayView<std::array<float, kFftLengthBy2Plus1>> R2) {
   RTC_DCHECK_EQ(S2_linear.size(), R2.size());
 
+  aec3::VectorMath vector_math(optimization);
   const size_t num_capture_channels = R2.size();
   for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-      R2[ch][k] = S2_linear[ch][k] * erle_uncertainty;
-    }
+    vector_math.Scale(erle_uncertainty, S2_linear[ch], R2[ch]);
   }
 }
 
 // Estimates the residual echo power based on the estimate of the echo path
 // gain.
 void NonLinearEstimate(
+    Aec3Optimization optimization,
     float echo_path_gain,
     const std::array<float, kFftLengthBy2Plus1>& X2,
     rtc::ArrayView<std::array<float, kFftLengthBy2Plus1>> R2) {
+  aec3::VectorMath vector_math(optimization);
   const size_t num_capture_channels = R2.size();
   for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-      R2[ch][k] = X2[k] * echo_path_gain;
-    }
+    vector_math.Scale(echo_path_gain, X2, R2[ch]);
   }
 }
 
@@ -161,7 +163,8 @@ void ApplyNoiseGate(const EchoCanceller3Config::EchoModel& config,
 
 // Estimates the echo generating signal power as gated maximal power over a
 // time window.
-void EchoGeneratingPower(size_t num_render_channels,
+void EchoGeneratingPower(Aec3Optimization optimization,
+                         size_t num_render_channels,
                          const SpectrumBuffer& spectrum_buffer,
                          const EchoCanceller3Config::EchoModel& echo_model,
                          int filter_delay_blocks,
@@ -171,26 +174,20 @@ void EchoGeneratingPower(size_t num_render_channels,
   GetRenderIndexesToAnalyze(spectrum_buffer, echo_model, filter_delay_blocks,
                             &idx_start, &idx_stop);
 
+  aec3::VectorMath vector_math(optimization);
   std::fill(X2.begin(), X2.end(), 0.f);
   if (num_render_channels == 1) {
     for (int k = idx_start; k != idx_stop; k = spectrum_buffer.IncIndex(k)) {
-      for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
-        X2[j] = std::max(X2[j], spectrum_buffer.buffer[k][/*channel=*/0][j]);
-      }
+      vector_math.Max(spectrum_buffer.buffer[k][/*channel=*/0], X2);
     }
   } else {
     for (int k = idx_start; k != idx_stop; k = spectrum_buffer.IncIndex(k)) {
       std::array<float, kFftLengthBy2Plus1> render_power;
       render_power.fill(0.f);
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        const auto& channel_power = spectrum_buffer.buffer[k][ch];
-        for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
-          render_power[j] += channel_power[j];
-        }
-      }
-      for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
-        X2[j] = std::max(X2[j], render_power[j]);
+        vector_math.Accumulate(spectrum_buffer.buffer[k][ch], render_power);
       }
+      vector_math.Max(render_power, X2);
     }
   }
 }
@@ -198,8 +195,10 @@ void EchoGeneratingPower(size_t num_render_channels,
 }  // namespace
 
 ResidualEchoEstimator::ResidualEchoEstimator(const EchoCanceller3Config& config,
+                                             Aec3Optimization optimization,
                                              size_t num_render_channels)
     : config_(config),
+      optimization_(optimization),
       num_render_channels_(num_render_channels),
       early_reflections_transparent_mode_gain_(
           GetEarlyReflectionsTransparentModeGain()),
@@ -209,7 +208,8 @@ ResidualEchoEstimator::ResidualEchoEstimator(const EchoCanceller3Config& config,
           GetEarlyReflectionsDefaultModeGain(config_.ep_strength)),
       late_reflections_general_gain_(
           GetLateReflectionsDefaultModeGain(config_.ep_strength)),
-      model_reverb_in_nonlinear_mode_(ModelReverbInNonlinearMode()) {
+      model_reverb_in_nonlinear_mode_(ModelReverbInNonlinearMode()),
+      echo_reverb_(optimization_) {
   Reset();
 }
 
@@ -240,9 +240,9 @@ void ResidualEchoEstimator::Estimate(
     } else {
       absl::optional<float> erle_uncertainty = aec_state.ErleUncertainty();
       if (erle_uncertainty) {
-        LinearEstimate(S2_linear, *erle_uncertainty, R2);
+        LinearEstimate(optimization_, S2_linear, *erle_uncertainty, R2);
       } else {
-        LinearEstimate(S2_linear, aec_state.Erle(), R2);
+        LinearEstimate(optimization_, S2_linear, aec_state.Erle(), R2);
       }
     }
 
@@ -260,7 +260,7 @@ void ResidualEchoEstimator::Estimate(
     } else {
       // Estimate the echo generating signal power.
       std::array<float, kFftLengthBy2Plus1> X2;
-      EchoGeneratingPower(num_render_channels_,
+      EchoGeneratingPower(optimization_, num_render_channels_,
                           render_buffer.GetSpectrumBuffer(), config_.echo_model,
                           aec_state.MinDirectPathFilterDelay(), X2);
       if (!aec_state.UseStationarityProperties()) {
@@ -274,7 +274,7 @@ void ResidualEchoEstimator::Estimate(
         X2[k] = std::max(0.f, X2[k]);
       }
 
-      NonLinearEstimate(echo_path_gain, X2, R2);
+      NonLinearEstimate(optimization_, echo_path_gain, X2, R2);
     }
 
     if (model_reverb_in_nonlinear_mode_ && !aec_state.TransparentMode()) {
@@ -286,10 +286,9 @@ void ResidualEchoEstimator::Estimate(
     // Scale the echo according to echo audibility.
     std::array<float, kFftLengthBy2Plus1> residual_scaling;
     aec_state.GetResidualEchoScaling(residual_scaling);
+    aec3::VectorMath vector_math(optimization_);
     for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        R2[ch][k] *= residual_scaling[k];
-      }
+      vector_math.Multiply(R2[ch], residual_scaling, R2[ch]);
     }
   }
 }
@@ -309,11 +308,9 @@ void ResidualEchoEstimator::UpdateRenderNoisePower(
       X2[/*channel=*/0];
   if (num_render_channels_ > 1) {
     render_power_data.fill(0.f);
+    aec3::VectorMath vector_math(optimization_);
     for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-      const auto& channel_power = X2[ch];
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        render_power_data[k] += channel_power[k];
-      }
+      vector_math.Accumulate(X2[ch], render_power_data);
     }
     render_power = render_power_data;
   }
@@ -359,11 +356,9 @@ void ResidualEchoEstimator::AddReverb(
       X2[/*channel=*/0];
   if (num_render_channels_ > 1) {
     render_power_data.fill(0.f);
+    aec3::VectorMath vector_math(optimization_);
     for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-      const auto& channel_power = X2[ch];
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        render_power_data[k] += channel_power[k];
-      }
+      vector_math.Accumulate(X2[ch], render_power_data);
     }
     render_power = render_power_data;
   }
@@ -383,10 +378,9 @@ void ResidualEchoEstimator::AddReverb(
   // Add the reverb power.
   rtc::ArrayView<const float, kFftLengthBy2Plus1> reverb_power =
       echo_reverb_.reverb();
+  aec3::VectorMath vector_math(optimization_);
   for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-      R2[ch][k] += reverb_power[k];
-    }
+    vector_math.Accumulate(reverb_power, R2[ch]);
   }
 }
 
@@ -28,6 +28,7 @@ namespace webrtc {
 class ResidualEchoEstimator {
  public:
   ResidualEchoEstimator(const EchoCanceller3Config& config,
+                        Aec3Optimization optimization,
                         size_t num_render_channels);
   ~ResidualEchoEstimator();
 
@@ -63,6 +64,7 @@ class ResidualEchoEstimator {
                         bool gain_for_early_reflections) const;
 
   const EchoCanceller3Config config_;
+  const Aec3Optimization optimization_;
   const size_t num_render_channels_;
   const float early_reflections_transparent_mode_gain_;
   const float late_reflections_transparent_mode_gain_;
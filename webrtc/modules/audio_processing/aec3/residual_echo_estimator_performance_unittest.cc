@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/aec_state.h"
+#include "modules/audio_processing/aec3/delay_estimate.h"
+#include "modules/audio_processing/aec3/render_delay_buffer.h"
+#include "modules/audio_processing/aec3/residual_echo_estimator.h"
+#include "modules/audio_processing/aec3/subtractor_output.h"
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+// Number of blocks used for building up the render and AEC state.
+constexpr int kNumWarmUpBlocks = 500;
+
+int NumIterations() {
+  const int kNumIterations = 100000;
+  const int kQuickNumIterations = 1000;
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumIterations
+                                                        : kNumIterations;
+}
+
+// Measures the per-block cost of estimating the residual echo power, for both
+// the linear and the nonlinear echo model, and reports the throughput in
+// blocks per second.
+void RunAndReport(Aec3Optimization optimization,
+                  bool usable_linear_estimate,
+                  size_t num_render_channels,
+                  size_t num_capture_channels) {
+  EchoCanceller3Config config;
+  ResidualEchoEstimator estimator(config, optimization, num_render_channels);
+  AecState aec_state(config, num_capture_channels);
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, num_render_channels));
+
+  std::vector<std::array<float, kFftLengthBy2Plus1>> E2_refined(
+      num_capture_channels);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> S2_linear(
+      num_capture_channels);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> Y2(num_capture_channels);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> R2(num_capture_channels);
+  Block x(NumBandsForRate(kSampleRateHz), num_render_channels);
+  std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>> H2(
+      num_capture_channels,
+      std::vector<std::array<float, kFftLengthBy2Plus1>>(
+          config.filter.refined.length_blocks));
+  std::vector<std::vector<float>> h(
+      num_capture_channels,
+      std::vector<float>(
+          GetTimeDomainLength(config.filter.refined.length_blocks), 0.f));
+  std::vector<SubtractorOutput> output(num_capture_channels);
+  absl::optional<DelayEstimate> delay_estimate;
+  Random random_generator(42U);
+
+  for (size_t ch = 0; ch < num_capture_channels; ++ch) {
+    for (auto& H2_k : H2[ch]) {
+      H2_k.fill(0.01f);
+    }
+    H2[ch][2].fill(10.f);
+    h[ch][2 * kBlockSize] = 1.f;
+    output[ch].Reset();
+    output[ch].s_refined.fill(100.f);
+    E2_refined[ch].fill(10.f);
+    S2_linear[ch].fill(10.f);
+    Y2[ch].fill(1000.f);
+  }
+  if (usable_linear_estimate) {
+    delay_estimate = DelayEstimate(DelayEstimate::Quality::kRefined, 0);
+  }
+
+  for (int k = 0; k < kNumWarmUpBlocks; ++k) {
+    for (size_t ch = 0; ch < num_render_channels; ++ch) {
+      RandomizeSampleVector(&random_generator, x.View(/*band=*/0, ch));
+    }
+    render_delay_buffer->Insert(x);
+    if (k == 0) {
+      render_delay_buffer->Reset();
+    }
+    render_delay_buffer->PrepareCaptureProcessing();
+    aec_state.Update(delay_estimate, H2, h,
+                     *render_delay_buffer->GetRenderBuffer(), E2_refined, Y2,
+                     output);
+  }
+  const RenderBuffer& render_buffer = *render_delay_buffer->GetRenderBuffer();
+
+  const int num_iterations = NumIterations();
+  Clock* clock = Clock::GetRealTimeClock();
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int n = 0; n < num_iterations; ++n) {
+    estimator.Estimate(aec_state, render_buffer, S2_linear, Y2, R2);
+  }
+  const int64_t runtime_us = clock->TimeInMicroseconds() - start_time_us;
+  ASSERT_GT(runtime_us, 0);
+  test::PrintResult(
+      "aec3_residual_echo_estimator",
+      std::string(usable_linear_estimate ? "_linear" : "_nonlinear") +
+          (optimization == Aec3Optimization::kNone ? "_none" : "_optimized"),
+      "channels_" + std::to_string(num_render_channels) + "_" +
+          std::to_string(num_capture_channels),
+      1e6 * num_iterations / runtime_us, "blocks_per_second_per_core", true);
+}
+
+}  // namespace
+
+TEST(ResidualEchoEstimatorPerformanceTest, Optimizations) {
+  for (bool usable_linear_estimate : {true, false}) {
+    for (size_t num_channels : {1, 2, 8}) {
+      RunAndReport(Aec3Optimization::kNone, usable_linear_estimate,
+                   num_channels, num_channels);
+      RunAndReport(DetectOptimization(), usable_linear_estimate, num_channels,
+                   num_channels);
+    }
+  }
+}
+
+}  // namespace webrtc
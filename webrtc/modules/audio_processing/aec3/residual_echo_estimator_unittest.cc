@@ -37,7 +37,8 @@ TEST_P(ResidualEchoEstimatorMultiChannel, BasicTest) {
   constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
 
   EchoCanceller3Config config;
-  ResidualEchoEstimator estimator(config, num_render_channels);
+  ResidualEchoEstimator estimator(config, DetectOptimization(),
+                                  num_render_channels);
   AecState aec_state(config, num_capture_channels);
   std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
       RenderDelayBuffer::Create(config, kSampleRateHz, num_render_channels));
@@ -48,9 +49,7 @@ TEST_P(ResidualEchoEstimatorMultiChannel, BasicTest) {
       num_capture_channels);
   std::vector<std::array<float, kFftLengthBy2Plus1>> Y2(num_capture_channels);
   std::vector<std::array<float, kFftLengthBy2Plus1>> R2(num_capture_channels);
-  std::vector<std::vector<std::vector<float>>> x(
-      kNumBands, std::vector<std::vector<float>>(
-                     num_render_channels, std::vector<float>(kBlockSize, 0.f)));
+  Block x(kNumBands, num_render_channels);
   std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>> H2(
       num_capture_channels,
       std::vector<std::array<float, kFftLengthBy2Plus1>>(10));
@@ -88,7 +87,7 @@ TEST_P(ResidualEchoEstimatorMultiChannel, BasicTest) {
   }
 
   for (int k = 0; k < 1993; ++k) {
-    RandomizeSampleVector(&random_generator, x[0][0]);
+    RandomizeSampleVector(&random_generator, x.View(/*band=*/0, /*channel=*/0));
     render_delay_buffer->Insert(x);
     if (k == 0) {
       render_delay_buffer->Reset();
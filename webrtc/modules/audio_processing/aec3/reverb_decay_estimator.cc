@@ -100,6 +100,14 @@ ReverbDecayEstimator::ReverbDecayEstimator(const EchoCanceller3Config& config)
 
 ReverbDecayEstimator::~ReverbDecayEstimator() = default;
 
+void ReverbDecayEstimator::RestoreDecay(float decay) {
+  if (use_adaptive_echo_decay_) {
+    constexpr float kMaxDecay = 0.95f;
+    constexpr float kMinDecay = 0.02f;
+    decay_ = std::min(std::max(decay, kMinDecay), kMaxDecay);
+  }
+}
+
 void ReverbDecayEstimator::Update(rtc::ArrayView<const float> filter,
                                   const absl::optional<float>& filter_quality,
                                   int filter_delay_blocks,
@@ -36,6 +36,9 @@ class ReverbDecayEstimator {
               bool stationary_signal);
   // Returns the decay for the exponential model.
   float Decay() const { return decay_; }
+  // Restores a previously estimated decay. Has no effect if the decay is not
+  // adaptively estimated.
+  void RestoreDecay(float decay);
   // Dumps debug data.
   void Dump(ApmDataDumper* data_dumper) const;
 
@@ -54,6 +54,15 @@ ReverbFrequencyResponse::ReverbFrequencyResponse() {
 }
 ReverbFrequencyResponse::~ReverbFrequencyResponse() = default;
 
+void ReverbFrequencyResponse::Restore(
+    float average_decay,
+    rtc::ArrayView<const float, kFftLengthBy2Plus1> tail_response) {
+  average_decay_ = std::max(average_decay, 0.f);
+  std::transform(tail_response.begin(), tail_response.end(),
+                 tail_response_.begin(),
+                 [](float a) { return std::max(a, 0.f); });
+}
+
 void ReverbFrequencyResponse::Update(
     const std::vector<std::array<float, kFftLengthBy2Plus1>>&
         frequency_response,
@@ -38,6 +38,13 @@ class ReverbFrequencyResponse {
     return tail_response_;
   }
 
+  // Returns the smoothed energy ratio between the tail and the direct path.
+  float AverageDecay() const { return average_decay_; }
+
+  // Restores a previously estimated frequency response.
+  void Restore(float average_decay,
+               rtc::ArrayView<const float, kFftLengthBy2Plus1> tail_response);
+
  private:
   void Update(const std::vector<std::array<float, kFftLengthBy2Plus1>>&
                   frequency_response,
@@ -16,10 +16,13 @@
 #include <functional>
 
 #include "api/array_view.h"
+#include "modules/audio_processing/aec3/vector_math.h"
+#include "rtc_base/checks.h"
 
 namespace webrtc {
 
-ReverbModel::ReverbModel() {
+ReverbModel::ReverbModel(Aec3Optimization optimization)
+    : optimization_(optimization) {
   Reset();
 }
 
@@ -33,12 +36,17 @@ void ReverbModel::UpdateReverbNoFreqShaping(
     rtc::ArrayView<const float> power_spectrum,
     float power_spectrum_scaling,
     float reverb_decay) {
+  RTC_DCHECK_LE(power_spectrum.size(), reverb_.size());
   if (reverb_decay > 0) {
     // Update the estimate of the reverberant power.
-    for (size_t k = 0; k < power_spectrum.size(); ++k) {
-      reverb_[k] = (reverb_[k] + power_spectrum[k] * power_spectrum_scaling) *
-                   reverb_decay;
-    }
+    aec3::VectorMath vector_math(optimization_);
+    std::array<float, kFftLengthBy2Plus1> scaled_power_spectrum;
+    rtc::ArrayView<float> scaled_power(scaled_power_spectrum.data(),
+                                       power_spectrum.size());
+    rtc::ArrayView<float> reverb(reverb_.data(), power_spectrum.size());
+    vector_math.Scale(power_spectrum_scaling, power_spectrum, scaled_power);
+    vector_math.Accumulate(scaled_power, reverb);
+    vector_math.Scale(reverb_decay, reverb, reverb);
   }
 }
 
@@ -46,13 +54,18 @@ void ReverbModel::UpdateReverb(
     rtc::ArrayView<const float> power_spectrum,
     rtc::ArrayView<const float> power_spectrum_scaling,
     float reverb_decay) {
+  RTC_DCHECK_LE(power_spectrum.size(), reverb_.size());
+  RTC_DCHECK_EQ(power_spectrum.size(), power_spectrum_scaling.size());
   if (reverb_decay > 0) {
     // Update the estimate of the reverberant power.
-    for (size_t k = 0; k < power_spectrum.size(); ++k) {
-      reverb_[k] =
-          (reverb_[k] + power_spectrum[k] * power_spectrum_scaling[k]) *
-          reverb_decay;
-    }
+    aec3::VectorMath vector_math(optimization_);
+    std::array<float, kFftLengthBy2Plus1> scaled_power_spectrum;
+    rtc::ArrayView<float> scaled_power(scaled_power_spectrum.data(),
+                                       power_spectrum.size());
+    rtc::ArrayView<float> reverb(reverb_.data(), power_spectrum.size());
+    vector_math.Multiply(power_spectrum, power_spectrum_scaling, scaled_power);
+    vector_math.Accumulate(scaled_power, reverb);
+    vector_math.Scale(reverb_decay, reverb, reverb);
   }
 }
 
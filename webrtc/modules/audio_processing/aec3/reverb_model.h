@@ -22,7 +22,7 @@ namespace webrtc {
 // that can be applied over power spectrums.
 class ReverbModel {
  public:
-  ReverbModel();
+  explicit ReverbModel(Aec3Optimization optimization);
   ~ReverbModel();
 
   // Resets the state.
@@ -50,6 +50,7 @@ class ReverbModel {
 
  private:
 
+  const Aec3Optimization optimization_;
   std::array<float, kFftLengthBy2Plus1> reverb_;
 };
 
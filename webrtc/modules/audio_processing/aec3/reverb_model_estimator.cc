@@ -24,6 +24,16 @@ ReverbModelEstimator::ReverbModelEstimator(const EchoCanceller3Config& config,
 
 ReverbModelEstimator::~ReverbModelEstimator() = default;
 
+void ReverbModelEstimator::Restore(
+    float decay,
+    float average_decay,
+    rtc::ArrayView<const float, kFftLengthBy2Plus1> tail_response) {
+  for (size_t ch = 0; ch < reverb_decay_estimators_.size(); ++ch) {
+    reverb_decay_estimators_[ch]->RestoreDecay(decay);
+    reverb_frequency_responses_[ch].Restore(average_decay, tail_response);
+  }
+}
+
 void ReverbModelEstimator::Update(
     rtc::ArrayView<const std::vector<float>> impulse_responses,
     rtc::ArrayView<const std::vector<std::array<float, kFftLengthBy2Plus1>>>
@@ -52,6 +52,17 @@ class ReverbModelEstimator {
     return reverb_frequency_responses_[0].FrequencyResponse();
   }
 
+  // Returns the smoothed energy ratio between the reverb tail and the direct
+  // path.
+  float ReverbAverageDecay() const {
+    return reverb_frequency_responses_[0].AverageDecay();
+  }
+
+  // Restores previously estimated reverb model parameters for all channels.
+  void Restore(float decay,
+               float average_decay,
+               rtc::ArrayView<const float, kFftLengthBy2Plus1> tail_response);
+
   // Dumps debug data.
   void Dump(ApmDataDumper* data_dumper) const {
     reverb_decay_estimators_[0]->Dump(data_dumper);
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/reverb_model.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+// Number of distinct spectra cycled through during the measurement.
+constexpr size_t kNumSpectra = 50;
+constexpr float kReverbDecay = 0.8f;
+
+int NumIterations() {
+  const int kNumIterations = 1000000;
+  const int kQuickNumIterations = 10000;
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumIterations
+                                                        : kNumIterations;
+}
+
+// Measures the per-block cost of updating the reverb estimate, with a
+// frequency dependent scaling of the power spectrum if |freq_shaping| is true
+// and with a single scaling otherwise, and reports the throughput in blocks
+// per second.
+void RunAndReport(Aec3Optimization optimization, bool freq_shaping) {
+  Random random_generator(42U);
+  std::vector<std::array<float, kFftLengthBy2Plus1>> power_spectra(
+      kNumSpectra);
+  for (auto& spectrum : power_spectra) {
+    std::for_each(spectrum.begin(), spectrum.end(), [&](float& a) {
+      a = 1000000.f * random_generator.Rand<float>();
+    });
+  }
+  std::array<float, kFftLengthBy2Plus1> scaling;
+  std::for_each(scaling.begin(), scaling.end(),
+                [&](float& a) { a = random_generator.Rand<float>(); });
+  ReverbModel reverb_model(optimization);
+
+  const int num_iterations = NumIterations();
+  Clock* clock = Clock::GetRealTimeClock();
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int n = 0; n < num_iterations; ++n) {
+    const auto& power_spectrum = power_spectra[n % kNumSpectra];
+    if (freq_shaping) {
+      reverb_model.UpdateReverb(power_spectrum, scaling, kReverbDecay);
+    } else {
+      reverb_model.UpdateReverbNoFreqShaping(power_spectrum, scaling[0],
+                                             kReverbDecay);
+    }
+  }
+  const int64_t runtime_us = clock->TimeInMicroseconds() - start_time_us;
+  ASSERT_GT(runtime_us, 0);
+  // Keeps the updates from being optimized away.
+  EXPECT_GE(reverb_model.reverb()[0], 0.f);
+  test::PrintResult(
+      "aec3_reverb_model",
+      std::string(freq_shaping ? "_freq_shaping" : "_no_freq_shaping") +
+          (optimization == Aec3Optimization::kNone ? "_none" : "_optimized"),
+      "", 1e6 * num_iterations / runtime_us, "blocks_per_second_per_core",
+      true);
+}
+
+}  // namespace
+
+TEST(ReverbModelPerformanceTest, Optimizations) {
+  for (bool freq_shaping : {true, false}) {
+    RunAndReport(Aec3Optimization::kNone, freq_shaping);
+    RunAndReport(DetectOptimization(), freq_shaping);
+  }
+}
+
+}  // namespace webrtc
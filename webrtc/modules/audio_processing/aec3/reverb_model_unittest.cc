@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/reverb_model.h"
+
+#include <algorithm>
+#include <array>
+
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+// Verifies that the optimized reverb updates give the same estimate as the
+// generic code, with and without frequency shaping.
+TEST(ReverbModel, OptimizationsAreBitExact) {
+  Random random_generator(42U);
+  ReverbModel reverb_model(Aec3Optimization::kNone);
+  ReverbModel reverb_model_optimized(DetectOptimization());
+  std::array<float, kFftLengthBy2Plus1> power_spectrum;
+  std::array<float, kFftLengthBy2Plus1> scaling;
+  for (int n = 0; n < 1000; ++n) {
+    std::for_each(power_spectrum.begin(), power_spectrum.end(), [&](float& a) {
+      a = 1000000.f * random_generator.Rand<float>();
+    });
+    std::for_each(scaling.begin(), scaling.end(),
+                  [&](float& a) { a = random_generator.Rand<float>(); });
+    const float reverb_decay = random_generator.Rand<float>();
+    if (n % 2 == 0) {
+      reverb_model.UpdateReverb(power_spectrum, scaling, reverb_decay);
+      reverb_model_optimized.UpdateReverb(power_spectrum, scaling,
+                                          reverb_decay);
+    } else {
+      reverb_model.UpdateReverbNoFreqShaping(power_spectrum, scaling[0],
+                                             reverb_decay);
+      reverb_model_optimized.UpdateReverbNoFreqShaping(
+          power_spectrum, scaling[0], reverb_decay);
+    }
+    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+      ASSERT_EQ(reverb_model.reverb()[k], reverb_model_optimized.reverb()[k])
+          << "block " << n << ", bin " << k;
+    }
+  }
+}
+
+}  // namespace webrtc
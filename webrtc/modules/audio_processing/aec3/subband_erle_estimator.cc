@@ -68,6 +68,24 @@ void SubbandErleEstimator::Reset() {
   ResetAccumulatedSpectra();
 }
 
+void SubbandErleEstimator::Restore(
+    rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle,
+    rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle_onsets) {
+  RTC_DCHECK_EQ(erle_.size(), erle.size());
+  RTC_DCHECK_EQ(erle_onsets_.size(), erle_onsets.size());
+  for (size_t ch = 0; ch < erle_.size(); ++ch) {
+    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+      erle_[ch][k] = rtc::SafeClamp(erle[ch][k], min_erle_, max_erle_[k]);
+      erle_onsets_[ch][k] =
+          rtc::SafeClamp(erle_onsets[ch][k], min_erle_, max_erle_[k]);
+    }
+    // Hold the restored estimates as if they had just been updated.
+    coming_onset_[ch].fill(false);
+    hold_counters_[ch].fill(kBlocksForOnsetDetection);
+  }
+  ResetAccumulatedSpectra();
+}
+
 void SubbandErleEstimator::Update(
     rtc::ArrayView<const float, kFftLengthBy2Plus1> X2,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
@@ -34,6 +34,11 @@ class SubbandErleEstimator {
   // Resets the ERLE estimator.
   void Reset();
 
+  // Restores previously converged ERLE estimates.
+  void Restore(
+      rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle,
+      rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle_onsets);
+
   // Updates the ERLE estimate.
   void Update(rtc::ArrayView<const float, kFftLengthBy2Plus1> X2,
               rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
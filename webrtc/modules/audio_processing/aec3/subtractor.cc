@@ -24,6 +24,24 @@ namespace webrtc {
 
 namespace {
 
+// Returns whether the render power in all bins is low enough, about -90 dBFS,
+// for the filter outputs to be negligible.
+bool SilentRender(const std::array<float, kFftLengthBy2Plus1>& X2) {
+  constexpr float kSilentRenderPower = kFftLength * kFftLength;
+  return *std::max_element(X2.begin(), X2.end()) < kSilentRenderPower;
+}
+
+// Returns whether the capture signal is digital silence.
+bool SilentCapture(rtc::ArrayView<const float> y) {
+  return std::all_of(y.begin(), y.end(), [](float a) { return a == 0.f; });
+}
+
+bool IsZero(const FftData& G) {
+  const auto is_zero = [](float a) { return a == 0.f; };
+  return std::all_of(G.re.begin(), G.re.end(), is_zero) &&
+         std::all_of(G.im.begin(), G.im.end(), is_zero);
+}
+
 void PredictionError(const Aec3Fft& fft,
                      const FftData& S,
                      rtc::ArrayView<const float> y,
@@ -90,6 +108,10 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
         config_.filter.refined_initial.length_blocks,
         config.filter.config_change_duration_blocks, num_render_channels,
         optimization, data_dumper_);
+    if (config_.filter.non_uniform_partitioning.enabled) {
+      refined_filters_[ch]->SetNonUniformAdaptation(
+          config_.filter.non_uniform_partitioning.head_length_blocks);
+    }
 
     coarse_filter_[ch] = std::make_unique<AdaptiveFirFilter>(
         config_.filter.coarse.length_blocks,
@@ -154,12 +176,46 @@ void Subtractor::ExitInitialState() {
   }
 }
 
+void Subtractor::GetWarmStartState(WarmStartState* state) const {
+  RTC_DCHECK(state);
+  state->filters.resize(num_capture_channels_);
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    state->filters[ch] = refined_filters_[ch]->GetFilter();
+  }
+}
+
+void Subtractor::SetWarmStartState(const WarmStartState& state) {
+  RTC_DCHECK_EQ(num_capture_channels_, state.filters.size());
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    const auto& H = state.filters[ch];
+    RTC_DCHECK_EQ(FilterSizePartitions(), H.size());
+
+    // Apply the non-initial filter sizes directly, since the restored filters
+    // are already converged.
+    refined_gains_[ch]->SetConfig(config_.filter.refined, true);
+    coarse_gains_[ch]->SetConfig(config_.filter.coarse, true);
+    refined_filters_[ch]->SetSizePartitions(
+        config_.filter.refined.length_blocks, true);
+    coarse_filter_[ch]->SetSizePartitions(config_.filter.coarse.length_blocks,
+                                          true);
+
+    refined_filters_[ch]->SetFilter(H.size(), H);
+    coarse_filter_[ch]->SetFilter(H.size(), H);
+    refined_filters_[ch]->ConstrainAndComputeImpulseResponse(
+        &refined_impulse_responses_[ch]);
+    refined_filters_[ch]->ComputeFrequencyResponse(
+        &refined_frequency_responses_[ch]);
+    filter_misadjustment_estimators_[ch].Reset();
+    poor_coarse_filter_counters_[ch] = 0;
+  }
+}
+
 void Subtractor::Process(const RenderBuffer& render_buffer,
-                         const std::vector<std::vector<float>>& capture,
+                         const Block& capture,
                          const RenderSignalAnalyzer& render_signal_analyzer,
                          const AecState& aec_state,
                          rtc::ArrayView<SubtractorOutput> outputs) {
-  RTC_DCHECK_EQ(num_capture_channels_, capture.size());
+  RTC_DCHECK_EQ(num_capture_channels_, capture.NumChannels());
 
   // Compute the render powers.
   const bool same_filter_sizes = refined_filters_[0]->SizePartitions() ==
@@ -181,11 +237,28 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
                                &X2_coarse);
   }
 
+  const bool skip_coarse_filter_adaptation =
+      config_.duty_cycling.skip_coarse_filter_adaptation &&
+      aec_state.SteadyState();
+  data_dumper_->DumpRaw("aec3_subtractor_skip_coarse_filter_adaptation",
+                        skip_coarse_filter_adaptation);
+
+  // When the render signal over the span of the longest filter is silent, the
+  // filter outputs are negligible and the filtering can be bypassed.
+  const bool bypass_filters_for_silence =
+      config_.filter.bypass_filters_for_silence;
+  const bool render_silent =
+      bypass_filters_for_silence &&
+      (refined_filters_[0]->SizePartitions() >=
+               coarse_filter_[0]->SizePartitions()
+           ? SilentRender(X2_refined)
+           : SilentRender(X2_coarse));
+  bool all_capture_silent = true;
+
   // Process all capture channels
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
-    RTC_DCHECK_EQ(kBlockSize, capture[ch].size());
     SubtractorOutput& output = outputs[ch];
-    rtc::ArrayView<const float> y = capture[ch];
+    rtc::ArrayView<const float> y = capture.View(/*band=*/0, ch);
     FftData& E_refined = output.E_refined;
     FftData E_coarse;
     std::array<float, kBlockSize>& e_refined = output.e_refined;
@@ -194,12 +267,26 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
     FftData S;
     FftData& G = S;
 
+    // If enabled, for silent render or capture signals, the filters are
+    // neither applied nor adapted. The filter outputs are then set to zero, as
+    // any echo is either absent or inaudible.
+    const bool capture_silent = bypass_filters_for_silence && SilentCapture(y);
+    all_capture_silent = all_capture_silent && capture_silent;
+    const bool bypass_filters = render_silent || capture_silent;
+
     // Form the outputs of the refined and coarse filters.
-    refined_filters_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_refined, &output.s_refined);
+    if (bypass_filters) {
+      output.s_refined.fill(0.f);
+      output.s_coarse.fill(0.f);
+      std::copy(y.begin(), y.end(), e_refined.begin());
+      std::copy(y.begin(), y.end(), e_coarse.begin());
+    } else {
+      refined_filters_[ch]->Filter(render_buffer, &S);
+      PredictionError(fft_, S, y, &e_refined, &output.s_refined);
 
-    coarse_filter_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_coarse, &output.s_coarse);
+      coarse_filter_[ch]->Filter(render_buffer, &S);
+      PredictionError(fft_, S, y, &e_coarse, &output.s_coarse);
+    }
 
     // Compute the signal powers in the subtractor output.
     output.ComputeMetrics(y);
@@ -218,54 +305,81 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
       refined_filters_adjusted = true;
     }
 
-    // Compute the FFts of the refined and coarse filter outputs.
+    // Compute the FFts of the refined and coarse filter outputs, which are
+    // identical when the filters are bypassed.
     fft_.ZeroPaddedFft(e_refined, Aec3Fft::Window::kHanning, &E_refined);
-    fft_.ZeroPaddedFft(e_coarse, Aec3Fft::Window::kHanning, &E_coarse);
+    if (bypass_filters) {
+      E_coarse.Assign(E_refined);
+    } else {
+      fft_.ZeroPaddedFft(e_coarse, Aec3Fft::Window::kHanning, &E_coarse);
+    }
 
     // Compute spectra for future use.
-    E_coarse.Spectrum(optimization_, output.E2_coarse);
     E_refined.Spectrum(optimization_, output.E2_refined);
+    if (bypass_filters) {
+      output.E2_coarse = output.E2_refined;
+    } else {
+      E_coarse.Spectrum(optimization_, output.E2_coarse);
+    }
 
-    // Update the refined filter.
+    // Update the refined filter. The gain is still computed when the filters
+    // are bypassed in order to keep its internal state running. A silent
+    // capture signal is treated as a saturated one, for which no adaptation
+    // is done.
+    const bool freeze_adaptation =
+        aec_state.SaturatedCapture() || capture_silent;
     if (!refined_filters_adjusted) {
       std::array<float, kFftLengthBy2Plus1> erl;
       ComputeErl(optimization_, refined_frequency_responses_[ch], erl);
       refined_gains_[ch]->Compute(X2_refined, render_signal_analyzer, output,
                                   erl, refined_filters_[ch]->SizePartitions(),
-                                  aec_state.SaturatedCapture(), &G);
+                                  freeze_adaptation, &G);
     } else {
       G.re.fill(0.f);
       G.im.fill(0.f);
     }
-    refined_filters_[ch]->Adapt(render_buffer, G,
-                                &refined_impulse_responses_[ch]);
-    refined_filters_[ch]->ComputeFrequencyResponse(
-        &refined_frequency_responses_[ch]);
+    if (!bypass_filters || refined_filters_adjusted || !IsZero(G)) {
+      refined_filters_[ch]->Adapt(render_buffer, G,
+                                  &refined_impulse_responses_[ch]);
+      refined_filters_[ch]->ComputeFrequencyResponse(
+          &refined_frequency_responses_[ch]);
+    }
 
     if (ch == 0) {
       data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.re);
       data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.im);
     }
 
-    // Update the coarse filter.
-    poor_coarse_filter_counters_[ch] =
-        output.e2_refined < output.e2_coarse
-            ? poor_coarse_filter_counters_[ch] + 1
-            : 0;
-    if (poor_coarse_filter_counters_[ch] < 5) {
-      coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer, E_coarse,
-                                 coarse_filter_[ch]->SizePartitions(),
-                                 aec_state.SaturatedCapture(), &G);
+    // Update the coarse filter. In the steady state the refined filter is
+    // converged and tracks the echo path on its own, so the coarse filter
+    // adaptation can be skipped. The coarse filter output is still computed
+    // above for the divergence detection.
+    if (!skip_coarse_filter_adaptation) {
+      poor_coarse_filter_counters_[ch] =
+          output.e2_refined < output.e2_coarse
+              ? poor_coarse_filter_counters_[ch] + 1
+              : 0;
+      if (poor_coarse_filter_counters_[ch] < 5) {
+        coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer, E_coarse,
+                                   coarse_filter_[ch]->SizePartitions(),
+                                   freeze_adaptation, &G);
+      } else {
+        poor_coarse_filter_counters_[ch] = 0;
+        coarse_filter_[ch]->SetFilter(refined_filters_[ch]->SizePartitions(),
+                                      refined_filters_[ch]->GetFilter());
+        coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer,
+                                   E_refined,
+                                   coarse_filter_[ch]->SizePartitions(),
+                                   freeze_adaptation, &G);
+      }
+
+      if (!bypass_filters || !IsZero(G)) {
+        coarse_filter_[ch]->Adapt(render_buffer, G);
+      }
     } else {
-      poor_coarse_filter_counters_[ch] = 0;
-      coarse_filter_[ch]->SetFilter(refined_filters_[ch]->SizePartitions(),
-                                    refined_filters_[ch]->GetFilter());
-      coarse_gains_[ch]->Compute(X2_coarse, render_signal_analyzer, E_refined,
-                                 coarse_filter_[ch]->SizePartitions(),
-                                 aec_state.SaturatedCapture(), &G);
+      G.re.fill(0.f);
+      G.im.fill(0.f);
     }
-
-    coarse_filter_[ch]->Adapt(render_buffer, G);
     if (ch == 0) {
       data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.re);
       data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.im);
@@ -283,6 +397,11 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
                             &e_coarse[0], 16000, 1);
     }
   }
+
+  render_silence_blocks_ += render_silent ? 1 : 0;
+  capture_silence_blocks_ += all_capture_silent ? 1 : 0;
+  data_dumper_->DumpRaw("aec3_subtractor_render_silent", render_silent);
+  data_dumper_->DumpRaw("aec3_subtractor_capture_silent", all_capture_silent);
 }
 
 void Subtractor::FilterMisadjustmentEstimator::Update(
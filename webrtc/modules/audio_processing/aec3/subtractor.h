@@ -23,12 +23,14 @@
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/aec3_fft.h"
 #include "modules/audio_processing/aec3/aec_state.h"
+#include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/coarse_filter_update_gain.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
 #include "modules/audio_processing/aec3/refined_filter_update_gain.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/aec3/render_signal_analyzer.h"
 #include "modules/audio_processing/aec3/subtractor_output.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 
@@ -48,7 +50,7 @@ class Subtractor {
 
   // Performs the echo subtraction.
   void Process(const RenderBuffer& render_buffer,
-               const std::vector<std::vector<float>>& capture,
+               const Block& capture,
                const RenderSignalAnalyzer& render_signal_analyzer,
                const AecState& aec_state,
                rtc::ArrayView<SubtractorOutput> outputs);
@@ -58,6 +60,19 @@ class Subtractor {
   // Exits the initial state.
   void ExitInitialState();
 
+  // Returns the maximum number of partitions of the refined filters.
+  size_t FilterSizePartitions() const {
+    return refined_filters_[0]->max_filter_size_partitions();
+  }
+
+  // Stores the refined filter coefficients in |state|.
+  void GetWarmStartState(WarmStartState* state) const;
+
+  // Sets the refined and coarse filters to the filter coefficients in |state|
+  // and exits the initial state. The dimensions of |state| must match the
+  // filters.
+  void SetWarmStartState(const WarmStartState& state);
+
   // Returns the block-wise frequency responses for the refined adaptive
   // filters.
   const std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>&
@@ -71,6 +86,16 @@ class Subtractor {
     return refined_impulse_responses_;
   }
 
+  // Returns the number of processed blocks for which the render signal over
+  // the filter span was silent, and for which the filters were bypassed. Only
+  // counted if filter.bypass_filters_for_silence is set in the config.
+  int RenderSilenceBlocks() const { return render_silence_blocks_; }
+
+  // Returns the number of processed blocks for which the capture signal was
+  // digital silence in all channels, and for which the filters were bypassed.
+  // Only counted if filter.bypass_filters_for_silence is set in the config.
+  int CaptureSilenceBlocks() const { return capture_silence_blocks_; }
+
   void DumpFilters() {
     data_dumper_->DumpRaw(
         "aec3_subtractor_h_refined",
@@ -130,6 +155,8 @@ class Subtractor {
   std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>
       refined_frequency_responses_;
   std::vector<std::vector<float>> refined_impulse_responses_;
+  int render_silence_blocks_ = 0;
+  int capture_silence_blocks_ = 0;
 };
 
 }  // namespace webrtc
@@ -45,11 +45,8 @@ std::vector<float> RunSubtractorTest(
   Subtractor subtractor(config, num_render_channels, num_capture_channels,
                         &data_dumper, DetectOptimization());
   absl::optional<DelayEstimate> delay_estimate;
-  std::vector<std::vector<std::vector<float>>> x(
-      kNumBands, std::vector<std::vector<float>>(
-                     num_render_channels, std::vector<float>(kBlockSize, 0.f)));
-  std::vector<std::vector<float>> y(num_capture_channels,
-                                    std::vector<float>(kBlockSize, 0.f));
+  Block x(kNumBands, num_render_channels);
+  Block y(/*num_bands=*/1, num_capture_channels);
   std::array<float, kBlockSize> x_old;
   std::vector<SubtractorOutput> output(num_capture_channels);
   config.delay.default_delay = 1;
@@ -101,12 +98,13 @@ std::vector<float> RunSubtractorTest(
 
   for (int k = 0; k < num_blocks_to_process; ++k) {
     for (size_t render_ch = 0; render_ch < num_render_channels; ++render_ch) {
-      RandomizeSampleVector(&random_generator, x[0][render_ch]);
+      RandomizeSampleVector(&random_generator, x.View(/*band=*/0, render_ch));
     }
     if (uncorrelated_inputs) {
       for (size_t capture_ch = 0; capture_ch < num_capture_channels;
            ++capture_ch) {
-        RandomizeSampleVector(&random_generator, y[capture_ch]);
+        RandomizeSampleVector(&random_generator,
+                              y.View(/*band=*/0, capture_ch));
       }
     } else {
       for (size_t capture_ch = 0; capture_ch < num_capture_channels;
@@ -114,19 +112,20 @@ std::vector<float> RunSubtractorTest(
         for (size_t render_ch = 0; render_ch < num_render_channels;
              ++render_ch) {
           std::array<float, kBlockSize> y_channel;
-          delay_buffer[capture_ch][render_ch]->Delay(x[0][render_ch],
-                                                     y_channel);
-          for (size_t k = 0; k < y.size(); ++k) {
-            y[capture_ch][k] += y_channel[k] / num_render_channels;
+          delay_buffer[capture_ch][render_ch]->Delay(
+              x.View(/*band=*/0, render_ch), y_channel);
+          for (size_t k = 0; k < kBlockSize; ++k) {
+            y.View(/*band=*/0, capture_ch)[k] +=
+                y_channel[k] / num_render_channels;
           }
         }
       }
     }
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
-      x_hp_filter[ch]->Process(x[0][ch]);
+      x_hp_filter[ch]->Process(x.View(/*band=*/0, ch));
     }
     for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-      y_hp_filter[ch]->Process(y[ch]);
+      y_hp_filter[ch]->Process(y.View(/*band=*/0, ch));
     }
 
     render_delay_buffer->Insert(x);
@@ -162,7 +161,8 @@ std::vector<float> RunSubtractorTest(
         output[ch].e_refined.begin(), output[ch].e_refined.end(),
         output[ch].e_refined.begin(), 0.f);
     const float y_power =
-        std::inner_product(y[ch].begin(), y[ch].end(), y[ch].begin(), 0.f);
+        std::inner_product(y.begin(/*band=*/0, ch), y.end(/*band=*/0, ch),
+                           y.begin(/*band=*/0, ch), 0.f);
     if (y_power == 0.f) {
       ADD_FAILURE();
       results[ch] = -1.f;
@@ -195,23 +195,6 @@ TEST(Subtractor, NullDataDumper) {
       "");
 }
 
-// Verifies the check for the capture signal size.
-TEST(Subtractor, WrongCaptureSize) {
-  ApmDataDumper data_dumper(42);
-  EchoCanceller3Config config;
-  Subtractor subtractor(config, 1, 1, &data_dumper, DetectOptimization());
-  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
-      RenderDelayBuffer::Create(config, 48000, 1));
-  RenderSignalAnalyzer render_signal_analyzer(config);
-  std::vector<std::vector<float>> y(1, std::vector<float>(kBlockSize - 1, 0.f));
-  std::array<SubtractorOutput, 1> output;
-
-  EXPECT_DEATH(
-      subtractor.Process(*render_delay_buffer->GetRenderBuffer(), y,
-                         render_signal_analyzer, AecState(config, 1), output),
-      "");
-}
-
 #endif
 
 // Verifies that the subtractor is able to converge on correlated data.
@@ -253,6 +236,119 @@ TEST(Subtractor, CoarseFilterLongerThanRefinedFilter) {
   }
 }
 
+// Verifies that the filters are bypassed and not adapted for silent render and
+// capture signals, when enabled.
+TEST(Subtractor, SilentSignalsBypassFilters) {
+  ApmDataDumper data_dumper(42);
+  constexpr int kSampleRateHz = 16000;
+  EchoCanceller3Config config;
+  config.filter.bypass_filters_for_silence = true;
+  Subtractor subtractor(config, 1, 1, &data_dumper, DetectOptimization());
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, 1));
+  RenderSignalAnalyzer render_signal_analyzer(config);
+  AecState aec_state(config, 1);
+  Random random_generator(42U);
+  Block x(/*num_bands=*/1, /*num_channels=*/1);
+  Block y(/*num_bands=*/1, /*num_channels=*/1);
+  std::vector<SubtractorOutput> output(1);
+
+  auto process_block = [&]() {
+    render_delay_buffer->Insert(x);
+    render_delay_buffer->PrepareCaptureProcessing();
+    render_signal_analyzer.Update(*render_delay_buffer->GetRenderBuffer(),
+                                  aec_state.MinDirectPathFilterDelay());
+    subtractor.Process(*render_delay_buffer->GetRenderBuffer(), y,
+                       render_signal_analyzer, aec_state, output);
+  };
+  auto filter_is_zero = [&]() {
+    for (const auto& H2 : subtractor.FilterFrequencyResponses()[0]) {
+      for (float h2 : H2) {
+        if (h2 != 0.f) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  // Silent render and active capture.
+  std::fill(x.begin(/*band=*/0, /*channel=*/0),
+            x.end(/*band=*/0, /*channel=*/0), 0.f);
+  for (int k = 0; k < 100; ++k) {
+    RandomizeSampleVector(&random_generator,
+                          y.View(/*band=*/0, /*channel=*/0));
+    process_block();
+    EXPECT_TRUE(std::equal(y.begin(/*band=*/0, /*channel=*/0),
+                           y.end(/*band=*/0, /*channel=*/0),
+                           output[0].e_refined.begin()));
+    EXPECT_TRUE(std::all_of(output[0].s_refined.begin(),
+                            output[0].s_refined.end(),
+                            [](float a) { return a == 0.f; }));
+  }
+  EXPECT_EQ(100, subtractor.RenderSilenceBlocks());
+  EXPECT_EQ(0, subtractor.CaptureSilenceBlocks());
+  EXPECT_TRUE(filter_is_zero());
+
+  // Active render and silent capture.
+  std::fill(y.begin(/*band=*/0, /*channel=*/0),
+            y.end(/*band=*/0, /*channel=*/0), 0.f);
+  for (int k = 0; k < 100; ++k) {
+    RandomizeSampleVector(&random_generator,
+                          x.View(/*band=*/0, /*channel=*/0));
+    process_block();
+    EXPECT_TRUE(std::all_of(output[0].e_refined.begin(),
+                            output[0].e_refined.end(),
+                            [](float a) { return a == 0.f; }));
+  }
+  // The silent render blocks remain in the render buffer for the first few
+  // blocks.
+  const int render_silence_blocks = subtractor.RenderSilenceBlocks();
+  EXPECT_LT(render_silence_blocks, 110);
+  EXPECT_EQ(100, subtractor.CaptureSilenceBlocks());
+  EXPECT_TRUE(filter_is_zero());
+
+  // Active render and capture.
+  for (int k = 0; k < 100; ++k) {
+    RandomizeSampleVector(&random_generator,
+                          x.View(/*band=*/0, /*channel=*/0));
+    RandomizeSampleVector(&random_generator,
+                          y.View(/*band=*/0, /*channel=*/0));
+    process_block();
+  }
+  EXPECT_EQ(render_silence_blocks, subtractor.RenderSilenceBlocks());
+  EXPECT_EQ(100, subtractor.CaptureSilenceBlocks());
+  EXPECT_FALSE(filter_is_zero());
+}
+
+// Verifies that the filters are not bypassed for silent signals by default.
+TEST(Subtractor, SilentSignalsDoNotBypassFiltersByDefault) {
+  ApmDataDumper data_dumper(42);
+  constexpr int kSampleRateHz = 16000;
+  EchoCanceller3Config config;
+  ASSERT_FALSE(config.filter.bypass_filters_for_silence);
+  Subtractor subtractor(config, 1, 1, &data_dumper, DetectOptimization());
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, 1));
+  RenderSignalAnalyzer render_signal_analyzer(config);
+  AecState aec_state(config, 1);
+  Block x(/*num_bands=*/1, /*num_channels=*/1);
+  Block y(/*num_bands=*/1, /*num_channels=*/1);
+  std::vector<SubtractorOutput> output(1);
+
+  // Silent render and capture.
+  for (int k = 0; k < 100; ++k) {
+    render_delay_buffer->Insert(x);
+    render_delay_buffer->PrepareCaptureProcessing();
+    render_signal_analyzer.Update(*render_delay_buffer->GetRenderBuffer(),
+                                  aec_state.MinDirectPathFilterDelay());
+    subtractor.Process(*render_delay_buffer->GetRenderBuffer(), y,
+                       render_signal_analyzer, aec_state, output);
+  }
+  EXPECT_EQ(0, subtractor.RenderSilenceBlocks());
+  EXPECT_EQ(0, subtractor.CaptureSilenceBlocks());
+}
+
 // Verifies that the subtractor does not converge on uncorrelated signals.
 TEST(Subtractor, NonConvergenceOnUncorrelatedSignals) {
   std::vector<int> blocks_with_echo_path_changes;
@@ -10,6 +10,15 @@
 
 #include "modules/audio_processing/aec3/suppression_gain.h"
 
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 #include <math.h>
 #include <stddef.h>
 
@@ -108,13 +117,13 @@ float SuppressionGain::UpperBandsGain(
         comfort_noise_spectrum,
     const absl::optional<int>& narrow_peak_band,
     bool saturated_echo,
-    const std::vector<std::vector<std::vector<float>>>& render,
+    const Block& render,
     const std::array<float, kFftLengthBy2Plus1>& low_band_gain) const {
-  RTC_DCHECK_LT(0, render.size());
-  if (render.size() == 1) {
+  RTC_DCHECK_LT(0, render.NumBands());
+  if (render.NumBands() == 1) {
     return 1.f;
   }
-  const size_t num_render_channels = render[0].size();
+  const size_t num_render_channels = render.NumChannels();
 
   if (narrow_peak_band &&
       (*narrow_peak_band > static_cast<int>(kFftLengthBy2Plus1 - 10))) {
@@ -134,15 +143,17 @@ float SuppressionGain::UpperBandsGain(
   const auto sum_of_squares = [](float a, float b) { return a + b * b; };
   float low_band_energy = 0.f;
   for (size_t ch = 0; ch < num_render_channels; ++ch) {
-    const float channel_energy = std::accumulate(
-        render[0][0].begin(), render[0][0].end(), 0.f, sum_of_squares);
+    const float channel_energy =
+        std::accumulate(render.begin(/*band=*/0, /*channel=*/0),
+                        render.end(/*band=*/0, /*channel=*/0), 0.f,
+                        sum_of_squares);
     low_band_energy = std::max(low_band_energy, channel_energy);
   }
   float high_band_energy = 0.f;
-  for (size_t k = 1; k < render.size(); ++k) {
+  for (size_t k = 1; k < render.NumBands(); ++k) {
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
       const float energy = std::accumulate(
-          render[k][ch].begin(), render[k][ch].end(), 0.f, sum_of_squares);
+          render.begin(k, ch), render.end(k, ch), 0.f, sum_of_squares);
       high_band_energy = std::max(high_band_energy, energy);
     }
   }
@@ -195,7 +206,58 @@ void SuppressionGain::GainToNoAudibleEcho(
     std::array<float, kFftLengthBy2Plus1>* gain) const {
   const auto& p = dominant_nearend_detector_->IsNearendState() ? nearend_params_
                                                                : normal_params_;
-  for (size_t k = 0; k < gain->size(); ++k) {
+  size_t k = 0;
+  switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2: {
+      const __m128 one = _mm_set1_ps(1.f);
+      for (; k + 4 <= gain->size(); k += 4) {
+        const __m128 echo_k = _mm_loadu_ps(&echo[k]);
+        const __m128 enr =
+            _mm_div_ps(echo_k, _mm_add_ps(_mm_loadu_ps(&nearend[k]), one));
+        const __m128 emr =
+            _mm_div_ps(echo_k, _mm_add_ps(_mm_loadu_ps(&masker[k]), one));
+        const __m128 enr_transparent = _mm_loadu_ps(&p.enr_transparent_[k]);
+        const __m128 enr_suppress = _mm_loadu_ps(&p.enr_suppress_[k]);
+        const __m128 emr_transparent = _mm_loadu_ps(&p.emr_transparent_[k]);
+        const __m128 suppress = _mm_and_ps(_mm_cmpgt_ps(enr, enr_transparent),
+                                           _mm_cmpgt_ps(emr, emr_transparent));
+        // The gain is computed for all bins, including those for which the
+        // echo is transparent, and those bins are then set to one.
+        __m128 g = _mm_div_ps(_mm_sub_ps(enr_suppress, enr),
+                              _mm_sub_ps(enr_suppress, enr_transparent));
+        g = _mm_max_ps(g, _mm_div_ps(emr_transparent, emr));
+        g = _mm_or_ps(_mm_and_ps(suppress, g), _mm_andnot_ps(suppress, one));
+        _mm_storeu_ps(&(*gain)[k], g);
+      }
+    } break;
+#endif
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+    case Aec3Optimization::kNeon: {
+      const float32x4_t one = vdupq_n_f32(1.f);
+      for (; k + 4 <= gain->size(); k += 4) {
+        const float32x4_t echo_k = vld1q_f32(&echo[k]);
+        const float32x4_t enr =
+            vdivq_f32(echo_k, vaddq_f32(vld1q_f32(&nearend[k]), one));
+        const float32x4_t emr =
+            vdivq_f32(echo_k, vaddq_f32(vld1q_f32(&masker[k]), one));
+        const float32x4_t enr_transparent = vld1q_f32(&p.enr_transparent_[k]);
+        const float32x4_t enr_suppress = vld1q_f32(&p.enr_suppress_[k]);
+        const float32x4_t emr_transparent = vld1q_f32(&p.emr_transparent_[k]);
+        const uint32x4_t suppress = vandq_u32(vcgtq_f32(enr, enr_transparent),
+                                              vcgtq_f32(emr, emr_transparent));
+        float32x4_t g = vdivq_f32(vsubq_f32(enr_suppress, enr),
+                                  vsubq_f32(enr_suppress, enr_transparent));
+        g = vmaxq_f32(g, vdivq_f32(emr_transparent, emr));
+        vst1q_f32(&(*gain)[k], vbslq_f32(suppress, g, one));
+      }
+    } break;
+#endif
+    default:
+      break;
+  }
+
+  for (; k < gain->size(); ++k) {
     float enr = echo[k] / (nearend[k] + 1.f);  // Echo-to-nearend ratio.
     float emr = echo[k] / (masker[k] + 1.f);   // Echo-to-masker (noise) ratio.
     float g = 1.0f;
@@ -287,10 +349,9 @@ void SuppressionGain::LowerBandGain(
     GainToNoAudibleEcho(nearend, weighted_residual_echo, comfort_noise[0], &G);
 
     // Clamp gains.
-    for (size_t k = 0; k < gain->size(); ++k) {
-      G[k] = std::max(std::min(G[k], max_gain[k]), min_gain[k]);
-      (*gain)[k] = std::min((*gain)[k], G[k]);
-    }
+    aec3::VectorMath vector_math(optimization_);
+    vector_math.Clamp(min_gain, max_gain, G);
+    vector_math.Min(G, *gain);
 
     // Store data required for the gain computation of the next block.
     std::copy(nearend.begin(), nearend.end(), last_nearend_[ch].begin());
@@ -351,7 +412,7 @@ void SuppressionGain::GetGain(
         comfort_noise_spectrum,
     const RenderSignalAnalyzer& render_signal_analyzer,
     const AecState& aec_state,
-    const std::vector<std::vector<std::vector<float>>>& render,
+    const Block& render,
     float* high_bands_gain,
     std::array<float, kFftLengthBy2Plus1>* low_band_gain) {
   RTC_DCHECK(high_bands_gain);
@@ -386,18 +447,17 @@ void SuppressionGain::SetInitialState(bool state) {
 
 // Detects when the render signal can be considered to have low power and
 // consist of stationary noise.
-bool SuppressionGain::LowNoiseRenderDetector::Detect(
-    const std::vector<std::vector<std::vector<float>>>& render) {
+bool SuppressionGain::LowNoiseRenderDetector::Detect(const Block& render) {
   float x2_sum = 0.f;
   float x2_max = 0.f;
-  for (const auto& x_ch : render[0]) {
-    for (const auto& x_k : x_ch) {
+  const size_t num_render_channels = render.NumChannels();
+  for (size_t ch = 0; ch < num_render_channels; ++ch) {
+    for (const auto& x_k : render.View(/*band=*/0, ch)) {
       const float x2 = x_k * x_k;
       x2_sum += x2;
       x2_max = std::max(x2_max, x2);
     }
   }
-  const size_t num_render_channels = render[0].size();
   x2_sum = x2_sum / num_render_channels;
   ;
 
@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/aec_state.h"
+#include "modules/audio_processing/aec3/delay_estimate.h"
+#include "modules/audio_processing/aec3/render_delay_buffer.h"
+#include "modules/audio_processing/aec3/render_signal_analyzer.h"
+#include "modules/audio_processing/aec3/subtractor_output.h"
+#include "modules/audio_processing/aec3/suppression_gain.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kNumRenderChannels = 1;
+// Number of distinct sets of spectra cycled through during the measurement.
+constexpr size_t kNumSpectra = 50;
+
+int NumIterations() {
+  const int kNumIterations = 100000;
+  const int kQuickNumIterations = 1000;
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumIterations
+                                                        : kNumIterations;
+}
+
+using Spectra = std::vector<std::array<float, kFftLengthBy2Plus1>>;
+
+Spectra CreateRandomSpectra(size_t num_channels,
+                            float level,
+                            Random* random_generator) {
+  Spectra spectra(num_channels);
+  for (auto& spectrum : spectra) {
+    std::for_each(spectrum.begin(), spectrum.end(), [&](float& a) {
+      a = level * random_generator->Rand<float>();
+    });
+  }
+  return spectra;
+}
+
+// Measures the per-block cost of computing the suppression gains from
+// randomized nearend, echo and noise spectra, and reports the throughput in
+// blocks per second.
+void RunAndReport(Aec3Optimization optimization, size_t num_capture_channels) {
+  EchoCanceller3Config config;
+  SuppressionGain suppression_gain(config, optimization, kSampleRateHz,
+                                   num_capture_channels);
+  RenderSignalAnalyzer analyzer(config);
+  AecState aec_state(config, num_capture_channels);
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, kNumRenderChannels));
+  std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>> H2(
+      num_capture_channels,
+      std::vector<std::array<float, kFftLengthBy2Plus1>>(
+          config.filter.refined.length_blocks));
+  std::vector<std::vector<float>> h(
+      num_capture_channels,
+      std::vector<float>(
+          GetTimeDomainLength(config.filter.refined.length_blocks), 0.f));
+  std::vector<SubtractorOutput> output(num_capture_channels);
+  for (auto& subtractor_output : output) {
+    subtractor_output.Reset();
+  }
+  Block x(NumBandsForRate(kSampleRateHz), kNumRenderChannels);
+  absl::optional<DelayEstimate> delay_estimate;
+
+  Random random_generator(42U);
+  std::vector<Spectra> E2;
+  std::vector<Spectra> S2;
+  std::vector<Spectra> R2;
+  std::vector<Spectra> N2;
+  for (size_t k = 0; k < kNumSpectra; ++k) {
+    E2.push_back(CreateRandomSpectra(num_capture_channels, 1e6f,
+                                     &random_generator));
+    S2.push_back(CreateRandomSpectra(num_capture_channels, 1e6f,
+                                     &random_generator));
+    R2.push_back(CreateRandomSpectra(num_capture_channels, 1e6f,
+                                     &random_generator));
+    N2.push_back(CreateRandomSpectra(num_capture_channels, 1e3f,
+                                     &random_generator));
+  }
+
+  // Ensure that the gain is no longer forced to zero.
+  for (int k = 0; k <= kNumBlocksPerSecond / 5 + 1; ++k) {
+    aec_state.Update(delay_estimate, H2, h,
+                     *render_delay_buffer->GetRenderBuffer(), E2[0], E2[0],
+                     output);
+  }
+  suppression_gain.SetInitialState(false);
+
+  float high_bands_gain;
+  std::array<float, kFftLengthBy2Plus1> g;
+  const int num_iterations = NumIterations();
+  Clock* clock = Clock::GetRealTimeClock();
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int n = 0; n < num_iterations; ++n) {
+    const size_t k = n % kNumSpectra;
+    suppression_gain.GetGain(E2[k], S2[k], R2[k], N2[k], analyzer, aec_state,
+                             x, &high_bands_gain, &g);
+  }
+  const int64_t runtime_us = clock->TimeInMicroseconds() - start_time_us;
+  ASSERT_GT(runtime_us, 0);
+  test::PrintResult(
+      "aec3_suppression_gain",
+      optimization == Aec3Optimization::kNone ? "_none" : "_optimized",
+      "capture_channels_" + std::to_string(num_capture_channels),
+      1e6 * num_iterations / runtime_us, "blocks_per_second_per_core", true);
+}
+
+}  // namespace
+
+TEST(SuppressionGainPerformanceTest, Optimizations) {
+  for (size_t num_capture_channels : {1, 2, 8}) {
+    RunAndReport(Aec3Optimization::kNone, num_capture_channels);
+    RunAndReport(DetectOptimization(), num_capture_channels);
+  }
+}
+
+}  // namespace webrtc
@@ -204,6 +204,244 @@ class VectorMath {
     }
   }
 
+  // Elementwise vector maximum z = max(z, x).
+  void Max(rtc::ArrayView<const float> x, rtc::ArrayView<float> z) {
+    RTC_DCHECK_EQ(z.size(), x.size());
+    switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kSse2: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const __m128 x_j = _mm_loadu_ps(&x[j]);
+          __m128 z_j = _mm_loadu_ps(&z[j]);
+          z_j = _mm_max_ps(z_j, x_j);
+          _mm_storeu_ps(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = std::max(z[j], x[j]);
+        }
+      } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+      case Aec3Optimization::kNeon: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const float32x4_t x_j = vld1q_f32(&x[j]);
+          float32x4_t z_j = vld1q_f32(&z[j]);
+          z_j = vmaxq_f32(z_j, x_j);
+          vst1q_f32(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = std::max(z[j], x[j]);
+        }
+      } break;
+#endif
+      default:
+        std::transform(z.begin(), z.end(), x.begin(), z.begin(),
+                       [](float a, float b) { return std::max(a, b); });
+    }
+  }
+
+  // Elementwise vector minimum z = min(z, x).
+  void Min(rtc::ArrayView<const float> x, rtc::ArrayView<float> z) {
+    RTC_DCHECK_EQ(z.size(), x.size());
+    switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kSse2: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const __m128 x_j = _mm_loadu_ps(&x[j]);
+          __m128 z_j = _mm_loadu_ps(&z[j]);
+          z_j = _mm_min_ps(z_j, x_j);
+          _mm_storeu_ps(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = std::min(z[j], x[j]);
+        }
+      } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+      case Aec3Optimization::kNeon: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const float32x4_t x_j = vld1q_f32(&x[j]);
+          float32x4_t z_j = vld1q_f32(&z[j]);
+          z_j = vminq_f32(z_j, x_j);
+          vst1q_f32(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = std::min(z[j], x[j]);
+        }
+      } break;
+#endif
+      default:
+        std::transform(z.begin(), z.end(), x.begin(), z.begin(),
+                       [](float a, float b) { return std::min(a, b); });
+    }
+  }
+
+  // Elementwise clamping z = max(min(z, upper), lower).
+  void Clamp(rtc::ArrayView<const float> lower,
+             rtc::ArrayView<const float> upper,
+             rtc::ArrayView<float> z) {
+    RTC_DCHECK_EQ(z.size(), lower.size());
+    RTC_DCHECK_EQ(z.size(), upper.size());
+    switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kSse2: {
+        const int x_size = static_cast<int>(z.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const __m128 lower_j = _mm_loadu_ps(&lower[j]);
+          const __m128 upper_j = _mm_loadu_ps(&upper[j]);
+          __m128 z_j = _mm_loadu_ps(&z[j]);
+          z_j = _mm_max_ps(_mm_min_ps(z_j, upper_j), lower_j);
+          _mm_storeu_ps(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = std::max(std::min(z[j], upper[j]), lower[j]);
+        }
+      } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+      case Aec3Optimization::kNeon: {
+        const int x_size = static_cast<int>(z.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const float32x4_t lower_j = vld1q_f32(&lower[j]);
+          const float32x4_t upper_j = vld1q_f32(&upper[j]);
+          float32x4_t z_j = vld1q_f32(&z[j]);
+          z_j = vmaxq_f32(vminq_f32(z_j, upper_j), lower_j);
+          vst1q_f32(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = std::max(std::min(z[j], upper[j]), lower[j]);
+        }
+      } break;
+#endif
+      default:
+        for (size_t j = 0; j < z.size(); ++j) {
+          z[j] = std::max(std::min(z[j], upper[j]), lower[j]);
+        }
+    }
+  }
+
+  // Elementwise vector division z = x / y.
+  void Divide(rtc::ArrayView<const float> x,
+              rtc::ArrayView<const float> y,
+              rtc::ArrayView<float> z) {
+    RTC_DCHECK_EQ(z.size(), x.size());
+    RTC_DCHECK_EQ(z.size(), y.size());
+    switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kSse2: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const __m128 x_j = _mm_loadu_ps(&x[j]);
+          const __m128 y_j = _mm_loadu_ps(&y[j]);
+          const __m128 z_j = _mm_div_ps(x_j, y_j);
+          _mm_storeu_ps(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = x[j] / y[j];
+        }
+      } break;
+#endif
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+      // The ARMv7 Neon unit has no exact division, so only ARM64 uses the
+      // vectorized code.
+      case Aec3Optimization::kNeon: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const float32x4_t x_j = vld1q_f32(&x[j]);
+          const float32x4_t y_j = vld1q_f32(&y[j]);
+          const float32x4_t z_j = vdivq_f32(x_j, y_j);
+          vst1q_f32(&z[j], z_j);
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = x[j] / y[j];
+        }
+      } break;
+#endif
+      default:
+        std::transform(x.begin(), x.end(), y.begin(), z.begin(),
+                       std::divides<float>());
+    }
+  }
+
+  // Vector scaling z = a * x.
+  void Scale(float a, rtc::ArrayView<const float> x, rtc::ArrayView<float> z) {
+    RTC_DCHECK_EQ(z.size(), x.size());
+    switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kSse2: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+        const __m128 a_v = _mm_set1_ps(a);
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const __m128 x_j = _mm_loadu_ps(&x[j]);
+          _mm_storeu_ps(&z[j], _mm_mul_ps(x_j, a_v));
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = x[j] * a;
+        }
+      } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+      case Aec3Optimization::kNeon: {
+        const int x_size = static_cast<int>(x.size());
+        const int vector_limit = x_size >> 2;
+
+        int j = 0;
+        for (; j < vector_limit * 4; j += 4) {
+          const float32x4_t x_j = vld1q_f32(&x[j]);
+          vst1q_f32(&z[j], vmulq_n_f32(x_j, a));
+        }
+
+        for (; j < x_size; ++j) {
+          z[j] = x[j] * a;
+        }
+      } break;
+#endif
+      default:
+        std::transform(x.begin(), x.end(), z.begin(),
+                       [a](float b) { return b * a; });
+    }
+  }
+
  private:
   Aec3Optimization optimization_;
 };
@@ -75,6 +75,99 @@ TEST(VectorMath, Accumulate) {
     EXPECT_FLOAT_EQ(x[k] + 2.f * x[k], z_neon[k]);
   }
 }
+
+TEST(VectorMath, Max) {
+  std::array<float, kFftLengthBy2Plus1> x;
+  std::array<float, kFftLengthBy2Plus1> z;
+  std::array<float, kFftLengthBy2Plus1> z_neon;
+
+  for (size_t k = 0; k < x.size(); ++k) {
+    x[k] = k;
+    z[k] = z_neon[k] = k % 2 == 0 ? 2.f * k : 0.5f * k;
+  }
+
+  aec3::VectorMath(Aec3Optimization::kNone).Max(x, z);
+  aec3::VectorMath(Aec3Optimization::kNeon).Max(x, z_neon);
+  for (size_t k = 0; k < z.size(); ++k) {
+    EXPECT_EQ(z[k], z_neon[k]);
+    EXPECT_EQ(k % 2 == 0 ? 2.f * k : x[k], z_neon[k]);
+  }
+}
+
+TEST(VectorMath, Min) {
+  std::array<float, kFftLengthBy2Plus1> x;
+  std::array<float, kFftLengthBy2Plus1> z;
+  std::array<float, kFftLengthBy2Plus1> z_neon;
+
+  for (size_t k = 0; k < x.size(); ++k) {
+    x[k] = k;
+    z[k] = z_neon[k] = k % 2 == 0 ? 2.f * k : 0.5f * k;
+  }
+
+  aec3::VectorMath(Aec3Optimization::kNone).Min(x, z);
+  aec3::VectorMath(Aec3Optimization::kNeon).Min(x, z_neon);
+  for (size_t k = 0; k < z.size(); ++k) {
+    EXPECT_EQ(z[k], z_neon[k]);
+    EXPECT_EQ(k % 2 == 0 ? x[k] : 0.5f * k, z_neon[k]);
+  }
+}
+
+TEST(VectorMath, Clamp) {
+  std::array<float, kFftLengthBy2Plus1> lower;
+  std::array<float, kFftLengthBy2Plus1> upper;
+  std::array<float, kFftLengthBy2Plus1> z;
+  std::array<float, kFftLengthBy2Plus1> z_neon;
+
+  for (size_t k = 0; k < z.size(); ++k) {
+    lower[k] = k;
+    upper[k] = k + 1.f;
+    z[k] = z_neon[k] = k + (k % 3) * 0.75f - 0.5f;
+  }
+
+  aec3::VectorMath(Aec3Optimization::kNone).Clamp(lower, upper, z);
+  aec3::VectorMath(Aec3Optimization::kNeon).Clamp(lower, upper, z_neon);
+  for (size_t k = 0; k < z.size(); ++k) {
+    EXPECT_EQ(z[k], z_neon[k]);
+    EXPECT_LE(lower[k], z_neon[k]);
+    EXPECT_GE(upper[k], z_neon[k]);
+  }
+}
+
+TEST(VectorMath, Divide) {
+  std::array<float, kFftLengthBy2Plus1> x;
+  std::array<float, kFftLengthBy2Plus1> y;
+  std::array<float, kFftLengthBy2Plus1> z;
+  std::array<float, kFftLengthBy2Plus1> z_neon;
+
+  for (size_t k = 0; k < x.size(); ++k) {
+    x[k] = k;
+    y[k] = (2.f / 3.f) * (k + 1);
+  }
+
+  aec3::VectorMath(Aec3Optimization::kNone).Divide(x, y, z);
+  aec3::VectorMath(Aec3Optimization::kNeon).Divide(x, y, z_neon);
+  for (size_t k = 0; k < z.size(); ++k) {
+    EXPECT_FLOAT_EQ(z[k], z_neon[k]);
+    EXPECT_FLOAT_EQ(x[k] / y[k], z_neon[k]);
+  }
+}
+
+TEST(VectorMath, Scale) {
+  std::array<float, kFftLengthBy2Plus1> x;
+  std::array<float, kFftLengthBy2Plus1> z;
+  std::array<float, kFftLengthBy2Plus1> z_neon;
+
+  for (size_t k = 0; k < x.size(); ++k) {
+    x[k] = k;
+  }
+
+  aec3::VectorMath(Aec3Optimization::kNone).Scale(2.f / 3.f, x, z);
+  aec3::VectorMath(Aec3Optimization::kNeon).Scale(2.f / 3.f, x, z_neon);
+  for (size_t k = 0; k < z.size(); ++k) {
+    EXPECT_FLOAT_EQ(z[k], z_neon[k]);
+    EXPECT_FLOAT_EQ(x[k] * (2.f / 3.f), z_neon[k]);
+  }
+}
 #endif
 
 #if defined(WEBRTC_ARCH_X86_FAMILY)
@@ -141,6 +234,109 @@ TEST(VectorMath, Accumulate) {
     }
   }
 }
+
+TEST(VectorMath, Max) {
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    std::array<float, kFftLengthBy2Plus1> x;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_sse2;
+
+    for (size_t k = 0; k < x.size(); ++k) {
+      x[k] = k;
+      z[k] = z_sse2[k] = k % 2 == 0 ? 2.f * k : 0.5f * k;
+    }
+
+    aec3::VectorMath(Aec3Optimization::kNone).Max(x, z);
+    aec3::VectorMath(Aec3Optimization::kSse2).Max(x, z_sse2);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_EQ(z[k], z_sse2[k]);
+      EXPECT_EQ(k % 2 == 0 ? 2.f * k : x[k], z_sse2[k]);
+    }
+  }
+}
+
+TEST(VectorMath, Min) {
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    std::array<float, kFftLengthBy2Plus1> x;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_sse2;
+
+    for (size_t k = 0; k < x.size(); ++k) {
+      x[k] = k;
+      z[k] = z_sse2[k] = k % 2 == 0 ? 2.f * k : 0.5f * k;
+    }
+
+    aec3::VectorMath(Aec3Optimization::kNone).Min(x, z);
+    aec3::VectorMath(Aec3Optimization::kSse2).Min(x, z_sse2);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_EQ(z[k], z_sse2[k]);
+      EXPECT_EQ(k % 2 == 0 ? x[k] : 0.5f * k, z_sse2[k]);
+    }
+  }
+}
+
+TEST(VectorMath, Clamp) {
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    std::array<float, kFftLengthBy2Plus1> lower;
+    std::array<float, kFftLengthBy2Plus1> upper;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_sse2;
+
+    for (size_t k = 0; k < z.size(); ++k) {
+      lower[k] = k;
+      upper[k] = k + 1.f;
+      z[k] = z_sse2[k] = k + (k % 3) * 0.75f - 0.5f;
+    }
+
+    aec3::VectorMath(Aec3Optimization::kNone).Clamp(lower, upper, z);
+    aec3::VectorMath(Aec3Optimization::kSse2).Clamp(lower, upper, z_sse2);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_EQ(z[k], z_sse2[k]);
+      EXPECT_LE(lower[k], z_sse2[k]);
+      EXPECT_GE(upper[k], z_sse2[k]);
+    }
+  }
+}
+
+TEST(VectorMath, Divide) {
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    std::array<float, kFftLengthBy2Plus1> x;
+    std::array<float, kFftLengthBy2Plus1> y;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_sse2;
+
+    for (size_t k = 0; k < x.size(); ++k) {
+      x[k] = k;
+      y[k] = (2.f / 3.f) * (k + 1);
+    }
+
+    aec3::VectorMath(Aec3Optimization::kNone).Divide(x, y, z);
+    aec3::VectorMath(Aec3Optimization::kSse2).Divide(x, y, z_sse2);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_FLOAT_EQ(z[k], z_sse2[k]);
+      EXPECT_FLOAT_EQ(x[k] / y[k], z_sse2[k]);
+    }
+  }
+}
+
+TEST(VectorMath, Scale) {
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    std::array<float, kFftLengthBy2Plus1> x;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_sse2;
+
+    for (size_t k = 0; k < x.size(); ++k) {
+      x[k] = k;
+    }
+
+    aec3::VectorMath(Aec3Optimization::kNone).Scale(2.f / 3.f, x, z);
+    aec3::VectorMath(Aec3Optimization::kSse2).Scale(2.f / 3.f, x, z_sse2);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_FLOAT_EQ(z[k], z_sse2[k]);
+      EXPECT_FLOAT_EQ(x[k] * (2.f / 3.f), z_sse2[k]);
+    }
+  }
+}
 #endif
 
 }  // namespace webrtc
@@ -0,0 +1,248 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/warm_start_state.h"
+
+#include <string.h>
+
+#include <cmath>
+#include <limits>
+
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x41454333;  // "AEC3".
+// Version 1 stored the dimensions in 8 bits and is no longer accepted.
+constexpr uint8_t kVersion = 2;
+constexpr size_t kHeaderSize = 4 + 1 + 3 * 4 + 1 + 4;
+constexpr size_t kChecksumSize = 4;
+
+// FNV-1a hash, used for detecting corrupted blobs.
+uint32_t Checksum(const uint8_t* data, size_t size) {
+  uint32_t hash = 2166136261u;
+  for (size_t k = 0; k < size; ++k) {
+    hash = (hash ^ data[k]) * 16777619u;
+  }
+  return hash;
+}
+
+// Returns whether a blob of |blob_size| bytes is large enough for the filter
+// coefficients of the given non-zero dimensions. This bounds the dimensions
+// before the blob size is computed from them.
+bool FiltersFit(size_t blob_size,
+                size_t num_render_channels,
+                size_t num_capture_channels,
+                size_t num_partitions) {
+  const size_t max_num_filters =
+      blob_size / (2 * kFftLengthBy2Plus1 * sizeof(float));
+  return num_capture_channels <=
+         max_num_filters / num_partitions / num_render_channels;
+}
+
+// Returns the blob size for the given dimensions.
+size_t BlobSize(size_t num_render_channels,
+                size_t num_capture_channels,
+                size_t num_partitions) {
+  const size_t num_floats =
+      num_capture_channels * num_partitions * num_render_channels * 2 *
+          kFftLengthBy2Plus1 +
+      kFftLengthBy2Plus1 + 1 +
+      num_capture_channels * (2 * kFftLengthBy2Plus1 + 1) + 2 +
+      kFftLengthBy2Plus1;
+  return kHeaderSize + num_floats * sizeof(float) + kChecksumSize;
+}
+
+void WriteFloat(float value, rtc::ByteBufferWriter* writer) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  writer->WriteUInt32(bits);
+}
+
+void WriteFloats(rtc::ArrayView<const float> values,
+                 rtc::ByteBufferWriter* writer) {
+  for (float value : values) {
+    WriteFloat(value, writer);
+  }
+}
+
+// Reads a float, failing on values that are not finite.
+bool ReadFloat(rtc::ByteBufferReader* reader, float* value) {
+  uint32_t bits;
+  if (!reader->ReadUInt32(&bits)) {
+    return false;
+  }
+  memcpy(value, &bits, sizeof(bits));
+  return std::isfinite(*value);
+}
+
+bool ReadFloats(rtc::ByteBufferReader* reader, rtc::ArrayView<float> values) {
+  for (float& value : values) {
+    if (!ReadFloat(reader, &value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+WarmStartState::WarmStartState() {
+  erl.fill(0.f);
+  reverb_frequency_response.fill(0.f);
+}
+
+WarmStartState::WarmStartState(const WarmStartState&) = default;
+WarmStartState& WarmStartState::operator=(const WarmStartState&) = default;
+WarmStartState::~WarmStartState() = default;
+
+void SerializeWarmStartState(const WarmStartState& state,
+                             std::vector<uint8_t>* blob) {
+  RTC_DCHECK(blob);
+  RTC_DCHECK(!state.filters.empty());
+  RTC_DCHECK(!state.filters[0].empty());
+  const size_t num_capture_channels = state.filters.size();
+  const size_t num_partitions = state.filters[0].size();
+  const size_t num_render_channels = state.filters[0][0].size();
+  RTC_DCHECK(!state.delay_blocks ||
+             *state.delay_blocks <= std::numeric_limits<uint32_t>::max());
+  RTC_DCHECK_EQ(num_capture_channels, state.erle.size());
+  RTC_DCHECK_EQ(num_capture_channels, state.erle_onsets.size());
+  RTC_DCHECK_EQ(num_capture_channels, state.fullband_erle_log2.size());
+
+  rtc::ByteBufferWriter writer;
+  writer.WriteUInt32(kMagic);
+  writer.WriteUInt8(kVersion);
+  // The dimensions are bounded by the size of the state, which fits in memory.
+  writer.WriteUInt32(static_cast<uint32_t>(num_render_channels));
+  writer.WriteUInt32(static_cast<uint32_t>(num_capture_channels));
+  writer.WriteUInt32(static_cast<uint32_t>(num_partitions));
+  writer.WriteUInt8(state.delay_blocks ? 1 : 0);
+  writer.WriteUInt32(
+      state.delay_blocks ? static_cast<uint32_t>(*state.delay_blocks) : 0);
+
+  for (const auto& H : state.filters) {
+    RTC_DCHECK_EQ(num_partitions, H.size());
+    for (const auto& H_p : H) {
+      RTC_DCHECK_EQ(num_render_channels, H_p.size());
+      for (const FftData& H_p_ch : H_p) {
+        WriteFloats(H_p_ch.re, &writer);
+        WriteFloats(H_p_ch.im, &writer);
+      }
+    }
+  }
+
+  WriteFloats(state.erl, &writer);
+  WriteFloat(state.erl_time_domain, &writer);
+  for (size_t ch = 0; ch < num_capture_channels; ++ch) {
+    WriteFloats(state.erle[ch], &writer);
+    WriteFloats(state.erle_onsets[ch], &writer);
+    WriteFloat(state.fullband_erle_log2[ch], &writer);
+  }
+
+  WriteFloat(state.reverb_decay, &writer);
+  WriteFloat(state.reverb_average_decay, &writer);
+  WriteFloats(state.reverb_frequency_response, &writer);
+
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(writer.Data());
+  writer.WriteUInt32(Checksum(data, writer.Length()));
+  RTC_DCHECK_EQ(BlobSize(num_render_channels, num_capture_channels,
+                         num_partitions),
+                writer.Length());
+
+  data = reinterpret_cast<const uint8_t*>(writer.Data());
+  blob->assign(data, data + writer.Length());
+}
+
+bool ParseWarmStartState(rtc::ArrayView<const uint8_t> blob,
+                         WarmStartState* state) {
+  RTC_DCHECK(state);
+  if (blob.size() < kHeaderSize + kChecksumSize) {
+    return false;
+  }
+
+  rtc::ByteBufferReader reader(reinterpret_cast<const char*>(blob.data()),
+                               blob.size());
+  uint32_t magic;
+  uint8_t version;
+  uint32_t num_render_channels;
+  uint32_t num_capture_channels;
+  uint32_t num_partitions;
+  uint8_t has_delay;
+  uint32_t delay_blocks;
+  reader.ReadUInt32(&magic);
+  reader.ReadUInt8(&version);
+  reader.ReadUInt32(&num_render_channels);
+  reader.ReadUInt32(&num_capture_channels);
+  reader.ReadUInt32(&num_partitions);
+  reader.ReadUInt8(&has_delay);
+  reader.ReadUInt32(&delay_blocks);
+
+  if (magic != kMagic || version != kVersion || num_render_channels == 0 ||
+      num_capture_channels == 0 || num_partitions == 0 || has_delay > 1 ||
+      !FiltersFit(blob.size(), num_render_channels, num_capture_channels,
+                  num_partitions) ||
+      blob.size() != BlobSize(num_render_channels, num_capture_channels,
+                              num_partitions)) {
+    return false;
+  }
+
+  WarmStartState parsed;
+  if (has_delay) {
+    parsed.delay_blocks = delay_blocks;
+  }
+
+  parsed.filters.resize(num_capture_channels);
+  for (auto& H : parsed.filters) {
+    H.resize(num_partitions, std::vector<FftData>(num_render_channels));
+    for (auto& H_p : H) {
+      for (FftData& H_p_ch : H_p) {
+        if (!ReadFloats(&reader, H_p_ch.re) ||
+            !ReadFloats(&reader, H_p_ch.im)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  if (!ReadFloats(&reader, parsed.erl) ||
+      !ReadFloat(&reader, &parsed.erl_time_domain)) {
+    return false;
+  }
+  parsed.erle.resize(num_capture_channels);
+  parsed.erle_onsets.resize(num_capture_channels);
+  parsed.fullband_erle_log2.resize(num_capture_channels);
+  for (size_t ch = 0; ch < num_capture_channels; ++ch) {
+    if (!ReadFloats(&reader, parsed.erle[ch]) ||
+        !ReadFloats(&reader, parsed.erle_onsets[ch]) ||
+        !ReadFloat(&reader, &parsed.fullband_erle_log2[ch])) {
+      return false;
+    }
+  }
+
+  if (!ReadFloat(&reader, &parsed.reverb_decay) ||
+      !ReadFloat(&reader, &parsed.reverb_average_decay) ||
+      !ReadFloats(&reader, parsed.reverb_frequency_response)) {
+    return false;
+  }
+  uint32_t checksum;
+  reader.ReadUInt32(&checksum);
+  if (checksum != Checksum(blob.data(), blob.size() - kChecksumSize)) {
+    return false;
+  }
+
+  *state = std::move(parsed);
+  return true;
+}
+
+}  // namespace webrtc
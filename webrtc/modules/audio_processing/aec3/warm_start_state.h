@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_WARM_START_STATE_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_WARM_START_STATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+
+namespace webrtc {
+
+// Adaptive state of a converged echo canceller, which allows a new echo
+// canceller with the same configuration to start in a converged state.
+struct WarmStartState {
+  WarmStartState();
+  WarmStartState(const WarmStartState&);
+  WarmStartState& operator=(const WarmStartState&);
+  ~WarmStartState();
+
+  // Render delay buffer delay, in blocks.
+  absl::optional<size_t> delay_blocks;
+  // Frequency domain coefficients of the refined linear filters, indexed as
+  // [capture channel][partition][render channel].
+  std::vector<std::vector<std::vector<FftData>>> filters;
+  std::array<float, kFftLengthBy2Plus1> erl;
+  float erl_time_domain = 0.f;
+  // Subband and fullband ERLE estimates for each capture channel.
+  std::vector<std::array<float, kFftLengthBy2Plus1>> erle;
+  std::vector<std::array<float, kFftLengthBy2Plus1>> erle_onsets;
+  std::vector<float> fullband_erle_log2;
+  // Reverb model parameters.
+  float reverb_decay = 0.f;
+  float reverb_average_decay = 0.f;
+  std::array<float, kFftLengthBy2Plus1> reverb_frequency_response;
+};
+
+// Serializes |state| into a versioned binary blob.
+void SerializeWarmStartState(const WarmStartState& state,
+                             std::vector<uint8_t>* blob);
+
+// Parses a blob produced by SerializeWarmStartState(). Returns false, leaving
+// |state| untouched, if the blob is of an unknown version, truncated, corrupt
+// or contains non-finite values.
+bool ParseWarmStartState(rtc::ArrayView<const uint8_t> blob,
+                         WarmStartState* state);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_WARM_START_STATE_H_
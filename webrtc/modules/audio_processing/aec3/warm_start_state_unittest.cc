@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/warm_start_state.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+WarmStartState CreateState(size_t num_render_channels,
+                           size_t num_capture_channels,
+                           size_t num_partitions) {
+  Random random_generator(42U);
+  WarmStartState state;
+  state.delay_blocks = 3;
+  state.filters.resize(num_capture_channels);
+  for (auto& H : state.filters) {
+    H.resize(num_partitions, std::vector<FftData>(num_render_channels));
+    for (auto& H_p : H) {
+      for (FftData& H_p_ch : H_p) {
+        RandomizeSampleVector(&random_generator, H_p_ch.re);
+        RandomizeSampleVector(&random_generator, H_p_ch.im);
+      }
+    }
+  }
+  RandomizeSampleVector(&random_generator, state.erl);
+  state.erl_time_domain = 0.5f;
+  state.erle.resize(num_capture_channels);
+  state.erle_onsets.resize(num_capture_channels);
+  for (size_t ch = 0; ch < num_capture_channels; ++ch) {
+    RandomizeSampleVector(&random_generator, state.erle[ch]);
+    RandomizeSampleVector(&random_generator, state.erle_onsets[ch]);
+  }
+  state.fullband_erle_log2.resize(num_capture_channels, 3.f);
+  state.reverb_decay = 0.8f;
+  state.reverb_average_decay = 0.1f;
+  RandomizeSampleVector(&random_generator, state.reverb_frequency_response);
+  return state;
+}
+
+}  // namespace
+
+// Verifies that a serialized state is parsed back without changes.
+TEST(WarmStartState, RoundTrip) {
+  for (size_t num_render_channels : {1, 2}) {
+    for (size_t num_capture_channels : {1, 3}) {
+      const WarmStartState state =
+          CreateState(num_render_channels, num_capture_channels, 13);
+      std::vector<uint8_t> blob;
+      SerializeWarmStartState(state, &blob);
+
+      WarmStartState parsed;
+      ASSERT_TRUE(ParseWarmStartState(blob, &parsed));
+      EXPECT_EQ(state.delay_blocks, parsed.delay_blocks);
+      ASSERT_EQ(num_capture_channels, parsed.filters.size());
+      for (size_t ch = 0; ch < num_capture_channels; ++ch) {
+        ASSERT_EQ(13u, parsed.filters[ch].size());
+        for (size_t p = 0; p < 13; ++p) {
+          ASSERT_EQ(num_render_channels, parsed.filters[ch][p].size());
+          for (size_t k = 0; k < num_render_channels; ++k) {
+            EXPECT_EQ(state.filters[ch][p][k].re, parsed.filters[ch][p][k].re);
+            EXPECT_EQ(state.filters[ch][p][k].im, parsed.filters[ch][p][k].im);
+          }
+        }
+      }
+      EXPECT_EQ(state.erl, parsed.erl);
+      EXPECT_EQ(state.erl_time_domain, parsed.erl_time_domain);
+      EXPECT_EQ(state.erle, parsed.erle);
+      EXPECT_EQ(state.erle_onsets, parsed.erle_onsets);
+      EXPECT_EQ(state.fullband_erle_log2, parsed.fullband_erle_log2);
+      EXPECT_EQ(state.reverb_decay, parsed.reverb_decay);
+      EXPECT_EQ(state.reverb_average_decay, parsed.reverb_average_decay);
+      EXPECT_EQ(state.reverb_frequency_response,
+                parsed.reverb_frequency_response);
+    }
+  }
+}
+
+// Verifies that a state without a delay estimate is parsed correctly.
+TEST(WarmStartState, NoDelay) {
+  WarmStartState state = CreateState(1, 1, 12);
+  state.delay_blocks = absl::nullopt;
+  std::vector<uint8_t> blob;
+  SerializeWarmStartState(state, &blob);
+  WarmStartState parsed;
+  ASSERT_TRUE(ParseWarmStartState(blob, &parsed));
+  EXPECT_FALSE(parsed.delay_blocks);
+}
+
+// Verifies that dimensions above 255 are kept.
+TEST(WarmStartState, LargeDimensions) {
+  const WarmStartState state = CreateState(1, 1, 300);
+  std::vector<uint8_t> blob;
+  SerializeWarmStartState(state, &blob);
+  WarmStartState parsed;
+  ASSERT_TRUE(ParseWarmStartState(blob, &parsed));
+  ASSERT_EQ(1u, parsed.filters.size());
+  ASSERT_EQ(300u, parsed.filters[0].size());
+  EXPECT_EQ(state.filters[0][299][0].re, parsed.filters[0][299][0].re);
+}
+
+// Verifies that truncated, extended, corrupted and unknown blobs are rejected
+// without modifying the output.
+TEST(WarmStartState, InvalidBlobs) {
+  std::vector<uint8_t> blob;
+  SerializeWarmStartState(CreateState(1, 1, 13), &blob);
+
+  WarmStartState parsed;
+  EXPECT_FALSE(ParseWarmStartState(std::vector<uint8_t>(), &parsed));
+
+  std::vector<uint8_t> truncated(blob.begin(), blob.end() - 1);
+  EXPECT_FALSE(ParseWarmStartState(truncated, &parsed));
+
+  std::vector<uint8_t> extended = blob;
+  extended.push_back(0);
+  EXPECT_FALSE(ParseWarmStartState(extended, &parsed));
+
+  std::vector<uint8_t> corrupted = blob;
+  corrupted[blob.size() / 2] ^= 1;
+  EXPECT_FALSE(ParseWarmStartState(corrupted, &parsed));
+
+  std::vector<uint8_t> unknown_version = blob;
+  ++unknown_version[4];
+  EXPECT_FALSE(ParseWarmStartState(unknown_version, &parsed));
+
+  // Dimensions much too large for the blob, with products that overflow.
+  std::vector<uint8_t> too_large = blob;
+  std::fill(too_large.begin() + 5, too_large.begin() + 17, 0xff);
+  EXPECT_FALSE(ParseWarmStartState(too_large, &parsed));
+
+  EXPECT_TRUE(parsed.filters.empty());
+  EXPECT_FALSE(parsed.delay_blocks);
+}
+
+}  // namespace webrtc
@@ -23,6 +23,7 @@ extern "C" {
 #include "modules/audio_processing/utility/delay_estimator_wrapper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 
@@ -185,6 +186,9 @@ const uint16_t* WebRtcAecm_AlignedFarend(AecmCore* self,
 CalcLinearEnergies WebRtcAecm_CalcLinearEnergies;
 StoreAdaptiveChannel WebRtcAecm_StoreAdaptiveChannel;
 ResetAdaptiveChannel WebRtcAecm_ResetAdaptiveChannel;
+WindowTimeSignal WebRtcAecm_WindowTimeSignal;
+Conjugate WebRtcAecm_Conjugate;
+WindowAndOverlapAdd WebRtcAecm_WindowAndOverlapAdd;
 
 AecmCore* WebRtcAecm_CreateCore() {
   // Allocate zero-filled memory.
@@ -274,12 +278,12 @@ void WebRtcAecm_InitEchoPathCore(AecmCore* aecm, const int16_t* echo_path) {
   aecm->mseChannelCount = 0;
 }
 
-static void CalcLinearEnergiesC(AecmCore* aecm,
-                                const uint16_t* far_spectrum,
-                                int32_t* echo_est,
-                                uint32_t* far_energy,
-                                uint32_t* echo_energy_adapt,
-                                uint32_t* echo_energy_stored) {
+void WebRtcAecm_CalcLinearEnergiesC(AecmCore* aecm,
+                                    const uint16_t* far_spectrum,
+                                    int32_t* echo_est,
+                                    uint32_t* far_energy,
+                                    uint32_t* echo_energy_adapt,
+                                    uint32_t* echo_energy_stored) {
   int i;
 
   // Get energy for the delayed far end signal and estimated
@@ -293,9 +297,9 @@ static void CalcLinearEnergiesC(AecmCore* aecm,
   }
 }
 
-static void StoreAdaptiveChannelC(AecmCore* aecm,
-                                  const uint16_t* far_spectrum,
-                                  int32_t* echo_est) {
+void WebRtcAecm_StoreAdaptiveChannelC(AecmCore* aecm,
+                                      const uint16_t* far_spectrum,
+                                      int32_t* echo_est) {
   int i;
 
   // During startup we store the channel every block.
@@ -315,7 +319,7 @@ static void StoreAdaptiveChannelC(AecmCore* aecm,
   echo_est[i] = WEBRTC_SPL_MUL_16_U16(aecm->channelStored[i], far_spectrum[i]);
 }
 
-static void ResetAdaptiveChannelC(AecmCore* aecm) {
+void WebRtcAecm_ResetAdaptiveChannelC(AecmCore* aecm) {
   int i;
 
   // The stored channel has a significantly lower MSE than the adaptive one for
@@ -341,6 +345,20 @@ static void WebRtcAecm_InitNeon(void) {
 }
 #endif
 
+// Initialize function pointers for x86 platforms with SSE2.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+static void WebRtcAecm_InitSse2(void) {
+  WebRtcAecm_StoreAdaptiveChannel = WebRtcAecm_StoreAdaptiveChannelSse2;
+  WebRtcAecm_ResetAdaptiveChannel = WebRtcAecm_ResetAdaptiveChannelSse2;
+  WebRtcAecm_CalcLinearEnergies = WebRtcAecm_CalcLinearEnergiesSse2;
+#if defined(__SSE2__)
+  WebRtcAecm_WindowTimeSignal = WebRtcAecm_WindowTimeSignalSse2;
+  WebRtcAecm_Conjugate = WebRtcAecm_ConjugateSse2;
+  WebRtcAecm_WindowAndOverlapAdd = WebRtcAecm_WindowAndOverlapAddSse2;
+#endif
+}
+#endif
+
 // Initialize function pointers for MIPS platform.
 #if defined(MIPS32_LE)
 static void WebRtcAecm_InitMips(void) {
@@ -468,14 +486,27 @@ int WebRtcAecm_InitCore(AecmCore* const aecm, int samplingFreq) {
   static_assert(PART_LEN % 16 == 0, "PART_LEN is not a multiple of 16");
 
   // Initialize function pointers.
-  WebRtcAecm_CalcLinearEnergies = CalcLinearEnergiesC;
-  WebRtcAecm_StoreAdaptiveChannel = StoreAdaptiveChannelC;
-  WebRtcAecm_ResetAdaptiveChannel = ResetAdaptiveChannelC;
+  WebRtcAecm_CalcLinearEnergies = WebRtcAecm_CalcLinearEnergiesC;
+  WebRtcAecm_StoreAdaptiveChannel = WebRtcAecm_StoreAdaptiveChannelC;
+  WebRtcAecm_ResetAdaptiveChannel = WebRtcAecm_ResetAdaptiveChannelC;
+  WebRtcAecm_WindowTimeSignal = WebRtcAecm_WindowTimeSignalC;
+  WebRtcAecm_Conjugate = WebRtcAecm_ConjugateC;
+  WebRtcAecm_WindowAndOverlapAdd = WebRtcAecm_WindowAndOverlapAddC;
 
 #if defined(WEBRTC_HAS_NEON)
   WebRtcAecm_InitNeon();
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  WebRtcAecm_InitSse2();
+#else
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    WebRtcAecm_InitSse2();
+  }
+#endif
+#endif
+
 #if defined(MIPS32_LE)
   WebRtcAecm_InitMips();
 #endif
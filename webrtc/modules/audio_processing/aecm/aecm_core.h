@@ -18,6 +18,8 @@ extern "C" {
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 }
 #include "modules/audio_processing/aecm/aecm_defines.h"
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
 
 struct RealFFT;
 
@@ -402,9 +404,37 @@ extern StoreAdaptiveChannel WebRtcAecm_StoreAdaptiveChannel;
 typedef void (*ResetAdaptiveChannel)(AecmCore* aecm);
 extern ResetAdaptiveChannel WebRtcAecm_ResetAdaptiveChannel;
 
+typedef void (*WindowTimeSignal)(const int16_t* time_signal,
+                                 int time_signal_scaling,
+                                 int16_t* fft);
+extern WindowTimeSignal WebRtcAecm_WindowTimeSignal;
+
+typedef void (*Conjugate)(const ComplexInt16* in, ComplexInt16* out);
+extern Conjugate WebRtcAecm_Conjugate;
+
+typedef void (*WindowAndOverlapAdd)(int16_t* ifft_out,
+                                    int shift,
+                                    int16_t* out_buf,
+                                    int16_t* output);
+extern WindowAndOverlapAdd WebRtcAecm_WindowAndOverlapAdd;
+
 // For the above function pointers, functions for generic platforms are declared
-// and defined as static in file aecm_core.c, while those for ARM Neon platforms
-// are declared below and defined in file aecm_core_neon.c.
+// below and defined in file aecm_core.cc, while those for ARM Neon and x86 SSE2
+// platforms are declared below and defined in files aecm_core_neon.cc and
+// aecm_core_sse2.cc.
+void WebRtcAecm_CalcLinearEnergiesC(AecmCore* aecm,
+                                    const uint16_t* far_spectrum,
+                                    int32_t* echo_est,
+                                    uint32_t* far_energy,
+                                    uint32_t* echo_energy_adapt,
+                                    uint32_t* echo_energy_stored);
+
+void WebRtcAecm_StoreAdaptiveChannelC(AecmCore* aecm,
+                                      const uint16_t* far_spectrum,
+                                      int32_t* echo_est);
+
+void WebRtcAecm_ResetAdaptiveChannelC(AecmCore* aecm);
+
 #if defined(WEBRTC_HAS_NEON)
 void WebRtcAecm_CalcLinearEnergiesNeon(AecmCore* aecm,
                                        const uint16_t* far_spectrum,
@@ -420,6 +450,21 @@ void WebRtcAecm_StoreAdaptiveChannelNeon(AecmCore* aecm,
 void WebRtcAecm_ResetAdaptiveChannelNeon(AecmCore* aecm);
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcAecm_CalcLinearEnergiesSse2(AecmCore* aecm,
+                                       const uint16_t* far_spectrum,
+                                       int32_t* echo_est,
+                                       uint32_t* far_energy,
+                                       uint32_t* echo_energy_adapt,
+                                       uint32_t* echo_energy_stored);
+
+void WebRtcAecm_StoreAdaptiveChannelSse2(AecmCore* aecm,
+                                         const uint16_t* far_spectrum,
+                                         int32_t* echo_est);
+
+void WebRtcAecm_ResetAdaptiveChannelSse2(AecmCore* aecm);
+#endif
+
 #if defined(MIPS32_LE)
 void WebRtcAecm_CalcLinearEnergies_mips(AecmCore* aecm,
                                         const uint16_t* far_spectrum,
@@ -436,6 +481,39 @@ void WebRtcAecm_ResetAdaptiveChannel_mips(AecmCore* aecm);
 #endif
 #endif
 
+// Windowing steps of the FFTs in aecm_core_c.cc, used through the function
+// pointers above. The SSE2 versions are selected when SSE2 is available at
+// compile time. Both are declared here so that they can be tested against each
+// other.
+//
+// Windows the 2 * PART_LEN samples of |time_signal|, scaled by
+// 2^|time_signal_scaling|, into |fft|.
+void WebRtcAecm_WindowTimeSignalC(const int16_t* time_signal,
+                                  int time_signal_scaling,
+                                  int16_t* fft);
+// Writes the complex conjugates of the first PART_LEN values of |in| to |out|,
+// which may be |in|.
+void WebRtcAecm_ConjugateC(const ComplexInt16* in, ComplexInt16* out);
+// Windows the 2 * PART_LEN samples of the inverse FFT output |ifft_out| and
+// shifts them left by |shift|, or right if it is negative. The first half is
+// windowed in place and added to the overlap in |out_buf| into |output|. The
+// second half is the overlap for the next block and replaces |out_buf|.
+void WebRtcAecm_WindowAndOverlapAddC(int16_t* ifft_out,
+                                     int shift,
+                                     int16_t* out_buf,
+                                     int16_t* output);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+void WebRtcAecm_WindowTimeSignalSse2(const int16_t* time_signal,
+                                     int time_signal_scaling,
+                                     int16_t* fft);
+void WebRtcAecm_ConjugateSse2(const ComplexInt16* in, ComplexInt16* out);
+void WebRtcAecm_WindowAndOverlapAddSse2(int16_t* ifft_out,
+                                        int shift,
+                                        int16_t* out_buf,
+                                        int16_t* output);
+#endif
+
 }  // namespace webrtc
 
 #endif
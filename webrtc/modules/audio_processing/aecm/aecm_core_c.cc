@@ -13,6 +13,10 @@
 
 #include "modules/audio_processing/aecm/aecm_core.h"
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 extern "C" {
 #include "common_audio/ring_buffer.h"
 #include "common_audio/signal_processing/include/real_fft.h"
@@ -58,6 +62,165 @@ static const uint16_t kBeta3 = 18927;
 static const int16_t kNoiseEstQDomain = 15;
 static const int16_t kNoiseEstIncCount = 5;
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+// The windowing below is bit exact with the C code. All products of a sample
+// and the window are at most 2^15 in magnitude after the shift by 14, so
+// saturating packs give the same results as the truncating casts.
+
+// Returns the 32-bit products of the lower and upper four signed 16-bit lanes
+// of |a| and |b|.
+static inline void MulS16(__m128i a,
+                          __m128i b,
+                          __m128i* product_low,
+                          __m128i* product_high) {
+  const __m128i low = _mm_mullo_epi16(a, b);
+  const __m128i high = _mm_mulhi_epi16(a, b);
+  *product_low = _mm_unpacklo_epi16(low, high);
+  *product_high = _mm_unpackhi_epi16(low, high);
+}
+
+// Returns (a * b) >> 14 for the signed 16-bit lanes of |a| and |b|.
+static inline __m128i MulRsft14(__m128i a, __m128i b) {
+  __m128i low;
+  __m128i high;
+  MulS16(a, b, &low, &high);
+  return _mm_packs_epi32(_mm_srai_epi32(low, 14), _mm_srai_epi32(high, 14));
+}
+
+// Reverses the order of the eight 16-bit lanes of |v|.
+static inline __m128i Reverse16(__m128i v) {
+  v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+// Negates the imaginary parts of the four complex values in |v|.
+static inline __m128i ConjugateX4(__m128i v) {
+  const __m128i imag_mask = _mm_set1_epi32(static_cast<int32_t>(0xFFFF0000));
+  return _mm_sub_epi16(_mm_xor_si128(v, imag_mask), imag_mask);
+}
+
+// WEBRTC_SPL_SHIFT_W32() on each 32-bit lane of |v|.
+static inline __m128i ShiftW32(__m128i v, int shift) {
+  return shift >= 0 ? _mm_sll_epi32(v, _mm_cvtsi32_si128(shift))
+                    : _mm_sra_epi32(v, _mm_cvtsi32_si128(-shift));
+}
+
+static inline __m128i LoadS16(const int16_t* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+static inline void StoreS16(int16_t* p, __m128i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+#endif
+
+}  // namespace
+
+void WebRtcAecm_WindowTimeSignalC(const int16_t* time_signal,
+                                  int time_signal_scaling,
+                                  int16_t* fft) {
+  for (int i = 0; i < PART_LEN; i++) {
+    // Window time domain signal and insert into real part of
+    // transformation array |fft|
+    int16_t scaled_time_signal = time_signal[i] * (1 << time_signal_scaling);
+    fft[i] = (int16_t)((scaled_time_signal * WebRtcAecm_kSqrtHanning[i]) >> 14);
+    scaled_time_signal = time_signal[i + PART_LEN] * (1 << time_signal_scaling);
+    fft[PART_LEN + i] = (int16_t)(
+        (scaled_time_signal * WebRtcAecm_kSqrtHanning[PART_LEN - i]) >> 14);
+  }
+}
+
+void WebRtcAecm_ConjugateC(const ComplexInt16* in, ComplexInt16* out) {
+  for (int i = 0; i < PART_LEN; i++) {
+    out[i].real = in[i].real;
+    out[i].imag = -in[i].imag;
+  }
+}
+
+void WebRtcAecm_WindowAndOverlapAddC(int16_t* ifft_out,
+                                     int shift,
+                                     int16_t* out_buf,
+                                     int16_t* output) {
+  int32_t tmp32no1;
+  for (int i = 0; i < PART_LEN; i++) {
+    ifft_out[i] = (int16_t)WEBRTC_SPL_MUL_16_16_RSFT_WITH_ROUND(
+        ifft_out[i], WebRtcAecm_kSqrtHanning[i], 14);
+    tmp32no1 = WEBRTC_SPL_SHIFT_W32((int32_t)ifft_out[i], shift);
+    output[i] = (int16_t)WEBRTC_SPL_SAT(WEBRTC_SPL_WORD16_MAX,
+                                        tmp32no1 + out_buf[i],
+                                        WEBRTC_SPL_WORD16_MIN);
+
+    tmp32no1 =
+        (ifft_out[PART_LEN + i] * WebRtcAecm_kSqrtHanning[PART_LEN - i]) >> 14;
+    tmp32no1 = WEBRTC_SPL_SHIFT_W32(tmp32no1, shift);
+    out_buf[i] = (int16_t)WEBRTC_SPL_SAT(WEBRTC_SPL_WORD16_MAX, tmp32no1,
+                                         WEBRTC_SPL_WORD16_MIN);
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+void WebRtcAecm_WindowTimeSignalSse2(const int16_t* time_signal,
+                                     int time_signal_scaling,
+                                     int16_t* fft) {
+  const __m128i scaling = _mm_cvtsi32_si128(time_signal_scaling);
+  for (int i = 0; i < PART_LEN; i += 8) {
+    const __m128i x_low = _mm_sll_epi16(LoadS16(&time_signal[i]), scaling);
+    const __m128i x_high =
+        _mm_sll_epi16(LoadS16(&time_signal[i + PART_LEN]), scaling);
+    const __m128i window = LoadS16(&WebRtcAecm_kSqrtHanning[i]);
+    // The upper half uses the window backwards, from index PART_LEN - i.
+    const __m128i window_reversed =
+        Reverse16(LoadS16(&WebRtcAecm_kSqrtHanning[PART_LEN - 7 - i]));
+    StoreS16(&fft[i], MulRsft14(x_low, window));
+    StoreS16(&fft[PART_LEN + i], MulRsft14(x_high, window_reversed));
+  }
+}
+
+void WebRtcAecm_ConjugateSse2(const ComplexInt16* in, ComplexInt16* out) {
+  for (int i = 0; i < PART_LEN; i += 4) {
+    StoreS16(&out[i].real, ConjugateX4(LoadS16(&in[i].real)));
+  }
+}
+
+void WebRtcAecm_WindowAndOverlapAddSse2(int16_t* ifft_out,
+                                        int shift,
+                                        int16_t* out_buf,
+                                        int16_t* output) {
+  const __m128i rounding = _mm_set1_epi32(1 << 13);
+  for (int i = 0; i < PART_LEN; i += 8) {
+    __m128i low;
+    __m128i high;
+    MulS16(LoadS16(&ifft_out[i]), LoadS16(&WebRtcAecm_kSqrtHanning[i]), &low,
+           &high);
+    const __m128i windowed =
+        _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(low, rounding), 14),
+                        _mm_srai_epi32(_mm_add_epi32(high, rounding), 14));
+    StoreS16(&ifft_out[i], windowed);
+    // Sign extend the windowed samples and the saved overlap to 32 bits.
+    const __m128i overlap = LoadS16(&out_buf[i]);
+    low = _mm_add_epi32(
+        ShiftW32(_mm_srai_epi32(_mm_unpacklo_epi16(windowed, windowed), 16),
+                 shift),
+        _mm_srai_epi32(_mm_unpacklo_epi16(overlap, overlap), 16));
+    high = _mm_add_epi32(
+        ShiftW32(_mm_srai_epi32(_mm_unpackhi_epi16(windowed, windowed), 16),
+                 shift),
+        _mm_srai_epi32(_mm_unpackhi_epi16(overlap, overlap), 16));
+    StoreS16(&output[i], _mm_packs_epi32(low, high));
+
+    const __m128i window_reversed =
+        Reverse16(LoadS16(&WebRtcAecm_kSqrtHanning[PART_LEN - 7 - i]));
+    MulS16(LoadS16(&ifft_out[PART_LEN + i]), window_reversed, &low, &high);
+    StoreS16(&out_buf[i],
+             _mm_packs_epi32(ShiftW32(_mm_srai_epi32(low, 14), shift),
+                             ShiftW32(_mm_srai_epi32(high, 14), shift)));
+  }
+}
+#endif
+
+namespace {
+
 static void ComfortNoise(AecmCore* aecm,
                          const uint16_t* dfa,
                          ComplexInt16* out,
@@ -176,25 +339,13 @@ static void WindowAndFFT(AecmCore* aecm,
                          const int16_t* time_signal,
                          ComplexInt16* freq_signal,
                          int time_signal_scaling) {
-  int i = 0;
-
   // FFT of signal
-  for (i = 0; i < PART_LEN; i++) {
-    // Window time domain signal and insert into real part of
-    // transformation array |fft|
-    int16_t scaled_time_signal = time_signal[i] * (1 << time_signal_scaling);
-    fft[i] = (int16_t)((scaled_time_signal * WebRtcAecm_kSqrtHanning[i]) >> 14);
-    scaled_time_signal = time_signal[i + PART_LEN] * (1 << time_signal_scaling);
-    fft[PART_LEN + i] = (int16_t)(
-        (scaled_time_signal * WebRtcAecm_kSqrtHanning[PART_LEN - i]) >> 14);
-  }
+  WebRtcAecm_WindowTimeSignal(time_signal, time_signal_scaling, fft);
 
   // Do forward FFT, then take only the first PART_LEN complex samples,
   // and change signs of the imaginary parts.
   WebRtcSpl_RealForwardFFT(aecm->real_fft, fft, (int16_t*)freq_signal);
-  for (i = 0; i < PART_LEN; i++) {
-    freq_signal[i].imag = -freq_signal[i].imag;
-  }
+  WebRtcAecm_Conjugate(freq_signal, freq_signal);
 }
 
 static void InverseFFTAndWindow(AecmCore* aecm,
@@ -202,40 +353,21 @@ static void InverseFFTAndWindow(AecmCore* aecm,
                                 ComplexInt16* efw,
                                 int16_t* output,
                                 const int16_t* nearendClean) {
-  int i, j, outCFFT;
-  int32_t tmp32no1;
+  int outCFFT;
   // Reuse |efw| for the inverse FFT output after transferring
   // the contents to |fft|.
   int16_t* ifft_out = (int16_t*)efw;
 
   // Synthesis
-  for (i = 1, j = 2; i < PART_LEN; i += 1, j += 2) {
-    fft[j] = efw[i].real;
-    fft[j + 1] = -efw[i].imag;
-  }
-  fft[0] = efw[0].real;
-  fft[1] = -efw[0].imag;
+  WebRtcAecm_Conjugate(efw, (ComplexInt16*)fft);
 
   fft[PART_LEN2] = efw[PART_LEN].real;
   fft[PART_LEN2 + 1] = -efw[PART_LEN].imag;
 
   // Inverse FFT. Keep outCFFT to scale the samples in the next block.
   outCFFT = WebRtcSpl_RealInverseFFT(aecm->real_fft, fft, ifft_out);
-  for (i = 0; i < PART_LEN; i++) {
-    ifft_out[i] = (int16_t)WEBRTC_SPL_MUL_16_16_RSFT_WITH_ROUND(
-        ifft_out[i], WebRtcAecm_kSqrtHanning[i], 14);
-    tmp32no1 = WEBRTC_SPL_SHIFT_W32((int32_t)ifft_out[i],
-                                    outCFFT - aecm->dfaCleanQDomain);
-    output[i] = (int16_t)WEBRTC_SPL_SAT(WEBRTC_SPL_WORD16_MAX,
-                                        tmp32no1 + aecm->outBuf[i],
-                                        WEBRTC_SPL_WORD16_MIN);
-
-    tmp32no1 =
-        (ifft_out[PART_LEN + i] * WebRtcAecm_kSqrtHanning[PART_LEN - i]) >> 14;
-    tmp32no1 = WEBRTC_SPL_SHIFT_W32(tmp32no1, outCFFT - aecm->dfaCleanQDomain);
-    aecm->outBuf[i] = (int16_t)WEBRTC_SPL_SAT(WEBRTC_SPL_WORD16_MAX, tmp32no1,
-                                              WEBRTC_SPL_WORD16_MIN);
-  }
+  WebRtcAecm_WindowAndOverlapAdd(ifft_out, outCFFT - aecm->dfaCleanQDomain,
+                                 aecm->outBuf, output);
 
   // Copy the current block to the old position
   // (aecm->outBuf is shifted elsewhere)
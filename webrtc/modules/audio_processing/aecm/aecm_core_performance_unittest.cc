@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "modules/audio_processing/aecm/aecm_core.h"
+#include "modules/audio_processing/aecm/echo_control_mobile.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 16000;
+constexpr size_t kFrameLength = 160;
+// Number of distinct frames cycled through during the measurement.
+constexpr size_t kNumFrames = 100;
+
+int NumIterations() {
+  const int kNumIterations = 10000;
+  const int kQuickNumIterations = 100;
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumIterations
+                                                        : kNumIterations;
+}
+
+// Measures the cost of processing 10 ms frames of an echoic near end, with the
+// AECM core function pointers set up by WebRtcAecm_Init(), or with the generic
+// C functions for all of them, including the windowing steps of the FFTs, if
+// |use_c_functions| is true, and reports the throughput in frames per second.
+void RunAndReport(bool use_c_functions) {
+  Random random_generator(42U);
+  std::vector<std::vector<int16_t>> far_end(kNumFrames,
+                                            std::vector<int16_t>(kFrameLength));
+  std::vector<std::vector<int16_t>> near_end(
+      kNumFrames, std::vector<int16_t>(kFrameLength));
+  for (size_t k = 0; k < kNumFrames; ++k) {
+    for (size_t j = 0; j < kFrameLength; ++j) {
+      far_end[k][j] = random_generator.Rand(-8000, 8000);
+      // A scaled and delayed copy of the far end, plus some near end noise.
+      near_end[k][j] = (k > 0 ? far_end[k - 1][j] / 2 : 0) +
+                       random_generator.Rand(-500, 500);
+    }
+  }
+  std::vector<int16_t> output(kFrameLength);
+
+  void* aecm = WebRtcAecm_Create();
+  ASSERT_TRUE(aecm);
+  ASSERT_EQ(0, WebRtcAecm_Init(aecm, kSampleRateHz));
+  if (use_c_functions) {
+    WebRtcAecm_CalcLinearEnergies = WebRtcAecm_CalcLinearEnergiesC;
+    WebRtcAecm_StoreAdaptiveChannel = WebRtcAecm_StoreAdaptiveChannelC;
+    WebRtcAecm_ResetAdaptiveChannel = WebRtcAecm_ResetAdaptiveChannelC;
+    WebRtcAecm_WindowTimeSignal = WebRtcAecm_WindowTimeSignalC;
+    WebRtcAecm_Conjugate = WebRtcAecm_ConjugateC;
+    WebRtcAecm_WindowAndOverlapAdd = WebRtcAecm_WindowAndOverlapAddC;
+  }
+
+  const int num_iterations = NumIterations();
+  Clock* clock = Clock::GetRealTimeClock();
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int n = 0; n < num_iterations; ++n) {
+    const size_t k = n % kNumFrames;
+    WebRtcAecm_BufferFarend(aecm, far_end[k].data(), kFrameLength);
+    WebRtcAecm_Process(aecm, near_end[k].data(), nullptr, output.data(),
+                       kFrameLength, 0);
+  }
+  const int64_t runtime_us = clock->TimeInMicroseconds() - start_time_us;
+  WebRtcAecm_Free(aecm);
+  ASSERT_GT(runtime_us, 0);
+  test::PrintResult("aecm_core", use_c_functions ? "_c" : "_default",
+                    "sample_rate_" + std::to_string(kSampleRateHz),
+                    1e6 * num_iterations / runtime_us,
+                    "frames_per_second_per_core", true);
+}
+
+}  // namespace
+
+TEST(AecmCorePerformanceTest, ProcessFrames) {
+  RunAndReport(/*use_c_functions=*/true);
+  RunAndReport(/*use_c_functions=*/false);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aecm/aecm_core.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+
+namespace webrtc {
+
+namespace {
+
+// Computes WEBRTC_SPL_MUL_16_U16(a, b) for the eight signed lanes of |a| and
+// the eight unsigned lanes of |b|, returning the products of the lower and
+// upper four lanes. Unlike the Neon version, which multiplies the lanes of |a|
+// as unsigned, this is bit exact with the C code for negative channel values.
+static inline void MulS16U16(__m128i a,
+                             __m128i b,
+                             __m128i* product_low,
+                             __m128i* product_high) {
+  const __m128i low = _mm_mullo_epi16(a, b);
+  // The unsigned high half, corrected by subtracting |b| where |a| < 0.
+  const __m128i high = _mm_sub_epi16(_mm_mulhi_epu16(a, b),
+                                     _mm_and_si128(_mm_srai_epi16(a, 15), b));
+  *product_low = _mm_unpacklo_epi16(low, high);
+  *product_high = _mm_unpackhi_epi16(low, high);
+}
+
+static inline uint32_t AddLanes(__m128i v) {
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+}
+
+}  // namespace
+
+void WebRtcAecm_CalcLinearEnergiesSse2(AecmCore* aecm,
+                                       const uint16_t* far_spectrum,
+                                       int32_t* echo_est,
+                                       uint32_t* far_energy,
+                                       uint32_t* echo_energy_adapt,
+                                       uint32_t* echo_energy_stored) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i far_energy_v = zero;
+  __m128i echo_adapt_v = zero;
+  __m128i echo_stored_v = zero;
+
+  // Get energy for the delayed far end signal and estimated echo using both
+  // stored and adapted channels, as in WebRtcAecm_CalcLinearEnergiesC(). All
+  // sums wrap modulo 2^32 like the C code, so the lane order does not matter.
+  for (int i = 0; i < PART_LEN; i += 8) {
+    const __m128i spectrum_v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&far_spectrum[i]));
+    const __m128i stored_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelStored[i]));
+    const __m128i adapt_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelAdapt16[i]));
+
+    far_energy_v = _mm_add_epi32(
+        far_energy_v, _mm_add_epi32(_mm_unpacklo_epi16(spectrum_v, zero),
+                                    _mm_unpackhi_epi16(spectrum_v, zero)));
+
+    __m128i echo_est_low;
+    __m128i echo_est_high;
+    MulS16U16(stored_v, spectrum_v, &echo_est_low, &echo_est_high);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i]), echo_est_low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i + 4]),
+                     echo_est_high);
+    echo_stored_v = _mm_add_epi32(
+        echo_stored_v, _mm_add_epi32(echo_est_low, echo_est_high));
+
+    __m128i echo_adapt_low;
+    __m128i echo_adapt_high;
+    MulS16U16(adapt_v, spectrum_v, &echo_adapt_low, &echo_adapt_high);
+    echo_adapt_v = _mm_add_epi32(
+        echo_adapt_v, _mm_add_epi32(echo_adapt_low, echo_adapt_high));
+  }
+
+  *far_energy += AddLanes(far_energy_v);
+  *echo_energy_stored += AddLanes(echo_stored_v);
+  *echo_energy_adapt += AddLanes(echo_adapt_v);
+
+  echo_est[PART_LEN] = WEBRTC_SPL_MUL_16_U16(aecm->channelStored[PART_LEN],
+                                             far_spectrum[PART_LEN]);
+  *echo_energy_stored += (uint32_t)echo_est[PART_LEN];
+  *far_energy += (uint32_t)far_spectrum[PART_LEN];
+  *echo_energy_adapt += aecm->channelAdapt16[PART_LEN] * far_spectrum[PART_LEN];
+}
+
+void WebRtcAecm_StoreAdaptiveChannelSse2(AecmCore* aecm,
+                                         const uint16_t* far_spectrum,
+                                         int32_t* echo_est) {
+  // During startup we store the channel every block, and recalculate the echo
+  // estimate, as in WebRtcAecm_StoreAdaptiveChannelC().
+  for (int i = 0; i < PART_LEN; i += 8) {
+    const __m128i spectrum_v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&far_spectrum[i]));
+    const __m128i adapt_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelAdapt16[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelStored[i]),
+                     adapt_v);
+
+    __m128i echo_est_low;
+    __m128i echo_est_high;
+    MulS16U16(adapt_v, spectrum_v, &echo_est_low, &echo_est_high);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i]), echo_est_low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i + 4]),
+                     echo_est_high);
+  }
+  aecm->channelStored[PART_LEN] = aecm->channelAdapt16[PART_LEN];
+  echo_est[PART_LEN] = WEBRTC_SPL_MUL_16_U16(aecm->channelStored[PART_LEN],
+                                             far_spectrum[PART_LEN]);
+}
+
+void WebRtcAecm_ResetAdaptiveChannelSse2(AecmCore* aecm) {
+  // Reset the adaptive channel to the stored one and restore the W32 channel,
+  // as in WebRtcAecm_ResetAdaptiveChannelC().
+  const __m128i zero = _mm_setzero_si128();
+  for (int i = 0; i < PART_LEN; i += 8) {
+    const __m128i stored_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelStored[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelAdapt16[i]),
+                     stored_v);
+    // Interleaving with zeros below puts each value in the upper half of a
+    // 32-bit lane, i.e., shifts it left by 16.
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelAdapt32[i]),
+                     _mm_unpacklo_epi16(zero, stored_v));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelAdapt32[i + 4]),
+                     _mm_unpackhi_epi16(zero, stored_v));
+  }
+  aecm->channelAdapt16[PART_LEN] = aecm->channelStored[PART_LEN];
+  aecm->channelAdapt32[PART_LEN] = (int32_t)aecm->channelStored[PART_LEN] << 16;
+}
+
+}  // namespace webrtc
+
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
@@ -0,0 +1,208 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aecm/aecm_core.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+constexpr int kNumTrials = 100;
+
+// Returns a random sample, with the extreme values much more likely than in a
+// uniform distribution.
+int16_t RandomSample(Random* random_generator) {
+  switch (random_generator->Rand(0, 7)) {
+    case 0:
+      return -32768;
+    case 1:
+      return 32767;
+    default:
+      return random_generator->Rand<int16_t>();
+  }
+}
+
+// Sets up the channels of |aecm| with random values, and a random far end
+// spectrum in |far_spectrum|.
+void RandomizeChannels(Random* random_generator,
+                       AecmCore* aecm,
+                       uint16_t* far_spectrum) {
+  for (int k = 0; k < PART_LEN1; ++k) {
+    aecm->channelStored[k] = RandomSample(random_generator);
+    aecm->channelAdapt16[k] = RandomSample(random_generator);
+    aecm->channelAdapt32[k] = random_generator->Rand<int32_t>();
+    far_spectrum[k] = random_generator->Rand(0, 7) == 0
+                          ? 65535
+                          : random_generator->Rand<uint16_t>();
+  }
+}
+
+// Copies the channels of |from| to |to|.
+void CopyChannels(const AecmCore* from, AecmCore* to) {
+  for (int k = 0; k < PART_LEN1; ++k) {
+    to->channelStored[k] = from->channelStored[k];
+    to->channelAdapt16[k] = from->channelAdapt16[k];
+    to->channelAdapt32[k] = from->channelAdapt32[k];
+  }
+}
+
+void ExpectEqualChannels(const AecmCore* a, const AecmCore* b) {
+  for (int k = 0; k < PART_LEN1; ++k) {
+    ASSERT_EQ(a->channelStored[k], b->channelStored[k]);
+    ASSERT_EQ(a->channelAdapt16[k], b->channelAdapt16[k]);
+    ASSERT_EQ(a->channelAdapt32[k], b->channelAdapt32[k]);
+  }
+}
+#endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+void FillRandom(Random* random_generator, int16_t* x, size_t length) {
+  for (size_t k = 0; k < length; ++k) {
+    x[k] = RandomSample(random_generator);
+  }
+}
+#endif
+
+}  // namespace
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Verifies that the SSE2 versions of the function pointers give the same
+// output as the C versions, for channels and spectra over the full range.
+TEST(AecmCoreTest, Sse2FunctionsAreBitExact) {
+  Random random_generator(42U);
+  AecmCore* aecm_c = WebRtcAecm_CreateCore();
+  AecmCore* aecm_sse2 = WebRtcAecm_CreateCore();
+  ASSERT_TRUE(aecm_c);
+  ASSERT_TRUE(aecm_sse2);
+  ASSERT_EQ(0, WebRtcAecm_InitCore(aecm_c, 16000));
+  ASSERT_EQ(0, WebRtcAecm_InitCore(aecm_sse2, 16000));
+  uint16_t far_spectrum[PART_LEN1];
+  int32_t echo_est_c[PART_LEN1];
+  int32_t echo_est_sse2[PART_LEN1];
+
+  for (int n = 0; n < kNumTrials; ++n) {
+    RandomizeChannels(&random_generator, aecm_c, far_spectrum);
+    CopyChannels(aecm_c, aecm_sse2);
+    uint32_t far_energy_c = random_generator.Rand<uint32_t>();
+    uint32_t echo_energy_adapt_c = random_generator.Rand<uint32_t>();
+    uint32_t echo_energy_stored_c = random_generator.Rand<uint32_t>();
+    uint32_t far_energy_sse2 = far_energy_c;
+    uint32_t echo_energy_adapt_sse2 = echo_energy_adapt_c;
+    uint32_t echo_energy_stored_sse2 = echo_energy_stored_c;
+    WebRtcAecm_CalcLinearEnergiesC(aecm_c, far_spectrum, echo_est_c,
+                                   &far_energy_c, &echo_energy_adapt_c,
+                                   &echo_energy_stored_c);
+    WebRtcAecm_CalcLinearEnergiesSse2(aecm_sse2, far_spectrum, echo_est_sse2,
+                                      &far_energy_sse2, &echo_energy_adapt_sse2,
+                                      &echo_energy_stored_sse2);
+    EXPECT_EQ(far_energy_c, far_energy_sse2);
+    EXPECT_EQ(echo_energy_adapt_c, echo_energy_adapt_sse2);
+    EXPECT_EQ(echo_energy_stored_c, echo_energy_stored_sse2);
+    for (int k = 0; k < PART_LEN1; ++k) {
+      ASSERT_EQ(echo_est_c[k], echo_est_sse2[k]);
+    }
+
+    RandomizeChannels(&random_generator, aecm_c, far_spectrum);
+    CopyChannels(aecm_c, aecm_sse2);
+    WebRtcAecm_StoreAdaptiveChannelC(aecm_c, far_spectrum, echo_est_c);
+    WebRtcAecm_StoreAdaptiveChannelSse2(aecm_sse2, far_spectrum,
+                                        echo_est_sse2);
+    ExpectEqualChannels(aecm_c, aecm_sse2);
+    for (int k = 0; k < PART_LEN1; ++k) {
+      ASSERT_EQ(echo_est_c[k], echo_est_sse2[k]);
+    }
+
+    RandomizeChannels(&random_generator, aecm_c, far_spectrum);
+    CopyChannels(aecm_c, aecm_sse2);
+    WebRtcAecm_ResetAdaptiveChannelC(aecm_c);
+    WebRtcAecm_ResetAdaptiveChannelSse2(aecm_sse2);
+    ExpectEqualChannels(aecm_c, aecm_sse2);
+  }
+
+  WebRtcAecm_FreeCore(aecm_c);
+  WebRtcAecm_FreeCore(aecm_sse2);
+}
+#endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+// Verifies that the SSE2 windowing steps of the FFTs give the same output as
+// the C versions, for all scalings and shifts in use.
+TEST(AecmCoreTest, Sse2WindowingIsBitExact) {
+  Random random_generator(42U);
+  int16_t time_signal[PART_LEN2];
+  int16_t fft_c[PART_LEN2];
+  int16_t fft_sse2[PART_LEN2];
+  for (int n = 0; n < kNumTrials; ++n) {
+    FillRandom(&random_generator, time_signal, PART_LEN2);
+    for (int scaling = 0; scaling < 16; ++scaling) {
+      WebRtcAecm_WindowTimeSignalC(time_signal, scaling, fft_c);
+      WebRtcAecm_WindowTimeSignalSse2(time_signal, scaling, fft_sse2);
+      for (int k = 0; k < PART_LEN2; ++k) {
+        ASSERT_EQ(fft_c[k], fft_sse2[k]) << "scaling " << scaling;
+      }
+    }
+  }
+
+  // In place, as for the forward FFT, and out of place, as for the inverse.
+  ComplexInt16 in[PART_LEN];
+  ComplexInt16 out_c[PART_LEN];
+  ComplexInt16 out_sse2[PART_LEN];
+  for (int n = 0; n < kNumTrials; ++n) {
+    FillRandom(&random_generator, &in[0].real, PART_LEN2);
+    WebRtcAecm_ConjugateC(in, out_c);
+    WebRtcAecm_ConjugateSse2(in, out_sse2);
+    for (int k = 0; k < PART_LEN; ++k) {
+      ASSERT_EQ(out_c[k].real, out_sse2[k].real);
+      ASSERT_EQ(out_c[k].imag, out_sse2[k].imag);
+    }
+    WebRtcAecm_ConjugateSse2(in, in);
+    for (int k = 0; k < PART_LEN; ++k) {
+      ASSERT_EQ(out_c[k].real, in[k].real);
+      ASSERT_EQ(out_c[k].imag, in[k].imag);
+    }
+  }
+
+  int16_t ifft_out_c[PART_LEN2];
+  int16_t ifft_out_sse2[PART_LEN2];
+  int16_t out_buf_c[PART_LEN];
+  int16_t out_buf_sse2[PART_LEN];
+  int16_t output_c[PART_LEN];
+  int16_t output_sse2[PART_LEN];
+  for (int n = 0; n < kNumTrials; ++n) {
+    for (int shift = -15; shift <= 15; ++shift) {
+      FillRandom(&random_generator, ifft_out_c, PART_LEN2);
+      FillRandom(&random_generator, out_buf_c, PART_LEN);
+      std::copy(ifft_out_c, ifft_out_c + PART_LEN2, ifft_out_sse2);
+      std::copy(out_buf_c, out_buf_c + PART_LEN, out_buf_sse2);
+      WebRtcAecm_WindowAndOverlapAddC(ifft_out_c, shift, out_buf_c, output_c);
+      WebRtcAecm_WindowAndOverlapAddSse2(ifft_out_sse2, shift, out_buf_sse2,
+                                         output_sse2);
+      for (int k = 0; k < PART_LEN; ++k) {
+        ASSERT_EQ(output_c[k], output_sse2[k]) << "shift " << shift;
+        ASSERT_EQ(out_buf_c[k], out_buf_sse2[k]) << "shift " << shift;
+      }
+      // The first half is windowed in place.
+      for (int k = 0; k < PART_LEN; ++k) {
+        ASSERT_EQ(ifft_out_c[k], ifft_out_sse2[k]) << "shift " << shift;
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace webrtc
@@ -22,6 +22,11 @@
 #include <stdlib.h>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 
@@ -138,11 +143,11 @@ int WebRtcAgc_AddMic(void* state,
                      int16_t* const* in_mic,
                      size_t num_bands,
                      size_t samples) {
-  int32_t nrg, max_nrg, sample, tmp32;
+  int32_t tmp32;
   int32_t* ptr;
   uint16_t targetGainIdx, gain;
   size_t i;
-  int16_t n, L, tmp16, tmp_speech[16];
+  int16_t L, tmp16, tmp_speech[16];
   LegacyAgc* stt;
   stt = reinterpret_cast<LegacyAgc*>(state);
 
@@ -183,10 +188,29 @@ int WebRtcAgc_AddMic(void* state,
     /* Q12 */
     gain = kGainTableAnalog[stt->gainTableIdx];
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+    /* All table gains fit in a signed 16-bit value, and the number of
+     * samples checked above is a multiple of 8. */
+    RTC_DCHECK_LE(gain, 32767);
+    RTC_DCHECK_EQ(0, samples % 8);
+    const __m128i gain_v = _mm_set1_epi16(static_cast<int16_t>(gain));
+    for (size_t j = 0; j < num_bands; ++j) {
+      __m128i* in_band = reinterpret_cast<__m128i*>(in_mic[j]);
+      for (i = 0; i < samples / 8; i++) {
+        const __m128i x = _mm_loadu_si128(&in_band[i]);
+        const __m128i lo = _mm_mullo_epi16(x, gain_v);
+        const __m128i hi = _mm_mulhi_epi16(x, gain_v);
+        _mm_storeu_si128(
+            &in_band[i],
+            _mm_packs_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 12),
+                            _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 12)));
+      }
+    }
+#else
     for (i = 0; i < samples; i++) {
       size_t j;
       for (j = 0; j < num_bands; ++j) {
-        sample = (in_mic[j][i] * gain) >> 12;
+        int32_t sample = (in_mic[j][i] * gain) >> 12;
         if (sample > 32767) {
           in_mic[j][i] = 32767;
         } else if (sample < -32768) {
@@ -196,6 +220,7 @@ int WebRtcAgc_AddMic(void* state,
         }
       }
     }
+#endif
   } else {
     stt->gainTableIdx = 0;
   }
@@ -207,17 +232,7 @@ int WebRtcAgc_AddMic(void* state,
     ptr = stt->env[0];
   }
 
-  for (i = 0; i < kNumSubframes; i++) {
-    /* iterate over samples */
-    max_nrg = 0;
-    for (n = 0; n < L; n++) {
-      nrg = in_mic[0][i * L + n] * in_mic[0][i * L + n];
-      if (nrg > max_nrg) {
-        max_nrg = nrg;
-      }
-    }
-    ptr[i] = max_nrg;
-  }
+  WebRtcAgc_ComputeEnvelope(in_mic[0], L, ptr);
 
   /* compute energy */
   if (stt->inQueue > 0) {
@@ -1001,6 +1016,34 @@ int WebRtcAgc_Process(const void* agcInst,
   return WebRtcAgc_ApplyDigitalGains(gains, num_bands, stt->fs, in_near, out);
 }
 
+int WebRtcAgc_AnalyzeAndProcessBatch(void* const* agcInsts,
+                                     size_t num_instances,
+                                     const int16_t* const* const* in_near,
+                                     size_t num_bands,
+                                     size_t samples,
+                                     const int32_t* inMicLevels,
+                                     int32_t* outMicLevels,
+                                     const int16_t* echo,
+                                     uint8_t* saturationWarnings,
+                                     int16_t* const* const* out) {
+  int32_t gains[11];
+  size_t i;
+
+  for (i = 0; i < num_instances; i++) {
+    if (WebRtcAgc_Analyze(agcInsts[i], in_near[i], num_bands, samples,
+                          inMicLevels[i], &outMicLevels[i], echo[i],
+                          &saturationWarnings[i], gains) != 0) {
+      return -1;
+    }
+    if (WebRtcAgc_Process(agcInsts[i], gains, in_near[i], num_bands,
+                          out[i]) != 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
 int WebRtcAgc_set_config(void* agcInst, WebRtcAgcConfig agcConfig) {
   LegacyAgc* stt;
   stt = reinterpret_cast<LegacyAgc*>(agcInst);
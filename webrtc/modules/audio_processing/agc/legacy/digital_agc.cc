@@ -12,8 +12,15 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 #include "modules/audio_processing/agc/legacy/gain_control.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 
@@ -57,10 +64,39 @@ static const int16_t kAvgDecayTime = 250;  // frames; < 3000
 
 // the 32 most significant bits of A(19) * B(26) >> 13
 #define AGC_MUL32(A, B) (((B) >> 13) * (A) + (((0x00001FFF & (B)) * (A)) >> 13))
+
 // C + the 32 most significant bits of A * B
 #define AGC_SCALEDIFF32(A, B, C) \
   ((C) + ((B) >> 16) * (A) + (((0x0000FFFF & (B)) * (A)) >> 16))
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+// Applies the gains |gain_high| * 2^16 + |gain_low| to the eight samples of
+// |x| as ((int64_t)x * gain) >> 16, saturated to 16 bits. |gain_low| holds the
+// unsigned lower 16 bits of the gains, and |gain_high| the signed upper bits,
+// which fit in 16 bits for any gain32 >> 4.
+__m128i ApplyGainSse2(__m128i x, __m128i gain_high, __m128i gain_low) {
+  // x * gain_high, which is exact in 32 bits.
+  const __m128i high_lo = _mm_mullo_epi16(x, gain_high);
+  const __m128i high_hi = _mm_mulhi_epi16(x, gain_high);
+  // (x * gain_low) >> 16, with the signed high half of the product of a
+  // signed and an unsigned value.
+  const __m128i low_hi =
+      _mm_sub_epi16(_mm_mulhi_epu16(x, gain_low),
+                    _mm_and_si128(_mm_srai_epi16(x, 15), gain_low));
+  const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(low_hi, low_hi), 16);
+  const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(low_hi, low_hi), 16);
+  return _mm_packs_epi32(
+      _mm_add_epi32(_mm_unpacklo_epi16(high_lo, high_hi), low),
+      _mm_add_epi32(_mm_unpackhi_epi16(high_lo, high_hi), high));
+}
+
+// Returns the lower 16 bits of each of the eight 32-bit values in |a| and |b|.
+__m128i PackLow16(__m128i a, __m128i b) {
+  return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                         _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+}
+#endif
+
 }  // namespace
 
 int32_t WebRtcAgc_CalculateGainTable(int32_t* gainTable,       // Q16
@@ -284,7 +320,6 @@ int32_t WebRtcAgc_ComputeDigitalGains(DigitalAgc* stt,
                                       int32_t gains[11]) {
   int32_t tmp32;
   int32_t env[10];
-  int32_t max_nrg;
   int32_t cur_level;
   int32_t gain32;
   int16_t logratio;
@@ -293,7 +328,7 @@ int32_t WebRtcAgc_ComputeDigitalGains(DigitalAgc* stt,
   int16_t decay;
   int16_t gate, gain_adj;
   int16_t k;
-  size_t n, L;
+  size_t L;
   int16_t L2;  // samples/subframe
 
   // determine number of samples per ms
@@ -351,18 +386,7 @@ int32_t WebRtcAgc_ComputeDigitalGains(DigitalAgc* stt,
     }
   }
   // Find max amplitude per sub frame
-  // iterate over sub frames
-  for (k = 0; k < 10; k++) {
-    // iterate over samples
-    max_nrg = 0;
-    for (n = 0; n < L; n++) {
-      int32_t nrg = in_near[0][k * L + n] * in_near[0][k * L + n];
-      if (nrg > max_nrg) {
-        max_nrg = nrg;
-      }
-    }
-    env[k] = max_nrg;
-  }
+  WebRtcAgc_ComputeEnvelope(in_near[0], L, env);
 
   // Calculate gain per sub frame
   gains[0] = stt->gain;
@@ -530,6 +554,38 @@ int32_t WebRtcAgc_ApplyDigitalGains(const int32_t gains[11],
     gain32 += delta;
   }
   // iterate over subframes
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+  // Interpolate the gains of the remaining subframes once, split into the
+  // upper and lower 16 bits of gain32 >> 4, and apply them to all bands.
+  const size_t num_vectors = 9 * L / 8;
+  __m128i gain_high[18];
+  __m128i gain_low[18];
+  RTC_DCHECK_LE(num_vectors, 18);
+  for (size_t k = 1, m = 0; k < 10; k++) {
+    delta = (gains[k + 1] - gains[k]) * (1 << (4 - L2));
+    const __m128i delta4 = _mm_set1_epi32(4 * delta);
+    gain32 = gains[k] * (1 << 4);
+    __m128i gain32_a = _mm_setr_epi32(gain32, gain32 + delta,
+                                      gain32 + 2 * delta, gain32 + 3 * delta);
+    for (size_t n = 0; n < L; n += 8, m++) {
+      const __m128i gain32_b = _mm_add_epi32(gain32_a, delta4);
+      const __m128i gain_a = _mm_srai_epi32(gain32_a, 4);
+      const __m128i gain_b = _mm_srai_epi32(gain32_b, 4);
+      gain_high[m] = _mm_packs_epi32(_mm_srai_epi32(gain_a, 16),
+                                     _mm_srai_epi32(gain_b, 16));
+      gain_low[m] = PackLow16(gain_a, gain_b);
+      gain32_a = _mm_add_epi32(gain32_b, delta4);
+    }
+  }
+  for (size_t i = 0; i < num_bands; ++i) {
+    __m128i* out_band = reinterpret_cast<__m128i*>(&out[i][L]);
+    for (size_t m = 0; m < num_vectors; m++) {
+      _mm_storeu_si128(&out_band[m],
+                       ApplyGainSse2(_mm_loadu_si128(&out_band[m]),
+                                     gain_high[m], gain_low[m]));
+    }
+  }
+#else
   for (int k = 1; k < 10; k++) {
     delta = (gains[k + 1] - gains[k]) * (1 << (4 - L2));
     gain32 = gains[k] * (1 << 4);
@@ -549,9 +605,52 @@ int32_t WebRtcAgc_ApplyDigitalGains(const int32_t gains[11],
       gain32 += delta;
     }
   }
+#endif
   return 0;
 }
 
+void WebRtcAgc_ComputeEnvelope(const int16_t* in,
+                               size_t subframe_length,
+                               int32_t env[10]) {
+  const size_t L = subframe_length;
+  // iterate over sub frames
+  for (size_t k = 0; k < 10; k++) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+    // The largest squared sample is that of the largest or of the smallest
+    // sample.
+    RTC_DCHECK_EQ(0, L % 8);
+    __m128i max_v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    __m128i min_v = max_v;
+    for (size_t n = 8; n < L; n += 8) {
+      const __m128i x =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[n]));
+      max_v = _mm_max_epi16(max_v, x);
+      min_v = _mm_min_epi16(min_v, x);
+    }
+    max_v = _mm_max_epi16(max_v, _mm_shuffle_epi32(max_v, 0x4E));
+    min_v = _mm_min_epi16(min_v, _mm_shuffle_epi32(min_v, 0x4E));
+    max_v = _mm_max_epi16(max_v, _mm_shuffle_epi32(max_v, 0xB1));
+    min_v = _mm_min_epi16(min_v, _mm_shuffle_epi32(min_v, 0xB1));
+    max_v = _mm_max_epi16(max_v, _mm_srli_epi32(max_v, 16));
+    min_v = _mm_min_epi16(min_v, _mm_srli_epi32(min_v, 16));
+    const int32_t max_sample = static_cast<int16_t>(_mm_cvtsi128_si32(max_v));
+    const int32_t min_sample = static_cast<int16_t>(_mm_cvtsi128_si32(min_v));
+    env[k] = std::max(max_sample * max_sample, min_sample * min_sample);
+#else
+    // iterate over samples
+    int32_t max_nrg = 0;
+    for (size_t n = 0; n < L; n++) {
+      int32_t nrg = in[n] * in[n];
+      if (nrg > max_nrg) {
+        max_nrg = nrg;
+      }
+    }
+    env[k] = max_nrg;
+#endif
+    in += L;
+  }
+}
+
 void WebRtcAgc_InitVad(AgcVad* state) {
   int16_t k;
 
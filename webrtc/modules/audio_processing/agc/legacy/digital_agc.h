@@ -54,6 +54,12 @@ int32_t WebRtcAgc_ApplyDigitalGains(const int32_t gains[11],
                                     const int16_t* const* in_near,
                                     int16_t* const* out);
 
+// Computes the envelope |env| of the 10 subframes of |subframe_length|
+// samples in |in|, as the largest squared sample of each subframe.
+void WebRtcAgc_ComputeEnvelope(const int16_t* in,
+                               size_t subframe_length,
+                               int32_t env[10]);
+
 int32_t WebRtcAgc_AddFarendToDigital(DigitalAgc* digitalAgcInst,
                                      const int16_t* inFar,
                                      size_t nrSamples);
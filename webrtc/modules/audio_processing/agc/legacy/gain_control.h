@@ -180,6 +180,48 @@ int WebRtcAgc_Process(const void* agcInst,
                       size_t num_bands,
                       int16_t* const* out);
 
+/*
+ * This function runs WebRtcAgc_Analyze() and then WebRtcAgc_Process() with
+ * the resulting gains on a 10 ms frame for each of a number of AGC instances,
+ * e.g., one per stream. Each instance is completely processed before the next
+ * one, while its frame is still in the cache. All instances must have the same
+ * number of bands and samples.
+ *
+ * Input:
+ *      - agcInsts           : AGC instances
+ *      - num_instances      : Number of AGC instances
+ *      - in_near            : Near-end input speech vector for each band, for
+ *                             each instance
+ *      - num_bands          : Number of bands in input/output vectors
+ *      - samples            : Number of samples in input/output vectors
+ *      - inMicLevels        : Current microphone volume level per instance
+ *      - echo               : Echo indication per instance, as in
+ *                             WebRtcAgc_Analyze()
+ *
+ * Output:
+ *      - outMicLevels       : Adjusted microphone volume level per instance
+ *      - saturationWarnings : Saturation warning per instance, as in
+ *                             WebRtcAgc_Analyze()
+ *      - out                : Gain-adjusted near-end speech vector for each
+ *                             band, for each instance
+ *                           : May be the same vectors as the input.
+ *
+ * Return value:
+ *                           :  0 - Normal operation.
+ *                           : -1 - Error. The instances after the first one
+ *                                  that failed are not processed.
+ */
+int WebRtcAgc_AnalyzeAndProcessBatch(void* const* agcInsts,
+                                     size_t num_instances,
+                                     const int16_t* const* const* in_near,
+                                     size_t num_bands,
+                                     size_t samples,
+                                     const int32_t* inMicLevels,
+                                     int32_t* outMicLevels,
+                                     const int16_t* echo,
+                                     uint8_t* saturationWarnings,
+                                     int16_t* const* const* out);
+
 /*
  * This function sets the config parameters (targetLevelDbfs,
  * compressionGaindB and limiterEnable).
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "modules/audio_processing/agc/legacy/gain_control.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumInstances = 16;
+constexpr size_t kFrameLength = 160;
+
+int NumIterations() {
+  const int kNumIterations = 2000;
+  const int kQuickNumIterations = 20;
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumIterations
+                                                        : kNumIterations;
+}
+
+// Measures the cost of analyzing and processing 10 ms frames of
+// |kNumInstances| legacy AGC instances in adaptive digital mode with
+// WebRtcAgc_AnalyzeAndProcessBatch(), and reports the throughput in frames per
+// second, summed over the instances.
+void RunAndReport(int sample_rate_hz) {
+  const size_t num_bands = sample_rate_hz <= 16000 ? 1 : sample_rate_hz / 16000;
+  Random random_generator(42U);
+
+  std::vector<void*> agcs(kNumInstances);
+  std::vector<std::vector<int16_t>> audio(kNumInstances * num_bands,
+                                          std::vector<int16_t>(kFrameLength));
+  std::vector<std::vector<const int16_t*>> in(kNumInstances);
+  std::vector<std::vector<int16_t*>> out(kNumInstances);
+  std::vector<const int16_t* const*> in_ptrs(kNumInstances);
+  std::vector<int16_t* const*> out_ptrs(kNumInstances);
+  for (size_t i = 0; i < kNumInstances; ++i) {
+    agcs[i] = WebRtcAgc_Create();
+    ASSERT_TRUE(agcs[i]);
+    ASSERT_EQ(0, WebRtcAgc_Init(agcs[i], 0, 255, kAgcModeAdaptiveDigital,
+                                sample_rate_hz));
+    for (size_t b = 0; b < num_bands; ++b) {
+      in[i].push_back(audio[i * num_bands + b].data());
+      out[i].push_back(audio[i * num_bands + b].data());
+    }
+    in_ptrs[i] = in[i].data();
+    out_ptrs[i] = out[i].data();
+  }
+  std::vector<int32_t> in_levels(kNumInstances, 0);
+  std::vector<int32_t> out_levels(kNumInstances);
+  std::vector<int16_t> echo(kNumInstances, 0);
+  std::vector<uint8_t> saturation_warnings(kNumInstances);
+
+  const int num_iterations = NumIterations();
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t runtime_us = 0;
+  for (int n = 0; n < num_iterations; ++n) {
+    // Fresh speech-like levels every frame, so that the gains keep adapting.
+    const int amplitude = 1000 + random_generator.Rand(0, 20000);
+    for (auto& band : audio) {
+      for (auto& sample : band) {
+        sample = random_generator.Rand(-amplitude, amplitude);
+      }
+    }
+    const int64_t start_time_us = clock->TimeInMicroseconds();
+    ASSERT_EQ(0, WebRtcAgc_AnalyzeAndProcessBatch(
+                     agcs.data(), kNumInstances, in_ptrs.data(), num_bands,
+                     kFrameLength, in_levels.data(), out_levels.data(),
+                     echo.data(), saturation_warnings.data(), out_ptrs.data()));
+    runtime_us += clock->TimeInMicroseconds() - start_time_us;
+  }
+
+  for (void* agc : agcs) {
+    WebRtcAgc_Free(agc);
+  }
+  ASSERT_GT(runtime_us, 0);
+  test::PrintResult("legacy_agc", "_adaptive_digital",
+                    "sample_rate_" + std::to_string(sample_rate_hz),
+                    1e6 * num_iterations * kNumInstances / runtime_us,
+                    "frames_per_second_per_core", true);
+}
+
+}  // namespace
+
+TEST(LegacyAgcPerformanceTest, AnalyzeAndProcessBatch) {
+  for (int sample_rate_hz : {16000, 32000, 48000}) {
+    RunAndReport(sample_rate_hz);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "modules/audio_processing/agc/legacy/digital_agc.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumTrials = 1000;
+
+// Returns a random sample, with the extreme values much more likely than in a
+// uniform distribution.
+int16_t RandomSample(Random* random_generator) {
+  switch (random_generator->Rand(0, 7)) {
+    case 0:
+      return -32768;
+    case 1:
+      return 32767;
+    default:
+      return random_generator->Rand<int16_t>();
+  }
+}
+
+// Scalar reference for WebRtcAgc_ComputeEnvelope().
+void ComputeEnvelopeReference(const int16_t* in, size_t L, int32_t env[10]) {
+  for (size_t k = 0; k < 10; k++) {
+    int32_t max_nrg = 0;
+    for (size_t n = 0; n < L; n++) {
+      int32_t nrg = in[k * L + n] * in[k * L + n];
+      if (nrg > max_nrg) {
+        max_nrg = nrg;
+      }
+    }
+    env[k] = max_nrg;
+  }
+}
+
+// Scalar reference for WebRtcAgc_ApplyDigitalGains(), in place on |out|.
+void ApplyDigitalGainsReference(const int32_t gains[11],
+                                size_t L,
+                                std::vector<std::vector<int16_t>>* out) {
+  const int16_t L2 = L == 8 ? 3 : 4;
+  int32_t delta = (gains[1] - gains[0]) * (1 << (4 - L2));
+  int32_t gain32 = gains[0] * (1 << 4);
+  for (size_t n = 0; n < L; n++) {
+    for (auto& band : *out) {
+      int32_t out_tmp = (int64_t)band[n] * ((gain32 + 127) >> 7) >> 16;
+      if (out_tmp > 4095) {
+        band[n] = 32767;
+      } else if (out_tmp < -4096) {
+        band[n] = -32768;
+      } else {
+        band[n] = (int16_t)(((int64_t)band[n] * (gain32 >> 4)) >> 16);
+      }
+    }
+    gain32 += delta;
+  }
+  for (size_t k = 1; k < 10; k++) {
+    delta = (gains[k + 1] - gains[k]) * (1 << (4 - L2));
+    gain32 = gains[k] * (1 << 4);
+    for (size_t n = 0; n < L; n++) {
+      for (auto& band : *out) {
+        int64_t tmp64 = ((int64_t)band[k * L + n] * (gain32 >> 4)) >> 16;
+        if (tmp64 > 32767) {
+          band[k * L + n] = 32767;
+        } else if (tmp64 < -32768) {
+          band[k * L + n] = -32768;
+        } else {
+          band[k * L + n] = (int16_t)tmp64;
+        }
+      }
+      gain32 += delta;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(LegacyAgcTest, ComputeEnvelopeMatchesScalarReference) {
+  Random random_generator(42U);
+  for (size_t subframe_length : {8, 16}) {
+    std::vector<int16_t> in(10 * subframe_length);
+    for (int n = 0; n < kNumTrials; ++n) {
+      // Vary the level, so that the smallest or the largest sample may give
+      // the envelope.
+      const int amplitude = random_generator.Rand(0, 32767);
+      for (auto& sample : in) {
+        sample = random_generator.Rand(0, 15) == 0
+                     ? RandomSample(&random_generator)
+                     : random_generator.Rand(-amplitude, amplitude);
+      }
+      int32_t env[10];
+      int32_t env_reference[10];
+      WebRtcAgc_ComputeEnvelope(in.data(), subframe_length, env);
+      ComputeEnvelopeReference(in.data(), subframe_length, env_reference);
+      for (size_t k = 0; k < 10; ++k) {
+        ASSERT_EQ(env_reference[k], env[k]);
+      }
+    }
+  }
+
+  // Full scale negative samples only.
+  std::vector<int16_t> in(160, -32768);
+  int32_t env[10];
+  WebRtcAgc_ComputeEnvelope(in.data(), 16, env);
+  for (size_t k = 0; k < 10; ++k) {
+    EXPECT_EQ(1 << 30, env[k]);
+  }
+}
+
+TEST(LegacyAgcTest, ApplyDigitalGainsMatchesScalarReference) {
+  Random random_generator(42U);
+  for (uint32_t sample_rate_hz : {8000, 16000, 32000, 48000}) {
+    const size_t L = sample_rate_hz == 8000 ? 8 : 16;
+    const size_t num_bands =
+        sample_rate_hz <= 16000 ? 1 : sample_rate_hz / 16000;
+    std::vector<std::vector<int16_t>> in(num_bands,
+                                         std::vector<int16_t>(10 * L));
+    std::vector<std::vector<int16_t>> out(in);
+    std::vector<std::vector<int16_t>> out_reference(in);
+    std::vector<const int16_t*> in_ptrs(num_bands);
+    std::vector<int16_t*> out_ptrs(num_bands);
+    for (size_t i = 0; i < num_bands; ++i) {
+      in_ptrs[i] = in[i].data();
+      out_ptrs[i] = out[i].data();
+    }
+    for (int n = 0; n < kNumTrials; ++n) {
+      for (auto& band : in) {
+        for (auto& sample : band) {
+          sample = RandomSample(&random_generator);
+        }
+      }
+      // Q16 gains from far below unity up to 2^10, where all but the smallest
+      // samples saturate. Every fourth frame has a constant gain.
+      int32_t gains[11];
+      for (auto& gain : gains) {
+        const int max_gain = 1 << random_generator.Rand(0, 26);
+        gain = random_generator.Rand(0, 3) == 0
+                   ? 1 << 26
+                   : random_generator.Rand(0, max_gain);
+      }
+      if (n % 4 == 0) {
+        for (auto& gain : gains) {
+          gain = gains[0];
+        }
+      }
+      out_reference = in;
+      ApplyDigitalGainsReference(gains, L, &out_reference);
+      ASSERT_EQ(0,
+                WebRtcAgc_ApplyDigitalGains(gains, num_bands, sample_rate_hz,
+                                            in_ptrs.data(), out_ptrs.data()));
+      for (size_t i = 0; i < num_bands; ++i) {
+        for (size_t k = 0; k < 10 * L; ++k) {
+          ASSERT_EQ(out_reference[i][k], out[i][k])
+              << "sample rate " << sample_rate_hz << ", band " << i
+              << ", sample " << k;
+        }
+      }
+    }
+  }
+}
+
+// Verifies that the gains may be applied in place.
+TEST(LegacyAgcTest, ApplyDigitalGainsInPlace) {
+  Random random_generator(42U);
+  std::vector<std::vector<int16_t>> audio(1, std::vector<int16_t>(160));
+  for (auto& sample : audio[0]) {
+    sample = RandomSample(&random_generator);
+  }
+  std::vector<std::vector<int16_t>> out_reference(audio);
+  int32_t gains[11];
+  for (auto& gain : gains) {
+    gain = random_generator.Rand(0, 1 << 20);
+  }
+  ApplyDigitalGainsReference(gains, 16, &out_reference);
+  int16_t* audio_ptr = audio[0].data();
+  ASSERT_EQ(0, WebRtcAgc_ApplyDigitalGains(gains, 1, 16000, &audio_ptr,
+                                           &audio_ptr));
+  EXPECT_EQ(out_reference, audio);
+}
+
+}  // namespace webrtc
@@ -294,10 +294,8 @@ void AudioBuffer::CopyFrom(const int16_t* const interleaved_data,
                                        buffer_num_frames_);
       }
     } else {
-      for (size_t i = 0; i < num_channels_; ++i) {
-        deinterleave_channel(i, num_channels_, input_num_frames_, interleaved,
-                             data_->channels()[i]);
-      }
+      DeinterleaveS16ToFloatS16(interleaved, input_num_frames_, num_channels_,
+                                data_->channels());
     }
   }
 }
@@ -323,9 +321,7 @@ void AudioBuffer::CopyTo(const StreamConfig& stream_config,
         resampling_required ? float_buffer.data() : data_->channels()[0];
 
     if (config_num_channels == 1) {
-      for (size_t j = 0; j < output_num_frames_; ++j) {
-        interleaved[j] = FloatS16ToS16(deinterleaved[j]);
-      }
+      FloatS16ToS16(deinterleaved, output_num_frames_, interleaved);
     } else {
       for (size_t i = 0, k = 0; i < output_num_frames_; ++i) {
         float tmp = FloatS16ToS16(deinterleaved[i]);
@@ -353,6 +349,9 @@ void AudioBuffer::CopyTo(const StreamConfig& stream_config,
         interleave_channel(i, config_num_channels, output_num_frames_,
                            float_buffer.data(), interleaved);
       }
+    } else if (config_num_channels == num_channels_) {
+      InterleaveFloatS16ToS16(data_->channels(), output_num_frames_,
+                              num_channels_, interleaved);
     } else {
       for (size_t i = 0; i < num_channels_; ++i) {
         interleave_channel(i, config_num_channels, output_num_frames_,
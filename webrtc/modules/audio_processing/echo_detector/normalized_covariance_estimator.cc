@@ -12,7 +12,14 @@
 
 #include <math.h>
 
+#include <algorithm>
+
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 namespace {
@@ -22,22 +29,93 @@ constexpr float kAlpha = 0.001f;
 
 }  // namespace
 
-void NormalizedCovarianceEstimator::Update(float x,
-                                           float x_mean,
-                                           float x_sigma,
-                                           float y,
-                                           float y_mean,
-                                           float y_sigma) {
-  covariance_ =
-      (1.f - kAlpha) * covariance_ + kAlpha * (x - x_mean) * (y - y_mean);
-  normalized_cross_correlation_ = covariance_ / (x_sigma * y_sigma + .0001f);
-  RTC_DCHECK(isfinite(covariance_));
-  RTC_DCHECK(isfinite(normalized_cross_correlation_));
+NormalizedCovarianceEstimator::NormalizedCovarianceEstimator(
+    size_t num_estimators)
+    : covariance_(num_estimators, 0.f) {}
+
+NormalizedCovarianceEstimator::~NormalizedCovarianceEstimator() = default;
+
+void NormalizedCovarianceEstimator::Update(
+    float x,
+    float x_mean,
+    float x_sigma,
+    rtc::ArrayView<const float> y,
+    rtc::ArrayView<const float> y_mean,
+    rtc::ArrayView<const float> y_sigma) {
+  const size_t num_estimators = covariance_.size();
+  RTC_DCHECK_EQ(num_estimators, y.size());
+  RTC_DCHECK_EQ(num_estimators, y_mean.size());
+  RTC_DCHECK_EQ(num_estimators, y_sigma.size());
+  // The operations below are ordered as in the scalar loop, so that all paths
+  // give identical estimates.
+  const float x_diff = kAlpha * (x - x_mean);
+  float max_correlation = 0.f;
+  int max_index = -1;
+  size_t k = 0;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+  const __m128 one_minus_alpha = _mm_set1_ps(1.f - kAlpha);
+  const __m128 x_diff_v = _mm_set1_ps(x_diff);
+  const __m128 x_sigma_v = _mm_set1_ps(x_sigma);
+  const __m128 epsilon = _mm_set1_ps(.0001f);
+  const __m128i four = _mm_set1_epi32(4);
+  // Each lane tracks the first largest correlation among the estimates with
+  // indices equal to the lane modulo four.
+  __m128 max_v = _mm_setzero_ps();
+  __m128i max_index_v = _mm_set1_epi32(-1);
+  __m128i index_v = _mm_setr_epi32(0, 1, 2, 3);
+  for (; k + 4 <= num_estimators; k += 4) {
+    __m128 covariance = _mm_loadu_ps(&covariance_[k]);
+    const __m128 y_diff =
+        _mm_sub_ps(_mm_loadu_ps(&y[k]), _mm_loadu_ps(&y_mean[k]));
+    covariance = _mm_add_ps(_mm_mul_ps(one_minus_alpha, covariance),
+                            _mm_mul_ps(x_diff_v, y_diff));
+    _mm_storeu_ps(&covariance_[k], covariance);
+    const __m128 correlation = _mm_div_ps(
+        covariance,
+        _mm_add_ps(_mm_mul_ps(x_sigma_v, _mm_loadu_ps(&y_sigma[k])), epsilon));
+    const __m128 is_larger = _mm_cmpgt_ps(correlation, max_v);
+    max_v = _mm_or_ps(_mm_and_ps(is_larger, correlation),
+                      _mm_andnot_ps(is_larger, max_v));
+    const __m128i is_larger_i = _mm_castps_si128(is_larger);
+    max_index_v = _mm_or_si128(_mm_and_si128(is_larger_i, index_v),
+                               _mm_andnot_si128(is_larger_i, max_index_v));
+    index_v = _mm_add_epi32(index_v, four);
+  }
+  float max_lanes[4];
+  int max_index_lanes[4];
+  _mm_storeu_ps(max_lanes, max_v);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(max_index_lanes), max_index_v);
+  for (int lane = 0; lane < 4; ++lane) {
+    if (max_lanes[lane] > max_correlation ||
+        (max_lanes[lane] == max_correlation && max_index_lanes[lane] >= 0 &&
+         max_index_lanes[lane] < max_index)) {
+      max_correlation = max_lanes[lane];
+      max_index = max_index_lanes[lane];
+    }
+  }
+#endif
+
+  for (; k < num_estimators; ++k) {
+    covariance_[k] =
+        (1.f - kAlpha) * covariance_[k] + x_diff * (y[k] - y_mean[k]);
+    const float correlation =
+        covariance_[k] / (x_sigma * y_sigma[k] + .0001f);
+    if (correlation > max_correlation) {
+      max_correlation = correlation;
+      max_index = static_cast<int>(k);
+    }
+  }
+
+  max_normalized_cross_correlation_ = max_correlation;
+  max_index_ = max_index;
+  RTC_DCHECK(isfinite(max_normalized_cross_correlation_));
 }
 
 void NormalizedCovarianceEstimator::Clear() {
-  covariance_ = 0.f;
-  normalized_cross_correlation_ = 0.f;
+  std::fill(covariance_.begin(), covariance_.end(), 0.f);
+  max_normalized_cross_correlation_ = 0.f;
+  max_index_ = -1;
 }
 
 }  // namespace webrtc
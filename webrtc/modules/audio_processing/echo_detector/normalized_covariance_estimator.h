@@ -11,31 +11,50 @@
 #ifndef MODULES_AUDIO_PROCESSING_ECHO_DETECTOR_NORMALIZED_COVARIANCE_ESTIMATOR_H_
 #define MODULES_AUDIO_PROCESSING_ECHO_DETECTOR_NORMALIZED_COVARIANCE_ESTIMATOR_H_
 
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
 namespace webrtc {
 
-// This class iteratively estimates the normalized covariance between two
-// signals.
+// This class iteratively estimates the normalized covariance between a signal
+// x and each signal in a bank of signals y_k, e.g., differently delayed
+// versions of another signal. The estimates are stored contiguously and are
+// all updated in a single pass, which also finds the largest one.
 class NormalizedCovarianceEstimator {
  public:
+  explicit NormalizedCovarianceEstimator(size_t num_estimators);
+  ~NormalizedCovarianceEstimator();
+
+  // Updates estimate k with |x| and |y[k]|, using the means and standard
+  // deviations of the signals, for all k.
   void Update(float x,
               float x_mean,
-              float x_var,
-              float y,
-              float y_mean,
-              float y_var);
-  // This function returns an estimate of the Pearson product-moment correlation
-  // coefficient of the two signals.
-  float normalized_cross_correlation() const {
-    return normalized_cross_correlation_;
+              float x_sigma,
+              rtc::ArrayView<const float> y,
+              rtc::ArrayView<const float> y_mean,
+              rtc::ArrayView<const float> y_sigma);
+  // This function returns the largest positive estimate of the Pearson
+  // product-moment correlation coefficient of the signals, or zero if there is
+  // none.
+  float max_normalized_cross_correlation() const {
+    return max_normalized_cross_correlation_;
   }
-  float covariance() const { return covariance_; }
+  // Returns the index of the first estimate with the largest positive
+  // correlation coefficient, or -1 if there is none.
+  int max_index() const { return max_index_; }
+  float covariance(size_t k) const { return covariance_[k]; }
+  size_t size() const { return covariance_.size(); }
   // This function resets the estimated values to zero.
   void Clear();
 
  private:
-  float normalized_cross_correlation_ = 0.f;
-  // Estimate of the covariance value.
-  float covariance_ = 0.f;
+  float max_normalized_cross_correlation_ = 0.f;
+  int max_index_ = -1;
+  // Estimates of the covariance values.
+  std::vector<float> covariance_;
 };
 
 }  // namespace webrtc
@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "modules/audio_processing/echo_detector/normalized_covariance_estimator.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+// Number of distinct sets of signals cycled through during the measurement.
+constexpr size_t kNumSignals = 16;
+
+int NumIterations() {
+  const int kNumIterations = 100000;
+  const int kQuickNumIterations = 1000;
+  return field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumIterations
+                                                        : kNumIterations;
+}
+
+// Measures the cost of updating a bank of |num_estimators| estimates and
+// finding the largest one, as the residual echo detector does once per
+// capture frame, and reports the throughput in updates per second.
+void RunAndReport(size_t num_estimators) {
+  Random random_generator(42U);
+  std::vector<std::vector<float>> y(kNumSignals,
+                                    std::vector<float>(num_estimators));
+  std::vector<std::vector<float>> y_mean(kNumSignals,
+                                         std::vector<float>(num_estimators));
+  std::vector<std::vector<float>> y_sigma(kNumSignals,
+                                          std::vector<float>(num_estimators));
+  for (size_t n = 0; n < kNumSignals; ++n) {
+    for (size_t k = 0; k < num_estimators; ++k) {
+      y[n][k] = random_generator.Rand<float>();
+      y_mean[n][k] = 0.5f * random_generator.Rand<float>();
+      y_sigma[n][k] = random_generator.Rand<float>();
+    }
+  }
+  NormalizedCovarianceEstimator estimator(num_estimators);
+
+  const int num_iterations = NumIterations();
+  Clock* clock = Clock::GetRealTimeClock();
+  const int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int i = 0; i < num_iterations; ++i) {
+    const size_t n = i % kNumSignals;
+    estimator.Update(y[n][0], 0.5f, 0.3f, y[n], y_mean[n], y_sigma[n]);
+  }
+  const int64_t runtime_us = clock->TimeInMicroseconds() - start_time_us;
+  ASSERT_GT(runtime_us, 0);
+  // Keep the compiler from removing the updates.
+  EXPECT_GE(estimator.max_index(), -1);
+  test::PrintResult("normalized_covariance_estimator", "",
+                    std::to_string(num_estimators) + "_estimators",
+                    1e6 * num_iterations / runtime_us, "updates_per_second",
+                    true);
+}
+
+}  // namespace
+
+// The residual echo detector uses 650 estimators.
+TEST(NormalizedCovarianceEstimatorPerformanceTest, Update) {
+  for (size_t num_estimators : {650, 651}) {
+    RunAndReport(num_estimators);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,179 @@
+/*
+ *  Copyright (c) 2020 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/echo_detector/normalized_covariance_estimator.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr float kAlpha = 0.001f;
+
+// Scalar reference, with one independently updated estimator per lag, as
+// before the estimates were kept in a bank.
+class ReferenceEstimators {
+ public:
+  explicit ReferenceEstimators(size_t num_estimators)
+      : covariance_(num_estimators, 0.f) {}
+
+  void Update(float x,
+              float x_mean,
+              float x_sigma,
+              const std::vector<float>& y,
+              const std::vector<float>& y_mean,
+              const std::vector<float>& y_sigma) {
+    max_normalized_cross_correlation_ = 0.f;
+    max_index_ = -1;
+    for (size_t k = 0; k < covariance_.size(); ++k) {
+      covariance_[k] = (1.f - kAlpha) * covariance_[k] +
+                       kAlpha * (x - x_mean) * (y[k] - y_mean[k]);
+      const float normalized_cross_correlation =
+          covariance_[k] / (x_sigma * y_sigma[k] + .0001f);
+      if (normalized_cross_correlation > max_normalized_cross_correlation_) {
+        max_normalized_cross_correlation_ = normalized_cross_correlation;
+        max_index_ = static_cast<int>(k);
+      }
+    }
+  }
+
+  float max_normalized_cross_correlation() const {
+    return max_normalized_cross_correlation_;
+  }
+  int max_index() const { return max_index_; }
+  float covariance(size_t k) const { return covariance_[k]; }
+
+ private:
+  float max_normalized_cross_correlation_ = 0.f;
+  int max_index_ = -1;
+  std::vector<float> covariance_;
+};
+
+// Updates |estimator| and |reference| |num_updates| times with random signals
+// and verifies that the estimates and the search results are identical.
+void VerifyAgainstReference(size_t num_estimators, int num_updates) {
+  Random random_generator(42U);
+  NormalizedCovarianceEstimator estimator(num_estimators);
+  ReferenceEstimators reference(num_estimators);
+  ASSERT_EQ(num_estimators, estimator.size());
+  std::vector<float> y(num_estimators);
+  std::vector<float> y_mean(num_estimators);
+  std::vector<float> y_sigma(num_estimators);
+  for (int n = 0; n < num_updates; ++n) {
+    const float x = random_generator.Rand<float>();
+    const float x_mean = 0.5f * random_generator.Rand<float>();
+    const float x_sigma = random_generator.Rand<float>();
+    for (size_t k = 0; k < num_estimators; ++k) {
+      y[k] = random_generator.Rand<float>();
+      y_mean[k] = 0.5f * random_generator.Rand<float>();
+      y_sigma[k] = random_generator.Rand<float>();
+    }
+    estimator.Update(x, x_mean, x_sigma, y, y_mean, y_sigma);
+    reference.Update(x, x_mean, x_sigma, y, y_mean, y_sigma);
+    for (size_t k = 0; k < num_estimators; ++k) {
+      ASSERT_EQ(reference.covariance(k), estimator.covariance(k));
+    }
+    ASSERT_EQ(reference.max_normalized_cross_correlation(),
+              estimator.max_normalized_cross_correlation());
+    ASSERT_EQ(reference.max_index(), estimator.max_index());
+  }
+}
+
+}  // namespace
+
+// Verifies the bank against the scalar reference, for sizes with and without
+// a tail after the last full group of four estimators.
+TEST(NormalizedCovarianceEstimatorTest, MatchesScalarReference) {
+  for (size_t num_estimators : {1, 2, 3, 4, 5, 7, 8, 9, 16, 650, 651}) {
+    SCOPED_TRACE(num_estimators);
+    VerifyAgainstReference(num_estimators, 1000);
+  }
+}
+
+// Verifies that the first of several estimates with the same largest
+// correlation is reported, wherever the estimates are located.
+TEST(NormalizedCovarianceEstimatorTest, TiesGoToTheSmallestIndex) {
+  constexpr size_t kNumEstimators = 11;
+  // Tied estimates in the same group of four, in different groups and lanes,
+  // on both sides of the start of the tail at 8, and within the tail.
+  const std::vector<std::vector<size_t>> kTies = {
+      {2, 6}, {3, 5}, {5, 3}, {1, 2, 10}, {7, 9}, {8, 10}, {9, 10}};
+  for (const auto& ties : kTies) {
+    NormalizedCovarianceEstimator estimator(kNumEstimators);
+    ReferenceEstimators reference(kNumEstimators);
+    // A small positive correlation for all estimates, and a larger one for
+    // the tied ones.
+    std::vector<float> y(kNumEstimators, 1.5f);
+    const std::vector<float> y_mean(kNumEstimators, 1.f);
+    const std::vector<float> y_sigma(kNumEstimators, 1.f);
+    for (size_t k : ties) {
+      y[k] = 3.f;
+    }
+    for (int n = 0; n < 10; ++n) {
+      estimator.Update(2.f, 1.f, 1.f, y, y_mean, y_sigma);
+      reference.Update(2.f, 1.f, 1.f, y, y_mean, y_sigma);
+    }
+    size_t first = ties[0];
+    for (size_t k : ties) {
+      first = std::min(first, k);
+    }
+    EXPECT_EQ(static_cast<int>(first), reference.max_index());
+    EXPECT_EQ(static_cast<int>(first), estimator.max_index());
+    EXPECT_EQ(reference.max_normalized_cross_correlation(),
+              estimator.max_normalized_cross_correlation());
+  }
+
+  // All estimates tied.
+  for (size_t num_estimators : {3, 4, 11}) {
+    NormalizedCovarianceEstimator estimator(num_estimators);
+    const std::vector<float> y(num_estimators, 2.f);
+    const std::vector<float> ones(num_estimators, 1.f);
+    estimator.Update(2.f, 1.f, 1.f, y, ones, ones);
+    EXPECT_EQ(0, estimator.max_index());
+    EXPECT_GT(estimator.max_normalized_cross_correlation(), 0.f);
+  }
+}
+
+// Verifies that no index is reported without a positive correlation.
+TEST(NormalizedCovarianceEstimatorTest, NoPositiveCorrelation) {
+  for (size_t num_estimators : {3, 4, 7}) {
+    NormalizedCovarianceEstimator estimator(num_estimators);
+    const std::vector<float> y(num_estimators, 0.f);
+    const std::vector<float> ones(num_estimators, 1.f);
+    estimator.Update(2.f, 1.f, 1.f, y, ones, ones);
+    EXPECT_EQ(-1, estimator.max_index());
+    EXPECT_EQ(0.f, estimator.max_normalized_cross_correlation());
+    for (size_t k = 0; k < num_estimators; ++k) {
+      EXPECT_LT(estimator.covariance(k), 0.f);
+    }
+  }
+}
+
+// Verifies that Clear() resets the estimates and the search results.
+TEST(NormalizedCovarianceEstimatorTest, Clear) {
+  constexpr size_t kNumEstimators = 6;
+  NormalizedCovarianceEstimator estimator(kNumEstimators);
+  const std::vector<float> y(kNumEstimators, 2.f);
+  const std::vector<float> ones(kNumEstimators, 1.f);
+  estimator.Update(2.f, 1.f, 1.f, y, ones, ones);
+  ASSERT_EQ(0, estimator.max_index());
+  estimator.Clear();
+  EXPECT_EQ(-1, estimator.max_index());
+  EXPECT_EQ(0.f, estimator.max_normalized_cross_correlation());
+  for (size_t k = 0; k < kNumEstimators; ++k) {
+    EXPECT_EQ(0.f, estimator.covariance(k));
+  }
+}
+
+}  // namespace webrtc
@@ -89,6 +89,11 @@ void HighPassFilter::Process(std::vector<std::vector<float>>* audio) {
   }
 }
 
+void HighPassFilter::Process(size_t channel, rtc::ArrayView<float> audio) {
+  RTC_DCHECK_LT(channel, filters_.size());
+  filters_[channel]->Process(audio);
+}
+
 void HighPassFilter::Reset() {
   for (size_t k = 0; k < filters_.size(); ++k) {
     filters_[k]->Reset();
@@ -38,6 +38,14 @@ constexpr float kAlpha = 0.001f;
 // 10 seconds of data, updated every 10 ms.
 constexpr size_t kAggregationBufferSize = 10 * 100;
 
+// Stores |value| at |index| of a circular buffer of size |kLookbackFrames|
+// that holds two copies of its contents.
+void StoreMirrored(float value, size_t index, std::vector<float>* buffer) {
+  RTC_DCHECK_EQ(buffer->size(), 2 * kLookbackFrames);
+  (*buffer)[index] = value;
+  (*buffer)[index + kLookbackFrames] = value;
+}
+
 }  // namespace
 
 namespace webrtc {
@@ -48,9 +56,9 @@ ResidualEchoDetector::ResidualEchoDetector()
     : data_dumper_(
           new ApmDataDumper(rtc::AtomicOps::Increment(&instance_count_))),
       render_buffer_(kRenderBufferSize),
-      render_power_(kLookbackFrames),
-      render_power_mean_(kLookbackFrames),
-      render_power_std_dev_(kLookbackFrames),
+      render_power_(2 * kLookbackFrames),
+      render_power_mean_(2 * kLookbackFrames),
+      render_power_std_dev_(2 * kLookbackFrames),
       covariances_(kLookbackFrames),
       recent_likelihood_max_(kAggregationBufferSize) {}
 
@@ -99,13 +107,15 @@ void ResidualEchoDetector::AnalyzeCaptureAudio(
     // TODO(ivoc): Include how often this happens in APM stats.
     return;
   }
-  // Update the render statistics, and store the statistics in circular buffers.
+  // Update the render statistics, and store the statistics in circular buffers,
+  // in front of the previous values.
   render_statistics_.Update(*buffered_render_power);
-  RTC_DCHECK_LT(next_insertion_index_, kLookbackFrames);
-  render_power_[next_insertion_index_] = *buffered_render_power;
-  render_power_mean_[next_insertion_index_] = render_statistics_.mean();
-  render_power_std_dev_[next_insertion_index_] =
-      render_statistics_.std_deviation();
+  newest_index_ = newest_index_ > 0 ? newest_index_ - 1 : kLookbackFrames - 1;
+  RTC_DCHECK_LT(newest_index_, kLookbackFrames);
+  StoreMirrored(*buffered_render_power, newest_index_, &render_power_);
+  StoreMirrored(render_statistics_.mean(), newest_index_, &render_power_mean_);
+  StoreMirrored(render_statistics_.std_deviation(), newest_index_,
+                &render_power_std_dev_);
 
   // Get the next capture value, update capture statistics and add the relevant
   // values to the buffers.
@@ -114,40 +124,31 @@ void ResidualEchoDetector::AnalyzeCaptureAudio(
   const float capture_mean = capture_statistics_.mean();
   const float capture_std_deviation = capture_statistics_.std_deviation();
 
-  // Update the covariance values and determine the new echo likelihood.
-  echo_likelihood_ = 0.f;
-  size_t read_index = next_insertion_index_;
-
-  int best_delay = -1;
-  for (size_t delay = 0; delay < covariances_.size(); ++delay) {
-    RTC_DCHECK_LT(read_index, render_power_.size());
-    covariances_[delay].Update(capture_power, capture_mean,
-                               capture_std_deviation, render_power_[read_index],
-                               render_power_mean_[read_index],
-                               render_power_std_dev_[read_index]);
-    read_index = read_index > 0 ? read_index - 1 : kLookbackFrames - 1;
-
-    if (covariances_[delay].normalized_cross_correlation() > echo_likelihood_) {
-      echo_likelihood_ = covariances_[delay].normalized_cross_correlation();
-      best_delay = static_cast<int>(delay);
-    }
-  }
+  // Update the covariance values for all delays and determine the new echo
+  // likelihood.
+  covariances_.Update(
+      capture_power, capture_mean, capture_std_deviation,
+      rtc::ArrayView<const float>(&render_power_[newest_index_],
+                                  kLookbackFrames),
+      rtc::ArrayView<const float>(&render_power_mean_[newest_index_],
+                                  kLookbackFrames),
+      rtc::ArrayView<const float>(&render_power_std_dev_[newest_index_],
+                                  kLookbackFrames));
+  echo_likelihood_ = covariances_.max_normalized_cross_correlation();
+  const int best_delay = covariances_.max_index();
   // This is a temporary log message to help find the underlying cause for echo
   // likelihoods > 1.0.
   // TODO(ivoc): Remove once the issue is resolved.
   if (echo_likelihood_ > 1.1f) {
     // Make sure we don't spam the log.
     if (log_counter_ < 5 && best_delay != -1) {
-      size_t read_index = kLookbackFrames + next_insertion_index_ - best_delay;
-      if (read_index >= kLookbackFrames) {
-        read_index -= kLookbackFrames;
-      }
+      const size_t read_index = newest_index_ + best_delay;
       RTC_DCHECK_LT(read_index, render_power_.size());
       RTC_LOG_F(LS_ERROR) << "Echo detector internal state: {"
                              "Echo likelihood: "
                           << echo_likelihood_ << ", Best Delay: " << best_delay
                           << ", Covariance: "
-                          << covariances_[best_delay].covariance()
+                          << covariances_.covariance(best_delay)
                           << ", Last capture power: " << capture_power
                           << ", Capture mean: " << capture_mean
                           << ", Capture_standard deviation: "
@@ -173,11 +174,6 @@ void ResidualEchoDetector::AnalyzeCaptureAudio(
 
   // Update the buffer of recent likelihood values.
   recent_likelihood_max_.Update(echo_likelihood_);
-
-  // Update the next insertion index.
-  next_insertion_index_ = next_insertion_index_ < (kLookbackFrames - 1)
-                              ? next_insertion_index_ + 1
-                              : 0;
 }
 
 void ResidualEchoDetector::Initialize(int /*capture_sample_rate_hz*/,
@@ -191,11 +187,9 @@ void ResidualEchoDetector::Initialize(int /*capture_sample_rate_hz*/,
   render_statistics_.Clear();
   capture_statistics_.Clear();
   recent_likelihood_max_.Clear();
-  for (auto& cov : covariances_) {
-    cov.Clear();
-  }
+  covariances_.Clear();
   echo_likelihood_ = 0.f;
-  next_insertion_index_ = 0;
+  newest_index_ = 0;
   reliability_ = 0.f;
 }
 
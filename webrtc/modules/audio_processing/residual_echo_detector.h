@@ -64,15 +64,17 @@ class ResidualEchoDetector : public EchoDetector {
   size_t frames_since_zero_buffer_size_ = 0;
 
   // Circular buffers containing delayed versions of the power, mean and
-  // standard deviation, for calculating the delayed covariance values.
+  // standard deviation, for calculating the delayed covariance values. The
+  // values are stored from the newest to the oldest, and each buffer holds two
+  // copies of its contents, so that the values for all delays can be read as
+  // one contiguous range starting at |newest_index_|.
   std::vector<float> render_power_;
   std::vector<float> render_power_mean_;
   std::vector<float> render_power_std_dev_;
   // Covariance estimates for different delay values.
-  std::vector<NormalizedCovarianceEstimator> covariances_;
-  // Index where next element should be inserted in all of the above circular
-  // buffers.
-  size_t next_insertion_index_ = 0;
+  NormalizedCovarianceEstimator covariances_;
+  // Index of the newest element in all of the above circular buffers.
+  size_t newest_index_ = 0;
 
   MeanVarianceEstimator render_statistics_;
   MeanVarianceEstimator capture_statistics_;
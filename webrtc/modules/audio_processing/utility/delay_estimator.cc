@@ -16,6 +16,11 @@
 #include <algorithm>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 
@@ -74,6 +79,29 @@ static void BitCountComparison(uint32_t binary_vector,
                                int32_t* bit_counts) {
   int n = 0;
 
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+  // Four rows at a time, using the same bit counting as BitCount().
+  const __m128i vector_v = _mm_set1_epi32(static_cast<int32_t>(binary_vector));
+  const __m128i mask_1 = _mm_set1_epi32(033333333333);
+  const __m128i mask_2 = _mm_set1_epi32(011111111111);
+  const __m128i mask_3 = _mm_set1_epi32(030707070707);
+  const __m128i mask_6 = _mm_set1_epi32(077);
+  for (; n + 4 <= matrix_size; n += 4) {
+    const __m128i u32 = _mm_xor_si128(
+        vector_v,
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&binary_matrix[n])));
+    __m128i tmp = _mm_sub_epi32(
+        _mm_sub_epi32(u32, _mm_and_si128(_mm_srli_epi32(u32, 1), mask_1)),
+        _mm_and_si128(_mm_srli_epi32(u32, 2), mask_2));
+    tmp = _mm_and_si128(_mm_add_epi32(tmp, _mm_srli_epi32(tmp, 3)), mask_3);
+    tmp = _mm_add_epi32(tmp, _mm_srli_epi32(tmp, 6));
+    tmp = _mm_add_epi32(_mm_add_epi32(tmp, _mm_srli_epi32(tmp, 12)),
+                        _mm_srli_epi32(tmp, 24));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&bit_counts[n]),
+                     _mm_and_si128(tmp, mask_6));
+  }
+#endif
+
   // Compare |binary_vector| with all rows of the |binary_matrix|
   for (; n < matrix_size; n++) {
     bit_counts[n] = (int32_t)BitCount(binary_vector ^ binary_matrix[n]);
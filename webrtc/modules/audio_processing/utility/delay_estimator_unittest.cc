@@ -10,8 +10,11 @@
 
 #include "modules/audio_processing/utility/delay_estimator.h"
 
+#include <bitset>
+
 #include "modules/audio_processing/utility/delay_estimator_internal.h"
 #include "modules/audio_processing/utility/delay_estimator_wrapper.h"
+#include "rtc_base/random.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -614,6 +617,100 @@ TEST_F(DelayEstimatorTest, VerifyHistorySizeIsSetAndKeptAfterInit) {
   EXPECT_EQ(kDifferentHistorySize, WebRtc_history_size(handle_));
 }
 
+TEST_F(DelayEstimatorTest, BitCountsMatchScalarReference) {
+  // In this test we verify the bit counts of the Binary Delay Estimator
+  // against a scalar reference, for history sizes with and without a tail
+  // after the last full group of four.
+  Random random_generator(42U);
+  const int kHistorySizes[] = {2, 3, 4, 7, kHistorySize};
+  for (int history_size : kHistorySizes) {
+    SCOPED_TRACE(history_size);
+    BinaryDelayEstimatorFarend* binary_farend =
+        WebRtc_CreateBinaryDelayEstimatorFarend(history_size);
+    ASSERT_TRUE(binary_farend != NULL);
+    BinaryDelayEstimator* binary =
+        WebRtc_CreateBinaryDelayEstimator(binary_farend, 0);
+    ASSERT_TRUE(binary != NULL);
+    WebRtc_InitBinaryDelayEstimatorFarend(binary_farend);
+    WebRtc_InitBinaryDelayEstimator(binary);
+    for (int i = 0; i < kSequenceLength; i++) {
+      // Include spectra with no and all bits differing.
+      const uint32_t binary_far_spectrum = random_generator.Rand<uint32_t>();
+      uint32_t binary_near_spectrum = random_generator.Rand<uint32_t>();
+      if (i % 8 == 1) {
+        binary_near_spectrum = binary_far_spectrum;
+      } else if (i % 8 == 2) {
+        binary_near_spectrum = ~binary_far_spectrum;
+      }
+      WebRtc_AddBinaryFarSpectrum(binary_farend, binary_far_spectrum);
+      WebRtc_ProcessBinarySpectrum(binary, binary_near_spectrum);
+      for (int j = 0; j < history_size; j++) {
+        const std::bitset<32> difference(binary_near_spectrum ^
+                                         binary_farend->binary_far_history[j]);
+        ASSERT_EQ(static_cast<int32_t>(difference.count()),
+                  binary->bit_counts[j]);
+      }
+    }
+    WebRtc_FreeBinaryDelayEstimator(binary);
+    WebRtc_FreeBinaryDelayEstimatorFarend(binary_farend);
+  }
+}
+
+TEST_F(DelayEstimatorTest, BinarySpectrumFixMatchesScalarReference) {
+  // In this test we verify the binary far-end spectra and the threshold
+  // spectrum of the wrapper against a scalar reference, for all Q-domains.
+  // Only bands 12 through 43 are used, as in delay_estimator_wrapper.cc.
+  const int kBandFirst = 12;
+  const int kBandLast = 43;
+  Random random_generator(42U);
+  int32_t threshold_spectrum[kSpectrumSize] = {0};
+  int threshold_initialized = 0;
+  Init();
+  for (int i = 0; i < kSequenceLength; i++) {
+    const int far_q = random_generator.Rand(0, 15);
+    for (int j = 0; j < kSpectrumSize; j++) {
+      // Include silent and full scale bands.
+      switch (random_generator.Rand(0, 7)) {
+        case 0:
+          far_u16_[j] = 0;
+          break;
+        case 1:
+          far_u16_[j] = 65535;
+          break;
+        default:
+          far_u16_[j] = random_generator.Rand<uint16_t>();
+      }
+    }
+    ASSERT_EQ(0, WebRtc_AddFarSpectrumFix(farend_handle_, far_u16_,
+                                          spectrum_size_, far_q));
+
+    uint32_t binary_spectrum = 0;
+    if (!threshold_initialized) {
+      for (int j = kBandFirst; j <= kBandLast; j++) {
+        if (far_u16_[j] > 0) {
+          threshold_spectrum[j] = (far_u16_[j] << (15 - far_q)) >> 1;
+          threshold_initialized = 1;
+        }
+      }
+    }
+    for (int j = kBandFirst; j <= kBandLast; j++) {
+      const int32_t spectrum_q15 = far_u16_[j] << (15 - far_q);
+      WebRtc_MeanEstimatorFix(spectrum_q15, 6, &threshold_spectrum[j]);
+      if (spectrum_q15 > threshold_spectrum[j]) {
+        binary_spectrum |= 1u << (j - kBandFirst);
+      }
+    }
+
+    EXPECT_EQ(threshold_initialized, farend_self_->far_spectrum_initialized);
+    for (int j = kBandFirst; j <= kBandLast; j++) {
+      ASSERT_EQ(threshold_spectrum[j],
+                farend_self_->mean_far_spectrum[j].int32_);
+    }
+    ASSERT_EQ(binary_spectrum,
+              farend_self_->binary_farend->binary_far_history[0]);
+  }
+}
+
 // TODO(bjornv): Add tests for SoftReset...(...).
 
 }  // namespace
@@ -16,6 +16,11 @@
 #include "modules/audio_processing/utility/delay_estimator.h"
 #include "modules/audio_processing/utility/delay_estimator_internal.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 
@@ -80,6 +85,37 @@ static uint32_t BinarySpectrumFix(const uint16_t* spectrum,
       }
     }
   }
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+  // Eight bands at a time, with WebRtc_MeanEstimatorFix() inlined. The 32
+  // bands fill exactly four iterations.
+  static_assert((kBandLast - kBandFirst + 1) % 8 == 0, "");
+  static_assert(sizeof(SpectrumType) == sizeof(int32_t), "");
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i shift = _mm_cvtsi32_si128(15 - q_domain);
+  for (i = kBandFirst; i <= kBandLast; i += 8) {
+    const __m128i spectrum_v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&spectrum[i]));
+    const __m128i spectrum_q15[2] = {
+        _mm_sll_epi32(_mm_unpacklo_epi16(spectrum_v, zero), shift),
+        _mm_sll_epi32(_mm_unpackhi_epi16(spectrum_v, zero), shift)};
+    for (int k = 0; k < 2; ++k) {
+      __m128i* threshold =
+          reinterpret_cast<__m128i*>(&threshold_spectrum[i + 4 * k].int32_);
+      __m128i mean = _mm_loadu_si128(threshold);
+      // Shift the magnitude of the difference, to round towards zero.
+      const __m128i diff = _mm_sub_epi32(spectrum_q15[k], mean);
+      const __m128i sign = _mm_srai_epi32(diff, 31);
+      __m128i step = _mm_sub_epi32(_mm_xor_si128(diff, sign), sign);
+      step = _mm_srli_epi32(step, 6);
+      step = _mm_sub_epi32(_mm_xor_si128(step, sign), sign);
+      mean = _mm_add_epi32(mean, step);
+      _mm_storeu_si128(threshold, mean);
+      const int bits = _mm_movemask_ps(
+          _mm_castsi128_ps(_mm_cmpgt_epi32(spectrum_q15[k], mean)));
+      out |= static_cast<uint32_t>(bits) << (i + 4 * k - kBandFirst);
+    }
+  }
+#else
   for (i = kBandFirst; i <= kBandLast; i++) {
     // Convert input spectrum from Q(|q_domain|) to Q15.
     int32_t spectrum_q15 = ((int32_t)spectrum[i]) << (15 - q_domain);
@@ -90,6 +126,7 @@ static uint32_t BinarySpectrumFix(const uint16_t* spectrum,
       out = SetBit(out, i - kBandFirst);
     }
   }
+#endif
 
   return out;
 }